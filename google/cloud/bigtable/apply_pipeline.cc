@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/apply_pipeline.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+std::size_t constexpr ApplyPipeline::kDefaultMaxInFlight;
+
+ApplyPipeline::ApplyPipeline(Table table, CompletionQueue cq,
+                             std::size_t max_in_flight)
+    : table_(std::move(table)),
+      cq_(std::move(cq)),
+      max_in_flight_(max_in_flight),
+      num_in_flight_(),
+      next_index_() {}
+
+ApplyPipeline::~ApplyPipeline() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return num_in_flight_ == 0; });
+}
+
+void ApplyPipeline::Apply(SingleRowMutation mut) {
+  int index;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    // This is the backpressure: admitting a mutation waits for a free slot
+    // in the in-flight window.
+    cv_.wait(lk, [this] { return num_in_flight_ < max_in_flight_; });
+    ++num_in_flight_;
+    index = next_index_++;
+  }
+  table_.AsyncApply(std::move(mut), cq_).then([this, index](future<Status> f) {
+    OnDone(index, f.get());
+  });
+}
+
+std::vector<FailedMutation> ApplyPipeline::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return num_in_flight_ == 0; });
+  std::vector<FailedMutation> res;
+  res.swap(failures_);
+  return res;
+}
+
+void ApplyPipeline::OnDone(int index, Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!status.ok()) {
+    failures_.emplace_back(std::move(status), index);
+  }
+  --num_in_flight_;
+  lk.unlock();
+  // Wake up both `Apply()` waiting for a slot and `Flush()` waiting for the
+  // window to drain.
+  cv_.notify_all();
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
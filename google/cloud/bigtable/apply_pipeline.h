@@ -0,0 +1,121 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_APPLY_PIPELINE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_APPLY_PIPELINE_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+/**
+ * Pipeline `Table::Apply()`-style writes over a bounded in-flight window.
+ *
+ * `Table::Apply()` blocks on each mutation, so a simple loop gets one
+ * round-trip of latency per mutation. This class accepts mutations into a
+ * bounded window of concurrent `Table::AsyncApply()` operations instead:
+ * `Apply()` returns as soon as the mutation is started, and only blocks when
+ * the window is full. Failures are collected and reported from `Flush()`,
+ * with the index of the failed mutation in submission order.
+ *
+ * Unlike `MutationBatcher` this class sends one RPC per mutation, trading
+ * some throughput for per-mutation latency; use `MutationBatcher` when
+ * mutations can tolerate waiting for a batch to fill.
+ *
+ * This quasi-synchronous example shows the intended use:
+ * @code
+ * bigtable::CompletionQueue cq;
+ * std::thread cq_runner([&cq]() { cq.Run(); });
+ *
+ * bigtable::ApplyPipeline pipeline(bigtable::Table(...args...), cq);
+ * while (HasMoreMutations()) {
+ *   // Blocks only when the in-flight window is full.
+ *   pipeline.Apply(GenerateMutation());
+ * }
+ * auto failures = pipeline.Flush();
+ * for (auto const& f : failures) {
+ *   std::cerr << "mutation " << f.original_index() << " failed: "
+ *             << f.status() << "\n";
+ * }
+ * cq.Shutdown();
+ * cq_runner.join();
+ * @endcode
+ *
+ * @warning `Apply()` and `Flush()` block waiting for completions delivered
+ *     by the `CompletionQueue`, so they must not be called from a thread
+ *     running the `CompletionQueue` event loop.
+ */
+class ApplyPipeline {
+ public:
+  ApplyPipeline(Table table, CompletionQueue cq,
+                std::size_t max_in_flight = kDefaultMaxInFlight);
+
+  /// Waits for all in-flight mutations, like `Flush()`.
+  ~ApplyPipeline();
+
+  ApplyPipeline(ApplyPipeline const&) = delete;
+  ApplyPipeline& operator=(ApplyPipeline const&) = delete;
+
+  /**
+   * Start applying @p mut, blocking while the in-flight window is full.
+   *
+   * Failures are reported from `Flush()`, not from this function.
+   */
+  void Apply(SingleRowMutation mut);
+
+  /**
+   * Wait until all in-flight mutations complete.
+   *
+   * @return the mutations that failed since the last call to `Flush()`,
+   *     identified by their index in submission order. The indexes keep
+   *     growing across `Flush()` calls.
+   */
+  std::vector<FailedMutation> Flush();
+
+  /// A window deep enough to hide the per-mutation round-trip latency.
+  static std::size_t constexpr kDefaultMaxInFlight = 64;
+
+ private:
+  /// Record the result of one mutation and free its window slot.
+  void OnDone(int index, Status status);
+
+  Table table_;
+  CompletionQueue cq_;
+  std::size_t const max_in_flight_;
+
+  std::mutex mu_;
+  /// Signalled when a mutation completes, freeing a window slot.
+  std::condition_variable cv_;
+  std::size_t num_in_flight_;
+  /// The submission-order index of the next mutation.
+  int next_index_;
+  std::vector<FailedMutation> failures_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_APPLY_PIPELINE_H
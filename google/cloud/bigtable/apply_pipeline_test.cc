@@ -0,0 +1,140 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/apply_pipeline.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+namespace bt = ::google::cloud::bigtable;
+using namespace ::testing;
+using namespace google::cloud::testing_util::chrono_literals;
+
+class ApplyPipelineTest : public bigtable::testing::TableTestFixture {
+ protected:
+  using ReaderType =
+      bigtable::testing::MockAsyncResponseReader<btproto::MutateRowResponse>;
+
+  ApplyPipelineTest()
+      : cq_impl_(std::make_shared<bigtable::testing::MockCompletionQueue>()),
+        cq_(cq_impl_) {}
+
+  /**
+   * Expect one `AsyncMutateRow` for @p row_key finishing with @p code.
+   *
+   * Just like in `MutationBatcherTest`, gmock matches the latest added
+   * expectation first, so tests must call this in the reverse order of the
+   * expected requests.
+   */
+  void ExpectMutateRow(std::string const& row_key, grpc::StatusCode code) {
+    auto reader = google::cloud::internal::make_unique<ReaderType>();
+    EXPECT_CALL(*reader, Finish(_, _, _))
+        .WillOnce(Invoke([code](btproto::MutateRowResponse*,
+                                grpc::Status* status,
+                                void*) { *status = grpc::Status(code, ""); }));
+    auto* reader_ptr = reader.get();
+    EXPECT_CALL(*client_, AsyncMutateRow(_, _, _))
+        .WillOnce(Invoke([reader_ptr, row_key](
+                             grpc::ClientContext*,
+                             btproto::MutateRowRequest const& request,
+                             grpc::CompletionQueue*) {
+          EXPECT_EQ(row_key, request.row_key());
+          // This is safe, see comments in MockAsyncResponseReader.
+          return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+              btproto::MutateRowResponse>>(reader_ptr);
+        }))
+        .RetiresOnSaturation();
+    readers_.emplace_back(std::move(reader));
+  }
+
+  std::size_t NumOperationsOutstanding() { return cq_impl_->size(); }
+
+  std::shared_ptr<bigtable::testing::MockCompletionQueue> cq_impl_;
+  CompletionQueue cq_;
+  std::vector<std::unique_ptr<ReaderType>> readers_;
+};
+
+TEST_F(ApplyPipelineTest, PipelinesMutationsAndReportsFailures) {
+  // In the reverse order of the expected requests.
+  ExpectMutateRow("r3", grpc::StatusCode::OK);
+  ExpectMutateRow("r2", grpc::StatusCode::PERMISSION_DENIED);
+  ExpectMutateRow("r1", grpc::StatusCode::OK);
+
+  ApplyPipeline pipeline(table_, cq_, 4);
+  pipeline.Apply(SingleRowMutation("r1", {bt::SetCell("fam", "c", 0_ms, "v")}));
+  pipeline.Apply(SingleRowMutation("r2", {bt::SetCell("fam", "c", 0_ms, "v")}));
+  pipeline.Apply(SingleRowMutation("r3", {bt::SetCell("fam", "c", 0_ms, "v")}));
+  // All three mutations are in flight concurrently.
+  EXPECT_EQ(3, NumOperationsOutstanding());
+
+  cq_impl_->SimulateCompletion(true);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+
+  auto failures = pipeline.Flush();
+  ASSERT_EQ(1, failures.size());
+  EXPECT_EQ(1, failures[0].original_index());
+  EXPECT_EQ(StatusCode::kPermissionDenied, failures[0].status().code());
+
+  // The failures have been consumed.
+  EXPECT_TRUE(pipeline.Flush().empty());
+}
+
+TEST_F(ApplyPipelineTest, FullWindowBlocksApply) {
+  // In the reverse order of the expected requests.
+  ExpectMutateRow("r2", grpc::StatusCode::OK);
+  ExpectMutateRow("r1", grpc::StatusCode::OK);
+
+  ApplyPipeline pipeline(table_, cq_, 1);
+  pipeline.Apply(SingleRowMutation("r1", {bt::SetCell("fam", "c", 0_ms, "v")}));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  std::atomic<bool> admitted(false);
+  std::thread submitter([this, &pipeline, &admitted] {
+    pipeline.Apply(
+        SingleRowMutation("r2", {bt::SetCell("fam", "c", 0_ms, "v")}));
+    admitted = true;
+  });
+  // The second mutation should block while the window is full.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(admitted.load());
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // Completing the first mutation frees the slot and admits the second.
+  cq_impl_->SimulateCompletion(true);
+  submitter.join();
+  EXPECT_TRUE(admitted.load());
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  cq_impl_->SimulateCompletion(true);
+  EXPECT_TRUE(pipeline.Flush().empty());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
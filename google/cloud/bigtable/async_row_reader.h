@@ -31,12 +31,80 @@
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <chrono>
+#include <memory>
 #include <queue>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Counters describing one `Table::AsyncReadRows()` call.
+ *
+ * The counters are written to `AsyncRowReaderOptions::metrics` just
+ * before the `on_finish` callback is invoked, they should not be read
+ * before that.
+ */
+struct AsyncRowReaderMetrics {
+  /// The number of rows delivered to the `on_row` callback.
+  std::int64_t rows_delivered = 0;
+
+  /// The largest number of rows buffered waiting for the consumer.
+  std::size_t max_rows_buffered = 0;
+
+  /**
+   * Total time spent waiting for the server.
+   *
+   * This accumulates the periods where the consumer wanted a row but
+   * none was buffered. A scan dominated by this value is network-bound,
+   * consider raising `AsyncRowReaderOptions::readahead_high_watermark`.
+   */
+  std::chrono::microseconds server_wait{0};
+
+  /**
+   * Total time spent waiting for the consumer.
+   *
+   * This accumulates the periods where the stream was paused because the
+   * buffer reached `AsyncRowReaderOptions::readahead_high_watermark`. A
+   * scan dominated by this value is bound by the consumer, e.g. by the
+   * work performed in the `on_row` callback.
+   */
+  std::chrono::microseconds consumer_wait{0};
+};
+
+/**
+ * Per-call tuning knobs for `Table::AsyncReadRows()`.
+ */
+struct AsyncRowReaderOptions {
+  /**
+   * Pause the stream when this many rows are buffered.
+   *
+   * The default of 1 preserves the historical behavior: the stream stops
+   * reading ahead as soon as any row is waiting for the consumer. Larger
+   * values let the stream read ahead while the consumer processes rows,
+   * at the cost of buffering up to this many rows in memory.
+   */
+  std::size_t readahead_high_watermark = 1;
+
+  /**
+   * Resume a paused stream when the buffer drains to this many rows.
+   *
+   * With the default of 0 a paused stream resumes only when the consumer
+   * asks for a row and the buffer is empty. A non-zero value (which must
+   * be less than `readahead_high_watermark`) re-primes the stream before
+   * the buffer is exhausted, hiding the server round-trip behind the
+   * consumption of the remaining buffered rows.
+   */
+  std::size_t readahead_low_watermark = 0;
+
+  /**
+   * If not null, the counters for the call are written here just before
+   * the `on_finish` callback is invoked.
+   */
+  std::shared_ptr<AsyncRowReaderMetrics> metrics;
+};
+
 /**
  * Objects of this class represent the state of reading rows via AsyncReadRows.
  *
@@ -69,13 +137,15 @@ class AsyncRowReader : public std::enable_shared_from_this<
       Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory) {
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      AsyncRowReaderOptions options = AsyncRowReaderOptions()) {
     std::shared_ptr<AsyncRowReader> res(new AsyncRowReader(
         std::move(cq), std::move(client), std::move(app_profile_id),
         std::move(table_name), std::move(on_row), std::move(on_finish),
         std::move(row_set), rows_limit, std::move(filter),
         std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
-        std::move(metadata_update_policy), std::move(parser_factory)));
+        std::move(metadata_update_policy), std::move(parser_factory),
+        std::move(options)));
     res->MakeRequest();
     return res;
   }
@@ -87,7 +157,8 @@ class AsyncRowReader : public std::enable_shared_from_this<
       Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      AsyncRowReaderOptions options)
       : cq_(std::move(cq)),
         client_(std::move(client)),
         app_profile_id_(std::move(app_profile_id)),
@@ -101,12 +172,24 @@ class AsyncRowReader : public std::enable_shared_from_this<
         rpc_backoff_policy_(std::move(rpc_backoff_policy)),
         metadata_update_policy_(std::move(metadata_update_policy)),
         parser_factory_(std::move(parser_factory)),
+        options_(std::move(options)),
         rows_count_(0),
         whole_op_finished_(),
-        recursion_level_() {}
+        recursion_level_(),
+        user_waiting_(true) {
+    if (options_.readahead_high_watermark < 1) {
+      options_.readahead_high_watermark = 1;
+    }
+    if (options_.readahead_low_watermark >= options_.readahead_high_watermark) {
+      options_.readahead_low_watermark = options_.readahead_high_watermark - 1;
+    }
+  }
 
   void MakeRequest() {
     status_ = Status();
+    if (user_waiting_ && !server_wait_start_) {
+      server_wait_start_ = std::chrono::steady_clock::now();
+    }
     google::bigtable::v2::ReadRowsRequest request;
 
     request.set_app_profile_id(app_profile_id_);
@@ -146,7 +229,25 @@ class AsyncRowReader : public std::enable_shared_from_this<
    * Called when the user asks for more rows via satisfying the future returned
    * from the row callback.
    */
-  void UserWantsRows() { TryGiveRowToUser(); }
+  void UserWantsRows() {
+    user_waiting_ = true;
+    TryGiveRowToUser();
+  }
+
+  /**
+   * Satisfy the pending promise, the lower layers will fetch more data.
+   */
+  void ResumeStream() {
+    if (consumer_wait_start_) {
+      metrics_.consumer_wait +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - *consumer_wait_start_);
+      consumer_wait_start_.reset();
+    }
+    auto continue_reading = std::move(continue_reading_);
+    continue_reading_.reset();
+    continue_reading->set_value(true);
+  }
 
   /**
    * Attempt to call a user callback.
@@ -177,26 +278,47 @@ class AsyncRowReader : public std::enable_shared_from_this<
     if (ready_rows_.empty()) {
       if (whole_op_finished_) {
         // The scan is finished for good, there will be no more rows.
+        if (options_.metrics) {
+          *options_.metrics = metrics_;
+        }
         on_finish_(status_);
         return;
       }
-      if (!continue_reading_) {
-        // TODO(#1402): replace with GCP_ASSERT(continue_reading_);
-        Terminate(
-            "No rows are ready and we can't continue reading. This is a bug, "
-            "please report it at "
-            "https://github.com/googleapis/google-cloud-cpp/issues/new");
+      if (user_waiting_ && !server_wait_start_) {
+        server_wait_start_ = std::chrono::steady_clock::now();
       }
-      // No rows, but we can fetch some.
-      auto continue_reading = std::move(continue_reading_);
-      continue_reading_.reset();
-      continue_reading->set_value(true);
+      if (continue_reading_) {
+        // No rows, but we can fetch some.
+        ResumeStream();
+      }
+      // Otherwise the stream is already reading ahead (see
+      // `AsyncRowReaderOptions::readahead_high_watermark`), the next
+      // response or the end of the stream will resume the delivery.
+      return;
+    }
+    if (!user_waiting_) {
+      // The consumer is still processing the previously delivered row,
+      // keep the rows buffered until they ask for more.
       return;
     }
 
     // Yay! We have something to give to the user and they want it.
     auto row = std::move(ready_rows_.front());
     ready_rows_.pop();
+    user_waiting_ = false;
+    ++metrics_.rows_delivered;
+    if (server_wait_start_) {
+      metrics_.server_wait +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - *server_wait_start_);
+      server_wait_start_.reset();
+    }
+    // Re-prime a paused stream before the buffer is exhausted, so the
+    // server round-trip overlaps with the remaining buffered rows.
+    if (continue_reading_ && options_.readahead_low_watermark > 0 &&
+        ready_rows_.size() <= options_.readahead_low_watermark) {
+      ResumeStream();
+    }
 
     auto self = this->shared_from_this();
     bool const break_recursion = recursion_level_ >= 100;
@@ -254,7 +376,14 @@ class AsyncRowReader : public std::enable_shared_from_this<
     // retriable anyway.
 
     if (status_.ok()) {
+      if (ready_rows_.size() < options_.readahead_high_watermark) {
+        // Below the high watermark, keep the stream reading ahead while
+        // the consumer works through the buffered rows.
+        TryGiveRowToUser();
+        return make_ready_future<bool>(true);
+      }
       continue_reading_.emplace(promise<bool>());
+      consumer_wait_start_ = std::chrono::steady_clock::now();
       auto res = continue_reading_->get_future();
       TryGiveRowToUser();
       return res;
@@ -324,6 +453,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
   /// User satisfied the future returned from the row callback with false.
   void Cancel(std::string const& reason) {
     ready_rows_ = std::queue<Row>();
+    consumer_wait_start_.reset();
     auto continue_reading = std::move(continue_reading_);
     continue_reading_.reset();
     Status status(StatusCode::kCancelled, reason);
@@ -351,24 +481,21 @@ class AsyncRowReader : public std::enable_shared_from_this<
       ++rows_count_;
       last_read_row_key_ = std::string(parsed_row.row_key());
       ready_rows_.emplace(std::move(parsed_row));
+      if (ready_rows_.size() > metrics_.max_rows_buffered) {
+        metrics_.max_rows_buffered = ready_rows_.size();
+      }
     }
     return Status();
   }
 
   /// Parse the data from the response.
   Status ConsumeResponse(google::bigtable::v2::ReadRowsResponse response) {
-    for (auto& chunk : *response.mutable_chunks()) {
-      grpc::Status status;
-      parser_->HandleChunk(std::move(chunk), status);
-      if (!status.ok()) {
-        return MakeStatusFromRpcError(status);
-      }
-      Status parser_status = DrainParser();
-      if (!parser_status.ok()) {
-        return parser_status;
-      }
+    grpc::Status status;
+    parser_->HandleResponse(std::move(response), status);
+    if (!status.ok()) {
+      return MakeStatusFromRpcError(status);
     }
-    return Status();
+    return DrainParser();
   }
 
   friend class Table;
@@ -387,6 +514,8 @@ class AsyncRowReader : public std::enable_shared_from_this<
   std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
+  /// Per-call tuning knobs, see `AsyncRowReaderOptions`.
+  AsyncRowReaderOptions options_;
   std::unique_ptr<internal::ReadRowsParser> parser_;
   /// Number of rows read so far, used to set row_limit in retries.
   std::int64_t rows_count_;
@@ -416,6 +545,14 @@ class AsyncRowReader : public std::enable_shared_from_this<
   Status status_;
   /// Tracks the level of recursion of TryGiveRowToUser
   int recursion_level_;
+  /// Is the consumer ready for the next row?
+  bool user_waiting_;
+  /// The counters for this call, see `AsyncRowReaderOptions::metrics`.
+  AsyncRowReaderMetrics metrics_;
+  /// When the consumer started waiting for the server, if it is waiting.
+  optional<std::chrono::steady_clock::time_point> server_wait_start_;
+  /// When the stream was paused waiting for the consumer, if it is.
+  optional<std::chrono::steady_clock::time_point> consumer_wait_start_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -92,7 +92,8 @@ class TableAsyncReadRowsTest : public bigtable::testing::TableTestFixture {
   }
 
   // Start Table::AsyncReadRows.
-  void ReadRows(int row_limit = RowReader::NO_ROWS_LIMIT) {
+  void ReadRows(int row_limit = RowReader::NO_ROWS_LIMIT,
+                AsyncRowReaderOptions options = AsyncRowReaderOptions()) {
     table_.AsyncReadRows(
         cq_,
         [this](Row row) {
@@ -107,7 +108,7 @@ class TableAsyncReadRowsTest : public bigtable::testing::TableTestFixture {
         [this](Status stream_status) {
           stream_status_promise_.set_value(stream_status);
         },
-        RowSet(), row_limit, Filter::PassAllFilter());
+        RowSet(), row_limit, Filter::PassAllFilter(), std::move(options));
   }
 
   /// Expect a row whose row key is equal to this function's argument.
@@ -383,6 +384,159 @@ TEST_F(TableAsyncReadRowsTest, MultipleChunksImmediatelySatisfied) {
   ASSERT_EQ(0U, cq_impl_->size());
 }
 
+/// @test Verify that a high watermark above 1 keeps the stream reading.
+TEST_F(TableAsyncReadRowsTest, ReadAheadKeepsStreamRunning) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r1"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r2"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      }))
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  ExpectRow("r1");
+  ExpectRow("r2");
+  AsyncRowReaderOptions options;
+  options.readahead_high_watermark = 4;
+  options.metrics = std::make_shared<AsyncRowReaderMetrics>();
+  ReadRows(RowReader::NO_ROWS_LIMIT, options);
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  row_futures_[0].get();
+
+  // Below the high watermark the stream keeps fetching even though the
+  // user is still processing "r1".
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(1U, cq_impl_->size());
+
+  // The second row is buffered, not delivered, until the user asks.
+  EXPECT_TRUE(Unsatisfied(row_futures_[1]));
+  promises_from_user_cb_[0].set_value(true);
+  row_futures_[1].get();
+  promises_from_user_cb_[1].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto stream_status = stream_status_future_.get();
+  ASSERT_STATUS_OK(stream_status);
+  ASSERT_EQ(0U, cq_impl_->size());
+  EXPECT_EQ(2, options.metrics->rows_delivered);
+  EXPECT_LE(1U, options.metrics->max_rows_buffered);
+}
+
+/// @test Verify the stream is re-primed at the low watermark.
+TEST_F(TableAsyncReadRowsTest, ReadAheadLowWatermarkReprimes) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r1"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                }
+                chunks {
+                  row_key: "r2"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                }
+                chunks {
+                  row_key: "r3"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      }))
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  ExpectRows({"r1", "r2", "r3"});
+  AsyncRowReaderOptions options;
+  options.readahead_high_watermark = 2;
+  options.readahead_low_watermark = 1;
+  options.metrics = std::make_shared<AsyncRowReaderMetrics>();
+  ReadRows(RowReader::NO_ROWS_LIMIT, options);
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  row_futures_[0].get();
+
+  // Two rows are buffered, which reached the high watermark, so the
+  // stream is paused.
+  ASSERT_EQ(0U, cq_impl_->size());
+
+  // Consuming "r2" drains the buffer to the low watermark, the stream
+  // resumes before the buffer is exhausted.
+  promises_from_user_cb_[0].set_value(true);
+  row_futures_[1].get();
+  ASSERT_EQ(1U, cq_impl_->size());
+
+  promises_from_user_cb_[1].set_value(true);
+  row_futures_[2].get();
+  promises_from_user_cb_[2].set_value(true);
+
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto stream_status = stream_status_future_.get();
+  ASSERT_STATUS_OK(stream_status);
+  ASSERT_EQ(0U, cq_impl_->size());
+  EXPECT_EQ(3, options.metrics->rows_delivered);
+  EXPECT_EQ(3U, options.metrics->max_rows_buffered);
+}
+
 /// @test Verify that a single row can span mutiple responses.
 TEST_F(TableAsyncReadRowsTest, ResponseInMultipleChunks) {
   auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
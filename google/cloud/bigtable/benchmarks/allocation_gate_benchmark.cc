@@ -0,0 +1,256 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/mutations.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * An allocation-regression gate for the client data path.
+ *
+ * Several releases have accidentally added copies (and therefore heap
+ * allocations) to the `ReadRows()` and `BulkApply()` paths; time-based
+ * benchmarks only catch such regressions when someone compares runs.
+ * This program counts the exact number of `operator new` calls for
+ * canonical workloads and fails when a count exceeds its checked-in
+ * baseline, turning allocation behavior into a tested contract.
+ *
+ * The workloads are CPU-only so the counts are deterministic:
+ * - a point read: build the request and parse a one-row stream,
+ * - a scan: parse a synthetic 1,000 row chunk stream into `Row`s,
+ * - a bulk apply: build a 1,000 mutation `BulkMutation` and move it
+ *   into the request proto, as `Table::BulkApply()` does before the RPC.
+ *
+ * The baselines are round numbers a comfortable margin above the counts
+ * measured on the reference toolchain; they absorb standard library and
+ * protobuf version differences but catch multiplicative regressions,
+ * e.g. a new copy per row, cell, or mutation. After changing the data
+ * path intentionally, re-run with `report` to obtain the new counts and
+ * adjust the baselines in this file:
+ *
+ * @code
+ * ./allocation_gate_benchmark         # enforce the baselines
+ * ./allocation_gate_benchmark report  # only report the counts
+ * @endcode
+ *
+ * This gate requires no project or instance.
+ */
+
+// The replaced allocation functions must be at global scope. A plain
+// counter is enough, the workloads are single-threaded; the atomic only
+// guards against background threads of linked-in libraries.
+namespace {
+std::atomic<std::uint64_t> allocation_count{0};
+}  // anonymous namespace
+
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  void* p = std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/**
+ * The baselines, in allocations per operation.
+ *
+ * Keep these round and with headroom over the measured counts (see the
+ * file comment); lowering them after an optimization is as much part of
+ * a change as raising them after an accepted trade-off.
+ */
+constexpr std::uint64_t kPointReadBaseline = 128;
+constexpr std::uint64_t kScanBaseline = 150000;
+constexpr std::uint64_t kBulkApplyBaseline = 16000;
+
+constexpr int kScanRowCount = 1000;
+constexpr int kBulkMutationCount = 1000;
+constexpr int kValueSize = 100;
+
+/// Build a synthetic stream of @p row_count rows of kNumFields cells.
+std::vector<google::bigtable::v2::ReadRowsResponse> MakeStream(
+    int row_count, int rows_per_response) {
+  std::vector<google::bigtable::v2::ReadRowsResponse> stream;
+  std::string const value(kValueSize, 'x');
+  int row_id = 0;
+  while (row_id != row_count) {
+    google::bigtable::v2::ReadRowsResponse response;
+    for (int r = 0; r != rows_per_response && row_id != row_count;
+         ++r, ++row_id) {
+      std::ostringstream os;
+      os << "user" << std::setw(12) << std::setfill('0') << row_id;
+      std::string row_key = os.str();
+      for (int f = 0; f != kNumFields; ++f) {
+        auto& chunk = *response.add_chunks();
+        if (f == 0) {
+          chunk.set_row_key(row_key);
+          chunk.mutable_family_name()->set_value(kColumnFamily);
+        }
+        chunk.mutable_qualifier()->set_value("field" + std::to_string(f));
+        chunk.set_timestamp_micros(0);
+        chunk.set_value(value);
+        chunk.set_value_size(0);
+        if (f == kNumFields - 1) {
+          chunk.set_commit_row(true);
+        }
+      }
+    }
+    stream.push_back(std::move(response));
+  }
+  return stream;
+}
+
+/// Parse @p stream with a fresh parser, as one `ReadRows()` call would.
+long ParseStream(
+    std::vector<google::bigtable::v2::ReadRowsResponse> const& stream) {
+  bigtable::internal::ReadRowsParser parser;
+  grpc::Status status;
+  long cells = 0;
+  for (auto const& response : stream) {
+    for (auto const& chunk : response.chunks()) {
+      // The copy made for this call stands in for the allocations that
+      // deserializing the response from the wire performs in production.
+      parser.HandleChunk(chunk, status);
+      if (!status.ok()) {
+        std::cerr << "HandleChunk() failed: " << status.error_message()
+                  << "\n";
+        std::exit(1);
+      }
+      if (parser.HasNext()) {
+        auto row = parser.Next(status);
+        cells += static_cast<long>(row.cells().size());
+      }
+    }
+  }
+  parser.HandleEndOfStream(status);
+  if (!status.ok()) {
+    std::cerr << "HandleEndOfStream() failed: " << status.error_message()
+              << "\n";
+    std::exit(1);
+  }
+  return cells;
+}
+
+/// The client-side work of a `Table::ReadRow()` call.
+void RunPointRead(
+    std::vector<google::bigtable::v2::ReadRowsResponse> const& stream) {
+  google::bigtable::v2::ReadRowsRequest request;
+  request.set_table_name(
+      "projects/p/instances/i/tables/perf-gate");
+  request.mutable_rows()->add_row_keys("user000000000000");
+  request.set_rows_limit(1);
+  auto filter = bigtable::Filter::Latest(1);
+  auto filter_proto = filter.as_proto();
+  request.mutable_filter()->Swap(&filter_proto);
+  (void)ParseStream(stream);
+}
+
+/// The client-side work of building one `Table::BulkApply()` request.
+void RunBulkApply() {
+  bigtable::BulkMutation bulk;
+  std::string const value(kValueSize, 'x');
+  for (int i = 0; i != kBulkMutationCount; ++i) {
+    std::ostringstream os;
+    os << "user" << std::setw(12) << std::setfill('0') << i;
+    bulk.emplace_back(bigtable::SingleRowMutation(
+        os.str(), bigtable::SetCell(kColumnFamily, "field0",
+                                    std::chrono::milliseconds(0), value)));
+  }
+  google::bigtable::v2::MutateRowsRequest request;
+  bulk.MoveTo(&request);
+}
+
+/**
+ * Measure the allocations per call of @p workload.
+ *
+ * The first (unmeasured) call populates lazily initialized state; the
+ * maximum over the measured calls is reported so a count that is only
+ * sometimes higher still trips the gate.
+ */
+template <typename Workload>
+std::uint64_t MeasureAllocations(Workload&& workload, int iterations) {
+  workload();
+  std::uint64_t max_count = 0;
+  for (int i = 0; i != iterations; ++i) {
+    auto const before = allocation_count.load();
+    workload();
+    auto const count = allocation_count.load() - before;
+    if (count > max_count) {
+      max_count = count;
+    }
+  }
+  return max_count;
+}
+
+/// Report one workload and return false if it exceeds its baseline.
+bool CheckWorkload(char const* name, std::uint64_t measured,
+                   std::uint64_t baseline, bool enforce) {
+  bool const ok = measured <= baseline;
+  std::cout << name << "," << measured << "," << baseline << ","
+            << (ok ? "OK" : "FAILED") << "\n";
+  if (!ok && enforce) {
+    std::cerr << "Allocation regression: " << name << " performs "
+              << measured << " allocations per operation, the baseline is "
+              << baseline << ". If this increase is intended, adjust the "
+              << "baseline in allocation_gate_benchmark.cc\n";
+  }
+  return ok || !enforce;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  bool const enforce = !(argc > 1 && std::string(argv[1]) == "report");
+
+  auto const point_stream = MakeStream(1, 1);
+  auto const scan_stream = MakeStream(kScanRowCount, 100);
+
+  auto const point_read = MeasureAllocations(
+      [&point_stream] { RunPointRead(point_stream); }, 100);
+  auto const scan = MeasureAllocations(
+      [&scan_stream] { (void)ParseStream(scan_stream); }, 10);
+  auto const bulk_apply = MeasureAllocations([] { RunBulkApply(); }, 10);
+
+  std::cout << "Workload,AllocationsPerOp,Baseline,Result\n";
+  bool ok = true;
+  ok = CheckWorkload("PointRead", point_read, kPointReadBaseline, enforce) &&
+       ok;
+  ok = CheckWorkload("Scan1k", scan, kScanBaseline, enforce) && ok;
+  ok = CheckWorkload("BulkApply1k", bulk_apply, kBulkApplyBaseline, enforce) &&
+       ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file
+ *
+ * Measure the latency of `bigtable::Table::Apply()` and
+ * `bigtable::Table::ReadRow()` at a fixed arrival rate.
+ *
+ * Unlike `apply_read_latency_benchmark.cc`, which runs closed-loop
+ * (each thread issues the next operation only after the previous one
+ * completes), this benchmark runs open-loop: the start times of the
+ * operations are drawn from a Poisson process at a configurable target
+ * rate, the operations are issued asynchronously through a
+ * `CompletionQueue`, and each latency is measured from the *intended*
+ * start time of the operation.  A stalled response therefore counts
+ * against every operation that was scheduled behind it, which avoids
+ * the coordinated omission problem and shows how the client behaves at
+ * production-shaped load.
+ *
+ * More specifically, the benchmark:
+ *
+ * - Creates and populates a table as in the other benchmarks (see
+ *   `apply_read_latency_benchmark.cc` for the details).
+ * - Starts T threads running a `CompletionQueue` event loop.
+ * - Draws operation start times from a Poisson process at the target
+ *   rate.  At each start time it randomly picks, with 50% probability,
+ *   an `AsyncApply()` or an `AsyncReadRow()` operation and issues it
+ *   without waiting for any previous operation.
+ * - When an operation completes, records whether it was successful and
+ *   the elapsed time since its intended start time.
+ * - After S seconds it waits for the outstanding operations, reports
+ *   the results (including latency percentiles), deletes the table,
+ *   and reports the same results in CSV format.
+ *
+ * The target rate can be given as an additional (trailing) command-line
+ * argument, after the arguments consumed by the common benchmark setup.
+ */
+
+/// Helper functions and types for the apply_read_open_loop_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/// The default arrival rate, in operations per second.
+constexpr double kDefaultTargetQps = 1000.0;
+
+struct LatencyBenchmarkResult {
+  BenchmarkResult apply_results;
+  BenchmarkResult read_results;
+};
+
+class OpenLoopBenchmark {
+ public:
+  OpenLoopBenchmark(bigtable::benchmarks::Benchmark& benchmark,
+                    std::string const& app_profile_id,
+                    std::string const& table_id, int thread_count)
+      : benchmark_(benchmark),
+        table_(benchmark_.MakeDataClient(), app_profile_id, table_id),
+        generator_(std::random_device{}()) {
+    for (int i = 0; i != thread_count; ++i) {
+      cq_threads_.emplace_back([this] { cq_.Run(); });
+    }
+  }
+
+  ~OpenLoopBenchmark() {
+    cq_.Shutdown();
+    for (auto& t : cq_threads_) {
+      t.join();
+    }
+  }
+
+  LatencyBenchmarkResult Run(std::chrono::seconds test_duration,
+                             double target_qps);
+
+ private:
+  void StartOneApply(std::chrono::steady_clock::time_point intended_start);
+  void StartOneReadRow(std::chrono::steady_clock::time_point intended_start);
+  void OnOperation(BenchmarkResult& results,
+                   std::chrono::steady_clock::time_point intended_start,
+                   google::cloud::Status status);
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  google::cloud::CompletionQueue cq_;
+  std::vector<std::thread> cq_threads_;
+  bigtable::benchmarks::Benchmark& benchmark_;
+  bigtable::Table table_;
+  google::cloud::internal::DefaultPRNG generator_;
+  int outstanding_requests_ = 0;
+  LatencyBenchmarkResult results_;
+};
+
+//@{
+/// @name Test constants.  Defined as requirements in the original bug (#189).
+/// How many times does each thread report progress.
+constexpr int kBenchmarkProgressMarks = 4;
+//@}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto setup = MakeBenchmarkSetup("perf", argc, argv);
+  if (!setup) {
+    std::cerr << setup.status() << "\n";
+    return -1;
+  }
+
+  // The common setup leaves any unconsumed arguments in place, use the
+  // first one (if any) as the target arrival rate.
+  double target_qps = kDefaultTargetQps;
+  if (argc > 1) {
+    target_qps = std::stod(argv[1]);
+    if (target_qps <= 0) {
+      std::cerr << "target-qps should be > 0\n";
+      return -1;
+    }
+  }
+
+  Benchmark benchmark(*setup);
+
+  // Create and populate the table for the benchmark.
+  benchmark.CreateTable();
+  auto populate_results = benchmark.PopulateTable();
+  if (!populate_results) {
+    std::cerr << populate_results.status() << "\n";
+    return 1;
+  }
+
+  benchmark.PrintThroughputResult(std::cout, "perf", "Upload",
+                                  *populate_results);
+
+  std::cout << "# Running Open-Loop Latency Benchmark at " << target_qps
+            << " ops/s " << std::flush;
+  OpenLoopBenchmark open_loop(benchmark, setup->app_profile_id(),
+                              setup->table_id(), setup->thread_count());
+  auto test_start = std::chrono::steady_clock::now();
+  auto combined = open_loop.Run(setup->test_duration(), target_qps);
+  auto test_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - test_start);
+  combined.apply_results.elapsed = test_elapsed;
+  combined.read_results.elapsed = test_elapsed;
+  std::cout << " DONE. Elapsed=" << FormatDuration(test_elapsed)
+            << ", Ops=" << (combined.apply_results.operations.size() +
+                            combined.read_results.operations.size())
+            << "\n";
+
+  benchmark.PrintLatencyResult(std::cout, "perf", "Apply()",
+                               combined.apply_results);
+  benchmark.PrintLatencyResult(std::cout, "perf", "ReadRow()",
+                               combined.read_results);
+
+  std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
+  benchmark.PrintResultCsv(std::cout, "perf", "BulkApply()", "Latency",
+                           *populate_results);
+  benchmark.PrintResultCsv(std::cout, "perf", "Apply()", "Latency",
+                           combined.apply_results);
+  benchmark.PrintResultCsv(std::cout, "perf", "ReadRow()", "Latency",
+                           combined.read_results);
+
+  benchmark.DeleteTable();
+
+  return 0;
+}
+
+namespace {
+
+LatencyBenchmarkResult OpenLoopBenchmark::Run(
+    std::chrono::seconds test_duration, double target_qps) {
+  results_ = LatencyBenchmarkResult{};
+
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + test_duration;
+  auto mark = start + test_duration / kBenchmarkProgressMarks;
+  PoissonArrivalSchedule schedule(target_qps, start);
+  std::uniform_int_distribution<int> prng_operation(0, 1);
+
+  // The generator, the schedule, and the distribution are only used in
+  // this thread; the completion callbacks only touch the members
+  // protected by `mu_`.
+  for (;;) {
+    auto intended_start = schedule.NextArrival(generator_);
+    if (intended_start >= deadline) {
+      break;
+    }
+    std::this_thread::sleep_until(intended_start);
+    if (prng_operation(generator_) == 0) {
+      StartOneApply(intended_start);
+    } else {
+      StartOneReadRow(intended_start);
+    }
+    if (intended_start >= mark) {
+      std::cout << "." << std::flush;
+      mark = intended_start + test_duration / kBenchmarkProgressMarks;
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return outstanding_requests_ == 0; });
+  return std::move(results_);
+}
+
+void OpenLoopBenchmark::StartOneApply(
+    std::chrono::steady_clock::time_point intended_start) {
+  using google::cloud::future;
+  using google::cloud::Status;
+
+  bigtable::SingleRowMutation mutation(benchmark_.MakeRandomKey(generator_));
+  for (int field = 0; field != kNumFields; ++field) {
+    mutation.emplace_back(MakeRandomMutation(generator_, field));
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++outstanding_requests_;
+  }
+  table_.AsyncApply(std::move(mutation), cq_)
+      .then([this, intended_start](future<Status> f) {
+        OnOperation(results_.apply_results, intended_start, f.get());
+      });
+}
+
+void OpenLoopBenchmark::StartOneReadRow(
+    std::chrono::steady_clock::time_point intended_start) {
+  using google::cloud::future;
+  using google::cloud::StatusOr;
+
+  auto row_key = benchmark_.MakeRandomKey(generator_);
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++outstanding_requests_;
+  }
+  table_
+      .AsyncReadRow(cq_, std::move(row_key),
+                    bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0",
+                                                        "field9"))
+      .then([this, intended_start](
+                future<StatusOr<std::pair<bool, bigtable::Row>>> f) {
+        OnOperation(results_.read_results, intended_start, f.get().status());
+      });
+}
+
+void OpenLoopBenchmark::OnOperation(
+    BenchmarkResult& results,
+    std::chrono::steady_clock::time_point intended_start,
+    google::cloud::Status status) {
+  // Measure from the intended start time, so the time an operation
+  // spent queued behind a stalled response counts as latency.
+  auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - intended_start);
+
+  std::lock_guard<std::mutex> lk(mu_);
+  results.operations.push_back({std::move(status), usecs});
+  ++results.row_count;
+  if (--outstanding_requests_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+}  // anonymous namespace
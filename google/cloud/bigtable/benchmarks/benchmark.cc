@@ -89,20 +89,40 @@ std::shared_ptr<bigtable::DataClient> Benchmark::MakeDataClient() {
       setup_.project_id(), setup_.instance_id(), client_options_);
 }
 
+std::shared_ptr<bigtable::DataClient> Benchmark::MakeDataClient(
+    std::size_t connection_pool_size) {
+  auto options = client_options_;
+  options.set_connection_pool_size(connection_pool_size);
+  return bigtable::CreateDefaultDataClient(setup_.project_id(),
+                                           setup_.instance_id(), options);
+}
+
 google::cloud::StatusOr<BenchmarkResult> Benchmark::PopulateTable() {
-  bigtable::Table table(MakeDataClient(), setup_.app_profile_id(),
-                        setup_.table_id());
+  auto table_size = setup_.table_size();
+  // For the large configurations the fixed shard count leaves most of the
+  // benchmark threads (and their channels) idle during the load, so scale
+  // the shard count with the thread count. Never make a shard smaller than
+  // one `BulkApply()` batch, tiny shards just add half-empty requests.
+  int shard_count = (std::max)(
+      kPopulateShardCount, kPopulateShardsPerThread * setup_.thread_count());
+  auto const max_shards = static_cast<int>(table_size / kBulkSize);
+  shard_count = (std::max)(1, (std::min)(shard_count, max_shards));
+  // Use a dedicated client with one channel per shard, the shards upload
+  // over independent `MutateRows` streams instead of contending for the
+  // default connection pool.
+  auto client = MakeDataClient(static_cast<std::size_t>(shard_count));
   std::cout << "# Populating table " << setup_.table_id() << " " << std::flush;
   std::vector<std::future<google::cloud::StatusOr<BenchmarkResult>>> tasks;
   auto upload_start = std::chrono::steady_clock::now();
-  auto table_size = setup_.table_size();
+  long const shard_size = (table_size + shard_count - 1) / shard_count;
   long shard_start = 0;
-  for (int i = 0; i != kPopulateShardCount; ++i) {
-    long end =
-        std::min(table_size, shard_start + table_size / kPopulateShardCount);
-    tasks.emplace_back(std::async(std::launch::async,
-                                  &Benchmark::PopulateTableShard, this,
-                                  std::ref(table), shard_start, end));
+  for (int i = 0; i != shard_count; ++i) {
+    long end = std::min(table_size, shard_start + shard_size);
+    tasks.emplace_back(
+        std::async(std::launch::async, &Benchmark::PopulateTableShard, this,
+                   bigtable::Table(client, setup_.app_profile_id(),
+                                   setup_.table_id()),
+                   shard_start, end));
     shard_start = end;
   }
 
@@ -253,7 +273,7 @@ int Benchmark::read_rows_count() const {
 }
 
 google::cloud::StatusOr<BenchmarkResult> Benchmark::PopulateTableShard(
-    bigtable::Table& table, long begin, long end) {
+    bigtable::Table table, long begin, long end) {
   auto start = std::chrono::steady_clock::now();
   BenchmarkResult result{};
   result.row_count = 0;
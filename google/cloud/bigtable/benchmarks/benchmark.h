@@ -63,6 +63,15 @@ class Benchmark {
   /// Return a `bigtable::DataClient` configured for this benchmark.
   std::shared_ptr<bigtable::DataClient> MakeDataClient();
 
+  /**
+   * Return a `bigtable::DataClient` with a custom connection pool size.
+   *
+   * The scaling sweep benchmark measures each configuration with a
+   * fresh client, overriding the pool size picked by the common setup.
+   */
+  std::shared_ptr<bigtable::DataClient> MakeDataClient(
+      std::size_t connection_pool_size);
+
   /// Create a random key.
   std::string MakeRandomKey(google::cloud::internal::DefaultPRNG& gen) const;
 
@@ -119,7 +128,7 @@ class Benchmark {
  private:
   /// Populate the table rows in the range [@p begin, @p end)
   google::cloud::StatusOr<BenchmarkResult> PopulateTableShard(
-      bigtable::Table& table, long begin, long end);
+      bigtable::Table table, long begin, long end);
 
   /**
    * Return how much space to reserve for digits if the table has @p table_size
@@ -135,6 +144,37 @@ class Benchmark {
   std::thread server_thread_;
 };
 
+/**
+ * Generate Poisson arrival times for open-loop benchmarks.
+ *
+ * Closed-loop benchmarks start an operation when the previous one
+ * completes, so a slow response delays the requests behind it and the
+ * recorded latencies under-report the stall (the "coordinated
+ * omission" problem).  An open-loop benchmark draws the operation start
+ * times from a Poisson process at a fixed target rate, and measures
+ * each operation from its *intended* start time, whether or not the
+ * client had to queue the operation.
+ */
+class PoissonArrivalSchedule {
+ public:
+  PoissonArrivalSchedule(double target_qps,
+                         std::chrono::steady_clock::time_point start)
+      : interarrival_(target_qps), next_(start) {}
+
+  /// Return the intended start time for the next operation.
+  std::chrono::steady_clock::time_point NextArrival(
+      google::cloud::internal::DefaultPRNG& gen) {
+    std::chrono::duration<double> seconds(interarrival_(gen));
+    next_ += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        seconds);
+    return next_;
+  }
+
+ private:
+  std::exponential_distribution<double> interarrival_;
+  std::chrono::steady_clock::time_point next_;
+};
+
 /// Helper class to pretty print durations.
 struct FormatDuration {
   template <typename Rep, typename Period>
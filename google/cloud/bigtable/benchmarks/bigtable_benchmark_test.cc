@@ -200,3 +200,29 @@ TEST(BenchmarkTest, PrintCsv) {
   // The output includes the throughput.
   EXPECT_THAT(output, HasSubstr(",123,"));
 }
+
+TEST(BenchmarkTest, PoissonArrivalSchedule) {
+  auto start = std::chrono::steady_clock::now();
+  // Use a high rate so the test can draw many samples over a short
+  // simulated period.
+  PoissonArrivalSchedule schedule(10000.0, start);
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+
+  int const count = 10000;
+  auto previous = start;
+  std::chrono::steady_clock::duration total(0);
+  for (int i = 0; i != count; ++i) {
+    auto arrival = schedule.NextArrival(generator);
+    EXPECT_GE(arrival, previous);
+    total += arrival - previous;
+    previous = arrival;
+  }
+  // The mean inter-arrival time should be close to 1/rate, i.e. 100us.
+  // With 10,000 samples the mean has a standard error of about 1us, so
+  // these (wide) bounds keep the test stable.
+  auto mean_usec =
+      std::chrono::duration_cast<std::chrono::microseconds>(total).count() /
+      count;
+  EXPECT_GT(mean_usec, 50);
+  EXPECT_LT(mean_usec, 200);
+}
@@ -48,9 +48,18 @@ constexpr int kDefaultThreads = 8;
 /// How long does the test last by default.
 constexpr int kDefaultTestDuration = 30;
 
-/// How many shards are used to populate the table.
+/// The minimum number of shards used to populate the table.
 constexpr int kPopulateShardCount = 10;
 
+/**
+ * How many populate shards to run per benchmark thread.
+ *
+ * Each shard alternates between generating mutations and waiting for a
+ * synchronous `BulkApply()`, running more shards than channels keeps the
+ * channels busy during the generation gaps.
+ */
+constexpr int kPopulateShardsPerThread = 2;
+
 /// How many times each PopulateTable shard reports progress.
 constexpr int kPopulateShardProgressMarks = 4;
 
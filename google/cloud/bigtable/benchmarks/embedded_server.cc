@@ -20,6 +20,7 @@
 #include <atomic>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 namespace btproto = google::bigtable::v2;
 namespace btadmin = google::bigtable::admin::v2;
@@ -39,21 +40,41 @@ namespace benchmarks {
  */
 class BigtableImpl final : public btproto::Bigtable::Service {
  public:
-  BigtableImpl()
-      : mutate_row_count_(0), mutate_rows_count_(0), read_rows_count_(0) {
+  explicit BigtableImpl(EmbeddedServerConfig config)
+      : config_(std::move(config)),
+        mutate_row_count_(0),
+        mutate_rows_count_(0),
+        read_rows_count_(0) {
     // Prepare a list of random values to use at run-time.  This is because we
     // want the overhead of this implementation to be as small as possible.
     // Using a single value is an option, but compresses too well and makes the
     // tests a bit unrealistic.
+    static std::string const chars(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
     auto generator = google::cloud::internal::MakeDefaultPRNG();
     values_.resize(1000);
-    std::generate(values_.begin(), values_.end(),
-                  [&generator]() { return MakeRandomValue(generator); });
+    std::generate(values_.begin(), values_.end(), [this, &generator]() {
+      return google::cloud::internal::Sample(generator, config_.value_size,
+                                             chars);
+    });
+    // Pre-compute the `ReadRows()` response messages, so serving a
+    // stream does not build protos on the critical path.  A single
+    // message would compress too well, so keep a handful and serve
+    // them round-robin.
+    long row_id = 0;
+    std::size_t value_idx = 0;
+    responses_.resize(8);
+    for (auto& msg : responses_) {
+      for (int i = 0; i != config_.rows_per_response; ++i) {
+        AppendRow(msg, row_id++, value_idx);
+      }
+    }
   }
 
   grpc::Status MutateRow(grpc::ServerContext*, btproto::MutateRowRequest const*,
                          btproto::MutateRowResponse*) override {
     ++mutate_row_count_;
+    MaybeInjectDelay();
     return grpc::Status::OK;
   }
 
@@ -67,6 +88,7 @@ class BigtableImpl final : public btproto::Bigtable::Service {
       entry.set_index(index);
       entry.mutable_status()->set_code(grpc::StatusCode::OK);
     }
+    MaybeInjectDelay();
     writer->WriteLast(msg, grpc::WriteOptions());
     return grpc::Status::OK;
   }
@@ -80,38 +102,32 @@ class BigtableImpl final : public btproto::Bigtable::Service {
       rows_limit = request->rows_limit();
     }
 
-    btproto::ReadRowsResponse msg;
-    for (std::int64_t i = 0; i != rows_limit; ++i) {
-      std::size_t idx = 0;
-      char const* cf = kColumnFamily;
-      std::ostringstream os;
-      os << "user" << std::setw(12) << std::setfill('0') << i;
-      std::string row_key = os.str();
-      for (int j = 0; j != kNumFields; ++j) {
-        auto& chunk = *msg.add_chunks();
-        // This is neither the real format of the keys, nor the keys requested,
-        // but it is good enough for a simulation.
-        chunk.set_row_key(row_key);
-        chunk.set_timestamp_micros(0);
-        chunk.mutable_family_name()->set_value(cf);
-        chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
-        chunk.set_value(values_[idx]);
-        chunk.set_value_size(static_cast<std::int32_t>(values_[idx].size()));
-        if (++idx >= values_.size()) {
-          idx = 0;
+    std::int64_t remaining = rows_limit;
+    std::size_t next = 0;
+    while (remaining > 0) {
+      MaybeInjectDelay();
+      if (remaining >= config_.rows_per_response) {
+        auto const& msg = responses_[next];
+        next = (next + 1) % responses_.size();
+        remaining -= config_.rows_per_response;
+        if (remaining == 0) {
+          writer->WriteLast(msg, grpc::WriteOptions());
+        } else {
+          writer->Write(msg);
         }
-        cf = "";
-        if (j == kNumFields - 1) {
-          chunk.set_value_size(0);
-          chunk.set_commit_row(true);
+      } else {
+        // Serve the tail of the stream by copying the first `remaining`
+        // rows of one of the pre-computed messages.
+        auto const& full = responses_[next];
+        btproto::ReadRowsResponse msg;
+        int chunk_count = static_cast<int>(remaining) * kNumFields;
+        for (int i = 0; i != chunk_count; ++i) {
+          *msg.add_chunks() = full.chunks(i);
         }
-      }
-      if (i != request->rows_limit() - 1) {
-        writer->Write(msg);
-        msg = {};
+        remaining = 0;
+        writer->WriteLast(msg, grpc::WriteOptions());
       }
     }
-    writer->WriteLast(msg, grpc::WriteOptions());
     return grpc::Status::OK;
   }
 
@@ -120,7 +136,50 @@ class BigtableImpl final : public btproto::Bigtable::Service {
   int read_rows_count() const { return read_rows_count_.load(); }
 
  private:
+  /// Append the chunks for one row to @p msg.
+  void AppendRow(btproto::ReadRowsResponse& msg, long row_id,
+                 std::size_t& value_idx) {
+    char const* cf = kColumnFamily;
+    std::ostringstream os;
+    os << "user" << std::setw(12) << std::setfill('0') << row_id;
+    std::string row_key = os.str();
+    for (int j = 0; j != kNumFields; ++j) {
+      auto& chunk = *msg.add_chunks();
+      // This is neither the real format of the keys, nor the keys requested,
+      // but it is good enough for a simulation.
+      chunk.set_row_key(row_key);
+      chunk.set_timestamp_micros(0);
+      chunk.mutable_family_name()->set_value(cf);
+      chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
+      chunk.set_value(values_[value_idx]);
+      chunk.set_value_size(
+          static_cast<std::int32_t>(values_[value_idx].size()));
+      if (++value_idx >= values_.size()) {
+        value_idx = 0;
+      }
+      cf = "";
+      if (j == kNumFields - 1) {
+        chunk.set_value_size(0);
+        chunk.set_commit_row(true);
+      }
+    }
+  }
+
+  /// Sleep for an exponentially distributed delay, if configured.
+  void MaybeInjectDelay() {
+    if (config_.mean_response_delay.count() == 0) {
+      return;
+    }
+    thread_local auto generator = google::cloud::internal::MakeDefaultPRNG();
+    std::exponential_distribution<double> delay(
+        1.0 / static_cast<double>(config_.mean_response_delay.count()));
+    std::this_thread::sleep_for(
+        std::chrono::duration<double, std::micro>(delay(generator)));
+  }
+
+  EmbeddedServerConfig config_;
   std::vector<std::string> values_;
+  std::vector<btproto::ReadRowsResponse> responses_;
   std::atomic<int> mutate_row_count_;
   std::atomic<int> mutate_rows_count_;
   std::atomic<int> read_rows_count_;
@@ -160,11 +219,19 @@ class TableAdminImpl final : public btadmin::BigtableTableAdmin::Service {
 /// The implementation of EmbeddedServer.
 class DefaultEmbeddedServer : public EmbeddedServer {
  public:
-  explicit DefaultEmbeddedServer() {
+  explicit DefaultEmbeddedServer(EmbeddedServerConfig config)
+      : bigtable_service_(std::move(config)) {
     int port;
     std::string server_address("[::]:0");
     builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
                               &port);
+    // Use one completion queue (and its polling threads) per core, the
+    // benchmarks should measure the client, not a server starved for
+    // polling threads.
+    auto cores = std::thread::hardware_concurrency();
+    int num_cqs = cores == 0 ? 4 : static_cast<int>(cores);
+    builder_.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS,
+                                 num_cqs);
     builder_.RegisterService(&bigtable_service_);
     builder_.RegisterService(&admin_service_);
     server_ = builder_.BuildAndStart();
@@ -200,7 +267,13 @@ class DefaultEmbeddedServer : public EmbeddedServer {
 };
 
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer() {
-  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer);
+  return CreateEmbeddedServer(EmbeddedServerConfig{});
+}
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerConfig config) {
+  return std::unique_ptr<EmbeddedServer>(
+      new DefaultEmbeddedServer(std::move(config)));
 }
 
 }  // namespace benchmarks
@@ -15,6 +15,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -46,9 +48,38 @@ class EmbeddedServer {
   virtual int read_rows_count() const = 0;
 };
 
-/// Create an embedded server.
+/**
+ * Configure the traffic shape of the embedded server.
+ *
+ * The server must not become the bottleneck before the client does, or
+ * the benchmarks measure the server instead of the client.  These knobs
+ * control the shape of the `ReadRows()` responses and (optionally)
+ * inject server-side latency, so the benchmarks can reproduce the
+ * response sizes and jitter of a production backend.
+ */
+struct EmbeddedServerConfig {
+  /// The size of each cell value in `ReadRows()` responses.
+  int value_size = kFieldSize;
+
+  /// How many rows are packed into each `ReadRows()` response message.
+  int rows_per_response = 100;
+
+  /**
+   * The mean of the delay injected before each response.
+   *
+   * The delays are drawn from an exponential distribution with this
+   * mean; a zero mean (the default) disables the injected delay.
+   */
+  std::chrono::microseconds mean_response_delay{0};
+};
+
+/// Create an embedded server with the default configuration.
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer();
 
+/// Create an embedded server with a custom configuration.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerConfig config);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
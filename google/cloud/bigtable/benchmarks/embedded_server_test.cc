@@ -127,6 +127,59 @@ TEST(EmbeddedServer, ReadRows1) {
   wait_thread.join();
 }
 
+TEST(EmbeddedServer, ReadRowsConfiguredChunking) {
+  EmbeddedServerConfig config;
+  config.value_size = 16;
+  config.rows_per_response = 7;
+  auto server = CreateEmbeddedServer(config);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "fake-project", "fake-instance", options),
+                        "fake-table");
+
+  // 100 rows requires a partial response at the end of the stream.
+  auto reader =
+      table.ReadRows(bigtable::RowSet(bigtable::RowRange::StartingAt("foo")),
+                     100, bigtable::Filter::PassAllFilter());
+  auto count = std::distance(reader.begin(), reader.end());
+  EXPECT_EQ(100, count);
+  EXPECT_EQ(1, server->read_rows_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, ReadRowsInjectedDelay) {
+  EmbeddedServerConfig config;
+  config.rows_per_response = 10;
+  config.mean_response_delay = std::chrono::microseconds(2000);
+  auto server = CreateEmbeddedServer(config);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "fake-project", "fake-instance", options),
+                        "fake-table");
+
+  auto start = std::chrono::steady_clock::now();
+  auto reader =
+      table.ReadRows(bigtable::RowSet(bigtable::RowRange::StartingAt("foo")),
+                     50, bigtable::Filter::PassAllFilter());
+  auto count = std::distance(reader.begin(), reader.end());
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(50, count);
+  // The stream has 5 responses, each delayed by 2ms on average; the
+  // probability of the sum being under 1ms is less than 1 in 10^6.
+  EXPECT_GE(elapsed, std::chrono::milliseconds(1));
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
 TEST(EmbeddedServer, ReadRows100) {
   auto server = CreateEmbeddedServer();
   std::thread wait_thread([&server]() { server->Wait(); });
@@ -14,9 +14,12 @@
 
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
 #include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/bigtable/benchmarks/resource_usage.h"
+#include <atomic>
 #include <future>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 /**
  * @file
@@ -46,6 +49,15 @@
  * The test then waits for all the threads to finish and reports effective
  * throughput.
  *
+ * While the threads run, a sampler thread periodically records the
+ * process RSS, the allocator heap usage, and the total number of
+ * outstanding requests in the client.  At the end of the run the
+ * benchmark fits a line through the RSS samples; if the RSS grows
+ * faster than a threshold (in KiB per hour, configurable as a trailing
+ * command-line argument) the benchmark reports a regression and exits
+ * with a non-zero status, so long CI runs detect leaks and heap
+ * fragmentation.
+ *
  * Using a command-line parameter the benchmark can be configured to create a
  * local gRPC server that implements the Cloud Bigtable APIs used by the
  * benchmark.  If this parameter is not used the benchmark uses the default
@@ -60,8 +72,13 @@ using namespace bigtable::benchmarks;
 
 /// Run an iteration of the test, returns the number of operations.
 google::cloud::StatusOr<long> RunBenchmark(
-    bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration);
+    bigtable::benchmarks::Benchmark& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client,
+    std::string app_profile_id, std::string const& table_id,
+    std::chrono::seconds test_duration);
+
+/// If the RSS grows faster than this, report a regression.
+constexpr long kDefaultRssThresholdKiBPerHour = 16 * 1024;
 
 }  // anonymous namespace
 
@@ -72,10 +89,25 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
+  // The common setup leaves any unconsumed arguments in place, use the
+  // first one (if any) as the RSS growth threshold.
+  long rss_threshold = kDefaultRssThresholdKiBPerHour;
+  if (argc > 1) {
+    rss_threshold = std::stol(argv[1]);
+    if (rss_threshold <= 0) {
+      std::cerr << "rss-threshold-kib-per-hour should be > 0\n";
+      return -1;
+    }
+  }
+
   Benchmark benchmark(*setup);
   // Create and populate the table for the benchmark.
   benchmark.CreateTable();
 
+  // All the threads share one client, so the sampler below sees the
+  // queue depth of the connections that the threads actually use.
+  auto data_client = benchmark.MakeDataClient();
+
   // Start the threads running the latency test.
   std::cout << "# Running Endurance Benchmark:\n";
   auto latency_test_start = std::chrono::steady_clock::now();
@@ -87,10 +119,49 @@ int main(int argc, char* argv[]) {
       launch_policy = std::launch::deferred;
     }
     tasks.emplace_back(std::async(launch_policy, RunBenchmark,
-                                  std::ref(benchmark), setup->app_profile_id(),
-                                  setup->table_id(), setup->test_duration()));
+                                  std::ref(benchmark), data_client,
+                                  setup->app_profile_id(), setup->table_id(),
+                                  setup->test_duration()));
   }
 
+  // Periodically sample the resource usage of the process.
+  auto take_sample = [&data_client, latency_test_start] {
+    long depth = 0;
+    for (auto d : data_client->channel_queue_depths()) {
+      depth += d;
+    }
+    ResourceUsageSample sample{
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - latency_test_start),
+        CurrentRssKiB(), CurrentHeapKiB(), depth};
+    std::cout << "# resource sample: t=" << FormatDuration(sample.elapsed)
+              << " rss=" << sample.rss_kib << "KiB heap=" << sample.heap_kib
+              << "KiB queue-depth=" << sample.queue_depth << "\n";
+    return sample;
+  };
+  auto sample_period = setup->test_duration() / 20;
+  if (sample_period > std::chrono::seconds(60)) {
+    sample_period = std::chrono::seconds(60);
+  }
+  if (sample_period < std::chrono::seconds(1)) {
+    sample_period = std::chrono::seconds(1);
+  }
+  std::vector<ResourceUsageSample> samples;
+  samples.push_back(take_sample());
+  std::atomic<bool> sampling_done(false);
+  std::thread sampler([&] {
+    auto next = latency_test_start + sample_period;
+    while (!sampling_done.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      auto now = std::chrono::steady_clock::now();
+      if (now < next) {
+        continue;
+      }
+      next = now + sample_period;
+      samples.push_back(take_sample());
+    }
+  });
+
   // Wait for the threads and combine all the results.
   long combined = 0;
   int count = 0;
@@ -104,6 +175,10 @@ int main(int argc, char* argv[]) {
     }
     ++count;
   }
+  sampling_done.store(true);
+  sampler.join();
+  samples.push_back(take_sample());
+
   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - latency_test_start);
   auto throughput = 1000.0 * combined / elapsed.count();
@@ -111,8 +186,17 @@ int main(int argc, char* argv[]) {
             << ", Ops=" << combined << ", Throughput: " << throughput
             << " ops/sec\n";
 
+  int exit_code = 0;
+  auto growth = RssGrowthRate(samples);
+  std::cout << "# RSS growth=" << growth
+            << " KiB/hour, threshold=" << rss_threshold << " KiB/hour\n";
+  if (growth > static_cast<double>(rss_threshold)) {
+    std::cout << "# REGRESSION: RSS grows faster than the threshold\n";
+    exit_code = 2;
+  }
+
   benchmark.DeleteTable();
-  return 0;
+  return exit_code;
 }
 
 namespace {
@@ -143,11 +227,12 @@ OperationResult RunOneReadRow(bigtable::Table& table,
 }
 
 google::cloud::StatusOr<long> RunBenchmark(
-    bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration) {
+    bigtable::benchmarks::Benchmark& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client,
+    std::string app_profile_id, std::string const& table_id,
+    std::chrono::seconds test_duration) {
   BenchmarkResult partial = {};
 
-  auto data_client = benchmark.MakeDataClient();
   bigtable::Table table(std::move(data_client), app_profile_id, table_id);
 
   auto generator = google::cloud::internal::MakeDefaultPRNG();
@@ -0,0 +1,332 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/cell_visitor.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the CPU cost of the `ReadRows()` parsing path in isolation.
+ *
+ * The scan benchmarks (`scan_throughput_benchmark` and friends) measure
+ * the client end-to-end, so a parser change is hidden behind network and
+ * server variance.  This benchmark feeds synthetic, pre-computed chunk
+ * streams directly into the `internal::ReadRowsParser` entry points, no
+ * server or network is involved, so runs are reproducible enough to
+ * compare parser changes against each other.
+ *
+ * The benchmark sweeps a small grid of stream shapes:
+ * - the cell value size,
+ * - the number of chunks each cell is split across, and
+ * - the number of rows packed into each `ReadRowsResponse` message.
+ *
+ * Each shape is parsed in three modes: accumulating `Row` objects (the
+ * `ReadRows()` path), delivering borrowed cells to a `CellVisitor` (the
+ * `ScanRows()` path), and the visitor combined with relaxed validation.
+ * Note that relaxed validation is only effective in `NDEBUG` builds.
+ * Every combination runs through both entry points: chunk at a time via
+ * `HandleChunk()`, and a whole response at a time via `HandleResponse()`.
+ *
+ * It also measures the construction cost of typical `Filter`
+ * expressions, which the client rebuilds for each retry attempt.
+ *
+ * This benchmark requires no project or instance, the only (optional)
+ * command-line argument is the number of seconds to spend on each cell
+ * of the grid:
+ *
+ * @code
+ * ./parser_benchmark [seconds-per-config (default 5)]
+ * @endcode
+ */
+
+/// Helper functions and types for the parser_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+constexpr int kDefaultSecondsPerConfig = 5;
+
+/// The number of rows in each synthetic stream.
+constexpr int kRowsPerStream = 1000;
+
+/// The shape of a synthetic chunk stream.
+struct StreamConfig {
+  int value_size;
+  int chunks_per_cell;
+  int rows_per_response;
+};
+
+constexpr StreamConfig kStreamConfigs[] = {
+    {16, 1, 1},    {16, 1, 100},   {256, 1, 1},  {256, 1, 100},
+    {256, 4, 100}, {4096, 1, 100}, {4096, 4, 100},
+};
+
+/// How the parsed cells are consumed.
+enum class ParseMode { kAccumulateRows, kVisitor, kVisitorRelaxed };
+
+char const* ParseModeName(ParseMode mode) {
+  switch (mode) {
+    case ParseMode::kAccumulateRows:
+      return "rows";
+    case ParseMode::kVisitor:
+      return "visitor";
+    case ParseMode::kVisitorRelaxed:
+      return "visitor-relaxed";
+  }
+  return "unknown";
+}
+
+/// Which parser entry point feeds the stream.
+enum class ParseApi { kHandleChunk, kHandleResponse };
+
+char const* ParseApiName(ParseApi api) {
+  switch (api) {
+    case ParseApi::kHandleChunk:
+      return "HandleChunk";
+    case ParseApi::kHandleResponse:
+      return "HandleResponse";
+  }
+  return "unknown";
+}
+
+/// Counts what it receives, so the parsing work cannot be elided.
+class CountingVisitor : public bigtable::CellVisitor {
+ public:
+  void OnCell(bigtable::RowKeyType const&, std::string const&,
+              bigtable::ColumnQualifierType const&, std::int64_t,
+              bigtable::CellValueType const& value,
+              std::vector<std::string> const&) override {
+    ++cells;
+    bytes += value.size();
+  }
+
+  long cells = 0;
+  long bytes = 0;
+};
+
+/// The totals for one cell of the benchmark grid.
+struct ParseResult {
+  std::chrono::milliseconds elapsed;
+  long cells;
+  long bytes;
+  long streams;
+};
+
+std::vector<google::bigtable::v2::ReadRowsResponse> MakeStream(
+    StreamConfig const& config);
+ParseResult RunParserBenchmark(
+    std::vector<google::bigtable::v2::ReadRowsResponse> const& stream,
+    ParseMode mode, ParseApi api, std::chrono::seconds test_duration);
+void RunFilterBenchmark(std::chrono::seconds test_duration);
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto test_duration = std::chrono::seconds(kDefaultSecondsPerConfig);
+  if (argc >= 2) {
+    test_duration = std::chrono::seconds(std::stoi(argv[1]));
+  }
+
+  std::cout << "Name,ValueSize,ChunksPerCell,RowsPerResponse,Mode"
+            << ",Count,StreamCount,ElapsedMilliseconds"
+            << ",OpsPerSecond,MiBPerSecond\n";
+  for (auto const& config : kStreamConfigs) {
+    auto stream = MakeStream(config);
+    for (auto api : {ParseApi::kHandleChunk, ParseApi::kHandleResponse}) {
+      for (auto mode : {ParseMode::kAccumulateRows, ParseMode::kVisitor,
+                        ParseMode::kVisitorRelaxed}) {
+        std::cerr << "# Running parser benchmark [v=" << config.value_size
+                  << ", c=" << config.chunks_per_cell
+                  << ", r=" << config.rows_per_response
+                  << ", api=" << ParseApiName(api)
+                  << ", mode=" << ParseModeName(mode) << "] " << std::flush;
+        auto result = RunParserBenchmark(stream, mode, api, test_duration);
+        auto seconds = static_cast<double>(result.elapsed.count()) / 1000.0;
+        std::cerr << "DONE. Elapsed=" << FormatDuration(result.elapsed)
+                  << ", Cells=" << result.cells << "\n";
+        std::cout << ParseApiName(api) << "," << config.value_size << ","
+                  << config.chunks_per_cell << "," << config.rows_per_response
+                  << "," << ParseModeName(mode) << "," << result.cells << ","
+                  << result.streams << "," << result.elapsed.count() << ","
+                  << std::fixed << std::setprecision(0)
+                  << static_cast<double>(result.cells) / seconds << ","
+                  << std::setprecision(2)
+                  << static_cast<double>(result.bytes) / seconds /
+                         (1024.0 * 1024.0)
+                  << "\n";
+      }
+    }
+  }
+
+  RunFilterBenchmark(test_duration);
+
+  return 0;
+}
+
+namespace {
+std::vector<google::bigtable::v2::ReadRowsResponse> MakeStream(
+    StreamConfig const& config) {
+  std::vector<google::bigtable::v2::ReadRowsResponse> stream;
+  std::string const value(static_cast<std::size_t>(config.value_size), 'x');
+  int row_id = 0;
+  while (row_id != kRowsPerStream) {
+    google::bigtable::v2::ReadRowsResponse response;
+    for (int r = 0; r != config.rows_per_response && row_id != kRowsPerStream;
+         ++r, ++row_id) {
+      std::ostringstream os;
+      os << "user" << std::setw(12) << std::setfill('0') << row_id;
+      std::string row_key = os.str();
+      for (int f = 0; f != kNumFields; ++f) {
+        int piece = config.value_size / config.chunks_per_cell;
+        for (int c = 0; c != config.chunks_per_cell; ++c) {
+          auto& chunk = *response.add_chunks();
+          if (f == 0 && c == 0) {
+            chunk.set_row_key(row_key);
+            chunk.mutable_family_name()->set_value(kColumnFamily);
+          }
+          if (c == 0) {
+            chunk.mutable_qualifier()->set_value("field" + std::to_string(f));
+            chunk.set_timestamp_micros(0);
+          }
+          if (c == config.chunks_per_cell - 1) {
+            // The last chunk of a cell has a zero value size, and gets
+            // any bytes the integer division above left over.
+            chunk.set_value(value.substr(
+                static_cast<std::size_t>(c) * static_cast<std::size_t>(piece)));
+            chunk.set_value_size(0);
+            if (f == kNumFields - 1) {
+              chunk.set_commit_row(true);
+            }
+          } else {
+            chunk.set_value(value.substr(
+                static_cast<std::size_t>(c) * static_cast<std::size_t>(piece),
+                static_cast<std::size_t>(piece)));
+            chunk.set_value_size(config.value_size);
+          }
+        }
+      }
+    }
+    stream.push_back(std::move(response));
+  }
+  return stream;
+}
+
+ParseResult RunParserBenchmark(
+    std::vector<google::bigtable::v2::ReadRowsResponse> const& stream,
+    ParseMode mode, ParseApi api, std::chrono::seconds test_duration) {
+  ParseResult result{std::chrono::milliseconds(0), 0, 0, 0};
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + test_duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    // The parser is stateful and must not be recycled across streams,
+    // each pass over the pre-computed messages is a new stream.
+    bigtable::internal::ReadRowsParser parser;
+    CountingVisitor visitor;
+    if (mode != ParseMode::kAccumulateRows) {
+      parser.SetVisitor(&visitor);
+    }
+    if (mode == ParseMode::kVisitorRelaxed) {
+      parser.SetRelaxedValidation(true);
+    }
+    grpc::Status status;
+    auto take_rows = [&] {
+      while (parser.HasNext()) {
+        auto row = parser.Next(status);
+        result.cells += static_cast<long>(row.cells().size());
+        for (auto const& cell : row.cells()) {
+          result.bytes += static_cast<long>(cell.value().size());
+        }
+      }
+    };
+    for (auto const& response : stream) {
+      if (api == ParseApi::kHandleResponse) {
+        // Copy the pre-computed message, the parser consumes its chunks.
+        // The HandleChunk() branch below copies each chunk too, so the
+        // comparison between the entry points stays fair.
+        auto copy = response;
+        parser.HandleResponse(std::move(copy), status);
+        if (!status.ok()) {
+          std::cerr << "HandleResponse() failed: " << status.error_message()
+                    << "\n";
+          std::exit(1);
+        }
+        take_rows();
+      } else {
+        for (auto const& chunk : response.chunks()) {
+          parser.HandleChunk(chunk, status);
+          if (!status.ok()) {
+            std::cerr << "HandleChunk() failed: " << status.error_message()
+                      << "\n";
+            std::exit(1);
+          }
+          take_rows();
+        }
+      }
+    }
+    parser.HandleEndOfStream(status);
+    if (!status.ok()) {
+      std::cerr << "HandleEndOfStream() failed: " << status.error_message()
+                << "\n";
+      std::exit(1);
+    }
+    result.cells += visitor.cells;
+    result.bytes += visitor.bytes;
+    ++result.streams;
+  }
+  result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+void RunFilterBenchmark(std::chrono::seconds test_duration) {
+  std::cerr << "# Running filter construction benchmark " << std::flush;
+  // Accumulate a value derived from each filter, otherwise the compiler
+  // could remove the constructions altogether.
+  std::size_t checksum = 0;
+  long count = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + test_duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    auto simple = bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0",
+                                                      "field9");
+    auto chain = bigtable::Filter::Chain(
+        bigtable::Filter::FamilyRegex(kColumnFamily),
+        bigtable::Filter::Latest(1),
+        bigtable::Filter::ValueRangeClosed("a", "z"));
+    auto interleave = bigtable::Filter::Interleave(
+        bigtable::Filter::ColumnName(kColumnFamily, "field0"),
+        bigtable::Filter::ColumnName(kColumnFamily, "field1"));
+    checksum += simple.as_proto().ByteSizeLong();
+    checksum += chain.as_proto().ByteSizeLong();
+    checksum += interleave.as_proto().ByteSizeLong();
+    count += 3;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  auto seconds = static_cast<double>(elapsed.count()) / 1000.0;
+  std::cerr << "DONE. Elapsed=" << FormatDuration(elapsed)
+            << ", Filters=" << count << " (checksum=" << checksum << ")\n";
+  std::cout << "FilterConstruction,0,0,0,default," << count << ",0,"
+            << elapsed.count() << "," << std::fixed << std::setprecision(0)
+            << static_cast<double>(count) / seconds << ",0.00\n";
+}
+
+}  // anonymous namespace
@@ -0,0 +1,89 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/resource_usage.h"
+#include <fstream>
+#if defined(__linux__)
+#include <malloc.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+
+long CurrentRssKiB() {
+#if defined(__linux__)
+  // The second field of /proc/self/statm is the resident set size in
+  // pages.  getrusage(2) only reports the peak, which cannot detect
+  // growth after the peak is reached.
+  std::ifstream statm("/proc/self/statm");
+  long size_pages;
+  long rss_pages;
+  if (!(statm >> size_pages >> rss_pages)) {
+    return -1;
+  }
+  return rss_pages * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+  return -1;
+#endif  // __linux__
+}
+
+long CurrentHeapKiB() {
+#if defined(__GLIBC__)
+  // mallinfo() reports sizes as `int`, so this saturates (and becomes
+  // useless) for heaps over 2GiB; the endurance benchmark heap is well
+  // below that.
+  auto info = mallinfo();
+  return static_cast<long>(info.uordblks) / 1024;
+#else
+  return -1;
+#endif  // __GLIBC__
+}
+
+double RssGrowthRate(std::vector<ResourceUsageSample> const& samples) {
+  if (samples.size() < 2) {
+    return 0;
+  }
+  double sum_t = 0;
+  double sum_r = 0;
+  double sum_tt = 0;
+  double sum_tr = 0;
+  double n = 0;
+  for (auto const& sample : samples) {
+    if (sample.rss_kib < 0) {
+      continue;
+    }
+    double hours = std::chrono::duration_cast<std::chrono::duration<double>>(
+                       sample.elapsed)
+                       .count() /
+                   3600.0;
+    sum_t += hours;
+    sum_r += static_cast<double>(sample.rss_kib);
+    sum_tt += hours * hours;
+    sum_tr += hours * static_cast<double>(sample.rss_kib);
+    n += 1;
+  }
+  double const denominator = n * sum_tt - sum_t * sum_t;
+  if (n < 2 || denominator == 0) {
+    return 0;
+  }
+  return (n * sum_tr - sum_t * sum_r) / denominator;
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
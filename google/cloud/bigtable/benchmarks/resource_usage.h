@@ -0,0 +1,69 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_RESOURCE_USAGE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_RESOURCE_USAGE_H
+
+#include <chrono>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+
+/**
+ * One sample of the process resource usage.
+ *
+ * The endurance benchmark collects these periodically to detect slow
+ * memory growth (leaks or heap fragmentation) that operation counts and
+ * latencies do not show.
+ */
+struct ResourceUsageSample {
+  /// When the sample was taken, relative to the start of the run.
+  std::chrono::milliseconds elapsed;
+
+  /// The resident set size in KiB, or -1 if not available.
+  long rss_kib;
+
+  /// The bytes in use by the C allocator in KiB, or -1 if not
+  /// available.  The difference between the RSS growth and the heap
+  /// growth points at fragmentation rather than leaks.
+  long heap_kib;
+
+  /// The total number of outstanding requests in the client, or 0 when
+  /// the client does not expose the counters.
+  long queue_depth;
+};
+
+/// Return the current resident set size in KiB, or -1 if not available.
+long CurrentRssKiB();
+
+/// Return the KiB in use by the C allocator, or -1 if not available.
+long CurrentHeapKiB();
+
+/**
+ * Return the least-squares slope of the RSS samples, in KiB per hour.
+ *
+ * Returns 0 with fewer than two samples.  A long run with a positive
+ * slope well above measurement noise indicates a leak.
+ */
+double RssGrowthRate(std::vector<ResourceUsageSample> const& samples);
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_RESOURCE_USAGE_H
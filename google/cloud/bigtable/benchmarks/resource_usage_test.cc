@@ -0,0 +1,58 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/resource_usage.h"
+#include <gmock/gmock.h>
+
+using namespace google::cloud::bigtable::benchmarks;
+
+TEST(ResourceUsage, CurrentRss) {
+  auto rss = CurrentRssKiB();
+  // -1 means "not available on this platform", anything else must be a
+  // plausible size for a running process.
+  EXPECT_TRUE(rss == -1 || rss > 0);
+}
+
+TEST(ResourceUsage, CurrentHeap) {
+  auto heap = CurrentHeapKiB();
+  EXPECT_TRUE(heap == -1 || heap >= 0);
+}
+
+TEST(ResourceUsage, RssGrowthRateEmpty) {
+  EXPECT_EQ(0, RssGrowthRate({}));
+  std::vector<ResourceUsageSample> one{
+      {std::chrono::milliseconds(0), 100, 100, 0}};
+  EXPECT_EQ(0, RssGrowthRate(one));
+}
+
+TEST(ResourceUsage, RssGrowthRateLinear) {
+  using std::chrono::milliseconds;
+  // 1000 KiB of growth per hour, sampled every half hour.
+  std::vector<ResourceUsageSample> samples{
+      {milliseconds(0), 10000, 0, 0},
+      {milliseconds(1800000), 10500, 0, 0},
+      {milliseconds(3600000), 11000, 0, 0},
+  };
+  EXPECT_NEAR(1000.0, RssGrowthRate(samples), 0.001);
+}
+
+TEST(ResourceUsage, RssGrowthRateSkipsUnavailable) {
+  using std::chrono::milliseconds;
+  std::vector<ResourceUsageSample> samples{
+      {milliseconds(0), 10000, 0, 0},
+      {milliseconds(1800000), -1, 0, 0},
+      {milliseconds(3600000), 11000, 0, 0},
+  };
+  EXPECT_NEAR(1000.0, RssGrowthRate(samples), 0.001);
+}
@@ -0,0 +1,254 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @file
+ *
+ * Measure the throughput and latency of `bigtable::Table::BulkApply()`
+ * and `bigtable::Table::ReadRow()` across a grid of configurations.
+ *
+ * The other benchmarks in this directory measure a single
+ * configuration.  Sizing the connection pool
+ * (`ClientOptions::set_connection_pool_size()`) requires measuring the
+ * full surface, so this benchmark sweeps a grid of (threads x channels
+ * x batch sizes) and reports one CSV line per operation per cell.
+ *
+ * More specifically, the benchmark:
+ *
+ * - Creates and populates a table as in the other benchmarks (see
+ *   `apply_read_latency_benchmark.cc` for the details).
+ * - For each cell in the grid it creates a new `DataClient` with the
+ *   cell's connection pool size, then starts the cell's number of
+ *   threads, each executing the following loop for S seconds:
+ *   - Build a `BulkApply()` request with the cell's batch size, using
+ *     random keys and random values, perform the operation, record the
+ *     latency and whether the operation was successful.
+ *   - Pick one of the keys at random, perform a `ReadRow()` operation,
+ *     record the latency and whether the operation was successful.
+ * - Report, for each cell, the number of operations, the latency
+ *   percentiles and the effective throughput in CSV format, naming the
+ *   cell `sweep/t<threads>/c<channels>/b<batch>`.
+ * - Delete the table.
+ *
+ * Note that the test duration argument applies to each cell, so the
+ * total running time is the number of cells times that duration.  The
+ * grids can be overridden with up to three additional (trailing)
+ * command-line arguments, each a comma-separated list: the thread
+ * counts, the channel counts, and the batch sizes.
+ */
+
+/// Helper functions and types for the scaling_sweep_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/// The results of one (threads, channels, batch size) cell.
+struct SweepCellResult {
+  BenchmarkResult bulk_apply_results;
+  BenchmarkResult read_results;
+};
+
+/// Run the workload of a single thread in one cell.
+google::cloud::StatusOr<SweepCellResult> RunCellThread(
+    bigtable::benchmarks::Benchmark& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client,
+    std::string const& app_profile_id, std::string const& table_id,
+    int batch_size, std::chrono::seconds test_duration);
+
+/// Parse a comma-separated list of positive integers.
+google::cloud::StatusOr<std::vector<int>> ParseIntList(char const* arg);
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto setup = MakeBenchmarkSetup("sweep", argc, argv);
+  if (!setup) {
+    std::cerr << setup.status() << "\n";
+    return -1;
+  }
+
+  // The common setup leaves any unconsumed arguments in place, use them
+  // (if any) to override the default grids.
+  std::vector<int> thread_counts{1, 2, 4, 8};
+  std::vector<int> channel_counts{1, 2, 4, 8};
+  std::vector<int> batch_sizes{1, 32, 128};
+  std::vector<std::vector<int>*> grids{&thread_counts, &channel_counts,
+                                       &batch_sizes};
+  for (std::size_t i = 0; i != grids.size() && argc > 1 + static_cast<int>(i);
+       ++i) {
+    auto values = ParseIntList(argv[1 + i]);
+    if (!values) {
+      std::cerr << values.status() << "\n";
+      return -1;
+    }
+    *grids[i] = *std::move(values);
+  }
+
+  Benchmark benchmark(*setup);
+
+  // Create and populate the table for the benchmark.
+  benchmark.CreateTable();
+  auto populate_results = benchmark.PopulateTable();
+  if (!populate_results) {
+    std::cerr << populate_results.status() << "\n";
+    return 1;
+  }
+
+  benchmark.PrintThroughputResult(std::cout, "sweep", "Upload",
+                                  *populate_results);
+
+  std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
+  for (int channels : channel_counts) {
+    for (int threads : thread_counts) {
+      for (int batch_size : batch_sizes) {
+        std::ostringstream os;
+        os << "sweep/t" << threads << "/c" << channels << "/b" << batch_size;
+        auto cell_name = os.str();
+        std::cerr << "# Running " << cell_name << " " << std::flush;
+
+        auto data_client =
+            benchmark.MakeDataClient(static_cast<std::size_t>(channels));
+        auto cell_start = std::chrono::steady_clock::now();
+        std::vector<std::future<google::cloud::StatusOr<SweepCellResult>>>
+            tasks;
+        for (int i = 0; i != threads; ++i) {
+          tasks.emplace_back(std::async(
+              std::launch::async, RunCellThread, std::ref(benchmark),
+              data_client, setup->app_profile_id(), setup->table_id(),
+              batch_size, setup->test_duration()));
+        }
+
+        SweepCellResult combined{};
+        auto append_ops = [](BenchmarkResult& d, BenchmarkResult const& s) {
+          d.row_count += s.row_count;
+          d.operations.insert(d.operations.end(), s.operations.begin(),
+                              s.operations.end());
+        };
+        int count = 0;
+        for (auto& future : tasks) {
+          auto result = future.get();
+          if (!result) {
+            std::cerr << "Standard exception raised by task[" << count
+                      << "]: " << result.status() << "\n";
+          } else {
+            append_ops(combined.bulk_apply_results, result->bulk_apply_results);
+            append_ops(combined.read_results, result->read_results);
+          }
+          ++count;
+        }
+        auto cell_elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - cell_start);
+        combined.bulk_apply_results.elapsed = cell_elapsed;
+        combined.read_results.elapsed = cell_elapsed;
+        std::cerr << " DONE. Elapsed=" << FormatDuration(cell_elapsed) << "\n";
+
+        std::ostringstream op;
+        op << "BulkApply(" << batch_size << ")";
+        benchmark.PrintResultCsv(std::cout, cell_name, op.str(), "Latency",
+                                 combined.bulk_apply_results);
+        benchmark.PrintResultCsv(std::cout, cell_name, "ReadRow()", "Latency",
+                                 combined.read_results);
+      }
+    }
+  }
+
+  benchmark.DeleteTable();
+
+  return 0;
+}
+
+namespace {
+
+google::cloud::StatusOr<SweepCellResult> RunCellThread(
+    bigtable::benchmarks::Benchmark& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client,
+    std::string const& app_profile_id, std::string const& table_id,
+    int batch_size, std::chrono::seconds test_duration) {
+  SweepCellResult result{};
+
+  bigtable::Table table(std::move(data_client), app_profile_id, table_id);
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+
+  auto start = std::chrono::steady_clock::now();
+  auto end = start + test_duration;
+  for (auto now = start; now < end; now = std::chrono::steady_clock::now()) {
+    bigtable::BulkMutation bulk;
+    for (int i = 0; i != batch_size; ++i) {
+      bigtable::SingleRowMutation mutation(benchmark.MakeRandomKey(generator));
+      for (int field = 0; field != kNumFields; ++field) {
+        mutation.emplace_back(MakeRandomMutation(generator, field));
+      }
+      bulk.emplace_back(std::move(mutation));
+    }
+    auto op_result = Benchmark::TimeOperation([&table, &bulk]() {
+      auto failures = table.BulkApply(std::move(bulk));
+      if (!failures.empty()) {
+        return failures.front().status();
+      }
+      return google::cloud::Status{};
+    });
+    if (!op_result.status.ok()) {
+      return op_result.status;
+    }
+    result.bulk_apply_results.operations.emplace_back(op_result);
+    result.bulk_apply_results.row_count += batch_size;
+
+    auto row_key = benchmark.MakeRandomKey(generator);
+    op_result = Benchmark::TimeOperation([&table, &row_key]() {
+      return table
+          .ReadRow(std::move(row_key), bigtable::Filter::ColumnRangeClosed(
+                                           kColumnFamily, "field0", "field9"))
+          .status();
+    });
+    if (!op_result.status.ok()) {
+      return op_result.status;
+    }
+    result.read_results.operations.emplace_back(op_result);
+    ++result.read_results.row_count;
+  }
+  return result;
+}
+
+google::cloud::StatusOr<std::vector<int>> ParseIntList(char const* arg) {
+  std::vector<int> values;
+  std::istringstream is(arg);
+  std::string token;
+  while (std::getline(is, token, ',')) {
+    auto value = std::stoi(token);
+    if (value <= 0) {
+      return google::cloud::Status(
+          google::cloud::StatusCode::kInvalidArgument,
+          "expected a comma-separated list of positive integers, got: " +
+              std::string(arg));
+    }
+    values.push_back(value);
+  }
+  if (values.empty()) {
+    return google::cloud::Status(
+        google::cloud::StatusCode::kInvalidArgument,
+        "expected a non-empty comma-separated list of integers");
+  }
+  return values;
+}
+
+}  // anonymous namespace
@@ -19,13 +19,17 @@
 bigtable_client_hdrs = [
     "admin_client.h",
     "app_profile_config.h",
+    "apply_pipeline.h",
     "async_row_reader.h",
     "cell.h",
+    "cell_batch.h",
+    "cell_visitor.h",
     "client_options.h",
     "cluster_config.h",
     "cluster_list_responses.h",
     "column_family.h",
     "completion_queue.h",
+    "completion_queue_thread_pool.h",
     "data_client.h",
     "expr.h",
     "filters.h",
@@ -45,20 +49,26 @@ bigtable_client_hdrs = [
     "internal/async_retry_unary_rpc.h",
     "internal/async_retry_unary_rpc_and_poll.h",
     "internal/bulk_mutator.h",
+    "internal/callback_executor.h",
     "internal/client_options_defaults.h",
     "internal/common_client.h",
     "internal/conjunction.h",
     "internal/google_bytes_traits.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
+    "internal/row_buffer_arena.h",
     "internal/rowreaderiterator.h",
+    "internal/rpc_metrics.h",
     "internal/rpc_policy_parameters.h",
     "internal/rpc_policy_parameters.inc",
+    "internal/timer_wheel.h",
     "internal/unary_client_utils.h",
     "metadata_update_policy.h",
     "mutation_batcher.h",
     "mutations.h",
+    "parallel_row_reader.h",
     "polling_policy.h",
+    "read_batcher.h",
     "read_modify_write_rule.h",
     "row.h",
     "row_key.h",
@@ -78,8 +88,10 @@ bigtable_client_hdrs = [
 bigtable_client_srcs = [
     "admin_client.cc",
     "app_profile_config.cc",
+    "apply_pipeline.cc",
     "client_options.cc",
     "cluster_config.cc",
+    "completion_queue_thread_pool.cc",
     "data_client.cc",
     "expr.cc",
     "iam_binding.cc",
@@ -91,15 +103,20 @@ bigtable_client_srcs = [
     "instance_update_config.cc",
     "internal/async_bulk_apply.cc",
     "internal/bulk_mutator.cc",
+    "internal/callback_executor.cc",
     "internal/common_client.cc",
     "internal/google_bytes_traits.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
     "internal/rowreaderiterator.cc",
+    "internal/rpc_metrics.cc",
+    "internal/timer_wheel.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
     "mutations.cc",
+    "parallel_row_reader.cc",
     "polling_policy.cc",
+    "read_batcher.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
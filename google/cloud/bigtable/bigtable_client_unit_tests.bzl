@@ -19,17 +19,20 @@
 bigtable_client_unit_tests = [
     "admin_client_test.cc",
     "app_profile_config_test.cc",
+    "apply_pipeline_test.cc",
     "async_list_app_profiles_test.cc",
     "async_list_clusters_test.cc",
     "async_list_instances_test.cc",
     "async_read_stream_test.cc",
     "async_row_reader_test.cc",
     "bigtable_version_test.cc",
+    "cell_batch_test.cc",
     "cell_test.cc",
     "client_options_test.cc",
     "cluster_config_test.cc",
     "column_family_test.cc",
     "completion_queue_test.cc",
+    "completion_queue_thread_pool_test.cc",
     "data_client_test.cc",
     "expr_test.cc",
     "filters_test.cc",
@@ -45,10 +48,16 @@ bigtable_client_unit_tests = [
     "internal/async_retry_multi_page_test.cc",
     "internal/async_retry_unary_rpc_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/callback_executor_test.cc",
     "internal/google_bytes_traits_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/row_buffer_arena_test.cc",
+    "internal/rpc_metrics_test.cc",
+    "internal/timer_wheel_test.cc",
     "mutation_batcher_test.cc",
     "mutations_test.cc",
+    "parallel_row_reader_test.cc",
+    "read_batcher_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
     "table_bulk_apply_test.cc",
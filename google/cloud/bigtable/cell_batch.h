@@ -0,0 +1,176 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_BATCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_BATCH_H
+
+#include "google/cloud/bigtable/cell_visitor.h"
+#include "google/cloud/bigtable/internal/google_bytes_traits.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A structure-of-arrays batch of cells for columnar consumers.
+ *
+ * Columnar ingestion pipelines convert `Row`/`Cell` objects into column
+ * vectors right after reading, touching every string twice. A `CellBatch`
+ * holds the scan output as contiguous per-column arrays instead: each
+ * string column concatenates its bytes into a single buffer with an
+ * offset array, so a scan appends each byte exactly once and consumers
+ * iterate cache-friendly arrays. Fill one with `CellBatchVisitor` and
+ * `Table::ScanRows()`.
+ *
+ * Cell labels are not captured; scans that need them should use a custom
+ * `CellVisitor`.
+ */
+class CellBatch {
+ public:
+  /// A column of strings stored as concatenated bytes plus offsets.
+  struct StringColumn {
+    /// The bytes of all the strings in the column, concatenated.
+    std::string data;
+    /// The end offset of the i-th string in `data`.
+    std::vector<std::size_t> ends;
+
+    std::size_t size() const { return ends.size(); }
+    std::size_t offset(std::size_t i) const { return i == 0 ? 0 : ends[i - 1]; }
+    std::size_t length(std::size_t i) const { return ends[i] - offset(i); }
+
+    /// Copy the i-th string out, mostly for tests and debugging.
+    std::string Get(std::size_t i) const {
+      return data.substr(offset(i), length(i));
+    }
+
+    void Append(std::string const& value) {
+      data.append(value);
+      ends.push_back(data.size());
+    }
+
+    /// Drop all but the first @p n strings.
+    void Truncate(std::size_t n) {
+      ends.resize(n);
+      data.resize(n == 0 ? 0 : ends.back());
+    }
+
+    void clear() {
+      data.clear();
+      ends.clear();
+    }
+  };
+
+  StringColumn row_keys;
+  StringColumn family_names;
+  StringColumn column_qualifiers;
+  std::vector<std::int64_t> timestamps;
+  StringColumn values;
+
+  /// The number of cells in the batch.
+  std::size_t size() const { return timestamps.size(); }
+
+  /**
+   * Decode every value in the batch as a big-endian integer of type `T`.
+   *
+   * Analytics jobs decode hundreds of millions of fixed-width counters
+   * per scan; calling `Cell::decode_big_endian_integer()` validates the
+   * value size and builds a `StatusOr<T>` once per cell. This validates
+   * the whole batch in one pass over the offset array, then converts the
+   * contiguous value bytes in a branchless byte-swap loop, so typed
+   * extraction runs at memory bandwidth.
+   *
+   * @return the decoded values, in batch order, or an error naming the
+   *     first value whose size is not `sizeof(T)`.
+   */
+  template <typename T>
+  StatusOr<std::vector<T>> DecodeBigEndianValues() const {
+    static_assert(std::is_integral<T>::value,
+                  "DecodeBigEndianValues requires an integral type");
+    auto const n = values.size();
+    for (std::size_t i = 0; i != n; ++i) {
+      if (values.length(i) != sizeof(T)) {
+        return Status(StatusCode::kInvalidArgument,
+                      "value " + std::to_string(i) + " has " +
+                          std::to_string(values.length(i)) +
+                          " bytes, expected " + std::to_string(sizeof(T)));
+      }
+    }
+    std::vector<T> result(n);
+    char const* p = values.data.data();
+    for (std::size_t i = 0; i != n; ++i, p += sizeof(T)) {
+      result[i] = internal::DecodeBigEndianUnchecked<T>(p);
+    }
+    return result;
+  }
+
+  /// Drop all but the first @p n cells.
+  void Truncate(std::size_t n) {
+    row_keys.Truncate(n);
+    family_names.Truncate(n);
+    column_qualifiers.Truncate(n);
+    timestamps.resize(n);
+    values.Truncate(n);
+  }
+
+  void clear() { Truncate(0); }
+};
+
+/**
+ * Fills a `CellBatch` from a scan, see `Table::ScanRows()`.
+ *
+ * Appends each visited cell to the batch columns. Cells of a row the
+ * service resends (see `CellVisitor::OnRowReset()`) are truncated away,
+ * the batch only ever contains cells of committed rows plus the row
+ * currently in flight.
+ */
+class CellBatchVisitor : public CellVisitor {
+ public:
+  /// The visitor appends to @p batch, which must outlive the visitor.
+  explicit CellBatchVisitor(CellBatch& batch)
+      : batch_(batch), committed_size_(batch.size()) {}
+
+  void OnCell(RowKeyType const& row_key, std::string const& family_name,
+              ColumnQualifierType const& column_qualifier,
+              std::int64_t timestamp_micros, CellValueType const& value,
+              std::vector<std::string> const&) override {
+    batch_.row_keys.Append(row_key);
+    batch_.family_names.Append(family_name);
+    batch_.column_qualifiers.Append(column_qualifier);
+    batch_.timestamps.push_back(timestamp_micros);
+    batch_.values.Append(value);
+  }
+
+  void OnRowCommitted(RowKeyType const&) override {
+    committed_size_ = batch_.size();
+  }
+
+  void OnRowReset() override { batch_.Truncate(committed_size_); }
+
+ private:
+  CellBatch& batch_;
+  std::size_t committed_size_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_BATCH_H
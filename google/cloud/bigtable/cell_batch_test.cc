@@ -0,0 +1,135 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/cell_batch.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+
+TEST(CellBatchTest, StringColumnAppendAndGet) {
+  bigtable::CellBatch::StringColumn column;
+  column.Append("one");
+  column.Append("");
+  column.Append("three");
+
+  ASSERT_EQ(3U, column.size());
+  EXPECT_EQ("one", column.Get(0));
+  EXPECT_EQ("", column.Get(1));
+  EXPECT_EQ("three", column.Get(2));
+  // The bytes are contiguous, with no per-string storage.
+  EXPECT_EQ("onethree", column.data);
+}
+
+TEST(CellBatchTest, TruncateDropsTrailingCells) {
+  bigtable::CellBatch batch;
+  bigtable::CellBatchVisitor visitor(batch);
+  visitor.OnCell("r1", "fam", "c1", 42, "v1", {});
+  visitor.OnCell("r1", "fam", "c2", 43, "v2", {});
+  ASSERT_EQ(2U, batch.size());
+
+  batch.Truncate(1);
+  ASSERT_EQ(1U, batch.size());
+  EXPECT_EQ("r1", batch.row_keys.Get(0));
+  EXPECT_EQ("v1", batch.values.Get(0));
+  EXPECT_EQ("v1", batch.values.data);
+}
+
+TEST(CellBatchTest, VisitorKeepsOnlyCommittedRowsOnReset) {
+  using google::bigtable::v2::ReadRowsResponse_CellChunk;
+  using google::protobuf::TextFormat;
+
+  bigtable::CellBatch batch;
+  bigtable::CellBatchVisitor visitor(batch);
+  google::cloud::bigtable::internal::ReadRowsParser parser;
+  parser.SetVisitor(&visitor);
+  grpc::Status status;
+
+  std::vector<std::string> chunk_texts = {
+      R"(
+        row_key: "r1"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 42
+        value: "v1"
+        commit_row: true
+        )",
+      R"(
+        row_key: "r2"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 43
+        value: "stale"
+        reset_row: true
+        )",
+      R"(
+        row_key: "r2"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 43
+        value: "v2"
+        commit_row: true
+        )",
+  };
+  for (std::string const& text : chunk_texts) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_STATUS_OK(status);
+  }
+  parser.HandleEndOfStream(status);
+  ASSERT_STATUS_OK(status);
+
+  // The reset "stale" cell was truncated away.
+  ASSERT_EQ(2U, batch.size());
+  EXPECT_EQ("r1", batch.row_keys.Get(0));
+  EXPECT_EQ("v1", batch.values.Get(0));
+  EXPECT_EQ("r2", batch.row_keys.Get(1));
+  EXPECT_EQ("v2", batch.values.Get(1));
+  EXPECT_EQ(42, batch.timestamps[0]);
+  EXPECT_EQ(43, batch.timestamps[1]);
+}
+
+TEST(CellBatchTest, DecodeBigEndianValues) {
+  bigtable::CellBatch batch;
+  bigtable::CellBatchVisitor visitor(batch);
+  std::vector<std::int64_t> expected{0, 1, -1, 343321020};
+  for (auto value : expected) {
+    visitor.OnCell("r1", "fam", "counter", 42,
+                   google::cloud::internal::EncodeBigEndian(value), {});
+  }
+
+  auto decoded = batch.DecodeBigEndianValues<std::int64_t>();
+  ASSERT_STATUS_OK(decoded);
+  EXPECT_EQ(expected, *decoded);
+}
+
+TEST(CellBatchTest, DecodeBigEndianValuesWrongSize) {
+  bigtable::CellBatch batch;
+  bigtable::CellBatchVisitor visitor(batch);
+  visitor.OnCell("r1", "fam", "counter", 42,
+                 google::cloud::internal::EncodeBigEndian(std::int64_t(7)),
+                 {});
+  visitor.OnCell("r1", "fam", "counter", 42, "too-short", {});
+
+  auto decoded = batch.DecodeBigEndianValues<std::int64_t>();
+  EXPECT_FALSE(decoded.ok());
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            decoded.status().code());
+  // The error names the offending value.
+  EXPECT_THAT(decoded.status().message(), ::testing::HasSubstr("value 1"));
+}
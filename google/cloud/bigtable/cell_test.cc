@@ -14,7 +14,7 @@
 
 #include "google/cloud/bigtable/cell.h"
 #include "google/cloud/testing_util/assert_ok.h"
-#include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 namespace bigtable = google::cloud::bigtable;
 
@@ -76,3 +76,60 @@ TEST(CellTest, SimpleNumericNegativeValue) {
   EXPECT_STATUS_OK(decoded);
   EXPECT_EQ(value, *decoded);
 }
+
+/// @test Verify Cell labels are stored and shared across copies.
+TEST(CellTest, Labels) {
+  using namespace ::testing;
+
+  std::string row_key = "row";
+  std::string family_name = "family";
+  std::string column_qualifier = "column";
+  std::int64_t timestamp = 42;
+  std::string value = "value";
+  std::vector<std::string> labels{"l1", "l2"};
+
+  bigtable::Cell cell(row_key, family_name, column_qualifier, timestamp, value,
+                      labels);
+  EXPECT_EQ(labels, cell.labels());
+
+  // Labels are immutable once the cell is created, copies share them.
+  bigtable::Cell copy = cell;
+  EXPECT_EQ(&cell.labels(), &copy.labels());
+
+  // Cells without labels return the same (empty) vector.
+  bigtable::Cell no_labels(row_key, family_name, column_qualifier, timestamp,
+                           value);
+  bigtable::Cell no_labels_too(row_key, family_name, column_qualifier,
+                               timestamp, value, std::vector<std::string>{});
+  EXPECT_TRUE(no_labels.labels().empty());
+  EXPECT_EQ(&no_labels.labels(), &no_labels_too.labels());
+}
+
+/// @test Verify the bulk decoder matches the per-cell decoder.
+TEST(CellTest, DecodeBigEndianCellValues) {
+  std::vector<std::int64_t> expected{0, 1, -1, 343321020, -343321020};
+  std::vector<bigtable::Cell> cells;
+  for (auto value : expected) {
+    cells.emplace_back("row", "family", "column", std::int64_t(42), value);
+  }
+
+  auto decoded = bigtable::DecodeBigEndianCellValues<std::int64_t>(cells);
+  ASSERT_STATUS_OK(decoded);
+  EXPECT_EQ(expected, *decoded);
+}
+
+/// @test Verify the bulk decoder rejects values of the wrong size.
+TEST(CellTest, DecodeBigEndianCellValuesWrongSize) {
+  std::vector<bigtable::Cell> cells;
+  cells.emplace_back("row", "family", "column", std::int64_t(42),
+                     std::int64_t(7));
+  cells.emplace_back("row", "family", "column", std::int64_t(42),
+                     std::string("too-short"));
+
+  auto decoded = bigtable::DecodeBigEndianCellValues<std::int64_t>(cells);
+  EXPECT_FALSE(decoded.ok());
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            decoded.status().code());
+  // The error names the offending cell.
+  EXPECT_THAT(decoded.status().message(), ::testing::HasSubstr("cell 1"));
+}
@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_VISITOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_VISITOR_H
+
+#include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/version.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Receive borrowed cell data during a scan, see `Table::ScanRows()`.
+ *
+ * Scan-and-aggregate jobs often fold each cell into an accumulator and
+ * discard it, so building owned `Cell` and `Row` objects is wasted work.
+ * `Table::ScanRows()` invokes a `CellVisitor` with references into the
+ * scan buffers instead, constructing no cells or rows at all.
+ */
+class CellVisitor {
+ public:
+  virtual ~CellVisitor() = default;
+
+  /**
+   * Called once for each cell in the scan.
+   *
+   * The references are only valid for the duration of the call, the
+   * visitor must copy any data it needs to keep.
+   */
+  virtual void OnCell(RowKeyType const& row_key, std::string const& family_name,
+                      ColumnQualifierType const& column_qualifier,
+                      std::int64_t timestamp_micros, CellValueType const& value,
+                      std::vector<std::string> const& labels) = 0;
+
+  /**
+   * Called when a row is complete, with its row key as the argument.
+   *
+   * All cells of the row have been delivered, and they will not be
+   * delivered again.
+   */
+  virtual void OnRowCommitted(RowKeyType const&) {}
+
+  /**
+   * Called when the current (uncommitted) row must be discarded.
+   *
+   * The service may resend a row it has not committed yet, e.g. after a
+   * transient stream failure. The cells delivered since the last
+   * `OnRowCommitted()` call will be delivered again. Aggregations should
+   * fold cells into per-row scratch state, merge the scratch state in
+   * `OnRowCommitted()`, and discard it here.
+   */
+  virtual void OnRowReset() {}
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_VISITOR_H
@@ -19,6 +19,8 @@
 #include "google/cloud/status.h"
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/resource_quota.h>
+#include <chrono>
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -31,6 +33,37 @@ std::string DefaultAdminEndpoint();
 std::string DefaultInstanceAdminEndpoint();
 }  // namespace internal
 
+/**
+ * The type used to hand background work to an application-owned executor.
+ *
+ * The executor is any callable that eventually runs the task it is given,
+ * typically by submitting it to a thread pool. The type is deliberately
+ * just a `std::function` so the same callable can be installed in the
+ * options of every Google Cloud C++ library in the process (for example
+ * `storage::ClientOptions` uses the same signature), letting one
+ * right-sized pool serve timers, async RPCs, and background transfers
+ * instead of each library spawning its own threads.
+ */
+using BackgroundExecutor = std::function<void(std::function<void()>)>;
+
+/**
+ * The priority lane for an individual data RPC.
+ *
+ * Large scan and batch-mutation responses can head-of-line block small
+ * point reads multiplexed on the same HTTP/2 connection. When
+ * `ClientOptions::set_bulk_connection_pool_size()` is configured the
+ * client keeps a separate channel pool for bulk traffic, and RPCs
+ * tagged `kBulk` use it, so batch work never queues ahead of
+ * latency-sensitive serving reads.
+ */
+enum class TrafficClass {
+  /// Latency-sensitive operations, e.g. point reads and single-row
+  /// mutations.
+  kServing,
+  /// Throughput-oriented operations, e.g. scans and `BulkApply()`.
+  kBulk,
+};
+
 /**
  * Configuration options for the Bigtable Client.
  *
@@ -123,6 +156,145 @@ class ClientOptions {
 
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /**
+   * Configure per-call compression for the data operations.
+   *
+   * Unlike `SetCompressionAlgorithm()`, which applies to every message
+   * on the channel, this setting is applied per call by `Table` to the
+   * payload-heavy data RPCs (`Apply`, `BulkApply`, `ReadRows`), and only
+   * when the request reaches `call_compression_threshold()`. Large cell
+   * values that compress well can cut cross-region transfer times
+   * significantly; small messages spend more CPU compressing than they
+   * save and skip it.
+   */
+  ClientOptions& set_call_compression_algorithm(
+      grpc_compression_algorithm algorithm) {
+    call_compression_algorithm_ = algorithm;
+    return *this;
+  }
+
+  /// Return the per-call compression algorithm for data operations.
+  grpc_compression_algorithm call_compression_algorithm() const {
+    return call_compression_algorithm_;
+  }
+
+  /**
+   * Configure the minimum request size (in bytes) that enables the
+   * per-call compression, zero compresses every request.
+   */
+  ClientOptions& set_call_compression_threshold(std::size_t bytes) {
+    call_compression_threshold_ = bytes;
+    return *this;
+  }
+
+  /// Return the minimum request size that enables per-call compression.
+  std::size_t call_compression_threshold() const {
+    return call_compression_threshold_;
+  }
+
+  /**
+   * Configure dynamic sizing of the connection pool.
+   *
+   * When @p size is not zero the pool may temporarily grow beyond
+   * `connection_pool_size()`, up to @p size channels, while the
+   * outstanding RPC count per channel is high — gRPC channels cap out
+   * at about 100 concurrent streams — and it shrinks back (never below
+   * `connection_pool_size()`) when the load subsides. A zero @p size
+   * (the default) keeps the pool at its fixed configured size.
+   */
+  ClientOptions& set_max_connection_pool_size(std::size_t size) {
+    max_connection_pool_size_ = size;
+    return *this;
+  }
+
+  /// Return the dynamic sizing limit of the pool, zero if disabled.
+  std::size_t max_connection_pool_size() const {
+    return max_connection_pool_size_;
+  }
+
+  /**
+   * Configure a periodic, staggered refresh of the connection pool.
+   *
+   * The server drops connections when they reach their maximum age. If
+   * all the channels in the pool were created together they all
+   * reconnect at about the same time, and the requests in flight during
+   * that storm observe much higher latency. When @p period is not zero
+   * the client proactively rebuilds one channel at a time, on a jittered
+   * schedule that cycles through the whole pool every @p period, so at
+   * most one channel is paying for a connection handshake at any time.
+   *
+   * Pick a @p period shorter than the server-side maximum connection
+   * age. A zero @p period (the default) disables the refresh.
+   */
+  ClientOptions& set_channel_refresh_period(std::chrono::milliseconds period) {
+    channel_refresh_period_ = period;
+    return *this;
+  }
+
+  /// Return the period of the staggered channel refresh, zero if disabled.
+  std::chrono::milliseconds channel_refresh_period() const {
+    return channel_refresh_period_;
+  }
+
+  /**
+   * Keep a separate channel pool for bulk traffic.
+   *
+   * When @p size is not zero the client creates @p size additional
+   * channels and routes `TrafficClass::kBulk` RPCs — scans and
+   * `BulkApply()` — through them, so their large responses cannot
+   * head-of-line block point reads on a shared HTTP/2 connection. A
+   * zero @p size (the default) disables the separate pool and all
+   * traffic shares the main channel pool.
+   */
+  ClientOptions& set_bulk_connection_pool_size(std::size_t size) {
+    bulk_connection_pool_size_ = size;
+    return *this;
+  }
+
+  /// Return the size of the bulk-traffic channel pool, zero if disabled.
+  std::size_t bulk_connection_pool_size() const {
+    return bulk_connection_pool_size_;
+  }
+
+  /**
+   * Size the HTTP/2 flow-control windows for the link's bandwidth-delay
+   * product.
+   *
+   * A stream cannot have more unacknowledged data in flight than its
+   * flow-control window, so per-stream throughput is capped at
+   * `window / round-trip time`. With the default windows a cross-region
+   * scan (~100ms RTT) stalls far below link capacity. Set this option to
+   * `bandwidth * RTT` for the link and the client sizes the stream
+   * windows of every channel in the pool to match, so `ReadRows` streams
+   * keep the pipe full. When zero (the default) the client enables
+   * gRPC's own bandwidth-delay product probe instead, which measures the
+   * link and grows the windows automatically.
+   */
+  ClientOptions& set_bandwidth_delay_product(std::size_t bytes) {
+    bandwidth_delay_product_ = bytes;
+    return *this;
+  }
+
+  /**
+   * Compute the bandwidth-delay product from the link parameters.
+   *
+   * Equivalent to `set_bandwidth_delay_product(bandwidth * rtt)`.
+   *
+   * @param bytes_per_second the link bandwidth available to this client.
+   * @param round_trip_time the round-trip time to the service.
+   */
+  ClientOptions& set_bandwidth_delay_product(
+      std::size_t bytes_per_second, std::chrono::milliseconds round_trip_time) {
+    return set_bandwidth_delay_product(
+        bytes_per_second / 1000 *
+        static_cast<std::size_t>(round_trip_time.count()));
+  }
+
+  /// Return the configured bandwidth-delay product, zero if unset.
+  std::size_t bandwidth_delay_product() const {
+    return bandwidth_delay_product_;
+  }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -291,6 +463,29 @@ class ClientOptions {
     channel_arguments_.SetSslTargetNameOverride(name);
   }
 
+  //@{
+  /**
+   * Run the client's background work on an application-owned executor.
+   *
+   * The client spawns threads for work that must proceed while the
+   * calling thread does something else, for example the background
+   * refresh of cached `Table::SampleRows()` results. Applications using
+   * several Google Cloud C++ libraries can install the same executor in
+   * each library's options instead, so one pool serves all of them; see
+   * `BackgroundExecutor` for the expected signature. When unset the
+   * client creates its own (short-lived) threads.
+   *
+   * The executor must outlive every client configured with it.
+   */
+  BackgroundExecutor const& background_executor() const {
+    return background_executor_;
+  }
+  ClientOptions& set_background_executor(BackgroundExecutor executor) {
+    background_executor_ = std::move(executor);
+    return *this;
+  }
+  //@}
+
   /// Return the user agent prefix used by the library.
   static std::string UserAgentPrefix();
 
@@ -307,6 +502,14 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  std::size_t max_connection_pool_size_ = 0;
+  std::chrono::milliseconds channel_refresh_period_ =
+      std::chrono::milliseconds(0);
+  std::size_t bulk_connection_pool_size_ = 0;
+  std::size_t bandwidth_delay_product_ = 0;
+  grpc_compression_algorithm call_compression_algorithm_ = GRPC_COMPRESS_NONE;
+  std::size_t call_compression_threshold_ = 0;
+  BackgroundExecutor background_executor_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
   // The endpoint for instance admin operations, in most scenarios this should
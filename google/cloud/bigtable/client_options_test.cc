@@ -19,6 +19,8 @@
 #include "google/cloud/testing_util/scoped_environment.h"
 #include <gmock/gmock.h>
 #include <cstdlib>
+#include <functional>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -262,6 +264,67 @@ TEST(ClientOptionsTest, EditConnectionPoolSize) {
   EXPECT_EQ(42UL, returned.connection_pool_size());
 }
 
+TEST(ClientOptionsTest, EditCallCompression) {
+  bigtable::ClientOptions client_options_object;
+  // Per-call compression is disabled by default.
+  EXPECT_EQ(GRPC_COMPRESS_NONE,
+            client_options_object.call_compression_algorithm());
+  EXPECT_EQ(0UL, client_options_object.call_compression_threshold());
+  auto& returned =
+      client_options_object.set_call_compression_algorithm(GRPC_COMPRESS_GZIP)
+          .set_call_compression_threshold(16 * 1024);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(GRPC_COMPRESS_GZIP, returned.call_compression_algorithm());
+  EXPECT_EQ(16UL * 1024, returned.call_compression_threshold());
+}
+
+TEST(ClientOptionsTest, EditMaxConnectionPoolSize) {
+  bigtable::ClientOptions client_options_object;
+  // Dynamic pool sizing is disabled by default.
+  EXPECT_EQ(0UL, client_options_object.max_connection_pool_size());
+  auto& returned = client_options_object.set_max_connection_pool_size(64);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(64UL, returned.max_connection_pool_size());
+}
+
+TEST(ClientOptionsTest, EditChannelRefreshPeriod) {
+  bigtable::ClientOptions client_options_object;
+  // The refresh is disabled by default.
+  EXPECT_EQ(std::chrono::milliseconds(0),
+            client_options_object.channel_refresh_period());
+  auto& returned = client_options_object.set_channel_refresh_period(
+      std::chrono::minutes(30));
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(std::chrono::minutes(30), returned.channel_refresh_period());
+}
+
+TEST(ClientOptionsTest, EditBulkConnectionPoolSize) {
+  bigtable::ClientOptions client_options_object;
+  // The separate bulk-traffic pool is disabled by default.
+  EXPECT_EQ(0UL, client_options_object.bulk_connection_pool_size());
+  auto& returned = client_options_object.set_bulk_connection_pool_size(4);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(4UL, returned.bulk_connection_pool_size());
+}
+
+TEST(ClientOptionsTest, EditBandwidthDelayProduct) {
+  bigtable::ClientOptions client_options_object;
+  // Unset by default, gRPC's own probe tunes the windows.
+  EXPECT_EQ(0UL, client_options_object.bandwidth_delay_product());
+  auto& returned =
+      client_options_object.set_bandwidth_delay_product(16 * 1024 * 1024);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(16UL * 1024 * 1024, returned.bandwidth_delay_product());
+}
+
+TEST(ClientOptionsTest, BandwidthDelayProductFromLinkParameters) {
+  bigtable::ClientOptions client_options_object;
+  // A 1 Gbps link (125 MB/s) with a 100ms round-trip time.
+  client_options_object.set_bandwidth_delay_product(
+      125 * 1000 * 1000, std::chrono::milliseconds(100));
+  EXPECT_EQ(12500000UL, client_options_object.bandwidth_delay_product());
+}
+
 TEST(ClientOptionsTest, ResetToDefaultConnectionPoolSize) {
   bigtable::ClientOptions client_options_object;
   auto& returned = client_options_object.set_connection_pool_size(0);
@@ -362,6 +425,24 @@ TEST(ClientOptionsTest, SetMaxSendMessageSize) {
   EXPECT_EQ(test_args.args[3].value.integer, 256 * 1024L * 1024L);
 }
 
+TEST(ClientOptionsTest, BackgroundExecutor) {
+  bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
+  // The default is empty: the library creates its own threads.
+  EXPECT_FALSE(client_options_object.background_executor());
+
+  std::vector<std::function<void()>> submitted;
+  client_options_object.set_background_executor(
+      [&submitted](std::function<void()> task) {
+        submitted.push_back(std::move(task));
+      });
+  ASSERT_TRUE(client_options_object.background_executor());
+  bool ran = false;
+  client_options_object.background_executor()([&ran] { ran = true; });
+  ASSERT_EQ(1U, submitted.size());
+  submitted[0]();
+  EXPECT_TRUE(ran);
+}
+
 TEST(ClientOptionsTest, SetLoadBalancingPolicyName) {
   bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
   client_options_object.SetLoadBalancingPolicyName("test-policy-name");
@@ -0,0 +1,60 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_thread_pool.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+CompletionQueueThreadPool::CompletionQueueThreadPool(std::size_t thread_count) {
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+  threads_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    // `CompletionQueue` is a handle to a shared implementation, each thread
+    // runs the event loop on its own copy.
+    auto cq = cq_;
+    threads_.emplace_back([cq]() mutable { cq.Run(); });
+  }
+}
+
+CompletionQueueThreadPool::~CompletionQueueThreadPool() { Shutdown(); }
+
+void CompletionQueueThreadPool::Shutdown() {
+  if (threads_.empty()) {
+    return;
+  }
+  cq_.Shutdown();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+std::size_t CompletionQueueThreadPool::DefaultThreadCount() {
+  std::size_t const hw = std::thread::hardware_concurrency();
+  if (hw == 0) {
+    // The hardware concurrency is unknown, pick a small fixed pool.
+    return 4;
+  }
+  return (std::max)(std::size_t(1), hw / 2);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
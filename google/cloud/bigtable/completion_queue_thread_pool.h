@@ -0,0 +1,94 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_THREAD_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_THREAD_POOL_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/version.h"
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Own a `CompletionQueue` and the threads that service it.
+ *
+ * Asynchronous operations make no progress unless some thread is calling
+ * `CompletionQueue::Run()`, and sizing, starting, and joining those
+ * threads is left to the application. This class bundles the common
+ * answer: the constructor starts a fixed pool of threads running the
+ * event loop, and the destructor shuts the queue down and joins them.
+ *
+ * @par Example
+ * @code
+ * bigtable::CompletionQueueThreadPool pool;  // DefaultThreadCount()
+ * bigtable::Table table(data_client, "my-table");
+ * auto f = table.AsyncApply(std::move(mutation), pool.cq());
+ * @endcode
+ */
+class CompletionQueueThreadPool {
+ public:
+  /**
+   * Start @p thread_count threads servicing a new `CompletionQueue`.
+   *
+   * A @p thread_count of zero is treated as one, a pool that services
+   * nothing would just deadlock its users.
+   */
+  explicit CompletionQueueThreadPool(
+      std::size_t thread_count = DefaultThreadCount());
+  ~CompletionQueueThreadPool();
+
+  CompletionQueueThreadPool(CompletionQueueThreadPool const&) = delete;
+  CompletionQueueThreadPool& operator=(CompletionQueueThreadPool const&) =
+      delete;
+
+  /// The queue serviced by this pool, pass it to the `Async*` operations.
+  CompletionQueue cq() const { return cq_; }
+
+  /// The number of threads still servicing the queue, zero after Shutdown().
+  std::size_t thread_count() const { return threads_.size(); }
+
+  /**
+   * Shutdown the queue and join the threads.
+   *
+   * Operations already in the queue run to completion, but new
+   * asynchronous operations fail immediately. Calling this member
+   * function more than once (including the implicit call in the
+   * destructor) is harmless.
+   */
+  void Shutdown();
+
+  /**
+   * The default pool size: half the hardware threads, but at least one.
+   *
+   * gRPC runs its own internal threads, so dedicating every core to
+   * completion callbacks would oversubscribe the machine.
+   */
+  static std::size_t DefaultThreadCount();
+
+ private:
+  CompletionQueue cq_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_THREAD_POOL_H
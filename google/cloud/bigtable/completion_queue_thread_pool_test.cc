@@ -0,0 +1,66 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_thread_pool.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <future>
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+/// @test Verify the pool services timers without any user-supplied threads.
+TEST(CompletionQueueThreadPoolTest, RunsTimers) {
+  CompletionQueueThreadPool pool(2);
+  EXPECT_EQ(2U, pool.thread_count());
+
+  auto timer = pool.cq().MakeRelativeTimer(2_ms).get();
+  ASSERT_STATUS_OK(timer);
+}
+
+/// @test Verify shutdown joins the threads and can be called repeatedly.
+TEST(CompletionQueueThreadPoolTest, ShutdownIsIdempotent) {
+  CompletionQueueThreadPool pool(1);
+
+  std::promise<void> promise;
+  pool.cq().RunAsync([&promise](CompletionQueue&) { promise.set_value(); });
+  promise.get_future().get();
+
+  pool.Shutdown();
+  EXPECT_EQ(0U, pool.thread_count());
+  // The destructor calls Shutdown() again, so an explicit second call must
+  // be harmless too.
+  pool.Shutdown();
+}
+
+/// @test Verify a zero thread count is bumped to one.
+TEST(CompletionQueueThreadPoolTest, ZeroThreadsBecomesOne) {
+  CompletionQueueThreadPool pool(0);
+  EXPECT_EQ(1U, pool.thread_count());
+}
+
+/// @test Verify the default size is always usable.
+TEST(CompletionQueueThreadPoolTest, DefaultThreadCountIsPositive) {
+  EXPECT_GE(CompletionQueueThreadPool::DefaultThreadCount(), 1U);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
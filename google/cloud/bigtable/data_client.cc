@@ -45,7 +45,11 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
-        impl_(std::move(options)) {}
+        impl_(std::move(options)) {
+    // Start connecting the channel pool in the background, so the first
+    // RPCs do not pay for the connection handshakes.
+    impl_.PreConnect();
+  }
 
   DefaultDataClient(std::string project, std::string instance)
       : DefaultDataClient(std::move(project), std::move(instance),
@@ -57,6 +61,21 @@ class DefaultDataClient : public DataClient {
   std::shared_ptr<grpc::Channel> Channel() override { return impl_.Channel(); }
   void reset() override { impl_.reset(); }
 
+  grpc_compression_algorithm call_compression_algorithm() const override {
+    return impl_.Options().call_compression_algorithm();
+  }
+  std::size_t call_compression_threshold() const override {
+    return impl_.Options().call_compression_threshold();
+  }
+
+  BackgroundExecutor background_executor() const override {
+    return impl_.Options().background_executor();
+  }
+
+  std::vector<long> channel_queue_depths() override {
+    return impl_.OutstandingPerChannel();
+  }
+
   grpc::Status MutateRow(grpc::ClientContext* context,
                          btproto::MutateRowRequest const& request,
                          btproto::MutateRowResponse* response) override {
@@ -109,6 +128,13 @@ class DefaultDataClient : public DataClient {
     return impl_.Stub()->ReadRows(context, request);
   }
 
+  std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
+  ReadRows(grpc::ClientContext* context,
+           btproto::ReadRowsRequest const& request,
+           TrafficClass traffic_class) override {
+    return impl_.Stub(traffic_class)->ReadRows(context, request);
+  }
+
   std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
@@ -129,6 +155,12 @@ class DefaultDataClient : public DataClient {
                 btproto::SampleRowKeysRequest const& request) override {
     return impl_.Stub()->SampleRowKeys(context, request);
   }
+  std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
+  SampleRowKeys(grpc::ClientContext* context,
+                btproto::SampleRowKeysRequest const& request,
+                TrafficClass traffic_class) override {
+    return impl_.Stub(traffic_class)->SampleRowKeys(context, request);
+  }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
   AsyncSampleRowKeys(
@@ -143,6 +175,12 @@ class DefaultDataClient : public DataClient {
              btproto::MutateRowsRequest const& request) override {
     return impl_.Stub()->MutateRows(context, request);
   }
+  std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
+  MutateRows(grpc::ClientContext* context,
+             btproto::MutateRowsRequest const& request,
+             TrafficClass traffic_class) override {
+    return impl_.Stub(traffic_class)->MutateRows(context, request);
+  }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
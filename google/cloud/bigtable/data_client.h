@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/rpc_metrics.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/version.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
@@ -82,6 +83,57 @@ class DataClient {
    */
   virtual void reset() = 0;
 
+  /**
+   * The per-call compression algorithm configured for data operations.
+   *
+   * Applications with large cell payloads configure this through
+   * `ClientOptions::set_call_compression_algorithm()`. The default
+   * (no compression) preserves the behavior of clients created before
+   * this knob existed.
+   */
+  virtual grpc_compression_algorithm call_compression_algorithm() const {
+    return GRPC_COMPRESS_NONE;
+  }
+
+  /// The minimum request size (in bytes) that enables compression.
+  virtual std::size_t call_compression_threshold() const { return 0; }
+
+  /**
+   * The executor configured for background work, if any.
+   *
+   * Applications configure this through
+   * `ClientOptions::set_background_executor()`. The default (an empty
+   * executor) preserves the behavior of clients created before this
+   * knob existed: the library creates its own threads.
+   */
+  virtual BackgroundExecutor background_executor() const {
+    return BackgroundExecutor{};
+  }
+
+  /**
+   * A snapshot of the client-observed RPC metrics.
+   *
+   * The retry loops record the latency, outcome, and retry count of
+   * every attempt; use this to alert on what the application actually
+   * experiences, including channel-level problems that server-side
+   * metrics cannot see. The metrics are recorded in a process-wide
+   * registry, so the snapshot covers every `DataClient` in the
+   * process.
+   */
+  std::vector<internal::RpcMetrics::MethodMetrics> metrics_snapshot() const {
+    return internal::RpcMetrics::Instance().Snapshot();
+  }
+
+  /**
+   * The number of outstanding RPCs on each channel in the pool.
+   *
+   * A channel with a queue depth far above its peers usually indicates
+   * a connection-level problem, e.g. a slow backend or a lossy path.
+   * The default implementation returns an empty vector; clients that
+   * do not pool connections have nothing to report.
+   */
+  virtual std::vector<long> channel_queue_depths() { return {}; }
+
   // The member functions of this class are not intended for general use by
   // application developers (they are simply a dependency injection point). Make
   // them protected, so the mock classes can override them, and then make the
@@ -136,6 +188,22 @@ class DataClient {
       grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            google::bigtable::v2::ReadRowsRequest const& request) = 0;
+  /**
+   * As `ReadRows()`, picking the connection by traffic class.
+   *
+   * The default implementation ignores @p traffic_class, so existing
+   * mocks and implementations keep working; `CreateDefaultDataClient()`
+   * routes `TrafficClass::kBulk` calls through the bulk channel pool
+   * when one is configured.
+   */
+  virtual std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+  ReadRows(grpc::ClientContext* context,
+           google::bigtable::v2::ReadRowsRequest const& request,
+           TrafficClass traffic_class) {
+    (void)traffic_class;
+    return ReadRows(context, request);
+  }
   virtual std::unique_ptr<
       grpc::ClientAsyncReaderInterface<google::bigtable::v2::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
@@ -150,6 +218,15 @@ class DataClient {
       grpc::ClientReaderInterface<google::bigtable::v2::SampleRowKeysResponse>>
   SampleRowKeys(grpc::ClientContext* context,
                 google::bigtable::v2::SampleRowKeysRequest const& request) = 0;
+  /// As `SampleRowKeys()`, picking the connection by traffic class.
+  virtual std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::SampleRowKeysResponse>>
+  SampleRowKeys(grpc::ClientContext* context,
+                google::bigtable::v2::SampleRowKeysRequest const& request,
+                TrafficClass traffic_class) {
+    (void)traffic_class;
+    return SampleRowKeys(context, request);
+  }
   virtual std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
   AsyncSampleRowKeys(
@@ -160,6 +237,15 @@ class DataClient {
       grpc::ClientReaderInterface<google::bigtable::v2::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              google::bigtable::v2::MutateRowsRequest const& request) = 0;
+  /// As `MutateRows()`, picking the connection by traffic class.
+  virtual std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::MutateRowsResponse>>
+  MutateRows(grpc::ClientContext* context,
+             google::bigtable::v2::MutateRowsRequest const& request,
+             TrafficClass traffic_class) {
+    (void)traffic_class;
+    return MutateRows(context, request);
+  }
   virtual std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
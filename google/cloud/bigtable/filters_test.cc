@@ -398,3 +398,25 @@ TEST(FiltersTest, MoveProto) {
   differencer.ReportDifferencesToString(&delta);
   EXPECT_TRUE(differencer.Compare(proto_copy, proto_move)) << delta;
 }
+
+/// @test Verify that `bigtable::CompiledFilter` round-trips the filter.
+TEST(FiltersTest, CompiledFilterRoundTrip) {
+  using F = bigtable::Filter;
+  auto filter = F::Chain(F::FamilyRegex("fam"), F::ColumnRegex("col"),
+                         F::CellsRowOffset(2), F::Latest(1));
+  bigtable::CompiledFilter compiled(filter);
+  auto materialized = compiled.Materialize().as_proto();
+
+  std::string delta;
+  google::protobuf::util::MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(filter.as_proto(), materialized)) << delta;
+}
+
+/// @test Verify that `bigtable::CompiledFilter` copies share the bytes.
+TEST(FiltersTest, CompiledFilterCopiesShareSerializedForm) {
+  using F = bigtable::Filter;
+  bigtable::CompiledFilter compiled(F::Chain(F::Family("fam"), F::Latest(1)));
+  bigtable::CompiledFilter copy = compiled;
+  EXPECT_EQ(compiled.serialized().data(), copy.serialized().data());
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -23,6 +24,17 @@ std::unique_ptr<IdempotentMutationPolicy> DefaultIdempotentMutationPolicy() {
       new SafeIdempotentMutationPolicy);
 }
 
+bool IdempotentMutationPolicy::is_idempotent(
+    google::bigtable::v2::MutateRowsRequest::Entry const& entry, bool) {
+  // Policies predating the row-level overload only classify one mutation at
+  // a time, fall back to querying each of them.
+  auto const& mutations = entry.mutations();
+  return std::all_of(mutations.begin(), mutations.end(),
+                     [this](google::bigtable::v2::Mutation const& m) {
+                       return is_idempotent(m);
+                     });
+}
+
 std::unique_ptr<IdempotentMutationPolicy> SafeIdempotentMutationPolicy::clone()
     const {
   return std::unique_ptr<IdempotentMutationPolicy>(
@@ -43,6 +55,14 @@ bool SafeIdempotentMutationPolicy::is_idempotent(
   return false;
 }
 
+bool SafeIdempotentMutationPolicy::is_idempotent(
+    google::bigtable::v2::MutateRowsRequest::Entry const&,
+    bool safe_idempotent) {
+  // The bit was computed with exactly this policy's criteria when the
+  // mutations were built, there is no need to walk them again.
+  return safe_idempotent;
+}
+
 std::unique_ptr<IdempotentMutationPolicy> AlwaysRetryMutationPolicy::clone()
     const {
   return std::unique_ptr<IdempotentMutationPolicy>(
@@ -59,6 +79,11 @@ bool AlwaysRetryMutationPolicy::is_idempotent(
   return true;
 }
 
+bool AlwaysRetryMutationPolicy::is_idempotent(
+    google::bigtable::v2::MutateRowsRequest::Entry const&, bool) {
+  return true;
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
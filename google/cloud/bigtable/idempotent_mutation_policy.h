@@ -39,6 +39,20 @@ class IdempotentMutationPolicy {
   /// Return true if a conditional mutation is idempotent
   virtual bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) = 0;
+
+  /**
+   * Return true if all the mutations of a row are idempotent.
+   *
+   * @param entry the row and its mutations.
+   * @param safe_idempotent a bit precomputed when the mutations were
+   *     built: true if none of them sets the server timestamp, i.e. the
+   *     answer `SafeIdempotentMutationPolicy` would give. The default
+   *     implementation ignores it and queries each mutation; derived
+   *     classes can use it to avoid walking the mutations again.
+   */
+  virtual bool is_idempotent(
+      google::bigtable::v2::MutateRowsRequest::Entry const& entry,
+      bool safe_idempotent);
 };
 
 /// Return an instance of the default IdempotentMutationPolicy.
@@ -59,6 +73,8 @@ class SafeIdempotentMutationPolicy : public IdempotentMutationPolicy {
   bool is_idempotent(google::bigtable::v2::Mutation const&) override;
   bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) override;
+  bool is_idempotent(google::bigtable::v2::MutateRowsRequest::Entry const&,
+                     bool safe_idempotent) override;
 };
 
 /**
@@ -79,6 +95,8 @@ class AlwaysRetryMutationPolicy : public IdempotentMutationPolicy {
   bool is_idempotent(google::bigtable::v2::Mutation const&) override;
   bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) override;
+  bool is_idempotent(google::bigtable::v2::MutateRowsRequest::Entry const&,
+                     bool safe_idempotent) override;
 };
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
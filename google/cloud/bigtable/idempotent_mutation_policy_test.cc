@@ -47,3 +47,20 @@ TEST(IdempotentMutationPolicyTest, AlwaysRetry) {
   EXPECT_TRUE(clone->is_idempotent(bigtable::SetCell("f", "c", "v").op));
   EXPECT_TRUE(clone->is_idempotent(bigtable::SetCell("f", "c", 10_ms, "v").op));
 }
+
+/// @test Verify the row-level overload honors the precomputed bit.
+TEST(IdempotentMutationPolicyTest, RowLevel) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  google::bigtable::v2::MutateRowsRequest::Entry entry;
+  entry.set_row_key("row");
+  *entry.add_mutations() = bigtable::SetCell("fam", "col", 0_ms, "v").op;
+
+  // The default policy trusts the bit cached when the mutations were built.
+  auto policy = bigtable::DefaultIdempotentMutationPolicy();
+  EXPECT_TRUE(policy->is_idempotent(entry, true));
+  EXPECT_FALSE(policy->is_idempotent(entry, false));
+
+  // AlwaysRetryMutationPolicy ignores it.
+  bigtable::AlwaysRetryMutationPolicy always_retry;
+  EXPECT_TRUE(always_retry.is_idempotent(entry, false));
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/instance_admin.h"
+#include "google/cloud/bigtable/completion_queue_thread_pool.h"
 #include "google/cloud/bigtable/internal/async_retry_multi_page.h"
 #include "google/cloud/bigtable/internal/async_retry_unary_rpc_and_poll.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
@@ -35,47 +36,90 @@ static_assert(std::is_copy_assignable<bigtable::InstanceAdmin>::value,
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<InstanceAdminClient>;
 
+namespace {
+/**
+ * The completion queue shared by the synchronous long-running operations.
+ *
+ * These wrappers used to detach one event-loop thread per call. The
+ * polling itself runs on `CompletionQueue::MakeRelativeTimer()` (see
+ * `internal::AsyncStartPollAfterRetryUnaryRpc`), so a single shared
+ * thread can drive any number of concurrent pending operations. The
+ * pool starts on first use and is joined at program exit.
+ */
+CompletionQueue SharedCompletionQueue() {
+  static CompletionQueueThreadPool pool(1);
+  return pool.cq();
+}
+}  // anonymous namespace
+
 StatusOr<InstanceList> InstanceAdmin::ListInstances() {
-  grpc::Status status;
   InstanceList result;
+  auto failed_locations =
+      ListInstances([&result](btadmin::Instance instance) {
+        result.instances.emplace_back(std::move(instance));
+      });
+  if (!failed_locations) {
+    return failed_locations.status();
+  }
+  result.failed_locations = *std::move(failed_locations);
+  return result;
+}
+
+StatusOr<std::vector<std::string>> InstanceAdmin::ListInstances(
+    std::function<void(btadmin::Instance)> const& on_instance) {
   // Copy the policies in effect for the operation.
   auto rpc_policy = clone_rpc_retry_policy();
   auto backoff_policy = clone_rpc_backoff_policy();
 
-  // Build the RPC request, try to minimize copying.
-  std::unordered_set<std::string> unique_failed_locations;
-  std::string page_token;
-  do {
+  // The page tokens force the pages to be requested in order, but the
+  // fetch of page N+1 can start as soon as the token on page N arrives,
+  // and overlap with the `on_instance` callbacks for page N. The
+  // policies are shared across pages (as in the non-streaming
+  // overload), which is safe because at most one fetch runs at a time.
+  auto fetch = [this, &rpc_policy, &backoff_policy](std::string page_token)
+      -> StatusOr<btadmin::ListInstancesResponse> {
     btadmin::ListInstancesRequest request;
     request.set_page_token(std::move(page_token));
     request.set_parent(project_name());
 
+    grpc::Status status;
     auto response = ClientUtils::MakeCall(
         *(client_), *rpc_policy, *backoff_policy,
         MetadataUpdatePolicy(project_name(), MetadataParamTypes::PARENT),
         &InstanceAdminClient::ListInstances, request,
         "InstanceAdmin::ListInstances", status, true);
     if (!status.ok()) {
-      break;
+      return MakeStatusFromRpcError(status);
     }
+    return response;
+  };
 
-    auto& instances = *response.mutable_instances();
-    std::move(instances.begin(), instances.end(),
-              std::back_inserter(result.instances));
-    auto& failed_locations = *response.mutable_failed_locations();
+  std::unordered_set<std::string> unique_failed_locations;
+  auto page = fetch(std::string{});
+  while (true) {
+    if (!page) {
+      return page.status();
+    }
+    std::string page_token = std::move(*page->mutable_next_page_token());
+    std::future<StatusOr<btadmin::ListInstancesResponse>> next;
+    if (!page_token.empty()) {
+      next = std::async(std::launch::async, fetch, std::move(page_token));
+    }
+    for (auto& instance : *page->mutable_instances()) {
+      on_instance(std::move(instance));
+    }
+    auto& failed_locations = *page->mutable_failed_locations();
     std::move(
         failed_locations.begin(), failed_locations.end(),
         std::inserter(unique_failed_locations, unique_failed_locations.end()));
-
-    page_token = std::move(*response.mutable_next_page_token());
-  } while (!page_token.empty());
-
-  if (!status.ok()) {
-    return MakeStatusFromRpcError(status);
+    if (!next.valid()) {
+      break;
+    }
+    page = next.get();
   }
-
+  std::vector<std::string> result;
   std::move(unique_failed_locations.begin(), unique_failed_locations.end(),
-            std::back_inserter(result.failed_locations));
+            std::back_inserter(result));
   return result;
 }
 
@@ -129,14 +173,8 @@ future<StatusOr<InstanceList>> InstanceAdmin::AsyncListInstances(
 
 future<StatusOr<btadmin::Instance>> InstanceAdmin::CreateInstance(
     InstanceConfig instance_config) {
-  CompletionQueue cq;
-  std::thread([](CompletionQueue cq) { cq.Run(); }, cq).detach();
-
-  return AsyncCreateInstance(cq, std::move(instance_config))
-      .then([cq](future<StatusOr<btadmin::Instance>> f) mutable {
-        cq.Shutdown();
-        return f.get();
-      });
+  auto cq = SharedCompletionQueue();
+  return AsyncCreateInstance(cq, std::move(instance_config));
 }
 
 future<StatusOr<google::bigtable::admin::v2::Instance>>
@@ -166,15 +204,9 @@ InstanceAdmin::AsyncCreateInstance(CompletionQueue& cq,
 future<StatusOr<btadmin::Cluster>> InstanceAdmin::CreateCluster(
     ClusterConfig cluster_config, std::string const& instance_id,
     std::string const& cluster_id) {
-  CompletionQueue cq;
-  std::thread([](CompletionQueue cq) { cq.Run(); }, cq).detach();
-
+  auto cq = SharedCompletionQueue();
   return AsyncCreateCluster(cq, std::move(cluster_config), instance_id,
-                            cluster_id)
-      .then([cq](future<StatusOr<btadmin::Cluster>> f) mutable {
-        cq.Shutdown();
-        return f.get();
-      });
+                            cluster_id);
 }
 
 future<StatusOr<google::bigtable::admin::v2::Cluster>>
@@ -206,14 +238,8 @@ InstanceAdmin::AsyncCreateCluster(CompletionQueue& cq,
 
 future<StatusOr<google::bigtable::admin::v2::Instance>>
 InstanceAdmin::UpdateInstance(InstanceUpdateConfig instance_update_config) {
-  CompletionQueue cq;
-  std::thread([](CompletionQueue cq) { cq.Run(); }, cq).detach();
-
-  return AsyncUpdateInstance(cq, std::move(instance_update_config))
-      .then([cq](future<StatusOr<btadmin::Instance>> f) mutable {
-        cq.Shutdown();
-        return f.get();
-      });
+  auto cq = SharedCompletionQueue();
+  return AsyncUpdateInstance(cq, std::move(instance_update_config));
 }
 
 future<StatusOr<google::bigtable::admin::v2::Instance>>
@@ -490,14 +516,8 @@ future<StatusOr<ClusterList>> InstanceAdmin::AsyncListClusters(
 
 future<StatusOr<google::bigtable::admin::v2::Cluster>>
 InstanceAdmin::UpdateCluster(ClusterConfig cluster_config) {
-  CompletionQueue cq;
-  std::thread([](CompletionQueue cq) { cq.Run(); }, cq).detach();
-
-  return AsyncUpdateCluster(cq, std::move(cluster_config))
-      .then([cq](future<StatusOr<btadmin::Cluster>> f) mutable {
-        cq.Shutdown();
-        return f.get();
-      });
+  auto cq = SharedCompletionQueue();
+  return AsyncUpdateCluster(cq, std::move(cluster_config));
 }
 
 future<StatusOr<google::bigtable::admin::v2::Cluster>>
@@ -623,14 +643,8 @@ InstanceAdmin::AsyncGetAppProfile(CompletionQueue& cq,
 future<StatusOr<btadmin::AppProfile>> InstanceAdmin::UpdateAppProfile(
     std::string const& instance_id, std::string const& profile_id,
     AppProfileUpdateConfig config) {
-  CompletionQueue cq;
-  std::thread([](CompletionQueue cq) { cq.Run(); }, cq).detach();
-
-  return AsyncUpdateAppProfile(cq, instance_id, profile_id, std::move(config))
-      .then([cq](future<StatusOr<btadmin::AppProfile>> f) mutable {
-        cq.Shutdown();
-        return f.get();
-      });
+  auto cq = SharedCompletionQueue();
+  return AsyncUpdateAppProfile(cq, instance_id, profile_id, std::move(config));
 }
 
 future<StatusOr<google::bigtable::admin::v2::AppProfile>>
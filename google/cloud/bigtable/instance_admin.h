@@ -29,6 +29,7 @@
 #include "google/cloud/future.h"
 #include "google/cloud/iam_policy.h"
 #include "google/cloud/status_or.h"
+#include <functional>
 #include <future>
 #include <memory>
 
@@ -353,6 +354,28 @@ class InstanceAdmin {
    */
   StatusOr<InstanceList> ListInstances();
 
+  /**
+   * Query the list of instances in the project, streaming the results.
+   *
+   * Invokes @p on_instance once per instance, as the pages arrive from
+   * the service. While the callbacks for one page run the next page is
+   * already being fetched on a background thread, so large projects
+   * list in roughly the time of the page fetches alone.
+   *
+   * @param on_instance invoked once per instance, in the order the
+   *     service returns them. No callbacks are invoked after a page
+   *     fails.
+   * @return the list of locations where Cloud Bigtable could not get a
+   *     response from (see `InstanceList::failed_locations`), or the
+   *     error if any page could not be fetched.
+   *
+   * @par Idempotency
+   * This operation is read-only and therefore it is always idempotent.
+   */
+  StatusOr<std::vector<std::string>> ListInstances(
+      std::function<void(google::bigtable::admin::v2::Instance)> const&
+          on_instance);
+
   /**
    * Query (asynchronously) the list of instances in the project.
    *
@@ -256,6 +256,31 @@ TEST_F(InstanceAdminTest, ListInstances) {
   EXPECT_EQ(instance_name + "/instances/t1", actual->instances[1].name());
 }
 
+/// @test Verify the streaming `ListInstances()` overload delivers all pages.
+TEST_F(InstanceAdminTest, ListInstancesStreaming) {
+  using namespace ::testing;
+
+  bigtable::InstanceAdmin tested(client_);
+  auto page0 = create_list_instances_lambda("", "token-001", {"t0", "t1"});
+  auto page1 = create_list_instances_lambda("token-001", "", {"t2"});
+  EXPECT_CALL(*client_, ListInstances(_, _, _))
+      .WillOnce(Invoke(page0))
+      .WillOnce(Invoke(page1));
+
+  std::vector<std::string> names;
+  auto failed_locations = tested.ListInstances(
+      [&names](btadmin::Instance instance) {
+        names.push_back(instance.name());
+      });
+  ASSERT_STATUS_OK(failed_locations);
+  EXPECT_TRUE(failed_locations->empty());
+  std::string instance_name = tested.project_name();
+  ASSERT_EQ(3UL, names.size());
+  EXPECT_EQ(instance_name + "/instances/t0", names[0]);
+  EXPECT_EQ(instance_name + "/instances/t1", names[1]);
+  EXPECT_EQ(instance_name + "/instances/t2", names[2]);
+}
+
 /// @test Verify that `bigtable::InstanceAdmin::ListInstances` handles failures.
 TEST_F(InstanceAdminTest, ListInstancesRecoverableFailures) {
   using namespace ::testing;
@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/rpc_metrics.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/log.h"
 #include <numeric>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -29,48 +31,86 @@ namespace btproto = google::bigtable::v2;
 BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
                                    std::string const& table_name,
                                    IdempotentMutationPolicy& idempotent_policy,
-                                   BulkMutation mut) {
+                                   BulkMutation mut)
+    : mutations_storage_(
+          google::cloud::internal::make_unique<btproto::MutateRowsRequest>()),
+      pending_mutations_storage_(
+          google::cloud::internal::make_unique<btproto::MutateRowsRequest>()),
+      mutations_(mutations_storage_.get()),
+      pending_mutations_(pending_mutations_storage_.get()) {
   // Every time the client library calls MakeOneRequest(), the data in the
   // "pending_*" variables initializes the next request.  So in the constructor
   // we start by putting the data on the "pending_*" variables.
+  // Grab the idempotency bits computed when the mutations were built, they
+  // are gone once the entries are moved out of `mut`.
+  auto hints = std::move(mut.entry_is_safe_idempotent_);
   // Move the mutations to the "pending" request proto, this is a zero copy
   // optimization.
-  mut.MoveTo(&pending_mutations_);
-  pending_mutations_.set_app_profile_id(app_profile_id);
-  pending_mutations_.set_table_name(table_name);
+  mut.MoveTo(pending_mutations_);
+  pending_mutations_->set_app_profile_id(app_profile_id);
+  pending_mutations_->set_table_name(table_name);
 
+  AnnotatePendingMutations(idempotent_policy, hints);
+}
+
+BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
+                                   std::string const& table_name,
+                                   IdempotentMutationPolicy& idempotent_policy,
+                                   ArenaBulkMutation mut)
+    : arena_(std::move(mut.arena_)),
+      // Use the arena-owned request in place, and allocate its companion
+      // request from the same arena so that the entries moved between the
+      // two on retries stay arena-allocated swaps, not copies.
+      mutations_(google::protobuf::Arena::CreateMessage<
+                 btproto::MutateRowsRequest>(arena_.get())),
+      pending_mutations_(mut.request_) {
+  pending_mutations_->set_app_profile_id(app_profile_id);
+  pending_mutations_->set_table_name(table_name);
+
+  AnnotatePendingMutations(idempotent_policy, mut.entry_is_safe_idempotent_);
+}
+
+void BulkMutatorState::AnnotatePendingMutations(
+    IdempotentMutationPolicy& idempotent_policy,
+    std::vector<bool> const& safe_idempotent_hints) {
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are resent).  But if any fails we want to report their index
   // in the original sequence provided by the user. This vector maps from the
   // index in the current sequence of mutations to the index in the original
   // sequence of mutations.
-  pending_annotations_.reserve(pending_mutations_.entries_size());
+  pending_annotations_.reserve(pending_mutations_->entries_size());
 
   // We save the idempotency of each mutation, to be used later as we decide if
-  // they should be retried or not.
+  // they should be retried or not. The hint for each row was cached when the
+  // mutations were built; the default policy just reads it instead of walking
+  // each mutation proto again. Missing hints (which should not happen) are
+  // conservatively treated as not idempotent.
   int index = 0;
-  for (auto const& e : pending_mutations_.entries()) {
-    // This is a giant && across all the mutations for each row.
-    auto r = std::all_of(e.mutations().begin(), e.mutations().end(),
-                         [&idempotent_policy](btproto::Mutation const& m) {
-                           return idempotent_policy.is_idempotent(m);
-                         });
+  for (auto const& e : pending_mutations_->entries()) {
+    bool const hint =
+        static_cast<std::size_t>(index) < safe_idempotent_hints.size() &&
+        safe_idempotent_hints[index];
+    auto r = idempotent_policy.is_idempotent(e, hint);
     pending_annotations_.push_back(Annotations{index++, r, false});
   }
 }
 
 google::bigtable::v2::MutateRowsRequest const& BulkMutatorState::BeforeStart() {
-  mutations_.Swap(&pending_mutations_);
+  std::swap(mutations_, pending_mutations_);
   annotations_.swap(pending_annotations_);
   for (auto& a : annotations_) {
     a.has_mutation_result = false;
   }
-  pending_mutations_ = {};
-  pending_mutations_.set_app_profile_id(mutations_.app_profile_id());
-  pending_mutations_.set_table_name(mutations_.table_name());
-  pending_annotations_ = {};
+  // Clear() (vs. assigning a fresh message) retains the storage of the
+  // husk entries left behind by the Swap() calls in OnRead() and
+  // OnFinish(); add_entries() reuses that storage on the next attempt
+  // instead of allocating new entries and nested mutations.
+  pending_mutations_->Clear();
+  pending_mutations_->set_app_profile_id(mutations_->app_profile_id());
+  pending_mutations_->set_table_name(mutations_->table_name());
+  pending_annotations_.clear();
 
-  return mutations_;
+  return *mutations_;
 }
 
 std::vector<int> BulkMutatorState::OnRead(
@@ -95,15 +135,19 @@ std::vector<int> BulkMutatorState::OnRead(
     // this class takes ownership in the constructor.
     if (grpc::StatusCode::OK == code) {
       res.push_back(annotation.original_index);
+      // Release the acknowledged mutation's memory right away instead of
+      // holding it until the next attempt starts; a large bulk load's
+      // footprint is then bounded by its unacknowledged mutations only.
+      mutations_->mutable_entries(index)->Clear();
       continue;
     }
-    auto& original = *mutations_.mutable_entries(index);
+    auto& original = *mutations_->mutable_entries(index);
     // Failed responses are handled according to the current policies.
     if (SafeGrpcRetry::IsTransientFailure(code) && annotation.is_idempotent) {
       // Retryable requests are saved in the pending mutations, along with the
       // mapping from their index in pending_mutations_ to the original
       // vector and other miscellanea.
-      pending_mutations_.add_entries()->Swap(&original);
+      pending_mutations_->add_entries()->Swap(&original);
       pending_annotations_.push_back(annotation);
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
@@ -126,11 +170,11 @@ void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
       continue;
     }
     // If there are any mutations with unknown state, they need to be handled.
-    auto& original = *mutations_.mutable_entries(index);
+    auto& original = *mutations_->mutable_entries(index);
     if (annotation.is_idempotent) {
       // If the mutation was retryable, move it to the pending mutations to try
       // again, along with their index.
-      pending_mutations_.add_entries()->Swap(&original);
+      pending_mutations_->add_entries()->Swap(&original);
       pending_annotations_.push_back(annotation);
     } else {
       if (last_status_.ok()) {
@@ -160,7 +204,7 @@ std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
 std::vector<FailedMutation> BulkMutatorState::OnRetryDone() && {
   std::vector<FailedMutation> result(std::move(failures_));
 
-  auto size = pending_mutations_.mutable_entries()->size();
+  auto size = pending_mutations_->mutable_entries()->size();
   for (int idx = 0; idx != size; idx++) {
     int original_index = pending_annotations_[idx].original_index;
     if (last_status_.ok()) {
@@ -185,18 +229,40 @@ BulkMutator::BulkMutator(std::string const& app_profile_id,
                          BulkMutation mut)
     : state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
 
+BulkMutator::BulkMutator(std::string const& app_profile_id,
+                         std::string const& table_name,
+                         IdempotentMutationPolicy& idempotent_policy,
+                         ArenaBulkMutation mut)
+    : state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+
 grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
                                          grpc::ClientContext& client_context) {
+  return MakeOneRequest(client, client_context, std::function<void(int)>{});
+}
+
+grpc::Status BulkMutator::MakeOneRequest(
+    bigtable::DataClient& client, grpc::ClientContext& client_context,
+    std::function<void(int)> const& on_success) {
   // Send the request to the server.
   auto const& mutations = state_.BeforeStart();
-  auto stream = client.MutateRows(&client_context, mutations);
+  RecordAttemptLatency attempt(RpcMetrics::Method::kBulkApply);
+  auto stream =
+      client.MutateRows(&client_context, mutations, TrafficClass::kBulk);
   // Read the stream of responses.
   btproto::MutateRowsResponse response;
   while (stream->Read(&response)) {
-    state_.OnRead(response);
+    auto succeeded = state_.OnRead(response);
+    if (on_success) {
+      // Report the successes as the acknowledgments stream in, rather than
+      // waiting for the last retry to complete.
+      for (int original_index : succeeded) {
+        on_success(original_index);
+      }
+    }
   }
   // Handle any errors in the stream.
   auto grpc_status = stream->Finish();
+  attempt.Record(grpc_status.ok());
   state_.OnFinish(MakeStatusFromRpcError(grpc_status));
   return grpc_status;
 }
@@ -21,6 +21,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/make_unique.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -34,8 +35,19 @@ class BulkMutatorState {
                    IdempotentMutationPolicy& idempotent_policy,
                    BulkMutation mut);
 
+  /// Use the arena-owned request of @p mut in place, with no copies.
+  BulkMutatorState(std::string const& app_profile_id,
+                   std::string const& table_name,
+                   IdempotentMutationPolicy& idempotent_policy,
+                   ArenaBulkMutation mut);
+
   bool HasPendingMutations() const {
-    return pending_mutations_.entries_size() != 0;
+    return pending_mutations_->entries_size() != 0;
+  }
+
+  /// The serialized size of the next MutateRows() request, in bytes.
+  std::size_t PendingRequestSize() const {
+    return pending_mutations_->ByteSizeLong();
   }
 
   /// Returns the Request parameter for the next MutateRows() RPC.
@@ -65,8 +77,33 @@ class BulkMutatorState {
   std::vector<FailedMutation> OnRetryDone() &&;
 
  private:
+  /**
+   * Record the idempotency of each pending mutation, see `annotations_`.
+   *
+   * @param safe_idempotent_hints the per-row idempotency bits cached when
+   *     the mutations were built, aligned with the pending entries.
+   */
+  void AnnotatePendingMutations(IdempotentMutationPolicy& idempotent_policy,
+                                std::vector<bool> const& safe_idempotent_hints);
+
+  /**
+   * Keeps the request protos (and their strings) alive.
+   *
+   * The requests are held through pointers so that `BeforeStart()` can
+   * swap the current and pending requests without touching the protos;
+   * when they live on an arena a message-level `Swap()` would copy.
+   * In the `BulkMutation` path the protos are heap-allocated and owned
+   * by `mutations_storage_` and `pending_mutations_storage_`; in the
+   * `ArenaBulkMutation` path both are owned by the arena and the
+   * `unique_ptr`s stay null.
+   */
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::unique_ptr<google::bigtable::v2::MutateRowsRequest> mutations_storage_;
+  std::unique_ptr<google::bigtable::v2::MutateRowsRequest>
+      pending_mutations_storage_;
+
   /// The current request proto.
-  google::bigtable::v2::MutateRowsRequest mutations_;
+  google::bigtable::v2::MutateRowsRequest* mutations_;
 
   /**
    * The status of the last MutateRows() RPC
@@ -104,7 +141,7 @@ class BulkMutatorState {
   std::vector<Annotations> annotations_;
 
   /// Accumulate mutations for the next request.
-  google::bigtable::v2::MutateRowsRequest pending_mutations_;
+  google::bigtable::v2::MutateRowsRequest* pending_mutations_;
 
   /// Accumulate annotations for the next request.
   std::vector<Annotations> pending_annotations_;
@@ -116,13 +153,35 @@ class BulkMutator {
   BulkMutator(std::string const& app_profile_id, std::string const& table_name,
               IdempotentMutationPolicy& idempotent_policy, BulkMutation mut);
 
+  BulkMutator(std::string const& app_profile_id, std::string const& table_name,
+              IdempotentMutationPolicy& idempotent_policy,
+              ArenaBulkMutation mut);
+
   /// Return true if there are pending mutations in the mutator
   bool HasPendingMutations() const { return state_.HasPendingMutations(); }
 
+  /// The serialized size of the next request, used to decide on per-call
+  /// compression.
+  std::size_t PendingRequestSize() const {
+    return state_.PendingRequestSize();
+  }
+
   /// Synchronously send one batch request to the given stub.
   grpc::Status MakeOneRequest(bigtable::DataClient& client,
                               grpc::ClientContext& client_context);
 
+  /**
+   * Synchronously send one batch request to the given stub, streaming the
+   * successes.
+   *
+   * @param on_success invoked with the original index of each mutation as
+   *     its acknowledgment arrives; the memory of an acknowledged
+   *     mutation is released before its callback runs.
+   */
+  grpc::Status MakeOneRequest(bigtable::DataClient& client,
+                              grpc::ClientContext& client_context,
+                              std::function<void(int)> const& on_success);
+
   /// Give up on any pending mutations, move them to the failures array.
   std::vector<FailedMutation> OnRetryDone() &&;
 
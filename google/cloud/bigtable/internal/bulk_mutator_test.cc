@@ -487,3 +487,142 @@ TEST(MultipleRowsMutatorTest, UnconfirmedAreFailed) {
   EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied,
             failures.front().status().code());
 }
+
+/// @test Verify that arena-backed mutations are retried without copies.
+TEST(MultipleRowsMutatorTest, ArenaRetryPartialFailure) {
+  // Same scenario as RetryPartialFailure, but the mutations live on the
+  // arena of an ArenaBulkMutation.
+  bt::ArenaBulkMutation mut;
+  mut.StartRow("foo");
+  mut.SetCell("fam", "col", 0_ms, "baz");
+  mut.StartRow("bar");
+  mut.SetCell("fam", "col", 0_ms, "qux");
+
+  auto r1 = google::cloud::internal::make_unique<MockMutateRowsReader>(
+      "google.bigtable.v2.Bigtable.MutateRows");
+  EXPECT_CALL(*r1, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        // Simulate a partial (and recoverable) failure.
+        auto& e0 = *r->add_entries();
+        e0.set_index(0);
+        e0.mutable_status()->set_code(grpc::StatusCode::UNAVAILABLE);
+        auto& e1 = *r->add_entries();
+        e1.set_index(1);
+        e1.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r1, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto r2 = google::cloud::internal::make_unique<MockMutateRowsReader>(
+      "google.bigtable.v2.Bigtable.MutateRows");
+  EXPECT_CALL(*r2, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        auto& e = *r->add_entries();
+        e.set_index(0);
+        e.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  bigtable::testing::MockDataClient client;
+  EXPECT_CALL(client, MutateRows(_, _))
+      .WillOnce(Invoke(
+          [&r1](grpc::ClientContext*, btproto::MutateRowsRequest const& req) {
+            EXPECT_EQ(2, req.entries_size());
+            return r1.release()->AsUniqueMocked();
+          }))
+      .WillOnce(Invoke(
+          [&r2](grpc::ClientContext*, btproto::MutateRowsRequest const& req) {
+            // Only the failed mutation is retried, and the request stays on
+            // the arena.
+            EXPECT_EQ(1, req.entries_size());
+            EXPECT_EQ("foo", req.entries(0).row_key());
+            EXPECT_NE(nullptr, req.GetArena());
+            return r2.release()->AsUniqueMocked();
+          }));
+
+  auto policy = bt::DefaultIdempotentMutationPolicy();
+  bt::internal::BulkMutator mutator("", "foo/bar/baz/table", *policy,
+                                    std::move(mut));
+
+  for (int i = 0; i != 2; ++i) {
+    EXPECT_TRUE(mutator.HasPendingMutations());
+    auto context = TestContext();
+    auto status = mutator.MakeOneRequest(client, *context);
+    EXPECT_TRUE(status.ok());
+  }
+  auto failures = std::move(mutator).OnRetryDone();
+  EXPECT_TRUE(failures.empty());
+}
+
+/// @test Verify that successes are streamed to the on_success callback.
+TEST(MultipleRowsMutatorTest, StreamingSuccessCallback) {
+  // In this test we create a Mutation for two rows; the first attempt
+  // acknowledges "foo" and transiently fails "bar", the second attempt
+  // acknowledges "bar".
+  bt::BulkMutation mut(
+      bt::SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+      bt::SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "qux")}));
+
+  auto r1 = google::cloud::internal::make_unique<MockMutateRowsReader>(
+      "google.bigtable.v2.Bigtable.MutateRows");
+  EXPECT_CALL(*r1, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        auto& e0 = *r->add_entries();
+        e0.set_index(0);
+        e0.mutable_status()->set_code(grpc::StatusCode::OK);
+        auto& e1 = *r->add_entries();
+        e1.set_index(1);
+        e1.mutable_status()->set_code(grpc::StatusCode::UNAVAILABLE);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r1, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto r2 = google::cloud::internal::make_unique<MockMutateRowsReader>(
+      "google.bigtable.v2.Bigtable.MutateRows");
+  EXPECT_CALL(*r2, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        auto& e = *r->add_entries();
+        e.set_index(0);
+        e.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  bigtable::testing::MockDataClient client;
+  EXPECT_CALL(client, MutateRows(_, _))
+      .WillOnce(Invoke(
+          [&r1](grpc::ClientContext*, btproto::MutateRowsRequest const&) {
+            return r1.release()->AsUniqueMocked();
+          }))
+      .WillOnce(Invoke(
+          [&r2](grpc::ClientContext*, btproto::MutateRowsRequest const&) {
+            return r2.release()->AsUniqueMocked();
+          }));
+
+  auto policy = bt::DefaultIdempotentMutationPolicy();
+  bt::internal::BulkMutator mutator("", "foo/bar/baz/table", *policy,
+                                    std::move(mut));
+
+  std::vector<int> succeeded;
+  auto on_success = [&succeeded](int index) { succeeded.push_back(index); };
+
+  EXPECT_TRUE(mutator.HasPendingMutations());
+  auto c1 = TestContext();
+  EXPECT_TRUE(mutator.MakeOneRequest(client, *c1, on_success).ok());
+  // "foo" was reported as soon as its acknowledgment arrived.
+  EXPECT_EQ(std::vector<int>({0}), succeeded);
+
+  EXPECT_TRUE(mutator.HasPendingMutations());
+  auto c2 = TestContext();
+  EXPECT_TRUE(mutator.MakeOneRequest(client, *c2, on_success).ok());
+  // "bar" is reported with its original index.
+  EXPECT_EQ(std::vector<int>({0, 1}), succeeded);
+
+  auto failures = std::move(mutator).OnRetryDone();
+  EXPECT_TRUE(failures.empty());
+}
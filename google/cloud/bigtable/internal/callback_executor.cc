@@ -0,0 +1,75 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/callback_executor.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+CallbackExecutor::CallbackExecutor(std::size_t thread_count,
+                                   std::size_t queue_limit)
+    : queue_limit_(queue_limit), shutdown_(false) {
+  workers_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    workers_.emplace_back([this] { Worker(); });
+  }
+}
+
+CallbackExecutor::~CallbackExecutor() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  ready_cv_.notify_all();
+  space_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void CallbackExecutor::Submit(std::function<void()> callback) {
+  std::unique_lock<std::mutex> lk(mu_);
+  space_cv_.wait(
+      lk, [this] { return queue_.size() < queue_limit_ || shutdown_; });
+  queue_.push(std::move(callback));
+  lk.unlock();
+  ready_cv_.notify_one();
+}
+
+void CallbackExecutor::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    ready_cv_.wait(lk, [this] { return !queue_.empty() || shutdown_; });
+    if (queue_.empty()) {
+      // Shutting down and the queue is drained.
+      return;
+    }
+    auto callback = std::move(queue_.front());
+    queue_.pop();
+    lk.unlock();
+    space_cv_.notify_one();
+    callback();
+    lk.lock();
+  }
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
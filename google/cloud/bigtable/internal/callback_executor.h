@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CALLBACK_EXECUTOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CALLBACK_EXECUTOR_H
+
+#include "google/cloud/bigtable/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A fixed-size thread pool with a bounded work queue.
+ *
+ * `MutationBatcher` uses this class to run user callbacks off the
+ * `CompletionQueue` threads, so a slow callback does not stall RPC progress
+ * for unrelated operations. The work queue is bounded: `Submit()` blocks
+ * while the queue is full, applying backpressure to the submitter instead of
+ * buffering an unbounded backlog of callbacks.
+ */
+class CallbackExecutor {
+ public:
+  CallbackExecutor(std::size_t thread_count, std::size_t queue_limit);
+
+  /// Runs all the queued callbacks to completion before returning.
+  ~CallbackExecutor();
+
+  CallbackExecutor(CallbackExecutor const&) = delete;
+  CallbackExecutor& operator=(CallbackExecutor const&) = delete;
+
+  /// Schedule @p callback to run on the pool, blocks while the queue is full.
+  void Submit(std::function<void()> callback);
+
+ private:
+  /// The main loop of each worker thread.
+  void Worker();
+
+  std::mutex mu_;
+  /// Signalled when a callback is queued or shutdown starts.
+  std::condition_variable ready_cv_;
+  /// Signalled when a callback is dequeued, unblocking `Submit()`.
+  std::condition_variable space_cv_;
+  std::queue<std::function<void()>> queue_;
+  std::size_t const queue_limit_;
+  bool shutdown_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CALLBACK_EXECUTOR_H
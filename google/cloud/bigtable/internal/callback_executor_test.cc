@@ -0,0 +1,68 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/callback_executor.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(CallbackExecutorTest, RunsAllSubmittedCallbacks) {
+  std::atomic<int> counter(0);
+  {
+    CallbackExecutor executor(4, 100);
+    for (int i = 0; i != 50; ++i) {
+      executor.Submit([&counter] { ++counter; });
+    }
+    // The destructor drains the queue before joining the workers.
+  }
+  EXPECT_EQ(50, counter.load());
+}
+
+TEST(CallbackExecutorTest, BoundedQueueBlocksSubmitters) {
+  CallbackExecutor executor(1, 1);
+  std::promise<void> release_promise;
+  auto release = release_promise.get_future().share();
+  // Occupy the only worker thread...
+  executor.Submit([release] { release.wait(); });
+  // ... and fill the queue.
+  executor.Submit([] {});
+  std::atomic<bool> submitted(false);
+  std::thread submitter([&executor, &submitted] {
+    executor.Submit([] {});
+    submitted = true;
+  });
+  // The submission should block while the queue is full.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(submitted.load());
+  // Unblocking the worker drains the queue and unblocks the submitter.
+  release_promise.set_value();
+  submitter.join();
+  EXPECT_TRUE(submitted.load());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
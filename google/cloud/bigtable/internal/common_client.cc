@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 
 #include "google/cloud/bigtable/internal/common_client.h"
+#include <algorithm>
+#include <limits>
 
 namespace google {
 namespace cloud {
@@ -19,18 +21,58 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+std::shared_ptr<grpc::Channel> CreatePooledChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t id, std::size_t epoch, bigtable::TrafficClass traffic_class) {
+  auto args = options.channel_arguments();
+  if (!options.connection_pool_name().empty()) {
+    args.SetString("cbt-c++/connection-pool-name",
+                   options.connection_pool_name());
+  }
+  args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(id));
+  if (traffic_class == bigtable::TrafficClass::kBulk) {
+    // The distinct argument keeps gRPC from multiplexing bulk traffic
+    // over a serving-lane connection with the same pool id.
+    args.SetString("cbt-c++/traffic-class", "bulk");
+  }
+  if (epoch != 0) {
+    // gRPC shares the underlying connection between channels with the same
+    // target and arguments. A refreshed channel must get a new connection,
+    // so its arguments have to differ from all previous channels with this
+    // pool id.
+    args.SetInt("cbt-c++/connection-refresh-epoch", static_cast<int>(epoch));
+  }
+  auto const bdp = options.bandwidth_delay_product();
+  if (bdp != 0) {
+    // A stream cannot have more data in flight than its flow-control
+    // window, size the window for the configured bandwidth-delay product
+    // so a single `ReadRows` stream can keep the pipe full. The explicit
+    // window is authoritative, disable gRPC's own probe so it does not
+    // shrink or fight the configuration.
+    auto const window = static_cast<int>((std::min)(
+        bdp, static_cast<std::size_t>((std::numeric_limits<int>::max)())));
+    args.SetInt(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES, window);
+    args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 0);
+  } else {
+    // Without a configured product let gRPC measure the link and grow
+    // both the stream and connection windows automatically.
+    args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 1);
+  }
+  return grpc::CreateCustomChannel(endpoint, options.credentials(), args);
+}
+
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options) {
   std::vector<std::shared_ptr<grpc::Channel>> result;
   for (std::size_t i = 0; i != options.connection_pool_size(); ++i) {
-    auto args = options.channel_arguments();
-    if (!options.connection_pool_name().empty()) {
-      args.SetString("cbt-c++/connection-pool-name",
-                     options.connection_pool_name());
-    }
-    args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(i));
-    result.push_back(
-        grpc::CreateCustomChannel(endpoint, options.credentials(), args));
+    result.push_back(CreatePooledChannel(endpoint, options, i, 0));
+    // Creating the channel performs no network I/O, gRPC connects lazily
+    // and the first RPC on each channel would pay for the TCP+TLS+HTTP/2
+    // handshake. Asking for the state with `try_to_connect == true` starts
+    // the handshake on gRPC's own threads without blocking this one; all
+    // the channels connect concurrently, so the whole pool is usable
+    // within roughly one handshake time.
+    result.back()->GetState(true);
   }
   return result;
 }
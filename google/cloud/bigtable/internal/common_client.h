@@ -18,6 +18,12 @@
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/version.h"
 #include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <random>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -25,6 +31,23 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Create one element of the channel pool.
+ *
+ * @param id the position of the channel in the pool, used to force gRPC
+ *     to open a separate connection for each element.
+ * @param epoch incremented each time the channel at @p id is refreshed,
+ *     zero for the initial pool; refreshed channels need distinct
+ *     arguments or gRPC would reuse the old connection.
+ * @param traffic_class channels of different classes get distinct
+ *     arguments, so the bulk lane never shares a connection with the
+ *     serving lane.
+ */
+std::shared_ptr<grpc::Channel> CreatePooledChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t id, std::size_t epoch,
+    bigtable::TrafficClass traffic_class = bigtable::TrafficClass::kServing);
+
 /// Create a pool of grpc::Channel objects based on the client options.
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
@@ -56,6 +79,17 @@ class CommonClient {
   CommonClient(bigtable::ClientOptions options)
       : options_(std::move(options)), current_index_(0) {}
 
+  ~CommonClient() {
+    {
+      std::lock_guard<std::mutex> lk(refresh_mu_);
+      refresh_shutdown_ = true;
+    }
+    refresh_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+      refresh_thread_.join();
+    }
+  }
+
   /**
    * Reset the channel and stub.
    *
@@ -66,14 +100,69 @@ class CommonClient {
   void reset() {
     std::lock_guard<std::mutex> lk(mu_);
     stubs_.clear();
+    bulk_stubs_.clear();
+    bulk_channels_.clear();
+  }
+
+  /**
+   * Create the channel pool and start connecting, without blocking.
+   *
+   * Normally the pool is created on the first RPC, which then also pays
+   * for the connection handshakes. Calling this member function at
+   * client construction time moves that work to the background:
+   * `CreateChannelPool()` asks every channel to start connecting, and
+   * gRPC completes the handshakes on its own threads while the
+   * application finishes its setup.
+   */
+  void PreConnect() {
+    std::unique_lock<std::mutex> lk(mu_);
+    CheckConnections(lk);
+  }
+
+  /// The options this pool was created with.
+  bigtable::ClientOptions const& Options() const { return options_; }
+
+  /// The outstanding-RPC count of each channel in the serving lane.
+  std::vector<long> OutstandingPerChannel() {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<long> result;
+    result.reserve(outstanding_.size());
+    for (auto const& counter : outstanding_) {
+      result.push_back(counter->load(std::memory_order_relaxed));
+    }
+    return result;
   }
 
   /// Return the next Stub to make a call.
-  StubPtr Stub() {
+  StubPtr Stub(
+      bigtable::TrafficClass traffic_class = bigtable::TrafficClass::kServing) {
     std::unique_lock<std::mutex> lk(mu_);
     CheckConnections(lk);
-    auto stub = stubs_[GetIndex()];
-    return stub;
+    if (traffic_class == bigtable::TrafficClass::kBulk &&
+        !bulk_stubs_.empty()) {
+      // The bulk lane is throughput-oriented, plain round-robin is good
+      // enough and its streams are too long-lived for outstanding-RPC
+      // counters to be a meaningful load signal.
+      auto stub = bulk_stubs_[bulk_index_++ % bulk_stubs_.size()];
+      return stub;
+    }
+    auto const index = GetIndex();
+    auto stub = stubs_[index];
+    auto counter = outstanding_[index];
+    counter->fetch_add(1, std::memory_order_relaxed);
+    MaybeResizePool(lk);
+    lk.unlock();
+    // Wrap the stub so that releasing the returned handle decrements the
+    // channel's outstanding-RPC count. For synchronous calls the handle
+    // lives exactly as long as the RPC (see `DefaultDataClient`, the stub
+    // is a temporary in the call expression), so the counter approximates
+    // the per-channel load quite well.
+    auto* raw = stub.get();
+    return StubPtr(raw,
+                   [stub, counter](typename Interface::StubInterface*) mutable {
+                     counter->fetch_sub(1, std::memory_order_relaxed);
+                     stub.reset();
+                   });
   }
 
   /// Return the next Channel to make a call.
@@ -101,17 +190,39 @@ class CommonClient {
     // introduce attributes in the implementation of CreateChannelPool() to
     // create one socket per element in the pool.
     lk.unlock();
-    auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
+    auto endpoint = Traits::Endpoint(options_);
+    auto channels = CreateChannelPool(endpoint, options_);
     std::vector<StubPtr> tmp;
     std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
                    [](std::shared_ptr<grpc::Channel> ch) {
                      return Interface::NewStub(ch);
                    });
+    std::vector<std::shared_ptr<std::atomic<long>>> counters(channels.size());
+    for (auto& counter : counters) {
+      counter = std::make_shared<std::atomic<long>>(0);
+    }
+    // The bulk lane, when configured, gets its own connections; its
+    // channels are excluded from the dynamic resizing and the staggered
+    // refresh, which only matter for the latency-sensitive lane.
+    std::vector<ChannelPtr> bulk_channels;
+    std::vector<StubPtr> bulk_tmp;
+    for (std::size_t i = 0; i != options_.bulk_connection_pool_size(); ++i) {
+      bulk_channels.push_back(CreatePooledChannel(
+          endpoint, options_, i, 0, bigtable::TrafficClass::kBulk));
+      bulk_channels.back()->GetState(true);
+      bulk_tmp.push_back(Interface::NewStub(bulk_channels.back()));
+    }
     lk.lock();
     if (stubs_.empty()) {
       channels.swap(channels_);
       tmp.swap(stubs_);
+      counters.swap(outstanding_);
+      bulk_channels.swap(bulk_channels_);
+      bulk_tmp.swap(bulk_stubs_);
       current_index_ = 0;
+      bulk_index_ = 0;
+      next_channel_id_ = channels_.size();
+      StartRefreshThread();
     } else {
       // Some other thread created the pool and saved it in `stubs_`. The work
       // in this thread was superfluous. We release the lock while clearing the
@@ -119,18 +230,185 @@ class CommonClient {
       lk.unlock();
       tmp.clear();
       channels.clear();
+      bulk_tmp.clear();
+      bulk_channels.clear();
       lk.lock();
     }
   }
 
-  /// Get the current index for round-robin over connections.
+  /**
+   * Grow or shrink the pool based on the outstanding RPC load.
+   *
+   * Disabled unless `max_connection_pool_size()` is set. The pool grows
+   * by one channel when the average outstanding RPCs per channel reach
+   * `kGrowThreshold` — well below the ~100 concurrent streams a gRPC
+   * channel supports, so new streams never queue behind the cap — and
+   * shrinks by one when the remaining channels would still be at no
+   * more than a quarter of that threshold. Shrinking is rate-limited so
+   * the pool does not flap around the threshold.
+   *
+   * The caller must own the lock on `mu_`; the lock is released (and
+   * re-acquired) while creating a new channel.
+   */
+  void MaybeResizePool(std::unique_lock<std::mutex>& lk) {
+    std::size_t constexpr kGrowThreshold = 64;
+    auto constexpr kResizeCooldown = std::chrono::seconds(60);
+
+    auto const max_size = options_.max_connection_pool_size();
+    if (max_size == 0) {
+      return;
+    }
+    std::size_t const size = stubs_.size();
+    long total = 0;
+    for (auto const& counter : outstanding_) {
+      total += counter->load(std::memory_order_relaxed);
+    }
+    auto const now = std::chrono::steady_clock::now();
+    if (size < max_size &&
+        total >= static_cast<long>(kGrowThreshold * size)) {
+      auto const id = next_channel_id_++;
+      auto endpoint = Traits::Endpoint(options_);
+      lk.unlock();
+      auto channel = CreatePooledChannel(endpoint, options_, id, 0);
+      // Start the handshake in the background, the channel takes load
+      // immediately but only blocks the RPCs it actually carries.
+      channel->GetState(true);
+      auto stub = StubPtr(Interface::NewStub(channel));
+      auto counter = std::make_shared<std::atomic<long>>(0);
+      lk.lock();
+      if (!stubs_.empty()) {
+        channels_.push_back(std::move(channel));
+        stubs_.push_back(std::move(stub));
+        outstanding_.push_back(std::move(counter));
+        last_resize_ = now;
+      }
+      return;
+    }
+    if (size > options_.connection_pool_size() &&
+        now - last_resize_ >= kResizeCooldown &&
+        total * 4 <= static_cast<long>(kGrowThreshold * (size - 1))) {
+      // Drop the least loaded channel; calls in flight on it own their
+      // stub (and counter) through the handles returned by `Stub()`, so
+      // they complete undisturbed.
+      std::size_t least = 0;
+      for (std::size_t i = 1; i != outstanding_.size(); ++i) {
+        if (outstanding_[i]->load(std::memory_order_relaxed) <
+            outstanding_[least]->load(std::memory_order_relaxed)) {
+          least = i;
+        }
+      }
+      channels_.erase(channels_.begin() + least);
+      stubs_.erase(stubs_.begin() + least);
+      outstanding_.erase(outstanding_.begin() + least);
+      if (current_index_ >= stubs_.size()) {
+        current_index_ = 0;
+      }
+      last_resize_ = now;
+    }
+  }
+
+  /// Start the staggered channel refresh, if configured and not running.
+  void StartRefreshThread() {
+    if (options_.channel_refresh_period() <= std::chrono::milliseconds(0)) {
+      return;
+    }
+    if (refresh_thread_.joinable()) {
+      return;
+    }
+    refresh_thread_ = std::thread([this] { RefreshLoop(); });
+  }
+
+  /**
+   * Proactively rebuild one channel at a time, on a jittered schedule.
+   *
+   * The server drops connections when they reach their maximum age, and
+   * a pool created all at once reconnects all at once. This loop cycles
+   * through the pool every `channel_refresh_period()`, replacing one
+   * channel per step. The replacement connects *before* it is swapped
+   * into the pool, so at most one channel is cold at any time and the
+   * RPCs never observe a reconnecting channel. The sleep between steps
+   * is jittered by +/-25% so multiple clients do not synchronize.
+   */
+  void RefreshLoop() {
+    std::mt19937 generator(std::random_device{}());
+    std::size_t index = 0;
+    std::size_t epoch = 1;
+    for (;;) {
+      std::size_t size;
+      std::string endpoint;
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        size = channels_.size();
+        endpoint = Traits::Endpoint(options_);
+      }
+      if (size == 0) {
+        return;
+      }
+      auto step = options_.channel_refresh_period() / size;
+      if (step < std::chrono::milliseconds(1)) {
+        step = std::chrono::milliseconds(1);
+      }
+      std::uniform_int_distribution<std::int64_t> jitter(
+          3 * step.count() / 4, 5 * step.count() / 4);
+      auto const sleep = std::chrono::milliseconds(jitter(generator));
+      {
+        std::unique_lock<std::mutex> lk(refresh_mu_);
+        if (refresh_cv_.wait_for(lk, sleep,
+                                 [this] { return refresh_shutdown_; })) {
+          return;
+        }
+      }
+      if (index >= size) {
+        index = 0;
+      }
+      // Build and connect the replacement before installing it, the pool
+      // keeps serving RPCs over the old (still warm) channel meanwhile.
+      auto channel = CreatePooledChannel(endpoint, options_, index, epoch);
+      channel->GetState(true);
+      (void)channel->WaitForConnected(std::chrono::system_clock::now() +
+                                      std::chrono::seconds(30));
+      auto stub = StubPtr(Interface::NewStub(channel));
+      auto counter = std::make_shared<std::atomic<long>>(0);
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (index < stubs_.size()) {
+          channels_[index] = std::move(channel);
+          stubs_[index] = std::move(stub);
+          // In-flight calls keep decrementing the counter they
+          // incremented, the fresh channel starts unloaded.
+          outstanding_[index] = std::move(counter);
+        }
+      }
+      ++index;
+      ++epoch;
+    }
+  }
+
+  /**
+   * Pick the connection for the next call.
+   *
+   * This is the classic "power of two choices" policy: compare the
+   * outstanding-RPC counts of two rotating candidates and pick the less
+   * loaded one. A channel stuck behind a slow tablet server accumulates
+   * outstanding calls and stops receiving new RPCs until it drains,
+   * while under even load the rotation degenerates to plain round-robin
+   * (ties go to the first candidate).
+   */
   std::size_t GetIndex() {
-    std::size_t current = current_index_++;
+    std::size_t const first = current_index_++;
     // Round robin through the connections.
     if (current_index_ >= stubs_.size()) {
       current_index_ = 0;
     }
-    return current;
+    if (stubs_.size() <= 1) {
+      return first;
+    }
+    std::size_t const second = current_index_;
+    auto const first_load =
+        outstanding_[first]->load(std::memory_order_relaxed);
+    auto const second_load =
+        outstanding_[second]->load(std::memory_order_relaxed);
+    return second_load < first_load ? second : first;
   }
 
  private:
@@ -138,7 +416,32 @@ class CommonClient {
   ClientOptions options_;
   std::vector<ChannelPtr> channels_;
   std::vector<StubPtr> stubs_;
+  /**
+   * The outstanding-RPC count for each channel, aligned with `stubs_`.
+   *
+   * The counters are shared with the deleters of the handles returned by
+   * `Stub()`, so counters from a pool discarded by `reset()` stay valid
+   * until their in-flight calls complete.
+   */
+  std::vector<std::shared_ptr<std::atomic<long>>> outstanding_;
+  /// The bulk-traffic lane, empty unless
+  /// `bulk_connection_pool_size()` is configured.
+  std::vector<ChannelPtr> bulk_channels_;
+  std::vector<StubPtr> bulk_stubs_;
+  std::size_t bulk_index_ = 0;
   std::size_t current_index_;
+  /// The pool id for the next dynamically added channel; ids are never
+  /// reused, each one maps to a distinct gRPC connection.
+  std::size_t next_channel_id_ = 0;
+  std::chrono::steady_clock::time_point last_resize_ =
+      std::chrono::steady_clock::now();
+  /// The staggered refresh loop, only started when the refresh period is
+  /// configured; `refresh_mu_` protects only the shutdown flag so the
+  /// loop never sleeps while holding `mu_`.
+  std::thread refresh_thread_;
+  std::mutex refresh_mu_;
+  std::condition_variable refresh_cv_;
+  bool refresh_shutdown_ = false;
 };
 
 }  // namespace internal
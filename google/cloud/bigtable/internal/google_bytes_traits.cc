@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/google_bytes_traits.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -29,8 +32,42 @@ bool ConsecutiveRowKeys(std::string const& a, std::string const& b) {
   if (b.back() != '\0') {
     return false;
   }
-  return b.compare(0, a.length(), a) == 0;
+  return CommonRowKeyPrefix(a, b) == a.length();
 }
+
+std::size_t CommonRowKeyPrefix(std::string const& a, std::string const& b) {
+  std::size_t const n = (std::min)(a.size(), b.size());
+  std::size_t i = 0;
+  // Compare one word at a time. The memcpy() calls compile to single
+  // (unaligned) loads on the platforms we care about, and the compiler
+  // builtins find the mismatching byte without a loop.
+  while (i + sizeof(std::uint64_t) <= n) {
+    std::uint64_t wa;
+    std::uint64_t wb;
+    std::memcpy(&wa, a.data() + i, sizeof(wa));
+    std::memcpy(&wb, b.data() + i, sizeof(wb));
+    std::uint64_t x = wa ^ wb;
+    if (x != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+      // The first differing byte in memory order is the least (most)
+      // significant non-zero byte of `x` on little (big) endian.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      return i + __builtin_clzll(x) / 8;
+#else
+      return i + __builtin_ctzll(x) / 8;
+#endif
+#else
+      break;  // Fall back to the byte-wise loop below.
+#endif
+    }
+    i += sizeof(std::uint64_t);
+  }
+  while (i < n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
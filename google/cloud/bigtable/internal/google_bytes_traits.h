@@ -18,6 +18,9 @@
 #include "google/cloud/bigtable/internal/google_bytes_traits.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/big_endian.h"
+#include <cstddef>
+#include <string>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -53,6 +56,30 @@ inline int CompareRowKey(std::string const& lhs, std::string const& rhs) {
 /// Returns true iff a < b and there is no string c such that a < c < b.
 bool ConsecutiveRowKeys(std::string const& a, std::string const& b);
 
+/**
+ * Return the length of the longest common prefix of @p a and @p b.
+ *
+ * Composite row keys often share long prefixes (a customer id, a
+ * shard, a reversed domain). This function compares a word at a time,
+ * so callers that need the first mismatching byte, e.g. the range
+ * membership tests in `RowRange`, do not pay a byte-wise loop over the
+ * shared prefix.
+ */
+std::size_t CommonRowKeyPrefix(std::string const& a, std::string const& b);
+
+/**
+ * Compare @p lhs and @p rhs assuming their first @p prefix bytes match.
+ *
+ * Use `CommonRowKeyPrefix()` (or any other out-of-band knowledge) to
+ * obtain @p prefix; the behavior is undefined if the prefixes differ.
+ */
+inline int CompareRowKeysSkipPrefix(std::size_t prefix,
+                                    std::string const& lhs,
+                                    std::string const& rhs) {
+  return lhs.compare(prefix, std::string::npos, rhs, prefix,
+                     std::string::npos);
+}
+
 /// Return `< 0` if `lhs < rhs`, 0 if `lhs == rhs`, and `> 0' otherwise.
 inline int CompareColumnQualifiers(std::string const& lhs,
                                    std::string const& rhs) {
@@ -65,6 +92,24 @@ StatusOr<T> DecodeBigEndianCellValue(std::string const& c) {
   return google::cloud::internal::DecodeBigEndian<T>(std::string(c));
 }
 
+/**
+ * Decode a big-endian `T` from @p p, without validation.
+ *
+ * The caller must have verified that @p p points at `sizeof(T)` bytes.
+ * The batch decoders hoist that validation out of their loops, so this
+ * inner loop is branchless; compilers reduce it to a byte-swapped load.
+ */
+template <typename T>
+inline T DecodeBigEndianUnchecked(char const* p) {
+  using Unsigned = typename std::make_unsigned<T>::type;
+  Unsigned value = 0;
+  for (std::size_t i = 0; i != sizeof(T); ++i) {
+    value = static_cast<Unsigned>((value << 8) |
+                                  static_cast<unsigned char>(p[i]));
+  }
+  return static_cast<T>(value);
+}
+
 /// Return `< 0` if `lhs < rhs`, 0 if `lhs == rhs`, and `> 0' otherwise.
 inline int CompareCellValues(std::string const& lhs, std::string const& rhs) {
   return lhs.compare(rhs);
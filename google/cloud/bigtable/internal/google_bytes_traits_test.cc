@@ -30,6 +30,43 @@ TEST(GoogleBytesTraitsTest, ConsecutiveRowKeys) {
   EXPECT_TRUE(ConsecutiveRowKeys("a", std::string("a\0", 2)));
 }
 
+TEST(GoogleBytesTraitsTest, CommonRowKeyPrefix) {
+  EXPECT_EQ(0U, CommonRowKeyPrefix("", ""));
+  EXPECT_EQ(0U, CommonRowKeyPrefix("", "abc"));
+  EXPECT_EQ(0U, CommonRowKeyPrefix("xyz", "abc"));
+  EXPECT_EQ(2U, CommonRowKeyPrefix("abc", "abd"));
+  EXPECT_EQ(3U, CommonRowKeyPrefix("abc", "abc"));
+  EXPECT_EQ(3U, CommonRowKeyPrefix("abc", "abcdef"));
+}
+
+TEST(GoogleBytesTraitsTest, CommonRowKeyPrefixLongKeys) {
+  // Exercise the word-at-a-time path: mismatches in every byte of a
+  // word, around word boundaries, and with embedded NUL and high-bit
+  // bytes.
+  std::string const base(64, 'a');
+  EXPECT_EQ(64U, CommonRowKeyPrefix(base, base));
+  for (std::size_t i = 0; i != base.size(); ++i) {
+    std::string other = base;
+    other[i] = 'b';
+    EXPECT_EQ(i, CommonRowKeyPrefix(base, other));
+    other[i] = '\0';
+    EXPECT_EQ(i, CommonRowKeyPrefix(base, other));
+    other[i] = '\xFF';
+    EXPECT_EQ(i, CommonRowKeyPrefix(base, other));
+  }
+  EXPECT_EQ(60U, CommonRowKeyPrefix(base, base.substr(0, 60)));
+}
+
+TEST(GoogleBytesTraitsTest, CompareRowKeysSkipPrefix) {
+  EXPECT_EQ(0, CompareRowKeysSkipPrefix(0, "", ""));
+  EXPECT_LT(CompareRowKeysSkipPrefix(2, "abc", "abd"), 0);
+  EXPECT_GT(CompareRowKeysSkipPrefix(2, "abd", "abc"), 0);
+  EXPECT_EQ(0, CompareRowKeysSkipPrefix(3, "abc", "abc"));
+  EXPECT_LT(CompareRowKeysSkipPrefix(3, "abc", "abcdef"), 0);
+  // Bytes must compare as unsigned values.
+  EXPECT_LT(CompareRowKeysSkipPrefix(1, "a\x01", "a\xFF"), 0);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
@@ -34,9 +34,29 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                           "HandleChunk called before taking the previous row");
     return;
   }
+  HandleChunkImpl(std::move(chunk), status);
+}
+
+void ReadRowsParser::HandleResponse(
+    google::bigtable::v2::ReadRowsResponse&& response, grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleResponse after end of stream");
+    return;
+  }
+  for (auto& chunk : *response.mutable_chunks()) {
+    HandleChunkImpl(std::move(chunk), status);
+    if (!status.ok()) {
+      return;
+    }
+  }
+}
 
+void ReadRowsParser::HandleChunkImpl(ReadRowsResponse_CellChunk chunk,
+                                     grpc::Status& status) {
   if (!chunk.row_key().empty()) {
-    if (CompareRowKey(last_seen_row_key_, chunk.row_key()) >= 0) {
+    if (StrictValidation() &&
+        CompareRowKey(*last_seen_row_key_, chunk.row_key()) >= 0) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Row keys are expected in increasing order");
       return;
@@ -46,18 +66,18 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
   }
 
   if (chunk.has_family_name()) {
-    if (!chunk.has_qualifier()) {
+    if (StrictValidation() && !chunk.has_qualifier()) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "New column family must specify qualifier");
       return;
     }
-    using std::swap;
-    swap(*chunk.mutable_family_name()->mutable_value(), cell_.family);
+    family_ =
+        MakeBuffer(std::move(*chunk.mutable_family_name()->mutable_value()));
   }
 
   if (chunk.has_qualifier()) {
-    using std::swap;
-    swap(*chunk.mutable_qualifier()->mutable_value(), cell_.column);
+    column_ =
+        MakeBuffer(std::move(*chunk.mutable_qualifier()->mutable_value()));
   }
 
   if (cell_first_chunk_) {
@@ -67,8 +87,18 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
   std::move(chunk.mutable_labels()->begin(), chunk.mutable_labels()->end(),
             std::back_inserter(cell_.labels));
 
-  if (cell_first_chunk_) {
-    // Most common case, move the value
+  // This is a hint we get about the total size of a value split across
+  // several chunks. Reserving before any append means each byte of a split
+  // value is copied exactly once, reserving after the fact would copy the
+  // accumulated fragments again on the reallocation.
+  if (chunk.value_size() > 0) {
+    internal::ReserveCellValue(cell_.value,
+                               static_cast<std::size_t>(chunk.value_size()));
+  }
+
+  if (cell_first_chunk_ && chunk.value_size() == 0) {
+    // Most common case, a cell fully contained in one chunk, steal the value
+    // from the proto instead of copying it.
     using std::swap;
     swap(*chunk.mutable_value(), cell_.value);
   } else {
@@ -77,54 +107,71 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   cell_first_chunk_ = false;
 
-  // This is a hint we get about the total size, use it to save some memory
-  // allocations.
-  if (chunk.value_size() > 0) {
-    internal::ReserveCellValue(cell_.value,
-                               static_cast<std::size_t>(chunk.value_size()));
-  }
-
   // Last chunk in the cell has zero for value size
   if (chunk.value_size() == 0) {
-    if (cells_.empty()) {
-      if (cell_.row.empty()) {
+    if (cells_in_row_ == 0) {
+      if (StrictValidation() && cell_.row.empty()) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Missing row key at last chunk in cell");
         return;
       }
-      row_key_ = cell_.row;
+      row_key_ = MakeBuffer(cell_.row);
     } else {
-      if (row_key_ != cell_.row) {
+      if (StrictValidation() && *row_key_ != cell_.row) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Different row key in cell chunk");
         return;
       }
     }
-    cells_.emplace_back(MovePartialToCell());
+    if (visitor_ != nullptr) {
+      // Hand the visitor references into the parse buffers, then reuse
+      // the buffers for the next cell; no Cell object is built.
+      visitor_->OnCell(*row_key_, *family_, *column_, cell_.timestamp,
+                       cell_.value, cell_.labels);
+      cell_.value.clear();
+      cell_.labels.clear();
+    } else {
+      cells_.emplace_back(MovePartialToCell());
+    }
+    ++cells_in_row_;
     cell_first_chunk_ = true;
   }
 
   if (chunk.reset_row()) {
+    if (visitor_ != nullptr && cells_in_row_ != 0) {
+      visitor_->OnRowReset();
+    }
     cells_.clear();
+    cells_in_row_ = 0;
     cell_ = {};
-    if (!cell_first_chunk_) {
+    family_ = std::make_shared<std::string const>();
+    column_ = std::make_shared<ColumnQualifierType const>();
+    if (StrictValidation() && !cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Reset row with an unfinished cell");
       return;
     }
   } else if (chunk.commit_row()) {
-    if (!cell_first_chunk_) {
+    if (StrictValidation() && !cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Commit row with an unfinished cell");
       return;
     }
-    if (cells_.empty()) {
+    // Not redundant even for trusted servers: committing with no cells
+    // would dereference a row key that was never set.
+    if (cells_in_row_ == 0) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Commit row missing the row key");
       return;
     }
-    row_ready_ = true;
     last_seen_row_key_ = row_key_;
+    if (visitor_ != nullptr) {
+      visitor_->OnRowCommitted(*row_key_);
+    } else {
+      ready_rows_.emplace_back(std::move(row_key_), std::move(cells_));
+      cells_.clear();
+    }
+    cells_in_row_ = 0;
     cell_.row.clear();
   }
 }
@@ -143,34 +190,49 @@ void ReadRowsParser::HandleEndOfStream(grpc::Status& status) {
     return;
   }
 
-  if (cells_.begin() != cells_.end() && !row_ready_) {
+  // Committed rows moved to `ready_rows_`, anything left in `cells_` (or
+  // delivered to the visitor, counted by `cells_in_row_`) is unfinished.
+  if (cells_.begin() != cells_.end() || cells_in_row_ != 0) {
     status = grpc::Status(grpc::StatusCode::INTERNAL,
                           "end of stream with unfinished row");
     return;
   }
 }
 
-bool ReadRowsParser::HasNext() const { return row_ready_; }
+bool ReadRowsParser::HasNext() const {
+  return next_ready_ != ready_rows_.size();
+}
 
 Row ReadRowsParser::Next(grpc::Status& status) {
-  if (!row_ready_) {
+  if (next_ready_ == ready_rows_.size()) {
     status =
         grpc::Status(grpc::StatusCode::INTERNAL, "Next with row not ready");
     return Row("", {});
   }
-  row_ready_ = false;
-
-  Row row(std::move(row_key_), std::move(cells_));
-  row_key_.clear();
-
+  Row row = std::move(ready_rows_[next_ready_++]);
+  if (next_ready_ == ready_rows_.size()) {
+    // All rows taken, reuse the vector's capacity for the next response.
+    ready_rows_.clear();
+    next_ready_ = 0;
+  }
   return row;
 }
 
+std::shared_ptr<std::string const> ReadRowsParser::MakeBuffer(
+    std::string value) {
+  if (arena_) {
+    return arena_->Allocate(std::move(value));
+  }
+  return std::make_shared<std::string const>(std::move(value));
+}
+
 Cell ReadRowsParser::MovePartialToCell() {
-  // The row, family, and column are explicitly copied because the
-  // ReadRows v2 may reuse them in future chunks. See the CellChunk
-  // message comments in bigtable.proto.
-  Cell cell(cell_.row, cell_.family, cell_.column, cell_.timestamp,
+  // The row key, family, and column may be reused by future chunks of the
+  // same row, see the CellChunk message comments in bigtable.proto. Instead
+  // of copying them into each cell, every cell shares ownership of a single
+  // immutable buffer per value. Only the value is unique to the cell, and it
+  // is moved.
+  Cell cell(row_key_, family_, column_, cell_.timestamp,
             std::move(cell_.value), std::move(cell_.labels));
   cell_.value.clear();
   return cell;
@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSPARSER_H
 
 #include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/cell_visitor.h"
+#include "google/cloud/bigtable/internal/row_buffer_arena.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
@@ -35,9 +37,8 @@ namespace internal {
  *
  * @code
  * while (!stream.End()) {
- *   chunk = stream.NextChunk();
- *   parser.HandleChunk(chunk);
- *   if (parser.HasNext()) {
+ *   parser.HandleResponse(stream.NextResponse());
+ *   while (parser.HasNext()) {
  *     row = parser.Next();  // you now own `row`
  *   }
  * }
@@ -52,16 +53,58 @@ namespace internal {
 class ReadRowsParser {
  public:
   ReadRowsParser()
-      : row_key_(""),
+      : visitor_(nullptr),
         cells_(),
+        cells_in_row_(0),
         cell_first_chunk_(true),
         cell_(),
-        last_seen_row_key_(""),
-        row_ready_(false),
-        end_of_stream_(false) {}
+        family_(std::make_shared<std::string const>()),
+        column_(std::make_shared<ColumnQualifierType const>()),
+        last_seen_row_key_(std::make_shared<RowKeyType const>()),
+        next_ready_(0),
+        end_of_stream_(false),
+        relaxed_validation_(false) {}
 
   virtual ~ReadRowsParser() = default;
 
+  /**
+   * Draw the shared row key, family, and column buffers from @p arena.
+   *
+   * The arena batches the buffer allocations of many rows, see
+   * `RowBufferArena`. The cells returned by this parser then pin the
+   * arena generation holding their buffers.
+   */
+  void SetArena(std::shared_ptr<RowBufferArena> arena) {
+    arena_ = std::move(arena);
+  }
+
+  /**
+   * Deliver cells to @p visitor instead of accumulating rows.
+   *
+   * With a visitor set the parser constructs no `Cell` or `Row` objects:
+   * each completed cell is passed to `CellVisitor::OnCell()` as borrowed
+   * references into the parse buffers, `HasNext()` is never true and
+   * `Next()` must not be called. The visitor must outlive the parser.
+   */
+  void SetVisitor(CellVisitor* visitor) { visitor_ = visitor; }
+
+  /**
+   * Skip the per-chunk consistency checks for trusted servers.
+   *
+   * The ordering, continuation, and row-key consistency checks run on
+   * every chunk and are a measurable fraction of scan CPU, yet they only
+   * trigger on invalid streams. With relaxed validation the parser keeps
+   * just the state tracking needed for correct reassembly. The full
+   * checks always remain enabled in debug builds (`NDEBUG` not defined).
+   */
+  void SetRelaxedValidation(bool relaxed) { relaxed_validation_ = relaxed; }
+
+  /// The key of the last committed row, empty if no row committed yet.
+  RowKeyType const& last_seen_row_key() const { return *last_seen_row_key_; }
+
+  /// Number of completed cells delivered for the current, uncommitted row.
+  std::size_t cells_delivered_in_row() const { return cells_in_row_; }
+
   /**
    * Pass an input chunk proto to the parser.
    *
@@ -74,6 +117,21 @@ class ReadRowsParser {
       google::bigtable::v2::ReadRowsResponse_CellChunk chunk,
       grpc::Status& status);
 
+  /**
+   * Pass all the chunks of a response proto to the parser.
+   *
+   * Responses routinely carry hundreds of chunks, and feeding them
+   * through `HandleChunk()` pays a virtual dispatch and the entry checks
+   * per chunk. This entry point hoists those out of the loop and
+   * processes the chunks with direct calls. Unlike `HandleChunk()` it
+   * may be called while rows are ready: completed rows queue up inside
+   * the parser and are drained with `HasNext()` and `Next()`.
+   *
+   * @throws std::runtime_error if validation failed.
+   */
+  virtual void HandleResponse(google::bigtable::v2::ReadRowsResponse&& response,
+                              grpc::Status& status);
+
   /**
    * Signal that the input stream reached the end.
    *
@@ -102,42 +160,81 @@ class ReadRowsParser {
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
     RowKeyType row;
-    std::string family;
-    ColumnQualifierType column;
     int64_t timestamp;
     CellValueType value;
     std::vector<std::string> labels;
   };
 
+  /**
+   * Process one chunk, without the per-call entry checks.
+   *
+   * The shared body of `HandleChunk()` and the `HandleResponse()` loop;
+   * not virtual, so the latter pays no dispatch per chunk.
+   */
+  void HandleChunkImpl(google::bigtable::v2::ReadRowsResponse_CellChunk chunk,
+                       grpc::Status& status);
+
   /**
    * Moves partial results into a Cell class.
    *
    * Also helps handle string ownership correctly. The value is moved
-   * when converting to a result cell, but the key, family and column
-   * are copied, because they are possibly reused by following cells.
+   * when converting to a result cell. The row key, family, and column
+   * buffers are shared with the other cells of the row instead of
+   * copied, see `row_key_`, `family_`, and `column_`.
    */
   Cell MovePartialToCell();
 
-  /// Row key for the current row.
-  RowKeyType row_key_;
+  /// Create a shared buffer, from the arena when one is configured.
+  std::shared_ptr<std::string const> MakeBuffer(std::string value);
 
-  /// Parsed cells of a yet unfinished row.
+  /// Whether the consistency checks run, see SetRelaxedValidation().
+  bool StrictValidation() const {
+#ifdef NDEBUG
+    return !relaxed_validation_;
+#else
+    return true;
+#endif
+  }
+
+  /// Batches buffer allocations when set, see SetArena().
+  std::shared_ptr<RowBufferArena> arena_;
+
+  /// Receives borrowed cell data when set, see SetVisitor().
+  CellVisitor* visitor_;
+
+  /// Row key for the current row, shared by the row and all its cells.
+  std::shared_ptr<RowKeyType const> row_key_;
+
+  /// Parsed cells of a yet unfinished row, always empty in visitor mode.
   std::vector<Cell> cells_;
 
+  /// Number of completed cells in the current row.
+  std::size_t cells_in_row_;
+
   /// Is the next incoming chunk the first in a cell?
   bool cell_first_chunk_;
 
   /// Stores partial fields.
   ParseCell cell_;
 
-  /// Set when a row is ready.
-  RowKeyType last_seen_row_key_;
+  /// The current family and column, shared by the cells that reuse them.
+  std::shared_ptr<std::string const> family_;
+  std::shared_ptr<ColumnQualifierType const> column_;
+
+  /// The key of the last committed row, rows must arrive in order.
+  std::shared_ptr<RowKeyType const> last_seen_row_key_;
 
-  /// True iff cells_ make up a complete row.
-  bool row_ready_;
+  /// Committed rows not yet taken by Next().
+  std::vector<Row> ready_rows_;
+
+  /// Index of the first row in `ready_rows_` not taken yet.
+  std::size_t next_ready_;
 
   /// Have we received the end of stream call?
   bool end_of_stream_;
+
+  /// Skip the redundant consistency checks, see SetRelaxedValidation().
+  bool relaxed_validation_;
 };
 
 /// Factory for creating parser instances, defined for testability.
@@ -24,6 +24,7 @@
 #include <sstream>
 #include <vector>
 
+using google::bigtable::v2::ReadRowsResponse;
 using google::bigtable::v2::ReadRowsResponse_CellChunk;
 using google::cloud::bigtable::internal::ReadRowsParser;
 
@@ -61,6 +62,94 @@ TEST(ReadRowsParserTest, HandleChunkAfterEndOfStreamThrows) {
   EXPECT_FALSE(parser.HasNext());
 }
 
+TEST(ReadRowsParserTest, HandleResponseAfterEndOfStreamThrows) {
+  ReadRowsParser parser;
+  ReadRowsResponse response;
+  response.add_chunks()->set_value_size(1);
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+
+  parser.HandleResponse(std::move(response), status);
+  EXPECT_FALSE(status.ok());
+  EXPECT_FALSE(parser.HasNext());
+}
+
+TEST(ReadRowsParserTest, HandleResponseQueuesMultipleRows) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse response;
+  ASSERT_TRUE(TextFormat::ParseFromString(R"(
+    chunks {
+      row_key: "r1"
+      family_name: < value: "F">
+      qualifier: < value: "C">
+      timestamp_micros: 42
+      value: "V1"
+      commit_row: true
+    }
+    chunks {
+      row_key: "r2"
+      timestamp_micros: 84
+      value: "V2"
+      commit_row: true
+    }
+    )",
+                                          &response));
+  grpc::Status status;
+  EXPECT_FALSE(parser.HasNext());
+  // Unlike HandleChunk(), the committed rows need not be taken between
+  // chunks, they queue up in the parser.
+  parser.HandleResponse(std::move(response), status);
+  ASSERT_TRUE(status.ok());
+
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_EQ("r1", row.row_key());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("V1", row.cells().front().value());
+
+  ASSERT_TRUE(parser.HasNext());
+  row = parser.Next(status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_EQ("r2", row.row_key());
+  ASSERT_EQ(1U, row.cells().size());
+  // The family and column are reused from the first row.
+  EXPECT_EQ("F", row.cells().front().family_name());
+  EXPECT_EQ("V2", row.cells().front().value());
+
+  EXPECT_FALSE(parser.HasNext());
+  EXPECT_EQ("r2", parser.last_seen_row_key());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsParserTest, HandleResponseStopsOnInvalidChunk) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse response;
+  // The second chunk commits a row without ever setting a row key.
+  ASSERT_TRUE(TextFormat::ParseFromString(R"(
+    chunks {
+      row_key: "r1"
+      family_name: < value: "F">
+      qualifier: < value: "C">
+      timestamp_micros: 42
+      value: "V1"
+      commit_row: true
+    }
+    chunks {
+      commit_row: true
+    }
+    )",
+                                          &response));
+  grpc::Status status;
+  parser.HandleResponse(std::move(response), status);
+  EXPECT_FALSE(status.ok());
+  // The row committed before the invalid chunk remains available.
+  EXPECT_TRUE(parser.HasNext());
+}
+
 TEST(ReadRowsParserTest, SingleChunkSucceeds) {
   using google::protobuf::TextFormat;
   ReadRowsParser parser;
@@ -96,6 +185,152 @@ TEST(ReadRowsParserTest, SingleChunkSucceeds) {
   EXPECT_TRUE(status.ok());
 }
 
+TEST(ReadRowsParserTest, SingleChunkValueIsStolenNotCopied) {
+  ReadRowsParser parser;
+  ReadRowsResponse_CellChunk chunk;
+  // Use values longer than any small-string optimization buffer, so the
+  // `data()` pointers below identify heap buffers.
+  std::string const row_key(128, 'k');
+  std::string const value(1024, 'v');
+  chunk.set_row_key(row_key);
+  chunk.mutable_family_name()->set_value("F");
+  chunk.mutable_qualifier()->set_value("C");
+  chunk.set_timestamp_micros(42);
+  chunk.set_value(value);
+  chunk.set_commit_row(true);
+  auto const* value_buffer = chunk.value().data();
+
+  grpc::Status status;
+  parser.HandleChunk(std::move(chunk), status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row.cells().size());
+  auto const& cell = row.cells().front();
+  EXPECT_EQ(row_key, cell.row_key());
+  EXPECT_EQ(value, cell.value());
+  // The parser moves the value buffer from the proto into the cell, copying
+  // it would break the zero-copy contract for large cells.
+  EXPECT_EQ(static_cast<void const*>(value_buffer),
+            static_cast<void const*>(cell.value().data()));
+}
+
+TEST(ReadRowsParserTest, SplitCellValuesAreReassembled) {
+  ReadRowsParser parser;
+  std::string const part1(512, 'a');
+  std::string const part2(512, 'b');
+  grpc::Status status;
+
+  ReadRowsResponse_CellChunk chunk;
+  chunk.set_row_key("RK");
+  chunk.mutable_family_name()->set_value("F");
+  chunk.mutable_qualifier()->set_value("C");
+  chunk.set_timestamp_micros(42);
+  chunk.set_value(part1);
+  chunk.set_value_size(1024);
+  parser.HandleChunk(std::move(chunk), status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_FALSE(parser.HasNext());
+
+  ReadRowsResponse_CellChunk continuation;
+  continuation.set_value(part2);
+  continuation.set_commit_row(true);
+  parser.HandleChunk(std::move(continuation), status);
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ(part1 + part2, row.cells().front().value());
+}
+
+TEST(ReadRowsParserTest, CellsShareRowKeyFamilyAndColumnBuffers) {
+  ReadRowsParser parser;
+  // Longer than any small-string optimization buffer, so the `data()`
+  // pointers below identify heap buffers.
+  std::string const row_key(128, 'k');
+  grpc::Status status;
+
+  ReadRowsResponse_CellChunk chunk;
+  chunk.set_row_key(row_key);
+  chunk.mutable_family_name()->set_value("F");
+  chunk.mutable_qualifier()->set_value("C");
+  chunk.set_timestamp_micros(42);
+  chunk.set_value("V1");
+  parser.HandleChunk(std::move(chunk), status);
+  ASSERT_TRUE(status.ok());
+
+  // The second cell omits the row key, family, and qualifier, reusing the
+  // values from the previous cell.
+  ReadRowsResponse_CellChunk continuation;
+  continuation.set_timestamp_micros(84);
+  continuation.set_value("V2");
+  continuation.set_commit_row(true);
+  parser.HandleChunk(std::move(continuation), status);
+  ASSERT_TRUE(status.ok());
+
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(2U, row.cells().size());
+  auto const& c0 = row.cells()[0];
+  auto const& c1 = row.cells()[1];
+  EXPECT_EQ(row_key, c0.row_key());
+  // All cells of a row (and the row itself) share one immutable key buffer
+  // instead of each holding a copy. Likewise for repeated families and
+  // columns.
+  EXPECT_EQ(static_cast<void const*>(row.row_key().data()),
+            static_cast<void const*>(c0.row_key().data()));
+  EXPECT_EQ(static_cast<void const*>(c0.row_key().data()),
+            static_cast<void const*>(c1.row_key().data()));
+  EXPECT_EQ(&c0.family_name(), &c1.family_name());
+  EXPECT_EQ(&c0.column_qualifier(), &c1.column_qualifier());
+}
+
+TEST(ReadRowsParserTest, ArenaBackedBuffersParseCorrectly) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  parser.SetArena(
+      std::make_shared<google::cloud::bigtable::internal::RowBufferArena>());
+  grpc::Status status;
+
+  std::vector<google::cloud::bigtable::Row> rows;
+  for (auto const* chunk_string : {R"(
+        row_key: "r1"
+        family_name: < value: "F">
+        qualifier: < value: "C">
+        timestamp_micros: 42
+        value: "V1"
+        commit_row: true
+        )",
+                                   R"(
+        row_key: "r2"
+        timestamp_micros: 84
+        value: "V2"
+        commit_row: true
+        )"}) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(chunk_string, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_TRUE(status.ok());
+    if (parser.HasNext()) {
+      rows.emplace_back(parser.Next(status));
+      ASSERT_TRUE(status.ok());
+    }
+  }
+  ASSERT_EQ(2U, rows.size());
+  EXPECT_EQ("r1", rows[0].row_key());
+  EXPECT_EQ("r2", rows[1].row_key());
+  ASSERT_EQ(1U, rows[1].cells().size());
+  auto const& cell = rows[1].cells().front();
+  // The family and column are reused from the first row, both rows draw
+  // their buffers from the same arena generation.
+  EXPECT_EQ("F", cell.family_name());
+  EXPECT_EQ("C", cell.column_qualifier());
+  EXPECT_EQ("V2", cell.value());
+}
+
 TEST(ReadRowsParserTest, NextAfterEndOfStreamSucceeds) {
   using google::protobuf::TextFormat;
   ReadRowsParser parser;
@@ -223,3 +458,155 @@ class AcceptanceTest : public ::testing::Test {
 
 // Auto-generated acceptance tests
 #include "google/cloud/bigtable/internal/readrowsparser_acceptance_tests.inc"
+
+namespace {
+/// Records every visitor callback as a string, for easy comparison.
+class RecordingVisitor : public google::cloud::bigtable::CellVisitor {
+ public:
+  void OnCell(google::cloud::bigtable::RowKeyType const& row_key,
+              std::string const& family_name,
+              google::cloud::bigtable::ColumnQualifierType const&
+                  column_qualifier,
+              std::int64_t timestamp_micros,
+              google::cloud::bigtable::CellValueType const& value,
+              std::vector<std::string> const&) override {
+    std::ostringstream os;
+    os << "cell " << row_key << "/" << family_name << ":" << column_qualifier
+       << "@" << timestamp_micros << "=" << value;
+    events.push_back(os.str());
+  }
+  void OnRowCommitted(
+      google::cloud::bigtable::RowKeyType const& row_key) override {
+    events.push_back("commit " + std::string(row_key));
+  }
+  void OnRowReset() override { events.push_back("reset"); }
+
+  std::vector<std::string> events;
+};
+}  // namespace
+
+TEST(ReadRowsParserTest, VisitorModeDeliversBorrowedCells) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  RecordingVisitor visitor;
+  parser.SetVisitor(&visitor);
+  grpc::Status status;
+
+  std::vector<std::string> chunks = {
+      R"(
+        row_key: "r1"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 42
+        value: "v1"
+        )",
+      R"(
+        qualifier: < value: "c2">
+        timestamp_micros: 43
+        value: "v2"
+        commit_row: true
+        )",
+      R"(
+        row_key: "r2"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 44
+        value: "v3"
+        reset_row: true
+        )",
+      R"(
+        row_key: "r2"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 44
+        value: "v4"
+        commit_row: true
+        )",
+  };
+  for (std::string const& text : chunks) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_STATUS_OK(status);
+    // No rows are accumulated in visitor mode.
+    EXPECT_FALSE(parser.HasNext());
+  }
+  parser.HandleEndOfStream(status);
+  ASSERT_STATUS_OK(status);
+
+  std::vector<std::string> expected = {
+      "cell r1/fam:c1@42=v1", "cell r1/fam:c2@43=v2", "commit r1",
+      "cell r2/fam:c1@44=v3", "reset",                "cell r2/fam:c1@44=v4",
+      "commit r2",
+  };
+  EXPECT_EQ(expected, visitor.events);
+  EXPECT_EQ("r2", parser.last_seen_row_key());
+}
+
+TEST(ReadRowsParserTest, VisitorModeEndOfStreamWithUnfinishedRowFails) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  RecordingVisitor visitor;
+  parser.SetVisitor(&visitor);
+  grpc::Status status;
+
+  ReadRowsResponse_CellChunk chunk;
+  ASSERT_TRUE(TextFormat::ParseFromString(R"(
+    row_key: "r1"
+    family_name: < value: "fam">
+    qualifier: < value: "c1">
+    timestamp_micros: 42
+    value: "v1"
+    )",
+                                          &chunk));
+  parser.HandleChunk(std::move(chunk), status);
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(1U, parser.cells_delivered_in_row());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_FALSE(status.ok());
+}
+
+TEST(ReadRowsParserTest, RelaxedValidationParsesValidStreams) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  parser.SetRelaxedValidation(true);
+  grpc::Status status;
+
+  std::vector<std::string> chunk_texts = {
+      R"(
+        row_key: "r1"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 42
+        value: "v1"
+        commit_row: true
+        )",
+      R"(
+        row_key: "r2"
+        family_name: < value: "fam">
+        qualifier: < value: "c1">
+        timestamp_micros: 43
+        value: "v2"
+        commit_row: true
+        )",
+  };
+  std::vector<google::cloud::bigtable::Row> rows;
+  for (std::string const& text : chunk_texts) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_STATUS_OK(status);
+    ASSERT_TRUE(parser.HasNext());
+    rows.emplace_back(parser.Next(status));
+    ASSERT_STATUS_OK(status);
+  }
+  parser.HandleEndOfStream(status);
+  ASSERT_STATUS_OK(status);
+
+  ASSERT_EQ(2U, rows.size());
+  EXPECT_EQ("r1", rows[0].row_key());
+  EXPECT_EQ("v1", rows[0].cells()[0].value());
+  EXPECT_EQ("r2", rows[1].row_key());
+  EXPECT_EQ("v2", rows[1].cells()[0].value());
+}
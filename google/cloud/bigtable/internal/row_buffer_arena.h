@@ -0,0 +1,77 @@
+// Copyright 2019 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_BUFFER_ARENA_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_BUFFER_ARENA_H
+
+#include "google/cloud/bigtable/version.h"
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Allocate shared immutable string buffers in generations.
+ *
+ * `ReadRowsParser` shares the row key, family, and column buffers between
+ * the cells of a row, but each buffer created with `std::make_shared`
+ * still pays for its own control block. This class packs the buffers of
+ * many rows into a generation that shares a single control block, cutting
+ * the allocations per row during large scans.
+ *
+ * The trade-off is retention: a generation is kept alive while any cell
+ * references any buffer in it. Generations are rotated after
+ * `kGenerationBytes` of buffer data, so the memory pinned by a long-lived
+ * cell is bounded.
+ */
+class RowBufferArena {
+ public:
+  /**
+   * Move @p value into the arena.
+   *
+   * The returned buffer shares ownership of the current generation; it
+   * remains valid for as long as the caller holds it, even after the
+   * arena rotates to a new generation or is destroyed.
+   */
+  std::shared_ptr<std::string const> Allocate(std::string value) {
+    if (!generation_ || generation_bytes_ >= kGenerationBytes) {
+      generation_ = std::make_shared<std::deque<std::string>>();
+      generation_bytes_ = 0;
+    }
+    generation_->emplace_back(std::move(value));
+    generation_bytes_ += generation_->back().size();
+    return std::shared_ptr<std::string const>(generation_,
+                                              &generation_->back());
+  }
+
+ private:
+  /// Rotate generations after this many bytes of buffer data.
+  static std::size_t constexpr kGenerationBytes = 64 * 1024;
+
+  /// A `deque` never relocates its elements, the aliased pointers
+  /// returned by `Allocate()` stay valid as the generation grows.
+  std::shared_ptr<std::deque<std::string>> generation_;
+  std::size_t generation_bytes_ = 0;
+};
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_BUFFER_ARENA_H
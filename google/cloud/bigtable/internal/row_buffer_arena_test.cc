@@ -0,0 +1,61 @@
+// Copyright 2019 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_buffer_arena.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using google::cloud::bigtable::internal::RowBufferArena;
+
+TEST(RowBufferArenaTest, AllocateReturnsValue) {
+  RowBufferArena arena;
+  auto buffer = arena.Allocate("stored-in-the-arena");
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ("stored-in-the-arena", *buffer);
+}
+
+TEST(RowBufferArenaTest, BuffersShareAGeneration) {
+  RowBufferArena arena;
+  auto a = arena.Allocate("a");
+  auto b = arena.Allocate("b");
+  // Buffers from the same generation share one control block: the arena
+  // holds one reference and each returned buffer holds one.
+  EXPECT_FALSE(a.owner_before(b));
+  EXPECT_FALSE(b.owner_before(a));
+  EXPECT_EQ(3, a.use_count());
+}
+
+TEST(RowBufferArenaTest, BuffersSurviveGenerationRotation) {
+  RowBufferArena arena;
+  // More than enough data to rotate generations several times.
+  std::vector<std::shared_ptr<std::string const>> buffers;
+  for (int i = 0; i != 64; ++i) {
+    buffers.push_back(arena.Allocate(std::string(8 * 1024, 'a' + (i % 26))));
+  }
+  for (int i = 0; i != 64; ++i) {
+    EXPECT_EQ(std::string(8 * 1024, 'a' + (i % 26)), *buffers[i]);
+  }
+  // The first and last buffer live in different generations.
+  EXPECT_TRUE(buffers.front().owner_before(buffers.back()) ||
+              buffers.back().owner_before(buffers.front()));
+}
+
+TEST(RowBufferArenaTest, BuffersSurviveArenaDestruction) {
+  std::shared_ptr<std::string const> buffer;
+  {
+    RowBufferArena arena;
+    buffer = arena.Allocate("outlives-the-arena");
+  }
+  EXPECT_EQ("outlives-the-arena", *buffer);
+}
@@ -0,0 +1,129 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/rpc_metrics.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+char const* MethodName(RpcMetrics::Method method) {
+  switch (method) {
+    case RpcMetrics::Method::kApply:
+      return "Apply";
+    case RpcMetrics::Method::kBulkApply:
+      return "BulkApply";
+    case RpcMetrics::Method::kReadRow:
+      return "ReadRow";
+    case RpcMetrics::Method::kReadRows:
+      return "ReadRows";
+    case RpcMetrics::Method::kSampleRowKeys:
+      return "SampleRowKeys";
+  }
+  return "Unknown";
+}
+
+int BucketFor(std::chrono::microseconds latency) {
+  auto us = latency.count();
+  int bucket = 0;
+  while (us > 1 && bucket < RpcMetrics::kBucketCount - 1) {
+    us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+}  // namespace
+
+RpcMetrics& RpcMetrics::Instance() {
+  static RpcMetrics instance;
+  return instance;
+}
+
+RpcMetrics::RpcMetrics() {
+  // `std::atomic<>` members are not zero-initialized before C++20.
+  for (auto& method : methods_) {
+    method.attempts.store(0, std::memory_order_relaxed);
+    method.failures.store(0, std::memory_order_relaxed);
+    method.retries.store(0, std::memory_order_relaxed);
+    for (auto& bucket : method.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void RpcMetrics::RecordAttempt(Method method, std::chrono::microseconds latency,
+                               bool ok) {
+  auto& per_method = methods_[static_cast<int>(method)];
+  per_method.attempts.fetch_add(1, std::memory_order_relaxed);
+  if (!ok) {
+    per_method.failures.fetch_add(1, std::memory_order_relaxed);
+  }
+  per_method.buckets[BucketFor(latency)].fetch_add(1,
+                                                   std::memory_order_relaxed);
+}
+
+void RpcMetrics::RecordRetry(Method method) {
+  methods_[static_cast<int>(method)].retries.fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+std::vector<RpcMetrics::MethodMetrics> RpcMetrics::Snapshot() const {
+  std::vector<MethodMetrics> result;
+  for (int m = 0; m != kMethodCount; ++m) {
+    auto const& per_method = methods_[m];
+    MethodMetrics metrics;
+    metrics.method = MethodName(static_cast<Method>(m));
+    metrics.attempts = per_method.attempts.load(std::memory_order_relaxed);
+    metrics.failures = per_method.failures.load(std::memory_order_relaxed);
+    metrics.retries = per_method.retries.load(std::memory_order_relaxed);
+    metrics.latency_histogram.reserve(kBucketCount);
+    for (auto const& bucket : per_method.buckets) {
+      metrics.latency_histogram.push_back(
+          bucket.load(std::memory_order_relaxed));
+    }
+    result.push_back(std::move(metrics));
+  }
+  return result;
+}
+
+std::chrono::microseconds RpcMetrics::MethodMetrics::LatencyPercentile(
+    double percentile) const {
+  std::int64_t total = 0;
+  for (auto count : latency_histogram) {
+    total += count;
+  }
+  if (total == 0) {
+    return std::chrono::microseconds(0);
+  }
+  // Use the histogram total rather than `attempts`: the two can differ
+  // by the updates in flight while the snapshot was taken.
+  auto const target = static_cast<std::int64_t>(percentile * total);
+  std::int64_t seen = 0;
+  for (std::size_t i = 0; i != latency_histogram.size(); ++i) {
+    seen += latency_histogram[i];
+    if (seen > target || seen == total) {
+      return std::chrono::microseconds(std::int64_t(1) << (i + 1));
+    }
+  }
+  return std::chrono::microseconds(std::int64_t(1)
+                                   << latency_histogram.size());
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
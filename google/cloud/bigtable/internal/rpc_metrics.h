@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_METRICS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Process-wide, client-observed metrics for the Bigtable data path.
+ *
+ * The retry loops record every RPC attempt here, so applications can
+ * alert on the latency their code actually observes — including time
+ * lost to channel-level problems that server-side metrics cannot see.
+ *
+ * Recording is lock-free: each method keeps a few `std::atomic`
+ * counters and a power-of-two latency histogram, so the cost per
+ * attempt is a handful of relaxed atomic increments. Snapshots are
+ * weakly consistent, counters read mid-update may be off by the
+ * updates in flight, which is harmless for monitoring.
+ */
+class RpcMetrics {
+ public:
+  /// The instrumented operations on `Table`.
+  enum class Method {
+    kApply = 0,
+    kBulkApply,
+    kReadRow,
+    kReadRows,
+    kSampleRowKeys,
+  };
+  static int constexpr kMethodCount = 5;
+  /// Bucket `i` counts attempts that took `[2^i, 2^(i+1))` microseconds.
+  static int constexpr kBucketCount = 32;
+
+  /// The process-wide registry.
+  static RpcMetrics& Instance();
+
+  /// Record one RPC attempt and its client-observed latency.
+  void RecordAttempt(Method method, std::chrono::microseconds latency,
+                     bool ok);
+
+  /// Record that an operation retried after a failed attempt.
+  void RecordRetry(Method method);
+
+  /// A point-in-time copy of the metrics for one method.
+  struct MethodMetrics {
+    std::string method;
+    std::int64_t attempts = 0;
+    std::int64_t failures = 0;
+    std::int64_t retries = 0;
+    /// Bucket `i` counts attempts in `[2^i, 2^(i+1))` microseconds.
+    std::vector<std::int64_t> latency_histogram;
+
+    /**
+     * Estimate a latency percentile from the histogram.
+     *
+     * Returns the upper bound of the bucket holding the requested
+     * percentile, so the estimate is conservative and never more than
+     * 2x the true value. @p percentile is in the [0.0, 1.0] range.
+     */
+    std::chrono::microseconds LatencyPercentile(double percentile) const;
+  };
+
+  /// Return a copy of the metrics for every instrumented method.
+  std::vector<MethodMetrics> Snapshot() const;
+
+ private:
+  RpcMetrics();
+
+  struct PerMethod {
+    std::atomic<std::int64_t> attempts;
+    std::atomic<std::int64_t> failures;
+    std::atomic<std::int64_t> retries;
+    std::atomic<std::int64_t> buckets[kBucketCount];
+  };
+  PerMethod methods_[kMethodCount];
+};
+
+/// A scope guard that records one attempt when destroyed.
+class RecordAttemptLatency {
+ public:
+  explicit RecordAttemptLatency(RpcMetrics::Method method)
+      : method_(method), start_(std::chrono::steady_clock::now()) {}
+
+  /// Record the attempt; call exactly once, when its outcome is known.
+  void Record(bool ok) {
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_);
+    RpcMetrics::Instance().RecordAttempt(method_, elapsed, ok);
+  }
+
+ private:
+  RpcMetrics::Method method_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_METRICS_H
@@ -0,0 +1,96 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/rpc_metrics.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+RpcMetrics::MethodMetrics FindMethod(
+    std::vector<RpcMetrics::MethodMetrics> const& snapshot,
+    std::string const& name) {
+  auto it = std::find_if(
+      snapshot.begin(), snapshot.end(),
+      [&name](RpcMetrics::MethodMetrics const& m) { return m.method == name; });
+  EXPECT_NE(it, snapshot.end());
+  return *it;
+}
+
+/// @test Verify that attempts, failures and retries are counted.
+TEST(RpcMetricsTest, RecordAndSnapshot) {
+  auto& metrics = RpcMetrics::Instance();
+  // The registry is process-wide, so compare against a baseline instead
+  // of assuming this test runs first.
+  auto before = FindMethod(metrics.Snapshot(), "Apply");
+
+  metrics.RecordAttempt(RpcMetrics::Method::kApply,
+                        std::chrono::microseconds(100), true);
+  metrics.RecordAttempt(RpcMetrics::Method::kApply,
+                        std::chrono::microseconds(200), false);
+  metrics.RecordRetry(RpcMetrics::Method::kApply);
+
+  auto after = FindMethod(metrics.Snapshot(), "Apply");
+  EXPECT_EQ(2, after.attempts - before.attempts);
+  EXPECT_EQ(1, after.failures - before.failures);
+  EXPECT_EQ(1, after.retries - before.retries);
+}
+
+/// @test Verify that each method is reported separately.
+TEST(RpcMetricsTest, MethodsAreSeparate) {
+  auto& metrics = RpcMetrics::Instance();
+  auto before = FindMethod(metrics.Snapshot(), "BulkApply");
+
+  metrics.RecordAttempt(RpcMetrics::Method::kReadRow,
+                        std::chrono::microseconds(50), true);
+
+  auto after = FindMethod(metrics.Snapshot(), "BulkApply");
+  EXPECT_EQ(before.attempts, after.attempts);
+}
+
+/// @test Verify the percentile estimate against a known distribution.
+TEST(RpcMetricsTest, LatencyPercentile) {
+  RpcMetrics::MethodMetrics metrics;
+  metrics.latency_histogram.assign(RpcMetrics::kBucketCount, 0);
+  // 90 attempts in [2^4, 2^5) us, 10 in [2^10, 2^11) us.
+  metrics.latency_histogram[4] = 90;
+  metrics.latency_histogram[10] = 10;
+  metrics.attempts = 100;
+
+  EXPECT_EQ(std::chrono::microseconds(1 << 5),
+            metrics.LatencyPercentile(0.50));
+  EXPECT_EQ(std::chrono::microseconds(1 << 11),
+            metrics.LatencyPercentile(0.99));
+  EXPECT_EQ(std::chrono::microseconds(1 << 11),
+            metrics.LatencyPercentile(1.0));
+}
+
+/// @test Verify that an empty histogram reports a zero percentile.
+TEST(RpcMetricsTest, LatencyPercentileEmpty) {
+  RpcMetrics::MethodMetrics metrics;
+  metrics.latency_histogram.assign(RpcMetrics::kBucketCount, 0);
+  EXPECT_EQ(std::chrono::microseconds(0), metrics.LatencyPercentile(0.99));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,113 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/timer_wheel.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+void TimerWheel::Timer::Cancel() {
+  Finish(Status(StatusCode::kCancelled, "timer cancelled"));
+}
+
+bool TimerWheel::Timer::Finish(Status status) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (completed_) {
+      return false;
+    }
+    completed_ = true;
+  }
+  promise_.set_value(std::move(status));
+  return true;
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::Create(
+    CompletionQueue cq, std::chrono::milliseconds resolution) {
+  if (resolution <= std::chrono::milliseconds(0)) {
+    resolution = std::chrono::milliseconds(1);
+  }
+  // Cannot use std::make_shared<> because the constructor is private.
+  return std::shared_ptr<TimerWheel>(
+      new TimerWheel(std::move(cq), resolution));
+}
+
+TimerWheel::TimerWheel(CompletionQueue cq, std::chrono::milliseconds resolution)
+    : cq_(std::move(cq)),
+      resolution_(std::chrono::duration_cast<
+                  std::chrono::system_clock::duration>(resolution)) {}
+
+std::shared_ptr<TimerWheel::Timer> TimerWheel::MakeRelativeTimer(
+    std::chrono::nanoseconds duration) {
+  auto timer = std::make_shared<Timer>();
+  auto const now = std::chrono::system_clock::now();
+  auto const slot = SlotFor(now + duration);
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& bucket = slots_[slot];
+  bucket.push_back(timer);
+  bool const arm = bucket.size() == 1;
+  lk.unlock();
+
+  if (arm) {
+    // First timer in this slot, arm the single underlying alarm for it.
+    // The remaining time may be negative if the slot just expired and was
+    // erased by `OnSlotExpired()`, in that case the alarm fires right
+    // away, which is exactly what we want.
+    auto const slot_end =
+        std::chrono::system_clock::time_point(slot * resolution_);
+    auto self = shared_from_this();
+    cq_.MakeRelativeTimer(slot_end - now)
+        .then([self,
+               slot](future<StatusOr<std::chrono::system_clock::time_point>>
+                         result) { self->OnSlotExpired(slot, result.get()); });
+  }
+  return timer;
+}
+
+std::int64_t TimerWheel::SlotFor(
+    std::chrono::system_clock::time_point deadline) const {
+  auto const since_epoch = deadline.time_since_epoch();
+  // Round up, so timers never fire before their requested deadline.
+  return (since_epoch + resolution_ -
+          std::chrono::system_clock::duration(1)) /
+         resolution_;
+}
+
+void TimerWheel::OnSlotExpired(
+    std::int64_t slot, StatusOr<std::chrono::system_clock::time_point> result) {
+  std::vector<std::shared_ptr<Timer>> expired;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = slots_.find(slot);
+    if (it != slots_.end()) {
+      expired.swap(it->second);
+      slots_.erase(it);
+    }
+  }
+  auto status = result ? Status() : result.status();
+  for (auto& timer : expired) {
+    timer->Finish(status);
+  }
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
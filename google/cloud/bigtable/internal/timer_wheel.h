@@ -0,0 +1,111 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_TIMER_WHEEL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_TIMER_WHEEL_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Coalesce many short-lived timers onto few `CompletionQueue` alarms.
+ *
+ * Each `CompletionQueue::MakeRelativeTimer()` call creates a separate gRPC
+ * alarm, and workloads that arm (and mostly cancel) a timer per request
+ * pay for that churn in the completion queue threads. This class rounds
+ * deadlines up to a configurable resolution and keeps one underlying
+ * alarm per occupied time slot, so the alarm count is bounded by the
+ * number of distinct slots rather than the number of timers. Scheduling
+ * appends to the slot's bucket and cancellation just marks the timer, so
+ * both are O(1) outside the (rare) slot-arming path.
+ *
+ * Timers never fire before their requested deadline, but may fire up to
+ * one resolution late; callers that need precise deadlines should use
+ * `CompletionQueue::MakeRelativeTimer()` directly.
+ */
+class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+ public:
+  static std::shared_ptr<TimerWheel> Create(
+      CompletionQueue cq,
+      std::chrono::milliseconds resolution = std::chrono::milliseconds(10));
+
+  /// A single scheduled timer, cheap to cancel.
+  class Timer {
+   public:
+    /// Satisfied with an OK status when the timer fires, with
+    /// `kCancelled` when cancelled, or with the underlying alarm's error
+    /// if the completion queue is shut down.
+    future<Status> get_future() { return promise_.get_future(); }
+
+    /**
+     * Cancel the timer, satisfying its future immediately.
+     *
+     * The slot bucket keeps a reference until the slot expires, but the
+     * entry becomes a no-op. Cancelling an already completed timer has
+     * no effect.
+     */
+    void Cancel();
+
+   private:
+    friend class TimerWheel;
+    /// Atomically claim completion, returns false if already completed.
+    bool Finish(Status status);
+
+    std::mutex mu_;
+    bool completed_ = false;
+    promise<Status> promise_;
+  };
+
+  /// Schedule a timer to fire no earlier than @p duration from now.
+  std::shared_ptr<Timer> MakeRelativeTimer(std::chrono::nanoseconds duration);
+
+ private:
+  TimerWheel(CompletionQueue cq, std::chrono::milliseconds resolution);
+
+  /// The slot containing @p deadline, rounding up.
+  std::int64_t SlotFor(std::chrono::system_clock::time_point deadline) const;
+
+  /// Satisfy every timer in @p slot with the alarm's result.
+  void OnSlotExpired(std::int64_t slot,
+                     StatusOr<std::chrono::system_clock::time_point> result);
+
+  CompletionQueue cq_;
+  std::chrono::system_clock::duration const resolution_;
+
+  std::mutex mu_;
+  /// The timers scheduled in each occupied slot; the slot's underlying
+  /// alarm is armed when its bucket first becomes non-empty.
+  std::map<std::int64_t, std::vector<std::shared_ptr<Timer>>> slots_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_TIMER_WHEEL_H
@@ -0,0 +1,102 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/timer_wheel.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+/// @test Verify timers in the same slot share one underlying alarm.
+TEST(TimerWheelTest, CoalescesTimersInSameSlot) {
+  auto cq_impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  auto wheel = TimerWheel::Create(CompletionQueue(cq_impl), 10_ms);
+
+  auto t1 = wheel->MakeRelativeTimer(2_ms);
+  auto t2 = wheel->MakeRelativeTimer(2_ms);
+  auto t3 = wheel->MakeRelativeTimer(2_ms);
+  // All three deadlines round up to the same slot, only one alarm exists.
+  EXPECT_EQ(1U, cq_impl->size());
+
+  auto f1 = t1->get_future();
+  auto f2 = t2->get_future();
+  auto f3 = t3->get_future();
+  cq_impl->SimulateCompletion(true);
+
+  EXPECT_STATUS_OK(f1.get());
+  EXPECT_STATUS_OK(f2.get());
+  EXPECT_STATUS_OK(f3.get());
+  EXPECT_TRUE(cq_impl->empty());
+}
+
+/// @test Verify distinct slots arm distinct alarms.
+TEST(TimerWheelTest, DistinctSlotsArmDistinctAlarms) {
+  auto cq_impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  auto wheel = TimerWheel::Create(CompletionQueue(cq_impl), 10_ms);
+
+  auto t1 = wheel->MakeRelativeTimer(2_ms);
+  auto t2 = wheel->MakeRelativeTimer(500_ms);
+  EXPECT_EQ(2U, cq_impl->size());
+
+  cq_impl->SimulateCompletion(true);
+  EXPECT_STATUS_OK(t1->get_future().get());
+  EXPECT_STATUS_OK(t2->get_future().get());
+}
+
+/// @test Verify cancellation satisfies the future without the alarm.
+TEST(TimerWheelTest, CancelIsImmediate) {
+  auto cq_impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  auto wheel = TimerWheel::Create(CompletionQueue(cq_impl), 10_ms);
+
+  auto cancelled = wheel->MakeRelativeTimer(2_ms);
+  auto pending = wheel->MakeRelativeTimer(2_ms);
+  EXPECT_EQ(1U, cq_impl->size());
+
+  auto cancelled_future = cancelled->get_future();
+  cancelled->Cancel();
+  ASSERT_EQ(std::future_status::ready, cancelled_future.wait_for(0_ms));
+  EXPECT_EQ(StatusCode::kCancelled, cancelled_future.get().code());
+  // Cancelling again must be harmless.
+  cancelled->Cancel();
+
+  // The shared alarm still fires for the remaining timer.
+  cq_impl->SimulateCompletion(true);
+  EXPECT_STATUS_OK(pending->get_future().get());
+}
+
+/// @test Verify a shutdown alarm propagates its error to the timers.
+TEST(TimerWheelTest, ShutdownPropagates) {
+  auto cq_impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  auto wheel = TimerWheel::Create(CompletionQueue(cq_impl), 10_ms);
+
+  auto timer = wheel->MakeRelativeTimer(2_ms);
+  cq_impl->SimulateCompletion(false);
+  EXPECT_FALSE(timer->get_future().get().ok());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
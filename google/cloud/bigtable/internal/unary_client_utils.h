@@ -162,6 +162,74 @@ struct UnaryClientUtils {
     return response;
   }
 
+  /**
+   * Call a simple unary RPC with retries, cloning the policies lazily.
+   *
+   * `MakeCall()` requires policy clones, which cost two heap allocations
+   * per call, even though the policies only change state when an attempt
+   * fails. This variant reads the policy *prototypes* (their `Setup()`
+   * member functions are `const`) and clones them on the first failure, so
+   * the common all-attempts-succeed path performs no policy allocations.
+   * The response proto is `Clear()`ed between attempts, which keeps its
+   * field storage for the next attempt.
+   *
+   * The remaining per-call objects are not reusable: gRPC requires a fresh
+   * `grpc::ClientContext` for every RPC, and the response is returned by
+   * value so its storage leaves with the caller.
+   *
+   * @tparam MemberFunction the signature of the member function.
+   * @param client the object that holds the gRPC stub.
+   * @param retry_prototype the configured retry policy, cloned on failure.
+   * @param backoff_prototype the configured backoff policy, cloned on
+   *     failure.
+   * @param metadata_update_policy to keep metadata like
+   *     x-goog-request-params.
+   * @param function the pointer to the member function to call.
+   * @param request an initialized request parameter for the RPC.
+   * @param error_message include this message in any exception or error log.
+   * @return the return parameter from the RPC.
+   */
+  template <typename MemberFunction>
+  static typename Signature<MemberFunction>::ResponseType
+  MakeCallFromPrototypes(
+      ClientType& client, bigtable::RPCRetryPolicy const& retry_prototype,
+      bigtable::RPCBackoffPolicy const& backoff_prototype,
+      bigtable::MetadataUpdatePolicy const& metadata_update_policy,
+      MemberFunction function,
+      typename Signature<MemberFunction>::RequestType const& request,
+      char const* error_message, grpc::Status& status, bool retry_on_failure) {
+    typename Signature<MemberFunction>::ResponseType response;
+    std::unique_ptr<bigtable::RPCRetryPolicy> rpc_policy;
+    std::unique_ptr<bigtable::RPCBackoffPolicy> backoff_policy;
+    do {
+      grpc::ClientContext client_context;
+      (rpc_policy ? *rpc_policy : retry_prototype).Setup(client_context);
+      (backoff_policy ? *backoff_policy : backoff_prototype)
+          .Setup(client_context);
+      metadata_update_policy.Setup(client_context);
+      status = (client.*function)(&client_context, request, &response);
+      if (status.ok()) {
+        break;
+      }
+      if (!rpc_policy) {
+        rpc_policy = retry_prototype.clone();
+        backoff_policy = backoff_prototype.clone();
+      }
+      if (!rpc_policy->OnFailure(status)) {
+        std::string full_message = error_message;
+        full_message += "(" + metadata_update_policy.value() + ") ";
+        full_message += status.error_message();
+        status = grpc::Status(status.error_code(), full_message,
+                              status.error_details());
+        break;
+      }
+      auto delay = backoff_policy->OnCompletion(status);
+      std::this_thread::sleep_for(delay);
+      response.Clear();
+    } while (retry_on_failure);
+    return response;
+  }
+
   /**
    * Call a simple unary RPC with no retry.
    *
@@ -187,12 +255,30 @@ struct UnaryClientUtils {
       MemberFunction function,
       typename Signature<MemberFunction>::RequestType const& request,
       char const* error_message, grpc::Status& status) {
+    return MakeNonIdemponentCall(client, *rpc_policy, metadata_update_policy,
+                                 function, request, error_message, status);
+  }
+
+  /**
+   * Call a simple unary RPC with no retry, borrowing the retry policy.
+   *
+   * The policy is only used to `Setup()` the `grpc::ClientContext`, which
+   * is `const`, so single-shot calls can pass the configured prototype
+   * directly instead of cloning it.
+   */
+  template <typename MemberFunction>
+  static typename Signature<MemberFunction>::ResponseType MakeNonIdemponentCall(
+      ClientType& client, bigtable::RPCRetryPolicy const& rpc_policy,
+      bigtable::MetadataUpdatePolicy const& metadata_update_policy,
+      MemberFunction function,
+      typename Signature<MemberFunction>::RequestType const& request,
+      char const* error_message, grpc::Status& status) {
     typename Signature<MemberFunction>::ResponseType response;
 
     grpc::ClientContext client_context;
 
     // Policies can set timeouts so allowing them to update context
-    rpc_policy->Setup(client_context);
+    rpc_policy.Setup(client_context);
     metadata_update_policy.Setup(client_context);
     // Call the pointer to member function.
     status = (client.*function)(&client_context, request, &response);
@@ -36,6 +36,20 @@ MetadataParamTypes const MetadataParamTypes::APP_PROFILE_NAME(
 // NOLINTNEXTLINE(readability-identifier-naming)
 MetadataParamTypes const MetadataParamTypes::INSTANCE_NAME("instance.name");
 
+namespace {
+std::string const& ApiClientHeader() {
+  // The value is the same for every policy, computing it once per process
+  // avoids re-running the compiler-info formatting every time a `Table`
+  // (or a clone of its policy) is constructed.
+  static std::string const kApiClientHeader =
+      "gl-cpp/" + google::cloud::internal::CompilerId() + "-" +
+      google::cloud::internal::CompilerVersion() + "-" +
+      google::cloud::internal::CompilerFeatures() + "-" +
+      google::cloud::internal::LanguageVersion() + " gccl/" + version_string();
+  return kApiClientHeader;
+}
+}  // anonymous namespace
+
 MetadataUpdatePolicy::MetadataUpdatePolicy(
     std::string const& resource_name,
     MetadataParamTypes const& metadata_param_type) {
@@ -43,17 +57,16 @@ MetadataUpdatePolicy::MetadataUpdatePolicy(
   value += "=";
   value += resource_name;
   value_ = std::move(value);
-  std::string api_client_header =
-      "gl-cpp/" + google::cloud::internal::CompilerId() + "-" +
-      google::cloud::internal::CompilerVersion() + "-" +
-      google::cloud::internal::CompilerFeatures() + "-" +
-      google::cloud::internal::LanguageVersion() + " gccl/" + version_string();
-  api_client_header_ = std::move(api_client_header);
+  api_client_header_ = ApiClientHeader();
 }
 
 void MetadataUpdatePolicy::Setup(grpc::ClientContext& context) const {
-  context.AddMetadata(std::string("x-goog-request-params"), value());
-  context.AddMetadata(std::string("x-goog-api-client"), api_client_header());
+  // The metadata keys never change, reusing one std::string per process
+  // avoids allocating them again on every RPC.
+  static std::string const kRequestParamsKey = "x-goog-request-params";
+  static std::string const kApiClientKey = "x-goog-api-client";
+  context.AddMetadata(kRequestParamsKey, value());
+  context.AddMetadata(kApiClientKey, api_client_header());
 }
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -15,7 +15,9 @@
 #include "google/cloud/bigtable/mutation_batcher.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include <algorithm>
 #include <sstream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -31,12 +33,26 @@ auto constexpr kDefaultMaxSizePerBatch =
 auto constexpr kDefaultMaxBatches = 8;
 auto constexpr kDefaultMaxOutstandingSize =
     kDefaultMaxSizePerBatch * kDefaultMaxBatches;
+auto constexpr kDefaultTargetLatencyMs = 100;
+// The granularity of the additive increase, as a fraction of
+// max_size_per_batch. It is also the lower bound for the adaptive batch
+// size, so that batches never shrink to nothing.
+auto constexpr kAdaptiveSizeSteps = 16;
+// Enough queued callbacks to keep the executor threads busy, yet small
+// enough to apply backpressure before the backlog grows out of hand.
+auto constexpr kDefaultCallbackQueueLimit = 1024;
 
 MutationBatcher::Options::Options()
     : max_mutations_per_batch(kBigtableMutationLimit),
       max_size_per_batch(kDefaultMaxSizePerBatch),
       max_batches(kDefaultMaxBatches),
-      max_outstanding_size(kDefaultMaxOutstandingSize) {}
+      max_outstanding_size(kDefaultMaxOutstandingSize),
+      adaptive_batching(false),
+      target_latency(kDefaultTargetLatencyMs),
+      has_max_linger(false),
+      max_linger(0),
+      callback_thread_count(0),
+      callback_queue_limit(kDefaultCallbackQueueLimit) {}
 
 std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     CompletionQueue& cq, SingleRowMutation mut) {
@@ -47,11 +63,11 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   PendingSingleRowMutation pending(std::move(mut),
                                    std::move(completion_promise),
                                    std::move(admission_promise));
-  std::unique_lock<std::mutex> lk(mu_);
 
+  // `IsValid()` only reads the immutable configuration, so rejecting
+  // invalid mutations does not need any lock.
   grpc::Status mutation_status = IsValid(pending);
   if (!mutation_status.ok()) {
-    lk.unlock();
     // Destroy the mutation before satisfying the admission promise so that we
     // can limit the memory usage.
     pending.mut.Clear();
@@ -62,21 +78,149 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     pending.admission_promise.set_value();
     return res;
   }
-  ++num_requests_pending_;
 
-  if (!CanAppendToBatch(pending)) {
-    pending_mutations_.push(std::move(pending));
-    return res;
+  // Stage the mutation in the calling thread's stripe. Each stripe lock is
+  // shared by few threads, so staging stays cheap no matter how many
+  // producers feed this batcher; the contended work of building batches
+  // happens in `DrainAdmissionStripes()`, batched across producers.
+  auto& stripe = StripeForThisThread();
+  {
+    std::lock_guard<std::mutex> stripe_lk(stripe.mu);
+    stripe.staged.push_back(std::move(pending));
+  }
+  DrainAdmissionStripes(cq, stripe);
+  return res;
+}
+
+MutationBatcher::AdmissionStripe& MutationBatcher::StripeForThisThread() {
+  auto const tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  return admission_stripes_[tid % admission_stripes_.size()];
+}
+
+void MutationBatcher::DrainAdmissionStripes(CompletionQueue& cq,
+                                            AdmissionStripe& own_stripe) {
+  for (;;) {
+    std::unique_lock<std::mutex> lk(mu_, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      // Another thread is building batches. It merges every stripe before
+      // releasing `mu_`, so once our stripe is empty our mutation has been
+      // picked up and there is nothing left to do. Waiting for that beats
+      // piling up on the contended lock.
+      {
+        std::lock_guard<std::mutex> stripe_lk(own_stripe.mu);
+        if (own_stripe.staged.empty()) {
+          return;
+        }
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    for (auto& stripe : admission_stripes_) {
+      std::lock_guard<std::mutex> stripe_lk(stripe.mu);
+      while (!stripe.staged.empty()) {
+        ++num_requests_pending_;
+        pending_mutations_.push(std::move(stripe.staged.front()));
+        stripe.staged.pop_front();
+      }
+    }
+    SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+    return;
   }
-  std::vector<AdmissionPromise> admission_promises_to_satisfy;
-  admission_promises_to_satisfy.emplace_back(
-      std::move(pending.admission_promise));
-  Admit(std::move(pending));
-  FlushIfPossible(cq);
-  SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
+}
+
+/**
+ * The in-progress state of one `AsyncApplyFromSource()` call.
+ *
+ * Shared by the pull loop and the completion callbacks of the mutations
+ * already in flight.
+ */
+struct MutationBatcher::SourceDrainState {
+  explicit SourceDrainState(std::unique_ptr<MutationSource> source_arg)
+      : source(std::move(source_arg)), outstanding(0), source_done(false) {}
+
+  std::unique_ptr<MutationSource> source;
+  std::mutex mu;
+  ApplyFromSourceResult result;
+  /// Mutations pulled from the source but not completed yet.
+  std::int64_t outstanding;
+  /// The source has returned an empty optional.
+  bool source_done;
+  promise<ApplyFromSourceResult> done;
+};
+
+future<MutationBatcher::ApplyFromSourceResult>
+MutationBatcher::AsyncApplyFromSource(CompletionQueue& cq,
+                                      std::unique_ptr<MutationSource> source) {
+  auto state = std::make_shared<SourceDrainState>(std::move(source));
+  auto res = state->done.get_future();
+  PullFromSource(cq, std::move(state));
   return res;
 }
 
+void MutationBatcher::PullFromSource(CompletionQueue cq,
+                                     std::shared_ptr<SourceDrainState> state) {
+  // Admission futures are usually satisfied immediately; looping on them
+  // here (instead of chaining `PullFromSource()` through `.then()`)
+  // avoids recursing once per admitted mutation.
+  for (;;) {
+    auto mut = state->source->Next();
+    if (!mut) {
+      bool finished;
+      ApplyFromSourceResult result;
+      {
+        std::lock_guard<std::mutex> lk(state->mu);
+        state->source_done = true;
+        finished = state->outstanding == 0;
+        if (finished) {
+          result = state->result;
+        }
+      }
+      if (finished) {
+        state->done.set_value(std::move(result));
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lk(state->mu);
+      ++state->result.total_mutations;
+      ++state->outstanding;
+    }
+    auto admission_completion = AsyncApply(cq, std::move(*mut));
+    admission_completion.second.then([state](future<Status> completion) {
+      auto status = completion.get();
+      bool finished;
+      ApplyFromSourceResult result;
+      {
+        std::lock_guard<std::mutex> lk(state->mu);
+        if (!status.ok()) {
+          ++state->result.failed_mutations;
+          if (state->result.first_failure.ok()) {
+            state->result.first_failure = std::move(status);
+          }
+        }
+        --state->outstanding;
+        finished = state->source_done && state->outstanding == 0;
+        if (finished) {
+          result = state->result;
+        }
+      }
+      if (finished) {
+        state->done.set_value(std::move(result));
+      }
+    });
+    auto& admission = admission_completion.first;
+    if (admission.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready) {
+      continue;
+    }
+    // The batcher is full, resume pulling when this mutation is admitted.
+    admission.then([this, cq, state](future<void>) mutable {
+      PullFromSource(std::move(cq), std::move(state));
+    });
+    return;
+  }
+}
+
 future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
   std::unique_lock<std::mutex> lk(mu_);
   if (num_requests_pending_ == 0) {
@@ -126,22 +270,50 @@ grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
   return grpc::Status();
 }
 
+std::size_t MutationBatcher::ShardOf(
+    PendingSingleRowMutation const& mut) const {
+  auto const& boundaries = options_.shard_boundaries;
+  if (boundaries.empty()) {
+    return 0;
+  }
+  // The boundaries are inclusive upper bounds (`Table::SampleRows()` returns
+  // the last key of each tablet), hence `lower_bound`. Row keys greater than
+  // the last boundary fall into the final shard.
+  auto const it = std::lower_bound(boundaries.begin(), boundaries.end(),
+                                   mut.mut.row_key());
+  return static_cast<std::size_t>(it - boundaries.begin());
+}
+
 bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
+  auto const& cur_batch = batches_[ShardOf(mut)];
+  // An empty batch accepts any mutation that passed `IsValid()`, even if
+  // the adaptive batch size shrank below the size of this mutation;
+  // otherwise a large (but valid) mutation could be stuck forever.
   return outstanding_size_ + mut.request_size <=
              options_.max_outstanding_size &&
-         cur_batch_->requests_size + mut.request_size <=
-             options_.max_size_per_batch &&
-         cur_batch_->num_mutations + mut.num_mutations <=
-             options_.max_mutations_per_batch;
+         (cur_batch->num_mutations == 0 ||
+          (cur_batch->requests_size + mut.request_size <=
+               adaptive_size_per_batch_ &&
+           cur_batch->num_mutations + mut.num_mutations <=
+               options_.max_mutations_per_batch));
 }
 
-bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
-  if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+bool MutationBatcher::FlushIfPossible(CompletionQueue cq, std::size_t shard,
+                                      bool flush_partial) {
+  auto& cur_batch = batches_[shard];
+  if (options_.has_max_linger && !flush_partial &&
+      !cur_batch->linger_expired) {
+    // With a linger configured, partial batches wait for more mutations;
+    // the linger timer bounds the wait.
+    return false;
+  }
+  if (cur_batch->num_mutations > 0 &&
+      num_outstanding_batches_ < adaptive_max_batches_) {
     ++num_outstanding_batches_;
+    cur_batch->sent_time = std::chrono::steady_clock::now();
 
     auto batch = std::make_shared<Batch>();
-    cur_batch_.swap(batch);
+    cur_batch.swap(batch);
     table_.AsyncBulkApply(std::move(batch->requests), cq)
         .then([this, cq,
                batch](future<std::vector<FailedMutation>> failed) mutable {
@@ -155,63 +327,131 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
 void MutationBatcher::OnBulkApplyDone(
     CompletionQueue cq, MutationBatcher::Batch batch,
     std::vector<FailedMutation> const& failed) {
-  // First process all the failures, marking the mutations as done after
-  // processing them.
-  for (auto const& f : failed) {
-    int const idx = f.original_index();
-    if (idx < 0 ||
-        static_cast<std::size_t>(idx) >= batch.mutation_data.size()) {
-      // This is a bug on the server or the client, either terminate (when
-      // -fno-exceptions is set) or throw an exception.
-      std::ostringstream os;
-      os << "Index " << idx << " is out of range [0,"
-         << batch.mutation_data.size() << ")";
-      google::cloud::internal::ThrowRuntimeError(std::move(os).str());
-    }
-    MutationData& data = batch.mutation_data[idx];
-    data.completion_promise.set_value(f.status());
-    data.done = true;
-  }
-  // Any remaining mutations are treated as successful.
-  for (auto& data : batch.mutation_data) {
-    if (!data.done) {
-      data.completion_promise.set_value(Status());
+  auto const num_mutations = batch.mutation_data.size();
+  // Satisfying the completion promises runs the user's callbacks;
+  // `RunCallbacks()` hands them off to the callback executor if one is
+  // configured, keeping this (typically `CompletionQueue`) thread on I/O.
+  auto mutation_data = std::make_shared<std::vector<MutationData>>(
+      std::move(batch.mutation_data));
+  auto failures = std::make_shared<std::vector<FailedMutation>>(failed);
+  RunCallbacks([mutation_data, failures] {
+    // First process all the failures, marking the mutations as done after
+    // processing them.
+    for (auto const& f : *failures) {
+      int const idx = f.original_index();
+      if (idx < 0 ||
+          static_cast<std::size_t>(idx) >= mutation_data->size()) {
+        // This is a bug on the server or the client, either terminate (when
+        // -fno-exceptions is set) or throw an exception.
+        std::ostringstream os;
+        os << "Index " << idx << " is out of range [0,"
+           << mutation_data->size() << ")";
+        google::cloud::internal::ThrowRuntimeError(std::move(os).str());
+      }
+      MutationData& data = (*mutation_data)[idx];
+      data.completion_promise.set_value(f.status());
       data.done = true;
     }
-  }
-  auto const num_mutations = batch.mutation_data.size();
-  batch.mutation_data.clear();
+    // Any remaining mutations are treated as successful.
+    for (auto& data : *mutation_data) {
+      if (!data.done) {
+        data.completion_promise.set_value(Status());
+        data.done = true;
+      }
+    }
+  });
 
   std::unique_lock<std::mutex> lk(mu_);
   outstanding_size_ -= batch.requests_size;
   num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
+  UpdateAdaptiveLimits(std::chrono::steady_clock::now() - batch.sent_time);
   SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
 }
 
+void MutationBatcher::UpdateAdaptiveLimits(
+    std::chrono::steady_clock::duration latency) {
+  if (!options_.adaptive_batching) {
+    return;
+  }
+  // Classic AIMD: shrink quickly while the server is slower than the
+  // target, grow slowly while it keeps up. The configured limits are
+  // upper bounds, so adaptive mode never sends more than the static
+  // configuration would.
+  std::size_t const size_step = (std::max<std::size_t>)(
+      1, options_.max_size_per_batch / kAdaptiveSizeSteps);
+  if (latency >= options_.target_latency) {
+    adaptive_size_per_batch_ =
+        (std::max)(size_step, adaptive_size_per_batch_ / 2);
+    adaptive_max_batches_ =
+        (std::max<std::size_t>)(1, adaptive_max_batches_ / 2);
+  } else {
+    adaptive_size_per_batch_ = (std::min)(
+        options_.max_size_per_batch, adaptive_size_per_batch_ + size_step);
+    adaptive_max_batches_ =
+        (std::min)(options_.max_batches, adaptive_max_batches_ + 1);
+  }
+}
+
 std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
     CompletionQueue& cq) {
   // Defer satisfying promises until we release the lock.
   std::vector<AdmissionPromise> admission_promises;
 
+  bool flushed;
   do {
     while (!pending_mutations_.empty() &&
            HasSpaceFor(pending_mutations_.front())) {
       auto& mut = pending_mutations_.front();
       admission_promises.emplace_back(std::move(mut.admission_promise));
-      Admit(std::move(mut));
+      Admit(cq, std::move(mut));
       pending_mutations_.pop();
     }
-  } while (FlushIfPossible(cq));
+    // A partial batch may be flushed while mutations are waiting for the
+    // space it occupies.
+    flushed = false;
+    for (std::size_t shard = 0; shard != batches_.size(); ++shard) {
+      flushed =
+          FlushIfPossible(cq, shard, !pending_mutations_.empty()) || flushed;
+    }
+  } while (flushed);
   return admission_promises;
 }
 
-void MutationBatcher::Admit(PendingSingleRowMutation mut) {
+void MutationBatcher::OnLingerExpired(CompletionQueue cq, std::size_t shard,
+                                      std::shared_ptr<Batch> batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (batches_[shard] != batch) {
+    // The batch was flushed before its linger expired, nothing to do.
+    return;
+  }
+  // Remember the expiration; if all the in-flight slots are taken right
+  // now, the batch is flushed as soon as one frees up.
+  batch->linger_expired = true;
+  FlushIfPossible(cq, shard, true);
+  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+}
+
+void MutationBatcher::Admit(CompletionQueue& cq, PendingSingleRowMutation mut) {
+  auto const shard = ShardOf(mut);
+  auto& cur_batch = batches_[shard];
+  if (options_.has_max_linger && cur_batch->num_mutations == 0) {
+    // Bound how long the first mutation of this batch can wait for more
+    // mutations to accumulate. The timer is a noop if the batch is
+    // flushed before it fires.
+    auto batch = cur_batch;
+    cq.MakeRelativeTimer(options_.max_linger)
+        .then([this, cq, shard, batch](
+                  future<StatusOr<std::chrono::system_clock::time_point>>)
+                  mutable {
+          OnLingerExpired(std::move(cq), shard, std::move(batch));
+        });
+  }
   outstanding_size_ += mut.request_size;
-  cur_batch_->requests_size += mut.request_size;
-  cur_batch_->num_mutations += mut.num_mutations;
-  cur_batch_->requests.emplace_back(std::move(mut.mut));
-  cur_batch_->mutation_data.emplace_back(MutationData(std::move(mut)));
+  cur_batch->requests_size += mut.request_size;
+  cur_batch->num_mutations += mut.num_mutations;
+  cur_batch->requests.emplace_back(std::move(mut.mut));
+  cur_batch->mutation_data.emplace_back(MutationData(std::move(mut)));
 }
 
 void MutationBatcher::SatisfyPromises(
@@ -227,15 +467,32 @@ void MutationBatcher::SatisfyPromises(
     no_more_pending_promises_.swap(no_more_pending_promises);
   }
   lk.unlock();
-
-  // Inform the user that we've admitted these mutations and there might be some
-  // space in the buffer finally.
-  for (auto& promise : admission_promises) {
-    promise.set_value();
+  if (admission_promises.empty() && no_more_pending_promises.empty()) {
+    return;
   }
-  for (auto& promise : no_more_pending_promises) {
-    promise.set_value();
+
+  auto admission = std::make_shared<std::vector<AdmissionPromise>>(
+      std::move(admission_promises));
+  auto no_more_pending = std::make_shared<std::vector<NoMorePendingPromise>>(
+      std::move(no_more_pending_promises));
+  RunCallbacks([admission, no_more_pending] {
+    // Inform the user that we've admitted these mutations and there might be
+    // some space in the buffer finally.
+    for (auto& promise : *admission) {
+      promise.set_value();
+    }
+    for (auto& promise : *no_more_pending) {
+      promise.set_value();
+    }
+  });
+}
+
+void MutationBatcher::RunCallbacks(std::function<void()> callbacks) {
+  if (callback_executor_) {
+    callback_executor_->Submit(std::move(callbacks));
+    return;
   }
+  callbacks();
 }
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -17,16 +17,23 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/callback_executor.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/optional.h"
 #include "google/cloud/status.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -45,6 +52,12 @@ inline namespace BIGTABLE_CLIENT_NS {
  * This class also offers an easy-to-use flow control mechanism to avoid
  * unbounded growth in its internal buffers.
  *
+ * `AsyncApply()` may be called concurrently from many threads. Mutations
+ * are staged in per-thread admission stripes and merged into batches by
+ * whichever thread holds the batcher lock, so admission throughput scales
+ * with the number of producer threads instead of serializing on a single
+ * lock.
+ *
  * Applications must provide a `CompletionQueue` to (asynchronously) execute
  * these operations. The application is responsible of executing the
  * `CompletionQueue` event loop in one or more threads.
@@ -79,19 +92,133 @@ class MutationBatcher {
       return *this;
     }
 
+    /**
+     * Adapt the batch size and in-flight batch count to observed latency.
+     *
+     * The best values for `max_size_per_batch` and `max_batches` depend
+     * on the server load and the payload mix, and they shift over time.
+     * In adaptive mode the batcher starts from the configured values and
+     * applies an AIMD (additive-increase / multiplicative-decrease)
+     * policy: each batch completing at or above `target_latency` halves
+     * the effective batch size and in-flight limit, each faster batch
+     * grows them back in small steps. The configured values act as upper
+     * bounds, so adaptive mode never sends more than the static
+     * configuration would.
+     */
+    Options& SetAdaptiveBatching(bool adaptive_batching_arg) {
+      adaptive_batching = adaptive_batching_arg;
+      return *this;
+    }
+
+    /// Batches slower than this shrink the adaptive limits, see
+    /// `SetAdaptiveBatching()`.
+    Options& SetTargetLatency(std::chrono::milliseconds target_latency_arg) {
+      target_latency = target_latency_arg;
+      return *this;
+    }
+
+    /**
+     * Let partial batches accumulate for up to this much time.
+     *
+     * By default a batch is sent as soon as an in-flight slot is
+     * available, so trickle writers get one RPC per mutation and no
+     * batching. With a linger configured, a partial batch waits for more
+     * mutations until it fills up, until a mutation that does not fit
+     * arrives, or until the linger expires — whichever happens first. The
+     * linger thus bounds the extra latency each mutation can incur
+     * waiting for a batch to form.
+     */
+    Options& SetMaxLinger(std::chrono::milliseconds max_linger_arg) {
+      has_max_linger = true;
+      max_linger = max_linger_arg;
+      return *this;
+    }
+
+    /**
+     * Partition batches by row key along these boundaries.
+     *
+     * Each boundary is the inclusive upper bound of a shard; row keys
+     * greater than the last boundary fall into one final shard. The
+     * boundaries are typically the sampled row keys returned by
+     * `Table::SampleRows()`, so each shard roughly corresponds to a
+     * tablet. Mutations in different shards accumulate in separate
+     * batches dispatched as concurrent RPCs, letting one batcher spread
+     * its load over many tablet servers (and, since each RPC picks the
+     * next channel of the `DataClient` pool, over many channels) instead
+     * of filling one batch spanning the whole table.
+     *
+     * The boundaries are sorted if they are not sorted already.
+     */
+    Options& SetShardBoundaries(std::vector<std::string> shard_boundaries_arg) {
+      shard_boundaries = std::move(shard_boundaries_arg);
+      std::sort(shard_boundaries.begin(), shard_boundaries.end());
+      return *this;
+    }
+
+    /**
+     * Run the user's callbacks on a dedicated pool of this many threads.
+     *
+     * By default the *completion* and *admission* callbacks run inline on
+     * the thread which learns about a batch's completion, typically a
+     * thread running the `CompletionQueue` event loop. One slow callback
+     * then delays RPC progress for every outstanding batch. With a
+     * callback thread count configured, the callbacks are handed off to a
+     * dedicated executor pool and the `CompletionQueue` threads stay on
+     * I/O.
+     *
+     * Note that with this option the futures returned from `AsyncApply()`
+     * and `AsyncWaitForNoPendingRequests()` are satisfied from the
+     * executor threads, and the latter may be satisfied while completion
+     * callbacks are still queued on the executor. The executor runs all
+     * remaining callbacks before the `MutationBatcher` is destroyed.
+     */
+    Options& SetCallbackThreadCount(std::size_t callback_thread_count_arg) {
+      callback_thread_count = callback_thread_count_arg;
+      return *this;
+    }
+
+    /**
+     * Bound the callback executor's queue to this many pending items.
+     *
+     * When the queue is full, submitting further callbacks blocks,
+     * applying backpressure instead of buffering an unbounded backlog.
+     * Only meaningful together with `SetCallbackThreadCount()`.
+     */
+    Options& SetCallbackQueueLimit(std::size_t callback_queue_limit_arg) {
+      callback_queue_limit = callback_queue_limit_arg;
+      return *this;
+    }
+
     std::size_t max_mutations_per_batch;
     std::size_t max_size_per_batch;
     std::size_t max_batches;
     std::size_t max_outstanding_size;
+    bool adaptive_batching;
+    std::chrono::milliseconds target_latency;
+    bool has_max_linger;
+    std::chrono::milliseconds max_linger;
+    std::vector<std::string> shard_boundaries;
+    std::size_t callback_thread_count;
+    std::size_t callback_queue_limit;
   };
 
   explicit MutationBatcher(Table table, Options options = Options())
       : table_(std::move(table)),
         options_(options),
+        adaptive_size_per_batch_(options.max_size_per_batch),
+        adaptive_max_batches_(options.max_batches),
         num_outstanding_batches_(),
         outstanding_size_(),
-        num_requests_pending_(),
-        cur_batch_(std::make_shared<Batch>()) {}
+        num_requests_pending_() {
+    batches_.reserve(options_.shard_boundaries.size() + 1);
+    for (std::size_t i = 0; i != options_.shard_boundaries.size() + 1; ++i) {
+      batches_.emplace_back(std::make_shared<Batch>());
+    }
+    if (options_.callback_thread_count != 0) {
+      callback_executor_.reset(new internal::CallbackExecutor(
+          options_.callback_thread_count, options_.callback_queue_limit));
+    }
+  }
 
   /**
    * Asynchronously apply mutation.
@@ -147,6 +274,65 @@ class MutationBatcher {
   std::pair<future<void>, future<Status>> AsyncApply(CompletionQueue& cq,
                                                      SingleRowMutation mut);
 
+  /**
+   * A pull-based source of mutations, see `AsyncApplyFromSource()`.
+   *
+   * Implementations produce the mutations of a large load job on demand,
+   * e.g. by reading them from a file, so the whole job never needs to be
+   * staged in memory at once.
+   */
+  class MutationSource {
+   public:
+    virtual ~MutationSource() = default;
+
+    /**
+     * Return the next mutation, or an empty optional at the end.
+     *
+     * Invocations are serialized, but may come from different threads
+     * (typically threads running the `CompletionQueue` event loop). It
+     * is not called again after it returns an empty optional.
+     */
+    virtual optional<SingleRowMutation> Next() = 0;
+  };
+
+  /// The summary of one `AsyncApplyFromSource()` call.
+  struct ApplyFromSourceResult {
+    /// The number of mutations pulled from the source.
+    std::int64_t total_mutations = 0;
+    /// The number of mutations which completed with an error.
+    std::int64_t failed_mutations = 0;
+    /// The status of the first failed mutation, OK if none failed.
+    Status first_failure;
+  };
+
+  /**
+   * Asynchronously apply all the mutations produced by @p source.
+   *
+   * Mutations are pulled from the source one at a time, and each pull is
+   * gated on the admission of the previous mutation. The memory held for
+   * the job is therefore bounded by `Options::SetMaxOutstandingSize()`
+   * (plus the one mutation waiting for admission), no matter how large
+   * the source is. This is the recommended way to run large load jobs:
+   * the equivalent loop over `AsyncApply()` is easy to get wrong, while
+   * staging the whole job in a `BulkMutation` needs memory proportional
+   * to the job size.
+   *
+   * The `MutationBatcher` must not be destroyed before the returned
+   * future is satisfied. Multiple sources may be drained concurrently,
+   * and `AsyncApply()` may be called while a drain is in progress; they
+   * all share the batcher's limits.
+   *
+   * @param cq the completion queue that will execute the asynchronous
+   *    calls, the application must ensure that one or more threads are
+   *    blocked on `cq.Run()`.
+   * @param source the source to drain.
+   *
+   * @return a future satisfied once every mutation pulled from the
+   *     source has completed, with a summary of the job.
+   */
+  future<ApplyFromSourceResult> AsyncApplyFromSource(
+      CompletionQueue& cq, std::unique_ptr<MutationSource> source);
+
   /**
    * Asynchronously wait until all submitted mutations complete.
    *
@@ -209,20 +395,71 @@ class MutationBatcher {
    * another attempt before invoking callbacks for the previous one.
    */
   struct Batch {
-    Batch() : num_mutations(), requests_size() {}
+    Batch() : num_mutations(), requests_size(), linger_expired() {}
 
     size_t num_mutations;
     size_t requests_size;
     BulkMutation requests;
     std::vector<MutationData> mutation_data;
+    /// When the batch was sent, to measure its latency in adaptive mode.
+    std::chrono::steady_clock::time_point sent_time;
+    /// The linger timer fired while this batch was accumulating, so it
+    /// should be flushed as soon as a slot is available.
+    bool linger_expired;
+  };
+
+  /**
+   * One admission stripe: a small staging area with its own lock.
+   *
+   * `AsyncApply()` appends the mutation to the calling thread's stripe
+   * instead of locking the whole batcher, so admissions from many
+   * producer threads proceed in parallel. Whichever thread next holds
+   * `mu_` merges all the stripes into `pending_mutations_`, see
+   * `DrainAdmissionStripes()`. The stripes are padded to a cache line so
+   * that stripes used by different threads do not false-share.
+   */
+  struct alignas(64) AdmissionStripe {
+    std::mutex mu;
+    std::deque<PendingSingleRowMutation> staged;
   };
 
+  /// The in-progress state of one `AsyncApplyFromSource()` call.
+  struct SourceDrainState;
+
+  /// The admission stripe assigned to the calling thread.
+  AdmissionStripe& StripeForThisThread();
+
+  /**
+   * Merge the admission stripes into `pending_mutations_` and admit what
+   * fits.
+   *
+   * This is a flat-combining scheme: the thread that acquires `mu_`
+   * merges *all* the stripes, so under contention one thread performs the
+   * batch construction work on behalf of many producers, and the other
+   * producers return as soon as their mutation has been picked up.
+   * @p own_stripe is the stripe holding the caller's mutation; the caller
+   * loops until that mutation has been merged, either by itself or by the
+   * current lock holder.
+   */
+  void DrainAdmissionStripes(CompletionQueue& cq, AdmissionStripe& own_stripe);
+
+  /// Pull mutations from @p state's source until admission blocks.
+  void PullFromSource(CompletionQueue cq,
+                      std::shared_ptr<SourceDrainState> state);
+
   /// Check if a mutation doesn't exceed allowed limits.
   grpc::Status IsValid(PendingSingleRowMutation& mut) const;
 
   /**
-   * Check whether there is space for the passed mutation in the currently
-   * constructed batch.
+   * The shard which the mutation's row key falls into.
+   *
+   * Always zero unless `Options::SetShardBoundaries()` was used.
+   */
+  std::size_t ShardOf(PendingSingleRowMutation const& mut) const;
+
+  /**
+   * Check whether there is space for the passed mutation in the batch
+   * currently constructed for its shard.
    */
   bool HasSpaceFor(PendingSingleRowMutation const& mut) const;
 
@@ -239,15 +476,32 @@ class MutationBatcher {
   }
 
   /**
-   * Send the currently constructed batch if there are not too many outstanding
-   * already. If there are no mutations in the batch, it's a noop.
+   * Send the batch currently constructed for @p shard if there are not too
+   * many outstanding already. If there are no mutations in the batch, it's a
+   * noop.
+   *
+   * When a linger is configured (see `Options::SetMaxLinger()`) a partial
+   * batch is only sent if @p flush_partial is set or its linger expired.
    */
-  bool FlushIfPossible(CompletionQueue cq);
+  bool FlushIfPossible(CompletionQueue cq, std::size_t shard,
+                       bool flush_partial);
+
+  /// Flush the batch whose linger timer fired, if it is still current.
+  void OnLingerExpired(CompletionQueue cq, std::size_t shard,
+                       std::shared_ptr<Batch> batch);
 
   /// Handle a completed batch.
   void OnBulkApplyDone(CompletionQueue cq, MutationBatcher::Batch batch,
                        std::vector<FailedMutation> const& failed);
 
+  /**
+   * Apply one AIMD step based on the latency of a completed batch.
+   *
+   * Must be called with `mu_` held. A noop unless
+   * `Options::SetAdaptiveBatching()` was used.
+   */
+  void UpdateAdaptiveLimits(std::chrono::steady_clock::duration latency);
+
   /**
    * Try to move mutations waiting in `pending_mutations_` to the currently
    * constructed batch.
@@ -257,9 +511,12 @@ class MutationBatcher {
   std::vector<MutationBatcher::AdmissionPromise> TryAdmit(CompletionQueue& cq);
 
   /**
-   * Append mutation `mut` to the currently constructed batch.
+   * Append mutation `mut` to the batch currently constructed for its shard.
+   *
+   * When a linger is configured, the first mutation of a batch schedules
+   * the timer bounding how long the batch may accumulate.
    */
-  void Admit(PendingSingleRowMutation mut);
+  void Admit(CompletionQueue& cq, PendingSingleRowMutation mut);
 
   /**
    * Satisfies passed admission promises and potentially the promises of no more
@@ -268,10 +525,26 @@ class MutationBatcher {
   void SatisfyPromises(std::vector<AdmissionPromise>,
                        std::unique_lock<std::mutex>& lk);
 
+  /**
+   * Run code which may invoke user callbacks.
+   *
+   * Runs @p callbacks inline, unless `Options::SetCallbackThreadCount()`
+   * moved the user's callbacks to a dedicated executor pool.
+   */
+  void RunCallbacks(std::function<void()> callbacks);
+
   std::mutex mu_;
   Table table_;
   Options options_;
 
+  /**
+   * The limits currently in effect, see `Options::SetAdaptiveBatching()`.
+   *
+   * Without adaptive batching these stay equal to the configured limits.
+   */
+  std::size_t adaptive_size_per_batch_;
+  std::size_t adaptive_max_batches_;
+
   /// Num batches sent but not completed.
   size_t num_outstanding_batches_;
   /// Size of admitted but uncompleted mutations.
@@ -279,8 +552,13 @@ class MutationBatcher {
   // Number of uncompleted SingleRowMutations (including not admitted).
   size_t num_requests_pending_;
 
-  /// Currently contructed batch of mutations.
-  std::shared_ptr<Batch> cur_batch_;
+  /**
+   * Currently contructed batches of mutations, one per shard.
+   *
+   * Without `Options::SetShardBoundaries()` there is a single shard, and
+   * hence a single batch accumulating at any time.
+   */
+  std::vector<std::shared_ptr<Batch>> batches_;
 
   /**
    * These are the mutations which have not been admitted yet. If the user is
@@ -289,6 +567,12 @@ class MutationBatcher {
    */
   std::queue<PendingSingleRowMutation> pending_mutations_;
 
+  /// The number of admission stripes, see `AdmissionStripe`.
+  static std::size_t constexpr kNumAdmissionStripes = 8;
+
+  /// Per-thread staging areas for `AsyncApply()`, see `AdmissionStripe`.
+  std::array<AdmissionStripe, kNumAdmissionStripes> admission_stripes_;
+
   /**
    * The list of promises made to this point.
    *
@@ -296,6 +580,13 @@ class MutationBatcher {
    * `AsyncWaitForNoPendingRequests()`.
    */
   std::vector<NoMorePendingPromise> no_more_pending_promises_;
+
+  /**
+   * Runs the user's callbacks off the `CompletionQueue` threads.
+   *
+   * Null unless `Options::SetCallbackThreadCount()` was used.
+   */
+  std::unique_ptr<internal::CallbackExecutor> callback_executor_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
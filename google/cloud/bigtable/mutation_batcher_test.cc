@@ -35,6 +35,11 @@ using namespace ::testing;
 using namespace google::cloud::testing_util::chrono_literals;
 using bigtable::testing::MockClientAsyncReaderInterface;
 
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
 std::size_t MutationSize(SingleRowMutation mut) {
   google::bigtable::v2::MutateRowsRequest::Entry entry;
   mut.MoveTo(&entry);
@@ -254,6 +259,14 @@ TEST(OptionsTest, Trivial) {
   ASSERT_EQ(4, opt.max_outstanding_size);
 }
 
+TEST(OptionsTest, Adaptive) {
+  MutationBatcher::Options opt;
+  ASSERT_FALSE(opt.adaptive_batching);
+  opt.SetAdaptiveBatching(true).SetTargetLatency(5_ms);
+  ASSERT_TRUE(opt.adaptive_batching);
+  ASSERT_EQ(5_ms, opt.target_latency);
+}
+
 TEST_F(MutationBatcherTest, TrivialTest) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
@@ -658,6 +671,326 @@ TEST_F(MutationBatcherTest, WaitForNoPendingEdgeCases) {
   EXPECT_EQ(no_more_pending2.wait_for(1_ms), std::future_status::ready);
 }
 
+// Test that adaptive batching shrinks the batch size after slow RPCs.
+TEST_F(MutationBatcherTest, AdaptiveBatchingShrinksBatchSize) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo4", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo5", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  std::size_t const mutation_size = MutationSize(mutations[0]);
+
+  // A target latency of zero makes every completed batch count as slow,
+  // so each completion halves the adaptive limits deterministically.
+  batcher_.reset(new MutationBatcher(table_,
+                                     MutationBatcher::Options()
+                                         .SetMaxSizePerBatch(2 * mutation_size)
+                                         .SetMaxBatches(1)
+                                         .SetMaxOutstandingSize(4000)
+                                         .SetAdaptiveBatching(true)
+                                         .SetTargetLatency(0_ms)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       // While the first batch is in flight the batch size limit is still
+       // 2 * mutation_size, so mutations 1 and 2 batch together.
+       Exchange({mutations[1], mutations[2]}, {ResultPiece({0, 1}, {}, {})}),
+       // The completion of the first batch halved the batch size limit,
+       // mutation 4 can no longer join mutation 3 in one batch.
+       Exchange({mutations[3]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[4]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  auto batched = ApplyMany(mutations.begin() + 1, mutations.begin() + 3);
+  auto delayed = ApplyMany(mutations.begin() + 3, mutations.end());
+  EXPECT_TRUE(batched.AllAdmitted());
+  EXPECT_TRUE(delayed.NoneAdmitted());
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(batched.NoneCompleted());
+  // Mutation 3 fills a whole (shrunk) batch, mutation 4 stays pending.
+  EXPECT_TRUE(delayed.states_[0]->admitted);
+  EXPECT_FALSE(delayed.states_[1]->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(batched.AllCompleted());
+  EXPECT_TRUE(delayed.AllAdmitted());
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(delayed.states_[0]->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(delayed.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST(OptionsTest, MaxLinger) {
+  MutationBatcher::Options opt;
+  ASSERT_FALSE(opt.has_max_linger);
+  opt.SetMaxLinger(7_ms);
+  ASSERT_TRUE(opt.has_max_linger);
+  ASSERT_EQ(7_ms, opt.max_linger);
+}
+
+// Test that with a linger configured mutations batch up until the timer
+// fires, rather than being sent one per RPC.
+TEST_F(MutationBatcherTest, MaxLingerBatchesTrickleWrites) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxBatches(1).SetMaxLinger(10_ms)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  // No RPC was sent; the only outstanding operation is the linger timer.
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  auto state1 = Apply(mutations[1]);
+  EXPECT_TRUE(state1->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // Firing the timer flushes the accumulated batch in a single RPC.
+  FinishTimer();
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state1->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+// Test that a mutation which does not fit flushes the lingering batch,
+// and that a batch whose linger expired while all slots were taken is
+// flushed as soon as a slot frees up.
+TEST_F(MutationBatcherTest, MaxLingerFlushesWhenBatchFills) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetMaxMutationsPerBatch(2)
+                                                 .SetMaxBatches(1)
+                                                 .SetMaxLinger(10_ms)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})}),
+       Exchange({mutations[2]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  auto state1 = Apply(mutations[1]);
+  // Only the linger timer is outstanding, the batch is still lingering.
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // The third mutation does not fit, so the full batch is flushed and the
+  // mutation is admitted into a fresh batch with its own linger timer.
+  auto state2 = Apply(mutations[2]);
+  EXPECT_TRUE(state2->admitted);
+  // The stale timer, the RPC, and the new batch's timer.
+  EXPECT_EQ(3, NumOperationsOutstanding());
+
+  // Completes the stale timer (a noop) and the new batch's timer; the
+  // second batch cannot be flushed yet because the only slot is taken.
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state1->completed);
+  EXPECT_FALSE(state2->completed);
+  // The expired second batch was flushed when the slot freed up.
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST(OptionsTest, ShardBoundaries) {
+  MutationBatcher::Options opt;
+  ASSERT_TRUE(opt.shard_boundaries.empty());
+  opt.SetShardBoundaries({"x", "m"});
+  ASSERT_EQ(std::vector<std::string>({"m", "x"}), opt.shard_boundaries);
+}
+
+// Test that with shard boundaries configured mutations are partitioned by
+// row key into per-shard batches sent as separate, concurrent RPCs.
+TEST_F(MutationBatcherTest, ShardBoundariesPartitionBatches) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("a", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("b", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("z", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetShardBoundaries({"m"}).SetMaxLinger(
+          10_ms)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})}),
+       Exchange({mutations[2]}, {ResultPiece({0}, {}, {})})});
+
+  auto state = ApplyMany(mutations.begin(), mutations.end());
+  EXPECT_TRUE(state.AllAdmitted());
+  EXPECT_TRUE(state.NoneCompleted());
+  // One linger timer per shard with accumulated mutations.
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  // Firing the timers flushes both shards as concurrent RPCs.
+  FinishTimer();
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST(OptionsTest, CallbackExecutor) {
+  MutationBatcher::Options opt;
+  ASSERT_EQ(0, opt.callback_thread_count);
+  opt.SetCallbackThreadCount(2).SetCallbackQueueLimit(32);
+  ASSERT_EQ(2, opt.callback_thread_count);
+  ASSERT_EQ(32, opt.callback_queue_limit);
+}
+
+// Test that with a callback executor configured the admission and
+// completion futures are still satisfied, now from the executor threads.
+TEST_F(MutationBatcherTest, CallbackExecutorDeliversCompletions) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options().SetCallbackThreadCount(1)));
+
+  ExpectInteraction({{{mutations[0]}, {ResultPiece({0}, {}, {})}}});
+
+  auto admission_and_completion = batcher_->AsyncApply(cq_, mutations[0]);
+  // The admission promise is satisfied from the executor thread, `get()`
+  // blocks until the handoff completes.
+  admission_and_completion.first.get();
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  // The completion promise is satisfied from the executor thread too.
+  EXPECT_EQ(Status(), admission_and_completion.second.get());
+  batcher_->AsyncWaitForNoPendingRequests().get();
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+/// A `MutationSource` yielding the contents of a vector.
+class VectorMutationSource : public MutationBatcher::MutationSource {
+ public:
+  explicit VectorMutationSource(std::vector<SingleRowMutation> mutations)
+      : mutations_(std::move(mutations)), next_(0) {}
+
+  optional<SingleRowMutation> Next() override {
+    if (next_ == mutations_.size()) {
+      return optional<SingleRowMutation>();
+    }
+    return optional<SingleRowMutation>(mutations_[next_++]);
+  }
+
+  /// The number of mutations pulled so far.
+  std::size_t num_pulled() const { return next_; }
+
+ private:
+  std::vector<SingleRowMutation> mutations_;
+  std::size_t next_;
+};
+
+// Test that a source is drained and its summary reports the failures.
+TEST_F(MutationBatcherTest, ApplyFromSourceDrainsSource) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(
+      new MutationBatcher(table_, MutationBatcher::Options().SetMaxBatches(1)));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[1]}, {ResultPiece({}, {}, {0})})});
+
+  auto res = batcher_->AsyncApplyFromSource(
+      cq_, google::cloud::internal::make_unique<VectorMutationSource>(
+               mutations));
+  // Both mutations fit in the outstanding size limit, so the whole
+  // source is pulled up front.
+  EXPECT_TRUE(Unsatisfied(res));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(Unsatisfied(res));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  auto summary = res.get();
+  EXPECT_EQ(2, summary.total_mutations);
+  EXPECT_EQ(1, summary.failed_mutations);
+  EXPECT_FALSE(summary.first_failure.ok());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+// Test that the source is pulled only as the admission window opens.
+TEST_F(MutationBatcherTest, ApplyFromSourcePullsAsWindowOpens) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  // Only one mutation fits in the outstanding size limit, the rest of
+  // the source has to wait for the admission window to open.
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options().SetMaxBatches(1).SetMaxOutstandingSize(
+                  MutationSize(mutations[0]))));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[1]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[2]}, {ResultPiece({0}, {}, {})})});
+
+  auto source_owner =
+      google::cloud::internal::make_unique<VectorMutationSource>(mutations);
+  auto* source = source_owner.get();
+  auto res = batcher_->AsyncApplyFromSource(cq_, std::move(source_owner));
+
+  // The first mutation is admitted, the second is pulled and waits for
+  // admission, the third stays in the source.
+  EXPECT_EQ(2, source->num_pulled());
+  EXPECT_TRUE(Unsatisfied(res));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  // Completing the first mutation admits the second, which opens the
+  // window for pulling the third.
+  EXPECT_EQ(3, source->num_pulled());
+  EXPECT_TRUE(Unsatisfied(res));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(Unsatisfied(res));
+  FinishSingleItemStream();
+
+  auto summary = res.get();
+  EXPECT_EQ(3, summary.total_mutations);
+  EXPECT_EQ(0, summary.failed_mutations);
+  EXPECT_STATUS_OK(summary.first_failure);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -14,11 +14,64 @@
 
 #include "google/cloud/bigtable/mutations.h"
 #include <google/protobuf/text_format.h>
+#include <google/protobuf/unknown_field_set.h>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/// Append @p value to @p buffer in the protobuf varint encoding.
+void AppendVarint(std::string& buffer, std::uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+/// Append a length-delimited field (wire type 2) to @p buffer.
+void AppendLengthDelimited(std::string& buffer, int field_number,
+                           std::string const& payload) {
+  AppendVarint(buffer, (static_cast<std::uint64_t>(field_number) << 3) | 2);
+  AppendVarint(buffer, payload.size());
+  buffer.append(payload);
+}
+}  // namespace
+
+SetCellTemplate::SetCellTemplate(std::string const& family,
+                                 std::string const& column) {
+  // The field numbers are from google.bigtable.v2.Mutation.SetCell:
+  // family_name = 1, column_qualifier = 2.
+  AppendLengthDelimited(constant_region_, 1, family);
+  AppendLengthDelimited(constant_region_, 2, column);
+}
+
+Mutation SetCellTemplate::MakeMutation(std::chrono::milliseconds timestamp,
+                                       std::string const& value) const {
+  auto const micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(timestamp).count();
+  std::string payload;
+  // The varint encodings of the tags and of a non-negative timestamp
+  // take at most 12 bytes together.
+  payload.reserve(constant_region_.size() + value.size() + 12);
+  payload.append(constant_region_);
+  // timestamp_micros = 3, wire type 0 (varint).
+  AppendVarint(payload, 3 << 3);
+  AppendVarint(payload, static_cast<std::uint64_t>(micros));
+  // value = 4, wire type 2.
+  AppendLengthDelimited(payload, 4, value);
+
+  // Store the encoded SetCell submessage as an unknown field with the
+  // number of the `set_cell` member of google.bigtable.v2.Mutation; the
+  // serializer emits unknown length-delimited fields as tag, length, and
+  // payload, exactly the bytes a parsed `set_cell` would produce.
+  Mutation m;
+  *m.op.GetReflection()->MutableUnknownFields(&m.op)->AddLengthDelimited(1) =
+      std::move(payload);
+  return m;
+}
+
 Mutation DeleteFromFamily(std::string family) {
   Mutation m;
   auto& d = *m.op.mutable_delete_from_family();
@@ -24,9 +24,15 @@
 #include "google/cloud/status_or.h"
 #include <google/bigtable/v2/bigtable.pb.h>
 #include <google/bigtable/v2/data.pb.h>
+#include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 #include <chrono>
+#include <memory>
 #include <type_traits>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif  // __cplusplus >= 201703L
 
 namespace google {
 namespace cloud {
@@ -273,6 +279,48 @@ Mutation DeleteFromFamily(std::string family);
 /// Create a mutation to delete all the cells in a row.
 Mutation DeleteFromRow();
 
+/**
+ * A factory for structurally identical `SetCell()` mutations.
+ *
+ * Ingestion workloads often emit millions of mutations that share the
+ * family and column and differ only in timestamp and value. Each
+ * `SetCell()` call copies the constant strings into a new proto again,
+ * and the proto is re-serialized field by field when the request is
+ * sent. This class encodes the constant region of the `SetCell` wire
+ * format once; `MakeMutation()` then only appends the timestamp and the
+ * value to the pre-encoded bytes, and the request serializer emits the
+ * result with a plain copy.
+ *
+ * The mutations created here are wire-compatible with those built by
+ * `SetCell()` and can be used anywhere a `Mutation` can. The trade-off
+ * is introspection: the pre-encoded bytes are carried in the proto's
+ * unknown fields, so code that inspects `op.set_cell()` — for example a
+ * custom `IdempotentMutationPolicy` — does not see them. The built-in
+ * policies classify these mutations correctly: the template requires an
+ * explicit timestamp, which always produces an idempotent mutation, and
+ * deliberately has no server-set timestamp overload.
+ */
+class SetCellTemplate {
+ public:
+  /// Create a template for cells in @p family and @p column.
+  SetCellTemplate(std::string const& family, std::string const& column);
+
+  /// Create a mutation setting the templated column to @p value.
+  Mutation MakeMutation(std::chrono::milliseconds timestamp,
+                        std::string const& value) const;
+
+  /// Create a mutation storing a 64-bit big endian integer value.
+  Mutation MakeMutation(std::chrono::milliseconds timestamp,
+                        std::int64_t value) const {
+    return MakeMutation(timestamp,
+                        google::cloud::internal::EncodeBigEndian(value));
+  }
+
+ private:
+  /// The encoded family and qualifier fields of the `SetCell` submessage.
+  std::string constant_region_;
+};
+
 /**
  * Represent a single row mutation.
  *
@@ -298,6 +346,7 @@ class SingleRowMutation {
       : request_() {
     request_.set_row_key(std::forward<RowKey>(row_key));
     for (auto&& i : list) {
+      UpdateIdempotencyCache(i.op);
       *request_.add_mutations() = i.op;
     }
   }
@@ -322,14 +371,22 @@ class SingleRowMutation {
     using std::swap;
     swap(*request_.mutable_row_key(), *entry.mutable_row_key());
     swap(*request_.mutable_mutations(), *entry.mutable_mutations());
+    for (auto const& m : request_.mutations()) {
+      UpdateIdempotencyCache(m);
+    }
   }
 
   /// Create a row mutation from gRPC proto
   explicit SingleRowMutation(::google::bigtable::v2::MutateRowRequest request)
-      : request_(std::move(request)) {}
+      : request_(std::move(request)) {
+    for (auto const& m : request_.mutations()) {
+      UpdateIdempotencyCache(m);
+    }
+  }
 
   // Add a mutation at the end.
   SingleRowMutation& emplace_back(Mutation mut) {
+    UpdateIdempotencyCache(mut.op);
     *request_.add_mutations() = std::move(mut.op);
     return *this;
   }
@@ -337,6 +394,15 @@ class SingleRowMutation {
   // Get the row key.
   RowKeyType const& row_key() const { return request_.row_key(); }
 
+  /**
+   * Returns true if none of the mutations sets the server timestamp.
+   *
+   * This bit is maintained as mutations are added, so
+   * `SafeIdempotentMutationPolicy` can classify a whole row without
+   * walking each mutation proto again on every `BulkApply()` attempt.
+   */
+  bool is_safe_idempotent() const { return is_safe_idempotent_; }
+
   friend class Table;
 
   SingleRowMutation(SingleRowMutation&&) = default;
@@ -357,7 +423,10 @@ class SingleRowMutation {
   }
 
   /// Remove the contents of the mutation.
-  void Clear() { request_.Clear(); }
+  void Clear() {
+    request_.Clear();
+    is_safe_idempotent_ = true;
+  }
 
  private:
   /// Add multiple mutations to single row
@@ -369,8 +438,17 @@ class SingleRowMutation {
 
   void emplace_many(Mutation m) { emplace_back(std::move(m)); }
 
+  /// Keep the cached idempotency bit current as mutations are added.
+  void UpdateIdempotencyCache(google::bigtable::v2::Mutation const& m) {
+    if (m.has_set_cell() &&
+        m.set_cell().timestamp_micros() == ServerSetTimestamp()) {
+      is_safe_idempotent_ = false;
+    }
+  }
+
  private:
   ::google::bigtable::v2::MutateRowRequest request_;
+  bool is_safe_idempotent_ = true;
 };
 
 /**
@@ -448,6 +526,10 @@ class PermanentMutationFailure : public std::runtime_error {
   grpc::Status status_;
 };
 
+namespace internal {
+class BulkMutatorState;
+}  // namespace internal
+
 /**
  * Represent a set of mutations across multiple rows.
  *
@@ -497,6 +579,7 @@ class BulkMutation {
 
   // Add a mutation to the batch.
   BulkMutation& emplace_back(SingleRowMutation mut) {
+    entry_is_safe_idempotent_.push_back(mut.is_safe_idempotent());
     mut.MoveTo(request_.add_entries());
     return *this;
   }
@@ -509,6 +592,7 @@ class BulkMutation {
 
   // Add a mutation to the batch.
   BulkMutation& push_back(SingleRowMutation mut) {
+    entry_is_safe_idempotent_.push_back(mut.is_safe_idempotent());
     mut.MoveTo(request_.add_entries());
     return *this;
   }
@@ -517,6 +601,7 @@ class BulkMutation {
   void MoveTo(google::bigtable::v2::MutateRowsRequest* request) {
     request_.Swap(request);
     request_ = {};
+    entry_is_safe_idempotent_.clear();
   }
 
   /// Return true if there are no mutations in this set.
@@ -530,6 +615,8 @@ class BulkMutation {
     return request_.ByteSizeLong();
   }
 
+  friend class internal::BulkMutatorState;
+
  private:
   template <typename... M>
   void emplace_many(SingleRowMutation first, M&&... tail) {
@@ -541,6 +628,138 @@ class BulkMutation {
 
  private:
   google::bigtable::v2::MutateRowsRequest request_;
+  /// The per-row idempotency bits, aligned with `request_.entries()`.
+  std::vector<bool> entry_is_safe_idempotent_;
+};
+
+/**
+ * A bulk mutation that allocates all of its protos from a single arena.
+ *
+ * Each mutation created through `SetCell()` allocates a standalone proto
+ * and separate heap strings for the family, qualifier, and value. For
+ * ingestion workloads creating millions of mutations per second this
+ * allocation (and the matching deallocation) dominates the cost of
+ * building the request. This class builds the entries directly inside a
+ * `MutateRowsRequest` owned by a `google::protobuf::Arena`: every proto
+ * and string is bump-allocated from the arena, each input is copied
+ * exactly once, and the whole request is released in one step when the
+ * arena is destroyed.
+ *
+ * Use it like so:
+ *
+ * @code
+ * bigtable::ArenaBulkMutation bulk;
+ * for (auto const& record : input) {
+ *   bulk.StartRow(record.key);
+ *   bulk.SetCell("fam", "col", record.timestamp, record.value);
+ * }
+ * auto failures = table.BulkApply(std::move(bulk));
+ * @endcode
+ *
+ * The class is move-only, moving it transfers ownership of the arena.
+ */
+class ArenaBulkMutation {
+ public:
+  ArenaBulkMutation()
+      : arena_(std::make_shared<google::protobuf::Arena>()),
+        request_(google::protobuf::Arena::CreateMessage<
+                 google::bigtable::v2::MutateRowsRequest>(arena_.get())),
+        entry_(nullptr) {}
+
+  ArenaBulkMutation(ArenaBulkMutation&&) = default;
+  ArenaBulkMutation& operator=(ArenaBulkMutation&&) = default;
+  ArenaBulkMutation(ArenaBulkMutation const&) = delete;
+  ArenaBulkMutation& operator=(ArenaBulkMutation const&) = delete;
+
+  /// Start a new row, the following `SetCell()` calls apply to it.
+  void StartRow(std::string const& row_key) {
+    entry_ = request_->add_entries();
+    entry_->set_row_key(row_key);
+    entry_is_safe_idempotent_.push_back(true);
+  }
+
+  /**
+   * Add a `SetCell()` mutation to the current row.
+   *
+   * `StartRow()` must have been called at least once before this.
+   */
+  void SetCell(std::string const& family, std::string const& column,
+               std::chrono::milliseconds timestamp, std::string const& value) {
+    auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+    set_cell.set_family_name(family);
+    set_cell.set_column_qualifier(column);
+    set_cell.set_timestamp_micros(
+        std::chrono::duration_cast<std::chrono::microseconds>(timestamp)
+            .count());
+    set_cell.set_value(value);
+  }
+
+  /**
+   * Add a `SetCell()` mutation where the server sets the time.
+   *
+   * These mutations are not idempotent and not retried by default.
+   */
+  void SetCell(std::string const& family, std::string const& column,
+               std::string const& value) {
+    auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+    set_cell.set_family_name(family);
+    set_cell.set_column_qualifier(column);
+    set_cell.set_timestamp_micros(ServerSetTimestamp());
+    set_cell.set_value(value);
+    entry_is_safe_idempotent_.back() = false;
+  }
+
+#if __cplusplus >= 201703L
+  /// @name Overloads copying each `std::string_view` once, into the arena.
+  //@{
+  void StartRow(std::string_view row_key) {
+    entry_ = request_->add_entries();
+    entry_->set_row_key(row_key.data(), row_key.size());
+    entry_is_safe_idempotent_.push_back(true);
+  }
+
+  void SetCell(std::string_view family, std::string_view column,
+               std::chrono::milliseconds timestamp, std::string_view value) {
+    auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+    set_cell.set_family_name(family.data(), family.size());
+    set_cell.set_column_qualifier(column.data(), column.size());
+    set_cell.set_timestamp_micros(
+        std::chrono::duration_cast<std::chrono::microseconds>(timestamp)
+            .count());
+    set_cell.set_value(value.data(), value.size());
+  }
+
+  void SetCell(std::string_view family, std::string_view column,
+               std::string_view value) {
+    auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+    set_cell.set_family_name(family.data(), family.size());
+    set_cell.set_column_qualifier(column.data(), column.size());
+    set_cell.set_timestamp_micros(ServerSetTimestamp());
+    set_cell.set_value(value.data(), value.size());
+    entry_is_safe_idempotent_.back() = false;
+  }
+  //@}
+#endif  // __cplusplus >= 201703L
+
+  /// Return true if there are no mutations in this set.
+  bool empty() const { return request_->entries().empty(); }
+
+  /// Return the number of row entries in this set.
+  std::size_t size() const { return request_->entries().size(); }
+
+  /// Return the request proto, the arena retains ownership.
+  google::bigtable::v2::MutateRowsRequest const& as_proto() const {
+    return *request_;
+  }
+
+ private:
+  friend class internal::BulkMutatorState;
+
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  google::bigtable::v2::MutateRowsRequest* request_;
+  google::bigtable::v2::MutateRowsRequest::Entry* entry_;
+  /// The per-row idempotency bits, aligned with `request_->entries()`.
+  std::vector<bool> entry_is_safe_idempotent_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
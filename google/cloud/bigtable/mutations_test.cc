@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/internal/big_endian.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/chrono_literals.h"
@@ -255,3 +256,111 @@ TEST(MutationsTest, SingleRowMutationClear) {
   mut.MoveTo(&entry);
   EXPECT_EQ(0, entry.mutations_size());
 }
+
+/// @test Verify that ArenaBulkMutation builds the request on its arena.
+TEST(MutationsTest, ArenaBulkMutation) {
+  bigtable::ArenaBulkMutation bulk;
+  EXPECT_TRUE(bulk.empty());
+
+  bulk.StartRow("row-key-1");
+  bulk.SetCell("family", "c1", 1234_ms, "v1");
+  bulk.SetCell("family", "c2", "v2");
+  bulk.StartRow("row-key-2");
+  bulk.SetCell("family", "c1", 1234_ms, "v3");
+
+  EXPECT_FALSE(bulk.empty());
+  EXPECT_EQ(2U, bulk.size());
+
+  auto const& request = bulk.as_proto();
+  // The request and all its entries are owned by the arena.
+  EXPECT_NE(nullptr, request.GetArena());
+  ASSERT_EQ(2, request.entries_size());
+  auto const& e0 = request.entries(0);
+  EXPECT_EQ("row-key-1", e0.row_key());
+  ASSERT_EQ(2, e0.mutations_size());
+  ASSERT_TRUE(e0.mutations(0).has_set_cell());
+  EXPECT_EQ("family", e0.mutations(0).set_cell().family_name());
+  EXPECT_EQ("c1", e0.mutations(0).set_cell().column_qualifier());
+  EXPECT_EQ(1234000, e0.mutations(0).set_cell().timestamp_micros());
+  EXPECT_EQ("v1", e0.mutations(0).set_cell().value());
+  EXPECT_EQ(bigtable::ServerSetTimestamp(),
+            e0.mutations(1).set_cell().timestamp_micros());
+  auto const& e1 = request.entries(1);
+  EXPECT_EQ("row-key-2", e1.row_key());
+  ASSERT_EQ(1, e1.mutations_size());
+  EXPECT_EQ("v3", e1.mutations(0).set_cell().value());
+}
+
+/// @test Verify that SingleRowMutation caches its idempotency bit.
+TEST(MutationsTest, SingleRowMutationIdempotencyCache) {
+  bigtable::SingleRowMutation idempotent(
+      "row", {bigtable::SetCell("fam", "col", 0_ms, "v")});
+  EXPECT_TRUE(idempotent.is_safe_idempotent());
+
+  bigtable::SingleRowMutation server_set(
+      "row", {bigtable::SetCell("fam", "col", "v")});
+  EXPECT_FALSE(server_set.is_safe_idempotent());
+  server_set.Clear();
+  EXPECT_TRUE(server_set.is_safe_idempotent());
+
+  bigtable::SingleRowMutation appended("row");
+  appended.emplace_back(bigtable::SetCell("fam", "col", 0_ms, "v"));
+  EXPECT_TRUE(appended.is_safe_idempotent());
+  appended.emplace_back(bigtable::SetCell("fam", "col", "v"));
+  EXPECT_FALSE(appended.is_safe_idempotent());
+
+  // The bit is recomputed when creating a mutation from a proto.
+  google::bigtable::v2::MutateRowsRequest::Entry entry;
+  entry.set_row_key("row");
+  auto& set_cell = *entry.add_mutations()->mutable_set_cell();
+  set_cell.set_family_name("fam");
+  set_cell.set_column_qualifier("col");
+  set_cell.set_timestamp_micros(bigtable::ServerSetTimestamp());
+  bigtable::SingleRowMutation from_proto(std::move(entry));
+  EXPECT_FALSE(from_proto.is_safe_idempotent());
+}
+
+TEST(MutationsTest, SetCellTemplateIsWireCompatible) {
+  bigtable::SetCellTemplate tmpl("family", "col");
+
+  // The pre-encoded mutation must serialize to the same bytes as one
+  // built through the regular factory function.
+  auto expected = bigtable::SetCell("family", "col", 1234_ms, "value");
+  auto actual = tmpl.MakeMutation(1234_ms, "value");
+  EXPECT_EQ(expected.op.SerializeAsString(), actual.op.SerializeAsString());
+
+  // A server parsing the encoded bytes sees a regular SetCell.
+  google::bigtable::v2::Mutation parsed;
+  ASSERT_TRUE(parsed.ParseFromString(actual.op.SerializeAsString()));
+  ASSERT_TRUE(parsed.has_set_cell());
+  EXPECT_EQ("family", parsed.set_cell().family_name());
+  EXPECT_EQ("col", parsed.set_cell().column_qualifier());
+  EXPECT_EQ(1234000, parsed.set_cell().timestamp_micros());
+  EXPECT_EQ("value", parsed.set_cell().value());
+
+  // Large values and timestamps exercise the multi-byte varint paths.
+  std::string const large_value(300, 'x');
+  auto const large_ts = std::chrono::milliseconds(std::int64_t{1} << 50);
+  expected = bigtable::SetCell("family", "col", large_ts, large_value);
+  actual = tmpl.MakeMutation(large_ts, large_value);
+  EXPECT_EQ(expected.op.SerializeAsString(), actual.op.SerializeAsString());
+}
+
+TEST(MutationsTest, SetCellTemplateNumericValue) {
+  bigtable::SetCellTemplate tmpl("family", "col");
+  auto expected =
+      bigtable::SetCell("family", "col", 1234_ms, std::int64_t{9876543210});
+  auto actual = tmpl.MakeMutation(1234_ms, std::int64_t{9876543210});
+  EXPECT_EQ(expected.op.SerializeAsString(), actual.op.SerializeAsString());
+}
+
+TEST(MutationsTest, SetCellTemplateIsIdempotent) {
+  // Template mutations always carry an explicit timestamp, the cached
+  // per-row idempotency bit must stay true.
+  bigtable::SetCellTemplate tmpl("family", "col");
+  bigtable::SingleRowMutation mut("row", tmpl.MakeMutation(0_ms, "v"));
+  EXPECT_TRUE(mut.is_safe_idempotent());
+
+  auto policy = bigtable::DefaultIdempotentMutationPolicy();
+  EXPECT_TRUE(policy->is_idempotent(tmpl.MakeMutation(0_ms, "v").op));
+}
@@ -0,0 +1,192 @@
+// Copyright 2019 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/parallel_row_reader.h"
+#include "google/cloud/bigtable/internal/google_bytes_traits.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::vector<RowSet> PartitionRowSetAtSampleBoundaries(
+    RowSet const& row_set, std::vector<RowKeySample> const& samples) {
+  std::vector<RowSet> shards;
+  auto append_shard = [&row_set, &shards](RowKeyType begin, RowKeyType end) {
+    auto shard = row_set.Intersect(
+        RowRange::RightOpen(std::move(begin), std::move(end)));
+    if (!shard.IsEmpty()) {
+      shards.emplace_back(std::move(shard));
+    }
+  };
+  RowKeyType previous("");
+  for (auto const& sample : samples) {
+    // The empty key marks the end of the table, the final shard below
+    // covers it. Also skip boundaries out of order or repeated.
+    if (sample.row_key.empty() ||
+        CompareRowKey(previous, sample.row_key) >= 0) {
+      continue;
+    }
+    append_shard(previous, sample.row_key);
+    previous = sample.row_key;
+  }
+  append_shard(std::move(previous), "");
+  return shards;
+}
+}  // namespace internal
+
+namespace {
+// Upper bound on the rows buffered in each delivery queue, this bounds the
+// memory used when the streams produce rows faster than the application
+// consumes them.
+std::size_t constexpr kMaxBufferedRows = 1024;
+}  // namespace
+
+Status ParallelRowReader::Scan(std::function<void(Row)> const& on_row) {
+  auto samples = table_.SampleRows();
+  if (!samples) {
+    return samples.status();
+  }
+  auto shards =
+      internal::PartitionRowSetAtSampleBoundaries(row_set_, *samples);
+  if (shards.empty()) {
+    return Status();
+  }
+
+  struct Queue {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<Row> rows;
+    bool done = false;
+  };
+  // With ordered delivery each shard gets its own queue and the consumer
+  // drains the queues in shard order; the shards are disjoint and sorted,
+  // so their concatenation is in row key order. With unordered delivery
+  // all streams share a single queue.
+  bool const ordered = ordering_ == Ordering::kOrdered;
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::size_t const queue_count = ordered ? shards.size() : 1;
+  for (std::size_t i = 0; i != queue_count; ++i) {
+    queues.emplace_back(new Queue);
+  }
+
+  std::atomic<std::size_t> next_shard(0);
+  std::atomic<bool> failed(false);
+  std::mutex error_mu;
+  Status first_error;
+  auto record_error = [&](Status status) {
+    std::lock_guard<std::mutex> lk(error_mu);
+    if (first_error.ok()) {
+      first_error = std::move(status);
+    }
+    failed = true;
+  };
+  auto wake_all = [&queues] {
+    for (auto& queue : queues) {
+      std::lock_guard<std::mutex> lk(queue->mu);
+      queue->cv.notify_all();
+    }
+  };
+
+  std::size_t const stream_count =
+      (std::min)((std::max)(max_concurrent_streams_, std::size_t(1)),
+                 shards.size());
+  std::atomic<std::size_t> active_workers(stream_count);
+
+  auto worker = [&] {
+    while (!failed) {
+      std::size_t const index = next_shard.fetch_add(1);
+      if (index >= shards.size()) {
+        break;
+      }
+      auto& queue = *queues[ordered ? index : 0];
+      auto reader = table_.ReadRows(std::move(shards[index]), filter_);
+      for (auto& row : reader) {
+        if (!row) {
+          record_error(std::move(row).status());
+          break;
+        }
+        std::unique_lock<std::mutex> lk(queue.mu);
+        queue.cv.wait(lk, [&queue, &failed] {
+          return failed.load() || queue.rows.size() < kMaxBufferedRows;
+        });
+        if (failed) {
+          break;
+        }
+        queue.rows.emplace_back(*std::move(row));
+        queue.cv.notify_all();
+      }
+      if (ordered) {
+        std::lock_guard<std::mutex> lk(queue.mu);
+        queue.done = true;
+        queue.cv.notify_all();
+      }
+    }
+    if (--active_workers == 0 && !ordered) {
+      auto& queue = *queues[0];
+      std::lock_guard<std::mutex> lk(queue.mu);
+      queue.done = true;
+      queue.cv.notify_all();
+    }
+    if (failed) {
+      wake_all();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(stream_count);
+  for (std::size_t i = 0; i != stream_count; ++i) {
+    pool.emplace_back(worker);
+  }
+
+  for (auto& queue : queues) {
+    bool queue_done = false;
+    while (!queue_done && !failed) {
+      std::unique_lock<std::mutex> lk(queue->mu);
+      queue->cv.wait(lk, [&queue, &failed] {
+        return failed.load() || queue->done || !queue->rows.empty();
+      });
+      if (!queue->rows.empty()) {
+        Row row = std::move(queue->rows.front());
+        queue->rows.pop_front();
+        queue->cv.notify_all();
+        lk.unlock();
+        on_row(std::move(row));
+        continue;
+      }
+      queue_done = queue->done;
+    }
+    if (failed) {
+      break;
+    }
+  }
+
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  return first_error;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,105 @@
+// Copyright 2019 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
+
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Split @p row_set into disjoint shards at the boundaries in @p samples.
+ *
+ * The shards cover the whole of @p row_set, are sorted by row key, and
+ * never cross a sampled tablet boundary, so each shard can be scanned by
+ * an independent `ReadRows` stream. Shards that intersect @p row_set in
+ * nothing are dropped, and boundaries out of order or repeated in
+ * @p samples are ignored.
+ */
+std::vector<RowSet> PartitionRowSetAtSampleBoundaries(
+    RowSet const& row_set, std::vector<RowKeySample> const& samples);
+}  // namespace internal
+
+/**
+ * Scan a table using multiple parallel `ReadRows` streams.
+ *
+ * A single `Table::ReadRows()` stream is limited by the throughput of one
+ * tablet server. This class calls `Table::SampleRows()` to discover the
+ * tablet boundaries, partitions the requested `RowSet` at those
+ * boundaries, and scans the partitions with up to @p max_concurrent_streams
+ * concurrent streams. The streams are spread over the `DataClient`
+ * connection pool, so large scans are no longer bound by a single
+ * connection.
+ *
+ * Rows are always delivered on the thread calling `Scan()`. With
+ * `Ordering::kOrdered` the partitions are delivered in row key order, at
+ * the cost of buffering rows from partitions scanned ahead of the one
+ * being delivered. With `Ordering::kUnordered` rows are delivered as soon
+ * as any stream produces them.
+ */
+class ParallelRowReader {
+ public:
+  /// How rows are delivered to the application.
+  enum class Ordering {
+    /// Deliver rows as soon as any stream produces them.
+    kUnordered,
+    /// Deliver rows in row key order, merging the streams.
+    kOrdered,
+  };
+
+  ParallelRowReader(Table table, RowSet row_set, Filter filter,
+                    std::size_t max_concurrent_streams = 4,
+                    Ordering ordering = Ordering::kUnordered)
+      : table_(std::move(table)),
+        row_set_(std::move(row_set)),
+        filter_(std::move(filter)),
+        max_concurrent_streams_(max_concurrent_streams),
+        ordering_(ordering) {}
+
+  /**
+   * Scan the table, invoking @p on_row for each row.
+   *
+   * This call blocks until the scan completes or fails. @p on_row is
+   * always invoked from the calling thread, applications do not need to
+   * synchronize their row processing.
+   *
+   * @returns the first error reported by `Table::SampleRows()` or by any
+   *   of the streams. On error the remaining streams are stopped and some
+   *   rows may have been delivered already; this operation is read-only,
+   *   so the application can simply restart the scan.
+   */
+  Status Scan(std::function<void(Row)> const& on_row);
+
+ private:
+  Table table_;
+  RowSet row_set_;
+  Filter filter_;
+  std::size_t max_concurrent_streams_;
+  Ordering ordering_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
@@ -0,0 +1,217 @@
+// Copyright 2019 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/parallel_row_reader.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = ::google::bigtable::v2;
+using testing::_;
+using testing::DoAll;
+using testing::ElementsAre;
+using testing::Invoke;
+using testing::Return;
+using testing::SetArgPointee;
+using testing::UnorderedElementsAre;
+
+/// Define helper types and functions for this test.
+namespace {
+class ParallelRowReaderTest : public bigtable::testing::TableTestFixture {};
+using bigtable::testing::MockReadRowsReader;
+using bigtable::testing::MockSampleRowKeysReader;
+
+btproto::ReadRowsResponse ResponseWithRow(std::string const& row_key) {
+  return bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: ")" + row_key +
+                                                       R"("
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+}
+}  // anonymous namespace
+
+TEST(PartitionRowSetAtSampleBoundariesTest, FullTableScan) {
+  std::vector<bigtable::RowKeySample> samples{
+      {"k1", 100}, {"k2", 200}, {"", 300}};
+  auto shards = bigtable::internal::PartitionRowSetAtSampleBoundaries(
+      bigtable::RowSet(), samples);
+  ASSERT_EQ(3U, shards.size());
+  auto const& p0 = shards[0].as_proto();
+  ASSERT_EQ(1, p0.row_ranges_size());
+  EXPECT_EQ("", p0.row_ranges(0).start_key_closed());
+  EXPECT_EQ("k1", p0.row_ranges(0).end_key_open());
+  auto const& p1 = shards[1].as_proto();
+  ASSERT_EQ(1, p1.row_ranges_size());
+  EXPECT_EQ("k1", p1.row_ranges(0).start_key_closed());
+  EXPECT_EQ("k2", p1.row_ranges(0).end_key_open());
+  auto const& p2 = shards[2].as_proto();
+  ASSERT_EQ(1, p2.row_ranges_size());
+  EXPECT_EQ("k2", p2.row_ranges(0).start_key_closed());
+}
+
+TEST(PartitionRowSetAtSampleBoundariesTest, DropsShardsOutsideRowSet) {
+  std::vector<bigtable::RowKeySample> samples{{"m", 100}};
+  bigtable::RowSet row_set(bigtable::RowRange::RightOpen("a", "b"));
+  auto shards =
+      bigtable::internal::PartitionRowSetAtSampleBoundaries(row_set, samples);
+  ASSERT_EQ(1U, shards.size());
+  auto const& p0 = shards[0].as_proto();
+  ASSERT_EQ(1, p0.row_ranges_size());
+  EXPECT_EQ("a", p0.row_ranges(0).start_key_closed());
+  EXPECT_EQ("b", p0.row_ranges(0).end_key_open());
+}
+
+TEST(PartitionRowSetAtSampleBoundariesTest, IgnoresOutOfOrderSamples) {
+  std::vector<bigtable::RowKeySample> samples{
+      {"k2", 100}, {"k1", 200}, {"k2", 300}};
+  auto shards = bigtable::internal::PartitionRowSetAtSampleBoundaries(
+      bigtable::RowSet(), samples);
+  ASSERT_EQ(2U, shards.size());
+  EXPECT_EQ("k2", shards[0].as_proto().row_ranges(0).end_key_open());
+  EXPECT_EQ("k2", shards[1].as_proto().row_ranges(0).start_key_closed());
+}
+
+TEST_F(ParallelRowReaderTest, OrderedScanDeliversRowsInOrder) {
+  auto* sample_reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(sample_reader->MakeMockReturner()));
+  EXPECT_CALL(*sample_reader, Read(_))
+      .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key("m");
+        r->set_offset_bytes(1024);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*sample_reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  // With a single stream the shards are scanned in order, so the streams
+  // can be paired with the expected shards deterministically.
+  auto* stream1 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream2 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream1->MakeMockReturner()))
+      .WillOnce(Invoke(stream2->MakeMockReturner()));
+  EXPECT_CALL(*stream1, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(ResponseWithRow("a1")), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream1, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*stream2, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(ResponseWithRow("x1")), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  bigtable::ParallelRowReader reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(), 1,
+      bigtable::ParallelRowReader::Ordering::kOrdered);
+  std::vector<std::string> keys;
+  auto status = reader.Scan([&keys](bigtable::Row row) {
+    keys.push_back(std::string(row.row_key()));
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(keys, ElementsAre("a1", "x1"));
+}
+
+TEST_F(ParallelRowReaderTest, UnorderedScanDeliversAllRows) {
+  auto* sample_reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(sample_reader->MakeMockReturner()));
+  EXPECT_CALL(*sample_reader, Read(_))
+      .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key("m");
+        r->set_offset_bytes(1024);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*sample_reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  // The two streams run concurrently, the pairing of streams to shards is
+  // not deterministic but the union of the delivered rows is.
+  auto* stream1 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream2 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream1->MakeMockReturner()))
+      .WillOnce(Invoke(stream2->MakeMockReturner()));
+  EXPECT_CALL(*stream1, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(ResponseWithRow("a1")), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream1, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*stream2, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(ResponseWithRow("x1")), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  bigtable::ParallelRowReader reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(), 2,
+      bigtable::ParallelRowReader::Ordering::kUnordered);
+  std::vector<std::string> keys;
+  auto status = reader.Scan([&keys](bigtable::Row row) {
+    keys.push_back(std::string(row.row_key()));
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(keys, UnorderedElementsAre("a1", "x1"));
+}
+
+TEST_F(ParallelRowReaderTest, SampleRowKeysFailurePropagates) {
+  auto* sample_reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(sample_reader->MakeMockReturner()));
+  EXPECT_CALL(*sample_reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*sample_reader, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+
+  bigtable::ParallelRowReader reader(table_, bigtable::RowSet(),
+                                     bigtable::Filter::PassAllFilter());
+  auto status = reader.Scan([](bigtable::Row) {});
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+}
+
+TEST_F(ParallelRowReaderTest, StreamFailurePropagates) {
+  auto* sample_reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(sample_reader->MakeMockReturner()));
+  EXPECT_CALL(*sample_reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*sample_reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto* stream =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+
+  bigtable::ParallelRowReader reader(table_, bigtable::RowSet(),
+                                     bigtable::Filter::PassAllFilter());
+  auto status = reader.Scan([](bigtable::Row) {});
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/polling_policy.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -23,6 +24,80 @@ std::unique_ptr<PollingPolicy> DefaultPollingPolicy(
   return std::unique_ptr<PollingPolicy>(new GenericPollingPolicy<>(defaults));
 }
 
+AdaptivePollingPolicy::AdaptivePollingPolicy(
+    internal::RPCPolicyParameters defaults)
+    : AdaptivePollingPolicy(std::chrono::milliseconds(10),
+                            defaults.maximum_delay,
+                            defaults.maximum_retry_period, 5) {}
+
+AdaptivePollingPolicy::AdaptivePollingPolicy(
+    std::chrono::milliseconds initial_delay,
+    std::chrono::milliseconds maximum_delay,
+    std::chrono::milliseconds maximum_poll_time, int tight_probe_count)
+    : initial_delay_(initial_delay),
+      maximum_delay_(maximum_delay),
+      maximum_poll_time_(maximum_poll_time),
+      tight_probe_count_(tight_probe_count),
+      shared_(std::make_shared<SharedState>()),
+      deadline_(std::chrono::steady_clock::now() + maximum_poll_time),
+      current_delay_(initial_delay) {}
+
+std::unique_ptr<PollingPolicy> AdaptivePollingPolicy::clone() const {
+  std::unique_ptr<AdaptivePollingPolicy> copy(new AdaptivePollingPolicy(
+      initial_delay_, maximum_delay_, maximum_poll_time_, tight_probe_count_));
+  // The clone starts a new call with fresh per-call state, but shares the
+  // convergence estimate with the policy it was cloned from.
+  copy->shared_ = shared_;
+  return std::unique_ptr<PollingPolicy>(std::move(copy));
+}
+
+void AdaptivePollingPolicy::Setup(grpc::ClientContext&) {}
+
+bool AdaptivePollingPolicy::IsPermanentError(
+    google::cloud::Status const& status) {
+  return RPCRetryPolicy::IsPermanentFailure(status);
+}
+
+bool AdaptivePollingPolicy::OnFailure(google::cloud::Status const& status) {
+  if (IsPermanentError(status)) {
+    return false;
+  }
+  return !Exhausted();
+}
+
+bool AdaptivePollingPolicy::Exhausted() {
+  return std::chrono::steady_clock::now() >= deadline_;
+}
+
+std::chrono::milliseconds AdaptivePollingPolicy::WaitPeriod() {
+  ++wait_count_;
+  if (wait_count_ == 1) {
+    std::lock_guard<std::mutex> lk(shared_->mu);
+    if (shared_->has_estimate) {
+      // Schedule the first re-probe just before convergence is expected.
+      auto seed = shared_->estimate / 2;
+      return (std::max)(initial_delay_, (std::min)(seed, maximum_delay_));
+    }
+    return initial_delay_;
+  }
+  if (wait_count_ <= tight_probe_count_) {
+    return initial_delay_;
+  }
+  // The tight probes failed, this operation converges slowly; back off.
+  current_delay_ = (std::min)(current_delay_ * 2, maximum_delay_);
+  return current_delay_;
+}
+
+void AdaptivePollingPolicy::OnSuccess(std::chrono::milliseconds elapsed) {
+  std::lock_guard<std::mutex> lk(shared_->mu);
+  if (!shared_->has_estimate) {
+    shared_->has_estimate = true;
+    shared_->estimate = elapsed;
+    return;
+  }
+  shared_->estimate = (shared_->estimate * 3 + elapsed) / 4;
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -20,6 +20,9 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -86,6 +89,20 @@ class PollingPolicy {
    * Return for how long we should wait before trying again.
    */
   virtual std::chrono::milliseconds WaitPeriod() = 0;
+
+  /**
+   * Hook invoked when the polled operation completes successfully.
+   *
+   * @param elapsed the time from the first poll to the one that observed
+   *     success.
+   *
+   * The default implementation does nothing. Adaptive policies use the
+   * observation to seed the schedule of later calls, see
+   * `AdaptivePollingPolicy`.
+   */
+  virtual void OnSuccess(std::chrono::milliseconds elapsed) {
+    (void)elapsed;
+  }
 };
 
 /**
@@ -142,6 +159,79 @@ class GenericPollingPolicy : public PollingPolicy {
   Backoff rpc_backoff_policy_;
 };
 
+/**
+ * A polling schedule tuned for operations that converge quickly.
+ *
+ * `GenericPollingPolicy` backs off exponentially from the first poll, so
+ * operations that converge quickly — replication typically catches up with
+ * a consistency token within a few hundred milliseconds — are discovered
+ * seconds late. This policy probes tightly at first and starts backing off
+ * only after the early probes fail.
+ *
+ * All clones of the same policy share an estimate of the observed
+ * convergence time, an exponentially-weighted moving average updated
+ * through `OnSuccess()`. Once an estimate is available the first wait of a
+ * new call is scheduled at half the estimate (clamped to the configured
+ * delay range), so a post-bulk-load barrier releases shortly after
+ * consistency is reached instead of at the next exponential step. The
+ * estimate aggregates every operation polled with this policy; workloads
+ * with very different convergence profiles (e.g. bulk loads into different
+ * tables) keep their estimates separate by using separate policy instances.
+ */
+class AdaptivePollingPolicy : public PollingPolicy {
+ public:
+  /**
+   * Create a policy from the default table admin limits.
+   *
+   * The tight probe delay defaults to 10ms with 5 tight probes; the
+   * maximum delay and total polling time are taken from @p defaults.
+   */
+  explicit AdaptivePollingPolicy(internal::RPCPolicyParameters defaults);
+
+  /**
+   * Create a policy with full control over the schedule.
+   *
+   * @param initial_delay the delay between the tight initial probes.
+   * @param maximum_delay the backoff ceiling after the tight probes fail.
+   * @param maximum_poll_time how long to poll before giving up.
+   * @param tight_probe_count the number of probes issued at
+   *     @p initial_delay before the policy starts doubling the delay.
+   */
+  AdaptivePollingPolicy(std::chrono::milliseconds initial_delay,
+                        std::chrono::milliseconds maximum_delay,
+                        std::chrono::milliseconds maximum_poll_time,
+                        int tight_probe_count);
+
+  std::unique_ptr<PollingPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) override;
+  bool IsPermanentError(google::cloud::Status const& status) override;
+  bool OnFailure(google::cloud::Status const& status) override;
+  bool Exhausted() override;
+  std::chrono::milliseconds WaitPeriod() override;
+  void OnSuccess(std::chrono::milliseconds elapsed) override;
+
+ private:
+  /// The convergence estimate shared by all clones of the same policy.
+  struct SharedState {
+    std::mutex mu;
+    bool has_estimate = false;
+    std::chrono::milliseconds estimate{0};
+  };
+
+  std::chrono::milliseconds initial_delay_;
+  std::chrono::milliseconds maximum_delay_;
+  std::chrono::milliseconds maximum_poll_time_;
+  int tight_probe_count_;
+  std::shared_ptr<SharedState> shared_;
+
+  //@{
+  /// @name Per-call state, reset by `clone()`.
+  std::chrono::steady_clock::time_point deadline_;
+  std::chrono::milliseconds current_delay_;
+  int wait_count_ = 0;
+  //@}
+};
+
 std::unique_ptr<PollingPolicy> DefaultPollingPolicy(
     internal::RPCPolicyParameters defaults);
 
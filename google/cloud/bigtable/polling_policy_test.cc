@@ -18,6 +18,7 @@
 #include "google/cloud/testing_util/check_predicate_becomes_false.h"
 #include "google/cloud/testing_util/chrono_literals.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -93,6 +94,66 @@ TEST(GenericPollingPolicy, IsPermanentError) {
       grpc::Status(grpc::StatusCode::UNAVAILABLE, "")));
 }
 
+/// @test Verify the tight initial probes and the later backoff.
+TEST(AdaptivePollingPolicy, TightProbesThenBackoff) {
+  AdaptivePollingPolicy tested(10_ms, 500_ms, std::chrono::minutes(1), 3);
+  EXPECT_EQ(10_ms, tested.WaitPeriod());
+  EXPECT_EQ(10_ms, tested.WaitPeriod());
+  EXPECT_EQ(10_ms, tested.WaitPeriod());
+  EXPECT_EQ(20_ms, tested.WaitPeriod());
+  EXPECT_EQ(40_ms, tested.WaitPeriod());
+  auto delay = tested.WaitPeriod();
+  while (delay < 500_ms) {
+    auto next = tested.WaitPeriod();
+    EXPECT_EQ((std::min)(2 * delay, std::chrono::milliseconds(500_ms)), next);
+    delay = next;
+  }
+  EXPECT_EQ(500_ms, tested.WaitPeriod());
+}
+
+/// @test Verify the first wait is seeded by the observed convergence time.
+TEST(AdaptivePollingPolicy, SeedsFirstWaitFromHistory) {
+  AdaptivePollingPolicy original(10_ms, 500_ms, std::chrono::minutes(1), 3);
+  original.OnSuccess(200_ms);
+  auto tested = original.clone();
+  EXPECT_EQ(100_ms, tested->WaitPeriod());
+  // The second wait returns to the tight probe schedule.
+  EXPECT_EQ(10_ms, tested->WaitPeriod());
+}
+
+/// @test Verify the estimate is shared across clones and clamped.
+TEST(AdaptivePollingPolicy, EstimateSharedAcrossClones) {
+  AdaptivePollingPolicy original(10_ms, 500_ms, std::chrono::minutes(1), 3);
+  auto c1 = original.clone();
+  c1->OnSuccess(std::chrono::seconds(10));
+  auto c2 = original.clone();
+  // Half of 10s exceeds the maximum delay, the seed is clamped.
+  EXPECT_EQ(500_ms, c2->WaitPeriod());
+}
+
+/// @test Verify the seed never drops below the tight probe delay.
+TEST(AdaptivePollingPolicy, SeedClampedToInitialDelay) {
+  AdaptivePollingPolicy original(10_ms, 500_ms, std::chrono::minutes(1), 3);
+  original.OnSuccess(2_ms);
+  auto tested = original.clone();
+  EXPECT_EQ(10_ms, tested->WaitPeriod());
+}
+
+/// @test Verify the policy stops polling after the configured time.
+TEST(AdaptivePollingPolicy, Simple) {
+  AdaptivePollingPolicy tested(1_ms, 10_ms, kLimitedTimeTestPeriod, 3);
+  CheckLimitedTime(tested);
+}
+
+/// @test Verify that non-retryable errors cause an immediate failure.
+TEST(AdaptivePollingPolicy, OnNonRetryable) {
+  AdaptivePollingPolicy tested(10_ms, 500_ms, std::chrono::minutes(1), 3);
+  EXPECT_FALSE(
+      static_cast<PollingPolicy&>(tested).OnFailure(CreatePermanentError()));
+  EXPECT_FALSE(
+      tested.OnFailure(MakeStatusFromRpcError(CreatePermanentError())));
+}
+
 }  // anonymous namespace
 }  // namespace bigtable
 }  // namespace cloud
@@ -0,0 +1,105 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_batcher.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+auto constexpr kDefaultMaxKeysPerBatch = 100;
+auto constexpr kDefaultBatchingDelayMilliseconds = 1;
+
+ReadBatcher::Options::Options()
+    : max_keys_per_batch(kDefaultMaxKeysPerBatch),
+      batching_delay(
+          std::chrono::milliseconds(kDefaultBatchingDelayMilliseconds)) {}
+
+future<StatusOr<std::pair<bool, Row>>> ReadBatcher::AsyncReadRow(
+    CompletionQueue& cq, std::string row_key) {
+  ReadPromise read_promise;
+  auto result = read_promise.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  bool const is_first_key = cur_batch_->promises.empty();
+  cur_batch_->promises[std::move(row_key)].emplace_back(
+      std::move(read_promise));
+  if (cur_batch_->promises.size() >= options_.max_keys_per_batch) {
+    auto batch = std::move(cur_batch_);
+    cur_batch_ = std::make_shared<Batch>();
+    lk.unlock();
+    Flush(cq, std::move(batch));
+    return result;
+  }
+  if (is_first_key) {
+    // Give other reads a chance to join this batch, then send it. If the
+    // batch fills up before the timer expires it is sent (and replaced)
+    // early, making the timer a no-op.
+    auto batch = cur_batch_;
+    lk.unlock();
+    cq.MakeRelativeTimer(options_.batching_delay)
+        .then([this, cq, batch](
+                  future<StatusOr<std::chrono::system_clock::time_point>>)
+                  mutable {
+          std::unique_lock<std::mutex> lk(mu_);
+          if (cur_batch_ != batch) {
+            return;
+          }
+          cur_batch_ = std::make_shared<Batch>();
+          lk.unlock();
+          Flush(cq, std::move(batch));
+        });
+    return result;
+  }
+  return result;
+}
+
+void ReadBatcher::Flush(CompletionQueue& cq, std::shared_ptr<Batch> batch) {
+  RowSet row_set;
+  for (auto const& kv : batch->promises) {
+    row_set.Append(kv.first);
+  }
+  table_.AsyncReadRows(
+      cq,
+      [batch](Row row) {
+        auto it = batch->promises.find(row.row_key());
+        if (it != batch->promises.end()) {
+          for (auto& p : it->second) {
+            p.set_value(std::make_pair(true, row));
+          }
+          batch->promises.erase(it);
+        }
+        return make_ready_future(true);
+      },
+      [batch](Status status) {
+        // The keys left over did not match a row; report them as missing,
+        // or report the stream failure for all of them.
+        for (auto& kv : batch->promises) {
+          for (auto& p : kv.second) {
+            if (status.ok()) {
+              p.set_value(std::make_pair(false, Row("", {})));
+            } else {
+              p.set_value(status);
+            }
+          }
+        }
+        batch->promises.clear();
+      },
+      std::move(row_set), filter_);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
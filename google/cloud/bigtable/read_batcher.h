@@ -0,0 +1,131 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Objects of this class pack point reads into shared `ReadRows` calls.
+ *
+ * Applications that read many specific rows, e.g. to serve a request that
+ * needs 50-500 keys, pay one RPC per row when using `Table::ReadRow()` or
+ * `Table::AsyncReadRow()`. This class coalesces such point reads: keys
+ * submitted close in time are grouped into a `RowSet` and fetched with a
+ * single `ReadRows` RPC, while each caller still gets a per-key future
+ * with the result for their row.
+ *
+ * A batch is sent when it reaches `Options::max_keys_per_batch` keys, or
+ * when `Options::batching_delay` elapses after its first key, whichever
+ * comes first. Latency for an individual read is therefore likely worse
+ * than `Table::AsyncReadRow()`, in exchange for far fewer RPCs.
+ *
+ * Applications must provide a `CompletionQueue` to (asynchronously) execute
+ * these operations. The application is responsible of executing the
+ * `CompletionQueue` event loop in one or more threads, and must keep the
+ * `ReadBatcher` alive until all returned futures are satisfied.
+ */
+class ReadBatcher {
+ public:
+  /// Configuration for `ReadBatcher`.
+  struct Options {
+    Options();
+
+    /// A single RPC will not read more keys than this.
+    Options& SetMaxKeysPerBatch(std::size_t max_keys_per_batch_arg) {
+      max_keys_per_batch = max_keys_per_batch_arg;
+      return *this;
+    }
+
+    /// A batch waits at most this long for more keys before it is sent.
+    Options& SetBatchingDelay(std::chrono::milliseconds batching_delay_arg) {
+      batching_delay = batching_delay_arg;
+      return *this;
+    }
+
+    std::size_t max_keys_per_batch;
+    std::chrono::milliseconds batching_delay;
+  };
+
+  /// All reads share @p filter, it is applied to each batched RPC.
+  explicit ReadBatcher(Table table, Filter filter, Options options = Options())
+      : table_(std::move(table)),
+        filter_(std::move(filter)),
+        options_(options),
+        cur_batch_(std::make_shared<Batch>()) {}
+
+  /**
+   * Asynchronously read a single row, coalesced with other reads.
+   *
+   * @param cq the completion queue that will execute the asynchronous
+   *    calls, the application must ensure that one or more threads are
+   *    blocked on `cq.Run()`.
+   * @param row_key the row to read.
+   *
+   * @return a future satisfied with `<false, Row>` if the row does not
+   *    exist, with `<true, Row>` if it does, or with an error `Status` if
+   *    the batched RPC failed after retries.
+   */
+  future<StatusOr<std::pair<bool, Row>>> AsyncReadRow(CompletionQueue& cq,
+                                                      std::string row_key);
+
+ private:
+  using ReadPromise = promise<StatusOr<std::pair<bool, Row>>>;
+
+  /**
+   * The reads accumulated for a single RPC.
+   *
+   * A batch is filled under the `ReadBatcher` lock, then handed over to
+   * `AsyncReadRows()` which invokes the callbacks serially, so the batch
+   * needs no separate synchronization.
+   */
+  struct Batch {
+    /// Maps each key to the promises of the reads waiting for it.
+    std::map<RowKeyType, std::vector<ReadPromise>> promises;
+  };
+
+  /// Send @p batch in one `ReadRows` RPC, called without the lock held.
+  void Flush(CompletionQueue& cq, std::shared_ptr<Batch> batch);
+
+  std::mutex mu_;
+  Table table_;
+  Filter filter_;
+  Options options_;
+
+  /// Currently constructed batch of reads.
+  std::shared_ptr<Batch> cur_batch_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_BATCHER_H
@@ -0,0 +1,204 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_batcher.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace ::testing;
+using namespace google::cloud::testing_util::chrono_literals;
+using bigtable::testing::MockClientAsyncReaderInterface;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+class ReadBatcherTest : public bigtable::testing::TableTestFixture {
+ protected:
+  ReadBatcherTest()
+      : cq_impl_(new bigtable::testing::MockCompletionQueue), cq_(cq_impl_) {}
+
+  /// Expect one ReadRows RPC asking for exactly @p expected_keys.
+  MockClientAsyncReaderInterface<btproto::ReadRowsResponse>& AddReader(
+      std::vector<std::string> expected_keys) {
+    readers_.emplace_back(
+        new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>);
+    auto& reader = *readers_.back();
+    // We can't move expected_keys into the lambda because of lack of
+    // generalized lambda capture in C++11, so let's share it instead.
+    auto expected_keys_ptr =
+        std::make_shared<std::vector<std::string>>(std::move(expected_keys));
+
+    EXPECT_CALL(*client_, PrepareAsyncReadRows(_, _, _))
+        .WillOnce(Invoke([&reader, expected_keys_ptr](
+                             grpc::ClientContext*,
+                             btproto::ReadRowsRequest const& r,
+                             grpc::CompletionQueue*) {
+          std::vector<std::string> keys(r.rows().row_keys().begin(),
+                                        r.rows().row_keys().end());
+          EXPECT_EQ(*expected_keys_ptr, keys);
+          return std::unique_ptr<
+              MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>(
+              &reader);
+        }));
+    EXPECT_CALL(reader, StartCall(_)).WillOnce(Invoke([this](void*) {
+      reader_started_ = true;
+    }));
+    return reader;
+  }
+
+  std::shared_ptr<bigtable::testing::MockCompletionQueue> cq_impl_;
+  bigtable::CompletionQueue cq_;
+  std::vector<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>*>
+      readers_;
+  bool reader_started_ = false;
+};
+
+btproto::ReadRowsResponse ResponseWithRow(std::string const& key) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+  response.mutable_chunks(0)->set_row_key(key);
+  return response;
+}
+
+/// @test Verify that reads submitted within the delay share one RPC.
+TEST_F(ReadBatcherTest, BatchedReadsShareOneRpc) {
+  auto& stream = AddReader({"r1", "r2"});
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        *r = ResponseWithRow("r1");
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}))
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  ReadBatcher batcher(table_, Filter::PassAllFilter());
+  auto fut1 = batcher.AsyncReadRow(cq_, "r1");
+  auto fut2 = batcher.AsyncReadRow(cq_, "r2");
+
+  // Neither read triggered an RPC yet, only the batching timer is pending.
+  EXPECT_FALSE(reader_started_);
+  ASSERT_EQ(1U, cq_impl_->size());
+
+  cq_impl_->SimulateCompletion(true);  // batching timer
+  EXPECT_TRUE(reader_started_);
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  cq_impl_->SimulateCompletion(true);  // Return data
+
+  auto row1 = fut1.get();
+  ASSERT_STATUS_OK(row1);
+  EXPECT_TRUE(row1->first);
+  EXPECT_EQ("r1", row1->second.row_key());
+  EXPECT_TRUE(Unsatisfied(fut2));
+
+  cq_impl_->SimulateCompletion(false);  // end of stream
+  cq_impl_->SimulateCompletion(true);   // Finish Finish()
+
+  // "r2" was not in the response, it is reported as missing.
+  auto row2 = fut2.get();
+  ASSERT_STATUS_OK(row2);
+  EXPECT_FALSE(row2->first);
+}
+
+/// @test Verify that a full batch is sent without waiting for the timer.
+TEST_F(ReadBatcherTest, FullBatchIsSentImmediately) {
+  auto& stream = AddReader({"r1", "r2"});
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        *r = ResponseWithRow("r1");
+        r->MergeFrom(ResponseWithRow("r2"));
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}))
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  ReadBatcher batcher(table_, Filter::PassAllFilter(),
+                      ReadBatcher::Options().SetMaxKeysPerBatch(2));
+  auto fut1 = batcher.AsyncReadRow(cq_, "r1");
+  EXPECT_FALSE(reader_started_);
+  auto fut2 = batcher.AsyncReadRow(cq_, "r2");
+  // The batch is full, the RPC started without waiting for the timer.
+  EXPECT_TRUE(reader_started_);
+
+  cq_impl_->SimulateCompletion(true);  // stale timer and Finish Start()
+  cq_impl_->SimulateCompletion(true);  // Return data
+  cq_impl_->SimulateCompletion(false);  // end of stream
+  cq_impl_->SimulateCompletion(true);   // Finish Finish()
+
+  auto row1 = fut1.get();
+  ASSERT_STATUS_OK(row1);
+  EXPECT_TRUE(row1->first);
+  EXPECT_EQ("r1", row1->second.row_key());
+  auto row2 = fut2.get();
+  ASSERT_STATUS_OK(row2);
+  EXPECT_TRUE(row2->first);
+  EXPECT_EQ("r2", row2->second.row_key());
+}
+
+/// @test Verify that a failed batch reports the error on every future.
+TEST_F(ReadBatcherTest, FailureIsReportedOnAllFutures) {
+  auto& stream = AddReader({"r1", "r2"});
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(stream, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh oh");
+      }));
+
+  ReadBatcher batcher(table_, Filter::PassAllFilter());
+  auto fut1 = batcher.AsyncReadRow(cq_, "r1");
+  auto fut2 = batcher.AsyncReadRow(cq_, "r2");
+
+  cq_impl_->SimulateCompletion(true);   // batching timer
+  cq_impl_->SimulateCompletion(true);   // Finish Start()
+  cq_impl_->SimulateCompletion(false);  // stream breaks
+  cq_impl_->SimulateCompletion(true);   // Finish Finish()
+
+  auto row1 = fut1.get();
+  EXPECT_FALSE(row1);
+  EXPECT_EQ(StatusCode::kPermissionDenied, row1.status().code());
+  auto row2 = fut2.get();
+  EXPECT_FALSE(row2);
+  EXPECT_EQ(StatusCode::kPermissionDenied, row2.status().code());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/cell.h"
 #include "google/cloud/bigtable/row_key.h"
 #include "google/cloud/bigtable/version.h"
+#include <memory>
 #include <vector>
 
 namespace google {
@@ -36,17 +37,29 @@ class Row {
   /// Create a row from a list of cells.
   template <typename T>
   Row(T&& row_key, std::vector<Cell> cells)
-      : row_key_(std::forward<T>(row_key)), cells_(std::move(cells)) {}
+      : row_key_(
+            std::make_shared<RowKeyType const>(std::forward<T>(row_key))),
+        cells_(std::move(cells)) {}
+
+  /**
+   * Create a row sharing ownership of its key.
+   *
+   * `RowReader` shares one immutable key buffer between the row and all its
+   * cells, avoiding a copy of the key per cell. The pointer must not be
+   * null.
+   */
+  Row(std::shared_ptr<RowKeyType const> row_key, std::vector<Cell> cells)
+      : row_key_(std::move(row_key)), cells_(std::move(cells)) {}
 
   /// Return the row key. The returned value is not valid
   /// after this object is deleted.
-  RowKeyType const& row_key() const { return row_key_; }
+  RowKeyType const& row_key() const { return *row_key_; }
 
   /// Return all cells.
   std::vector<Cell> const& cells() const { return cells_; }
 
  private:
-  RowKeyType row_key_;
+  std::shared_ptr<RowKeyType const> row_key_;
   std::vector<Cell> cells_;
 };
 
@@ -18,6 +18,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/log.h"
+#include <algorithm>
 #include <thread>
 
 namespace google {
@@ -91,8 +92,45 @@ RowReader::RowReader(
       parser_factory_(std::move(parser_factory)),
       stream_is_open_(false),
       operation_cancelled_(false),
-      processed_chunks_count_(0),
-      rows_count_(0) {}
+      request_prototype_is_ready_(false),
+      rows_count_(0),
+      prefetch_limit_(0),
+      relaxed_validation_(false),
+      abrupt_cancel_(false) {}
+
+RowReader::RowReader(
+    std::shared_ptr<DataClient> client, std::string app_profile_id,
+    std::string table_name, RowSet row_set, std::int64_t rows_limit,
+    Filter filter, std::shared_ptr<RPCRetryPolicy const> retry_prototype,
+    std::shared_ptr<RPCBackoffPolicy const> backoff_prototype,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+    : client_(std::move(client)),
+      app_profile_id_(std::move(app_profile_id)),
+      table_name_(std::move(table_name)),
+      row_set_(std::move(row_set)),
+      rows_limit_(rows_limit),
+      filter_(std::move(filter)),
+      retry_prototype_(std::move(retry_prototype)),
+      backoff_prototype_(std::move(backoff_prototype)),
+      metadata_update_policy_(std::move(metadata_update_policy)),
+      context_(),
+      parser_factory_(std::move(parser_factory)),
+      stream_is_open_(false),
+      operation_cancelled_(false),
+      request_prototype_is_ready_(false),
+      rows_count_(0),
+      prefetch_limit_(0),
+      relaxed_validation_(false),
+      abrupt_cancel_(false) {}
+
+void RowReader::EnsurePolicies() {
+  if (retry_policy_) {
+    return;
+  }
+  retry_policy_ = retry_prototype_->clone();
+  backoff_policy_ = backoff_prototype_->clone();
+}
 
 // The name must be all lowercase to work with range-for loops.
 RowReader::iterator RowReader::begin() {
@@ -103,43 +141,154 @@ RowReader::iterator RowReader::begin() {
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 RowReader::iterator RowReader::end() { return internal::RowReaderIterator(); }
 
+void RowReader::EnablePrefetch(std::size_t max_buffered_responses) {
+  prefetch_limit_ = (std::max)(max_buffered_responses, std::size_t(1));
+}
+
+void RowReader::EnableRelaxedValidation() { relaxed_validation_ = true; }
+
+void RowReader::EnableAbruptCancel() { abrupt_cancel_ = true; }
+
+void RowReader::EnableRowArena() {
+  // The arena is shared by the parsers of all the attempts, so the
+  // buffers of rows read before a retry stay valid.
+  row_arena_ = std::make_shared<internal::RowBufferArena>();
+}
+
 void RowReader::MakeRequest() {
-  response_ = {};
-  processed_chunks_count_ = 0;
+  // On a retry the prefetch thread of the failed stream may still be
+  // running, stop it before replacing the stream.
+  StopPrefetch();
 
-  google::bigtable::v2::ReadRowsRequest request;
-  request.set_table_name(table_name_);
-  request.set_app_profile_id(app_profile_id_);
+  // Clear() (vs. assigning a fresh message) keeps the repeated chunk
+  // capacity, the next stream parses its responses into recycled storage.
+  response_.Clear();
+
+  // The table name, profile, and filter do not change across attempts,
+  // nor across Restart() calls; convert them to a proto once and copy
+  // the cached prototype on later attempts, a message copy is cheaper
+  // than re-running the filter conversion.
+  if (!request_prototype_is_ready_) {
+    request_prototype_.set_table_name(table_name_);
+    request_prototype_.set_app_profile_id(app_profile_id_);
+    auto filter_proto = filter_.as_proto();
+    request_prototype_.mutable_filter()->Swap(&filter_proto);
+    request_prototype_is_ready_ = true;
+  }
+  google::bigtable::v2::ReadRowsRequest request = request_prototype_;
 
   auto row_set_proto = row_set_.as_proto();
   request.mutable_rows()->Swap(&row_set_proto);
 
-  auto filter_proto = filter_.as_proto();
-  request.mutable_filter()->Swap(&filter_proto);
-
   if (rows_limit_ != NO_ROWS_LIMIT) {
     request.set_rows_limit(rows_limit_ - rows_count_);
   }
 
   context_ = google::cloud::internal::make_unique<grpc::ClientContext>();
-  retry_policy_->Setup(*context_);
-  backoff_policy_->Setup(*context_);
+  (retry_policy_ ? *retry_policy_ : *retry_prototype_).Setup(*context_);
+  (backoff_policy_ ? *backoff_policy_ : *backoff_prototype_).Setup(*context_);
   metadata_update_policy_.Setup(*context_);
-  stream_ = client_->ReadRows(context_.get(), request);
+  // Reads are response-heavy: the request is tiny, so the size threshold
+  // does not apply, and the configured algorithm is set whenever the
+  // application asked for per-call compression.
+  auto const algorithm = client_->call_compression_algorithm();
+  if (algorithm != GRPC_COMPRESS_NONE) {
+    context_->set_compression_algorithm(algorithm);
+  }
+  // Scans ride the bulk lane so their large responses cannot
+  // head-of-line block point reads; without a configured bulk pool
+  // this falls back to the shared channels.
+  stream_ = client_->ReadRows(context_.get(), request, TrafficClass::kBulk);
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
+  if (row_arena_) {
+    parser_->SetArena(row_arena_);
+  }
+  if (relaxed_validation_) {
+    parser_->SetRelaxedValidation(true);
+  }
+
+  if (prefetch_limit_ > 0) {
+    StartPrefetch();
+  }
 }
 
-bool RowReader::NextChunk() {
-  ++processed_chunks_count_;
-  while (processed_chunks_count_ >= response_.chunks_size()) {
-    processed_chunks_count_ = 0;
-    bool response_is_valid = stream_->Read(&response_);
-    if (!response_is_valid) {
-      response_ = {};
-      return false;
+void RowReader::StartPrefetch() {
+  prefetch_ = google::cloud::internal::make_unique<PrefetchState>(
+      prefetch_limit_);
+  auto* state = prefetch_.get();
+  auto* stream = stream_.get();
+  state->reader = std::thread([state, stream] {
+    bool shutdown = false;
+    bool abandon = false;
+    google::bigtable::v2::ReadRowsResponse response;
+    while (stream->Read(&response)) {
+      std::unique_lock<std::mutex> lk(state->mu);
+      state->cv.wait(lk, [state] {
+        return state->shutdown || state->responses.size() < state->limit;
+      });
+      if (state->shutdown) {
+        shutdown = true;
+        abandon = state->abandon;
+        break;
+      }
+      state->responses.push(std::move(response));
+      state->cv.notify_all();
+    }
+    if (shutdown && !abandon) {
+      // Drain any responses left unread after the cancel, so that
+      // Finish() does not block.
+      while (stream->Read(&response)) {
+      }
     }
+    std::unique_lock<std::mutex> lk(state->mu);
+    state->done = true;
+    state->cv.notify_all();
+  });
+}
+
+void RowReader::StopPrefetch() {
+  if (!prefetch_) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lk(prefetch_->mu);
+    prefetch_->shutdown = true;
+    if (!prefetch_->done && context_) {
+      // Unblock the prefetch thread if it is waiting on the stream.
+      context_->TryCancel();
+    }
+    prefetch_->cv.notify_all();
+  }
+  if (prefetch_->reader.joinable()) {
+    prefetch_->reader.join();
+  }
+  prefetch_.reset();
+}
+
+bool RowReader::ReadResponse(google::bigtable::v2::ReadRowsResponse& response) {
+  if (!prefetch_) {
+    return stream_->Read(&response);
+  }
+  auto* state = prefetch_.get();
+  std::unique_lock<std::mutex> lk(state->mu);
+  state->cv.wait(
+      lk, [state] { return state->done || !state->responses.empty(); });
+  if (state->responses.empty()) {
+    return false;
+  }
+  response = std::move(state->responses.front());
+  state->responses.pop();
+  state->cv.notify_all();
+  return true;
+}
+
+bool RowReader::NextResponse() {
+  if (!ReadResponse(response_)) {
+    // Clear() keeps the chunk capacity for a retry or a Restart().
+    response_.Clear();
+    return false;
   }
   return true;
 }
@@ -175,6 +324,7 @@ StatusOr<internal::OptionalRow> RowReader::Advance() {
       return row;
     }
 
+    EnsurePolicies();
     if (!retry_policy_->OnFailure(status)) {
       return MakeStatusFromRpcError(status);
     }
@@ -187,6 +337,90 @@ StatusOr<internal::OptionalRow> RowReader::Advance() {
   }
 }
 
+Status RowReader::NextBatch(std::vector<Row>& rows) {
+  rows.clear();
+  if (operation_cancelled_) {
+    return Status(StatusCode::kCancelled, "Operation cancelled.");
+  }
+  while (true) {
+    grpc::Status status = NextBatchOrFail(rows);
+    if (status.ok()) {
+      return Status();
+    }
+
+    // The rows moved out before the failure are good, they were counted
+    // in `rows_count_` and `last_read_row_key_`, so the retry below only
+    // requests the rows that follow them.
+    if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+      return Status();
+    }
+
+    if (!last_read_row_key_.empty()) {
+      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+    }
+
+    // If we receive an error, but the retriable set is empty, stop.
+    if (row_set_.IsEmpty()) {
+      return Status();
+    }
+
+    EnsurePolicies();
+    if (!retry_policy_->OnFailure(status)) {
+      return MakeStatusFromRpcError(status);
+    }
+
+    auto delay = backoff_policy_->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
+
+    // If we reach this place, we failed and need to restart the call.
+    MakeRequest();
+  }
+}
+
+grpc::Status RowReader::NextBatchOrFail(std::vector<Row>& rows) {
+  grpc::Status status;
+  if (!stream_) {
+    MakeRequest();
+  }
+  while (true) {
+    if (parser_->HasNext()) {
+      Row parsed_row = parser_->Next(status);
+      if (!status.ok()) {
+        return status;
+      }
+      ++rows_count_;
+      last_read_row_key_ = std::string(parsed_row.row_key());
+      rows.emplace_back(std::move(parsed_row));
+      continue;
+    }
+
+    // Return a non-empty batch as soon as taking more rows would require
+    // another response from the stream.
+    if (!rows.empty()) {
+      return status;
+    }
+
+    if (NextResponse()) {
+      parser_->HandleResponse(std::move(response_), status);
+      if (!status.ok()) {
+        return status;
+      }
+      continue;
+    }
+
+    // No more chunks, close the stream and finalize the parser. An OK
+    // status with no rows tells the caller the stream is done.
+    StopPrefetch();
+    stream_is_open_ = false;
+    status = stream_->Finish();
+    if (!status.ok()) {
+      return status;
+    }
+    parser_->HandleEndOfStream(status);
+    return status;
+  }
+}
+
 grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   row.reset();
   grpc::Status status;
@@ -194,10 +428,8 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
     MakeRequest();
   }
   while (!parser_->HasNext()) {
-    if (NextChunk()) {
-      parser_->HandleChunk(
-          std::move(*(response_.mutable_chunks(processed_chunks_count_))),
-          status);
+    if (NextResponse()) {
+      parser_->HandleResponse(std::move(response_), status);
       if (!status.ok()) {
         return status;
       }
@@ -207,6 +439,7 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
     // Here, there are no more chunks to look at. Close the stream,
     // finalize the parser and return OK with no rows unless something
     // fails during cleanup.
+    StopPrefetch();
     stream_is_open_ = false;
     status = stream_->Finish();
     if (!status.ok()) {
@@ -228,6 +461,46 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   return status;
 }
 
+std::string RowReader::Checkpoint() const {
+  // A `ReadRowsRequest` already holds a row set and a rows-limit, reuse it
+  // as the serialization format instead of defining a new proto.
+  google::bigtable::v2::ReadRowsRequest checkpoint;
+  RowSet remaining = row_set_;
+  if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+    // The scan already returned all the requested rows.
+    remaining = RowSet(RowRange::Empty());
+  } else if (!last_read_row_key_.empty()) {
+    remaining = remaining.Intersect(RowRange::Open(last_read_row_key_, ""));
+  }
+  *checkpoint.mutable_rows() = std::move(remaining).as_proto();
+  if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ > rows_count_) {
+    checkpoint.set_rows_limit(rows_limit_ - rows_count_);
+  }
+  return checkpoint.SerializeAsString();
+}
+
+void RowReader::Restart(RowSet row_set, std::int64_t rows_limit,
+                        std::unique_ptr<RPCRetryPolicy> retry_policy,
+                        std::unique_ptr<RPCBackoffPolicy> backoff_policy) {
+  // Close the previous stream, if any; this also joins the prefetch
+  // thread and drains any data left unread.
+  Cancel();
+  row_set_ = std::move(row_set);
+  rows_limit_ = rows_limit;
+  retry_policy_ = std::move(retry_policy);
+  backoff_policy_ = std::move(backoff_policy);
+  // Drop the per-stream state so the next row request opens a new
+  // stream. The request prototype, the response message, and the arena
+  // are kept, reusing their storage is the point of restarting a reader
+  // instead of creating a new one.
+  stream_.reset();
+  parser_.reset();
+  context_.reset();
+  operation_cancelled_ = false;
+  rows_count_ = 0;
+  last_read_row_key_.clear();
+}
+
 void RowReader::Cancel() {
   operation_cancelled_ = true;
   if (!stream_is_open_) {
@@ -235,12 +508,25 @@ void RowReader::Cancel() {
   }
   context_->TryCancel();
 
-  // Also drain any data left unread
-  google::bigtable::v2::ReadRowsResponse response;
-  while (stream_->Read(&response)) {
+  if (prefetch_) {
+    if (abrupt_cancel_) {
+      // Tell the prefetch thread to exit without draining the stream.
+      std::unique_lock<std::mutex> lk(prefetch_->mu);
+      prefetch_->abandon = true;
+    }
+    // The prefetch thread drains the stream before exiting, unless the
+    // reader is in abrupt-cancel mode.
+    StopPrefetch();
+  } else if (!abrupt_cancel_) {
+    // Also drain any data left unread
+    google::bigtable::v2::ReadRowsResponse response;
+    while (stream_->Read(&response)) {
+    }
   }
 
   stream_is_open_ = false;
+  // With the context cancelled this completes promptly, even when the
+  // buffered responses were discarded unread.
   (void)stream_->Finish();  // ignore errors
 }
 
@@ -28,7 +28,13 @@
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
+#include <condition_variable>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -63,6 +69,22 @@ class RowReader {
             MetadataUpdatePolicy metadata_update_policy,
             std::unique_ptr<internal::ReadRowsParserFactory> parser_factory);
 
+  /**
+   * Create a reader that clones its policies lazily.
+   *
+   * The policies only change state when an attempt fails (`Setup()` is
+   * `const`), so the reader shares the immutable prototypes and clones
+   * its per-call policy state on the first failure. A scan that never
+   * fails performs no policy allocations.
+   */
+  RowReader(std::shared_ptr<DataClient> client, std::string app_profile_id,
+            std::string table_name, RowSet row_set, std::int64_t rows_limit,
+            Filter filter,
+            std::shared_ptr<RPCRetryPolicy const> retry_prototype,
+            std::shared_ptr<RPCBackoffPolicy const> backoff_prototype,
+            MetadataUpdatePolicy metadata_update_policy,
+            std::unique_ptr<internal::ReadRowsParserFactory> parser_factory);
+
   RowReader(RowReader&&) noexcept = default;
 
   ~RowReader();
@@ -90,6 +112,21 @@ class RowReader {
   /// End iterator over the rows in the response.
   iterator end();
 
+  /**
+   * Move all parsed-and-ready rows into @p rows in one call.
+   *
+   * Fills @p rows (after clearing it) with every row that can be taken
+   * without reading another response from the stream, blocking only while
+   * no row is ready yet. An empty @p rows on an OK return means the
+   * stream completed. This amortizes the per-row iterator, `optional`,
+   * and `StatusOr` overhead of `begin()` over a whole response worth of
+   * rows; do not mix calls to this function with iterator-based reads on
+   * the same `RowReader`.
+   *
+   * Retry and backoff policies are honored.
+   */
+  Status NextBatch(std::vector<Row>& rows);
+
   /**
    * Gracefully terminate a streaming read.
    *
@@ -97,7 +134,119 @@ class RowReader {
    */
   void Cancel();
 
+  /**
+   * Read responses ahead of the application on a background thread.
+   *
+   * By default the next `ReadRowsResponse` is pulled from the stream only
+   * when the application asks for the next row, so the server stalls
+   * whenever processing a row takes longer than a network round trip. With
+   * prefetching enabled a background thread drains the stream into a
+   * bounded buffer of up to @p max_buffered_responses responses while the
+   * application consumes rows, decoupling network reads from row
+   * processing.
+   *
+   * Must be called before `begin()`.
+   */
+  void EnablePrefetch(std::size_t max_buffered_responses = 8);
+
+  /**
+   * Batch the allocation of the shared row key, family, and column
+   * buffers through a per-reader arena.
+   *
+   * The arena packs the buffers of many rows into generations that share
+   * a single control block, cutting the allocations per row during large
+   * scans. The trade-off is retention: an arena generation (64 KiB of
+   * buffer data) stays alive while any cell of any row references it, so
+   * applications that keep a few cells from many rows for a long time
+   * should not enable this.
+   *
+   * Must be called before `begin()`.
+   */
+  void EnableRowArena();
+
+  /**
+   * Skip the redundant per-chunk consistency checks for trusted servers.
+   *
+   * The parser validates row-key ordering and chunk continuation rules on
+   * every chunk; for servers that are trusted to produce valid streams
+   * these checks are pure overhead. With relaxed validation only the
+   * checks needed for correct reassembly remain. The full checks always
+   * stay enabled in debug builds (`NDEBUG` not defined).
+   *
+   * Must be called before `begin()`.
+   */
+  void EnableRelaxedValidation();
+
+  /**
+   * Abandon the stream on `Cancel()` instead of draining it.
+   *
+   * By default `Cancel()` (and the destructor) consumes the responses
+   * buffered by gRPC before calling `Finish()`, so an early break out of
+   * a scan still pays for the data in flight. With abrupt cancel the
+   * stream is cancelled via `grpc::ClientContext::TryCancel()` and the
+   * buffered responses are discarded unread; `Finish()` is still called,
+   * after the cancel it completes promptly with `CANCELLED`. Use this
+   * for existence checks and prefix probes over large ranges, where the
+   * scan stops after the first row.
+   */
+  void EnableAbruptCancel();
+
+  /**
+   * Return an opaque checkpoint from which the scan can be resumed.
+   *
+   * The checkpoint captures the rows not returned yet, including the
+   * remaining rows-limit. It can be persisted and later passed to
+   * `Table::ResumeScan()`, possibly in a different process, to continue
+   * the scan without rescanning the rows already returned.
+   *
+   * Call this between iterator increments, the rows returned so far are
+   * excluded from the checkpoint.
+   */
+  std::string Checkpoint() const;
+
+  /**
+   * Reuse this reader for a new scan over the same table and filter.
+   *
+   * gRPC requires a fresh `grpc::ClientContext` and call object for every
+   * RPC, so each scan still opens a new stream. What a restarted reader
+   * does reuse is everything around the stream: the cached request
+   * prototype (the filter is converted to a proto only once), the
+   * response message with its accumulated chunk capacity, the parser
+   * factory, and the row arena if one is enabled. For applications that
+   * issue many small scans against the same hot tablets this removes
+   * most of the per-call allocation; see also `Table::RestartScan()`.
+   *
+   * The previous scan is cancelled if it has not finished. Invalidates
+   * iterators, call `begin()` again to consume the new scan.
+   *
+   * @param row_set the rows to read in the new scan.
+   * @param rows_limit the limit for the new scan, zero means "no limit".
+   * @param retry_policy a policy for the new scan, the policy passed to
+   *     the constructor was (partially) consumed by the previous scan.
+   * @param backoff_policy see @p retry_policy.
+   */
+  void Restart(RowSet row_set, std::int64_t rows_limit,
+               std::unique_ptr<RPCRetryPolicy> retry_policy,
+               std::unique_ptr<RPCBackoffPolicy> backoff_policy);
+
  private:
+  /// State shared with the prefetch thread, see EnablePrefetch().
+  struct PrefetchState {
+    explicit PrefetchState(std::size_t l) : limit(l) {}
+
+    std::size_t const limit;
+    std::mutex mu;
+    std::condition_variable cv;
+    std::queue<google::bigtable::v2::ReadRowsResponse> responses;
+    /// The prefetch thread exhausted the stream and exited.
+    bool done = false;
+    /// The consumer asked the prefetch thread to stop early.
+    bool shutdown = false;
+    /// Skip the post-shutdown drain, see EnableAbruptCancel().
+    bool abandon = false;
+    std::thread reader;
+  };
+
   /**
    * Read and parse the next row in the response.
    *
@@ -111,30 +260,50 @@ class RowReader {
   /// Called by Advance(), does not handle retries.
   grpc::Status AdvanceOrFail(internal::OptionalRow& row);
 
+  /// Called by NextBatch(), does not handle retries.
+  grpc::Status NextBatchOrFail(std::vector<Row>& rows);
+
   /**
-   * Move the `processed_chunks_count_` index to the next chunk,
-   * reading data if needed.
+   * Read the next response into `response_`.
    *
-   * Returns false if no more chunks are available.
-   *
-   * This call is used internally by AdvanceOrFail to prepare data for
-   * parsing. When it returns true, the value of
-   * `response_.chunks(processed_chunks_count_)` is valid and holds
-   * the next chunk to parse.
+   * Returns false if the stream has no more responses. When it returns
+   * true, `response_` holds the next response to hand to the parser.
    */
-  bool NextChunk();
+  bool NextResponse();
 
   /// Sends the ReadRows request to the stub.
   void MakeRequest();
 
+  /// Start the prefetch thread for the current stream, if enabled.
+  void StartPrefetch();
+
+  /// Stop and join the prefetch thread, if one is running.
+  void StopPrefetch();
+
+  /// Read the next response from the prefetch buffer or the stream.
+  bool ReadResponse(google::bigtable::v2::ReadRowsResponse& response);
+
+  /// Clone the per-call policy state from the prototypes, if not done yet.
+  void EnsurePolicies();
+
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
   RowSet row_set_;
   std::int64_t rows_limit_;
   Filter filter_;
+  /**
+   * The per-call policy state.
+   *
+   * Null until the first failure when the reader was constructed from
+   * policy prototypes, `EnsurePolicies()` clones them on demand.
+   */
   std::unique_ptr<RPCRetryPolicy> retry_policy_;
   std::unique_ptr<RPCBackoffPolicy> backoff_policy_;
+  /// The shared immutable policy configuration, null when the reader was
+  /// constructed with ready-made policy clones.
+  std::shared_ptr<RPCRetryPolicy const> retry_prototype_;
+  std::shared_ptr<RPCBackoffPolicy const> backoff_prototype_;
   MetadataUpdatePolicy metadata_update_policy_;
 
   std::unique_ptr<grpc::ClientContext> context_;
@@ -147,15 +316,30 @@ class RowReader {
   bool stream_is_open_;
   bool operation_cancelled_;
 
-  /// The last received response, chunks are being parsed one by one from it.
+  /// The last received response, handed to the parser whole.
   google::bigtable::v2::ReadRowsResponse response_;
-  /// Number of chunks already parsed in response_.
-  int processed_chunks_count_;
+  /// Caches the request fields that repeat on every attempt, see
+  /// MakeRequest().
+  google::bigtable::v2::ReadRowsRequest request_prototype_;
+  /// The first MakeRequest() call filled in `request_prototype_`.
+  bool request_prototype_is_ready_;
 
   /// Number of rows read so far, used to set row_limit in retries.
   std::int64_t rows_count_;
   /// Holds the last read row key, for retries.
   RowKeyType last_read_row_key_;
+
+  /// Batches the parser buffer allocations, null unless enabled.
+  std::shared_ptr<internal::RowBufferArena> row_arena_;
+
+  /// Maximum number of prefetched responses, zero disables prefetching.
+  std::size_t prefetch_limit_;
+  /// Skip redundant chunk validation, see EnableRelaxedValidation().
+  bool relaxed_validation_;
+  /// Discard buffered responses on Cancel(), see EnableAbruptCancel().
+  bool abrupt_cancel_;
+  /// Shared with the prefetch thread, null when no thread is running.
+  std::unique_ptr<PrefetchState> prefetch_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
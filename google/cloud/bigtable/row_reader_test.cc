@@ -52,6 +52,18 @@ class ReadRowsParserMock : public bigtable::internal::ReadRowsParser {
     HandleChunkHook(chunk, status);
   }
 
+  // The mock bypasses the real per-chunk loop, expectations stay on the
+  // per-chunk hook.
+  void HandleResponse(ReadRowsResponse&& response,
+                      grpc::Status& status) override {
+    for (auto& chunk : *response.mutable_chunks()) {
+      HandleChunkHook(chunk, status);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
+
   MOCK_METHOD1(HandleEndOfStreamHook, void(grpc::Status& status));
   void HandleEndOfStream(grpc::Status& status) override {
     HandleEndOfStreamHook(status);
@@ -313,6 +325,111 @@ TEST_F(RowReaderTest, ReadOneOfTwoRowsClosesStream) {
   // and the previously setup expectations on the mock `stream` check that.
 }
 
+TEST_F(RowReaderTest, PrefetchReadOneRow) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  EXPECT_CALL(*parser, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  reader.EnablePrefetch();
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_EQ(++it, reader.end());
+}
+
+TEST_F(RowReaderTest, PrefetchReadOneOfTwoRowsClosesStream) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  reader.EnablePrefetch();
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_NE(it, reader.end());
+  // Do not finish the iteration.  We still expect the stream to be finalized,
+  // and the previously setup expectations on the mock `stream` check that.
+}
+
+TEST_F(RowReaderTest, PrefetchFailedStreamIsRetried) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "retry")));
+
+    EXPECT_CALL(*retry_policy_, OnFailureHook(_)).WillOnce(Return(true));
+    EXPECT_CALL(*backoff_policy_, OnCompletionHook(_))
+        .WillOnce(Return(std::chrono::milliseconds(0)));
+
+    // the stub will free it
+    auto* stream_retry =
+        new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream_retry->MakeMockReturner()));
+    EXPECT_CALL(*stream_retry, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream_retry, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  reader.EnablePrefetch();
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_EQ(++it, reader.end());
+}
+
 TEST_F(RowReaderTest, FailedStreamIsRetried) {
   // wrapped in unique_ptr by ReadRows
   auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
@@ -710,6 +827,41 @@ TEST_F(RowReaderTest, BeginThrowsAfterCancelClosesStreamNoExcept) {
   EXPECT_FALSE(*it);
 }
 
+TEST_F(RowReaderTest, AbruptCancelSkipsStreamDrain) {
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    // Note there are no further Read() expectations: an abrupt cancel
+    // must not drain the buffered responses before Finish().
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(
+            grpc::Status(grpc::StatusCode::CANCELLED, "call cancelled")));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  reader.EnableAbruptCancel();
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  // Found the row we wanted, abandon the rest of the stream.
+  reader.Cancel();
+  it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  EXPECT_FALSE(*it);
+}
+
 TEST_F(RowReaderTest, BeginThrowsAfterImmediateCancelNoExcept) {
   auto backend =
       std::make_shared<google::cloud::testing_util::CaptureLogLinesBackend>();
@@ -745,6 +897,158 @@ TEST_F(RowReaderTest, BeginThrowsAfterImmediateCancelNoExcept) {
                       << backend->log_lines.front();
 }
 
+TEST_F(RowReaderTest, CheckpointBeforeReadingIsWholeRowSet) {
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  ReadRowsRequest checkpoint;
+  ASSERT_TRUE(checkpoint.ParseFromString(reader.Checkpoint()));
+  EXPECT_EQ(0, checkpoint.rows().row_keys_size());
+  EXPECT_EQ(0, checkpoint.rows().row_ranges_size());
+  EXPECT_EQ(0, checkpoint.rows_limit());
+}
+
+TEST_F(RowReaderTest, CheckpointExcludesRowsAlreadyRead) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), 10, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+
+  ReadRowsRequest checkpoint;
+  ASSERT_TRUE(checkpoint.ParseFromString(reader.Checkpoint()));
+  EXPECT_EQ(9, checkpoint.rows_limit());
+  ASSERT_EQ(1, checkpoint.rows().row_ranges_size());
+  EXPECT_EQ("r1", checkpoint.rows().row_ranges(0).start_key_open());
+  // Do not finish the iteration.  We still expect the stream to be finalized,
+  // and the previously setup expectations on the mock `stream` check that.
+}
+
+TEST_F(RowReaderTest, RestartReusesReaderForNewScan) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream1 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream2 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser1 = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser1->SetRows({"r1"});
+  EXPECT_CALL(*parser1, HandleEndOfStreamHook(_)).Times(1);
+  auto parser2 = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser2->SetRows({"r2"});
+  EXPECT_CALL(*parser2, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(1)))
+        .WillOnce(Invoke(stream1->MakeMockReturner()));
+    EXPECT_CALL(*stream1, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream1, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream1, Finish()).WillOnce(Return(grpc::Status::OK));
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(2)))
+        .WillOnce(Invoke(stream2->MakeMockReturner()));
+    EXPECT_CALL(*stream2, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream2, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream2, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser1));
+  parser_factory_->AddParser(std::move(parser2));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet("r1"), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_EQ(++it, reader.end());
+
+  reader.Restart(
+      bigtable::RowSet("r2", "r3"), bigtable::RowReader::NO_ROWS_LIMIT,
+      std::unique_ptr<bigtable::RPCRetryPolicy>(new RetryPolicyMock),
+      std::unique_ptr<bigtable::RPCBackoffPolicy>(new BackoffPolicyMock));
+
+  it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r2");
+  EXPECT_EQ(++it, reader.end());
+}
+
+TEST_F(RowReaderTest, RestartResetsTheRowsLimit) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream1 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream2 =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser1 = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser1->SetRows({"r1"});
+  EXPECT_CALL(*parser1, HandleEndOfStreamHook(_)).Times(1);
+  auto parser2 = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser2->SetRows({"r2"});
+  EXPECT_CALL(*parser2, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowsLimit(7)))
+        .WillOnce(Invoke(stream1->MakeMockReturner()));
+    EXPECT_CALL(*stream1, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream1, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream1, Finish()).WillOnce(Return(grpc::Status::OK));
+    // The row read in the first scan must not be subtracted from the
+    // limit of the restarted scan.
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowsLimit(5)))
+        .WillOnce(Invoke(stream2->MakeMockReturner()));
+    EXPECT_CALL(*stream2, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream2, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream2, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser1));
+  parser_factory_->AddParser(std::move(parser2));
+  bigtable::RowReader reader(client_, "", bigtable::RowSet(), 7,
+                             bigtable::Filter::PassAllFilter(),
+                             std::move(retry_policy_),
+                             std::move(backoff_policy_),
+                             metadata_update_policy_,
+                             std::move(parser_factory_));
+
+  auto it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_EQ(++it, reader.end());
+
+  reader.Restart(
+      bigtable::RowSet(), 5,
+      std::unique_ptr<bigtable::RPCRetryPolicy>(new RetryPolicyMock),
+      std::unique_ptr<bigtable::RPCBackoffPolicy>(new BackoffPolicyMock));
+
+  it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r2");
+  EXPECT_EQ(++it, reader.end());
+}
+
 TEST_F(RowReaderTest, RowReaderConstructorDoesNotCallRpc) {
   // The RowReader constructor/destructor by themselves should not
   // invoke the RPC or create parsers (the latter restriction because
@@ -812,3 +1116,80 @@ TEST_F(RowReaderTest, FailedStreamRetryNewContext) {
   EXPECT_EQ((*it)->row_key(), "r1");
   EXPECT_EQ(++it, reader.end());
 }
+
+TEST_F(RowReaderTest, NextBatchReturnsAllReadyRows) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2"});
+  EXPECT_CALL(*parser, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  // Both preloaded rows come back in a single call.
+  std::vector<bigtable::Row> batch;
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  ASSERT_EQ(2U, batch.size());
+  EXPECT_EQ("r1", batch[0].row_key());
+  EXPECT_EQ("r2", batch[1].row_key());
+
+  // The next call drains the stream and reports the end with no rows.
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST_F(RowReaderTest, NextBatchFailedStreamIsRetried) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "retry")));
+
+    EXPECT_CALL(*retry_policy_, OnFailureHook(_)).WillOnce(Return(true));
+    EXPECT_CALL(*backoff_policy_, OnCompletionHook(_))
+        .WillOnce(Return(std::chrono::milliseconds(0)));
+
+    // the stub will free it
+    auto* stream_retry =
+        new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream_retry->MakeMockReturner()));
+    EXPECT_CALL(*stream_retry, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream_retry, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  std::vector<bigtable::Row> batch;
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  ASSERT_EQ(1U, batch.size());
+  EXPECT_EQ("r1", batch[0].row_key());
+
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+}
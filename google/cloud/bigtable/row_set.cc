@@ -13,26 +13,183 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/row_set.h"
+#include <algorithm>
+
+namespace btproto = ::google::bigtable::v2;
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// The helpers below compare the bounds of `btproto::RowRange` messages.
+// A start bound is (key, open-vs-closed), where an unset start is the
+// same as a closed "" start (both match from the first row).  An unset
+// end bound is larger than any other end bound.  At the same key a
+// closed start sorts before an open start, and an open end sorts before
+// a closed end.
+std::string const& StartKey(btproto::RowRange const& r) {
+  static std::string const empty;
+  if (r.start_key_case() == btproto::RowRange::kStartKeyClosed) {
+    return r.start_key_closed();
+  }
+  if (r.start_key_case() == btproto::RowRange::kStartKeyOpen) {
+    return r.start_key_open();
+  }
+  return empty;
+}
+
+bool StartIsOpen(btproto::RowRange const& r) {
+  return r.start_key_case() == btproto::RowRange::kStartKeyOpen;
+}
+
+bool EndIsUnbounded(btproto::RowRange const& r) {
+  return r.end_key_case() == btproto::RowRange::END_KEY_NOT_SET;
+}
+
+std::string const& EndKey(btproto::RowRange const& r) {
+  static std::string const empty;
+  if (r.end_key_case() == btproto::RowRange::kEndKeyClosed) {
+    return r.end_key_closed();
+  }
+  if (r.end_key_case() == btproto::RowRange::kEndKeyOpen) {
+    return r.end_key_open();
+  }
+  return empty;
+}
+
+bool EndIsOpen(btproto::RowRange const& r) {
+  return r.end_key_case() == btproto::RowRange::kEndKeyOpen;
+}
+
+/// Compare two ranges by their start bound.
+bool StartLess(btproto::RowRange const& lhs, btproto::RowRange const& rhs) {
+  int cmp = StartKey(lhs).compare(StartKey(rhs));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  return !StartIsOpen(lhs) && StartIsOpen(rhs);
+}
+
+/// Compare two ranges by their end bound.
+bool EndLess(btproto::RowRange const& lhs, btproto::RowRange const& rhs) {
+  if (EndIsUnbounded(lhs)) {
+    return false;
+  }
+  if (EndIsUnbounded(rhs)) {
+    return true;
+  }
+  int cmp = EndKey(lhs).compare(EndKey(rhs));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  return EndIsOpen(lhs) && !EndIsOpen(rhs);
+}
+
+/**
+ * Can @p rhs be merged into @p lhs?
+ *
+ * Assumes `StartLess(rhs, lhs)` is false, i.e. @p rhs starts at or
+ * after @p lhs.  The union is a single range unless there is a gap
+ * between the end of @p lhs and the start of @p rhs.
+ */
+bool Mergeable(btproto::RowRange const& lhs, btproto::RowRange const& rhs) {
+  if (EndIsUnbounded(lhs)) {
+    return true;
+  }
+  int cmp = StartKey(rhs).compare(EndKey(lhs));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  // The bounds meet at the same key, there is a gap only when both
+  // bounds exclude that key.
+  return !(StartIsOpen(rhs) && EndIsOpen(lhs));
+}
+
+/// Is the whole of @p r below the start of @p range?
+bool RangeBelow(btproto::RowRange const& r, btproto::RowRange const& range) {
+  if (EndIsUnbounded(r)) {
+    return false;
+  }
+  int cmp = EndKey(r).compare(StartKey(range));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  // The bounds meet at the same key, they overlap only if both bounds
+  // include that key.
+  return EndIsOpen(r) || StartIsOpen(range);
+}
+
+/// Is the whole of @p r above the end of @p range?
+bool RangeAbove(btproto::RowRange const& r, btproto::RowRange const& range) {
+  if (EndIsUnbounded(range)) {
+    return false;
+  }
+  int cmp = StartKey(r).compare(EndKey(range));
+  if (cmp != 0) {
+    return cmp > 0;
+  }
+  return StartIsOpen(r) || EndIsOpen(range);
+}
+
+/// Is @p key below the start of @p range?
+bool KeyBelowStart(std::string const& key, btproto::RowRange const& range) {
+  int cmp = key.compare(StartKey(range));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  return StartIsOpen(range);
+}
+
+/// Is @p key above the end of @p range?
+bool KeyAboveEnd(std::string const& key, btproto::RowRange const& range) {
+  if (EndIsUnbounded(range)) {
+    return false;
+  }
+  int cmp = key.compare(EndKey(range));
+  if (cmp != 0) {
+    return cmp > 0;
+  }
+  return EndIsOpen(range);
+}
+}  // namespace
+
 RowSet RowSet::Intersect(bigtable::RowRange const& range) const {
   // Special case: "all rows", return the argument range.
   if (row_set_.row_keys().empty() && row_set_.row_ranges().empty()) {
-    return RowSet(range);
+    RowSet result(range);
+    result.normalized_ = true;
+    return result;
+  }
+  if (!normalized_) {
+    // Sort a copy once; the result below is marked as normalized so
+    // repeated intersections (e.g. the retry-resume pruning in
+    // `RowReader`) only pay for the sort on the first call.
+    RowSet copy(*this);
+    copy.Normalize();
+    return copy.Intersect(range);
   }
-  // Normal case: find the intersection with
-  // row keys and row ranges in the RowSet.
   RowSet result;
-  for (auto const& key : row_set_.row_keys()) {
-    if (range.Contains(key)) {
-      *result.row_set_.add_row_keys() = key;
-    }
+  auto const& range_proto = range.as_proto();
+  // The keys are sorted, find the surviving keys by binary search.
+  auto const& keys = row_set_.row_keys();
+  auto key = std::partition_point(
+      keys.begin(), keys.end(), [&range_proto](std::string const& k) {
+        return KeyBelowStart(k, range_proto);
+      });
+  for (; key != keys.end() && !KeyAboveEnd(*key, range_proto); ++key) {
+    *result.row_set_.add_row_keys() = *key;
   }
-  for (auto const& r : row_set_.row_ranges()) {
-    auto i = range.Intersect(RowRange(r));
+  // The ranges are sorted by start key and disjoint, so their end keys
+  // are sorted too; find the first range that is not below @p range by
+  // binary search, and stop as soon as a range is above @p range.
+  auto const& ranges = row_set_.row_ranges();
+  auto it = std::partition_point(
+      ranges.begin(), ranges.end(), [&range_proto](btproto::RowRange const& r) {
+        return RangeBelow(r, range_proto);
+      });
+  for (; it != ranges.end() && !RangeAbove(*it, range_proto); ++it) {
+    auto i = range.Intersect(RowRange(*it));
     if (std::get<0>(i)) {
       *result.row_set_.add_row_ranges() = std::move(std::get<1>(i)).as_proto();
     }
@@ -41,11 +198,53 @@ RowSet RowSet::Intersect(bigtable::RowRange const& range) const {
   // means "all rows", but we want "no rows".
   if (result.row_set_.row_keys().empty() &&
       result.row_set_.row_ranges().empty()) {
-    return RowSet(bigtable::RowRange::Empty());
+    RowSet empty(bigtable::RowRange::Empty());
+    empty.normalized_ = true;
+    return empty;
   }
+  result.normalized_ = true;
   return result;
 }
 
+void RowSet::Normalize() {
+  auto& keys = *row_set_.mutable_row_keys();
+  std::sort(keys.begin(), keys.end());
+  auto& ranges = *row_set_.mutable_row_ranges();
+  std::sort(ranges.begin(), ranges.end(), StartLess);
+  google::protobuf::RepeatedPtrField<btproto::RowRange> merged;
+  for (auto& r : ranges) {
+    if (RowRange(r).IsEmpty()) {
+      continue;
+    }
+    if (merged.empty() || !Mergeable(merged.Get(merged.size() - 1), r)) {
+      *merged.Add() = std::move(r);
+      continue;
+    }
+    auto& last = *merged.Mutable(merged.size() - 1);
+    if (!EndLess(last, r)) {
+      continue;  // @p r is fully contained in the last merged range.
+    }
+    switch (r.end_key_case()) {
+      case btproto::RowRange::kEndKeyClosed:
+        last.set_end_key_closed(std::move(*r.mutable_end_key_closed()));
+        break;
+      case btproto::RowRange::kEndKeyOpen:
+        last.set_end_key_open(std::move(*r.mutable_end_key_open()));
+        break;
+      default:
+        last.clear_end_key();
+        break;
+    }
+  }
+  ranges.Swap(&merged);
+  // Removing empty ranges can leave the set without any entries, which
+  // would mean "all rows" instead of "no rows"; keep one empty range.
+  if (row_set_.row_keys().empty() && row_set_.row_ranges().empty()) {
+    *row_set_.add_row_ranges() = RowRange::Empty().as_proto();
+  }
+  normalized_ = true;
+}
+
 bool RowSet::IsEmpty() const {
   if (row_set_.row_keys_size() > 0) {
     return false;
@@ -47,6 +47,7 @@ class RowSet {
   /// Add @p range to the set.
   void Append(RowRange range) {
     *row_set_.add_row_ranges() = std::move(range).as_proto();
+    normalized_ = false;
   }
 
   /**
@@ -55,6 +56,7 @@ class RowSet {
   template <typename T>
   void Append(T&& row_key) {
     *row_set_.add_row_keys() = std::forward<T>(row_key);
+    normalized_ = false;
   }
 
   /**
@@ -63,6 +65,14 @@ class RowSet {
    * This function removes any rowkeys outside @p range, it removes any row
    * ranges that do not insersect with @p range, and keeps only the intersection
    * for those ranges that do intersect @p range.
+   *
+   * The result is *normalized*: its keys are sorted and its ranges are
+   * sorted by start key, with overlapping ranges merged. Normalizing
+   * does not change which rows the set matches, but it lets further
+   * intersections find the surviving entries by binary search. The
+   * retry-resume logic in `RowReader` intersects the same set once per
+   * retry, so with many ranges this turns an O(n) scan per retry into
+   * an O(log n) search.
    */
   RowSet Intersect(bigtable::RowRange const& range) const;
 
@@ -95,7 +105,19 @@ class RowSet {
   void AppendAll() {}
 
  private:
+  /**
+   * Sort the keys and sort/merge the ranges, see `Intersect()`.
+   *
+   * Empty ranges are removed; if that leaves the set without entries a
+   * single empty range is kept, because a set without entries means
+   * "all rows".
+   */
+  void Normalize();
+
   ::google::bigtable::v2::RowSet row_set_;
+  /// True when the keys are sorted and the ranges are sorted by start
+  /// key and pairwise disjoint.
+  bool normalized_ = false;
 };
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
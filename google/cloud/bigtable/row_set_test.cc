@@ -115,3 +115,64 @@ TEST(RowSetTest, IntersectWithDisjointIsEmpty) {
   EXPECT_TRUE(
       RowSet("a", R::Range("a", "b")).Intersect(R::Range("c", "d")).IsEmpty());
 }
+
+TEST(RowSetTest, IntersectNormalizesOutOfOrderRanges) {
+  using R = bigtable::RowRange;
+  bigtable::RowSet row_set(R::Range("f", "k"), R::Range("a", "c"),
+                           R::Range("b", "d"), "zz", "aa");
+
+  auto proto = row_set.Intersect(R::InfiniteRange()).as_proto();
+  ASSERT_EQ(2, proto.row_ranges_size());
+  EXPECT_EQ(R::Range("a", "d"), R(proto.row_ranges(0)));
+  EXPECT_EQ(R::Range("f", "k"), R(proto.row_ranges(1)));
+  ASSERT_EQ(2, proto.row_keys_size());
+  EXPECT_EQ("aa", proto.row_keys(0));
+  EXPECT_EQ("zz", proto.row_keys(1));
+}
+
+TEST(RowSetTest, IntersectMergesAdjacentRanges) {
+  using R = bigtable::RowRange;
+  bigtable::RowSet row_set(R::RightOpen("a", "b"), R::Closed("b", "c"),
+                           R::RightOpen("e", "m"), R::RightOpen("f", "g"));
+
+  auto proto = row_set.Intersect(R::InfiniteRange()).as_proto();
+  ASSERT_EQ(2, proto.row_ranges_size());
+  EXPECT_EQ(R::Closed("a", "c"), R(proto.row_ranges(0)));
+  EXPECT_EQ(R::RightOpen("e", "m"), R(proto.row_ranges(1)));
+}
+
+TEST(RowSetTest, IntersectPreservesGapBetweenOpenBounds) {
+  using R = bigtable::RowRange;
+  // The row "b" is in neither range, the union is not a single range.
+  bigtable::RowSet row_set(R::Open("a", "b"), R::Open("b", "c"));
+
+  auto proto = row_set.Intersect(R::InfiniteRange()).as_proto();
+  ASSERT_EQ(2, proto.row_ranges_size());
+  EXPECT_EQ(R::Open("a", "b"), R(proto.row_ranges(0)));
+  EXPECT_EQ(R::Open("b", "c"), R(proto.row_ranges(1)));
+}
+
+TEST(RowSetTest, IntersectResumeAfterRetry) {
+  using R = bigtable::RowRange;
+  bigtable::RowSet row_set(R::RightOpen("e", "f"), R::RightOpen("a", "b"),
+                           R::RightOpen("c", "d"), "g", "b");
+
+  // Simulate the pruning performed by `RowReader` when a scan is
+  // resumed, first after reading "a5", then after reading "c5".
+  auto s1 = row_set.Intersect(R::Open("a5", ""));
+  auto proto = s1.as_proto();
+  ASSERT_EQ(3, proto.row_ranges_size());
+  EXPECT_EQ(R::Open("a5", "b"), R(proto.row_ranges(0)));
+  EXPECT_EQ(R::RightOpen("c", "d"), R(proto.row_ranges(1)));
+  EXPECT_EQ(R::RightOpen("e", "f"), R(proto.row_ranges(2)));
+  ASSERT_EQ(2, proto.row_keys_size());
+  EXPECT_EQ("b", proto.row_keys(0));
+  EXPECT_EQ("g", proto.row_keys(1));
+
+  proto = s1.Intersect(R::Open("c5", "")).as_proto();
+  ASSERT_EQ(2, proto.row_ranges_size());
+  EXPECT_EQ(R::Open("c5", "d"), R(proto.row_ranges(0)));
+  EXPECT_EQ(R::RightOpen("e", "f"), R(proto.row_ranges(1)));
+  ASSERT_EQ(1, proto.row_keys_size());
+  EXPECT_EQ("g", proto.row_keys(0));
+}
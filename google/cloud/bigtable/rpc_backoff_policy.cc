@@ -13,11 +13,44 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include <google/rpc/error_details.pb.h>
+#include <google/rpc/status.pb.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/**
+ * Extract the server's retry-delay hint, zero if there is none.
+ *
+ * The error details of a `grpc::Status` carry a serialized
+ * `google.rpc.Status`, which may include a `google.rpc.RetryInfo`
+ * detail when the server wants to push back on retries.
+ */
+std::chrono::milliseconds ServerRetryDelayHint(grpc::Status const& status) {
+  auto constexpr kNoHint = std::chrono::milliseconds(0);
+  if (status.error_details().empty()) {
+    return kNoHint;
+  }
+  google::rpc::Status details;
+  if (!details.ParseFromString(status.error_details())) {
+    return kNoHint;
+  }
+  google::rpc::RetryInfo retry_info;
+  for (auto const& any : details.details()) {
+    if (!any.Is<google::rpc::RetryInfo>() || !any.UnpackTo(&retry_info)) {
+      continue;
+    }
+    auto const& delay = retry_info.retry_delay();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::seconds(delay.seconds()) +
+        std::chrono::nanoseconds(delay.nanos()));
+  }
+  return kNoHint;
+}
+}  // anonymous namespace
 std::unique_ptr<RPCBackoffPolicy> DefaultRPCBackoffPolicy(
     internal::RPCPolicyParameters defaults) {
   return std::unique_ptr<RPCBackoffPolicy>(new ExponentialBackoffPolicy(
@@ -45,6 +78,48 @@ std::chrono::milliseconds ExponentialBackoffPolicy::OnCompletion(
   return impl_.OnCompletion();
 }
 
+DecorrelatedJitterBackoffPolicy::DecorrelatedJitterBackoffPolicy(
+    internal::RPCPolicyParameters defaults)
+    : DecorrelatedJitterBackoffPolicy(defaults.initial_delay,
+                                      defaults.maximum_delay) {}
+
+std::unique_ptr<RPCBackoffPolicy> DecorrelatedJitterBackoffPolicy::clone()
+    const {
+  // Create a fresh policy (with a fresh generator seed) instead of
+  // copying this one, copies sharing a seed would produce the very
+  // synchronized delays this policy exists to avoid.
+  return std::unique_ptr<RPCBackoffPolicy>(
+      new DecorrelatedJitterBackoffPolicy(initial_delay_, maximum_delay_));
+}
+
+void DecorrelatedJitterBackoffPolicy::Setup(grpc::ClientContext&) const {}
+
+std::chrono::milliseconds DecorrelatedJitterBackoffPolicy::OnCompletion(
+    google::cloud::Status const&) {
+  // `google::cloud::Status` does not carry the error details needed for
+  // the server hint, fall back to pure decorrelated jitter.
+  return OnCompletionImpl(std::chrono::milliseconds(0));
+}
+
+std::chrono::milliseconds DecorrelatedJitterBackoffPolicy::OnCompletion(
+    grpc::Status const& status) {
+  return OnCompletionImpl(ServerRetryDelayHint(status));
+}
+
+std::chrono::milliseconds DecorrelatedJitterBackoffPolicy::OnCompletionImpl(
+    std::chrono::milliseconds server_hint) {
+  auto const hi =
+      (std::min)(maximum_delay_.count(), 3 * previous_delay_.count());
+  auto const lo = (std::min)(initial_delay_.count(), hi);
+  std::uniform_int_distribution<std::chrono::milliseconds::rep> dist(lo, hi);
+  auto delay = std::chrono::milliseconds(dist(generator_));
+  // Never retry before the server's hint; the hint deliberately wins
+  // over `maximum_delay` too, retrying earlier would just fail again.
+  delay = (std::max)(delay, server_hint);
+  previous_delay_ = (std::min)(delay, maximum_delay_);
+  return delay;
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
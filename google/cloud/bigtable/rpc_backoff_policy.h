@@ -21,6 +21,7 @@
 #include <grpcpp/grpcpp.h>
 #include <chrono>
 #include <memory>
+#include <random>
 
 namespace google {
 namespace cloud {
@@ -98,6 +99,53 @@ class ExponentialBackoffPolicy : public RPCBackoffPolicy {
   Impl impl_;
 };
 
+/**
+ * Implement a "decorrelated jitter" backoff policy that honors server
+ * retry-delay hints.
+ *
+ * Exponential backoff with uniform jitter around each step keeps the
+ * retries of clients that failed together loosely synchronized, so under
+ * zone-wide overload their retry waves contribute to the congestion they
+ * are waiting out. Decorrelated jitter instead draws each delay
+ * uniformly from `[initial_delay, 3 * previous_delay]`, capped at
+ * `maximum_delay`; the much wider range spreads the clients apart after
+ * a couple of attempts.
+ *
+ * When the server attaches a `google.rpc.RetryInfo` detail to the error
+ * this policy also waits at least the hinted delay, the server knows how
+ * long the overload will last better than any client-side formula.
+ */
+class DecorrelatedJitterBackoffPolicy : public RPCBackoffPolicy {
+ public:
+  DecorrelatedJitterBackoffPolicy(internal::RPCPolicyParameters defaults);
+  template <typename duration_t1, typename duration_t2>
+  DecorrelatedJitterBackoffPolicy(duration_t1 initial_delay,
+                                  duration_t2 maximum_delay)
+      : initial_delay_(std::chrono::duration_cast<std::chrono::milliseconds>(
+            initial_delay)),
+        maximum_delay_(std::chrono::duration_cast<std::chrono::milliseconds>(
+            maximum_delay)),
+        previous_delay_(initial_delay_),
+        generator_(std::random_device{}()) {}
+
+  std::unique_ptr<RPCBackoffPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  std::chrono::milliseconds OnCompletion(
+      google::cloud::Status const& status) override;
+  // TODO(#2344) - remove ::grpc::Status version.
+  std::chrono::milliseconds OnCompletion(grpc::Status const& status) override;
+
+ private:
+  /// Compute the next delay, never shorter than @p server_hint.
+  std::chrono::milliseconds OnCompletionImpl(
+      std::chrono::milliseconds server_hint);
+
+  std::chrono::milliseconds initial_delay_;
+  std::chrono::milliseconds maximum_delay_;
+  std::chrono::milliseconds previous_delay_;
+  std::mt19937 generator_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -14,6 +14,8 @@
 
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/testing_util/chrono_literals.h"
+#include <google/rpc/error_details.pb.h>
+#include <google/rpc/status.pb.h>
 #include <gtest/gtest.h>
 #include <chrono>
 #include <vector>
@@ -71,3 +73,67 @@ TEST(ExponentialBackoffRetryPolicy, Randomness) {
   }
   EXPECT_NE(output1, output2);
 }
+
+/// @test Verify the decorrelated jitter delays stay within their bounds.
+TEST(DecorrelatedJitterBackoffPolicy, Bounds) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DecorrelatedJitterBackoffPolicy tested(10_ms, 500_ms);
+
+  for (int i = 0; i != 100; ++i) {
+    auto const delay = tested.OnCompletion(CreateTransientError());
+    EXPECT_LE(10_ms, delay);
+    EXPECT_GE(500_ms, delay);
+  }
+}
+
+/// @test Verify two policies do not produce the same delay sequence.
+TEST(DecorrelatedJitterBackoffPolicy, Randomness) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DecorrelatedJitterBackoffPolicy test_object1(10_ms, 1500_ms);
+  bigtable::DecorrelatedJitterBackoffPolicy test_object2(10_ms, 1500_ms);
+  std::vector<int> output1, output2;
+
+  for (int i = 0; i != 100; ++i) {
+    output1.push_back(
+        test_object1.OnCompletion(CreateTransientError()).count());
+    output2.push_back(
+        test_object2.OnCompletion(CreateTransientError()).count());
+  }
+  EXPECT_NE(output1, output2);
+}
+
+/// @test Verify clones draw independent sequences, not a shared one.
+TEST(DecorrelatedJitterBackoffPolicy, CloneIndependence) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DecorrelatedJitterBackoffPolicy original(10_ms, 1500_ms);
+  auto clone1 = original.clone();
+  auto clone2 = original.clone();
+  std::vector<int> output1, output2;
+
+  for (int i = 0; i != 100; ++i) {
+    output1.push_back(clone1->OnCompletion(CreateTransientError()).count());
+    output2.push_back(clone2->OnCompletion(CreateTransientError()).count());
+  }
+  EXPECT_NE(output1, output2);
+}
+
+/// @test Verify the server retry-delay hint is honored.
+TEST(DecorrelatedJitterBackoffPolicy, HonorsServerHint) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DecorrelatedJitterBackoffPolicy tested(10_ms, 500_ms);
+
+  google::rpc::Status details;
+  details.set_code(grpc::StatusCode::UNAVAILABLE);
+  details.set_message("overloaded");
+  google::rpc::RetryInfo retry_info;
+  retry_info.mutable_retry_delay()->set_seconds(2);
+  retry_info.mutable_retry_delay()->set_nanos(0);
+  details.add_details()->PackFrom(retry_info);
+  grpc::Status status(grpc::StatusCode::UNAVAILABLE, "overloaded",
+                      details.SerializeAsString());
+
+  // The hint deliberately wins over the 500ms maximum delay.
+  EXPECT_LE(std::chrono::milliseconds(2000), tested.OnCompletion(status));
+  // Without the hint the delays return to their normal bounds.
+  EXPECT_GE(500_ms, tested.OnCompletion(CreateTransientError()));
+}
@@ -64,6 +64,41 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(MakeStatusFromRpcError(status));
 }
 
+DeadlineBudgetRetryPolicy::DeadlineBudgetRetryPolicy(
+    std::chrono::milliseconds budget, std::chrono::milliseconds minimum_attempt)
+    : budget_(budget),
+      minimum_attempt_(minimum_attempt),
+      deadline_(std::chrono::system_clock::now() + budget) {}
+
+std::unique_ptr<RPCRetryPolicy> DeadlineBudgetRetryPolicy::clone() const {
+  // Clones get a full, fresh budget; the policies are cloned at the
+  // start of each operation and the budget covers one operation.
+  return std::unique_ptr<RPCRetryPolicy>(
+      new DeadlineBudgetRetryPolicy(budget_, minimum_attempt_));
+}
+
+void DeadlineBudgetRetryPolicy::Setup(grpc::ClientContext& context) const {
+  // Clip the attempt to the remaining budget, every attempt shares the
+  // one end-to-end deadline instead of getting a fresh timeout.
+  if (context.deadline() >= deadline_) {
+    context.set_deadline(deadline_);
+  }
+}
+
+bool DeadlineBudgetRetryPolicy::OnFailure(google::cloud::Status const& status) {
+  if (IsPermanentFailure(status)) {
+    return false;
+  }
+  // Skip retries that cannot fit a useful attempt in what remains of
+  // the budget, the caller gets the error now rather than after an
+  // attempt doomed to exceed its deadline.
+  return std::chrono::system_clock::now() + minimum_attempt_ <= deadline_;
+}
+
+bool DeadlineBudgetRetryPolicy::OnFailure(grpc::Status const& status) {
+  return OnFailure(MakeStatusFromRpcError(status));
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -163,6 +163,49 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   Impl impl_;
 };
 
+/**
+ * A retry policy that spends a fixed latency budget across all attempts.
+ *
+ * `LimitedTimeRetryPolicy` stops retrying once the maximum duration has
+ * elapsed, but each attempt still runs with whatever deadline the
+ * application (or the backoff policy) configured, so the total
+ * operation time can balloon to attempts x timeout. This policy tracks
+ * a single end-to-end budget instead: every attempt's deadline is
+ * clipped to whatever remains of the budget, and a retry is skipped
+ * when the remaining budget cannot fit a useful attempt. The
+ * end-to-end latency of the operation is therefore bounded by the
+ * budget, regardless of how the attempts fail.
+ *
+ * The budget starts when the policy is created; the policies are
+ * cloned at the start of each operation, so clones of a prototype get
+ * a full, fresh budget.
+ */
+class DeadlineBudgetRetryPolicy : public RPCRetryPolicy {
+ public:
+  /**
+   * @param budget the total time alloted to the operation.
+   * @param minimum_attempt how much of the budget must remain for a
+   *     retry to be worth attempting; retries that cannot fit this
+   *     window fail immediately instead of burning the tail of the
+   *     budget on an attempt doomed to time out.
+   */
+  explicit DeadlineBudgetRetryPolicy(
+      std::chrono::milliseconds budget,
+      std::chrono::milliseconds minimum_attempt = std::chrono::milliseconds(
+          10));
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  bool OnFailure(google::cloud::Status const& status) override;
+  // TODO(#2344) - remove ::grpc::Status version.
+  bool OnFailure(grpc::Status const& status) override;
+
+ private:
+  std::chrono::milliseconds budget_;
+  std::chrono::milliseconds minimum_attempt_;
+  std::chrono::system_clock::time_point deadline_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
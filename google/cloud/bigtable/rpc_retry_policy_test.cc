@@ -110,3 +110,62 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   bigtable::LimitedErrorCountRetryPolicy tested(3);
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
+
+/// @test Verify that the budget policy clips the attempt deadline.
+TEST(DeadlineBudgetRetryPolicy, SetupClipsDeadline) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DeadlineBudgetRetryPolicy tested(kLimitedTimeTestPeriod, 1_ms);
+  grpc::ClientContext context;
+  tested.Setup(context);
+  EXPECT_LE(context.deadline(),
+            std::chrono::system_clock::now() + kLimitedTimeTestPeriod);
+}
+
+/// @test Verify that attempt deadlines shrink as the budget is consumed.
+TEST(DeadlineBudgetRetryPolicy, DeadlineSharedAcrossAttempts) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DeadlineBudgetRetryPolicy tested(kLimitedTimeTestPeriod, 1_ms);
+  grpc::ClientContext c1;
+  tested.Setup(c1);
+  std::this_thread::sleep_for(10_ms);
+  grpc::ClientContext c2;
+  tested.Setup(c2);
+  // Both attempts share the one end-to-end deadline, so the second
+  // attempt does not get a fresh timeout.
+  EXPECT_EQ(c1.deadline(), c2.deadline());
+}
+
+/// @test Verify that retries stop when the budget is exhausted.
+TEST(DeadlineBudgetRetryPolicy, Simple) {
+  bigtable::DeadlineBudgetRetryPolicy tested(kLimitedTimeTestPeriod, 1_ms);
+  CheckLimitedTime(tested);
+}
+
+/// @test Verify that a retry is skipped when it cannot fit the budget.
+TEST(DeadlineBudgetRetryPolicy, SkipsRetryThatCannotFit) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  // The whole budget cannot fit the minimum attempt, so the first
+  // failure is final.
+  bigtable::DeadlineBudgetRetryPolicy tested(10_ms, 500_ms);
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+}
+
+/// @test Verify that non-retryable errors cause an immediate failure.
+TEST(DeadlineBudgetRetryPolicy, OnNonRetryable) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DeadlineBudgetRetryPolicy tested(kLimitedTimeTestPeriod, 1_ms);
+  EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
+}
+
+/// @test Verify that clones get a full, fresh budget.
+TEST(DeadlineBudgetRetryPolicy, CloneResetsBudget) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::DeadlineBudgetRetryPolicy original(kLimitedTimeTestPeriod, 1_ms);
+  std::this_thread::sleep_for(20_ms);
+  auto tested = original.clone();
+  grpc::ClientContext context;
+  tested->Setup(context);
+  EXPECT_GT(context.deadline(),
+            std::chrono::system_clock::now() + kLimitedTimeTestPeriod -
+                kLimitedTimeTolerance);
+}
@@ -16,8 +16,14 @@
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/async_retry_unary_rpc.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/rpc_metrics.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 
@@ -58,6 +64,36 @@ Row TransformReadModifyWriteRowResponse(Response& response) {
   return Row(std::move(*row.mutable_key()), std::move(cells));
 }
 
+/// One cached `SampleRows()` result, see `Table::SampleRows(max_age)`.
+struct RowKeySampleCacheEntry {
+  std::mutex mu;
+  bool valid = false;
+  bool refreshing = false;
+  std::chrono::steady_clock::time_point fetched;
+  std::vector<bigtable::RowKeySample> samples;
+};
+
+/**
+ * The process-wide row key sample cache.
+ *
+ * Keyed by table name and application profile, so every `Table` (and
+ * `DataClient`) addressing the same table shares one entry. Entries are
+ * never removed; the universe of tables sampled by one process is small
+ * and the samples themselves are tiny.
+ */
+std::shared_ptr<RowKeySampleCacheEntry> RowKeySampleCacheFor(
+    std::string const& key) {
+  static std::mutex mu;
+  static auto* cache =
+      new std::map<std::string, std::shared_ptr<RowKeySampleCacheEntry>>;
+  std::lock_guard<std::mutex> lk(mu);
+  auto& entry = (*cache)[key];
+  if (!entry) {
+    entry = std::make_shared<RowKeySampleCacheEntry>();
+  }
+  return entry;
+}
+
 }  // namespace
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
@@ -65,13 +101,26 @@ using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
 static_assert(std::is_copy_assignable<bigtable::Table>::value,
               "bigtable::Table must be CopyAssignable");
 
+void Table::SetupCompression(grpc::ClientContext& context,
+                             std::size_t request_size) {
+  auto const algorithm = client_->call_compression_algorithm();
+  if (algorithm == GRPC_COMPRESS_NONE) {
+    return;
+  }
+  if (request_size < client_->call_compression_threshold()) {
+    // Small messages spend more CPU compressing than they save.
+    return;
+  }
+  context.set_compression_algorithm(algorithm);
+}
+
 Status Table::Apply(SingleRowMutation mut) {
-  // Copy the policies in effect for this operation.  Many policy classes change
-  // their state as the operation makes progress (or fails to make progress), so
-  // we need fresh instances.
-  auto rpc_policy = clone_rpc_retry_policy();
-  auto backoff_policy = clone_rpc_backoff_policy();
-  auto idempotent_policy = clone_idempotent_mutation_policy();
+  // The policies only change state when an attempt fails, so clone them
+  // lazily on the first failure and read the prototypes until then. At
+  // high `Apply()` rates the clones are constant allocator noise for a
+  // path that almost always succeeds on the first attempt.
+  std::unique_ptr<RPCRetryPolicy> rpc_policy;
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
 
   // Build the RPC request, try to minimize copying.
   btproto::MutateRowRequest request;
@@ -79,31 +128,45 @@ Status Table::Apply(SingleRowMutation mut) {
       request, app_profile_id_, table_name_);
   mut.MoveTo(request);
 
+  auto& idempotent_policy = *idempotent_mutation_policy_;
   bool const is_idempotent =
       std::all_of(request.mutations().begin(), request.mutations().end(),
                   [&idempotent_policy](btproto::Mutation const& m) {
-                    return idempotent_policy->is_idempotent(m);
+                    return idempotent_policy.is_idempotent(m);
                   });
 
   btproto::MutateRowResponse response;
   grpc::Status status;
   while (true) {
     grpc::ClientContext client_context;
-    rpc_policy->Setup(client_context);
-    backoff_policy->Setup(client_context);
+    (rpc_policy ? *rpc_policy : *rpc_retry_policy_prototype_)
+        .Setup(client_context);
+    (backoff_policy ? *backoff_policy : *rpc_backoff_policy_prototype_)
+        .Setup(client_context);
     metadata_update_policy_.Setup(client_context);
+    SetupCompression(client_context, request.ByteSizeLong());
+    internal::RecordAttemptLatency attempt(
+        internal::RpcMetrics::Method::kApply);
     status = client_->MutateRow(&client_context, request, &response);
+    attempt.Record(status.ok());
 
     if (status.ok()) {
       return google::cloud::Status{};
     }
+    if (!rpc_policy) {
+      rpc_policy = rpc_retry_policy_prototype_->clone();
+      backoff_policy = rpc_backoff_policy_prototype_->clone();
+    }
     // It is up to the policy to terminate this loop, it could run
     // forever, but that would be a bad policy (pun intended).
     if (!rpc_policy->OnFailure(status) || !is_idempotent) {
       return MakeStatusFromRpcError(status);
     }
+    internal::RpcMetrics::Instance().RecordRetry(
+        internal::RpcMetrics::Method::kApply);
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
+    response.Clear();
   }
 }
 
@@ -141,6 +204,36 @@ future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
 }
 
 std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
+  // Copy the policies in effect for this operation.  Many policy classes change
+  // their state as the operation makes progress (or fails to make progress), so
+  // we need fresh instances.
+  auto idemponent_policy = clone_idempotent_mutation_policy();
+
+  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
+                                          *idemponent_policy, std::move(mut));
+  return BulkApplyImpl(mutator);
+}
+
+std::vector<FailedMutation> Table::BulkApply(
+    BulkMutation mut, std::function<void(int)> on_success) {
+  auto idemponent_policy = clone_idempotent_mutation_policy();
+
+  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
+                                          *idemponent_policy, std::move(mut));
+  return BulkApplyImpl(mutator, on_success);
+}
+
+std::vector<FailedMutation> Table::BulkApply(ArenaBulkMutation mut) {
+  auto idemponent_policy = clone_idempotent_mutation_policy();
+
+  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
+                                          *idemponent_policy, std::move(mut));
+  return BulkApplyImpl(mutator);
+}
+
+std::vector<FailedMutation> Table::BulkApplyImpl(
+    bigtable::internal::BulkMutator& mutator,
+    std::function<void(int)> const& on_success) {
   grpc::Status status;
 
   // Copy the policies in effect for this operation.  Many policy classes change
@@ -148,19 +241,21 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
   // we need fresh instances.
   auto backoff_policy = clone_rpc_backoff_policy();
   auto retry_policy = clone_rpc_retry_policy();
-  auto idemponent_policy = clone_idempotent_mutation_policy();
 
-  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
-                                          *idemponent_policy, std::move(mut));
   while (mutator.HasPendingMutations()) {
     grpc::ClientContext client_context;
     backoff_policy->Setup(client_context);
     retry_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
-    status = mutator.MakeOneRequest(*client_, client_context);
+    SetupCompression(client_context, mutator.PendingRequestSize());
+    status = mutator.MakeOneRequest(*client_, client_context, on_success);
     if (!status.ok() && !retry_policy->OnFailure(status)) {
       break;
     }
+    if (mutator.HasPendingMutations()) {
+      internal::RpcMetrics::Instance().RecordRetry(
+          internal::RpcMetrics::Method::kBulkApply);
+    }
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
   }
@@ -177,9 +272,11 @@ future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut,
 }
 
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
+  // Pass the policy prototypes, the reader clones its per-call policy
+  // state only if an attempt fails.
   return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
                    RowReader::NO_ROWS_LIMIT, std::move(filter),
-                   clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+                   rpc_retry_policy_prototype_, rpc_backoff_policy_prototype_,
                    metadata_update_policy_,
                    google::cloud::internal::make_unique<
                        bigtable::internal::ReadRowsParserFactory>());
@@ -188,32 +285,325 @@ RowReader Table::ReadRows(RowSet row_set, Filter filter) {
 RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                           Filter filter) {
   return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
-                   rows_limit, std::move(filter), clone_rpc_retry_policy(),
-                   clone_rpc_backoff_policy(), metadata_update_policy_,
+                   rows_limit, std::move(filter), rpc_retry_policy_prototype_,
+                   rpc_backoff_policy_prototype_, metadata_update_policy_,
                    google::cloud::internal::make_unique<
                        bigtable::internal::ReadRowsParserFactory>());
 }
 
+StatusOr<RowReader> Table::ResumeScan(std::string const& checkpoint,
+                                      Filter filter) {
+  google::bigtable::v2::ReadRowsRequest parsed;
+  if (!parsed.ParseFromString(checkpoint)) {
+    return Status(StatusCode::kInvalidArgument,
+                  "cannot parse scan checkpoint");
+  }
+  RowSet row_set;
+  for (auto& key : *parsed.mutable_rows()->mutable_row_keys()) {
+    row_set.Append(std::move(key));
+  }
+  for (auto& range : *parsed.mutable_rows()->mutable_row_ranges()) {
+    row_set.Append(RowRange(std::move(range)));
+  }
+  if (parsed.rows_limit() == 0) {
+    return ReadRows(std::move(row_set), std::move(filter));
+  }
+  return ReadRows(std::move(row_set), parsed.rows_limit(), std::move(filter));
+}
+
+void Table::RestartScan(RowReader& reader, RowSet row_set,
+                        std::int64_t rows_limit) {
+  reader.Restart(std::move(row_set), rows_limit, clone_rpc_retry_policy(),
+                 clone_rpc_backoff_policy());
+}
+
+Status Table::ScanRows(RowSet row_set, Filter filter, CellVisitor& visitor) {
+  btproto::ReadRowsRequest request;
+  SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_, table_name_);
+  *request.mutable_filter() = std::move(filter).as_proto();
+
+  // Cloned lazily on the first failure, a single-attempt scan performs
+  // no policy allocations.
+  std::unique_ptr<RPCRetryPolicy> rpc_policy;
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
+
+  grpc::Status status;
+  while (true) {
+    *request.mutable_rows() = row_set.as_proto();
+
+    grpc::ClientContext client_context;
+    (rpc_policy ? *rpc_policy : *rpc_retry_policy_prototype_)
+        .Setup(client_context);
+    (backoff_policy ? *backoff_policy : *rpc_backoff_policy_prototype_)
+        .Setup(client_context);
+    metadata_update_policy_.Setup(client_context);
+
+    internal::RecordAttemptLatency attempt(
+        internal::RpcMetrics::Method::kReadRows);
+    auto stream = client_->ReadRows(&client_context, request,
+                                    TrafficClass::kBulk);
+    internal::ReadRowsParser parser;
+    parser.SetVisitor(&visitor);
+    btproto::ReadRowsResponse response;
+    grpc::Status parse_status;
+    while (parse_status.ok() && stream->Read(&response)) {
+      parser.HandleResponse(std::move(response), parse_status);
+    }
+    if (!parse_status.ok()) {
+      // Drain the stream before closing it, gRPC requires it.
+      client_context.TryCancel();
+      while (stream->Read(&response)) {
+      }
+      stream->Finish();
+      status = parse_status;
+    } else {
+      status = stream->Finish();
+      if (status.ok()) {
+        parser.HandleEndOfStream(status);
+      }
+    }
+    attempt.Record(status.ok());
+    if (status.ok()) {
+      return google::cloud::Status{};
+    }
+    // The parser discards any partial row; the retry delivers the
+    // uncommitted row again, the visitor was told via OnRowReset() if
+    // any of its cells had been delivered.
+    if (parser.cells_delivered_in_row() != 0) {
+      visitor.OnRowReset();
+    }
+    if (!parser.last_seen_row_key().empty()) {
+      // We've delivered some rows and need to make sure we don't
+      // request them again.
+      row_set = row_set.Intersect(RowRange::Open(parser.last_seen_row_key(),
+                                                 ""));
+    }
+    // If we receive an error, but the retriable set is empty, stop.
+    if (row_set.IsEmpty()) {
+      return google::cloud::Status{};
+    }
+    if (!rpc_policy) {
+      rpc_policy = rpc_retry_policy_prototype_->clone();
+      backoff_policy = rpc_backoff_policy_prototype_->clone();
+    }
+    if (!rpc_policy->OnFailure(status)) {
+      return MakeStatusFromRpcError(status);
+    }
+    internal::RpcMetrics::Instance().RecordRetry(
+        internal::RpcMetrics::Method::kReadRows);
+    auto delay = backoff_policy->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
+  }
+}
+
+grpc::Status Table::ReadRowAttempt(btproto::ReadRowsRequest const& request,
+                                   grpc::ClientContext& client_context,
+                                   std::pair<bool, Row>& result) {
+  auto stream = client_->ReadRows(&client_context, request);
+  internal::ReadRowsParser parser;
+  btproto::ReadRowsResponse response;
+  grpc::Status parse_status;
+  while (parse_status.ok() && stream->Read(&response)) {
+    parser.HandleResponse(std::move(response), parse_status);
+  }
+  grpc::Status status;
+  if (!parse_status.ok()) {
+    // Drain the stream before closing it, gRPC requires it.
+    client_context.TryCancel();
+    while (stream->Read(&response)) {
+    }
+    stream->Finish();
+    status = parse_status;
+  } else {
+    status = stream->Finish();
+    if (status.ok()) {
+      parser.HandleEndOfStream(status);
+    }
+  }
+  if (!status.ok()) {
+    return status;
+  }
+  if (!parser.HasNext()) {
+    result = std::make_pair(false, Row("", {}));
+    return status;
+  }
+  Row row = parser.Next(status);
+  if (!status.ok()) {
+    return status;
+  }
+  if (parser.HasNext()) {
+    // INTERNAL is a permanent failure, the retry loops surface it as-is.
+    return grpc::Status(
+        grpc::StatusCode::INTERNAL,
+        "internal error - server returned 2 rows in ReadRow()");
+  }
+  result = std::make_pair(true, std::move(row));
+  return status;
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
-  RowSet row_set(std::move(row_key));
-  std::int64_t const rows_limit = 1;
-  RowReader reader =
-      ReadRows(std::move(row_set), rows_limit, std::move(filter));
+  // Point reads are the bulk of the data path, so this avoids the
+  // full RowReader machinery (parser factory, RowSet copies, iterator
+  // state) in favor of a single prebuilt request and a parser on the
+  // stack. Retries reuse the request unchanged: a point read either
+  // returns the full row or nothing.
+  btproto::ReadRowsRequest request;
+  SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_, table_name_);
+  request.mutable_rows()->add_row_keys(std::move(row_key));
+  request.set_rows_limit(1);
+  *request.mutable_filter() = std::move(filter).as_proto();
 
-  auto it = reader.begin();
-  if (it == reader.end()) {
-    return std::make_pair(false, Row("", {}));
+  // Like `Apply()`, clone the policies lazily: they only change state on
+  // failure (`Setup()` is `const`), so a point read that succeeds on the
+  // first attempt performs no policy allocations.
+  std::unique_ptr<RPCRetryPolicy> rpc_policy;
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
+
+  while (true) {
+    grpc::ClientContext client_context;
+    (rpc_policy ? *rpc_policy : *rpc_retry_policy_prototype_)
+        .Setup(client_context);
+    (backoff_policy ? *backoff_policy : *rpc_backoff_policy_prototype_)
+        .Setup(client_context);
+    metadata_update_policy_.Setup(client_context);
+
+    std::pair<bool, Row> result(false, Row("", {}));
+    internal::RecordAttemptLatency attempt(
+        internal::RpcMetrics::Method::kReadRow);
+    auto status = ReadRowAttempt(request, client_context, result);
+    attempt.Record(status.ok());
+    if (status.ok()) {
+      return result;
+    }
+    if (!rpc_policy) {
+      rpc_policy = rpc_retry_policy_prototype_->clone();
+      backoff_policy = rpc_backoff_policy_prototype_->clone();
+    }
+    if (!rpc_policy->OnFailure(status)) {
+      return MakeStatusFromRpcError(status);
+    }
+    internal::RpcMetrics::Instance().RecordRetry(
+        internal::RpcMetrics::Method::kReadRow);
+    auto delay = backoff_policy->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
   }
-  if (!*it) {
-    return it->status();
+}
+
+StatusOr<std::pair<bool, Row>> Table::ReadRow(
+    std::string row_key, Filter filter,
+    std::chrono::milliseconds hedging_delay) {
+  btproto::ReadRowsRequest request;
+  SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_, table_name_);
+  request.mutable_rows()->add_row_keys(std::move(row_key));
+  request.set_rows_limit(1);
+  *request.mutable_filter() = std::move(filter).as_proto();
+
+  // The attempts coordinate through this state: the first one to
+  // complete (or the last one to fail permanently) records the result
+  // and cancels its peer. The `contexts` slots expose each attempt's
+  // in-flight `grpc::ClientContext` so the winner can `TryCancel()`
+  // the loser; `grpc::ClientContext::TryCancel()` is thread-safe.
+  struct HedgeState {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    int launched = 1;
+    int failed = 0;
+    StatusOr<std::pair<bool, Row>> result;
+    grpc::ClientContext* contexts[2] = {nullptr, nullptr};
+  };
+  auto state = std::make_shared<HedgeState>();
+
+  // Each attempt runs the full retry loop with its own policies. The
+  // pooled `DataClient` rotates channels between calls, so the hedged
+  // attempt lands on a different connection (and typically a different
+  // tablet server frontend) than the primary.
+  auto attempt = [this, &request, state](int index) {
+    // Cloned lazily on the first failure, each attempt carries its own
+    // retry state.
+    std::unique_ptr<RPCRetryPolicy> rpc_policy;
+    std::unique_ptr<RPCBackoffPolicy> backoff_policy;
+    while (true) {
+      grpc::ClientContext client_context;
+      {
+        std::lock_guard<std::mutex> lk(state->mu);
+        if (state->done) {
+          return;
+        }
+        state->contexts[index] = &client_context;
+      }
+      (rpc_policy ? *rpc_policy : *rpc_retry_policy_prototype_)
+          .Setup(client_context);
+      (backoff_policy ? *backoff_policy : *rpc_backoff_policy_prototype_)
+          .Setup(client_context);
+      metadata_update_policy_.Setup(client_context);
+
+      std::pair<bool, Row> result(false, Row("", {}));
+      internal::RecordAttemptLatency attempt(
+          internal::RpcMetrics::Method::kReadRow);
+      auto status = ReadRowAttempt(request, client_context, result);
+      attempt.Record(status.ok());
+
+      std::unique_lock<std::mutex> lk(state->mu);
+      state->contexts[index] = nullptr;
+      if (state->done) {
+        return;
+      }
+      if (status.ok()) {
+        state->done = true;
+        state->result = std::move(result);
+        if (state->contexts[1 - index] != nullptr) {
+          state->contexts[1 - index]->TryCancel();
+        }
+        state->cv.notify_all();
+        return;
+      }
+      if (!rpc_policy) {
+        rpc_policy = rpc_retry_policy_prototype_->clone();
+        backoff_policy = rpc_backoff_policy_prototype_->clone();
+      }
+      if (!rpc_policy->OnFailure(status)) {
+        // The operation fails only when every launched attempt has
+        // failed; otherwise leave the outcome to the peer.
+        if (++state->failed == state->launched) {
+          state->done = true;
+          state->result = MakeStatusFromRpcError(status);
+          state->cv.notify_all();
+        }
+        return;
+      }
+      auto delay = backoff_policy->OnCompletion(status);
+      // An interruptible backoff: stop sleeping if the peer finishes.
+      state->cv.wait_for(lk, delay, [&state] { return state->done; });
+      if (state->done) {
+        return;
+      }
+    }
+  };
+
+  std::thread primary(attempt, 0);
+  bool launch_hedge = false;
+  {
+    std::unique_lock<std::mutex> lk(state->mu);
+    state->cv.wait_for(lk, hedging_delay, [&state] { return state->done; });
+    if (!state->done) {
+      state->launched = 2;
+      launch_hedge = true;
+    }
   }
-  auto result = std::make_pair(true, std::move(**it));
-  if (++it != reader.end()) {
-    return Status(StatusCode::kInternal,
-                  "internal error - RowReader returned 2 rows in ReadRow()");
+  if (launch_hedge) {
+    // Run the hedged attempt on the calling thread, no need for a
+    // second one.
+    attempt(1);
+    std::unique_lock<std::mutex> lk(state->mu);
+    state->cv.wait(lk, [&state] { return state->done; });
   }
-  return result;
+  primary.join();
+  return std::move(state->result);
 }
 
 StatusOr<MutationBranch> Table::CheckAndMutateRow(
@@ -233,8 +623,8 @@ StatusOr<MutationBranch> Table::CheckAndMutateRow(
   }
   bool const is_idempotent =
       idempotent_mutation_policy_->is_idempotent(request);
-  auto response = ClientUtils::MakeCall(
-      *client_, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+  auto response = ClientUtils::MakeCallFromPrototypes(
+      *client_, *rpc_retry_policy_prototype_, *rpc_backoff_policy_prototype_,
       metadata_update_policy_, &DataClient::CheckAndMutateRow, request,
       "Table::CheckAndMutateRow", status, is_idempotent);
 
@@ -308,7 +698,10 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
     retry_policy->Setup(client_context);
     clone_metadata_update_policy().Setup(client_context);
 
-    auto stream = client_->SampleRowKeys(&client_context, request);
+    internal::RecordAttemptLatency attempt(
+        internal::RpcMetrics::Method::kSampleRowKeys);
+    auto stream = client_->SampleRowKeys(&client_context, request,
+                                         TrafficClass::kBulk);
     while (stream->Read(&response)) {
       bigtable::RowKeySample row_sample;
       row_sample.offset_bytes = response.offset_bytes();
@@ -316,6 +709,7 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
       samples.emplace_back(std::move(row_sample));
     }
     auto status = stream->Finish();
+    attempt.Record(status.ok());
     if (status.ok()) {
       break;
     }
@@ -324,6 +718,8 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
           status.error_code(),
           "Retry policy exhausted: " + status.error_message());
     }
+    internal::RpcMetrics::Instance().RecordRetry(
+        internal::RpcMetrics::Method::kSampleRowKeys);
     samples.clear();
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
@@ -331,6 +727,59 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
   return samples;
 }
 
+StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows(
+    std::chrono::milliseconds max_age) {
+  auto entry = RowKeySampleCacheFor(table_name_ + "#" + app_profile_id_);
+  auto const now = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lk(entry->mu);
+    if (entry->valid && now - entry->fetched <= max_age) {
+      auto samples = entry->samples;
+      // Once the entry is past half its allowed age start a background
+      // refresh, so steady-state callers never see a cache miss. The
+      // `refreshing` flag ensures a single refresh at a time.
+      bool const start_refresh =
+          now - entry->fetched > max_age / 2 && !entry->refreshing;
+      if (start_refresh) {
+        entry->refreshing = true;
+      }
+      lk.unlock();
+      if (start_refresh) {
+        Table table(*this);
+        std::function<void()> refresh = [table, entry]() mutable {
+          auto fresh = table.SampleRows();
+          std::lock_guard<std::mutex> lk(entry->mu);
+          entry->refreshing = false;
+          if (fresh) {
+            entry->samples = *std::move(fresh);
+            entry->fetched = std::chrono::steady_clock::now();
+            entry->valid = true;
+          }
+        };
+        auto executor = client_->background_executor();
+        if (executor) {
+          executor(std::move(refresh));
+        } else {
+          std::thread(std::move(refresh)).detach();
+        }
+      }
+      return samples;
+    }
+  }
+  // A miss (or an entry past its maximum age) pays for the RPC and
+  // repopulates the cache. Concurrent misses each issue their own RPC;
+  // that only happens on the first call and after idle periods.
+  auto fresh = SampleRows();
+  if (!fresh) {
+    return fresh;
+  }
+  std::lock_guard<std::mutex> lk(entry->mu);
+  entry->samples = *fresh;
+  entry->fetched = std::chrono::steady_clock::now();
+  entry->valid = true;
+  return fresh;
+}
+
 StatusOr<Row> Table::ReadModifyWriteRowImpl(
     btproto::ReadModifyWriteRowRequest request) {
   SetCommonTableOperationRequest<
@@ -339,7 +788,7 @@ StatusOr<Row> Table::ReadModifyWriteRowImpl(
 
   grpc::Status status;
   auto response = ClientUtils::MakeNonIdemponentCall(
-      *(client_), clone_rpc_retry_policy(), clone_metadata_update_policy(),
+      *(client_), *rpc_retry_policy_prototype_, metadata_update_policy_,
       &DataClient::ReadModifyWriteRow, request, "ReadModifyWriteRowRequest",
       status);
   if (!status.ok()) {
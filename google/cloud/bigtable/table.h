@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 
 #include "google/cloud/bigtable/async_row_reader.h"
+#include "google/cloud/bigtable/cell_visitor.h"
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
@@ -33,6 +34,7 @@
 #include "google/cloud/internal/disjunction.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -50,6 +52,10 @@ enum class MutationBranch {
 
 class MutationBatcher;
 
+namespace internal {
+class BulkMutator;
+}  // namespace internal
+
 /**
  * Return the full table name.
  *
@@ -417,6 +423,47 @@ class Table {
    */
   std::vector<FailedMutation> BulkApply(BulkMutation mut);
 
+  /**
+   * Attempts to apply an arena-backed bulk mutation to multiple rows.
+   *
+   * The arena-owned request proto is sent in place, no mutation is
+   * copied out of the arena. See `ArenaBulkMutation` for when to prefer
+   * this overload over `BulkApply(BulkMutation)`.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership of the arena holding the mutations, the data is
+   *     discarded when the call completes.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent. Note
+   * that `ArenaBulkMutation::SetCell()` without an explicit timestamp is
+   * **not** an idempotent operation.
+   */
+  std::vector<FailedMutation> BulkApply(ArenaBulkMutation mut);
+
+  /**
+   * Attempts to apply mutations to multiple rows, streaming the successes.
+   *
+   * Identical to `BulkApply(BulkMutation)` except that @p on_success is
+   * invoked with the original index of each mutation as its acknowledgment
+   * arrives, and the memory of an acknowledged mutation is released
+   * immediately rather than held until the last retry completes. The
+   * footprint of a large bulk load is then bounded by its unacknowledged
+   * mutations only.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   * @param on_success invoked, from the thread calling this function, with
+   *     the index each mutation had in @p mut as the server confirms it.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent.
+   * Note that `google::cloud::bigtable::SetCell()` without an explicit
+   * timestamp is **not** an idempotent operation.
+   */
+  std::vector<FailedMutation> BulkApply(BulkMutation mut,
+                                        std::function<void(int)> on_success);
+
   /**
    * Makes asynchronous attempts to apply mutations to multiple rows.
    *
@@ -475,6 +522,99 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Reads a set of rows from the table using a pre-compiled filter.
+   *
+   * @param row_set the rows to read from.
+   * @param filter a `CompiledFilter`, serialized once and reused across
+   *     requests.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  RowReader ReadRows(RowSet row_set, CompiledFilter const& filter) {
+    return ReadRows(std::move(row_set), filter.Materialize());
+  }
+
+  /**
+   * Reads a limited set of rows from the table using a pre-compiled filter.
+   *
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read. Cannot be a negative
+   *     number or zero. Use `ReadRows(RowSet, CompiledFilter const&)` to read
+   *     all matching rows.
+   * @param filter a `CompiledFilter`, serialized once and reused across
+   *     requests.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  RowReader ReadRows(RowSet row_set, std::int64_t rows_limit,
+                     CompiledFilter const& filter) {
+    return ReadRows(std::move(row_set), rows_limit, filter.Materialize());
+  }
+
+  /**
+   * Resume a scan from a checkpoint created by `RowReader::Checkpoint()`.
+   *
+   * @param checkpoint an opaque checkpoint with the rows (and rows-limit)
+   *     left to scan, possibly created in a different process.
+   * @param filter is applied on the server-side to data in the rows. The
+   *     filter is not part of the checkpoint, pass the same filter used in
+   *     the original scan.
+   * @returns the reader for the remaining rows, or
+   *     `StatusCode::kInvalidArgument` if @p checkpoint cannot be parsed.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  StatusOr<RowReader> ResumeScan(std::string const& checkpoint, Filter filter);
+
+  /**
+   * Reuse @p reader for a new scan over @p row_set.
+   *
+   * Applications that issue many small scans against the same hot
+   * tablets pay the `RowReader` setup cost — policy clones, parser
+   * factory, filter conversion, response buffers — on every
+   * `ReadRows()` call. Restarting a reader obtained from `ReadRows()`
+   * keeps those parts and only opens a new stream; gRPC does not permit
+   * reusing the call object or `grpc::ClientContext` itself. The new
+   * scan uses the filter the reader was created with and fresh clones
+   * of this table's retry and backoff policies.
+   *
+   * @param reader a reader previously returned by `ReadRows()` on this
+   *     table; any unfinished scan on it is cancelled.
+   * @param row_set the rows to read in the new scan.
+   * @param rows_limit the maximum number of rows to read, zero means
+   *     "no limit".
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  void RestartScan(RowReader& reader, RowSet row_set,
+                   std::int64_t rows_limit = RowReader::NO_ROWS_LIMIT);
+
+  /**
+   * Scan rows, passing each cell to @p visitor without building rows.
+   *
+   * Scan-and-aggregate jobs that fold each cell into an accumulator and
+   * discard it do not need owned `Row` or `Cell` objects. This member
+   * function streams the scan through @p visitor as borrowed references
+   * into the scan buffers instead, constructing no rows or cells. See
+   * `CellVisitor` for the callback contract, including how re-delivery
+   * after transient failures is signaled.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param visitor receives every cell, must outlive the call.
+   *
+   * @return the final status of the scan, after retries.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  Status ScanRows(RowSet row_set, Filter filter, CellVisitor& visitor);
+
   /**
    * Read and return a single row from the table.
    *
@@ -494,6 +634,48 @@ class Table {
    */
   StatusOr<std::pair<bool, Row>> ReadRow(std::string row_key, Filter filter);
 
+  /**
+   * Read and return a single row from the table using a pre-compiled filter.
+   *
+   * @param row_key the row to read.
+   * @param filter a `CompiledFilter`, serialized once and reused across
+   *     requests.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  StatusOr<std::pair<bool, Row>> ReadRow(std::string row_key,
+                                         CompiledFilter const& filter) {
+    return ReadRow(std::move(row_key), filter.Materialize());
+  }
+
+  /**
+   * Read a single row, hedging the request against tail latency.
+   *
+   * Issues the read immediately and, if no response has arrived after
+   * @p hedging_delay, issues a second identical read on a different
+   * connection from the channel pool. The first attempt to complete
+   * wins and the other is cancelled. The operation only fails when
+   * both attempts fail.
+   *
+   * Set @p hedging_delay around the observed p99 latency of point
+   * reads: slower and the hedge rarely helps, faster and most calls
+   * send a wasted duplicate RPC. Because the read is issued twice,
+   * only use this with app profiles where duplicate reads are safe.
+   *
+   * @param row_key the row to read.
+   * @param filter a filter expression, can be used to select a subset of the
+   *     column families and columns in the row.
+   * @param hedging_delay how long to wait before sending the second
+   *     request.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  StatusOr<std::pair<bool, Row>> ReadRow(
+      std::string row_key, Filter filter,
+      std::chrono::milliseconds hedging_delay);
+
   /**
    * Atomic test-and-set for a row using filter expressions.
    *
@@ -566,6 +748,29 @@ class Table {
    */
   StatusOr<std::vector<bigtable::RowKeySample>> SampleRows();
 
+  /**
+   * Sample of the row keys in the table, served from a cache when fresh.
+   *
+   * Parallel jobs call `SampleRows()` repeatedly to partition work, and
+   * each call is a full streaming RPC. This overload shares a
+   * process-wide cache between every `Table` object addressing the same
+   * table and application profile: samples no older than @p max_age are
+   * returned straight from memory, and once a cached entry is past half
+   * its allowed age a background refresh starts, so steady-state callers
+   * keep hitting the cache. A miss (or an entry older than @p max_age)
+   * falls back to the RPC and repopulates the cache.
+   *
+   * Note that row key samples are approximate by nature, serving
+   * slightly stale samples does not change their guarantees.
+   *
+   * @param max_age maximum acceptable age of the cached samples.
+   *
+   * @par Idempotency
+   * This operation is always treated as non-idempotent.
+   */
+  StatusOr<std::vector<bigtable::RowKeySample>> SampleRows(
+      std::chrono::milliseconds max_age);
+
   /**
    * Atomically read and modify the row in the server, returning the
    * resulting row
@@ -670,6 +875,8 @@ class Table {
    *     results are undefined
    * @param row_set the rows to read from.
    * @param filter is applied on the server-side to data in the rows.
+   * @param options (optional) tuning knobs for the call, e.g. the
+   *     readahead watermarks, see `AsyncRowReaderOptions`.
    *
    * @tparam RowFunctor the type of the @p on_row callback.
    * @tparam FinishFunctor the type of the @p on_finish callback.
@@ -679,7 +886,8 @@ class Table {
    */
   template <typename RowFunctor, typename FinishFunctor>
   void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
-                     FinishFunctor on_finish, RowSet row_set, Filter filter) {
+                     FinishFunctor on_finish, RowSet row_set, Filter filter,
+                     AsyncRowReaderOptions options = AsyncRowReaderOptions()) {
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set),
@@ -687,7 +895,8 @@ class Table {
         std::move(filter), clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
         metadata_update_policy_,
         google::cloud::internal::make_unique<
-            bigtable::internal::ReadRowsParserFactory>());
+            bigtable::internal::ReadRowsParserFactory>(),
+        std::move(options));
   }
 
   /**
@@ -714,6 +923,8 @@ class Table {
    *     number or zero. Use `AsyncReadRows(CompletionQueue, RowSet, Filter)` to
    *     read all matching rows.
    * @param filter is applied on the server-side to data in the rows.
+   * @param options (optional) tuning knobs for the call, e.g. the
+   *     readahead watermarks, see `AsyncRowReaderOptions`.
    *
    * @tparam RowFunctor the type of the @p on_row callback.
    * @tparam FinishFunctor the type of the @p on_finish callback.
@@ -724,14 +935,16 @@ class Table {
   template <typename RowFunctor, typename FinishFunctor>
   void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
                      FinishFunctor on_finish, RowSet row_set,
-                     std::int64_t rows_limit, Filter filter) {
+                     std::int64_t rows_limit, Filter filter,
+                     AsyncRowReaderOptions options = AsyncRowReaderOptions()) {
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set), rows_limit, std::move(filter),
         clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
         metadata_update_policy_,
         google::cloud::internal::make_unique<
-            bigtable::internal::ReadRowsParserFactory>());
+            bigtable::internal::ReadRowsParserFactory>(),
+        std::move(options));
   }
 
   /**
@@ -766,6 +979,32 @@ class Table {
                                                       Filter filter);
 
  private:
+  /// The retry loop shared by the `BulkApply()` overloads.
+  std::vector<FailedMutation> BulkApplyImpl(
+      internal::BulkMutator& mutator,
+      std::function<void(int)> const& on_success = std::function<void(int)>{});
+
+  /**
+   * Enable per-call compression when the request is large enough.
+   *
+   * A no-op unless the application configured
+   * `ClientOptions::set_call_compression_algorithm()`; requests smaller
+   * than `ClientOptions::call_compression_threshold()` skip compression.
+   */
+  void SetupCompression(grpc::ClientContext& context,
+                        std::size_t request_size);
+
+  /**
+   * One attempt of a point read, shared by the `ReadRow()` overloads.
+   *
+   * On success @p result is set to the `ReadRow()` return value. The
+   * caller owns @p client_context so hedged reads can cancel an
+   * attempt that lost the race.
+   */
+  grpc::Status ReadRowAttempt(
+      ::google::bigtable::v2::ReadRowsRequest const& request,
+      grpc::ClientContext& client_context, std::pair<bool, Row>& result);
+
   /**
    * Send request ReadModifyWriteRowRequest to modify the row and get it back
    */
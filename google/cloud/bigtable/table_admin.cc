@@ -107,35 +107,65 @@ future<StatusOr<google::bigtable::admin::v2::Table>> TableAdmin::AsyncGetTable(
 
 StatusOr<std::vector<btadmin::Table>> TableAdmin::ListTables(
     btadmin::Table::View view) {
-  grpc::Status status;
+  std::vector<btadmin::Table> result;
+  auto status = ListTables(
+      view, [&result](btadmin::Table table) {
+        result.emplace_back(std::move(table));
+      });
+  if (!status.ok()) {
+    return status;
+  }
+  return result;
+}
 
+Status TableAdmin::ListTables(
+    btadmin::Table::View view,
+    std::function<void(btadmin::Table)> const& on_table) {
   // Copy the policies in effect for the operation.
   auto rpc_policy = clone_rpc_retry_policy();
   auto backoff_policy = clone_rpc_backoff_policy();
 
-  // Build the RPC request, try to minimize copying.
-  std::vector<btadmin::Table> result;
-  std::string page_token;
-  do {
+  // The page tokens force the pages to be requested in order, but the
+  // fetch of page N+1 can start as soon as the token on page N arrives,
+  // and overlap with the `on_table` callbacks for page N. The policies
+  // are shared across pages (as in the non-streaming overload), which
+  // is safe because at most one fetch runs at a time.
+  auto fetch =
+      [this, &rpc_policy, &backoff_policy,
+       view](std::string page_token) -> StatusOr<btadmin::ListTablesResponse> {
     btadmin::ListTablesRequest request;
     request.set_page_token(std::move(page_token));
     request.set_parent(instance_name());
     request.set_view(view);
 
+    grpc::Status status;
     auto response = ClientUtils::MakeCall(
         *client_, *rpc_policy, *backoff_policy, clone_metadata_update_policy(),
         &AdminClient::ListTables, request, "TableAdmin", status, true);
-
     if (!status.ok()) {
       return MakeStatusFromRpcError(status);
     }
+    return response;
+  };
 
-    for (auto& x : *response.mutable_tables()) {
-      result.emplace_back(std::move(x));
+  auto page = fetch(std::string{});
+  while (true) {
+    if (!page) {
+      return page.status();
     }
-    page_token = std::move(*response.mutable_next_page_token());
-  } while (!page_token.empty());
-  return result;
+    std::string page_token = std::move(*page->mutable_next_page_token());
+    std::future<StatusOr<btadmin::ListTablesResponse>> next;
+    if (!page_token.empty()) {
+      next = std::async(std::launch::async, fetch, std::move(page_token));
+    }
+    for (auto& x : *page->mutable_tables()) {
+      on_table(std::move(x));
+    }
+    if (!next.valid()) {
+      return Status();
+    }
+    page = next.get();
+  }
 }
 
 future<StatusOr<std::vector<btadmin::Table>>> TableAdmin::AsyncListTables(
@@ -364,6 +394,11 @@ TableAdmin::AsyncWaitForConsistency(CompletionQueue& cq,
     void OnCheckConsistency(StatusOr<Consistency> consistent) {
       auto self = shared_from_this();
       if (consistent && *consistent == Consistency::kConsistent) {
+        // Let adaptive policies learn how long this table took to
+        // converge, so later waits can schedule their probes tightly.
+        polling_policy_->OnSuccess(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_));
         promise_.set_value(*consistent);
         return;
       }
@@ -389,6 +424,8 @@ TableAdmin::AsyncWaitForConsistency(CompletionQueue& cq,
     TableAdmin table_admin_;
     std::unique_ptr<PollingPolicy> polling_policy_;
     google::cloud::promise<StatusOr<Consistency>> promise_;
+    std::chrono::steady_clock::time_point start_ =
+        std::chrono::steady_clock::now();
   };
 
   return AsyncWaitForConsistencyState::Create(cq, table_id, consistency_token,
@@ -25,6 +25,7 @@
 #include "google/cloud/future.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/status_or.h"
+#include <functional>
 #include <future>
 #include <memory>
 
@@ -275,6 +276,33 @@ class TableAdmin {
   StatusOr<std::vector<::google::bigtable::admin::v2::Table>> ListTables(
       ::google::bigtable::admin::v2::Table::View view);
 
+  /**
+   * Return all the tables in the instance, streaming the results.
+   *
+   * Invokes @p on_table once per table, as the pages arrive from the
+   * service. While the callbacks for one page run the next page is
+   * already being fetched on a background thread, so with many pages
+   * the listing completes in roughly the time of the page fetches
+   * alone. Prefer this overload over `ListTables()` for instances with
+   * thousands of tables, the first results arrive after one page
+   * instead of after the whole listing.
+   *
+   * @param view describes how much information to get about the name.
+   *   - VIEW_UNSPECIFIED: equivalent to VIEW_SCHEMA.
+   *   - NAME: return only the name of the table.
+   *   - VIEW_SCHEMA: return the name and the schema.
+   *   - FULL: return all the information about the table.
+   * @param on_table invoked once per table, in the order the service
+   *     returns them. No callbacks are invoked after a page fails.
+   *
+   * @par Idempotency
+   * This operation is read-only and therefore it is always idempotent.
+   */
+  Status ListTables(
+      ::google::bigtable::admin::v2::Table::View view,
+      std::function<void(::google::bigtable::admin::v2::Table)> const&
+          on_table);
+
   /**
    * Sends an asynchronous request to get all the tables in the instance.
    *
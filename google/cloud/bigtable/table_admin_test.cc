@@ -151,6 +151,29 @@ TEST_F(TableAdminTest, ListTables) {
   EXPECT_EQ(instance_name + "/tables/t1", v[1].name());
 }
 
+/// @test Verify the streaming `ListTables()` overload delivers all pages.
+TEST_F(TableAdminTest, ListTablesStreaming) {
+  using namespace ::testing;
+
+  bigtable::TableAdmin tested(client_, kInstanceId);
+  auto page0 = create_list_tables_lambda("", "token-1", {"t0", "t1"});
+  auto page1 = create_list_tables_lambda("token-1", "", {"t2"});
+  EXPECT_CALL(*client_, ListTables(_, _, _))
+      .WillOnce(Invoke(page0))
+      .WillOnce(Invoke(page1));
+
+  std::vector<std::string> names;
+  auto status = tested.ListTables(
+      btadmin::Table::FULL,
+      [&names](btadmin::Table table) { names.push_back(table.name()); });
+  ASSERT_STATUS_OK(status);
+  std::string instance_name = tested.instance_name();
+  ASSERT_EQ(3UL, names.size());
+  EXPECT_EQ(instance_name + "/tables/t0", names[0]);
+  EXPECT_EQ(instance_name + "/tables/t1", names[1]);
+  EXPECT_EQ(instance_name + "/tables/t2", names[2]);
+}
+
 /// @test Verify that `bigtable::TableAdmin::ListTables` handles failures.
 TEST_F(TableAdminTest, ListTablesRecoverableFailures) {
   using namespace ::testing;
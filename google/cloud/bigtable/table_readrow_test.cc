@@ -17,6 +17,8 @@
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/testing_util/assert_ok.h"
+#include <chrono>
+#include <future>
 
 namespace bigtable = google::cloud::bigtable;
 
@@ -118,3 +120,188 @@ TEST_F(TableReadRowTest, UnrecoverableFailure) {
   auto row = table_.ReadRow("r1", bigtable::Filter::PassAllFilter());
   EXPECT_FALSE(row);
 }
+
+TEST_F(TableReadRowTest, RecoverableFailure) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  auto failing_stream =
+      google::cloud::internal::make_unique<MockReadRowsReader>(
+          "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*failing_stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*failing_stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try again")));
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>(
+      "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&failing_stream](grpc::ClientContext* context,
+                                         btproto::ReadRowsRequest const&) {
+        EXPECT_STATUS_OK(google::cloud::bigtable::testing::IsContextMDValid(
+            *context, "google.bigtable.v2.Bigtable.ReadRows"));
+        return failing_stream.release()->AsUniqueMocked();
+      }))
+      .WillOnce(Invoke([&stream](grpc::ClientContext* context,
+                                 btproto::ReadRowsRequest const& req) {
+        EXPECT_STATUS_OK(google::cloud::bigtable::testing::IsContextMDValid(
+            *context, "google.bigtable.v2.Bigtable.ReadRows"));
+        EXPECT_EQ(1, req.rows().row_keys_size());
+        EXPECT_EQ("r1", req.rows().row_keys(0));
+        EXPECT_EQ(1, req.rows_limit());
+        return stream.release()->AsUniqueMocked();
+      }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  ASSERT_STATUS_OK(result);
+  EXPECT_TRUE(std::get<0>(*result));
+  EXPECT_EQ("r1", std::get<1>(*result).row_key());
+}
+
+/// @test Verify that a fast primary read never launches the hedge.
+TEST_F(TableReadRowTest, HedgedReadRowPrimaryWins) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>(
+      "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  // The mock would fail the test if the hedged attempt issued a
+  // second RPC.
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&stream](grpc::ClientContext* context,
+                                 btproto::ReadRowsRequest const&) {
+        EXPECT_STATUS_OK(google::cloud::bigtable::testing::IsContextMDValid(
+            *context, "google.bigtable.v2.Bigtable.ReadRows"));
+        return stream.release()->AsUniqueMocked();
+      }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter(),
+                               std::chrono::milliseconds(3600 * 1000));
+  ASSERT_STATUS_OK(result);
+  EXPECT_TRUE(std::get<0>(*result));
+  EXPECT_EQ("r1", std::get<1>(*result).row_key());
+}
+
+/// @test Verify that the hedged attempt can win the race.
+TEST_F(TableReadRowTest, HedgedReadRowHedgeWins) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  // The primary attempt blocks in `Read()` until the hedged attempt
+  // has produced its row, then behaves as a cancelled stream.
+  std::promise<void> hedge_responded;
+  std::shared_future<void> hedge_done(hedge_responded.get_future());
+  auto slow_stream = google::cloud::internal::make_unique<MockReadRowsReader>(
+      "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*slow_stream, Read(_))
+      .WillOnce(Invoke([hedge_done](btproto::ReadRowsResponse*) {
+        hedge_done.wait();
+        return false;
+      }));
+  EXPECT_CALL(*slow_stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::CANCELLED, "cancelled")));
+
+  auto fast_stream = google::cloud::internal::make_unique<MockReadRowsReader>(
+      "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*fast_stream, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Invoke([&hedge_responded](btproto::ReadRowsResponse*) {
+        hedge_responded.set_value();
+        return false;
+      }));
+  EXPECT_CALL(*fast_stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&slow_stream](grpc::ClientContext*,
+                                      btproto::ReadRowsRequest const&) {
+        return slow_stream.release()->AsUniqueMocked();
+      }))
+      .WillOnce(Invoke([&fast_stream](grpc::ClientContext*,
+                                      btproto::ReadRowsRequest const&) {
+        return fast_stream.release()->AsUniqueMocked();
+      }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter(),
+                               std::chrono::milliseconds(1));
+  ASSERT_STATUS_OK(result);
+  EXPECT_TRUE(std::get<0>(*result));
+  EXPECT_EQ("r1", std::get<1>(*result).row_key());
+}
+
+/// @test Verify that a permanent failure stops the hedged read.
+TEST_F(TableReadRowTest, HedgedReadRowPermanentFailure) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>(
+      "google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh oh")));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(
+          [&stream](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return stream.release()->AsUniqueMocked();
+          }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter(),
+                               std::chrono::milliseconds(3600 * 1000));
+  EXPECT_FALSE(result);
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied,
+            result.status().code());
+}
@@ -147,3 +147,105 @@ TEST_F(TableReadRowsTest, ReadRowsThrowsWhenTooManyErrors) {
   ++it;
   ASSERT_EQ(reader.end(), it);
 }
+
+TEST_F(TableReadRowsTest, ResumeScanReadsRemainingRows) {
+  namespace btproto = ::google::bigtable::v2;
+  btproto::ReadRowsRequest checkpoint;
+  checkpoint.mutable_rows()->add_row_ranges()->set_start_key_open("r1");
+  checkpoint.set_rows_limit(2);
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+
+  // must be a new pointer, it is wrapped in unique_ptr by ReadRows
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&stream](grpc::ClientContext*,
+                                 btproto::ReadRowsRequest req) {
+        EXPECT_EQ(2, req.rows_limit());
+        EXPECT_EQ(1, req.rows().row_ranges_size());
+        EXPECT_EQ("r1", req.rows().row_ranges(0).start_key_open());
+        return stream->AsUniqueMocked();
+      }));
+
+  auto reader = table_.ResumeScan(checkpoint.SerializeAsString(),
+                                  bigtable::Filter::PassAllFilter());
+  ASSERT_STATUS_OK(reader);
+
+  auto it = reader->begin();
+  EXPECT_NE(it, reader->end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r2");
+  EXPECT_EQ(++it, reader->end());
+}
+
+TEST_F(TableReadRowsTest, ResumeScanRejectsInvalidCheckpoint) {
+  auto reader = table_.ResumeScan(std::string(4, '\xff'),
+                                  bigtable::Filter::PassAllFilter());
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            reader.status().code());
+}
+
+TEST_F(TableReadRowsTest, ScanRowsVisitsCellsWithoutRows) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v1"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 43000
+        value: "v2"
+        commit_row: true
+      }
+      )");
+
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+
+  class Accumulator : public bigtable::CellVisitor {
+   public:
+    void OnCell(bigtable::RowKeyType const& row_key, std::string const&,
+                bigtable::ColumnQualifierType const&, std::int64_t,
+                bigtable::CellValueType const& value,
+                std::vector<std::string> const&) override {
+      visited.push_back(std::string(row_key) + "=" + std::string(value));
+    }
+    void OnRowCommitted(bigtable::RowKeyType const& row_key) override {
+      committed.push_back(std::string(row_key));
+    }
+    std::vector<std::string> visited;
+    std::vector<std::string> committed;
+  };
+
+  Accumulator accumulator;
+  auto status = table_.ScanRows(bigtable::RowSet(),
+                                bigtable::Filter::PassAllFilter(), accumulator);
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(std::vector<std::string>({"r1=v1", "r2=v2"}),
+            accumulator.visited);
+  EXPECT_EQ(std::vector<std::string>({"r1", "r2"}), accumulator.committed);
+}
@@ -191,3 +191,41 @@ TEST_F(TableSampleRowKeysTest, TooManyFailures) {
   EXPECT_FALSE(custom_table.SampleRows());
 }
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+/// @test Verify that the cached overload only issues one RPC while fresh.
+TEST_F(TableSampleRowKeysTest, CachedSamples) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  // Use a table name not shared with other tests, the cache is
+  // process-wide and keyed by table name.
+  ::bigtable::Table table(client_, "sample-row-keys-cache-test");
+
+  auto reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key("test1");
+        r->set_offset_bytes(11);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto const max_age = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::hours(1));
+  auto result = table.SampleRows(max_age);
+  ASSERT_STATUS_OK(result);
+  ASSERT_EQ(1U, result->size());
+  EXPECT_EQ("test1", result->begin()->row_key);
+
+  // Well within `max_age` the second call is served from the cache; the
+  // mock would fail the test if another RPC were issued.
+  auto cached = table.SampleRows(max_age);
+  ASSERT_STATUS_OK(cached);
+  ASSERT_EQ(1U, cached->size());
+  EXPECT_EQ("test1", cached->begin()->row_key);
+  EXPECT_EQ(11, cached->begin()->offset_bytes);
+}
@@ -0,0 +1,51 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/client_options.h"
+#include "google/cloud/internal/getenv.h"
+
+namespace {
+std::shared_ptr<grpc::ChannelCredentials> FirestoreDefaultCredentials() {
+  auto emulator = google::cloud::internal::GetEnv("FIRESTORE_EMULATOR_HOST");
+  if (emulator.has_value()) {
+    return grpc::InsecureChannelCredentials();
+  }
+  return grpc::GoogleDefaultCredentials();
+}
+
+// The streaming read RPCs are long-lived; a handful of connections is
+// enough to avoid head-of-line blocking between concurrent streams
+// without opening connections most applications never use.
+std::size_t constexpr kDefaultConnectionPoolSize = 4;
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace firestore {
+
+ClientOptions::ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds)
+    : endpoint_("firestore.googleapis.com"),
+      credentials_(std::move(creds)),
+      connection_pool_size_(kDefaultConnectionPoolSize) {}
+
+ClientOptions::ClientOptions() : ClientOptions(FirestoreDefaultCredentials()) {
+  auto emulator = google::cloud::internal::GetEnv("FIRESTORE_EMULATOR_HOST");
+  if (emulator.has_value()) {
+    endpoint_ = *std::move(emulator);
+  }
+}
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
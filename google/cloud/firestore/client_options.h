@@ -0,0 +1,112 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_CLIENT_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_CLIENT_OPTIONS_H
+
+#include <grpcpp/grpcpp.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+/**
+ * Configuration options for the Firestore client.
+ *
+ * Applications typically configure the credentials, and sometimes the
+ * size of the connection pool used for the streaming read RPCs.
+ */
+class ClientOptions {
+ public:
+  /**
+   * Initialize the client options with the default credentials.
+   *
+   * @par Environment Variables
+   * If the `FIRESTORE_EMULATOR_HOST` environment variable is set the
+   * default configuration changes in important ways:
+   *
+   * - The credentials are initialized to `grpc::InsecureCredentials()`.
+   * - Any client created with these options will connect to the endpoint
+   *   (typically just a `host:port` string) set in the environment
+   *   variable.
+   *
+   * This makes it easy to test applications using the Cloud Firestore
+   * emulator.
+   */
+  ClientOptions();
+
+  /**
+   * Connect to the production instance of Cloud Firestore using @p creds.
+   *
+   * This constructor always connects to the production service, and can
+   * be used when the application default credentials are not configured
+   * in the environment where the application is running.
+   */
+  explicit ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds);
+
+  /// Return the current endpoint for Firestore RPCs.
+  std::string const& endpoint() const { return endpoint_; }
+  ClientOptions& set_endpoint(std::string endpoint) {
+    endpoint_ = std::move(endpoint);
+    return *this;
+  }
+
+  /// Return the current credentials.
+  std::shared_ptr<grpc::ChannelCredentials> credentials() const {
+    return credentials_;
+  }
+  ClientOptions& set_credentials(
+      std::shared_ptr<grpc::ChannelCredentials> credentials) {
+    credentials_ = std::move(credentials);
+    return *this;
+  }
+
+  /**
+   * Return the number of connections in the pool.
+   *
+   * gRPC opens a single connection for each destination. The streaming
+   * read RPCs (`BatchGetDocuments()` and `RunQuery()`) are long-lived
+   * and response-heavy, spreading them over multiple connections
+   * improves throughput.
+   */
+  std::size_t connection_pool_size() const { return connection_pool_size_; }
+  ClientOptions& set_connection_pool_size(std::size_t size) {
+    connection_pool_size_ = size == 0 ? 1U : size;
+    return *this;
+  }
+
+  /// Return the channel arguments for new channels.
+  grpc::ChannelArguments channel_arguments() const {
+    return channel_arguments_;
+  }
+  ClientOptions& set_channel_arguments(
+      grpc::ChannelArguments channel_arguments) {
+    channel_arguments_ = std::move(channel_arguments);
+    return *this;
+  }
+
+ private:
+  std::string endpoint_;
+  std::shared_ptr<grpc::ChannelCredentials> credentials_;
+  std::size_t connection_pool_size_;
+  grpc::ChannelArguments channel_arguments_;
+};
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_CLIENT_OPTIONS_H
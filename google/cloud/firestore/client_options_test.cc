@@ -0,0 +1,43 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/client_options.h"
+#include <gtest/gtest.h>
+
+using google::cloud::firestore::ClientOptions;
+
+TEST(ClientOptionsTest, Defaults) {
+  auto creds = grpc::InsecureChannelCredentials();
+  ClientOptions options(creds);
+  EXPECT_EQ("firestore.googleapis.com", options.endpoint());
+  EXPECT_EQ(creds.get(), options.credentials().get());
+  EXPECT_NE(0U, options.connection_pool_size());
+}
+
+TEST(ClientOptionsTest, Setters) {
+  ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_endpoint("localhost:8080").set_connection_pool_size(7);
+  EXPECT_EQ("localhost:8080", options.endpoint());
+  EXPECT_EQ(7U, options.connection_pool_size());
+
+  auto creds = grpc::InsecureChannelCredentials();
+  options.set_credentials(creds);
+  EXPECT_EQ(creds.get(), options.credentials().get());
+}
+
+TEST(ClientOptionsTest, ZeroPoolSizeBecomesOne) {
+  ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_connection_pool_size(0);
+  EXPECT_EQ(1U, options.connection_pool_size());
+}
@@ -0,0 +1,87 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_DOCUMENT_NAME_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_DOCUMENT_NAME_BUILDER_H
+
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+/**
+ * Build fully qualified document resource names into a reusable buffer.
+ *
+ * Document names share the constant
+ * `projects/<project-id>/databases/<database-id>/documents` prefix;
+ * building each name by concatenation re-copies that prefix and
+ * allocates a fresh string per name. This builder renders the prefix
+ * once and appends the variable segments into a buffer that keeps its
+ * capacity across calls, so building millions of names allocates only
+ * while the buffer grows.
+ *
+ * The reference returned by `MakeName()` points into that buffer and is
+ * invalidated by the next `MakeName()` call; callers that need to keep
+ * a name must copy it.
+ */
+class DocumentNameBuilder {
+ public:
+  DocumentNameBuilder(std::string const& project_id,
+                      std::string const& database_id)
+      : buffer_("projects/" + project_id + "/databases/" + database_id +
+                "/documents"),
+        prefix_size_(buffer_.size()) {}
+
+  /// Build the name of @p document_id in the top-level @p collection_id.
+  std::string const& MakeName(std::string const& collection_id,
+                              std::string const& document_id) {
+    buffer_.resize(prefix_size_);
+    AppendSegment(collection_id);
+    AppendSegment(document_id);
+    return buffer_;
+  }
+
+  /**
+   * Build the name for a (possibly nested) document path.
+   *
+   * @param segments alternating collection and document ids, from the
+   *     root collection down to the document.
+   */
+  std::string const& MakeName(std::vector<std::string> const& segments) {
+    buffer_.resize(prefix_size_);
+    for (auto const& segment : segments) {
+      AppendSegment(segment);
+    }
+    return buffer_;
+  }
+
+  /// The constant `projects/.../documents` prefix of every name built.
+  std::string prefix() const { return buffer_.substr(0, prefix_size_); }
+
+ private:
+  void AppendSegment(std::string const& segment) {
+    buffer_ += '/';
+    buffer_ += segment;
+  }
+
+  std::string buffer_;
+  std::string::size_type prefix_size_;
+};
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_DOCUMENT_NAME_BUILDER_H
@@ -0,0 +1,49 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/document_name_builder.h"
+#include <gtest/gtest.h>
+
+using google::cloud::firestore::DocumentNameBuilder;
+
+TEST(DocumentNameBuilder, MakeName) {
+  DocumentNameBuilder builder("my-project", "(default)");
+  EXPECT_EQ("projects/my-project/databases/(default)/documents",
+            builder.prefix());
+  EXPECT_EQ(
+      "projects/my-project/databases/(default)/documents/users/alice",
+      builder.MakeName("users", "alice"));
+  // The buffer is reset between calls, a shorter name is not polluted
+  // by a previous longer one.
+  EXPECT_EQ("projects/my-project/databases/(default)/documents/users/bo",
+            builder.MakeName("users", "bo"));
+}
+
+TEST(DocumentNameBuilder, MakeNameNested) {
+  DocumentNameBuilder builder("my-project", "(default)");
+  EXPECT_EQ(
+      "projects/my-project/databases/(default)/documents"
+      "/users/alice/messages/m1",
+      builder.MakeName({"users", "alice", "messages", "m1"}));
+}
+
+TEST(DocumentNameBuilder, ReusesBuffer) {
+  DocumentNameBuilder builder("my-project", "(default)");
+  auto const* first = &builder.MakeName("users", "alice");
+  auto const* second = &builder.MakeName("users", "bob");
+  // The same buffer is reused, each call invalidates the previous name.
+  EXPECT_EQ(first, second);
+  EXPECT_EQ("projects/my-project/databases/(default)/documents/users/bob",
+            *second);
+}
@@ -15,6 +15,8 @@
 #include "google/cloud/firestore/field_path.h"
 #include <array>
 #include <cctype>
+#include <map>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -22,13 +24,22 @@ namespace firestore {
 
 FieldPath::FieldPath(std::vector<std::string> parts)
     : parts_(std::move(parts)) {
+  // The FieldPath is immutable, hash the representation once here, see
+  // hash(). Invalid paths keep an empty representation and all hash
+  // alike, consistent with `operator==`.
+  hash_ = std::hash<std::string>()(api_repr_);
   for (auto const& part : parts_) {
     if (part.empty()) {
       this->valid_ = false;
+      // Leave the representation empty, see ToApiRepr().
       return;
     }
   }
   this->valid_ = true;
+  // The FieldPath is immutable, compute the representation once instead
+  // of re-scanning and re-escaping the parts on every ToApiRepr() call.
+  api_repr_ = MakeApiRepr(parts_);
+  hash_ = std::hash<std::string>()(api_repr_);
 }
 
 FieldPath FieldPath::InvalidFieldPath() {
@@ -43,24 +54,53 @@ FieldPath FieldPath::FromString(std::string const& string) {
   return FieldPath(Split(string));
 }
 
-FieldPath FieldPath::Append(std::string const& string) const {
-  std::vector<std::string> parts(this->parts_);
-  auto const field_path = FieldPath::FromString(string);
-  return this->Append(field_path);
+FieldPath const& FieldPath::Intern(std::string const& string) {
+  // Leaked on purpose: the registry (and the references handed out)
+  // must outlive any static destructor that may still use a FieldPath.
+  static auto* const registry = new std::map<std::string, FieldPath>;
+  static std::mutex mu;
+  std::lock_guard<std::mutex> lk(mu);
+  auto it = registry->find(string);
+  if (it == registry->end()) {
+    // std::map guarantees the entry (and references to it) remain valid
+    // as the registry grows.
+    it = registry->emplace(string, FieldPath::FromString(string)).first;
+  }
+  return it->second;
+}
+
+FieldPath FieldPath::Append(std::string const& string) const& {
+  return this->Append(FieldPath::FromString(string));
 }
 
-FieldPath FieldPath::Append(FieldPath const& field_path) const {
+FieldPath FieldPath::Append(std::string const& string) && {
+  return std::move(*this).Append(FieldPath::FromString(string));
+}
+
+FieldPath FieldPath::Append(FieldPath const& field_path) const& {
   if (valid_ && field_path.valid_) {
-    std::vector<std::string> parts(this->parts_);
-    for (auto const& part : field_path.parts_) {
-      parts.push_back(part);
-    }
-    return FieldPath(parts);
+    std::vector<std::string> parts;
+    parts.reserve(parts_.size() + field_path.parts_.size());
+    parts.insert(parts.end(), parts_.begin(), parts_.end());
+    parts.insert(parts.end(), field_path.parts_.begin(),
+                 field_path.parts_.end());
+    return FieldPath(std::move(parts));
+  }
+  return FieldPath::InvalidFieldPath();
+}
+
+FieldPath FieldPath::Append(FieldPath const& field_path) && {
+  if (valid_ && field_path.valid_) {
+    // `*this` is expiring, reuse its parts vector for the result.
+    parts_.reserve(parts_.size() + field_path.parts_.size());
+    parts_.insert(parts_.end(), field_path.parts_.begin(),
+                  field_path.parts_.end());
+    return FieldPath(std::move(parts_));
   }
   return FieldPath::InvalidFieldPath();
 }
 
-std::string FieldPath::ToApiRepr() const {
+std::string FieldPath::MakeApiRepr(std::vector<std::string> const& parts) {
   // gcc-4.8 ships with a broken regex library (sigh), so don't use it.
   auto is_simple_field_name = [](std::string const& part) {
     if (part.empty()) {
@@ -73,27 +113,39 @@ std::string FieldPath::ToApiRepr() const {
                        [](char c) { return c == '_' || std::isalnum(c) != 0; });
   };
   std::string s;
-  if (valid_) {
-    for (auto part : parts_) {
-      auto const match = is_simple_field_name(part);
-      if (match) {
-        s += part + '.';
-      } else {
-        ReplaceAll(part, "\\", "\\\\");
-        ReplaceAll(part, "`", "\\`");
-        s += '`' + part + "`.";
-      }
+  for (auto part : parts) {
+    auto const match = is_simple_field_name(part);
+    if (match) {
+      s += part + '.';
+    } else {
+      ReplaceAll(part, "\\", "\\\\");
+      ReplaceAll(part, "`", "\\`");
+      s += '`' + part + "`.";
     }
-    s.resize(s.size() - 1);  // cannot be empty and remove final period
   }
-  return s;  // let the server catch the empty string error for invalid
+  if (s.empty()) {  // a FieldPath with no components
+    return s;
+  }
+  s.resize(s.size() - 1);  // remove the final period
+  return s;
 }
 
 bool operator==(FieldPath const& lhs, FieldPath const& rhs) {
-  return lhs.ToApiRepr() == rhs.ToApiRepr();
+  // Different paths almost always differ in the cached hash, comparing
+  // the hashes first avoids walking the representations.
+  return lhs.hash() == rhs.hash() && lhs.ToApiRepr() == rhs.ToApiRepr();
 }
 
 bool operator<(FieldPath const& lhs, FieldPath const& rhs) {
+  // Ordered containers detect equivalent keys with two `<` calls; when
+  // the cached hashes match the paths are almost certainly equal, and
+  // one comparison of the cached representations settles it without the
+  // part-by-part walk below. Invalid paths share an empty
+  // representation but still order by their parts, so they skip the
+  // fast path.
+  if (lhs.valid_ && lhs.hash_ == rhs.hash_ && lhs.api_repr_ == rhs.api_repr_) {
+    return false;
+  }
   auto const lhs_size = lhs.parts_.size();
   auto const rhs_size = rhs.parts_.size();
   auto const min_length = (std::min)(lhs_size, rhs_size);
@@ -129,15 +181,19 @@ bool FieldPath::InvalidCharacters(std::string const& string) {
   return false;
 }
 
-std::vector<std::string> FieldPath::Split(std::string string) {
+std::vector<std::string> FieldPath::Split(std::string const& string) {
+  // A single pass over the input, each part is allocated exactly once;
+  // re-assigning the shrinking remainder (as this used to do) costs a
+  // copy of the string tail per component.
   std::vector<std::string> parts;
+  std::size_t pos = 0;
   auto index = string.find('.');
   while (index != std::string::npos) {
-    parts.push_back(string.substr(0, index));
-    string = string.substr(index + 1);
-    index = string.find('.');
+    parts.push_back(string.substr(pos, index - pos));
+    pos = index + 1;
+    index = string.find('.', pos);
   }
-  parts.push_back(string);
+  parts.push_back(string.substr(pos));
   return parts;
 }
 
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
 
+#include <functional>
 #include <iostream>
 #include <regex>
 #include <string>
@@ -54,6 +55,24 @@ class FieldPath {
    */
   static FieldPath FromString(std::string const& string);
 
+  /**
+   * Return a canonical FieldPath for the field path string @p string.
+   *
+   * Applications typically reference a small fixed set of field paths;
+   * parsing and escaping the same path on every request is wasted work.
+   * This function keeps a process-lifetime registry of the paths it has
+   * seen and returns a reference to the registry entry, so each
+   * distinct path is parsed exactly once. The returned reference is
+   * valid for the remainder of the program.
+   *
+   * This function is thread safe. Prefer `FromString()` for paths that
+   * are not reused, the registry entries are never released.
+   *
+   * @param string A const field path string to canonicalize.
+   * @return A reference to the canonical FieldPath for @p string.
+   */
+  static FieldPath const& Intern(std::string const& string);
+
   /**
    * Construct a new FieldPath by appending a field path string @p string.
    *
@@ -61,21 +80,49 @@ class FieldPath {
    * @return A new field path created from appending the field path string.
    */
 
-  FieldPath Append(std::string const& string) const;
+  FieldPath Append(std::string const& string) const&;
+
+  /**
+   * Construct a new FieldPath by appending a field path string @p string.
+   *
+   * This overload applies when `*this` is an rvalue, for example in a
+   * chain of `Append()` calls; it reuses the parts vector instead of
+   * copying it.
+   *
+   * @param string A const field path string to append to this FieldPath
+   * @return A new field path created from appending the field path string.
+   */
+  FieldPath Append(std::string const& string) &&;
+
+  /**
+   * Construct a new FieldPath by appending a FieldPath @p field_path.
+   *
+   * @param field_path A const FieldPath to append to this FieldPath.
+   * @return A new field path created from appending the FieldPath
+   */
+  FieldPath Append(FieldPath const& field_path) const&;
 
   /**
    * Construct a new FieldPath by appending a FieldPath @p field_path.
    *
+   * This overload applies when `*this` is an rvalue, for example in a
+   * chain of `Append()` calls; it reuses the parts vector instead of
+   * copying it.
+   *
    * @param field_path A const FieldPath to append to this FieldPath.
    * @return A new field path created from appending the FieldPath
    */
-  FieldPath Append(FieldPath const& field_path) const;
+  FieldPath Append(FieldPath const& field_path) &&;
 
   /**
    * Convert the FieldPath into a unique representation for the server.
+   *
+   * The representation is computed once, when the FieldPath is created;
+   * repeated calls return a reference to the cached string.
+   *
    * @return The unique server API representation.
    */
-  std::string ToApiRepr() const;
+  std::string const& ToApiRepr() const { return api_repr_; }
 
   /**
    * Return the number of components for this FieldPath.
@@ -89,6 +136,18 @@ class FieldPath {
    */
   bool valid() const { return valid_; }
 
+  /**
+   * Return a hash of this FieldPath.
+   *
+   * The value is computed once, when the FieldPath is created, and is
+   * consistent with `operator==`: equal paths return equal hashes. The
+   * `std::hash` specialization below uses it, so unordered containers
+   * keyed by FieldPath do not re-hash the path on every lookup.
+   *
+   * @return The cached hash value.
+   */
+  std::size_t hash() const { return hash_; }
+
  private:
   /**
    * The representation of this FieldPath @p field_path for ostream @p os.
@@ -117,7 +176,7 @@ class FieldPath {
    * @param string A const string to write to.
    * @return The vector of string after splitting via delimiter
    */
-  static std::vector<std::string> Split(std::string const string);
+  static std::vector<std::string> Split(std::string const& string);
 
   /**
    * Replace all occurences of @p find in @p string with @p replace.
@@ -129,11 +188,29 @@ class FieldPath {
   static void ReplaceAll(std::string& string, std::string const& find,
                          std::string const& replace);
 
+  /**
+   * Compute the server API representation of @p parts.
+   *
+   * @param parts A const vector of valid field path components.
+   * @return The unique server API representation.
+   */
+  static std::string MakeApiRepr(std::vector<std::string> const& parts);
+
   /**
    * The components of this FieldPath.
    */
   std::vector<std::string> parts_;
 
+  /**
+   * The cached server API representation, empty if not valid.
+   */
+  std::string api_repr_;
+
+  /**
+   * The cached hash of the server API representation.
+   */
+  std::size_t hash_;
+
   /**
    * Whether this FieldPath is valid or not.
    */
@@ -163,4 +240,15 @@ inline bool operator>=(FieldPath const& lhs, FieldPath const& rhs) {
 }  // namespace cloud
 }  // namespace google
 
+namespace std {
+/// Allow using `FieldPath` as the key of unordered containers.
+template <>
+struct hash<google::cloud::firestore::FieldPath> {
+  std::size_t operator()(
+      google::cloud::firestore::FieldPath const& field_path) const {
+    return field_path.hash();
+  }
+};
+}  // namespace std
+
 #endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
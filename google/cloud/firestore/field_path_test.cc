@@ -14,6 +14,7 @@
 
 #include "google/cloud/firestore/field_path.h"
 #include <gtest/gtest.h>
+#include <unordered_map>
 
 namespace firestore = google::cloud::firestore;
 
@@ -209,3 +210,72 @@ TEST(FieldPath, Size) {
   ASSERT_TRUE(field_path.valid());
   EXPECT_EQ(3, field_path.size());
 }
+
+TEST(FieldPath, ToApiReprIsCached) {
+  auto const path = firestore::FieldPath::FromString("a.b.c");
+  // The representation is computed once, repeated calls return a
+  // reference to the same cached string.
+  EXPECT_EQ(&path.ToApiRepr(), &path.ToApiRepr());
+  EXPECT_EQ(path.ToApiRepr(), "a.b.c");
+
+  // Invalid paths keep returning an empty representation.
+  auto const invalid = firestore::FieldPath::InvalidFieldPath();
+  EXPECT_EQ(invalid.ToApiRepr(), "");
+}
+
+TEST(FieldPath, AppendRvalue) {
+  // Chained Append() calls apply the rvalue overloads, which reuse the
+  // parts vector of the expiring intermediate paths.
+  auto const path =
+      firestore::FieldPath::FromString("a").Append("b.c").Append(
+          firestore::FieldPath::FromString("d"));
+  EXPECT_TRUE(path.valid());
+  EXPECT_EQ(path.ToApiRepr(), "a.b.c.d");
+  EXPECT_EQ(4, path.size());
+
+  auto const invalid = firestore::FieldPath::FromString("a..b");
+  EXPECT_FALSE(
+      firestore::FieldPath::FromString("a").Append(invalid).valid());
+}
+
+TEST(FieldPath, InternReturnsCanonicalObject) {
+  auto const& a = firestore::FieldPath::Intern("x.y.z");
+  auto const& b = firestore::FieldPath::Intern("x.y.z");
+  // The same path string maps to the same registry entry.
+  EXPECT_EQ(&a, &b);
+  EXPECT_TRUE(a.valid());
+  EXPECT_EQ(a.ToApiRepr(), "x.y.z");
+
+  auto const& other = firestore::FieldPath::Intern("x.y");
+  EXPECT_NE(&a, &other);
+  EXPECT_EQ(other.ToApiRepr(), "x.y");
+}
+
+TEST(FieldPath, HashConsistentWithEquality) {
+  auto const a = firestore::FieldPath::FromString("foo.bar");
+  auto const b = firestore::FieldPath({"foo", "bar"});
+  auto const c = firestore::FieldPath::FromString("foo.baz");
+  // Equal paths hash equally, regardless of how they were constructed.
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_NE(a, c);
+  EXPECT_EQ(std::hash<firestore::FieldPath>()(a), a.hash());
+}
+
+TEST(FieldPath, UnorderedMapKey) {
+  std::unordered_map<firestore::FieldPath, int> counters;
+  counters[firestore::FieldPath::FromString("a.b")] = 7;
+  counters[firestore::FieldPath::FromString("a.c")] = 42;
+  EXPECT_EQ(7, counters[firestore::FieldPath({"a", "b"})]);
+  EXPECT_EQ(42, counters[firestore::FieldPath::FromString("a.c")]);
+  EXPECT_EQ(2UL, counters.size());
+}
+
+TEST(FieldPath, InvalidPathsOrderByParts) {
+  // Invalid paths share an empty representation (and hash), the `<`
+  // fast path must not collapse them into a single equivalence class.
+  auto const a = firestore::FieldPath({""});
+  auto const b = firestore::FieldPath({"a", ""});
+  EXPECT_TRUE(a < b);
+  EXPECT_FALSE(b < a);
+}
@@ -17,9 +17,16 @@
 """Automatically generated source lists for firestore_client - DO NOT EDIT."""
 
 firestore_client_hdrs = [
+    "client_options.h",
+    "document_name_builder.h",
     "field_path.h",
+    "firestore_client.h",
+    "internal/common_client.h",
 ]
 
 firestore_client_srcs = [
+    "client_options.cc",
     "field_path.cc",
+    "firestore_client.cc",
+    "internal/common_client.cc",
 ]
@@ -0,0 +1,78 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/firestore_client.h"
+#include "google/cloud/firestore/internal/common_client.h"
+
+namespace google {
+namespace cloud {
+namespace firestore {
+namespace {
+
+/**
+ * The default implementation of `FirestoreClient`.
+ *
+ * Each RPC takes the next stub from the connection pool; a streaming
+ * read keeps its stub (and therefore its channel) alive until the
+ * stream is destroyed, so concurrent streams land on different
+ * connections.
+ */
+class DefaultFirestoreClient : public FirestoreClient {
+ public:
+  DefaultFirestoreClient(std::string project_id, std::string database_id,
+                         ClientOptions options)
+      : project_id_(std::move(project_id)),
+        database_id_(std::move(database_id)),
+        database_name_("projects/" + project_id_ + "/databases/" +
+                       database_id_),
+        impl_(std::move(options)) {}
+
+  std::string const& project_id() const override { return project_id_; }
+  std::string const& database_id() const override { return database_id_; }
+  std::string const& database_name() const override { return database_name_; }
+
+  std::unique_ptr<grpc::ClientReaderInterface<
+      google::firestore::v1beta1::BatchGetDocumentsResponse>>
+  BatchGetDocuments(grpc::ClientContext* context,
+                    google::firestore::v1beta1::BatchGetDocumentsRequest const&
+                        request) override {
+    return impl_.Stub()->BatchGetDocuments(context, request);
+  }
+
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::firestore::v1beta1::RunQueryResponse>>
+  RunQuery(grpc::ClientContext* context,
+           google::firestore::v1beta1::RunQueryRequest const& request)
+      override {
+    return impl_.Stub()->RunQuery(context, request);
+  }
+
+ private:
+  std::string project_id_;
+  std::string database_id_;
+  std::string database_name_;
+  internal::CommonClient impl_;
+};
+
+}  // anonymous namespace
+
+std::shared_ptr<FirestoreClient> CreateDefaultFirestoreClient(
+    std::string project_id, std::string database_id, ClientOptions options) {
+  return std::make_shared<DefaultFirestoreClient>(
+      std::move(project_id), std::move(database_id), std::move(options));
+}
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,99 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIRESTORE_CLIENT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIRESTORE_CLIENT_H
+
+#include "google/cloud/firestore/client_options.h"
+#include <google/firestore/v1beta1/firestore.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+
+/**
+ * Connect to the Cloud Firestore data API.
+ *
+ * This interface exposes the streaming read RPCs of the service:
+ * `BatchGetDocuments()` fetches a batch of documents by name in a
+ * single stream and `RunQuery()` streams the results of a structured
+ * query. Both return server-side streams, so arbitrarily large result
+ * sets are delivered without buffering them in a single response.
+ *
+ * Applications rarely need more than one client per database; the
+ * client maintains a pool of gRPC connections and concurrent streams
+ * are spread over the pool.
+ */
+class FirestoreClient {
+ public:
+  virtual ~FirestoreClient() = default;
+
+  /// The project id this client operates on.
+  virtual std::string const& project_id() const = 0;
+
+  /// The database id this client operates on.
+  virtual std::string const& database_id() const = 0;
+
+  /**
+   * The fully qualified database resource name.
+   *
+   * This is the `projects/<project-id>/databases/<database-id>` string
+   * expected in the `database` field of the request protos.
+   */
+  virtual std::string const& database_name() const = 0;
+
+  /**
+   * Fetch multiple documents by name in a single stream.
+   *
+   * Documents may be returned in any order; documents that do not exist
+   * are reported in the `missing` field of the response. The request's
+   * `database` field must match `database_name()`.
+   */
+  virtual std::unique_ptr<grpc::ClientReaderInterface<
+      google::firestore::v1beta1::BatchGetDocumentsResponse>>
+  BatchGetDocuments(
+      grpc::ClientContext* context,
+      google::firestore::v1beta1::BatchGetDocumentsRequest const& request) = 0;
+
+  /**
+   * Stream the results of a structured query.
+   *
+   * The request's `parent` field names the resource to query, typically
+   * `database_name() + "/documents"` or a document path below it.
+   */
+  virtual std::unique_ptr<grpc::ClientReaderInterface<
+      google::firestore::v1beta1::RunQueryResponse>>
+  RunQuery(grpc::ClientContext* context,
+           google::firestore::v1beta1::RunQueryRequest const& request) = 0;
+};
+
+/**
+ * Create the default implementation of `FirestoreClient`.
+ *
+ * @param project_id the id of the project to connect to.
+ * @param database_id the id of the database, typically `(default)`.
+ * @param options the configuration for the connection pool, endpoint
+ *     and credentials.
+ */
+std::shared_ptr<FirestoreClient> CreateDefaultFirestoreClient(
+    std::string project_id, std::string database_id, ClientOptions options);
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIRESTORE_CLIENT_H
@@ -0,0 +1,29 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/firestore_client.h"
+#include <gtest/gtest.h>
+
+namespace firestore = google::cloud::firestore;
+
+TEST(FirestoreClientTest, Accessors) {
+  auto client = firestore::CreateDefaultFirestoreClient(
+      "my-project", "(default)",
+      firestore::ClientOptions(grpc::InsecureChannelCredentials()));
+  ASSERT_TRUE(client);
+  EXPECT_EQ("my-project", client->project_id());
+  EXPECT_EQ("(default)", client->database_id());
+  EXPECT_EQ("projects/my-project/databases/(default)",
+            client->database_name());
+}
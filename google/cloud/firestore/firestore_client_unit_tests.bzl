@@ -17,5 +17,8 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 firestore_client_unit_tests = [
+    "client_options_test.cc",
+    "document_name_builder_test.cc",
     "field_path_test.cc",
+    "firestore_client_test.cc",
 ]
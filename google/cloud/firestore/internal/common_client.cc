@@ -0,0 +1,75 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/internal/common_client.h"
+
+namespace google {
+namespace cloud {
+namespace firestore {
+namespace internal {
+
+std::shared_ptr<grpc::Channel> CreatePooledChannel(ClientOptions const& options,
+                                                   std::size_t id) {
+  auto args = options.channel_arguments();
+  args.SetInt("cfs-c++/connection-pool-id", static_cast<int>(id));
+  return grpc::CreateCustomChannel(options.endpoint(), options.credentials(),
+                                   args);
+}
+
+CommonClient::StubPtr CommonClient::Stub() {
+  std::unique_lock<std::mutex> lk(mu_);
+  CheckConnections(lk);
+  auto stub = stubs_[current_index_];
+  current_index_ = (current_index_ + 1) % stubs_.size();
+  return stub;
+}
+
+void CommonClient::reset() {
+  std::unique_lock<std::mutex> lk(mu_);
+  stubs_.clear();
+  current_index_ = 0;
+}
+
+void CommonClient::CheckConnections(std::unique_lock<std::mutex>& lk) {
+  if (!stubs_.empty()) {
+    return;
+  }
+  // Creating channels is slow (it may perform DNS lookups and TLS
+  // handshakes), release the lock while doing so.
+  lk.unlock();
+  auto const pool_size = options_.connection_pool_size();
+  std::vector<StubPtr> stubs;
+  stubs.reserve(pool_size);
+  for (std::size_t i = 0; i != pool_size; ++i) {
+    auto channel = CreatePooledChannel(options_, i);
+    // Start the connection handshake in the background, so the first
+    // RPC does not pay for it.
+    channel->GetState(true);
+    stubs.push_back(
+        google::firestore::v1beta1::Firestore::NewStub(std::move(channel)));
+  }
+  lk.lock();
+  if (!stubs_.empty()) {
+    // Lost the race against another thread, its pool wins and the local
+    // channels are discarded.
+    return;
+  }
+  stubs_.swap(stubs);
+  current_index_ = 0;
+}
+
+}  // namespace internal
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
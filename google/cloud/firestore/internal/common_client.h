@@ -0,0 +1,87 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_INTERNAL_COMMON_CLIENT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_INTERNAL_COMMON_CLIENT_H
+
+#include "google/cloud/firestore/client_options.h"
+#include <google/firestore/v1beta1/firestore.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+namespace internal {
+
+/**
+ * Create a gRPC channel for @p options with a distinct identity.
+ *
+ * gRPC (and some load balancers) collapse channels with identical
+ * arguments onto a single connection; setting a channel argument that
+ * depends on @p id forces one connection per pool entry.
+ */
+std::shared_ptr<grpc::Channel> CreatePooledChannel(ClientOptions const& options,
+                                                   std::size_t id);
+
+/**
+ * Maintain the gRPC channels and stubs for the Firestore client.
+ *
+ * This is modeled on the Cloud Bigtable client's `CommonClient`
+ * (google/cloud/bigtable/internal/common_client.h): the channels are
+ * created lazily, outside the lock, and the stubs are handed out
+ * round-robin. The streaming read RPCs (`BatchGetDocuments()` and
+ * `RunQuery()`) hold their stub for the lifetime of the stream, so the
+ * bigtable-specific refinements (traffic lanes, pool resizing, channel
+ * refresh) are omitted until they prove necessary here.
+ */
+class CommonClient {
+ public:
+  using StubPtr =
+      std::shared_ptr<google::firestore::v1beta1::Firestore::StubInterface>;
+
+  explicit CommonClient(ClientOptions options)
+      : options_(std::move(options)), current_index_(0) {}
+
+  /**
+   * Return a stub to make the next RPC on.
+   *
+   * The returned stub keeps its channel alive, callers may hold it for
+   * the full lifetime of a streaming read.
+   */
+  StubPtr Stub();
+
+  /// Release all the channels, new RPCs will create a fresh pool.
+  void reset();
+
+  ClientOptions const& Options() const { return options_; }
+
+ private:
+  /// Create the channels and stubs if they do not exist yet.
+  void CheckConnections(std::unique_lock<std::mutex>& lk);
+
+  std::mutex mu_;
+  ClientOptions options_;
+  std::vector<StubPtr> stubs_;
+  std::size_t current_index_;
+};
+
+}  // namespace internal
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_INTERNAL_COMMON_CLIENT_H
@@ -0,0 +1,115 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/appendable_object_writer.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+AppendableObjectWriter::AppendableObjectWriter(
+    Client client, std::string bucket_name, std::string object_name,
+    std::int32_t compaction_threshold)
+    : client_(std::move(client)),
+      bucket_name_(std::move(bucket_name)),
+      object_name_(std::move(object_name)),
+      compaction_threshold_(compaction_threshold < 2 ? 2
+                                                     : compaction_threshold),
+      tmp_prefix_(CreateRandomPrefixName(object_name_ + ".append-")) {}
+
+Status AppendableObjectWriter::Initialize() {
+  auto metadata = client_.GetObjectMetadata(bucket_name_, object_name_);
+  if (metadata) {
+    exists_ = true;
+    generation_ = metadata->generation();
+    // Non-composite objects report a component count of zero, but count
+    // as one source in the next compose.
+    component_count_ = (std::max)(std::int32_t(1), metadata->component_count());
+    return Status();
+  }
+  if (metadata.status().code() == StatusCode::kNotFound) {
+    exists_ = false;
+    return Status();
+  }
+  return metadata.status();
+}
+
+StatusOr<ObjectMetadata> AppendableObjectWriter::Append(
+    std::string const& data) {
+  if (!initialized_) {
+    auto status = Initialize();
+    if (!status.ok()) {
+      return status;
+    }
+    initialized_ = true;
+  }
+  if (!exists_) {
+    // The first append simply creates the object, no compose needed.
+    auto metadata =
+        client_.InsertObject(bucket_name_, object_name_, data,
+                             IfGenerationMatch(0));
+    if (!metadata) {
+      return metadata;
+    }
+    exists_ = true;
+    generation_ = metadata->generation();
+    component_count_ = 1;
+    return metadata;
+  }
+  if (component_count_ >= compaction_threshold_) {
+    // Materialize the accumulated components, resetting the component
+    // count. This costs one rewrite of the full object every
+    // `compaction_threshold_` appends, keeping the amortized I/O linear.
+    auto compacted = client_.RewriteObjectBlocking(
+        bucket_name_, object_name_, bucket_name_, object_name_,
+        IfGenerationMatch(generation_));
+    if (!compacted) {
+      return compacted;
+    }
+    generation_ = compacted->generation();
+    component_count_ =
+        (std::max)(std::int32_t(1), compacted->component_count());
+  }
+  auto tmp_name = tmp_prefix_ + "." + std::to_string(append_count_++);
+  auto tmp =
+      client_.InsertObject(bucket_name_, tmp_name, data, IfGenerationMatch(0));
+  if (!tmp) {
+    return tmp;
+  }
+  std::vector<ComposeSourceObject> sources(2);
+  sources[0].object_name = object_name_;
+  sources[0].generation = generation_;
+  sources[1].object_name = tmp->name();
+  sources[1].generation = tmp->generation();
+  auto result = client_.ComposeObject(bucket_name_, std::move(sources),
+                                      object_name_,
+                                      IfGenerationMatch(generation_));
+  // The temporary is no longer needed whether the compose succeeded or
+  // not. A failed delete only leaks a temporary object (recognizable by
+  // its prefix), the append outcome is determined by the compose.
+  (void)client_.DeleteObject(bucket_name_, tmp_name,
+                             Generation(tmp->generation()));
+  if (!result) {
+    return result;
+  }
+  generation_ = result->generation();
+  component_count_ = (std::max)(std::int32_t(1), result->component_count());
+  return result;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
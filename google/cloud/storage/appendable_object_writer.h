@@ -0,0 +1,123 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_APPENDABLE_OBJECT_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_APPENDABLE_OBJECT_WRITER_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Append to a GCS object without rewriting its existing contents.
+ *
+ * GCS objects are immutable, so the naive way to append is to download
+ * the object, append locally, and upload the result; appending n times
+ * this way re-uploads the ever-growing prefix and costs O(n^2) I/O.
+ * This class appends in O(n): each `Append()` uploads only the new data
+ * as a temporary object, folds it into the target with a two-source
+ * `ComposeObject()`, and deletes the temporary.
+ *
+ * Composite objects accumulate a component count, and the service
+ * limits both the sources per compose request (32) and the total
+ * components. When the component count reaches the compaction
+ * threshold the writer compacts the object with a same-location
+ * `RewriteObjectBlocking()`, which materializes the data and resets
+ * the count; the amortized cost remains linear because compaction
+ * happens once every `compaction_threshold` appends.
+ *
+ * This class assumes a single writer per object. Every compose carries
+ * an `IfGenerationMatch()` precondition, so a concurrent modification
+ * of the target does not lose data: the `Append()` fails with
+ * `kFailedPrecondition` instead.
+ *
+ * @par Example
+ * @code
+ * storage::AppendableObjectWriter writer(client, "my-bucket", "app.log");
+ * for (auto const& line : lines) {
+ *   auto metadata = writer.Append(line);
+ *   if (!metadata) throw std::runtime_error(metadata.status().message());
+ * }
+ * @endcode
+ */
+class AppendableObjectWriter {
+ public:
+  /**
+   * Create a writer appending to @p object_name in @p bucket_name.
+   *
+   * The target object does not need to exist, the first `Append()`
+   * creates it.
+   *
+   * @param client the client used for all the requests.
+   * @param bucket_name the bucket containing the target object.
+   * @param object_name the object to append to.
+   * @param compaction_threshold compact the object when its component
+   *     count reaches this value. The default stays just under the
+   *     32-source compose limit; larger values (the service accepts
+   *     component counts well above 32) compact less often at the cost
+   *     of a higher count on the stored object.
+   */
+  AppendableObjectWriter(Client client, std::string bucket_name,
+                         std::string object_name,
+                         std::int32_t compaction_threshold = 30);
+
+  /**
+   * Append @p data to the target object.
+   *
+   * The data is durable when this function returns successfully. Each
+   * call performs one upload, one compose, and one delete (plus a
+   * rewrite when compaction triggers), so batching many small appends
+   * into fewer larger ones is more efficient.
+   *
+   * @return the metadata of the object after the append, or the error
+   *     that stopped it. A `kFailedPrecondition` error indicates the
+   *     object was modified by another writer.
+   */
+  StatusOr<ObjectMetadata> Append(std::string const& data);
+
+  std::string const& bucket_name() const { return bucket_name_; }
+  std::string const& object_name() const { return object_name_; }
+
+  /// The component count after the last `Append()`, 0 before the first.
+  std::int32_t component_count() const { return component_count_; }
+
+ private:
+  /// Fetch the target's generation and component count, once.
+  Status Initialize();
+
+  Client client_;
+  std::string bucket_name_;
+  std::string object_name_;
+  std::int32_t compaction_threshold_;
+  /// The prefix for the temporary objects, unique to this writer.
+  std::string tmp_prefix_;
+  std::uint64_t append_count_ = 0;
+  bool initialized_ = false;
+  bool exists_ = false;
+  std::int64_t generation_ = 0;
+  std::int32_t component_count_ = 0;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_APPENDABLE_OBJECT_WRITER_H
@@ -0,0 +1,191 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/appendable_object_writer.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+
+ObjectMetadata CreateObject(std::string const& name, std::int64_t generation,
+                            std::int32_t component_count) {
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{{"bucket", "test-bucket"},
+                                {"name", name},
+                                {"generation", generation},
+                                {"componentCount", component_count},
+                                {"kind", "storage#object"}})
+      .value();
+}
+
+class AppendableObjectWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+/// @test The first append on a missing object simply creates it.
+TEST_F(AppendableObjectWriterTest, FirstAppendCreatesObject) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([](internal::GetObjectMetadataRequest const& request)
+                           -> StatusOr<ObjectMetadata> {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("app.log", request.object_name());
+        return Status(StatusCode::kNotFound, "not found");
+      }));
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([](internal::InsertObjectMediaRequest const& request) {
+        EXPECT_EQ("app.log", request.object_name());
+        EXPECT_EQ("line 1\n", request.contents());
+        return make_status_or(CreateObject("app.log", 1, 0));
+      }));
+
+  AppendableObjectWriter writer(*client, "test-bucket", "app.log");
+  auto metadata = writer.Append("line 1\n");
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ("app.log", metadata->name());
+  EXPECT_EQ(1, writer.component_count());
+}
+
+/// @test An append to an existing object uploads and composes the delta.
+TEST_F(AppendableObjectWriterTest, AppendComposesDelta) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateObject("app.log", 5, 3));
+      }));
+  std::string tmp_name;
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke(
+          [&tmp_name](internal::InsertObjectMediaRequest const& request) {
+            tmp_name = request.object_name();
+            EXPECT_NE("app.log", tmp_name);
+            EXPECT_EQ("line 2\n", request.contents());
+            return make_status_or(CreateObject(tmp_name, 1, 0));
+          }));
+  EXPECT_CALL(*raw_client_mock, ComposeObject(_))
+      .WillOnce(Invoke([](internal::ComposeObjectRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("app.log", request.object_name());
+        return make_status_or(CreateObject("app.log", 6, 4));
+      }));
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillOnce(Invoke(
+          [&tmp_name](internal::DeleteObjectRequest const& request) {
+            EXPECT_EQ(tmp_name, request.object_name());
+            return make_status_or(internal::EmptyResponse{});
+          }));
+
+  AppendableObjectWriter writer(*client, "test-bucket", "app.log");
+  auto metadata = writer.Append("line 2\n");
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ(4, writer.component_count());
+}
+
+/// @test Reaching the compaction threshold triggers a rewrite.
+TEST_F(AppendableObjectWriterTest, CompactionTriggers) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateObject("app.log", 7, 3));
+      }));
+  EXPECT_CALL(*raw_client_mock, RewriteObject(_))
+      .WillOnce(Invoke([](internal::RewriteObjectRequest const& request) {
+        EXPECT_EQ("app.log", request.source_object());
+        EXPECT_EQ("app.log", request.destination_object());
+        internal::RewriteObjectResponse response;
+        response.total_bytes_rewritten = 1000;
+        response.object_size = 1000;
+        response.done = true;
+        response.resource = CreateObject("app.log", 8, 0);
+        return make_status_or(response);
+      }));
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([](internal::InsertObjectMediaRequest const& request) {
+        return make_status_or(CreateObject(request.object_name(), 1, 0));
+      }));
+  EXPECT_CALL(*raw_client_mock, ComposeObject(_))
+      .WillOnce(Invoke([](internal::ComposeObjectRequest const&) {
+        return make_status_or(CreateObject("app.log", 9, 2));
+      }));
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillOnce(Invoke([](internal::DeleteObjectRequest const&) {
+        return make_status_or(internal::EmptyResponse{});
+      }));
+
+  // A threshold of 3 and an existing component count of 3 forces the
+  // compaction before the compose.
+  AppendableObjectWriter writer(*client, "test-bucket", "app.log", 3);
+  auto metadata = writer.Append("line 9\n");
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ(2, writer.component_count());
+}
+
+/// @test A failed compose reports the error and deletes the temporary.
+TEST_F(AppendableObjectWriterTest, ComposeFailureIsReported) {
+  using testing::canonical_errors::PermanentError;
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateObject("app.log", 5, 3));
+      }));
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([](internal::InsertObjectMediaRequest const& request) {
+        return make_status_or(CreateObject(request.object_name(), 1, 0));
+      }));
+  EXPECT_CALL(*raw_client_mock, ComposeObject(_))
+      .WillOnce(Invoke([](internal::ComposeObjectRequest const&)
+                           -> StatusOr<ObjectMetadata> {
+        return PermanentError();
+      }));
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillOnce(Invoke([](internal::DeleteObjectRequest const&) {
+        return make_status_or(internal::EmptyResponse{});
+      }));
+
+  AppendableObjectWriter writer(*client, "test-bucket", "app.log");
+  auto metadata = writer.Append("line 3\n");
+  EXPECT_FALSE(metadata.ok());
+  EXPECT_EQ(PermanentError().code(), metadata.status().code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
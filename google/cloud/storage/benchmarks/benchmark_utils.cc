@@ -13,15 +13,23 @@
 // limitations under the License.
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
-#include "google/cloud/storage/benchmarks/bounded_queue.h"
+#include "google/cloud/storage/internal/bounded_mpmc_queue.h"
 #include <cctype>
+#include <cstdlib>
 #include <future>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 
 namespace google {
 namespace cloud {
 namespace storage_benchmarks {
+namespace {
+thread_local AllocationStats thread_allocation_stats{0, 0, 0};
+}  // namespace
+
+AllocationStats GetAllocationStats() { return thread_allocation_stats; }
+
 bool EndsWith(std::string const& val, std::string const& suffix) {
   auto pos = val.rfind(suffix);
   if (pos == std::string::npos) {
@@ -166,6 +174,7 @@ void SimpleTimer::Start() {
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   (void)getrusage(rusage_who(), &start_usage_);
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  start_allocation_ = GetAllocationStats();
   start_ = std::chrono::steady_clock::now();
 }
 
@@ -173,6 +182,15 @@ void SimpleTimer::Stop() {
   using namespace std::chrono;
   elapsed_time_ = duration_cast<microseconds>(steady_clock::now() - start_);
 
+  auto allocation = GetAllocationStats();
+  allocation_count_ =
+      allocation.allocation_count - start_allocation_.allocation_count;
+  allocated_bytes_ =
+      allocation.allocated_bytes - start_allocation_.allocated_bytes;
+  auto deallocation_count =
+      allocation.deallocation_count - start_allocation_.deallocation_count;
+
+  std::ostringstream os;
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   auto as_usec = [](timeval const& tv) {
     return microseconds(seconds(tv.tv_sec)) + microseconds(tv.tv_usec);
@@ -199,7 +217,6 @@ void SimpleTimer::Stop() {
   now.ru_nvcsw -= start_usage_.ru_nvcsw;
   now.ru_nivcsw -= start_usage_.ru_nivcsw;
 
-  std::ostringstream os;
   os << "# user time                    =" << utime.count() << " us\n"
      << "# system time                  =" << stime.count() << " us\n"
      << "# CPU fraction                 =" << cpu_fraction << "\n"
@@ -217,8 +234,11 @@ void SimpleTimer::Stop() {
      << "# signals received             =" << now.ru_nsignals << "\n"
      << "# voluntary context switches   =" << now.ru_nvcsw << "\n"
      << "# involuntary context switches =" << now.ru_nivcsw << "\n";
-  annotations_ = std::move(os).str();
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  os << "# allocation count             =" << allocation_count_ << "\n"
+     << "# allocated bytes              =" << allocated_bytes_ << "\n"
+     << "# deallocation count           =" << deallocation_count << "\n";
+  annotations_ = std::move(os).str();
 }
 
 bool SimpleTimer::SupportPerThreadUsage() {
@@ -275,14 +295,15 @@ std::string FormatSize(std::uintmax_t size) {
 
 void DeleteAllObjects(google::cloud::storage::Client client,
                       std::string bucket_name, int thread_count) {
-  using WorkQueue = BoundedQueue<google::cloud::storage::ObjectMetadata>;
+  using WorkQueue = google::cloud::storage::internal::BoundedMpmcQueue<
+      google::cloud::storage::ObjectMetadata>;
   using std::chrono::duration_cast;
   using std::chrono::milliseconds;
   namespace gcs = google::cloud::storage;
 
   std::cout << "# Deleting test objects [" << thread_count << "]\n";
   auto start = std::chrono::steady_clock::now();
-  WorkQueue work_queue;
+  WorkQueue work_queue(1024);
   std::vector<std::future<google::cloud::Status>> workers;
   std::generate_n(
       std::back_inserter(workers), thread_count, [&client, &work_queue] {
@@ -320,3 +341,29 @@ void DeleteAllObjects(google::cloud::storage::Client client,
 }  // namespace storage_benchmarks
 }  // namespace cloud
 }  // namespace google
+
+#ifndef GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
+// Replace the global allocation functions to feed the counters returned by
+// `GetAllocationStats()`. Only the unsized forms need replacing, the standard
+// requires all other non-aligned forms to call these by default. The aligned
+// forms (C++17) are left alone, they do not forward to `operator new(size_t)`
+// and deleting their storage with `std::free()` would be undefined behavior.
+void* operator new(std::size_t count) {
+  auto& stats =
+      google::cloud::storage_benchmarks::thread_allocation_stats;
+  ++stats.allocation_count;
+  stats.allocated_bytes += count;
+  // Allocating zero bytes must return a unique pointer.
+  void* p = std::malloc(count == 0 ? 1 : count);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* ptr) noexcept {
+  ++google::cloud::storage_benchmarks::thread_allocation_stats
+        .deallocation_count;
+  std::free(ptr);
+}
+#endif  // GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
@@ -20,6 +20,7 @@
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/testing/random_names.h"
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <string>
@@ -74,6 +75,26 @@ std::string BuildUsage(std::vector<OptionDescriptor> const& desc,
 std::vector<std::string> OptionsParse(std::vector<OptionDescriptor> const& desc,
                                       std::vector<std::string> argv);
 
+/**
+ * Per-thread counters for the global allocation functions.
+ *
+ * The benchmarks replace the global `operator new` and `operator delete`
+ * functions to keep these counters, wall-clock throughput alone does not
+ * detect CPU or allocator regressions in the library. The counters are
+ * per-thread, a benchmark thread only observes its own allocations. Define
+ * `GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS` to disable the
+ * replacement, e.g., when linking against a custom allocator, in that case
+ * the counters are always zero.
+ */
+struct AllocationStats {
+  std::uint64_t allocation_count;
+  std::uint64_t allocated_bytes;
+  std::uint64_t deallocation_count;
+};
+
+/// Return the allocation counters for the calling thread.
+AllocationStats GetAllocationStats();
+
 class SimpleTimer {
  public:
   SimpleTimer() = default;
@@ -92,6 +113,8 @@ class SimpleTimer {
    */
   std::chrono::microseconds elapsed_time() const { return elapsed_time_; }
   std::chrono::microseconds cpu_time() const { return cpu_time_; }
+  std::uint64_t allocation_count() const { return allocation_count_; }
+  std::uint64_t allocated_bytes() const { return allocated_bytes_; }
   std::string const& annotations() const { return annotations_; }
   //@}
 
@@ -101,6 +124,9 @@ class SimpleTimer {
   std::chrono::steady_clock::time_point start_;
   std::chrono::microseconds elapsed_time_;
   std::chrono::microseconds cpu_time_;
+  AllocationStats start_allocation_;
+  std::uint64_t allocation_count_;
+  std::uint64_t allocated_bytes_;
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   struct rusage start_usage_;
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
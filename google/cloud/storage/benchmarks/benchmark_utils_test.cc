@@ -14,7 +14,9 @@
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
 #include <gmock/gmock.h>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -49,6 +51,36 @@ TEST(FormatSize, Basic) {
   EXPECT_EQ("2.0TiB", FormatSize(2 * kTiB));
 }
 
+TEST(AllocationStats, CountsThisThread) {
+  auto start = GetAllocationStats();
+  {
+    std::vector<char> buffer(128 * 1024);
+    // Keep the optimizer from eliding the allocation.
+    EXPECT_EQ('\0', buffer[buffer.size() / 2]);
+  }
+  auto stats = GetAllocationStats();
+#ifndef GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
+  EXPECT_LT(start.allocation_count, stats.allocation_count);
+  EXPECT_LE(start.allocated_bytes + 128 * 1024, stats.allocated_bytes);
+  EXPECT_LT(start.deallocation_count, stats.deallocation_count);
+#else
+  EXPECT_EQ(0, stats.allocation_count);
+#endif  // GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
+}
+
+TEST(SimpleTimerTest, MeasuresAllocations) {
+  SimpleTimer timer;
+  timer.Start();
+  std::vector<std::string> strings(64, std::string(1024, 'a'));
+  timer.Stop();
+#ifndef GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
+  EXPECT_LE(64U, timer.allocation_count());
+  EXPECT_LE(64U * 1024U, timer.allocated_bytes());
+#endif  // GOOGLE_CLOUD_CPP_BENCHMARKS_DISABLE_ALLOCATION_COUNTERS
+  EXPECT_THAT(timer.annotations(),
+              ::testing::HasSubstr("# allocation count"));
+}
+
 }  // namespace
 }  // namespace storage_benchmarks
 }  // namespace cloud
@@ -17,6 +17,8 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_benchmark_programs = [
+    "storage_client_microbenchmarks.cc",
+    "storage_cpp_testbench.cc",
     "storage_file_transfer_benchmark.cc",
     "storage_latency_benchmark.cc",
     "storage_parallel_uploads_benchmark.cc",
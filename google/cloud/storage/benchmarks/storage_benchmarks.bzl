@@ -18,7 +18,6 @@
 
 storage_benchmarks_hdrs = [
     "benchmark_utils.h",
-    "bounded_queue.h",
 ]
 
 storage_benchmarks_srcs = [
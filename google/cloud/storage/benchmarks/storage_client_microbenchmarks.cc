@@ -0,0 +1,282 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/patch_builder.h"
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+namespace {
+namespace gcs = google::cloud::storage;
+namespace gcs_bm = google::cloud::storage_benchmarks;
+
+char const kDescription[] = R"""(
+A microbenchmark suite for the non-I/O hot paths in the GCS C++ client.
+
+The macro benchmarks in this directory measure end-to-end throughput and
+latency against the service, where the network dominates and small
+regressions in the CPU-bound code are invisible. This program exercises the
+request construction and response parsing paths in isolation:
+
+- Parsing `ObjectMetadata` from its JSON representation.
+- Assembling request URLs with `CurlRequestBuilder`.
+- Computing patch payloads with `PatchBuilder`.
+- Applying well-known parameters and headers to a request.
+
+Each microbenchmark runs a fixed number of iterations inside a
+`SimpleTimer`, several times, and reports the elapsed time, the CPU time,
+and the allocations performed per iteration. The program makes no RPCs, it
+needs neither credentials nor network access.
+)""";
+
+struct Options {
+  long iterations = 100000;
+  int repeats = 5;
+};
+
+struct MicrobenchmarkResult {
+  std::string name;
+  long iterations;
+  std::chrono::microseconds elapsed_time;
+  std::chrono::microseconds cpu_time;
+  std::uint64_t allocation_count;
+  std::uint64_t allocated_bytes;
+};
+
+using Microbenchmark = std::function<std::size_t(long iterations)>;
+
+// A sample response payload for `Objects: get`, representative of an object
+// with a short ACL and a few lines of custom metadata.
+char const kObjectJsonText[] = R"""({
+  "acl": [{
+    "kind": "storage#objectAccessControl",
+    "id": "acl-id-0",
+    "bucket": "test-bucket",
+    "object": "test-object",
+    "generation": 12345,
+    "entity": "user-test-user",
+    "role": "OWNER",
+    "email": "test-user@example.com",
+    "etag": "AYX="
+  }, {
+    "kind": "storage#objectAccessControl",
+    "id": "acl-id-1",
+    "bucket": "test-bucket",
+    "object": "test-object",
+    "generation": 12345,
+    "entity": "user-test-user2",
+    "role": "READER",
+    "email": "test-user2@example.com",
+    "etag": "AYX="
+  }],
+  "bucket": "test-bucket",
+  "cacheControl": "no-cache",
+  "componentCount": 7,
+  "contentDisposition": "a-disposition",
+  "contentEncoding": "an-encoding",
+  "contentLanguage": "a-language",
+  "contentType": "application/octet-stream",
+  "crc32c": "deadbeef",
+  "etag": "XYZ=",
+  "generation": "12345",
+  "id": "test-bucket/test-object/12345",
+  "kind": "storage#object",
+  "md5Hash": "deaderBeef=",
+  "mediaLink": "https://storage.googleapis.com/storage/v1/b/test-bucket/o/test-object?generation=12345&alt=media",
+  "metadata": {
+    "foo": "bar",
+    "baz": "qux"
+  },
+  "metageneration": "4",
+  "name": "test-object",
+  "selfLink": "https://storage.googleapis.com/storage/v1/b/test-bucket/o/test-object",
+  "size": 102400,
+  "storageClass": "STANDARD",
+  "timeCreated": "2018-05-19T19:31:14Z",
+  "timeStorageClassUpdated": "2018-05-19T19:31:34Z",
+  "updated": "2018-05-19T19:31:24Z"
+})""";
+
+std::size_t ParseObjectMetadata(long iterations) {
+  std::string const text = kObjectJsonText;
+  std::size_t sink = 0;
+  for (long i = 0; i != iterations; ++i) {
+    auto metadata = gcs::internal::ObjectMetadataParser::FromString(text);
+    if (!metadata) break;
+    sink += static_cast<std::size_t>(metadata->size());
+  }
+  return sink;
+}
+
+std::size_t BuildRequestUrl(long iterations) {
+  auto factory = gcs::internal::GetDefaultCurlHandleFactory();
+  std::string const base_url =
+      "https://storage.googleapis.com/storage/v1/b/test-bucket/o/test-object";
+  std::size_t sink = 0;
+  for (long i = 0; i != iterations; ++i) {
+    gcs::internal::CurlRequestBuilder builder(base_url, factory);
+    builder.AddQueryParameter("generation", "12345")
+        .AddQueryParameter("userProject", "test-project")
+        .AddQueryParameter("fields", "bucket,name,generation")
+        .AddHeader("x-goog-test-header: test-value");
+    auto request = builder.BuildRequest();
+    sink += base_url.size();
+  }
+  return sink;
+}
+
+std::size_t ComputePatch(long iterations) {
+  std::size_t sink = 0;
+  for (long i = 0; i != iterations; ++i) {
+    gcs::internal::PatchBuilder patch;
+    patch.AddStringField("contentType", "text/plain",
+                         "application/octet-stream");
+    patch.AddStringField("cacheControl", "no-cache", "max-age=3600");
+    patch.AddStringField("contentLanguage", "a-language", "");
+    patch.AddBoolField("eventBasedHold", false, true);
+    patch.AddIntField("componentCount", std::int32_t(0), std::int32_t(7));
+    gcs::internal::PatchBuilder metadata;
+    metadata.SetStringField("foo", "bar");
+    metadata.SetStringField("baz", "qux");
+    patch.AddSubPatch("metadata", metadata);
+    sink += patch.ToString().size();
+  }
+  return sink;
+}
+
+std::size_t ApplyRequestOptions(long iterations) {
+  auto factory = gcs::internal::GetDefaultCurlHandleFactory();
+  std::string const base_url =
+      "https://storage.googleapis.com/storage/v1/b/test-bucket/o/test-object";
+  std::size_t sink = 0;
+  for (long i = 0; i != iterations; ++i) {
+    gcs::internal::ReadObjectRangeRequest request("test-bucket",
+                                                  "test-object");
+    request.set_multiple_options(
+        gcs::Generation(12345), gcs::IfGenerationMatch(12345),
+        gcs::UserProject("test-project"), gcs::QuotaUser("test-quota-user"),
+        gcs::Fields("bucket,name,generation"));
+    gcs::internal::CurlRequestBuilder builder(base_url, factory);
+    request.AddOptionsToHttpRequest(builder);
+    auto http_request = builder.BuildRequest();
+    sink += request.object_name().size();
+  }
+  return sink;
+}
+
+MicrobenchmarkResult RunOne(std::string name, Microbenchmark const& bm,
+                            long iterations) {
+  gcs_bm::SimpleTimer timer;
+  timer.Start();
+  auto sink = bm(iterations);
+  timer.Stop();
+  // Touch the accumulated value so the compiler cannot elide the work.
+  if (sink == 0) std::cerr << "# " << name << ": empty results\n";
+  return MicrobenchmarkResult{std::move(name),       iterations,
+                              timer.elapsed_time(),  timer.cpu_time(),
+                              timer.allocation_count(),
+                              timer.allocated_bytes()};
+}
+
+void PrintResult(MicrobenchmarkResult const& result) {
+  auto const count = static_cast<double>(result.iterations);
+  std::cout << result.name << ',' << result.iterations << ','
+            << result.elapsed_time.count() << ',' << result.cpu_time.count()
+            << ',' << 1000.0 * result.elapsed_time.count() / count << ','
+            << static_cast<double>(result.allocation_count) / count << ','
+            << static_cast<double>(result.allocated_bytes) / count << "\n";
+}
+
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::cloud::StatusOr<Options> options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Iterations: " << options->iterations
+            << "\n# Repeats: " << options->repeats
+            << "\n# Build info: " << notes
+            << "\n# Benchmark,Iterations,ElapsedTime(us),CpuTime(us)"
+               ",NsPerOp,AllocationsPerOp,AllocatedBytesPerOp"
+            << std::endl;
+
+  struct {
+    char const* name;
+    Microbenchmark benchmark;
+  } microbenchmarks[] = {
+      {"ParseObjectMetadata", ParseObjectMetadata},
+      {"BuildRequestUrl", BuildRequestUrl},
+      {"ComputePatch", ComputePatch},
+      {"ApplyRequestOptions", ApplyRequestOptions},
+  };
+  for (auto const& bm : microbenchmarks) {
+    for (int repeat = 0; repeat != options->repeats; ++repeat) {
+      PrintResult(RunOne(bm.name, bm.benchmark, options->iterations));
+    }
+  }
+
+  return 0;
+}
+
+namespace {
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  Options options;
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<gcs_bm::OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print benchmark description",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--iterations", "number of iterations in each repeat",
+       [&options](std::string const& val) {
+         options.iterations = std::stol(val);
+       }},
+      {"--repeats", "number of times to repeat each microbenchmark",
+       [&options](std::string const& val) {
+         options.repeats = std::stoi(val);
+       }},
+  };
+  auto usage = gcs_bm::BuildUsage(desc, argv[0]);
+
+  auto unparsed = gcs_bm::OptionsParse(desc, {argv, argv + argc});
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+  if (unparsed.size() > 1) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  return options;
+}
+}  // namespace
@@ -0,0 +1,744 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include <iostream>
+#include <sstream>
+
+namespace {
+char const kDescription[] = R"""(
+An in-process C++ testbench for high-fidelity benchmarking.
+
+The Python testbench saturates a core at a few hundred MB/s, so running the
+benchmarks against it measures the testbench and not the client. This
+program implements the subset of the JSON, XML, and resumable upload APIs
+used by the benchmarks, storing all objects in memory. It serves multiple
+GB/s on a single machine, making the client-side CPU costs (hashing,
+parsing, buffering) visible in the benchmark results.
+
+Usage:
+
+    ./storage_cpp_testbench --port=8585 &
+    export CLOUD_STORAGE_TESTBENCH_ENDPOINT=http://127.0.0.1:8585
+    ./storage_throughput_benchmark ...
+
+The server implements, with no error injection and no pagination:
+
+- Bucket create / get / delete.
+- Object insert (media, multipart, and resumable uploads), get, list,
+  download (JSON and XML, including ranged reads), compose, and delete.
+
+It is *not* a conformance testbench, use the Python testbench to validate
+correctness.
+)""";
+}  // namespace
+
+#if _WIN32
+
+int main(int, char*[]) {
+  std::cerr << "storage_cpp_testbench is not supported on Windows\n";
+  return 1;
+}
+
+#else
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+namespace gcs = google::cloud::storage;
+namespace gcs_bm = google::cloud::storage_benchmarks;
+namespace nl = google::cloud::storage::internal::nl;
+
+struct StoredObject {
+  std::string bucket;
+  std::string name;
+  std::int64_t generation;
+  std::shared_ptr<std::string const> media;
+  std::string crc32c;
+  std::string md5;
+};
+
+nl::json ObjectResource(StoredObject const& o) {
+  return nl::json{
+      {"kind", "storage#object"},
+      {"id", o.bucket + "/" + o.name + "/" + std::to_string(o.generation)},
+      {"bucket", o.bucket},
+      {"name", o.name},
+      {"generation", std::to_string(o.generation)},
+      {"metageneration", "1"},
+      {"size", std::to_string(o.media->size())},
+      {"storageClass", "STANDARD"},
+      {"crc32c", o.crc32c},
+      {"md5Hash", o.md5},
+      {"etag", "etag-" + std::to_string(o.generation)},
+  };
+}
+
+nl::json BucketResource(std::string const& name, std::string const& location) {
+  return nl::json{
+      {"kind", "storage#bucket"},  {"id", name},
+      {"name", name},              {"location", location},
+      {"locationType", "region"},  {"storageClass", "STANDARD"},
+      {"metageneration", "1"},     {"etag", "etag-1"},
+  };
+}
+
+/**
+ * The in-memory object store shared by all the server threads.
+ *
+ * The mutex only protects the metadata maps, downloads hold a
+ * `shared_ptr` to the immutable media so large transfers proceed without
+ * the lock and without copying the contents.
+ */
+class Store {
+ public:
+  Store() = default;
+
+  nl::json CreateBucket(std::string name, std::string location) {
+    std::lock_guard<std::mutex> lk(mu_);
+    buckets_[name] = location;
+    objects_[name];
+    return BucketResource(name, location);
+  }
+
+  bool GetBucket(std::string const& name, nl::json& resource) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto loc = buckets_.find(name);
+    if (loc == buckets_.end()) return false;
+    resource = BucketResource(name, loc->second);
+    return true;
+  }
+
+  bool DeleteBucket(std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    objects_.erase(name);
+    return buckets_.erase(name) != 0;
+  }
+
+  StoredObject Insert(std::string const& bucket, std::string const& name,
+                      std::string media) {
+    auto contents = std::make_shared<std::string const>(std::move(media));
+    StoredObject object{bucket, name, 0, contents,
+                        gcs::ComputeCrc32cChecksum(*contents),
+                        gcs::ComputeMD5Hash(*contents)};
+    std::lock_guard<std::mutex> lk(mu_);
+    object.generation = ++generation_;
+    objects_[bucket][name] = object;
+    return object;
+  }
+
+  bool Get(std::string const& bucket, std::string const& name,
+           StoredObject& object) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto b = objects_.find(bucket);
+    if (b == objects_.end()) return false;
+    auto o = b->second.find(name);
+    if (o == b->second.end()) return false;
+    object = o->second;
+    return true;
+  }
+
+  bool Delete(std::string const& bucket, std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto b = objects_.find(bucket);
+    if (b == objects_.end()) return false;
+    return b->second.erase(name) != 0;
+  }
+
+  nl::json List(std::string const& bucket) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto items = nl::json::array();
+    auto b = objects_.find(bucket);
+    if (b != objects_.end()) {
+      for (auto const& kv : b->second) {
+        items.push_back(ObjectResource(kv.second));
+      }
+    }
+    return nl::json{{"kind", "storage#objects"}, {"items", std::move(items)}};
+  }
+
+  std::string CreateUploadSession(std::string bucket, std::string name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto id = "upload-" + std::to_string(++generation_);
+    sessions_[id] = Session{std::move(bucket), std::move(name), {}};
+    return id;
+  }
+
+  /**
+   * Append @p payload to the session, finalize the object when @p final.
+   *
+   * Returns the committed byte count, and on a finalized upload fills in
+   * @p object.
+   */
+  std::size_t AppendUpload(std::string const& id, std::string const& payload,
+                           bool final, bool& found, StoredObject& object) {
+    std::string bucket;
+    std::string name;
+    std::string media;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      auto session = sessions_.find(id);
+      found = session != sessions_.end();
+      if (!found) return 0;
+      session->second.contents.append(payload);
+      if (!final) return session->second.contents.size();
+      bucket = std::move(session->second.bucket);
+      name = std::move(session->second.name);
+      media = std::move(session->second.contents);
+      sessions_.erase(session);
+    }
+    auto size = media.size();
+    object = Insert(bucket, name, std::move(media));
+    return size;
+  }
+
+  std::size_t SessionSize(std::string const& id, bool& found) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto session = sessions_.find(id);
+    found = session != sessions_.end();
+    if (!found) return 0;
+    return session->second.contents.size();
+  }
+
+ private:
+  struct Session {
+    std::string bucket;
+    std::string name;
+    std::string contents;
+  };
+
+  std::mutex mu_;
+  std::map<std::string, std::string> buckets_;
+  std::map<std::string, std::map<std::string, StoredObject>> objects_;
+  std::map<std::string, Session> sessions_;
+  std::int64_t generation_ = 0;
+};
+
+struct Request {
+  std::string method;
+  std::string path;
+  std::map<std::string, std::string> query;
+  std::map<std::string, std::string> headers;  // lowercase field names
+  std::string body;
+};
+
+struct Response {
+  int status = 200;
+  std::string reason = "OK";
+  std::vector<std::pair<std::string, std::string>> headers;
+  // Large bodies (downloads) borrow the stored media, `body_offset` and
+  // `body_length` select the range to send.
+  std::shared_ptr<std::string const> body;
+  std::size_t body_offset = 0;
+  std::size_t body_length = 0;
+
+  void SetBody(std::string contents) {
+    body = std::make_shared<std::string const>(std::move(contents));
+    body_offset = 0;
+    body_length = body->size();
+  }
+};
+
+Response JsonResponse(nl::json const& resource) {
+  Response response;
+  response.headers.emplace_back("Content-Type", "application/json");
+  response.SetBody(resource.dump());
+  return response;
+}
+
+Response ErrorResponse(int status, std::string reason) {
+  Response response;
+  response.status = status;
+  response.reason = std::move(reason);
+  response.SetBody("{\"error\": {\"code\": " + std::to_string(status) + "}}");
+  return response;
+}
+
+std::string UrlUnescape(std::string const& value) {
+  std::string result;
+  result.reserve(value.size());
+  for (std::size_t i = 0; i != value.size(); ++i) {
+    if (value[i] == '%' && i + 2 < value.size()) {
+      result += static_cast<char>(
+          std::stoi(value.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else if (value[i] == '+') {
+      result += ' ';
+    } else {
+      result += value[i];
+    }
+  }
+  return result;
+}
+
+std::vector<std::string> SplitPath(std::string const& path) {
+  std::vector<std::string> segments;
+  std::istringstream is{path};
+  std::string segment;
+  while (std::getline(is, segment, '/')) {
+    if (!segment.empty()) segments.push_back(UrlUnescape(segment));
+  }
+  return segments;
+}
+
+/// Parse a `Content-Range: bytes a-b/N` header, returns false on errors.
+bool ParseContentRange(std::string const& value, std::int64_t& first,
+                       std::int64_t& last, std::int64_t& total) {
+  first = last = total = -1;
+  if (value.rfind("bytes ", 0) != 0) return false;
+  auto spec = value.substr(6);
+  auto slash = spec.find('/');
+  if (slash == std::string::npos) return false;
+  auto range = spec.substr(0, slash);
+  auto size = spec.substr(slash + 1);
+  if (size != "*") total = std::stoll(size);
+  if (range != "*") {
+    auto dash = range.find('-');
+    if (dash == std::string::npos) return false;
+    first = std::stoll(range.substr(0, dash));
+    last = std::stoll(range.substr(dash + 1));
+  }
+  return true;
+}
+
+Response HandleDownload(StoredObject const& object, Request const& request) {
+  Response response;
+  auto const size = object.media->size();
+  std::size_t first = 0;
+  std::size_t last = size == 0 ? 0 : size - 1;
+  auto range = request.headers.find("range");
+  if (range != request.headers.end() &&
+      range->second.rfind("bytes=", 0) == 0 && size != 0) {
+    auto spec = range->second.substr(6);
+    auto dash = spec.find('-');
+    first = (std::min<std::size_t>)(std::stoull(spec.substr(0, dash)),
+                                    size - 1);
+    if (dash != std::string::npos && dash + 1 < spec.size()) {
+      last = (std::min<std::size_t>)(std::stoull(spec.substr(dash + 1)),
+                                     size - 1);
+    }
+    response.status = 206;
+    response.reason = "Partial Content";
+    std::ostringstream os;
+    os << "bytes " << first << "-" << last << "/" << size;
+    response.headers.emplace_back("Content-Range", std::move(os).str());
+  }
+  response.headers.emplace_back(
+      "x-goog-hash", "crc32c=" + object.crc32c + ",md5=" + object.md5);
+  response.headers.emplace_back("x-goog-generation",
+                                std::to_string(object.generation));
+  response.body = object.media;
+  response.body_offset = first;
+  response.body_length = size == 0 ? 0 : last - first + 1;
+  return response;
+}
+
+Response HandleResumableChunk(Store& store, std::string const& upload_id,
+                              Request const& request) {
+  std::int64_t first, last, total;
+  auto content_range = request.headers.find("content-range");
+  if (content_range == request.headers.end() ||
+      !ParseContentRange(content_range->second, first, last, total)) {
+    return ErrorResponse(400, "Bad Request");
+  }
+  bool found = false;
+  std::size_t committed = 0;
+  StoredObject object;
+  if (first < 0 && request.body.empty() && total < 0) {
+    // A `Content-Range: bytes */*` header queries the session status.
+    committed = store.SessionSize(upload_id, found);
+    if (!found) return ErrorResponse(404, "Not Found");
+  } else {
+    bool final = total >= 0 && (first < 0 || last + 1 == total);
+    committed =
+        store.AppendUpload(upload_id, request.body, final, found, object);
+    if (!found) return ErrorResponse(404, "Not Found");
+    if (final) return JsonResponse(ObjectResource(object));
+  }
+  Response response;
+  response.status = 308;
+  response.reason = "Resume Incomplete";
+  if (committed != 0) {
+    response.headers.emplace_back(
+        "Range", "bytes=0-" + std::to_string(committed - 1));
+  }
+  response.SetBody("");
+  return response;
+}
+
+Response HandleUpload(Store& store, std::string const& bucket,
+                      Request const& request) {
+  auto upload_type = request.query.find("uploadType");
+  auto type =
+      upload_type == request.query.end() ? "media" : upload_type->second;
+  auto name = request.query.find("name");
+  if (type == "resumable") {
+    auto upload_id = request.query.find("upload_id");
+    if (upload_id != request.query.end()) {
+      return HandleResumableChunk(store, upload_id->second, request);
+    }
+    std::string object_name;
+    if (name != request.query.end()) {
+      object_name = name->second;
+    } else if (!request.body.empty()) {
+      object_name =
+          nl::json::parse(request.body).value("name", std::string{});
+    }
+    auto id = store.CreateUploadSession(bucket, object_name);
+    auto host = request.headers.find("host");
+    Response response;
+    response.headers.emplace_back(
+        "Location", "http://" +
+                        (host == request.headers.end() ? std::string("")
+                                                       : host->second) +
+                        "/upload/storage/v1/b/" + bucket +
+                        "/o?uploadType=resumable&upload_id=" + id);
+    response.SetBody("");
+    return response;
+  }
+  if (type == "multipart") {
+    // The body is `multipart/related`, part one has the metadata and part
+    // two the media.
+    auto content_type = request.headers.find("content-type");
+    if (content_type == request.headers.end()) {
+      return ErrorResponse(400, "Bad Request");
+    }
+    auto b = content_type->second.find("boundary=");
+    if (b == std::string::npos) return ErrorResponse(400, "Bad Request");
+    auto boundary = "--" + content_type->second.substr(b + 9);
+    auto metadata_start = request.body.find("\r\n\r\n");
+    auto media_start = request.body.find(boundary, metadata_start);
+    media_start = request.body.find("\r\n\r\n", media_start) + 4;
+    auto media_end = request.body.rfind(boundary);
+    auto metadata = nl::json::parse(
+        request.body.substr(metadata_start + 4,
+                            request.body.find(boundary, metadata_start) -
+                                metadata_start - 4));
+    auto object = store.Insert(
+        bucket, metadata.value("name", std::string{}),
+        request.body.substr(media_start, media_end - media_start - 2));
+    return JsonResponse(ObjectResource(object));
+  }
+  // uploadType=media
+  if (name == request.query.end()) return ErrorResponse(400, "Bad Request");
+  auto object = store.Insert(bucket, name->second, request.body);
+  return JsonResponse(ObjectResource(object));
+}
+
+Response HandleCompose(Store& store, std::string const& bucket,
+                       std::string const& name, Request const& request) {
+  auto payload = nl::json::parse(request.body);
+  std::string contents;
+  for (auto const& source : payload["sourceObjects"]) {
+    StoredObject object;
+    if (!store.Get(bucket, source.value("name", std::string{}), object)) {
+      return ErrorResponse(404, "Not Found");
+    }
+    contents.append(*object.media);
+  }
+  auto composed = store.Insert(bucket, name, std::move(contents));
+  return JsonResponse(ObjectResource(composed));
+}
+
+Response HandleRequest(Store& store, Request const& request) {
+  auto segments = SplitPath(request.path);
+  // XML API: /xmlapi/{bucket}/{object}
+  if (segments.size() >= 3 && segments[0] == "xmlapi") {
+    auto object_name = segments[2];
+    for (std::size_t i = 3; i != segments.size(); ++i) {
+      object_name += "/" + segments[i];
+    }
+    if (request.method == "PUT") {
+      auto object = store.Insert(segments[1], object_name, request.body);
+      Response response;
+      response.headers.emplace_back("x-goog-generation",
+                                    std::to_string(object.generation));
+      response.SetBody("");
+      return response;
+    }
+    StoredObject object;
+    if (!store.Get(segments[1], object_name, object)) {
+      return ErrorResponse(404, "Not Found");
+    }
+    return HandleDownload(object, request);
+  }
+  // Resumable and media uploads: /upload/storage/v1/b/{bucket}/o
+  if (segments.size() == 6 && segments[0] == "upload" &&
+      segments[1] == "storage" && segments[3] == "b" && segments[5] == "o") {
+    return HandleUpload(store, segments[4], request);
+  }
+  if (segments.size() < 3 || segments[0] != "storage" || segments[2] != "b") {
+    return ErrorResponse(404, "Not Found");
+  }
+  // JSON API: /storage/v1/b[/{bucket}[/o[/{object}[/compose]]]]
+  if (segments.size() == 3 && request.method == "POST") {
+    auto metadata = nl::json::parse(request.body);
+    return JsonResponse(
+        store.CreateBucket(metadata.value("name", std::string{}),
+                           metadata.value("location", std::string{})));
+  }
+  if (segments.size() == 4) {
+    if (request.method == "GET") {
+      nl::json resource;
+      if (!store.GetBucket(segments[3], resource)) {
+        return ErrorResponse(404, "Not Found");
+      }
+      return JsonResponse(resource);
+    }
+    if (request.method == "DELETE") {
+      if (!store.DeleteBucket(segments[3])) {
+        return ErrorResponse(404, "Not Found");
+      }
+      return JsonResponse(nl::json::object());
+    }
+  }
+  if (segments.size() == 5 && segments[4] == "o" && request.method == "GET") {
+    return JsonResponse(store.List(segments[3]));
+  }
+  if (segments.size() == 6 && segments[4] == "o") {
+    StoredObject object;
+    if (request.method == "DELETE") {
+      if (!store.Delete(segments[3], segments[5])) {
+        return ErrorResponse(404, "Not Found");
+      }
+      return JsonResponse(nl::json::object());
+    }
+    if (request.method == "GET") {
+      if (!store.Get(segments[3], segments[5], object)) {
+        return ErrorResponse(404, "Not Found");
+      }
+      auto alt = request.query.find("alt");
+      if (alt != request.query.end() && alt->second == "media") {
+        return HandleDownload(object, request);
+      }
+      return JsonResponse(ObjectResource(object));
+    }
+  }
+  if (segments.size() == 7 && segments[4] == "o" &&
+      segments[6] == "compose" && request.method == "POST") {
+    return HandleCompose(store, segments[3], segments[5], request);
+  }
+  return ErrorResponse(404, "Not Found");
+}
+
+/// Buffers the data received over one connection.
+class ConnectionReader {
+ public:
+  explicit ConnectionReader(int fd) : fd_(fd) {}
+
+  bool ReadLine(std::string& line) {
+    for (;;) {
+      auto eol = buffer_.find("\r\n", offset_);
+      if (eol != std::string::npos) {
+        line = buffer_.substr(offset_, eol - offset_);
+        offset_ = eol + 2;
+        return true;
+      }
+      if (!Fill()) return false;
+    }
+  }
+
+  bool ReadExactly(std::size_t count, std::string& contents) {
+    while (buffer_.size() - offset_ < count) {
+      if (!Fill()) return false;
+    }
+    contents = buffer_.substr(offset_, count);
+    offset_ += count;
+    return true;
+  }
+
+ private:
+  bool Fill() {
+    // Compact the buffer before growing it, downloads and uploads reuse
+    // the connection many times.
+    if (offset_ != 0) {
+      buffer_.erase(0, offset_);
+      offset_ = 0;
+    }
+    char chunk[65536];
+    auto n = ::recv(fd_, chunk, sizeof(chunk), 0);
+    if (n <= 0) return false;
+    buffer_.append(chunk, static_cast<std::size_t>(n));
+    return true;
+  }
+
+  int fd_;
+  std::string buffer_;
+  std::size_t offset_ = 0;
+};
+
+bool SendAll(int fd, char const* data, std::size_t count) {
+  while (count != 0) {
+#ifdef MSG_NOSIGNAL
+    auto n = ::send(fd, data, count, MSG_NOSIGNAL);
+#else
+    auto n = ::send(fd, data, count, 0);
+#endif  // MSG_NOSIGNAL
+    if (n <= 0) return false;
+    data += n;
+    count -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+bool WriteResponse(int fd, Response const& response) {
+  std::ostringstream os;
+  os << "HTTP/1.1 " << response.status << " " << response.reason << "\r\n";
+  for (auto const& header : response.headers) {
+    os << header.first << ": " << header.second << "\r\n";
+  }
+  os << "Content-Length: " << response.body_length << "\r\n"
+     << "Connection: keep-alive\r\n\r\n";
+  auto head = std::move(os).str();
+  if (!SendAll(fd, head.data(), head.size())) return false;
+  if (response.body_length == 0) return true;
+  return SendAll(fd, response.body->data() + response.body_offset,
+                 response.body_length);
+}
+
+void HandleConnection(Store& store, int fd) {
+  int flag = 1;
+  (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  ConnectionReader reader(fd);
+  std::string line;
+  while (reader.ReadLine(line)) {
+    Request request;
+    // Parse `METHOD /path?query HTTP/1.1`.
+    auto method_end = line.find(' ');
+    auto target_end = line.find(' ', method_end + 1);
+    if (method_end == std::string::npos || target_end == std::string::npos) {
+      break;
+    }
+    request.method = line.substr(0, method_end);
+    auto target = line.substr(method_end + 1, target_end - method_end - 1);
+    auto question = target.find('?');
+    request.path = target.substr(0, question);
+    if (question != std::string::npos) {
+      std::istringstream is{target.substr(question + 1)};
+      std::string parameter;
+      while (std::getline(is, parameter, '&')) {
+        auto eq = parameter.find('=');
+        auto value = eq == std::string::npos
+                         ? std::string{}
+                         : UrlUnescape(parameter.substr(eq + 1));
+        request.query[UrlUnescape(parameter.substr(0, eq))] = std::move(value);
+      }
+    }
+    while (reader.ReadLine(line) && !line.empty()) {
+      auto colon = line.find(':');
+      if (colon == std::string::npos) continue;
+      auto name = line.substr(0, colon);
+      std::transform(name.begin(), name.end(), name.begin(),
+                     [](char c) { return static_cast<char>(std::tolower(c)); });
+      auto value = line.substr(colon + 1);
+      value.erase(0, value.find_first_not_of(' '));
+      request.headers[name] = value;
+    }
+    auto expect = request.headers.find("expect");
+    if (expect != request.headers.end() &&
+        expect->second == "100-continue") {
+      char const kContinue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+      if (!SendAll(fd, kContinue, sizeof(kContinue) - 1)) break;
+    }
+    auto content_length = request.headers.find("content-length");
+    if (content_length != request.headers.end()) {
+      auto count = std::stoull(content_length->second);
+      if (!reader.ReadExactly(count, request.body)) break;
+    }
+    if (!WriteResponse(fd, HandleRequest(store, request))) break;
+  }
+  (void)::close(fd);
+}
+
+int RunServer(int port) {
+  (void)std::signal(SIGPIPE, SIG_IGN);
+  int server = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (server < 0) {
+    std::cerr << "cannot create socket: " << std::strerror(errno) << "\n";
+    return 1;
+  }
+  int flag = 1;
+  (void)setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(static_cast<std::uint16_t>(port));
+  if (::bind(server, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(server, 128) != 0) {
+    std::cerr << "cannot bind or listen on port " << port << ": "
+              << std::strerror(errno) << "\n";
+    return 1;
+  }
+  socklen_t length = sizeof(address);
+  (void)getsockname(server, reinterpret_cast<sockaddr*>(&address), &length);
+  std::cout << "# Listening on http://127.0.0.1:" << ntohs(address.sin_port)
+            << std::endl;
+
+  Store store;
+  for (;;) {
+    int fd = ::accept(server, nullptr, nullptr);
+    if (fd < 0) continue;
+    std::thread{[&store, fd] { HandleConnection(store, fd); }}.detach();
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int port = 8585;
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<gcs_bm::OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print testbench description",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--port", "listen on the given port, 0 picks a free port",
+       [&port](std::string const& val) { port = std::stoi(val); }},
+  };
+  auto usage = gcs_bm::BuildUsage(desc, argv[0]);
+  auto unparsed = gcs_bm::OptionsParse(desc, {argv, argv + argc});
+  if (wants_help) {
+    std::cout << usage << "\n";
+    return 0;
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+    return 0;
+  }
+  if (unparsed.size() > 1) {
+    std::cerr << "Unknown arguments or options\n" << usage << "\n";
+    return 1;
+  }
+  return RunServer(port);
+}
+
+#endif  // _WIN32
@@ -17,7 +17,7 @@
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/random.h"
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
-#include "google/cloud/storage/benchmarks/bounded_queue.h"
+#include "google/cloud/storage/internal/bounded_mpmc_queue.h"
 #include "google/cloud/storage/client.h"
 #include <future>
 #include <iomanip>
@@ -78,7 +78,7 @@ struct WorkItem {
   std::int64_t end;
 };
 
-using WorkItemQueue = gcs_bm::BoundedQueue<WorkItem>;
+using WorkItemQueue = gcs::internal::BoundedMpmcQueue<WorkItem>;
 
 struct IterationResult {
   std::int64_t bytes;
@@ -270,7 +270,7 @@ IterationResult RunOneIteration(google::cloud::internal::DefaultPRNG& generator,
   using std::chrono::duration_cast;
   using std::chrono::microseconds;
 
-  WorkItemQueue work_queue;
+  WorkItemQueue work_queue(1024);
   std::vector<std::future<void>> workers;
   std::generate_n(std::back_inserter(workers), options.thread_count,
                   [&work_queue] {
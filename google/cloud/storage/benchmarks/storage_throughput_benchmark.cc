@@ -92,6 +92,9 @@ struct IterationResult {
   ApiName api;
   std::size_t bytes;
   std::chrono::microseconds elapsed;
+  std::chrono::microseconds cpu_time;
+  std::uint64_t allocation_count;
+  std::uint64_t allocated_bytes;
 };
 using TestResult = std::vector<IterationResult>;
 
@@ -190,7 +193,9 @@ int main(int argc, char* argv[]) {
             << "\n# Upload Objects: " << options->upload_objects
             << "\n# Download Objects: " << options->download_objects
             << "\n# Build info: " << notes
-            << "\n# OpType,ApiName,Bytes,ElapsedTime(us)" << std::endl;
+            << "\n# OpType,ApiName,Bytes,ElapsedTime(us),CpuTime(us)"
+               ",AllocationCount,AllocatedBytes"
+            << std::endl;
 
   std::vector<std::string> object_names;
   if (options->create_objects) {
@@ -240,15 +245,16 @@ char const* ToString(ApiName api) {
 void PrintResult(TestResult const& result) {
   for (auto const& r : result) {
     std::cout << ToString(r.op) << ',' << ToString(r.api) << ',' << r.bytes
-              << ',' << r.elapsed.count() << "\n";
+              << ',' << r.elapsed.count() << ',' << r.cpu_time.count() << ','
+              << r.allocation_count << ',' << r.allocated_bytes << "\n";
   }
 }
 
 TestResult WriteCommon(gcs::Client client, std::string const& object_name,
                        std::string const& data_chunk, Options const& options,
                        OpType op_type, ApiName api) {
-  using std::chrono::microseconds;
-  auto start = std::chrono::steady_clock::now();
+  gcs_bm::SimpleTimer timer;
+  timer.Start();
 
   TestResult result;
 
@@ -268,16 +274,18 @@ TestResult WriteCommon(gcs::Client client, std::string const& object_name,
   // during Close(), the status with the error message is returned by
   // metadata().
   auto status = stream.metadata();
+  timer.Stop();
   if (!status.ok()) {
     std::cerr << status.status().message() << "\n";
-    auto elapsed = std::chrono::steady_clock::now() - start;
-    result.emplace_back(IterationResult{
-        op_type, api, 0, std::chrono::duration_cast<microseconds>(elapsed)});
+    result.emplace_back(IterationResult{op_type, api, 0, timer.elapsed_time(),
+                                        timer.cpu_time(),
+                                        timer.allocation_count(),
+                                        timer.allocated_bytes()});
   } else {
-    auto elapsed = std::chrono::steady_clock::now() - start;
     result.emplace_back(IterationResult{
         op_type, api, static_cast<std::size_t>(options.object_size),
-        std::chrono::duration_cast<microseconds>(elapsed)});
+        timer.elapsed_time(), timer.cpu_time(), timer.allocation_count(),
+        timer.allocated_bytes()});
   }
   return result;
 }
@@ -297,8 +305,8 @@ TestResult WriteOnce(gcs::Client client, std::string const& object_name,
 
 TestResult ReadOnce(gcs::Client client, std::string const& object_name,
                     Options const& options, ApiName api, gcs::ReadRange range) {
-  using std::chrono::microseconds;
-  auto start = std::chrono::steady_clock::now();
+  gcs_bm::SimpleTimer timer;
+  timer.Start();
   TestResult result;
 
   gcs::ObjectReadStream stream =
@@ -312,10 +320,10 @@ TestResult ReadOnce(gcs::Client client, std::string const& object_name,
     stream.read(buffer.data(), buffer.size());
     total_size += stream.gcount();
   } while (stream.good());
-  auto elapsed = std::chrono::steady_clock::now() - start;
-  result.emplace_back(
-      IterationResult{OpType::OP_READ, api, total_size,
-                      std::chrono::duration_cast<microseconds>(elapsed)});
+  timer.Stop();
+  result.emplace_back(IterationResult{
+      OpType::OP_READ, api, total_size, timer.elapsed_time(), timer.cpu_time(),
+      timer.allocation_count(), timer.allocated_bytes()});
   return result;
 }
 
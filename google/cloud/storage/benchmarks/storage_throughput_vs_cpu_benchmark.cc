@@ -59,11 +59,13 @@ this loop until a prescribed *time* has elapsed:
 - Upload an object of the selected size, choosing the name of the object at
   random.
 - Once the object is fully uploaded, the program captures the object size, the
-  chunk size, the elapsed time (in microseconds), the CPU time (in microseconds)
-  used during the upload, and the status code for the upload.
+  chunk size, the elapsed time (in microseconds), the CPU time (in
+  microseconds) and the allocations performed during the upload, and the
+  status code for the upload.
 - Then the program downloads the same object, and captures the object size, the
-  chunk size, the elapsed time (in microseconds), the CPU time (in microseconds)
-  used during the download, and the status code for the download.
+  chunk size, the elapsed time (in microseconds), the CPU time (in
+  microseconds) and the allocations performed during the download, and the
+  status code for the download.
 - The program then deletes this object and starts another iteration.
 
 The loop stops when any of the following conditions are met:
@@ -103,6 +105,8 @@ struct IterationResult {
   bool md5_enabled;
   std::chrono::microseconds elapsed_time;
   std::chrono::microseconds cpu_time;
+  std::uint64_t allocation_count;
+  std::uint64_t allocated_bytes;
   google::cloud::StatusCode status;
   std::vector<gcs_bm::ProgressReporter::TimePoint> progress;
 };
@@ -230,6 +234,7 @@ std::ostream& operator<<(std::ostream& os, IterationResult const& rhs) {
             << rhs.chunk_size << ',' << rhs.buffer_size << ','
             << rhs.crc_enabled << ',' << rhs.md5_enabled << ','
             << rhs.elapsed_time.count() << ',' << rhs.cpu_time.count() << ','
+            << rhs.allocation_count << ',' << rhs.allocated_bytes << ','
             << rhs.status << ',' << rhs.progress << ','
             << google::cloud::storage::version_string();
 }
@@ -310,6 +315,7 @@ TestResults RunThread(Options const& options, std::string const& bucket_name) {
     results.emplace_back(IterationResult{
         OP_UPLOAD, object_size, chunk_size, download_buffer_size, enable_crc,
         enable_md5, timer.elapsed_time(), timer.cpu_time(),
+        timer.allocation_count(), timer.allocated_bytes(),
         object_metadata.status().code(), progress.GetAccumulatedProgress()});
 
     if (!object_metadata) {
@@ -332,6 +338,7 @@ TestResults RunThread(Options const& options, std::string const& bucket_name) {
     results.emplace_back(IterationResult{
         OP_DOWNLOAD, object_size, chunk_size, upload_buffer_size, enable_crc,
         enable_md5, timer.elapsed_time(), timer.cpu_time(),
+        timer.allocation_count(), timer.allocated_bytes(),
         reader.status().code(), progress.GetAccumulatedProgress()});
 
     auto status =
@@ -733,13 +733,17 @@ class BucketMetadata : private internal::CommonMetadata<BucketMetadata> {
   }
   //@}
 
-  std::string const& location() const { return location_; }
+  // The `&&`-qualified overloads let callers steal the string from an
+  // expiring value.
+  std::string const& location() const& { return location_; }
+  std::string&& location() && { return std::move(location_); }
   BucketMetadata& set_location(std::string v) {
     location_ = std::move(v);
     return *this;
   }
 
-  std::string const& location_type() const { return location_type_; }
+  std::string const& location_type() const& { return location_type_; }
+  std::string&& location_type() && { return std::move(location_type_); }
 
   //@{
   /// @name Accessors and modifiers for logging configuration.
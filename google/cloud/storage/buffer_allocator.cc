@@ -0,0 +1,135 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/buffer_allocator.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+// The (typical) size of a huge page, also used as the alignment target on
+// platforms without explicit huge page support.
+std::size_t constexpr kHugePageSize = 2 * 1024 * 1024;
+
+class NewDeleteBufferAllocator : public BufferAllocator {
+ public:
+  void* Allocate(std::size_t size) override { return ::operator new(size); }
+  void Deallocate(void* buffer, std::size_t) override {
+    ::operator delete(buffer);
+  }
+};
+
+#if defined(__linux__)
+class LinuxHugePageBufferAllocator : public BufferAllocator {
+ public:
+  void* Allocate(std::size_t size) override {
+    auto const rounded = RoundUpToHugePage(size);
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages give the strongest guarantee, but require the
+    // administrator to reserve them (vm.nr_hugepages), so failure is common.
+    void* p = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      return p;
+    }
+#endif  // MAP_HUGETLB
+    void* p2 = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p2 == MAP_FAILED) {
+      // Out of memory, report it like `operator new` would.
+      ThrowBadAlloc();
+    }
+#if defined(MADV_HUGEPAGE)
+    // Best effort, the kernel promotes the region to transparent huge pages
+    // when it can, the mapping is usable either way.
+    (void)::madvise(p2, rounded, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+    return p2;
+  }
+
+  void Deallocate(void* buffer, std::size_t size) override {
+    (void)::munmap(buffer, RoundUpToHugePage(size));
+  }
+
+ private:
+  static std::size_t RoundUpToHugePage(std::size_t size) {
+    return (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  }
+
+  [[noreturn]] static void ThrowBadAlloc() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+};
+#else   // __linux__
+/**
+ * A portable fallback that aligns buffers to the huge page size.
+ *
+ * Over-allocates by the alignment, and stores the pointer returned by
+ * `operator new` just before the aligned region so `Deallocate()` can find
+ * it.
+ */
+class AlignedBufferAllocator : public BufferAllocator {
+ public:
+  void* Allocate(std::size_t size) override {
+    auto* raw = static_cast<char*>(
+        ::operator new(size + kHugePageSize + sizeof(void*)));
+    auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+    auto aligned = (address + kHugePageSize - 1) / kHugePageSize *
+                   kHugePageSize;
+    auto* result = reinterpret_cast<char*>(aligned);
+    std::memcpy(result - sizeof(void*), &raw, sizeof(void*));
+    return result;
+  }
+
+  void Deallocate(void* buffer, std::size_t) override {
+    void* raw;
+    std::memcpy(&raw, static_cast<char*>(buffer) - sizeof(void*),
+                sizeof(void*));
+    ::operator delete(raw);
+  }
+};
+#endif  // __linux__
+
+}  // namespace
+
+std::shared_ptr<BufferAllocator> DefaultBufferAllocator() {
+  static auto const* const kInstance =
+      new std::shared_ptr<BufferAllocator>(new NewDeleteBufferAllocator);
+  return *kInstance;
+}
+
+std::shared_ptr<BufferAllocator> HugePageBufferAllocator() {
+#if defined(__linux__)
+  return std::make_shared<LinuxHugePageBufferAllocator>();
+#else
+  return std::make_shared<AlignedBufferAllocator>();
+#endif  // __linux__
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,151 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_ALLOCATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_ALLOCATOR_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Allocates the transfer and spill buffers used by object streams.
+ *
+ * The object read and write streams buffer multiple MiB of data per stream.
+ * Some applications want control over where this memory comes from, for
+ * example to place the buffers on huge pages (reducing TLB misses during
+ * multi-GB/s transfers), or to allocate them from memory local to the NUMA
+ * node driving the NIC. Implement this interface and install it with
+ * `ClientOptions::set_buffer_allocator()` to customize the placement.
+ *
+ * Implementations must be thread-safe, buffers may be allocated and released
+ * from multiple threads concurrently.
+ */
+class BufferAllocator {
+ public:
+  virtual ~BufferAllocator() = default;
+
+  /**
+   * Allocates a buffer of at least @p size bytes.
+   *
+   * May throw `std::bad_alloc` (or terminate the program when exceptions are
+   * disabled), just like `operator new`, if the memory is not available.
+   */
+  virtual void* Allocate(std::size_t size) = 0;
+
+  /// Releases a buffer, @p size is the value passed to `Allocate()`.
+  virtual void Deallocate(void* buffer, std::size_t size) = 0;
+};
+
+/// Returns an allocator based on `operator new`, the default.
+std::shared_ptr<BufferAllocator> DefaultBufferAllocator();
+
+/**
+ * Returns an allocator that places large buffers on huge pages.
+ *
+ * On Linux the buffers are backed by explicit 2MiB huge pages
+ * (`MAP_HUGETLB`) when the system has them configured, falling back to
+ * anonymous mappings marked with `madvise(MADV_HUGEPAGE)` so the kernel can
+ * use transparent huge pages. On other platforms the buffers are aligned to
+ * the huge page size, which helps allocators and kernels that promote
+ * aligned regions.
+ *
+ * This allocator has significant per-buffer granularity (2MiB), use it with
+ * transfer buffers of comparable or larger size.
+ */
+std::shared_ptr<BufferAllocator> HugePageBufferAllocator();
+
+namespace internal {
+/**
+ * Adapts a `BufferAllocator` to the standard library allocator interface.
+ *
+ * The streams keep their buffers in standard containers, this adapter routes
+ * the large allocations (the actual transfer and spill buffers) to the
+ * injected `BufferAllocator`. Small allocations, e.g. short strings during
+ * container bookkeeping, stay on the default heap, huge-page allocators have
+ * far too much granularity for them. A default-constructed adapter (or one
+ * holding a null implementation) uses `operator new` for everything.
+ */
+template <typename T>
+class BufferStdAllocator {
+ public:
+  using value_type = T;
+
+  BufferStdAllocator() = default;
+  explicit BufferStdAllocator(std::shared_ptr<BufferAllocator> impl)
+      : impl_(std::move(impl)) {}
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  BufferStdAllocator(BufferStdAllocator<U> const& rhs) : impl_(rhs.impl()) {}
+
+  T* allocate(std::size_t n) {
+    auto const bytes = n * sizeof(T);
+    if (UseDefaultHeap(bytes)) {
+      return static_cast<T*>(::operator new(bytes));
+    }
+    return static_cast<T*>(impl_->Allocate(bytes));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    auto const bytes = n * sizeof(T);
+    if (UseDefaultHeap(bytes)) {
+      ::operator delete(p);
+      return;
+    }
+    impl_->Deallocate(p, bytes);
+  }
+
+  std::shared_ptr<BufferAllocator> const& impl() const { return impl_; }
+
+ private:
+  bool UseDefaultHeap(std::size_t bytes) const {
+    // Allocations below this size are container bookkeeping, not transfer
+    // buffers, routing them to (say) a huge page allocator wastes memory.
+    auto constexpr kSmallAllocationLimit = std::size_t(4096);
+    return !impl_ || bytes < kSmallAllocationLimit;
+  }
+
+  std::shared_ptr<BufferAllocator> impl_;
+};
+
+template <typename T, typename U>
+bool operator==(BufferStdAllocator<T> const& lhs,
+                BufferStdAllocator<U> const& rhs) {
+  return lhs.impl() == rhs.impl();
+}
+
+template <typename T, typename U>
+bool operator!=(BufferStdAllocator<T> const& lhs,
+                BufferStdAllocator<U> const& rhs) {
+  return !(lhs == rhs);
+}
+
+/// The buffer types used by the object streams.
+using BufferVector = std::vector<char, BufferStdAllocator<char>>;
+using BufferString =
+    std::basic_string<char, std::char_traits<char>, BufferStdAllocator<char>>;
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_ALLOCATOR_H
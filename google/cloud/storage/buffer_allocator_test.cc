@@ -0,0 +1,117 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/buffer_allocator.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using internal::BufferStdAllocator;
+using internal::BufferString;
+using internal::BufferVector;
+
+/// An allocator that counts its calls, to verify the plumbing.
+class CountingAllocator : public BufferAllocator {
+ public:
+  void* Allocate(std::size_t size) override {
+    ++allocations_;
+    allocated_bytes_ += size;
+    return ::operator new(size);
+  }
+  void Deallocate(void* buffer, std::size_t size) override {
+    ++deallocations_;
+    deallocated_bytes_ += size;
+    ::operator delete(buffer);
+  }
+
+  int allocations() const { return allocations_; }
+  int deallocations() const { return deallocations_; }
+  std::size_t allocated_bytes() const { return allocated_bytes_; }
+  std::size_t deallocated_bytes() const { return deallocated_bytes_; }
+
+ private:
+  int allocations_ = 0;
+  int deallocations_ = 0;
+  std::size_t allocated_bytes_ = 0;
+  std::size_t deallocated_bytes_ = 0;
+};
+
+/// @test Verify the default allocator returns usable memory.
+TEST(BufferAllocatorTest, Default) {
+  auto allocator = DefaultBufferAllocator();
+  auto constexpr kSize = std::size_t(1024);
+  void* p = allocator->Allocate(kSize);
+  ASSERT_NE(nullptr, p);
+  std::memset(p, 0x5A, kSize);
+  allocator->Deallocate(p, kSize);
+}
+
+/// @test Verify the huge page allocator returns usable, aligned memory.
+TEST(BufferAllocatorTest, HugePage) {
+  auto allocator = HugePageBufferAllocator();
+  auto constexpr kSize = std::size_t(3 * 1024 * 1024);
+  void* p = allocator->Allocate(kSize);
+  ASSERT_NE(nullptr, p);
+  // The buffer must be at least page-aligned on any platform.
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 4096);
+  // The whole buffer must be writable and readable.
+  std::memset(p, 0x5A, kSize);
+  EXPECT_EQ(0x5A, *(static_cast<unsigned char*>(p) + kSize - 1));
+  allocator->Deallocate(p, kSize);
+}
+
+/// @test Verify large vector buffers are routed to the injected allocator.
+TEST(BufferAllocatorTest, AdaptorRoutesLargeAllocations) {
+  auto counter = std::make_shared<CountingAllocator>();
+  {
+    BufferVector buffer((BufferStdAllocator<char>(counter)));
+    buffer.resize(128 * 1024);
+    EXPECT_EQ(1, counter->allocations());
+    EXPECT_GE(counter->allocated_bytes(), buffer.size());
+  }
+  EXPECT_EQ(counter->allocations(), counter->deallocations());
+  EXPECT_EQ(counter->allocated_bytes(), counter->deallocated_bytes());
+}
+
+/// @test Verify small allocations stay on the default heap.
+TEST(BufferAllocatorTest, AdaptorSkipsSmallAllocations) {
+  auto counter = std::make_shared<CountingAllocator>();
+  {
+    BufferString buffer((BufferStdAllocator<char>(counter)));
+    buffer.append("short string, stays on the regular heap");
+    EXPECT_EQ(0, counter->allocations());
+    buffer.assign(128 * 1024, 'a');
+    EXPECT_EQ(1, counter->allocations());
+  }
+  EXPECT_EQ(counter->allocations(), counter->deallocations());
+}
+
+/// @test Verify a default-constructed adaptor works without an allocator.
+TEST(BufferAllocatorTest, AdaptorWithoutImplementation) {
+  BufferVector buffer;
+  buffer.resize(128 * 1024);
+  EXPECT_EQ(128 * 1024, buffer.size());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -19,6 +19,9 @@
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/internal/single_shot_upload_session.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/internal/upload_checkpoint.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
 #include <openssl/md5.h>
 #include <fstream>
@@ -35,6 +38,14 @@ static_assert(std::is_copy_assignable<storage::Client>::value,
 
 std::shared_ptr<internal::RawClient> Client::CreateDefaultInternalClient(
     ClientOptions options) {
+  if (options.transport() != "curl") {
+    // The gRPC storage backend needs the storage protos and a gRPC
+    // dependency, neither of which are part of this library (yet). Fall back
+    // to the curl transport rather than failing, the application still works,
+    // just without the requested transport.
+    GCP_LOG(WARNING) << "transport <" << options.transport()
+                     << "> is not compiled into this library, using <curl>";
+  }
   return internal::CurlClient::Create(std::move(options));
 }
 
@@ -46,6 +57,11 @@ StatusOr<Client> Client::CreateDefaultClient() {
   return StatusOr<Client>(Client(*opts));
 }
 
+std::vector<internal::OperationMetricsSummary>
+Client::OperationMetricsSnapshot() {
+  return internal::OperationMetrics::Instance().Snapshot();
+}
+
 ObjectReadStream Client::ReadObjectImpl(
     internal::ReadObjectRangeRequest const& request) {
   auto source = raw_client_->ReadObject(request);
@@ -58,7 +74,8 @@ ObjectReadStream Client::ReadObjectImpl(
   }
   auto stream = ObjectReadStream(
       google::cloud::internal::make_unique<internal::ObjectReadStreambuf>(
-          request, *std::move(source)));
+          request, *std::move(source),
+          raw_client_->client_options().buffer_allocator()));
   (void)stream.peek();
 #if !GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   // Without exceptions the streambuf cannot report errors, so we have to
@@ -72,7 +89,69 @@ ObjectReadStream Client::ReadObjectImpl(
 
 ObjectWriteStream Client::WriteObjectImpl(
     internal::ResumableUploadRequest const& request) {
-  auto session = raw_client_->CreateResumableSession(request);
+  bool const compress = request.HasOption<GzipUploadCompression>() &&
+                        request.GetOption<GzipUploadCompression>().value();
+  bool const single_shot =
+      request.HasOption<SingleShotUploadThreshold>() &&
+      request.GetOption<SingleShotUploadThreshold>().value() != 0 &&
+      !request.HasOption<UseResumableUploadSession>();
+  auto hash_validator = internal::CreateHashValidator(request);
+  auto restore_status = [&request, &hash_validator] {
+    // When restoring from a checkpoint (as opposed to a plain session id)
+    // the running hash state must be restored as well, or the hashes would
+    // only cover the bytes uploaded after the resume.
+    if (!request.HasOption<UseResumableUploadSession>()) {
+      return Status();
+    }
+    auto const& value = request.GetOption<UseResumableUploadSession>().value();
+    if (!internal::IsUploadCheckpoint(value)) {
+      return Status();
+    }
+    auto chk = internal::ParseUploadCheckpoint(value);
+    if (!chk) {
+      return std::move(chk).status();
+    }
+    return hash_validator->Restore(chk->hash_state);
+  }();
+  if (!restore_status.ok()) {
+    auto error = google::cloud::internal::make_unique<
+        internal ::ResumableUploadSessionError>(std::move(restore_status));
+
+    ObjectWriteStream error_stream(google::cloud::internal::make_unique<
+                                   internal::ObjectWriteStreambuf>(
+        std::move(error), 0,
+        google::cloud::internal::make_unique<internal::NullHashValidator>()));
+    error_stream.setstate(std::ios::badbit | std::ios::eofbit);
+    error_stream.Close();
+    return error_stream;
+  }
+  auto session = [this, compress, single_shot, &request]()
+      -> StatusOr<std::unique_ptr<internal::ResumableUploadSession>> {
+    if (!compress && !single_shot) {
+      return raw_client_->CreateResumableSession(request);
+    }
+    auto annotated = request;
+    if (compress) {
+      // The object stores the compressed bytes, mark it as gzip-encoded so
+      // downloads are transcoded by the service (or by the HTTP client).
+      auto metadata = request.HasOption<WithObjectMetadata>()
+                          ? request.GetOption<WithObjectMetadata>().value()
+                          : ObjectMetadata{};
+      annotated.set_option(
+          WithObjectMetadata(metadata.set_content_encoding("gzip")));
+    }
+    if (single_shot) {
+      // Defer creating the resumable session, small uploads complete in a
+      // single `InsertObjectMedia` request when the stream is closed.
+      std::unique_ptr<internal::ResumableUploadSession> session =
+          google::cloud::internal::make_unique<
+              internal::SingleShotUploadSession>(
+              raw_client_, std::move(annotated),
+              request.GetOption<SingleShotUploadThreshold>().value());
+      return make_status_or(std::move(session));
+    }
+    return raw_client_->CreateResumableSession(annotated);
+  }();
   if (!session) {
     auto error = google::cloud::internal::make_unique<
         internal ::ResumableUploadSessionError>(std::move(session).status());
@@ -85,11 +164,20 @@ ObjectWriteStream Client::WriteObjectImpl(
     error_stream.Close();
     return error_stream;
   }
+  std::unique_ptr<internal::GzipCompressor> compressor;
+  if (compress) {
+    compressor = google::cloud::internal::make_unique<
+        internal::GzipCompressor>();
+  }
+  bool const background_flush =
+      request.HasOption<BackgroundUploadFlush>() &&
+      request.GetOption<BackgroundUploadFlush>().value();
   return ObjectWriteStream(
       google::cloud::internal::make_unique<internal::ObjectWriteStreambuf>(
           *std::move(session),
           raw_client_->client_options().upload_buffer_size(),
-          internal::CreateHashValidator(request)));
+          std::move(hash_validator), std::move(compressor), background_flush,
+          raw_client_->client_options().buffer_allocator()));
 }
 
 bool Client::UseSimpleUpload(std::string const& file_name) const {
@@ -136,6 +224,16 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
 )""";
   }
 
+  if (is_regular(status)) {
+    // Prefer a memory-mapped source for regular files, it avoids copying
+    // every chunk through an `std::istream` buffer.
+    auto region = internal::MappedFileRegion::Open(file_name);
+    if (region) {
+      return UploadMappedResumable(*region, request);
+    }
+    // Fall back to the portable stream-based upload below.
+  }
+
   std::ifstream source(file_name, std::ios::binary);
   if (!source.is_open()) {
     std::ostringstream os;
@@ -146,6 +244,57 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
   return UploadStreamResumable(source, request);
 }
 
+StatusOr<ObjectMetadata> Client::UploadMappedResumable(
+    internal::MappedFileRegion const& region,
+    internal::ResumableUploadRequest const& request) {
+  StatusOr<std::unique_ptr<internal::ResumableUploadSession>> session_status =
+      raw_client()->CreateResumableSession(request);
+  if (!session_status) {
+    return std::move(session_status).status();
+  }
+
+  auto session = std::move(*session_status);
+
+  // GCS requires chunks to be a multiple of 256KiB.
+  auto chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
+      raw_client()->client_options().upload_buffer_size());
+
+  StatusOr<internal::ResumableUploadResponse> upload_response(
+      internal::ResumableUploadResponse{});
+  do {
+    // The next chunk always starts at the last byte committed by the
+    // service, so partially accepted chunks are simply retransmitted from
+    // the mapped region, there is no stream to reposition.
+    auto offset = static_cast<std::size_t>(session->next_expected_byte());
+    if (offset > region.size()) {
+      std::ostringstream os;
+      os << __func__ << "(" << request
+         << "): service requested unexpected byte, offset=" << offset
+         << ", file size=" << region.size();
+      return Status(StatusCode::kInternal, std::move(os).str());
+    }
+    auto n = (std::min)(chunk_size, region.size() - offset);
+    bool final_chunk = (offset + n == region.size());
+    // The session borrows a view of the mapped region, the chunk is never
+    // copied. An empty file maps to a nullptr region, do not form
+    // `data() + offset`.
+    internal::ConstBufferSequence buffer;
+    if (n != 0) {
+      buffer.emplace_back(region.data() + offset, n);
+    }
+    if (final_chunk) {
+      upload_response = session->UploadFinalChunk(buffer, region.size());
+    } else {
+      upload_response = session->UploadChunk(buffer);
+    }
+    if (!upload_response) {
+      return std::move(upload_response).status();
+    }
+  } while (!upload_response->payload.has_value());
+
+  return *std::move(upload_response->payload);
+}
+
 StatusOr<ObjectMetadata> Client::UploadStreamResumable(
     std::istream& source, internal::ResumableUploadRequest const& request) {
   StatusOr<std::unique_ptr<internal::ResumableUploadSession>> session_status =
@@ -176,9 +325,12 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
 
     auto expected = session->next_expected_byte() + gcount - 1;
     if (final_chunk) {
-      upload_response = session->UploadFinalChunk(buffer, source_size);
+      upload_response = session->UploadFinalChunk(
+          internal::ConstBufferSequence{internal::ConstBuffer(buffer)},
+          source_size);
     } else {
-      upload_response = session->UploadChunk(buffer);
+      upload_response = session->UploadChunk(
+          internal::ConstBufferSequence{internal::ConstBuffer(buffer)});
     }
     if (!upload_response) {
       return std::move(upload_response).status();
@@ -240,6 +392,70 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   return Status();
 }
 
+StatusOr<DownloadObjectToBufferResult> Client::DownloadToBufferImpl(
+    internal::ReadObjectRangeRequest const& request, char* buffer,
+    std::size_t buffer_size) {
+  auto source = raw_client_->ReadObject(request);
+  if (!source) {
+    return std::move(source).status();
+  }
+
+  auto hash_validator = internal::CreateHashValidator(request);
+  DownloadObjectToBufferResult result;
+  result.generation = 0;
+  std::size_t offset = 0;
+  while ((*source)->IsOpen()) {
+    // Once the buffer is full read into a one-byte spill area, a non-empty
+    // read there means the object does not fit in the buffer.
+    char spill;
+    char* data = offset < buffer_size ? buffer + offset : &spill;
+    std::size_t capacity = offset < buffer_size ? buffer_size - offset : 1;
+    auto read = (*source)->Read(data, capacity);
+    if (!read) {
+      return std::move(read).status();
+    }
+    for (auto const& kv : read->response.headers) {
+      hash_validator->ProcessHeader(kv.first, kv.second);
+      result.headers.emplace(kv.first, kv.second);
+    }
+    if (read->response.status_code >=
+        internal::HttpStatusCode::kMinNotSuccess) {
+      return internal::AsStatus(read->response);
+    }
+    if (read->bytes_received == 0) {
+      // This is an actual EOF, there is no more data to download.
+      break;
+    }
+    if (data == &spill) {
+      std::ostringstream os;
+      os << __func__ << "(" << request << "): object does not fit in "
+         << buffer_size << " byte buffer";
+      return Status(StatusCode::kOutOfRange, std::move(os).str());
+    }
+    hash_validator->Update(data, read->bytes_received);
+    offset += read->bytes_received;
+  }
+  result.bytes_written = offset;
+
+  auto hash_result = std::move(*hash_validator).Finish();
+  if (hash_result.is_mismatch) {
+    std::string msg;
+    msg += __func__;
+    msg += "(): mismatched hashes in download";
+    msg += ", expected=";
+    msg += hash_result.computed;
+    msg += ", received=";
+    msg += hash_result.received;
+    return Status(StatusCode::kDataLoss, std::move(msg));
+  }
+
+  auto loc = result.headers.find("x-goog-generation");
+  if (loc != result.headers.end()) {
+    result.generation = std::stoll(loc->second);
+  }
+  return result;
+}
+
 std::string Client::SigningEmail(SigningAccount const& signing_account) {
   if (signing_account.has_value()) {
     return signing_account.value();
@@ -279,14 +495,13 @@ StatusOr<std::string> Client::SignUrlV2(
     return signed_blob.status();
   }
 
-  internal::CurlHandle curl;
   auto encoded = internal::Base64Encode(signed_blob->signed_blob);
-  std::string signature = curl.MakeEscapedString(encoded).get();
+  std::string signature = internal::UrlEscape(encoded);
 
   std::ostringstream os;
   os << "https://storage.googleapis.com/" << request.bucket_name();
   if (!request.object_name().empty()) {
-    os << '/' << curl.MakeEscapedString(request.object_name()).get();
+    os << '/' << internal::UrlEscape(request.object_name());
   }
   os << "?GoogleAccessId=" << SigningEmail(signing_account)
      << "&Expires=" << request.expiration_time_as_seconds().count()
@@ -303,7 +518,12 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
   request.AddMissingRequiredHeaders();
   SigningAccount const& signing_account = request.signing_account();
   auto signing_email = SigningEmail(signing_account);
+  return SignUrlV4Impl(request, signing_account, signing_email);
+}
 
+StatusOr<std::string> Client::SignUrlV4Impl(
+    internal::V4SignUrlRequest& request, SigningAccount const& signing_account,
+    std::string const& signing_email) {
   auto string_to_sign = request.StringToSign(signing_email);
   auto signed_blob = SignBlobImpl(signing_account, string_to_sign);
   if (!signed_blob) {
@@ -311,11 +531,10 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
   }
 
   std::string signature = internal::HexEncode(signed_blob->signed_blob);
-  internal::CurlHandle curl;
   std::ostringstream os;
   os << request.HostnameWithBucket();
   for (auto& part : request.ObjectNameParts()) {
-    os << '/' << curl.MakeEscapedString(part).get();
+    os << '/' << internal::UrlEscape(part);
   }
   os << "?" << request.CanonicalQueryString(signing_email)
      << "&X-Goog-Signature=" << signature;
@@ -323,6 +542,64 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
   return std::move(os).str();
 }
 
+StatusOr<std::vector<std::string>> Client::SignUrlV4Batch(
+    std::vector<internal::V4SignUrlRequest> requests) {
+  if (requests.empty()) {
+    return std::vector<std::string>{};
+  }
+  for (auto& request : requests) {
+    auto valid = request.Validate();
+    if (!valid.ok()) {
+      return StatusOr<std::vector<std::string>>(valid);
+    }
+    request.AddMissingRequiredHeaders();
+  }
+  // All the requests in a batch share the same options, resolve the signing
+  // account email only once.
+  SigningAccount const& signing_account = requests.front().signing_account();
+  auto signing_email = SigningEmail(signing_account);
+
+  // Batches smaller than this are signed inline, the signatures are fast
+  // enough that threads do not pay off.
+  std::size_t constexpr kMinSignedUrlsPerThread = 32;
+  std::vector<StatusOr<std::string>> results(requests.size());
+  auto thread_count = (std::min<std::size_t>)(
+      std::thread::hardware_concurrency(),
+      requests.size() / kMinSignedUrlsPerThread);
+  if (thread_count <= 1) {
+    for (std::size_t i = 0; i != requests.size(); ++i) {
+      results[i] = SignUrlV4Impl(requests[i], signing_account, signing_email);
+    }
+  } else {
+    // Fan the signing out over a small thread pool, the RSA signatures
+    // dominate the cost of large batches.
+    auto* self = this;
+    auto* req = &requests;
+    auto* res = &results;
+    auto* account = &signing_account;
+    auto* email = &signing_email;
+    internal::ThreadPool pool(thread_count);
+    for (std::size_t t = 0; t != thread_count; ++t) {
+      pool.Submit([self, req, res, account, email, t, thread_count] {
+        for (std::size_t i = t; i < req->size(); i += thread_count) {
+          (*res)[i] = self->SignUrlV4Impl((*req)[i], *account, *email);
+        }
+      });
+    }
+    // The pool destructor waits until all the tasks complete.
+  }
+
+  std::vector<std::string> urls;
+  urls.reserve(results.size());
+  for (auto& result : results) {
+    if (!result) {
+      return std::move(result).status();
+    }
+    urls.push_back(*std::move(result));
+  }
+  return urls;
+}
+
 StatusOr<PolicyDocumentResult> Client::SignPolicyDocument(
     internal::PolicyDocumentRequest const& request) {
   SigningAccount const& signing_account = request.signing_account();
@@ -20,7 +20,10 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/hmac_key_metadata.h"
+#include "google/cloud/storage/internal/bucket_metadata_cache_client.h"
 #include "google/cloud/storage/internal/logging_client.h"
+#include "google/cloud/storage/internal/mapped_file_region.h"
+#include "google/cloud/storage/internal/tracing_client.h"
 #include "google/cloud/storage/internal/parameter_pack_validation.h"
 #include "google/cloud/storage/internal/policy_document_request.h"
 #include "google/cloud/storage/internal/retry_client.h"
@@ -37,6 +40,9 @@
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <map>
+#include <thread>
 #include <type_traits>
 
 namespace google {
@@ -47,6 +53,22 @@ namespace internal {
 class NonResumableParallelUploadState;
 class ResumableParallelUploadState;
 }  // namespace internal
+
+/**
+ * The result of a successful `Client::DownloadObjectToBuffer()` call.
+ */
+struct DownloadObjectToBufferResult {
+  /// The number of bytes copied into the application's buffer.
+  std::size_t bytes_written;
+
+  /// The generation of the downloaded object, or 0 if the service did not
+  /// report one.
+  std::int64_t generation;
+
+  /// The headers returned by the service during the download.
+  std::multimap<std::string, std::string> headers;
+};
+
 /**
  * The Google Cloud Storage (GCS) Client.
  *
@@ -247,6 +269,18 @@ class Client {
     return raw_client_;
   }
 
+  /**
+   * Returns a snapshot of the accumulated per-operation metrics.
+   *
+   * The metrics are only collected by clients created with
+   * `ClientOptions::set_enable_raw_client_metrics(true)`; for other clients
+   * the snapshot is empty. The counters are cumulative and process-wide
+   * (shared by all clients), so they can be exported directly to monitoring
+   * systems that expect monotonic counters.
+   */
+  static std::vector<internal::OperationMetricsSummary>
+  OperationMetricsSnapshot();
+
   //@{
   /**
    * @name Bucket operations.
@@ -899,6 +933,52 @@ class Client {
     return raw_client_->InsertObjectMedia(request);
   }
 
+  /**
+   * Creates an object given its name, borrowing its contents from @p contents.
+   *
+   * Unlike the `std::string` overload, the contents are *not* copied into the
+   * request: the memory viewed by @p contents must remain valid (and
+   * unmodified) until this function returns. Combined with `DisableMD5Hash`
+   * and `DisableCrc32cChecksum` the payload is streamed to the service with
+   * zero application-visible copies, which matters when inserting large
+   * objects at high rates. When hashes are computed, or when the request
+   * requires a multipart upload (e.g. `WithObjectMetadata`), the library
+   * coalesces the buffers once.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents a sequence of borrowed buffers with the object contents.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `ContentEncoding`,
+   *     `ContentType`, `Crc32cChecksumValue`, `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `KmsKeyName`, `MD5HashValue`,
+   *     `PredefinedAcl`, `Projection`, `UserProject`, and
+   *     `WithObjectMetadata`.
+   */
+  template <typename... Options>
+  StatusOr<ObjectMetadata> InsertObject(std::string const& bucket_name,
+                                        std::string const& object_name,
+                                        internal::ConstBufferSequence contents,
+                                        Options&&... options) {
+    internal::InsertObjectMediaRequest request(bucket_name, object_name,
+                                               std::move(contents));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->InsertObjectMedia(request);
+  }
+
+  /// @copydoc InsertObject(std::string const&,std::string const&,internal::ConstBufferSequence,Options&&...)
+  template <typename... Options>
+  StatusOr<ObjectMetadata> InsertObject(std::string const& bucket_name,
+                                        std::string const& object_name,
+                                        internal::ConstBuffer contents,
+                                        Options&&... options) {
+    return InsertObject(bucket_name, object_name,
+                        internal::ConstBufferSequence{contents},
+                        std::forward<Options>(options)...);
+  }
+
   /**
    * Copies an existing object.
    *
@@ -1021,8 +1101,8 @@ class Client {
    *     Valid types for this operation include `DisableCrc32cChecksum`,
    *     `DisableMD5Hash`, `IfGenerationMatch`, `EncryptionKey`, `Generation`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`
-   *     and `UserProject`.
+   *     `IfMetagenerationNotMatch`, `ReadAheadBufferSize`, `ReadFromOffset`,
+   *     `ReadRange`, `ReadLast` and `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1095,12 +1175,14 @@ class Client {
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
-   *   Valid types for this operation include `ContentEncoding`, `ContentType`,
-   *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
-   *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
+   *   Valid types for this operation include `BackgroundUploadFlush`,
+   *   `ContentEncoding`, `ContentType`, `Crc32cChecksumValue`,
+   *   `DisableCrc32cChecksum`, `DisableMD5Hash`, `EncryptionKey`,
+   *   `GzipUploadCompression`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
    *   `MD5HashValue`, `PredefinedAcl`, `Projection`,
-   *   `UseResumableUploadSession`, `UserProject`, and `WithObjectMetadata`.
+   *   `SingleShotUploadThreshold`, `UseResumableUploadSession`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
@@ -1201,6 +1283,42 @@ class Client {
     return DownloadFileImpl(request, file_name);
   }
 
+  /**
+   * Downloads a Cloud Storage object into an application-owned buffer.
+   *
+   * `ReadObject()` stages the download in the stream's internal buffers,
+   * copying each byte at least once before the application sees it. When
+   * the application already owns a destination of the right size — filling
+   * an in-memory cache, for example — this function hands @p buffer
+   * directly to the transport, so the payload is written in place without
+   * intermediate copies.
+   *
+   * If the object does not fit in @p buffer_size bytes the download fails
+   * with `kOutOfRange`. Use the `ReadRange` option to download just a
+   * portion of a larger object.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be downloaded.
+   * @param buffer the destination buffer.
+   * @param buffer_size the size of the destination buffer.
+   * @param options a list of optional query parameters and/or request
+   *   headers. Valid types for this operation include `EncryptionKey`,
+   *   `Generation`, `IfGenerationMatch`, `IfGenerationNotMatch`,
+   *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`,
+   *   `ReadFromOffset`, `ReadRange`, `ReadLast`, and `UserProject`.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  StatusOr<DownloadObjectToBufferResult> DownloadObjectToBuffer(
+      std::string const& bucket_name, std::string const& object_name,
+      char* buffer, std::size_t buffer_size, Options&&... options) {
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return DownloadToBufferImpl(request, buffer, buffer_size);
+  }
+
   /**
    * Deletes an object.
    *
@@ -2763,6 +2881,50 @@ class Client {
     request.set_multiple_options(std::forward<Options>(options)...);
     return SignUrlV4(std::move(request));
   }
+
+  /**
+   * Create V4 signed URLs for many objects in a single call.
+   *
+   * All the URLs share the @p verb, the @p bucket_name, and the @p options,
+   * they differ only in the object name. This is cheaper than calling
+   * `CreateV4SignedUrl()` in a loop: the signing account email is resolved
+   * only once, all the URLs share one timestamp (and therefore one
+   * credential scope), and large batches are signed using multiple threads.
+   *
+   * @note By default URLs created with this function expire after 7 days.
+   *
+   * @param verb the operation allowed through these signed URLs, `GET`,
+   *     `POST`, `PUT`, `HEAD`, etc. are valid values.
+   * @param bucket_name the name of the bucket.
+   * @param object_names the names of the objects, one URL is created for
+   *     each name. Note that the objects may not exist for signed URLs that
+   *     upload new objects.
+   * @param options a list of optional parameters for the signed URLs, these
+   *     are applied to every URL in the batch. See `CreateV4SignedUrl()` for
+   *     the supported options.
+   *
+   * @return the signed URLs, in the same order as @p object_names. If any
+   *     URL cannot be created the whole batch fails.
+   *
+   * @see `CreateV4SignedUrl()` for details about V4 signed URLs.
+   */
+  template <typename... Options>
+  StatusOr<std::vector<std::string>> CreateV4SignedUrls(
+      std::string verb, std::string bucket_name,
+      std::vector<std::string> object_names, Options&&... options) {
+    // Share one timestamp (and thus one scope) across the whole batch, an
+    // explicit `SignedUrlTimestamp` option still overrides it.
+    auto timestamp = std::chrono::system_clock::now();
+    std::vector<internal::V4SignUrlRequest> requests;
+    requests.reserve(object_names.size());
+    for (auto& object_name : object_names) {
+      internal::V4SignUrlRequest request(verb, bucket_name,
+                                         std::move(object_name));
+      request.set_multiple_options(SignedUrlTimestamp(timestamp), options...);
+      requests.push_back(std::move(request));
+    }
+    return SignUrlV4Batch(std::move(requests));
+  }
   //@}
 
   /**
@@ -2967,11 +3129,29 @@ class Client {
   template <typename... Policies>
   std::shared_ptr<internal::RawClient> Decorate(
       std::shared_ptr<internal::RawClient> client, Policies&&... policies) {
+    // The tracing client is installed closest to the transport, so its
+    // timestamps exclude the overhead of any other decorator.
+    auto record_events =
+        client->client_options().enable_raw_client_trace_events();
+    auto record_metrics = client->client_options().enable_raw_client_metrics();
+    if (record_events || record_metrics) {
+      client = std::make_shared<internal::TracingClient>(
+          std::move(client), 1, record_events, record_metrics);
+    }
     if (client->client_options().enable_raw_client_tracing()) {
       client = std::make_shared<internal::LoggingClient>(std::move(client));
     }
-    auto retry = std::make_shared<internal::RetryClient>(
-        std::move(client), std::forward<Policies>(policies)...);
+    std::shared_ptr<internal::RawClient> retry =
+        std::make_shared<internal::RetryClient>(
+            std::move(client), std::forward<Policies>(policies)...);
+    // The cache is the outermost decorator, so a cache hit skips the
+    // retry loop and the transport entirely, and revalidations are
+    // retried like any other request.
+    auto const cache_ttl = retry->client_options().bucket_metadata_cache_ttl();
+    if (cache_ttl.count() != 0) {
+      retry = std::make_shared<internal::BucketMetadataCacheClient>(
+          std::move(retry), cache_ttl);
+    }
     return retry;
   }
 
@@ -3026,9 +3206,17 @@ class Client {
   StatusOr<ObjectMetadata> UploadStreamResumable(
       std::istream& source, internal::ResumableUploadRequest const& request);
 
+  StatusOr<ObjectMetadata> UploadMappedResumable(
+      internal::MappedFileRegion const& region,
+      internal::ResumableUploadRequest const& request);
+
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
+  StatusOr<DownloadObjectToBufferResult> DownloadToBufferImpl(
+      internal::ReadObjectRangeRequest const& request, char* buffer,
+      std::size_t buffer_size);
+
   /// Determine the email used to sign a blob.
   std::string SigningEmail(SigningAccount const& signing_account);
 
@@ -3045,6 +3233,11 @@ class Client {
 
   StatusOr<std::string> SignUrlV2(internal::V2SignUrlRequest const& request);
   StatusOr<std::string> SignUrlV4(internal::V4SignUrlRequest request);
+  StatusOr<std::string> SignUrlV4Impl(internal::V4SignUrlRequest& request,
+                                      SigningAccount const& signing_account,
+                                      std::string const& signing_email);
+  StatusOr<std::vector<std::string>> SignUrlV4Batch(
+      std::vector<internal::V4SignUrlRequest> requests);
 
   StatusOr<PolicyDocumentResult> SignPolicyDocument(
       internal::PolicyDocumentRequest const& request);
@@ -3230,6 +3423,9 @@ class ScopedDeleter {
  *
  * The implementation may need to perform multiple Client::ComposeObject calls
  * to create intermediate, temporary objects which are then further composed.
+ * The intermediate compositions within each layer are independent and are
+ * performed in parallel, so the number of sequential composition rounds is
+ * logarithmic in the number of source objects.
  * Due to the lack of atomicity of this series of operations, stray temporary
  * objects might be left over if there are transient failuers. In order to allow
  * the user to easily control for such situations, the user is expected to
@@ -3329,18 +3525,19 @@ StatusOr<ObjectMetadata> ComposeMany(
   };
 
   auto composer = [&](std::vector<ComposeSourceObject> compose_range,
+                      std::string object_name,
                       bool is_final) -> StatusOr<ObjectMetadata> {
     if (is_final) {
       return google::cloud::internal::apply(
           internal::ComposeApplyHelper{client, bucket_name,
                                        std::move(compose_range),
-                                       std::move(destination_object_name)},
+                                       std::move(object_name)},
           std::tuple_cat(std::make_tuple(IfGenerationMatch(0)), all_options));
     }
     return google::cloud::internal::apply(
         internal::ComposeApplyHelper{client, bucket_name,
                                      std::move(compose_range),
-                                     tmpobject_name_gen()},
+                                     std::move(object_name)},
         StaticTupleFilter<
             NotAmong<IfGenerationMatch, IfMetagenerationMatch>::TPred>(
             all_options));
@@ -3348,7 +3545,13 @@ StatusOr<ObjectMetadata> ComposeMany(
 
   auto reduce = [&](std::vector<ComposeSourceObject> source_objects)
       -> StatusOr<std::vector<ObjectMetadata>> {
-    std::vector<ObjectMetadata> objects;
+    bool const is_final_composition = source_objects.size() <= max_num_objects;
+    // Split the sources into ranges of at most `max_num_objects` components
+    // and pick the destination names up front. The compositions within a
+    // layer are independent, so they run on parallel threads, keeping the
+    // total compose time logarithmic in the number of sources.
+    std::vector<std::vector<ComposeSourceObject>> ranges;
+    std::vector<std::string> names;
     for (auto range_begin = source_objects.begin();
          range_begin != source_objects.end();) {
       std::size_t range_size = std::min<std::size_t>(
@@ -3356,18 +3559,44 @@ StatusOr<ObjectMetadata> ComposeMany(
       auto range_end = std::next(range_begin, range_size);
       std::vector<ComposeSourceObject> compose_range(range_size);
       std::move(range_begin, range_end, compose_range.begin());
+      ranges.push_back(std::move(compose_range));
+      names.push_back(is_final_composition ? destination_object_name
+                                           : tmpobject_name_gen());
+      range_begin = range_end;
+    }
 
-      bool const is_final_composition =
-          source_objects.size() <= max_num_objects;
-      auto object = composer(std::move(compose_range), is_final_composition);
+    std::vector<StatusOr<ObjectMetadata>> results(ranges.size());
+    std::vector<std::thread> threads;
+    threads.reserve(ranges.size());
+    for (std::size_t i = 0; i != ranges.size(); ++i) {
+      threads.emplace_back([&, i] {
+        results[i] = composer(std::move(ranges[i]), std::move(names[i]),
+                              is_final_composition);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    std::vector<ObjectMetadata> objects;
+    objects.reserve(results.size());
+    Status failure;
+    for (auto& object : results) {
       if (!object) {
-        return std::move(object).status();
+        // Report the first failure, but keep registering any temporary
+        // objects that were created so they are still cleaned up.
+        if (failure.ok()) {
+          failure = object.status();
+        }
+        continue;
       }
-      objects.push_back(*std::move(object));
       if (!is_final_composition) {
-        deleter.Add(objects.back());
+        deleter.Add(*object);
       }
-      range_begin = range_end;
+      objects.push_back(*std::move(object));
+    }
+    if (!failure.ok()) {
+      return failure;
     }
     return objects;
   };
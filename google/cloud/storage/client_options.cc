@@ -127,6 +127,14 @@ void ClientOptions::SetupFromEnvironment() {
       GCP_LOG(INFO) << "Enabling logging for RawClient functions";
       set_enable_raw_client_tracing(true);
     }
+    if (enabled.end() != enabled.find("raw-client-trace")) {
+      GCP_LOG(INFO) << "Enabling binary trace events for RawClient functions";
+      set_enable_raw_client_trace_events(true);
+    }
+    if (enabled.end() != enabled.find("raw-client-metrics")) {
+      GCP_LOG(INFO) << "Enabling latency metrics for RawClient functions";
+      set_enable_raw_client_metrics(true);
+    }
   }
 
   auto project_id = google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT");
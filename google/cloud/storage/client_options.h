@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H
 
+#include "google/cloud/storage/buffer_allocator.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
+#include <functional>
 #include <memory>
 
 namespace google {
@@ -47,6 +49,19 @@ class ChannelOptions {
   std::string ssl_root_path_;
 };
 
+/**
+ * The type used to hand background work to an application-owned executor.
+ *
+ * The executor is any callable that eventually runs the task it is given,
+ * typically by submitting it to a thread pool. The type is deliberately
+ * just a `std::function` so the same callable can be installed in the
+ * options of every Google Cloud C++ library in the process (for example
+ * `bigtable::ClientOptions` uses the same signature), letting one
+ * right-sized pool serve timers, async RPCs, and background transfers
+ * instead of each library spawning its own threads.
+ */
+using BackgroundExecutor = std::function<void(std::function<void()>)>;
+
 /**
  * Describes the configuration for a `storage::Client` object.
  *
@@ -62,6 +77,8 @@ class ChannelOptions {
  * - `CLOUD_STORAGE_ENABLE_TRACING`: if set, this is the list of components that
  *   will have logging enabled, the component this is:
  *   - `http`: trace all http request / responses.
+ *   - `raw-client-trace`: record binary trace events for each operation,
+ *     cheap enough to enable in production.
  */
 class ClientOptions {
  public:
@@ -121,6 +138,40 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Enables the binary trace event recorder.
+   *
+   * Unlike `enable_raw_client_tracing()`, which formats every request and
+   * response into the log, this mode records fixed-size binary events
+   * (operation, timestamps, status, byte count) into a lock-free per-thread
+   * ring buffer. The overhead is low enough to leave enabled in production,
+   * use `internal::TraceRingBuffer::Instance().Dump()` to retrieve the
+   * events.
+   */
+  bool enable_raw_client_trace_events() const {
+    return enable_raw_client_trace_events_;
+  }
+  ClientOptions& set_enable_raw_client_trace_events(bool enable) {
+    enable_raw_client_trace_events_ = enable;
+    return *this;
+  }
+
+  /**
+   * Enables per-operation latency and byte-count metrics.
+   *
+   * When enabled the client maintains latency histograms (with p50/p99/p999
+   * accuracy of a few percent), error counts, and byte counters for each
+   * `RawClient` operation, aggregated per thread without locks. The
+   * overhead is low enough to leave enabled in production. Use
+   * `Client::OperationMetricsSnapshot()` to retrieve the accumulated
+   * values, e.g. to export them to a monitoring system.
+   */
+  bool enable_raw_client_metrics() const { return enable_raw_client_metrics_; }
+  ClientOptions& set_enable_raw_client_metrics(bool enable) {
+    enable_raw_client_metrics_ = enable;
+    return *this;
+  }
+
   std::string const& project_id() const { return project_id_; }
   ClientOptions& set_project_id(std::string v) {
     project_id_ = std::move(v);
@@ -133,6 +184,50 @@ class ClientOptions {
     return *this;
   }
 
+  //@{
+  /**
+   * Run the client's background work on an application-owned executor.
+   *
+   * The client runs its asynchronous operations (e.g. the `Async*()`
+   * members of the `RawClient` implementations and hedged requests) on a
+   * process-wide internal thread pool. Applications using several Google
+   * Cloud C++ libraries can install the same executor in each library's
+   * options instead, so one pool serves all of them; see
+   * `BackgroundExecutor` for the expected signature. When unset the
+   * internal pool is used.
+   *
+   * The executor must outlive every client configured with it.
+   */
+  BackgroundExecutor const& background_executor() const {
+    return background_executor_;
+  }
+  ClientOptions& set_background_executor(BackgroundExecutor executor) {
+    background_executor_ = std::move(executor);
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Control whether the client multiplexes requests over HTTP/2 connections.
+   *
+   * When enabled, new transfers wait for an existing HTTP/2 connection to the
+   * same endpoint instead of opening a new connection. Applications issuing
+   * many concurrent requests can reduce their connection count (and the
+   * associated TLS handshakes) by an order of magnitude. The option has no
+   * effect if the server does not negotiate HTTP/2, or if the library was
+   * compiled against a version of libcurl without multiplexing support.
+   *
+   * The default is `false` because sharing a connection serializes transfers
+   * through a single socket, which can reduce throughput for large transfers.
+   */
+  bool enable_http2_multiplexing() const { return enable_http2_multiplexing_; }
+  ClientOptions& set_enable_http2_multiplexing(bool v) {
+    enable_http2_multiplexing_ = v;
+    return *this;
+  }
+  //@}
+
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
@@ -195,6 +290,217 @@ class ClientOptions {
   ChannelOptions& channel_options() { return channel_options_; }
   ChannelOptions const& channel_options() const { return channel_options_; }
 
+  //@{
+  /**
+   * Select the transport used to talk to the service.
+   *
+   * The only transport compiled into this version of the library is `"curl"`
+   * (JSON and XML over HTTPS). The setting exists so applications can opt-in
+   * to alternative transports — such as the gRPC storage API, which avoids
+   * the JSON encoding CPU cost for high-throughput workloads — as they become
+   * available, without an API change. Requesting a transport that is not
+   * compiled in falls back to `"curl"` with a logged warning.
+   */
+  std::string const& transport() const { return transport_; }
+  ClientOptions& set_transport(std::string v) {
+    transport_ = std::move(v);
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Cache bucket metadata in the client, with the given time-to-live.
+   *
+   * Applications that consult the bucket configuration (storage class,
+   * retention settings) before each upload re-fetch metadata that rarely
+   * changes. With a non-zero TTL the `GetBucketMetadata()` results are
+   * cached per bucket: entries within the TTL are served from memory,
+   * and expired entries are revalidated with an
+   * `IfMetagenerationNotMatch` precondition, so an unchanged bucket
+   * costs a header-only `304` exchange instead of a full metadata
+   * download. Requests with options that change the response bypass the
+   * cache, and bucket mutations issued through the same client update
+   * it; changes made through other channels become visible when the TTL
+   * expires. If `0` (the default) no caching is performed.
+   */
+  std::chrono::seconds bucket_metadata_cache_ttl() const {
+    return bucket_metadata_cache_ttl_;
+  }
+  ClientOptions& set_bucket_metadata_cache_ttl(std::chrono::seconds v) {
+    bucket_metadata_cache_ttl_ = v;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Prefer the XML API for object uploads and downloads.
+   *
+   * Downloads already use the XML API whenever the request can be
+   * expressed in it. Uploads only use it when the application explicitly
+   * requests an empty field projection (`Fields("")`), because the XML
+   * response carries no object metadata. With this option enabled uploads
+   * also default to the XML API — skipping the JSON envelope, its larger
+   * responses, and the parsing cost — and the `ObjectMetadata` returned
+   * by `InsertObject()` contains only the bucket and object name.
+   * Requests with options the XML API cannot express
+   * (`IfGenerationNotMatch`, `IfMetagenerationNotMatch`, `QuotaUser`,
+   * `UserIp`, `Projection`, or a non-empty `Fields`) still use the JSON
+   * API; generation and metageneration match preconditions, predefined
+   * ACLs, encryption keys, and checksums all translate to XML headers.
+   */
+  bool prefer_xml_data_operations() const {
+    return prefer_xml_data_operations_;
+  }
+  ClientOptions& set_prefer_xml_data_operations(bool v) {
+    prefer_xml_data_operations_ = v;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Default the metadata-returning object operations to a field projection.
+   *
+   * By default the service returns the full object resource, including the
+   * ACL list and all metadata fields, and the library pays to parse all of
+   * it. Applications that only need a few fields can set this option to a
+   * partial response expression, for example
+   * `"bucket,name,generation,size"`, to cut the response size and the JSON
+   * parsing cost of `InsertObject()` and `GetObjectMetadata()`. A
+   * `Fields` option set on an individual request takes precedence. The
+   * empty string (the default) disables the projection.
+   *
+   * @see https://cloud.google.com/storage/docs/json_api#partial-response
+   *   for the syntax of partial response expressions.
+   */
+  std::string const& default_fields() const { return default_fields_; }
+  ClientOptions& set_default_fields(std::string v) {
+    default_fields_ = std::move(v);
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Control the size of the libcurl transfer (receive) buffer.
+   *
+   * Larger buffers reduce the number of callbacks (and the associated
+   * overhead) needed to download an object, which matters for applications
+   * downloading at 10Gbps+ rates. If `0` (the default) the library picks a
+   * reasonable value (128 KiB, already larger than the libcurl default of
+   * 16 KiB). libcurl silently caps the value to its compiled-in maximum.
+   */
+  std::size_t transfer_buffer_size() const { return transfer_buffer_size_; }
+  ClientOptions& set_transfer_buffer_size(std::size_t size) {
+    transfer_buffer_size_ = size;
+    return *this;
+  }
+
+  /**
+   * Enable growing the transfer buffer for long-running downloads.
+   *
+   * When enabled, the library starts with `transfer_buffer_size()` and
+   * doubles the libcurl receive buffer (up to 512 KiB) as a download streams
+   * more data. Short downloads keep their memory footprint small, while
+   * multi-gigabyte streams converge to the largest buffer.
+   */
+  bool enable_adaptive_buffer_size() const {
+    return enable_adaptive_buffer_size_;
+  }
+  ClientOptions& set_enable_adaptive_buffer_size(bool v) {
+    enable_adaptive_buffer_size_ = v;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Control the per-stream watermarks on buffered download data.
+   *
+   * Each download stream stages data received from libcurl but not yet
+   * consumed by the application in a spill buffer. The transfer is paused
+   * once the staged data reaches the high watermark, and resumed once the
+   * application drains it below the low watermark. Larger values keep the
+   * connection flowing between `Read()` calls, smaller values bound the
+   * memory held by a slow consumer. If `0` (the default) the high watermark
+   * matches the transfer buffer size and the low watermark is half the high
+   * watermark.
+   */
+  std::size_t download_buffer_low_watermark() const {
+    return download_buffer_low_watermark_;
+  }
+  std::size_t download_buffer_high_watermark() const {
+    return download_buffer_high_watermark_;
+  }
+  ClientOptions& set_download_buffer_watermarks(std::size_t low,
+                                               std::size_t high) {
+    download_buffer_low_watermark_ = low;
+    download_buffer_high_watermark_ = high;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Control the total download buffer memory used by this client.
+   *
+   * Limits the aggregate memory used by transfer and spill buffers across
+   * all concurrently active download streams created with this client. Once
+   * the limit is reached new downloads fall back to minimally-sized buffers
+   * instead of failing, and adaptive buffer growth stops. If `0` (the
+   * default) no client-wide limit is enforced.
+   */
+  std::size_t maximum_download_buffer_memory() const {
+    return maximum_download_buffer_memory_;
+  }
+  ClientOptions& set_maximum_download_buffer_memory(std::size_t v) {
+    maximum_download_buffer_memory_ = v;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Control the IPv6 to IPv4 fallback delay during connection setup.
+   *
+   * libcurl implements the "happy eyeballs" algorithm: it starts an IPv6
+   * connection attempt and falls back to IPv4 if the attempt does not
+   * complete within this timeout. At sites where IPv6 traffic is silently
+   * dropped the default (200ms in libcurl) can be lowered to reconnect over
+   * IPv4 sooner. If `0` (the default) the libcurl default applies. The
+   * option requires libcurl >= 7.59.0, it is ignored with older versions.
+   */
+  std::chrono::milliseconds happy_eyeballs_timeout() const {
+    return happy_eyeballs_timeout_;
+  }
+  ClientOptions& set_happy_eyeballs_timeout(std::chrono::milliseconds v) {
+    happy_eyeballs_timeout_ = v;
+    return *this;
+  }
+  //@}
+
+  //@{
+  /**
+   * Enable resolving the service endpoints at client construction.
+   *
+   * Unless libcurl is built against c-ares, name resolution blocks the
+   * thread issuing the request. When enabled, the client resolves the
+   * endpoint hostnames once, when it is constructed, and seeds the results
+   * into libcurl's DNS cache, so no request blocks on DNS. Long-lived
+   * clients connecting to the public endpoints are the intended use case,
+   * the cached addresses are not refreshed.
+   */
+  bool enable_endpoint_pre_resolution() const {
+    return enable_endpoint_pre_resolution_;
+  }
+  ClientOptions& set_enable_endpoint_pre_resolution(bool v) {
+    enable_endpoint_pre_resolution_ = v;
+    return *this;
+  }
+  //@}
+
   //@{
   /**
    * Control the maximum amount of time allowed for "stalls" during a download.
@@ -214,6 +520,26 @@ class ClientOptions {
   }
   //@}
 
+  //@{
+  /**
+   * Inject a custom allocator for the stream transfer and spill buffers.
+   *
+   * The object read and write streams buffer several MiB of data per stream.
+   * By default the buffers come from the regular heap, applications that
+   * want them on huge pages can install `HugePageBufferAllocator()`, and
+   * applications with stronger requirements (e.g. memory local to the NUMA
+   * node driving the NIC) can implement `BufferAllocator` themselves. If
+   * `nullptr` (the default) the regular heap is used.
+   */
+  std::shared_ptr<BufferAllocator> buffer_allocator() const {
+    return buffer_allocator_;
+  }
+  ClientOptions& set_buffer_allocator(std::shared_ptr<BufferAllocator> v) {
+    buffer_allocator_ = std::move(v);
+    return *this;
+  }
+  //@}
+
  private:
   void SetupFromEnvironment();
 
@@ -224,8 +550,11 @@ class ClientOptions {
   std::string version_;
   bool enable_http_tracing_;
   bool enable_raw_client_tracing_;
+  bool enable_raw_client_trace_events_ = false;
+  bool enable_raw_client_metrics_ = false;
   std::string project_id_;
   std::size_t connection_pool_size_;
+  BackgroundExecutor background_executor_;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
   std::string user_agent_prefix_;
@@ -234,8 +563,21 @@ class ClientOptions {
   bool enable_sigpipe_handler_ = true;
   std::size_t maximum_socket_recv_size_ = 0;
   std::size_t maximum_socket_send_size_ = 0;
+  bool enable_http2_multiplexing_ = false;
+  std::size_t transfer_buffer_size_ = 0;
+  bool enable_adaptive_buffer_size_ = false;
+  std::size_t download_buffer_low_watermark_ = 0;
+  std::size_t download_buffer_high_watermark_ = 0;
+  std::size_t maximum_download_buffer_memory_ = 0;
+  std::chrono::milliseconds happy_eyeballs_timeout_{0};
+  bool enable_endpoint_pre_resolution_ = false;
+  std::string transport_ = "curl";
+  std::chrono::seconds bucket_metadata_cache_ttl_{0};
+  bool prefer_xml_data_operations_ = false;
+  std::string default_fields_;
   std::chrono::seconds download_stall_timeout_;
   ChannelOptions channel_options_;
+  std::shared_ptr<BufferAllocator> buffer_allocator_;
 };
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
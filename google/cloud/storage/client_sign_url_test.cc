@@ -214,6 +214,54 @@ TEST_F(CreateSignedUrlTest, V4SignGet) {
   EXPECT_EQ(expected, *actual);
 }
 
+/// @test Verify that CreateV4SignedUrls() matches CreateV4SignedUrl().
+TEST_F(CreateSignedUrlTest, V4SignBatch) {
+  auto creds = oauth2::CreateServiceAccountCredentialsFromJsonContents(
+      kJsonKeyfileContentsForV4);
+  ASSERT_STATUS_OK(creds);
+  Client client(*creds);
+
+  std::string const bucket_name = "test-bucket";
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const valid_for = std::chrono::seconds(10);
+  // Large enough to exercise the multi-threaded code path.
+  std::vector<std::string> object_names(128);
+  for (std::size_t i = 0; i != object_names.size(); ++i) {
+    object_names[i] = "test-object-" + std::to_string(i);
+  }
+
+  auto actual = client.CreateV4SignedUrls(
+      "GET", bucket_name, object_names,
+      SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+      SignedUrlDuration(valid_for),
+      AddExtensionHeader("host", "storage.googleapis.com"));
+  ASSERT_STATUS_OK(actual);
+  ASSERT_EQ(object_names.size(), actual->size());
+
+  for (std::size_t i = 0; i != object_names.size(); ++i) {
+    auto expected = client.CreateV4SignedUrl(
+        "GET", bucket_name, object_names[i],
+        SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+        SignedUrlDuration(valid_for),
+        AddExtensionHeader("host", "storage.googleapis.com"));
+    ASSERT_STATUS_OK(expected);
+    EXPECT_EQ(*expected, (*actual)[i]);
+  }
+}
+
+/// @test Verify that CreateV4SignedUrls() works with an empty batch.
+TEST_F(CreateSignedUrlTest, V4SignBatchEmpty) {
+  auto creds = oauth2::CreateServiceAccountCredentialsFromJsonContents(
+      kJsonKeyfileContentsForV4);
+  ASSERT_STATUS_OK(creds);
+  Client client(*creds);
+
+  auto actual = client.CreateV4SignedUrls("GET", "test-bucket",
+                                          std::vector<std::string>{});
+  ASSERT_STATUS_OK(actual);
+  EXPECT_TRUE(actual->empty());
+}
+
 TEST_F(CreateSignedUrlTest, V4SignPut) {
   // This test uses a disabled key to create a V4 Signed URL for a PUT
   // operation. The bucket name was generated at random too.
@@ -71,6 +71,27 @@ struct ReadLast : public internal::ComplexOption<ReadLast, std::int64_t> {
   static char const* name() { return "read-last"; }
 };
 
+/**
+ * Prefetch data in the background during a ReadObject operation.
+ *
+ * The value is the size (in bytes) of the read-ahead buffer. While the
+ * application processes the current buffer, a background thread downloads
+ * the next one, overlapping network transfer and processing time. This
+ * helps applications that scan large objects sequentially; applications
+ * that seek frequently, or that consume the data faster than the network
+ * can deliver it, gain nothing from the extra thread.
+ *
+ * Set the value to 0 (the default) to disable read-ahead.
+ */
+struct ReadAheadBufferSize
+    : public internal::ComplexOption<ReadAheadBufferSize, std::size_t> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  ReadAheadBufferSize() = default;
+  static char const* name() { return "read-ahead-buffer-size"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -14,8 +14,8 @@
 
 #include "google/cloud/storage/hashing_options.h"
 #include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
 #include "google/cloud/storage/internal/openssl_util.h"
-#include <crc32c/crc32c.h>
 #include <openssl/md5.h>
 #include <cstring>
 
@@ -34,7 +34,7 @@ std::string ComputeMD5Hash(std::string const& payload) {
 }
 
 std::string ComputeCrc32cChecksum(std::string const& payload) {
-  auto checksum = crc32c::Extend(
+  auto checksum = internal::Crc32cExtend(
       0, reinterpret_cast<std::uint8_t const*>(payload.data()), payload.size());
   std::string const hash = google::cloud::internal::EncodeBigEndian(checksum);
   return internal::Base64Encode(hash);
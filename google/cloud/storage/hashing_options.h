@@ -106,6 +106,24 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+/**
+ * Compute hashes and checksums on a separate thread.
+ *
+ * By default the client library computes MD5 hashes and CRC32C checksums
+ * inline with the upload or download, serializing the hash computation with
+ * the network transfer. With this option the data is queued to a dedicated
+ * hashing thread instead, overlapping the computation with the transfer.
+ * This can improve throughput on fast connections, at the cost of one
+ * additional thread and a bounded amount of buffering per transfer.
+ */
+struct AsyncHashing : public internal::ComplexOption<AsyncHashing, bool> {
+  using ComplexOption<AsyncHashing, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  AsyncHashing() = default;
+  static char const* name() { return "async-hashing"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
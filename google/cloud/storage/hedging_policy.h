@@ -0,0 +1,65 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_POLICY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_POLICY_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Issues a backup ("hedged") attempt for slow, idempotent read operations.
+ *
+ * Tail latency for reads is often dominated by a few slow server replicas.
+ * When this policy is enabled the client starts a second attempt if the
+ * first one has not completed after `delay()`, and returns whichever attempt
+ * finishes first. The losing attempt is abandoned and its resources released
+ * when it completes.
+ *
+ * Set the delay to a high percentile (e.g. p99) of the operation's observed
+ * latency: only the slowest ~1% of requests then pay for a backup attempt,
+ * while precisely those requests get a second chance to complete quickly.
+ * Hedging applies only to operations the `IdempotencyPolicy` considers
+ * idempotent.
+ *
+ * The policy is disabled by default, pass it to the `Client` constructor to
+ * enable it:
+ *
+ * @code
+ * auto client = gcs::Client(options, gcs::HedgingPolicy(std::chrono::milliseconds(250)));
+ * @endcode
+ */
+class HedgingPolicy {
+ public:
+  HedgingPolicy() : delay_(0) {}
+  explicit HedgingPolicy(std::chrono::milliseconds delay) : delay_(delay) {}
+
+  /// Hedging is enabled by any positive delay.
+  bool enabled() const { return delay_.count() > 0; }
+  std::chrono::milliseconds delay() const { return delay_; }
+
+ private:
+  std::chrono::milliseconds delay_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_POLICY_H
@@ -36,7 +36,7 @@ Status AccessControlCommon::ParseFromJson(AccessControlCommon& result,
   result.role_ = json.value("role", "");
   result.self_link_ = json.value("selfLink", "");
   if (json.count("projectTeam") != 0) {
-    auto tmp = json["projectTeam"];
+    auto const& tmp = json["projectTeam"];
     ProjectTeam p;
     p.project_number = tmp.value("projectNumber", "");
     p.team = tmp.value("team", "");
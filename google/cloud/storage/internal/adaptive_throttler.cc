@@ -0,0 +1,88 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/adaptive_throttler.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::size_t constexpr AdaptiveThrottler::kNumBuckets;
+
+AdaptiveThrottler::AdaptiveThrottler(double accept_multiplier)
+    : accept_multiplier_(accept_multiplier),
+      bucket_start_(std::chrono::steady_clock::now()),
+      generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+
+bool AdaptiveThrottler::Allow() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Advance(std::chrono::steady_clock::now());
+  auto const p = RejectionProbabilityLocked();
+  // Count the request whether it is sent or rejected locally, a client that
+  // keeps trying during an overload should keep shedding load.
+  ++buckets_[index_].requests;
+  if (p <= 0) {
+    return true;
+  }
+  std::uniform_real_distribution<double> d(0, 1);
+  return d(generator_) >= p;
+}
+
+void AdaptiveThrottler::RecordAccept() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Advance(std::chrono::steady_clock::now());
+  ++buckets_[index_].accepts;
+}
+
+double AdaptiveThrottler::RejectionProbability() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return RejectionProbabilityLocked();
+}
+
+double AdaptiveThrottler::RejectionProbabilityLocked() const {
+  std::uint64_t requests = 0;
+  std::uint64_t accepts = 0;
+  for (auto const& b : buckets_) {
+    requests += b.requests;
+    accepts += b.accepts;
+  }
+  auto p = (static_cast<double>(requests) -
+            accept_multiplier_ * static_cast<double>(accepts)) /
+           static_cast<double>(requests + 1);
+  return (std::max)(0.0, p);
+}
+
+void AdaptiveThrottler::Advance(std::chrono::steady_clock::time_point now) {
+  auto elapsed =
+      std::chrono::duration_cast<std::chrono::seconds>(now - bucket_start_);
+  if (elapsed.count() <= 0) {
+    return;
+  }
+  auto steps = (std::min)(static_cast<std::size_t>(elapsed.count()),
+                          kNumBuckets);
+  for (std::size_t i = 0; i != steps; ++i) {
+    index_ = (index_ + 1) % kNumBuckets;
+    buckets_[index_] = Bucket{};
+  }
+  bucket_start_ += std::chrono::seconds(elapsed.count());
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_THROTTLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_THROTTLER_H
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/version.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Sheds load client-side when the service rejects a share of our requests.
+ *
+ * When the service returns bursts of 429/503 errors, retrying each call
+ * independently amplifies the overload and lengthens the brownout. This
+ * class implements adaptive throttling: it tracks the requests sent and the
+ * requests the service accepted over a trailing window, and rejects new
+ * requests locally with probability
+ *
+ *     max(0, (requests - multiplier * accepts) / (requests + 1))
+ *
+ * In the steady state (all requests accepted) nothing is rejected. As the
+ * service starts rejecting requests the probability rises, the client sheds
+ * load before putting it on the wire, and the service recovers faster.
+ *
+ * One instance is shared by all operations of a client, that is the point:
+ * the overload signal from any operation protects all of them.
+ */
+class AdaptiveThrottler {
+ public:
+  /**
+   * @param accept_multiplier how many requests are sent per accepted request
+   *   before throttling kicks in. Larger values waste more requests during
+   *   an overload but recover faster and tolerate spurious errors better.
+   *   The conventional default is 2.0.
+   */
+  explicit AdaptiveThrottler(double accept_multiplier = 2.0);
+
+  /**
+   * Records a request and decides if it may be sent.
+   *
+   * @return false if the request should be rejected locally without
+   *   contacting the service.
+   */
+  bool Allow();
+
+  /// Records that the service accepted (did not reject for overload) the
+  /// last request. Responses with application-level errors still count as
+  /// accepted, only overload rejections do not.
+  void RecordAccept();
+
+  /// The current probability of rejecting a request, for monitoring and
+  /// testing.
+  double RejectionProbability() const;
+
+ private:
+  // One-second buckets covering a two-minute trailing window.
+  static std::size_t constexpr kNumBuckets = 120;
+  struct Bucket {
+    std::uint64_t requests = 0;
+    std::uint64_t accepts = 0;
+  };
+
+  /// Expires old buckets. Requires `mu_` to be held.
+  void Advance(std::chrono::steady_clock::time_point now);
+  double RejectionProbabilityLocked() const;
+
+  double accept_multiplier_;
+  mutable std::mutex mu_;
+  std::array<Bucket, kNumBuckets> buckets_;  // GUARDED_BY(mu_)
+  std::size_t index_ = 0;                    // GUARDED_BY(mu_)
+  std::chrono::steady_clock::time_point bucket_start_;  // GUARDED_BY(mu_)
+  google::cloud::internal::DefaultPRNG generator_;      // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_THROTTLER_H
@@ -0,0 +1,69 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/adaptive_throttler.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// @test In the steady state no request is rejected.
+TEST(AdaptiveThrottlerTest, SteadyStateAllowsEverything) {
+  AdaptiveThrottler throttler;
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_TRUE(throttler.Allow());
+    throttler.RecordAccept();
+  }
+  EXPECT_EQ(0.0, throttler.RejectionProbability());
+}
+
+/// @test Requests without accepts raise the rejection probability.
+TEST(AdaptiveThrottlerTest, OverloadRaisesRejectionProbability) {
+  AdaptiveThrottler throttler;
+  int allowed = 0;
+  for (int i = 0; i != 200; ++i) {
+    if (throttler.Allow()) {
+      ++allowed;
+    }
+  }
+  EXPECT_GT(throttler.RejectionProbability(), 0.5);
+  // With 200 draws and a rejection probability growing towards 1.0 the
+  // probability of no local rejection is negligible.
+  EXPECT_LT(allowed, 200);
+}
+
+/// @test Accepted requests bring the rejection probability back to zero.
+TEST(AdaptiveThrottlerTest, RecoversAfterAccepts) {
+  AdaptiveThrottler throttler;
+  for (int i = 0; i != 100; ++i) {
+    throttler.Allow();
+  }
+  EXPECT_GT(throttler.RejectionProbability(), 0.0);
+  for (int i = 0; i != 300; ++i) {
+    throttler.Allow();
+    throttler.RecordAccept();
+  }
+  EXPECT_EQ(0.0, throttler.RejectionProbability());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
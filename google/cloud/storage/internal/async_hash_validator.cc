@@ -0,0 +1,114 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/async_hash_validator.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// Bound the memory used by queued buffers. When the limit is reached
+// `Update()` blocks, degrading gracefully to the synchronous behavior
+// instead of buffering an arbitrarily large transfer.
+std::size_t constexpr kMaxQueuedBytes = 16 * 1024 * 1024;
+}  // namespace
+
+AsyncHashValidator::AsyncHashValidator(std::unique_ptr<HashValidator> impl)
+    : impl_(std::move(impl)) {
+  worker_ = std::thread([this] { RunWorker(); });
+}
+
+AsyncHashValidator::~AsyncHashValidator() { Shutdown(); }
+
+void AsyncHashValidator::Update(char const* buf, std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  std::string copy(buf, n);
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return queued_bytes_ < kMaxQueuedBytes; });
+  queued_bytes_ += copy.size();
+  queue_.push_back(std::move(copy));
+  cv_.notify_all();
+}
+
+void AsyncHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
+  Drain();
+  impl_->ProcessMetadata(meta);
+}
+
+void AsyncHashValidator::ProcessHeader(std::string const& key,
+                                       std::string const& value) {
+  Drain();
+  impl_->ProcessHeader(key, value);
+}
+
+std::string AsyncHashValidator::State() const {
+  Drain();
+  return impl_->State();
+}
+
+Status AsyncHashValidator::Restore(std::string const& state) {
+  Drain();
+  return impl_->Restore(state);
+}
+
+HashValidator::Result AsyncHashValidator::Finish() && {
+  Shutdown();
+  return std::move(*impl_).Finish();
+}
+
+void AsyncHashValidator::Drain() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return queue_.empty() && !worker_busy_; });
+}
+
+void AsyncHashValidator::Shutdown() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (shutdown_) {
+      return;
+    }
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  worker_.join();
+}
+
+void AsyncHashValidator::RunWorker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return !queue_.empty() || shutdown_; });
+    if (queue_.empty()) {
+      return;
+    }
+    std::string buffer = std::move(queue_.front());
+    queue_.pop_front();
+    worker_busy_ = true;
+    lk.unlock();
+    impl_->Update(buffer.data(), buffer.size());
+    lk.lock();
+    queued_bytes_ -= buffer.size();
+    worker_busy_ = false;
+    cv_.notify_all();
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,82 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ASYNC_HASH_VALIDATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ASYNC_HASH_VALIDATOR_H
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A decorator that runs another validator on a dedicated thread.
+ *
+ * `Update()` copies the buffer into a (bounded) queue and returns, a worker
+ * thread feeds the queued buffers to the wrapped validator. This overlaps
+ * the hash computation with the network transfer, which would otherwise run
+ * serialized on the same thread. All other member functions wait for the
+ * queue to drain and then delegate, so from the caller's perspective this
+ * class behaves exactly like the wrapped validator.
+ *
+ * The caller must not invoke any member functions concurrently, this class
+ * only introduces concurrency between `Update()` and the wrapped validator.
+ */
+class AsyncHashValidator : public HashValidator {
+ public:
+  explicit AsyncHashValidator(std::unique_ptr<HashValidator> impl);
+  ~AsyncHashValidator() override;
+
+  std::string Name() const override { return impl_->Name(); }
+  void Update(char const* buf, std::size_t n) override;
+  void ProcessMetadata(ObjectMetadata const& meta) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  std::string State() const override;
+  Status Restore(std::string const& state) override;
+  Result Finish() && override;
+
+ private:
+  /// Block until the worker has consumed all the queued buffers.
+  void Drain() const;
+  /// Stop the worker thread, draining the queue first.
+  void Shutdown();
+  void RunWorker();
+
+  std::unique_ptr<HashValidator> impl_;
+  mutable std::mutex mu_;
+  mutable std::condition_variable cv_;
+  std::deque<std::string> queue_;   // GUARDED_BY(mu_)
+  std::size_t queued_bytes_ = 0;    // GUARDED_BY(mu_)
+  bool worker_busy_ = false;        // GUARDED_BY(mu_)
+  bool shutdown_ = false;           // GUARDED_BY(mu_)
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ASYNC_HASH_VALIDATOR_H
@@ -0,0 +1,89 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/async_hash_validator.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/internal/hash_validator_impl.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using google::cloud::internal::make_unique;
+
+/// @test Verify the async decorator computes the same result.
+TEST(AsyncHashValidatorTest, Simple) {
+  AsyncHashValidator validator(make_unique<Crc32cHashValidator>());
+  validator.Update("The quick", 9);
+  validator.Update(" brown", 6);
+  validator.Update(" fox jumps over the lazy dog", 28);
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ("ImIEBA==", result.computed);
+}
+
+/// @test Verify many small updates are all consumed before `Finish()`.
+TEST(AsyncHashValidatorTest, ManyUpdates) {
+  AsyncHashValidator async(make_unique<Crc32cHashValidator>());
+  Crc32cHashValidator sync;
+  std::string const block(1024, 'a');
+  for (int i = 0; i != 256; ++i) {
+    async.Update(block.data(), block.size());
+    sync.Update(block.data(), block.size());
+  }
+  auto actual = std::move(async).Finish();
+  auto expected = std::move(sync).Finish();
+  EXPECT_EQ(expected.computed, actual.computed);
+}
+
+/// @test Verify received hashes and mismatch detection work as usual.
+TEST(AsyncHashValidatorTest, ProcessHeader) {
+  AsyncHashValidator validator(make_unique<Crc32cHashValidator>());
+  validator.Update("The quick brown fox jumps over the lazy dog", 43);
+  validator.ProcessHeader("x-goog-hash", "crc32c=ImIEBA==");
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ("ImIEBA==", result.received);
+  EXPECT_EQ("ImIEBA==", result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+/// @test Verify `State()` drains the queue before serializing.
+TEST(AsyncHashValidatorTest, StateAndRestore) {
+  AsyncHashValidator validator(make_unique<Crc32cHashValidator>());
+  validator.Update("The quick brown fox", 19);
+  auto state = validator.State();
+
+  AsyncHashValidator restored(make_unique<Crc32cHashValidator>());
+  ASSERT_STATUS_OK(restored.Restore(state));
+  restored.Update(" jumps over the lazy dog", 24);
+  auto result = std::move(restored).Finish();
+  EXPECT_EQ("ImIEBA==", result.computed);
+}
+
+/// @test Verify destroying a validator without calling `Finish()` is safe.
+TEST(AsyncHashValidatorTest, AbandonedValidator) {
+  AsyncHashValidator validator(make_unique<Crc32cHashValidator>());
+  validator.Update("The quick brown fox", 19);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,269 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_request.h"
+#include "google/cloud/storage/internal/curl_handle.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/**
+ * Collects the request options for one part of a batch request.
+ *
+ * This class provides the same `AddOption()` interface as
+ * `CurlRequestBuilder`, so the `*Request` classes can contribute their
+ * optional query parameters and headers via `AddOptionsToHttpRequest()`.
+ */
+class BatchPartBuilder {
+ public:
+  explicit BatchPartBuilder(std::string path) : path_(std::move(path)) {}
+
+  template <typename P>
+  void AddOption(WellKnownParameter<P, std::string> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value());
+    }
+  }
+
+  template <typename P>
+  void AddOption(WellKnownParameter<P, std::int64_t> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), std::to_string(p.value()));
+    }
+  }
+
+  template <typename P>
+  void AddOption(WellKnownParameter<P, bool> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value() ? "true" : "false");
+    }
+  }
+
+  template <typename P>
+  void AddOption(WellKnownHeader<P, std::string> const& p) {
+    if (p.has_value()) {
+      headers_.push_back(std::string(p.header_name()) + ": " + p.value());
+    }
+  }
+
+  void AddOption(CustomHeader const& p) {
+    if (p.has_value()) {
+      headers_.push_back(p.custom_header_name() + ": " + p.value());
+    }
+  }
+
+  void AddOption(EncryptionKey const& p) {
+    if (p.has_value()) {
+      headers_.push_back(std::string(p.prefix()) +
+                         "algorithm: " + p.value().algorithm);
+      headers_.push_back(std::string(p.prefix()) + "key: " + p.value().key);
+      headers_.push_back(std::string(p.prefix()) +
+                         "key-sha256: " + p.value().sha256);
+    }
+  }
+
+  template <typename Option, typename T>
+  void AddOption(ComplexOption<Option, T> const&) {
+    // Ignore other options, they are handled by the caller where needed.
+  }
+
+  void AddQueryParameter(std::string const& key, std::string const& value) {
+    path_ += query_parameter_separator_;
+    AppendUrlEscaped(path_, key);
+    path_ += '=';
+    AppendUrlEscaped(path_, value);
+    query_parameter_separator_ = "&";
+  }
+
+  std::string path() && { return std::move(path_); }
+  std::vector<std::string> headers() && { return std::move(headers_); }
+
+ private:
+  std::string path_;
+  char const* query_parameter_separator_ = "?";
+  std::vector<std::string> headers_;
+};
+
+std::string ObjectPath(std::string const& bucket, std::string const& object) {
+  return "/storage/v1/b/" + bucket + "/o/" + UrlEscape(object);
+}
+
+}  // namespace
+
+Status BatchRequestBuilder::AddDeleteObject(DeleteObjectRequest const& request) {
+  BatchPartBuilder part(ObjectPath(request.bucket_name(), request.object_name()));
+  request.AddOptionsToHttpRequest(part);
+  return AddPart(Part{"DELETE", std::move(part).path(),
+                      std::move(part).headers(), std::string{}});
+}
+
+Status BatchRequestBuilder::AddPatchObject(PatchObjectRequest const& request) {
+  BatchPartBuilder part(ObjectPath(request.bucket_name(), request.object_name()));
+  request.AddOptionsToHttpRequest(part);
+  auto headers = std::move(part).headers();
+  headers.push_back("Content-Type: application/json; charset=UTF-8");
+  return AddPart(Part{"PATCH", std::move(part).path(), std::move(headers),
+                      request.payload()});
+}
+
+Status BatchRequestBuilder::AddGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  BatchPartBuilder part(ObjectPath(request.bucket_name(), request.object_name()));
+  request.AddOptionsToHttpRequest(part);
+  return AddPart(Part{"GET", std::move(part).path(), std::move(part).headers(),
+                      std::string{}});
+}
+
+Status BatchRequestBuilder::AddPart(Part part) {
+  if (parts_.size() >= kMaxBatchParts) {
+    std::ostringstream os;
+    os << "Batch requests cannot contain more than " << kMaxBatchParts
+       << " operations";
+    return Status(StatusCode::kInvalidArgument, std::move(os).str());
+  }
+  parts_.push_back(std::move(part));
+  return Status();
+}
+
+std::string BatchRequestBuilder::BuildPayload(
+    std::string const& boundary) const {
+  std::string const crlf = "\r\n";
+  std::string result;
+  int content_id = 0;
+  for (auto const& part : parts_) {
+    result += "--" + boundary + crlf;
+    result += "Content-Type: application/http" + crlf;
+    result += "Content-Transfer-Encoding: binary" + crlf;
+    result += "Content-ID: <item" + std::to_string(++content_id) + ">" + crlf;
+    result += crlf;
+    result += part.method + " " + part.path + " HTTP/1.1" + crlf;
+    for (auto const& header : part.headers) {
+      result += header + crlf;
+    }
+    if (!part.payload.empty()) {
+      result +=
+          "Content-Length: " + std::to_string(part.payload.size()) + crlf;
+    }
+    result += crlf;
+    result += part.payload;
+    result += crlf;
+  }
+  result += "--" + boundary + "--" + crlf;
+  return result;
+}
+
+StatusOr<std::vector<HttpResponse>> ParseBatchResponse(
+    HttpResponse const& response) {
+  // Find the part boundary in the `Content-Type` response header, e.g.:
+  //     Content-Type: multipart/mixed; boundary=batch_deadbeef
+  std::string boundary;
+  for (auto const& kv : response.headers) {
+    if (kv.first != "content-type" && kv.first != "Content-Type") {
+      continue;
+    }
+    auto pos = kv.second.find("boundary=");
+    if (pos == std::string::npos) {
+      continue;
+    }
+    boundary = kv.second.substr(pos + sizeof("boundary=") - 1);
+    auto end = boundary.find_first_of("; \r\n");
+    if (end != std::string::npos) {
+      boundary.erase(end);
+    }
+  }
+  if (boundary.empty()) {
+    return Status(StatusCode::kInternal,
+                  "missing multipart/mixed boundary in batch response");
+  }
+
+  std::string const delimiter = "--" + boundary;
+  std::vector<HttpResponse> result;
+  auto pos = response.payload.find(delimiter);
+  while (pos != std::string::npos) {
+    pos += delimiter.size();
+    if (response.payload.compare(pos, 2, "--") == 0) {
+      break;  // The closing delimiter.
+    }
+    auto next = response.payload.find(delimiter, pos);
+    if (next == std::string::npos) {
+      return Status(StatusCode::kInternal,
+                    "unterminated part in batch response");
+    }
+    auto part = response.payload.substr(pos, next - pos);
+    pos = next;
+
+    // Skip the part headers (Content-Type: application/http, etc.), the
+    // embedded HTTP response starts after the first empty line.
+    auto body_pos = part.find("\r\n\r\n");
+    if (body_pos == std::string::npos) {
+      return Status(StatusCode::kInternal,
+                    "malformed part in batch response");
+    }
+    auto http = part.substr(body_pos + 4);
+
+    // Parse the embedded status line, e.g. `HTTP/1.1 204 No Content`.
+    if (http.compare(0, 5, "HTTP/") != 0) {
+      return Status(StatusCode::kInternal,
+                    "missing embedded status line in batch response part");
+    }
+    auto space = http.find(' ');
+    long status_code = std::strtol(http.c_str() + space + 1, nullptr, 10);
+
+    HttpResponse part_response;
+    part_response.status_code = status_code;
+
+    // Parse the embedded headers and payload.
+    auto line_start = http.find("\r\n") + 2;
+    while (line_start < http.size()) {
+      auto line_end = http.find("\r\n", line_start);
+      if (line_end == std::string::npos) {
+        line_end = http.size();
+      }
+      if (line_end == line_start) {
+        // An empty line separates the embedded headers from the payload.
+        part_response.payload = http.substr(line_end + 2);
+        break;
+      }
+      auto line = http.substr(line_start, line_end - line_start);
+      auto colon = line.find(':');
+      if (colon != std::string::npos) {
+        auto value = line.substr(colon + 1);
+        auto value_start = value.find_first_not_of(' ');
+        if (value_start != std::string::npos) {
+          value = value.substr(value_start);
+        }
+        part_response.headers.emplace(line.substr(0, colon), std::move(value));
+      }
+      line_start = line_end + 2;
+    }
+    // Trim the CRLF that separates the payload from the next boundary.
+    auto& payload = part_response.payload;
+    if (payload.size() >= 2 && payload.compare(payload.size() - 2, 2, "\r\n") == 0) {
+      payload.erase(payload.size() - 2);
+    }
+    result.push_back(std::move(part_response));
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,100 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The maximum number of operations the GCS batch endpoint accepts.
+std::size_t constexpr kMaxBatchParts = 100;
+
+/**
+ * Builds a batch request for the GCS JSON API.
+ *
+ * The batch endpoint (`/batch/storage/v1`) accepts a `multipart/mixed`
+ * payload where each part is a serialized HTTP request for a metadata
+ * operation. Grouping many small operations (e.g. millions of nightly
+ * `DeleteObject` calls) into batches of up to `kMaxBatchParts` saves one
+ * HTTPS round trip per operation.
+ *
+ * Note that media operations (downloads and uploads) cannot be batched, the
+ * service only accepts metadata-only operations.
+ */
+class BatchRequestBuilder {
+ public:
+  BatchRequestBuilder() = default;
+
+  /// Adds an `Objects: delete` operation to the batch.
+  Status AddDeleteObject(DeleteObjectRequest const& request);
+
+  /// Adds an `Objects: patch` operation to the batch.
+  Status AddPatchObject(PatchObjectRequest const& request);
+
+  /// Adds an `Objects: get` (metadata) operation to the batch.
+  Status AddGetObjectMetadata(GetObjectMetadataRequest const& request);
+
+  std::size_t size() const { return parts_.size(); }
+  bool empty() const { return parts_.empty(); }
+
+  /**
+   * Formats the `multipart/mixed` payload for this batch.
+   *
+   * The caller is responsible for picking a @p boundary that does not appear
+   * in any of the part payloads, see `CurlClient::PickBoundary()`.
+   */
+  std::string BuildPayload(std::string const& boundary) const;
+
+ private:
+  struct Part {
+    std::string method;
+    std::string path;
+    std::vector<std::string> headers;
+    std::string payload;
+  };
+
+  Status AddPart(Part part);
+
+  std::vector<Part> parts_;
+};
+
+/**
+ * Parses a `multipart/mixed` batch response into the per-part responses.
+ *
+ * The parts are returned in the same order as the operations were added to
+ * the `BatchRequestBuilder`. Each part is an `HttpResponse`, a part may be a
+ * failure (e.g. 404 for a delete of a missing object) even though the batch
+ * as a whole succeeded.
+ */
+StatusOr<std::vector<HttpResponse>> ParseBatchResponse(
+    HttpResponse const& response);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H
@@ -0,0 +1,128 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_request.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(BatchRequestTest, BuildPayload) {
+  BatchRequestBuilder builder;
+  ASSERT_TRUE(builder
+                  .AddDeleteObject(DeleteObjectRequest("test-bucket",
+                                                       "test-object")
+                                       .set_multiple_options(Generation(7)))
+                  .ok());
+  ASSERT_TRUE(builder
+                  .AddGetObjectMetadata(
+                      GetObjectMetadataRequest("test-bucket", "test object"))
+                  .ok());
+  EXPECT_EQ(2, builder.size());
+
+  auto payload = builder.BuildPayload("test-boundary");
+  EXPECT_THAT(payload, HasSubstr("--test-boundary\r\n"));
+  EXPECT_THAT(payload, HasSubstr("Content-Type: application/http\r\n"));
+  EXPECT_THAT(payload, HasSubstr("Content-ID: <item1>\r\n"));
+  EXPECT_THAT(payload, HasSubstr("Content-ID: <item2>\r\n"));
+  EXPECT_THAT(
+      payload,
+      HasSubstr(
+          "DELETE /storage/v1/b/test-bucket/o/test-object?generation=7"
+          " HTTP/1.1\r\n"));
+  // The object name must be URL-escaped inside the part.
+  EXPECT_THAT(
+      payload,
+      HasSubstr("GET /storage/v1/b/test-bucket/o/test%20object HTTP/1.1\r\n"));
+  EXPECT_THAT(payload, HasSubstr("--test-boundary--\r\n"));
+}
+
+TEST(BatchRequestTest, BuildPayloadWithPatch) {
+  BatchRequestBuilder builder;
+  ObjectMetadataPatchBuilder patch;
+  patch.SetContentType("text/plain");
+  ASSERT_TRUE(builder
+                  .AddPatchObject(PatchObjectRequest("test-bucket",
+                                                     "test-object", patch))
+                  .ok());
+  auto payload = builder.BuildPayload("test-boundary");
+  EXPECT_THAT(payload, HasSubstr("PATCH /storage/v1/b/test-bucket/o/"
+                                 "test-object HTTP/1.1\r\n"));
+  EXPECT_THAT(payload,
+              HasSubstr("Content-Type: application/json; charset=UTF-8\r\n"));
+  EXPECT_THAT(payload, HasSubstr("text/plain"));
+}
+
+TEST(BatchRequestTest, TooManyParts) {
+  BatchRequestBuilder builder;
+  for (std::size_t i = 0; i != kMaxBatchParts; ++i) {
+    ASSERT_TRUE(builder
+                    .AddDeleteObject(DeleteObjectRequest(
+                        "test-bucket", "object-" + std::to_string(i)))
+                    .ok());
+  }
+  auto status = builder.AddDeleteObject(
+      DeleteObjectRequest("test-bucket", "one-too-many"));
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+  EXPECT_EQ(kMaxBatchParts, builder.size());
+}
+
+TEST(BatchRequestTest, ParseBatchResponse) {
+  std::string const payload =
+      "--batch_foo\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item1>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_foo\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item2>\r\n"
+      "\r\n"
+      "HTTP/1.1 404 Not Found\r\n"
+      "Content-Type: application/json\r\n"
+      "\r\n"
+      "{\"error\": {\"code\": 404}}\r\n"
+      "--batch_foo--\r\n";
+  HttpResponse response{200, payload,
+                        {{"content-type", "multipart/mixed; boundary=batch_foo"}}};
+  auto parsed = ParseBatchResponse(response);
+  ASSERT_TRUE(parsed.ok());
+  ASSERT_EQ(2, parsed->size());
+  EXPECT_EQ(204, (*parsed)[0].status_code);
+  EXPECT_EQ(404, (*parsed)[1].status_code);
+  EXPECT_EQ("{\"error\": {\"code\": 404}}", (*parsed)[1].payload);
+  EXPECT_EQ(1, (*parsed)[1].headers.count("Content-Type"));
+}
+
+TEST(BatchRequestTest, ParseBatchResponseMissingBoundary) {
+  HttpResponse response{200, "not-a-batch", {{"content-type", "text/plain"}}};
+  auto parsed = ParseBatchResponse(response);
+  EXPECT_EQ(StatusCode::kInternal, parsed.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,219 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BOUNDED_MPMC_QUEUE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BOUNDED_MPMC_QUEUE_H
+
+#include "google/cloud/optional.h"
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A bounded multi-producer multi-consumer queue for work distribution.
+ *
+ * The fast path is lock-free: the queue is a pre-allocated ring of slots,
+ * each with a sequence counter, producers and consumers claim a slot with a
+ * single compare-and-swap and then publish it with a store-release on the
+ * slot's counter. Threads never contend on a common mutex while the queue
+ * is neither full nor empty, which is the steady state when the work
+ * distribution is balanced.
+ *
+ * `Push()` and `Pop()` block, with a short spin before sleeping, when the
+ * queue is full (resp. empty). `Shutdown()` wakes all blocked threads,
+ * after a shutdown `Push()` rejects new elements while `Pop()` drains the
+ * elements already in the queue and then returns an empty optional.
+ */
+template <typename T>
+class BoundedMpmcQueue {
+ public:
+  /// Create a queue holding at least @p capacity elements.
+  explicit BoundedMpmcQueue(std::size_t capacity)
+      : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+        slots_(new Slot[mask_ + 1]),
+        head_(0),
+        tail_(0),
+        shutdown_(false),
+        push_waiters_(0),
+        pop_waiters_(0) {
+    for (std::size_t i = 0; i != mask_ + 1; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~BoundedMpmcQueue() {
+    // Destroy any elements still in the queue.
+    while (TryPop().has_value()) continue;
+  }
+
+  BoundedMpmcQueue(BoundedMpmcQueue const&) = delete;
+  BoundedMpmcQueue& operator=(BoundedMpmcQueue const&) = delete;
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+  /// Push without blocking, returns false if the queue is full or shutdown.
+  bool TryPush(T value) {
+    if (shutdown_.load(std::memory_order_acquire)) return false;
+    return TryPushImpl(value);
+  }
+
+  /// Pop without blocking, returns an empty optional if the queue is empty.
+  optional<T> TryPop() {
+    Slot* slot;
+    auto pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      auto seq = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) -
+                  static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return optional<T>{};  // empty
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    auto* element = reinterpret_cast<T*>(&slot->storage);
+    optional<T> result(std::move(*element));
+    element->~T();
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    WakeWaiters(push_waiters_, cv_not_full_);
+    return result;
+  }
+
+  /// Push @p value, blocking while the queue is full. Returns false (and
+  /// discards the value) if the queue is shutdown.
+  bool Push(T value) {
+    for (;;) {
+      for (int i = 0; i != kSpinCount; ++i) {
+        if (shutdown_.load(std::memory_order_acquire)) return false;
+        if (TryPushImpl(value)) return true;
+      }
+      Wait(push_waiters_, cv_not_full_);
+    }
+  }
+
+  /// Pop one element, blocking while the queue is empty. Returns an empty
+  /// optional once the queue is shutdown and drained.
+  optional<T> Pop() {
+    for (;;) {
+      for (int i = 0; i != kSpinCount; ++i) {
+        auto value = TryPop();
+        if (value.has_value()) return value;
+        // After a shutdown no producer adds elements, a failed pop means
+        // the queue is fully drained.
+        if (shutdown_.load(std::memory_order_acquire)) return value;
+      }
+      Wait(pop_waiters_, cv_not_empty_);
+    }
+  }
+
+  /// Wake all blocked threads, reject any further `Push()` calls.
+  void Shutdown() {
+    shutdown_.store(true, std::memory_order_release);
+    std::unique_lock<std::mutex> lk(mu_);
+    lk.unlock();
+    cv_not_full_.notify_all();
+    cv_not_empty_.notify_all();
+  }
+
+ private:
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  /// Claim a slot and move @p value into it, @p value is left untouched when
+  /// the queue is full.
+  bool TryPushImpl(T& value) {
+    Slot* slot;
+    auto pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      auto seq = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) -
+                  static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    new (&slot->storage) T(std::move(value));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    WakeWaiters(pop_waiters_, cv_not_empty_);
+    return true;
+  }
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t n) {
+    std::size_t result = 1;
+    while (result < n) result *= 2;
+    return result;
+  }
+
+  void Wait(std::atomic<int>& waiters, std::condition_variable& cv) {
+    std::unique_lock<std::mutex> lk(mu_);
+    waiters.fetch_add(1, std::memory_order_relaxed);
+    // The retry state is re-examined by the caller, a bounded wait keeps a
+    // lost notification from blocking the thread forever.
+    cv.wait_for(lk, std::chrono::milliseconds(1));
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void WakeWaiters(std::atomic<int>& waiters, std::condition_variable& cv) {
+    if (waiters.load(std::memory_order_relaxed) == 0) return;
+    cv.notify_one();
+  }
+
+  static int constexpr kSpinCount = 128;
+
+  std::size_t const mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<std::size_t> head_;
+  std::atomic<std::size_t> tail_;
+  std::atomic<bool> shutdown_;
+
+  std::mutex mu_;
+  std::condition_variable cv_not_full_;
+  std::condition_variable cv_not_empty_;
+  std::atomic<int> push_waiters_;
+  std::atomic<int> pop_waiters_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BOUNDED_MPMC_QUEUE_H
@@ -0,0 +1,144 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/bounded_mpmc_queue.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// @test Verify elements are delivered in FIFO order.
+TEST(BoundedMpmcQueueTest, Simple) {
+  BoundedMpmcQueue<int> queue(16);
+  EXPECT_EQ(16U, queue.capacity());
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Push(3));
+  EXPECT_EQ(1, queue.Pop().value());
+  EXPECT_EQ(2, queue.Pop().value());
+  EXPECT_EQ(3, queue.Pop().value());
+  EXPECT_FALSE(queue.TryPop().has_value());
+}
+
+/// @test Verify the capacity is rounded up to a power of two.
+TEST(BoundedMpmcQueueTest, CapacityRounding) {
+  BoundedMpmcQueue<int> queue(10);
+  EXPECT_EQ(16U, queue.capacity());
+}
+
+/// @test Verify `TryPush()` fails on a full queue without losing elements.
+TEST(BoundedMpmcQueueTest, TryPushFull) {
+  BoundedMpmcQueue<int> queue(4);
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(42));
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_EQ(i, queue.Pop().value());
+  }
+}
+
+/// @test Verify move-only elements work.
+TEST(BoundedMpmcQueueTest, MoveOnly) {
+  BoundedMpmcQueue<std::unique_ptr<int>> queue(4);
+  queue.Push(std::unique_ptr<int>(new int(42)));
+  auto value = queue.Pop();
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(42, **value);
+}
+
+/// @test Verify `Shutdown()` unblocks consumers and drains the queue.
+TEST(BoundedMpmcQueueTest, Shutdown) {
+  BoundedMpmcQueue<int> queue(16);
+  queue.Push(1);
+  queue.Push(2);
+  queue.Shutdown();
+  EXPECT_FALSE(queue.Push(3));
+  // The elements pushed before the shutdown are still delivered.
+  EXPECT_EQ(1, queue.Pop().value());
+  EXPECT_EQ(2, queue.Pop().value());
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+/// @test Verify `Shutdown()` wakes up a blocked `Pop()`.
+TEST(BoundedMpmcQueueTest, ShutdownUnblocksPop) {
+  BoundedMpmcQueue<int> queue(16);
+  auto consumer = std::async(std::launch::async,
+                             [&queue] { return queue.Pop().has_value(); });
+  queue.Shutdown();
+  EXPECT_FALSE(consumer.get());
+}
+
+/// @test Verify a blocked `Push()` completes once space is available.
+TEST(BoundedMpmcQueueTest, PushBlocksWhenFull) {
+  BoundedMpmcQueue<int> queue(2);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  auto producer =
+      std::async(std::launch::async, [&queue] { return queue.Push(3); });
+  EXPECT_EQ(1, queue.Pop().value());
+  EXPECT_TRUE(producer.get());
+  EXPECT_EQ(2, queue.Pop().value());
+  EXPECT_EQ(3, queue.Pop().value());
+}
+
+/// @test Verify concurrent producers and consumers deliver every element.
+TEST(BoundedMpmcQueueTest, ManyProducersManyConsumers) {
+  auto constexpr kProducers = 4;
+  auto constexpr kConsumers = 4;
+  auto constexpr kElementsPerProducer = 10000;
+  BoundedMpmcQueue<int> queue(64);
+
+  std::vector<std::future<void>> producers;
+  for (int p = 0; p != kProducers; ++p) {
+    producers.push_back(std::async(std::launch::async, [&queue, p] {
+      for (int i = 0; i != kElementsPerProducer; ++i) {
+        queue.Push(p * kElementsPerProducer + i);
+      }
+    }));
+  }
+  std::vector<std::future<std::int64_t>> consumers;
+  for (int c = 0; c != kConsumers; ++c) {
+    consumers.push_back(std::async(std::launch::async, [&queue] {
+      std::int64_t sum = 0;
+      for (auto value = queue.Pop(); value.has_value(); value = queue.Pop()) {
+        sum += *value;
+      }
+      return sum;
+    }));
+  }
+  for (auto& p : producers) p.get();
+  queue.Shutdown();
+  std::int64_t total = 0;
+  for (auto& c : consumers) total += c.get();
+
+  std::int64_t const count = kProducers * kElementsPerProducer;
+  EXPECT_EQ(count * (count - 1) / 2, total);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,392 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/bucket_metadata_cache_client.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+BucketMetadataCacheClient::BucketMetadataCacheClient(
+    std::shared_ptr<RawClient> client, std::chrono::seconds ttl)
+    : client_(std::move(client)), ttl_(ttl) {}
+
+ClientOptions const& BucketMetadataCacheClient::client_options() const {
+  return client_->client_options();
+}
+
+PoolStatistics BucketMetadataCacheClient::pool_statistics() const {
+  return client_->pool_statistics();
+}
+
+bool BucketMetadataCacheClient::Cacheable(
+    GetBucketMetadataRequest const& request) {
+  return !request.HasOption<IfMetagenerationMatch>() &&
+         !request.HasOption<IfMetagenerationNotMatch>() &&
+         !request.HasOption<Projection>() && !request.HasOption<Fields>();
+}
+
+void BucketMetadataCacheClient::StoreEntry(BucketMetadata metadata) {
+  auto name = metadata.name();
+  std::lock_guard<std::mutex> lk(mu_);
+  cache_[std::move(name)] =
+      CacheEntry{std::move(metadata), std::chrono::steady_clock::now()};
+}
+
+void BucketMetadataCacheClient::EraseEntry(std::string const& bucket_name) {
+  std::lock_guard<std::mutex> lk(mu_);
+  cache_.erase(bucket_name);
+}
+
+StatusOr<BucketMetadata> BucketMetadataCacheClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  if (!Cacheable(request)) {
+    return client_->GetBucketMetadata(request);
+  }
+  bool has_stale_entry = false;
+  BucketMetadata stale;
+  auto const now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = cache_.find(request.bucket_name());
+    if (it != cache_.end()) {
+      if (now - it->second.fetch_time < ttl_) {
+        return it->second.metadata;
+      }
+      has_stale_entry = true;
+      stale = it->second.metadata;
+    }
+  }
+  if (!has_stale_entry) {
+    auto response = client_->GetBucketMetadata(request);
+    if (response) {
+      StoreEntry(*response);
+    }
+    return response;
+  }
+  // Revalidate the stale entry: if the metageneration is unchanged the
+  // service answers `304 Not Modified` (reported as kFailedPrecondition)
+  // with no payload, and the stale entry is still current.
+  auto revalidate = request;
+  revalidate.set_option(IfMetagenerationNotMatch(stale.metageneration()));
+  auto response = client_->GetBucketMetadata(revalidate);
+  if (response) {
+    StoreEntry(*response);
+    return response;
+  }
+  if (response.status().code() == StatusCode::kFailedPrecondition) {
+    StoreEntry(stale);
+    return stale;
+  }
+  // Other failures may be transient, drop the entry rather than serving
+  // metadata of unknown freshness on later calls.
+  EraseEntry(request.bucket_name());
+  return response;
+}
+
+StatusOr<ListBucketsResponse> BucketMetadataCacheClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+StatusOr<BucketMetadata> BucketMetadataCacheClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  auto response = client_->CreateBucket(request);
+  if (response) {
+    StoreEntry(*response);
+  }
+  return response;
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  EraseEntry(request.bucket_name());
+  return client_->DeleteBucket(request);
+}
+
+StatusOr<BucketMetadata> BucketMetadataCacheClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  auto response = client_->UpdateBucket(request);
+  if (response) {
+    StoreEntry(*response);
+  } else {
+    EraseEntry(request.metadata().name());
+  }
+  return response;
+}
+
+StatusOr<BucketMetadata> BucketMetadataCacheClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  auto response = client_->PatchBucket(request);
+  if (response) {
+    StoreEntry(*response);
+  } else {
+    EraseEntry(request.bucket());
+  }
+  return response;
+}
+
+StatusOr<IamPolicy> BucketMetadataCacheClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> BucketMetadataCacheClient::GetNativeBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetNativeBucketIamPolicy(request);
+}
+
+StatusOr<IamPolicy> BucketMetadataCacheClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  return client_->SetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> BucketMetadataCacheClient::SetNativeBucketIamPolicy(
+    SetNativeBucketIamPolicyRequest const& request) {
+  return client_->SetNativeBucketIamPolicy(request);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+BucketMetadataCacheClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  return client_->TestBucketIamPermissions(request);
+}
+
+StatusOr<BucketMetadata> BucketMetadataCacheClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  auto response = client_->LockBucketRetentionPolicy(request);
+  if (response) {
+    StoreEntry(*response);
+  } else {
+    EraseEntry(request.bucket_name());
+  }
+  return response;
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return client_->InsertObjectMedia(request);
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return client_->CopyObject(request);
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return client_->GetObjectMetadata(request);
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>>
+BucketMetadataCacheClient::ReadObject(ReadObjectRangeRequest const& request) {
+  return client_->ReadObject(request);
+}
+
+StatusOr<ListObjectsResponse> BucketMetadataCacheClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return client_->DeleteObject(request);
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return client_->UpdateObject(request);
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return client_->PatchObject(request);
+}
+
+StatusOr<ObjectMetadata> BucketMetadataCacheClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return client_->ComposeObject(request);
+}
+
+StatusOr<RewriteObjectResponse> BucketMetadataCacheClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return client_->RewriteObject(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+BucketMetadataCacheClient::CreateResumableSession(
+    ResumableUploadRequest const& request) {
+  return client_->CreateResumableSession(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+BucketMetadataCacheClient::RestoreResumableSession(
+    std::string const& session_id) {
+  return client_->RestoreResumableSession(session_id);
+}
+
+StatusOr<ListBucketAclResponse> BucketMetadataCacheClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> BucketMetadataCacheClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  return client_->CreateBucketAcl(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  return client_->DeleteBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> BucketMetadataCacheClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return client_->GetBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> BucketMetadataCacheClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  return client_->UpdateBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> BucketMetadataCacheClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  return client_->PatchBucketAcl(request);
+}
+
+StatusOr<ListObjectAclResponse> BucketMetadataCacheClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return client_->CreateObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  return client_->DeleteObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return client_->UpdateObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return client_->PatchObjectAcl(request);
+}
+
+StatusOr<ListDefaultObjectAclResponse>
+BucketMetadataCacheClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return client_->ListDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  return client_->CreateDefaultObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  return client_->DeleteDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return client_->GetDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  return client_->UpdateDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> BucketMetadataCacheClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  return client_->PatchDefaultObjectAcl(request);
+}
+
+StatusOr<ServiceAccount> BucketMetadataCacheClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return client_->GetServiceAccount(request);
+}
+
+StatusOr<ListHmacKeysResponse> BucketMetadataCacheClient::ListHmacKeys(
+    ListHmacKeysRequest const& request) {
+  return client_->ListHmacKeys(request);
+}
+
+StatusOr<CreateHmacKeyResponse> BucketMetadataCacheClient::CreateHmacKey(
+    CreateHmacKeyRequest const& request) {
+  return client_->CreateHmacKey(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteHmacKey(
+    DeleteHmacKeyRequest const& request) {
+  return client_->DeleteHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> BucketMetadataCacheClient::GetHmacKey(
+    GetHmacKeyRequest const& request) {
+  return client_->GetHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> BucketMetadataCacheClient::UpdateHmacKey(
+    UpdateHmacKeyRequest const& request) {
+  return client_->UpdateHmacKey(request);
+}
+
+StatusOr<SignBlobResponse> BucketMetadataCacheClient::SignBlob(
+    SignBlobRequest const& request) {
+  return client_->SignBlob(request);
+}
+
+StatusOr<ListNotificationsResponse>
+BucketMetadataCacheClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return client_->ListNotifications(request);
+}
+
+StatusOr<NotificationMetadata> BucketMetadataCacheClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return client_->CreateNotification(request);
+}
+
+StatusOr<NotificationMetadata> BucketMetadataCacheClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return client_->GetNotification(request);
+}
+
+StatusOr<EmptyResponse> BucketMetadataCacheClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return client_->DeleteNotification(request);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
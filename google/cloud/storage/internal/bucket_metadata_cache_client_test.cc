@@ -0,0 +1,151 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/bucket_metadata_cache_client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::TransientError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+BucketMetadata MakeBucket(std::string const& name, int metageneration) {
+  std::string text = R"""({
+      "kind": "storage#bucket",
+      "id": ")""" + name + R"""(",
+      "name": ")""" + name + R"""(",
+      "metageneration": ")""" + std::to_string(metageneration) +
+                     R"""(",
+      "storageClass": "REGIONAL"
+})""";
+  return internal::BucketMetadataParser::FromString(text).value();
+}
+
+TEST(BucketMetadataCacheClientTest, ServesFreshEntriesFromMemory) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))));
+
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(3600));
+  auto first = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(first);
+  auto second = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ(*first, *second);
+}
+
+TEST(BucketMetadataCacheClientTest, RevalidatesExpiredEntries) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))))
+      .WillOnce(Invoke([](GetBucketMetadataRequest const& request) {
+        // An expired entry is revalidated with a precondition, the
+        // `304 Not Modified` answer surfaces as kFailedPrecondition.
+        EXPECT_TRUE(request.HasOption<IfMetagenerationNotMatch>());
+        EXPECT_EQ(4, request.GetOption<IfMetagenerationNotMatch>().value());
+        return StatusOr<BucketMetadata>(
+            Status(StatusCode::kFailedPrecondition, "not modified"));
+      }));
+
+  // A zero TTL expires entries immediately, forcing revalidation.
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(0));
+  auto first = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(first);
+  auto second = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ(*first, *second);
+}
+
+TEST(BucketMetadataCacheClientTest, RevalidationPicksUpChanges) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 5))));
+
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(0));
+  auto first = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(first);
+  auto second = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ(5, second->metageneration());
+}
+
+TEST(BucketMetadataCacheClientTest, ConditionalRequestsBypassTheCache) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))));
+
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(3600));
+  auto request = GetBucketMetadataRequest("my-bucket");
+  request.set_option(IfMetagenerationMatch(4));
+  ASSERT_STATUS_OK(client.GetBucketMetadata(request));
+  ASSERT_STATUS_OK(client.GetBucketMetadata(request));
+}
+
+TEST(BucketMetadataCacheClientTest, MutationsUpdateTheCache) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))));
+  EXPECT_CALL(*mock, PatchBucket(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 5))));
+
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(3600));
+  ASSERT_STATUS_OK(
+      client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket")));
+  ASSERT_STATUS_OK(client.PatchBucket(
+      PatchBucketRequest("my-bucket", BucketMetadataPatchBuilder())));
+  // The patched metadata is served without another GetBucketMetadata call.
+  auto updated =
+      client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(updated);
+  EXPECT_EQ(5, updated->metageneration());
+}
+
+TEST(BucketMetadataCacheClientTest, TransientErrorsDropTheEntry) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 4))))
+      .WillOnce(Return(StatusOr<BucketMetadata>(TransientError())))
+      .WillOnce(Return(make_status_or(MakeBucket("my-bucket", 6))));
+
+  BucketMetadataCacheClient client(mock, std::chrono::seconds(0));
+  ASSERT_STATUS_OK(
+      client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket")));
+  auto failed =
+      client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  EXPECT_FALSE(failed);
+  // The failed revalidation dropped the entry, the next call is a full
+  // fetch without preconditions.
+  auto third = client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  ASSERT_STATUS_OK(third);
+  EXPECT_EQ(6, third->metageneration());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -75,7 +75,7 @@ StatusOr<LifecycleRule> LifecycleRuleParser::FromJson(
     result.action_.storage_class = json["action"].value("storageClass", "");
   }
   if (json.count("condition") != 0) {
-    auto condition = json["condition"];
+    auto const& condition = json["condition"];
     if (condition.count("age") != 0) {
       result.condition_.age.emplace(internal::ParseIntField(condition, "age"));
     }
@@ -130,7 +130,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
     }
   }
   if (json.count("billing") != 0) {
-    auto billing = json["billing"];
+    auto const& billing = json["billing"];
     BucketBilling b;
     b.requester_pays = internal::ParseBoolField(billing, "requesterPays");
     result.billing_ = b;
@@ -161,7 +161,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
 
   if (json.count("iamConfiguration") != 0) {
     BucketIamConfiguration c;
-    auto config = json["iamConfiguration"];
+    auto const& config = json["iamConfiguration"];
     if (config.count("uniformBucketLevelAccess") != 0) {
       c.uniform_bucket_level_access =
           ParseUniformBucketLevelAccess(config["uniformBucketLevelAccess"]);
@@ -183,7 +183,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
   }
 
   if (json.count("lifecycle") != 0) {
-    auto lifecycle = json["lifecycle"];
+    auto const& lifecycle = json["lifecycle"];
     BucketLifecycle value;
     if (lifecycle.count("rule") != 0) {
       for (auto const& kv : lifecycle["rule"].items()) {
@@ -202,7 +202,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
   result.location_type_ = json.value("locationType", "");
 
   if (json.count("logging") != 0) {
-    auto logging = json["logging"];
+    auto const& logging = json["logging"];
     BucketLogging l;
     l.log_bucket = logging.value("logBucket", "");
     l.log_object_prefix = logging.value("logObjectPrefix", "");
@@ -216,7 +216,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
   }
 
   if (json.count("retentionPolicy") != 0) {
-    auto retention_policy = json["retentionPolicy"];
+    auto const& retention_policy = json["retentionPolicy"];
     BucketRetentionPolicy r;
     r.retention_period = std::chrono::seconds(
         internal::ParseLongField(retention_policy, "retentionPeriod"));
@@ -227,7 +227,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
   }
 
   if (json.count("versioning") != 0) {
-    auto versioning = json["versioning"];
+    auto const& versioning = json["versioning"];
     if (versioning.count("enabled") != 0) {
       BucketVersioning v{internal::ParseBoolField(versioning, "enabled")};
       result.versioning_ = v;
@@ -235,7 +235,7 @@ StatusOr<BucketMetadata> BucketMetadataParser::FromJson(
   }
 
   if (json.count("website") != 0) {
-    auto website = json["website"];
+    auto const& website = json["website"];
     BucketWebsite w;
     w.main_page_suffix = website.value("mainPageSuffix", "");
     w.not_found_page = website.value("notFoundPage", "");
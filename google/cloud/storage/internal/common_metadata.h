@@ -102,20 +102,29 @@ class CommonMetadata {
     return ParseFromJson(json);
   }
 
-  std::string const& etag() const { return etag_; }
-  std::string const& id() const { return id_; }
-  std::string const& kind() const { return kind_; }
+  // The string accessors are `&&`-qualified overloads so applications (and
+  // the library itself) can steal the strings from expiring values instead
+  // of copying them.
+  std::string const& etag() const& { return etag_; }
+  std::string&& etag() && { return std::move(etag_); }
+  std::string const& id() const& { return id_; }
+  std::string&& id() && { return std::move(id_); }
+  std::string const& kind() const& { return kind_; }
+  std::string&& kind() && { return std::move(kind_); }
   std::int64_t metageneration() const { return metageneration_; }
 
-  std::string const& name() const { return name_; }
+  std::string const& name() const& { return name_; }
+  std::string&& name() && { return std::move(name_); }
   void set_name(std::string value) { name_ = std::move(value); }
 
   bool has_owner() const { return owner_.has_value(); }
   Owner const& owner() const { return owner_.value(); }
 
-  std::string const& self_link() const { return self_link_; }
+  std::string const& self_link() const& { return self_link_; }
+  std::string&& self_link() && { return std::move(self_link_); }
 
-  std::string const& storage_class() const { return storage_class_; }
+  std::string const& storage_class() const& { return storage_class_; }
+  std::string&& storage_class() && { return std::move(storage_class_); }
   void set_storage_class(std::string value) {
     storage_class_ = std::move(value);
   }
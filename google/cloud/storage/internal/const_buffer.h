@@ -0,0 +1,96 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
+
+#include "google/cloud/storage/version.h"
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A borrowed, read-only view of a contiguous buffer.
+ *
+ * Upload payloads often live in application-owned buffer chains. Accepting a
+ * sequence of these views lets the library feed the data to the transport
+ * without first coalescing it into a single string, saving a full copy of the
+ * payload. The viewed memory is *not* owned: it must remain valid until the
+ * request using it completes.
+ */
+struct ConstBuffer {
+  ConstBuffer(char const* d, std::size_t s) : data(d), size(s) {}
+  explicit ConstBuffer(std::string const& s) : data(s.data()), size(s.size()) {}
+
+  char const* data;
+  std::size_t size;
+};
+
+inline bool operator==(ConstBuffer const& lhs, ConstBuffer const& rhs) {
+  return lhs.data == rhs.data && lhs.size == rhs.size;
+}
+
+inline bool operator!=(ConstBuffer const& lhs, ConstBuffer const& rhs) {
+  return !(lhs == rhs);
+}
+
+using ConstBufferSequence = std::vector<ConstBuffer>;
+
+/// Returns the total number of bytes viewed by @p s.
+inline std::size_t TotalBytes(ConstBufferSequence const& s) {
+  return std::accumulate(
+      s.begin(), s.end(), std::size_t{0},
+      [](std::size_t a, ConstBuffer const& b) { return a + b.size; });
+}
+
+/**
+ * Removes the first @p count bytes viewed by @p s.
+ *
+ * Only the views are adjusted, the viewed memory does not change. Removing
+ * more bytes than `TotalBytes(s)` empties the sequence.
+ */
+inline void PopFrontBytes(ConstBufferSequence& s, std::size_t count) {
+  auto i = s.begin();
+  for (; i != s.end() && i->size <= count; ++i) {
+    count -= i->size;
+  }
+  i = s.erase(s.begin(), i);
+  if (i != s.end()) {
+    i->data += count;
+    i->size -= count;
+  }
+}
+
+/// Copies the bytes viewed by @p s into a single string.
+inline std::string ToString(ConstBufferSequence const& s) {
+  std::string result;
+  result.reserve(TotalBytes(s));
+  for (auto const& b : s) {
+    result.append(b.data, b.size);
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
@@ -0,0 +1,49 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/const_buffer.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(ConstBufferTest, Basic) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  ConstBuffer buffer(contents);
+  EXPECT_EQ(contents.data(), buffer.data);
+  EXPECT_EQ(contents.size(), buffer.size);
+  EXPECT_EQ(buffer, ConstBuffer(contents.data(), contents.size()));
+  EXPECT_NE(buffer, ConstBuffer(contents.data(), contents.size() - 1));
+}
+
+TEST(ConstBufferTest, TotalBytes) {
+  std::string const b0 = "The quick brown fox";
+  std::string const b1 = " jumps over";
+  std::string const b2 = " the lazy dog";
+  EXPECT_EQ(0U, TotalBytes(ConstBufferSequence{}));
+  EXPECT_EQ(b0.size() + b1.size() + b2.size(),
+            TotalBytes(ConstBufferSequence{ConstBuffer(b0), ConstBuffer(b1),
+                                           ConstBuffer(b2)}));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,298 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
+#include <crc32c/crc32c.h>
+#include <cstring>
+
+// The hardware kernels need (a) a CRC32C instruction, and (b) a compiler
+// that can emit it in a single function without changing the flags for the
+// whole library. We only implement the combinations we can test.
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_X86 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::uint32_t Crc32cPortable(std::uint32_t crc, std::uint8_t const* data,
+                             std::size_t count) {
+  return crc32c::Extend(crc, data, count);
+}
+
+// Extending a CRC by a run of zero bytes is a linear operation over GF(2);
+// these helpers apply and compose such operators, represented as 32x32 bit
+// matrices. This is the well-known technique from Mark Adler's crc32c.c,
+// used both to merge the interleaved hardware chains below and to combine
+// shard checksums in `Crc32cCombine()`.
+
+std::uint32_t GF2MatrixTimes(std::uint32_t const* mat, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  while (vec != 0) {
+    if ((vec & 1) != 0) {
+      sum ^= *mat;
+    }
+    vec >>= 1;
+    ++mat;
+  }
+  return sum;
+}
+
+void GF2MatrixSquare(std::uint32_t* square, std::uint32_t const* mat) {
+  for (int n = 0; n != 32; ++n) {
+    square[n] = GF2MatrixTimes(mat, mat[n]);
+  }
+}
+
+#if defined(GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_X86) || \
+    defined(GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_ARM)
+
+// The CRC32C instruction consumes 8 bytes per issue but has a multi-cycle
+// latency, a single dependency chain leaves most of its throughput unused.
+// We run three independent chains over consecutive blocks and then merge
+// them, "extending" each chain's CRC by a block of zeros via the tables
+// below, which apply the zero-extension operator one byte of CRC at a time.
+
+/// Computes the operator that advances a CRC32C by @p count zero bytes.
+void Crc32cZerosOp(std::uint32_t* even, std::size_t count) {
+  std::uint32_t odd[32];
+  // The operator for a single zero bit: one shift, conditionally xor the
+  // (reflected) CRC32C polynomial.
+  odd[0] = 0x82f63b78U;
+  std::uint32_t row = 1;
+  for (int n = 1; n != 32; ++n) {
+    odd[n] = row;
+    row <<= 1;
+  }
+  // Square to get the one-byte and two-byte operators.
+  GF2MatrixSquare(even, odd);
+  GF2MatrixSquare(odd, even);
+  // Square until the operator covers `count` bytes. `count` is a power of
+  // two in this file, so the last squaring lands exactly.
+  for (;;) {
+    GF2MatrixSquare(even, odd);
+    count >>= 1;
+    if (count == 0) return;
+    GF2MatrixSquare(odd, even);
+    count >>= 1;
+    if (count == 0) {
+      std::memcpy(even, odd, sizeof(odd));
+      return;
+    }
+  }
+}
+
+/// Expands the zero-extension operator into byte-indexed tables.
+void Crc32cZerosTable(std::uint32_t (*zeros)[256], std::size_t count) {
+  std::uint32_t op[32];
+  Crc32cZerosOp(op, count);
+  for (std::uint32_t n = 0; n != 256; ++n) {
+    zeros[0][n] = GF2MatrixTimes(op, n);
+    zeros[1][n] = GF2MatrixTimes(op, n << 8);
+    zeros[2][n] = GF2MatrixTimes(op, n << 16);
+    zeros[3][n] = GF2MatrixTimes(op, n << 24);
+  }
+}
+
+std::uint32_t Crc32cShift(std::uint32_t const (*zeros)[256],
+                          std::uint32_t crc) {
+  return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff] ^
+         zeros[2][(crc >> 16) & 0xff] ^ zeros[3][crc >> 24];
+}
+
+// The block sizes for the interleaved chains. Large blocks amortize the
+// merge cost, the small blocks handle medium-sized buffers.
+std::size_t constexpr kLongBlock = 8192;
+std::size_t constexpr kShortBlock = 256;
+
+struct Crc32cShiftTables {
+  Crc32cShiftTables() {
+    Crc32cZerosTable(long_block, kLongBlock);
+    Crc32cZerosTable(short_block, kShortBlock);
+  }
+  std::uint32_t long_block[4][256];
+  std::uint32_t short_block[4][256];
+};
+
+#if defined(GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_X86)
+// Compile just these functions with SSE4.2 enabled, the rest of the library
+// keeps the default instruction set and we check for support at runtime.
+#define GOOGLE_CLOUD_CPP_STORAGE_CRC32C_TARGET \
+  __attribute__((target("sse4.2")))
+GOOGLE_CLOUD_CPP_STORAGE_CRC32C_TARGET
+inline std::uint64_t Crc32cU64(std::uint64_t crc, std::uint64_t v) {
+  return _mm_crc32_u64(crc, v);
+}
+GOOGLE_CLOUD_CPP_STORAGE_CRC32C_TARGET
+inline std::uint32_t Crc32cU8(std::uint32_t crc, std::uint8_t v) {
+  return _mm_crc32_u8(crc, v);
+}
+#else  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_ARM
+#define GOOGLE_CLOUD_CPP_STORAGE_CRC32C_TARGET
+inline std::uint64_t Crc32cU64(std::uint64_t crc, std::uint64_t v) {
+  return __crc32cd(static_cast<std::uint32_t>(crc), v);
+}
+inline std::uint32_t Crc32cU8(std::uint32_t crc, std::uint8_t v) {
+  return __crc32cb(crc, v);
+}
+#endif
+
+GOOGLE_CLOUD_CPP_STORAGE_CRC32C_TARGET
+std::uint32_t Crc32cHardware(std::uint32_t crc, std::uint8_t const* data,
+                             std::size_t count) {
+  static Crc32cShiftTables const tables;
+
+  auto load64 = [](std::uint8_t const* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  };
+
+  std::uint64_t crc0 = crc ^ 0xffffffffU;
+  // Consume bytes until the buffer is 8-byte aligned.
+  while (count != 0 &&
+         (reinterpret_cast<std::uintptr_t>(data) & 7) != 0) {
+    crc0 = Crc32cU8(static_cast<std::uint32_t>(crc0), *data++);
+    --count;
+  }
+
+  while (count >= 3 * kLongBlock) {
+    std::uint64_t crc1 = 0;
+    std::uint64_t crc2 = 0;
+    std::uint8_t const* end = data + kLongBlock;
+    do {
+      crc0 = Crc32cU64(crc0, load64(data));
+      crc1 = Crc32cU64(crc1, load64(data + kLongBlock));
+      crc2 = Crc32cU64(crc2, load64(data + 2 * kLongBlock));
+      data += 8;
+    } while (data < end);
+    crc0 = Crc32cShift(tables.long_block, static_cast<std::uint32_t>(crc0)) ^
+           crc1;
+    crc0 = Crc32cShift(tables.long_block, static_cast<std::uint32_t>(crc0)) ^
+           crc2;
+    data += 2 * kLongBlock;
+    count -= 3 * kLongBlock;
+  }
+
+  while (count >= 3 * kShortBlock) {
+    std::uint64_t crc1 = 0;
+    std::uint64_t crc2 = 0;
+    std::uint8_t const* end = data + kShortBlock;
+    do {
+      crc0 = Crc32cU64(crc0, load64(data));
+      crc1 = Crc32cU64(crc1, load64(data + kShortBlock));
+      crc2 = Crc32cU64(crc2, load64(data + 2 * kShortBlock));
+      data += 8;
+    } while (data < end);
+    crc0 = Crc32cShift(tables.short_block, static_cast<std::uint32_t>(crc0)) ^
+           crc1;
+    crc0 = Crc32cShift(tables.short_block, static_cast<std::uint32_t>(crc0)) ^
+           crc2;
+    data += 2 * kShortBlock;
+    count -= 3 * kShortBlock;
+  }
+
+  while (count >= 8) {
+    crc0 = Crc32cU64(crc0, load64(data));
+    data += 8;
+    count -= 8;
+  }
+  while (count != 0) {
+    crc0 = Crc32cU8(static_cast<std::uint32_t>(crc0), *data++);
+    --count;
+  }
+  return static_cast<std::uint32_t>(crc0) ^ 0xffffffffU;
+}
+
+#endif  // hardware kernels
+
+using Crc32cFunction = std::uint32_t (*)(std::uint32_t, std::uint8_t const*,
+                                         std::size_t);
+
+Crc32cFunction PickCrc32cFunction() {
+#if defined(GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_X86)
+  if (__builtin_cpu_supports("sse4.2")) {
+    return &Crc32cHardware;
+  }
+#elif defined(GOOGLE_CLOUD_CPP_STORAGE_HAVE_CRC32C_ARM)
+  // `__ARM_FEATURE_CRC32` means the whole program is compiled assuming the
+  // CRC extension exists, no runtime check is needed.
+  return &Crc32cHardware;
+#endif
+  return &Crc32cPortable;
+}
+
+}  // namespace
+
+std::uint32_t Crc32cExtend(std::uint32_t crc, std::uint8_t const* data,
+                           std::size_t count) {
+  static Crc32cFunction const crc32c_function = PickCrc32cFunction();
+  return crc32c_function(crc, data, count);
+}
+
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uint64_t b_count) {
+  if (b_count == 0) {
+    return crc_a;
+  }
+  // Build the operator for a single zero bit and square it twice: `even`
+  // then advances a CRC by half a zero byte, and the loop below starts by
+  // squaring it once more, to a full byte.
+  std::uint32_t even[32];
+  std::uint32_t odd[32];
+  odd[0] = 0x82f63b78U;  // The CRC32C polynomial, reflected.
+  std::uint32_t row = 1;
+  for (int n = 1; n != 32; ++n) {
+    odd[n] = row;
+    row <<= 1;
+  }
+  GF2MatrixSquare(even, odd);
+  GF2MatrixSquare(odd, even);
+  // Apply the zero-byte operator once per set bit of `b_count`, squaring
+  // it as the bits advance. The pre- and post-inversion of the CRCs cancel
+  // out, so the finalized values can be combined directly.
+  for (;;) {
+    GF2MatrixSquare(even, odd);
+    if ((b_count & 1) != 0) {
+      crc_a = GF2MatrixTimes(even, crc_a);
+    }
+    b_count >>= 1;
+    if (b_count == 0) {
+      break;
+    }
+    GF2MatrixSquare(odd, even);
+    if ((b_count & 1) != 0) {
+      crc_a = GF2MatrixTimes(odd, crc_a);
+    }
+    b_count >>= 1;
+    if (b_count == 0) {
+      break;
+    }
+  }
+  return crc_a ^ crc_b;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
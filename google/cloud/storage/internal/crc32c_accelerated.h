@@ -0,0 +1,61 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_ACCELERATED_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_ACCELERATED_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Computes the CRC32C of `[data, data + count)` starting from @p crc.
+ *
+ * This is a drop-in replacement for `crc32c::Extend()`. The checksum runs
+ * over every buffer of every transfer, so on CPUs with a CRC32C instruction
+ * (SSE4.2 on x86-64, the CRC extension on ARMv8) this uses the instruction
+ * directly, interleaving three independent streams to hide its latency. The
+ * implementation is picked once, at runtime, based on the CPU; other CPUs
+ * use the portable `crc32c` library.
+ */
+std::uint32_t Crc32cExtend(std::uint32_t crc, std::uint8_t const* data,
+                           std::size_t count);
+
+/**
+ * Computes the CRC32C of a concatenation from the checksums of its parts.
+ *
+ * Given the checksum of a buffer `A`, the checksum of a buffer `B`, and
+ * the size of `B`, this returns the checksum of `A` followed by `B`
+ * without reading either buffer. Extending a CRC is a linear operation
+ * over GF(2), so the checksum of `A` can be advanced over `b_count`
+ * (implicit) bytes in `O(log(b_count))` time and combined with the
+ * checksum of `B`. `ParallelUploadFile()` uses this to predict the
+ * checksum of a composed object from the checksums of its shards.
+ */
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uint64_t b_count);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_ACCELERATED_H
@@ -0,0 +1,129 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
+#include <gmock/gmock.h>
+#include <crc32c/crc32c.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::vector<std::uint8_t> MakeTestBuffer(std::size_t size) {
+  std::vector<std::uint8_t> buffer(size);
+  // A fixed, non-repeating-in-small-periods pattern is enough to exercise
+  // all the code paths, no need for a real PRNG.
+  std::uint32_t state = 0x5bd1e995U;
+  for (auto& b : buffer) {
+    state = state * 1664525U + 1013904223U;
+    b = static_cast<std::uint8_t>(state >> 24);
+  }
+  return buffer;
+}
+
+/// @test Verify the well-known CRC32C test vector.
+TEST(Crc32cAcceleratedTest, KnownVector) {
+  std::string const data = "123456789";
+  auto actual = Crc32cExtend(
+      0, reinterpret_cast<std::uint8_t const*>(data.data()), data.size());
+  EXPECT_EQ(0xe3069283U, actual);
+}
+
+/// @test Verify the result matches the portable library for many sizes.
+TEST(Crc32cAcceleratedTest, MatchesPortableLibrary) {
+  // The sizes cover the byte-at-a-time loops, the 8-byte loop, and both
+  // interleaved block sizes, including their boundaries.
+  std::size_t const sizes[] = {0,    1,    7,     8,        9,
+                               63,   255,  256,   3 * 256,  3 * 256 + 1,
+                               4096, 8192, 24576, 24576 + 17};
+  auto const buffer = MakeTestBuffer(3 * 8192 + 64);
+  for (auto size : sizes) {
+    auto expected = crc32c::Extend(0, buffer.data(), size);
+    EXPECT_EQ(expected, Crc32cExtend(0, buffer.data(), size))
+        << "size=" << size;
+  }
+}
+
+/// @test Verify unaligned buffers produce the same result.
+TEST(Crc32cAcceleratedTest, UnalignedBuffers) {
+  auto const buffer = MakeTestBuffer(3 * 8192 + 64);
+  for (std::size_t offset = 0; offset != 8; ++offset) {
+    auto size = buffer.size() - offset;
+    auto expected = crc32c::Extend(0, buffer.data() + offset, size);
+    EXPECT_EQ(expected, Crc32cExtend(0, buffer.data() + offset, size))
+        << "offset=" << offset;
+  }
+}
+
+/// @test Verify extending in chunks matches a single-shot computation.
+TEST(Crc32cAcceleratedTest, IncrementalExtend) {
+  auto const buffer = MakeTestBuffer(3 * 8192 + 64);
+  auto expected = crc32c::Extend(0, buffer.data(), buffer.size());
+  std::size_t const chunks[] = {1, 13, 256, 4096};
+  for (auto chunk : chunks) {
+    std::uint32_t actual = 0;
+    for (std::size_t pos = 0; pos < buffer.size(); pos += chunk) {
+      auto n = (std::min)(chunk, buffer.size() - pos);
+      actual = Crc32cExtend(actual, buffer.data() + pos, n);
+    }
+    EXPECT_EQ(expected, actual) << "chunk=" << chunk;
+  }
+}
+
+/// @test Verify combining checksums matches hashing the concatenation.
+TEST(Crc32cAcceleratedTest, CombineMatchesExtend) {
+  auto const buffer = MakeTestBuffer(8192 + 64);
+  // Split points cover empty parts, odd sizes, and sizes with several bits
+  // set, which exercises both halves of the squaring loop.
+  std::size_t const split_points[] = {0,   1,    7,    64,  255,
+                                      257, 4096, 5000, 8192, buffer.size()};
+  auto const expected = Crc32cExtend(0, buffer.data(), buffer.size());
+  for (auto split : split_points) {
+    auto crc_a = Crc32cExtend(0, buffer.data(), split);
+    auto crc_b = Crc32cExtend(0, buffer.data() + split, buffer.size() - split);
+    EXPECT_EQ(expected, Crc32cCombine(crc_a, crc_b, buffer.size() - split))
+        << "split=" << split;
+  }
+}
+
+/// @test Verify combining many parts in sequence, as compose does.
+TEST(Crc32cAcceleratedTest, CombineManyParts) {
+  auto const buffer = MakeTestBuffer(3 * 4096 + 129);
+  auto const expected = Crc32cExtend(0, buffer.data(), buffer.size());
+  std::size_t const chunks[] = {13, 4096, 8192};
+  for (auto chunk : chunks) {
+    std::uint32_t combined = 0;
+    bool first = true;
+    for (std::size_t pos = 0; pos < buffer.size(); pos += chunk) {
+      auto n = (std::min)(chunk, buffer.size() - pos);
+      auto part = Crc32cExtend(0, buffer.data() + pos, n);
+      combined = first ? part : Crc32cCombine(combined, part, n);
+      first = false;
+    }
+    EXPECT_EQ(expected, combined) << "chunk=" << chunk;
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
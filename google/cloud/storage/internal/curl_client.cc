@@ -19,6 +19,7 @@
 #include "google/cloud/storage/internal/curl_resumable_upload_session.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/upload_checkpoint.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/terminate_handler.h"
@@ -70,8 +71,7 @@ std::string XmlMapPredefinedAcl(std::string const& acl) {
 }
 
 std::string UrlEscapeString(std::string const& value) {
-  CurlHandle handle;
-  return std::string(handle.MakeEscapedString(value).get());
+  return UrlEscape(value);
 }
 
 template <typename ReturnType>
@@ -129,8 +129,9 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
   builder.SetMethod(method)
       .ApplyClientOptions(options_)
       .SetCurlShare(share_.get())
+      .SetResolveList(resolve_list_)
       .AddHeader(auth_header.value())
-      .AddHeader("x-goog-api-client: " + x_goog_api_client());
+      .AddHeader(x_goog_api_client_header_);
   return Status();
 }
 
@@ -147,6 +148,20 @@ void SetupBuilderUserIp(CurlRequestBuilder& builder, Request const& request) {
   }
 }
 
+template <typename Request>
+void SetupBuilderDefaultFields(CurlRequestBuilder& builder,
+                               ClientOptions const& options,
+                               Request const& request) {
+  // Applications can default all metadata-returning operations to a partial
+  // response expression, a `Fields` option on the request takes precedence.
+  if (options.default_fields().empty() ||
+      request.template HasOption<Fields>()) {
+    return;
+  }
+  builder.AddQueryParameter(Fields::well_known_parameter_name(),
+                            options.default_fields());
+}
+
 template <typename Request>
 Status CurlClient::SetupBuilder(CurlRequestBuilder& builder,
                                 Request const& request, char const* method) {
@@ -259,10 +274,15 @@ CurlClient::CurlClient(ClientOptions options)
     : options_(std::move(options)),
       share_(curl_share_init(), &curl_share_cleanup),
       generator_(google::cloud::internal::MakeDefaultPRNG()),
+      download_memory_budget_(std::make_shared<DownloadMemoryBudget>(
+          options_.maximum_download_buffer_memory())),
       storage_factory_(CreateHandleFactory(options_)),
       upload_factory_(CreateHandleFactory(options_)),
       xml_upload_factory_(CreateHandleFactory(options_)),
       xml_download_factory_(CreateHandleFactory(options_)) {
+  // The value is invariant for the lifetime of the client, rendering the
+  // header once saves a string concatenation on every request.
+  x_goog_api_client_header_ = "x-goog-api-client: " + x_goog_api_client();
   storage_endpoint_ = options_.endpoint() + "/storage/" + options_.version();
   upload_endpoint_ =
       options_.endpoint() + "/upload/storage/" + options_.version();
@@ -279,6 +299,14 @@ CurlClient::CurlClient(ClientOptions options)
     xml_download_endpoint_ = "https://storage-download.googleapis.com";
   }
 
+  if (options_.enable_endpoint_pre_resolution()) {
+    // Resolve the endpoints once and seed the results into each handle via
+    // CURLOPT_RESOLVE, requests then never block on name resolution.
+    resolve_list_ =
+        PreResolveEndpoints({storage_endpoint_, upload_endpoint_,
+                             xml_upload_endpoint_, xml_download_endpoint_});
+  }
+
   curl_share_setopt(share_.get(), CURLSHOPT_LOCKFUNC, CurlShareLockCallback);
   curl_share_setopt(share_.get(), CURLSHOPT_UNLOCKFUNC,
                     CurlShareUnlockCallback);
@@ -293,18 +321,41 @@ CurlClient::CurlClient(ClientOptions options)
   CurlInitializeOnce(options);
 }
 
+PoolStatistics CurlClient::pool_statistics() const {
+  PoolStatistics result = storage_factory_->statistics();
+  result += upload_factory_->statistics();
+  result += xml_upload_factory_->statistics();
+  result += xml_download_factory_->statistics();
+  return result;
+}
+
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
     UploadChunkRequest const& request) {
-  CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
+  return UploadChunk(request, nullptr);
+}
+
+StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
+    UploadChunkRequest const& request,
+    std::shared_ptr<CurlHandleFactory> const& factory) {
+  CurlRequestBuilder builder(request.upload_session_url(),
+                             factory ? factory : upload_factory_);
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
   }
+  if (factory) {
+    // A pinned session must not draw connections from (nor donate its
+    // connection to) the client-wide share, install the session's own
+    // share instead. That still reuses DNS results and TLS sessions
+    // across the chunks of this session.
+    builder.SetCurlShare(factory->share());
+  }
   builder.AddHeader(request.RangeHeader());
   builder.AddHeader("Content-Type: application/octet-stream");
   builder.AddHeader("Content-Length: " +
-                    std::to_string(request.payload().size()));
-  auto response = builder.BuildRequest().MakeRequest(request.payload());
+                    std::to_string(request.payload_size()));
+  auto response =
+      builder.BuildRequest().MakeUploadRequest(request.payload_buffers());
   if (!response.ok()) {
     return std::move(response).status();
   }
@@ -317,11 +368,22 @@ StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
 
 StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
     QueryResumableUploadRequest const& request) {
-  CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
+  return QueryResumableUpload(request, nullptr);
+}
+
+StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
+    QueryResumableUploadRequest const& request,
+    std::shared_ptr<CurlHandleFactory> const& factory) {
+  CurlRequestBuilder builder(request.upload_session_url(),
+                             factory ? factory : upload_factory_);
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
   }
+  if (factory) {
+    // See `UploadChunk()` for the rationale.
+    builder.SetCurlShare(factory->share());
+  }
   builder.AddHeader("Content-Range: bytes */*");
   builder.AddHeader("Content-Type: application/octet-stream");
   builder.AddHeader("Content-Length: 0");
@@ -336,6 +398,42 @@ StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
   return AsStatus(*response);
 }
 
+std::shared_ptr<CurlHandleFactory> CurlClient::CreateUploadSessionFactory()
+    const {
+  // A one-handle pool: the session reuses the same handle for every
+  // chunk, and its private connection cache keeps the connection alive
+  // between chunks.
+  return std::make_shared<PooledCurlHandleFactory>(
+      1, options_.channel_options());
+}
+
+StatusOr<std::vector<HttpResponse>> CurlClient::ExecuteBatch(
+    BatchRequestBuilder const& batch) {
+  if (batch.empty()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "batch requests require at least one operation");
+  }
+  CurlRequestBuilder builder(
+      options_.endpoint() + "/batch/storage/" + options_.version(),
+      storage_factory_);
+  auto status = SetupBuilderCommon(builder, "POST");
+  if (!status.ok()) {
+    return status;
+  }
+  auto boundary = PickBoundary();
+  auto payload = batch.BuildPayload(boundary);
+  builder.AddHeader("Content-Type: multipart/mixed; boundary=" + boundary);
+  builder.AddHeader("Content-Length: " + std::to_string(payload.size()));
+  auto response = builder.BuildRequest().MakeRequest(payload);
+  if (!response.ok()) {
+    return std::move(response).status();
+  }
+  if (response->status_code >= HttpStatusCode::kMinNotSuccess) {
+    return AsStatus(*response);
+  }
+  return ParseBatchResponse(*response);
+}
+
 StatusOr<ListBucketsResponse> CurlClient::ListBuckets(
     ListBucketsRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b", storage_factory_);
@@ -539,11 +637,17 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMedia(
   }
 
   // Unless the request uses a feature that disables it, prefer to use XML.
+  // The XML response carries no object metadata, so the application must
+  // either ask for no fields explicitly, or accept a minimal metadata
+  // object via `set_prefer_xml_data_operations()`.
+  bool const empty_fields = request.HasOption<Fields>() &&
+                            request.GetOption<Fields>().value().empty();
+  bool const xml_by_default = options_.prefer_xml_data_operations() &&
+                              !request.HasOption<Fields>();
   if (!request.HasOption<IfMetagenerationNotMatch>() &&
       !request.HasOption<IfGenerationNotMatch>() &&
       !request.HasOption<QuotaUser>() && !request.HasOption<UserIp>() &&
-      !request.HasOption<Projection>() && request.HasOption<Fields>() &&
-      request.GetOption<Fields>().value().empty()) {
+      !request.HasOption<Projection>() && (empty_fields || xml_by_default)) {
     return InsertObjectMediaXml(request);
   }
 
@@ -590,6 +694,7 @@ StatusOr<ObjectMetadata> CurlClient::GetObjectMetadata(
   if (!status.ok()) {
     return status;
   }
+  SetupBuilderDefaultFields(builder, options_, request);
   return CheckedFromString<ObjectMetadataParser>(
       builder.BuildRequest().MakeRequest(std::string{}));
 }
@@ -599,12 +704,29 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
   if (!request.HasOption<IfMetagenerationNotMatch>() &&
       !request.HasOption<IfGenerationNotMatch>() &&
       !request.HasOption<QuotaUser>() && !request.HasOption<UserIp>()) {
-    return ReadObjectXml(request);
+    return ReadObjectXml(request, xml_download_factory_);
+  }
+  return ReadObjectJson(request, storage_factory_);
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
+    ReadObjectRangeRequest const& request,
+    std::shared_ptr<CurlHandleFactory> factory) {
+  if (!request.HasOption<IfMetagenerationNotMatch>() &&
+      !request.HasOption<IfGenerationNotMatch>() &&
+      !request.HasOption<QuotaUser>() && !request.HasOption<UserIp>()) {
+    return ReadObjectXml(request, std::move(factory));
   }
+  return ReadObjectJson(request, std::move(factory));
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectJson(
+    ReadObjectRangeRequest const& request,
+    std::shared_ptr<CurlHandleFactory> factory) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             std::move(factory));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -617,6 +739,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
+  builder.SetDownloadMemoryBudget(download_memory_budget_);
   return std::unique_ptr<ObjectReadSource>(
       new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
 }
@@ -733,6 +856,18 @@ CurlClient::CreateResumableSession(ResumableUploadRequest const& request) {
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
 CurlClient::RestoreResumableSession(std::string const& session_id) {
+  if (IsUploadCheckpoint(session_id)) {
+    // The checkpoint stores the committed byte count, there is no need to
+    // query the service before resuming the upload.
+    auto chk = ParseUploadCheckpoint(session_id);
+    if (!chk) {
+      return std::move(chk).status();
+    }
+    return std::unique_ptr<ResumableUploadSession>(
+        google::cloud::internal::make_unique<CurlResumableUploadSession>(
+            shared_from_this(), std::move(chk->session_id),
+            chk->next_expected_byte));
+  }
   auto session =
       google::cloud::internal::make_unique<CurlResumableUploadSession>(
           shared_from_this(), session_id);
@@ -1318,8 +1453,9 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
   // UserIp cannot be set, checked by the caller.
 
   builder.AddHeader("Content-Length: " +
-                    std::to_string(request.contents().size()));
-  auto response = builder.BuildRequest().MakeRequest(request.contents());
+                    std::to_string(request.contents_size()));
+  auto response =
+      builder.BuildRequest().MakeUploadRequest(request.contents_buffers());
   if (!response.ok()) {
     return std::move(response).status();
   }
@@ -1333,11 +1469,12 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
-    ReadObjectRangeRequest const& request) {
+    ReadObjectRangeRequest const& request,
+    std::shared_ptr<CurlHandleFactory> factory) {
   CurlRequestBuilder builder(xml_download_endpoint_ + "/" +
                                  request.bucket_name() + "/" +
                                  UrlEscapeString(request.object_name()),
-                             xml_download_factory_);
+                             std::move(factory));
   auto status = SetupBuilderCommon(builder, "GET");
   if (!status.ok()) {
     return status;
@@ -1381,6 +1518,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
+  builder.SetDownloadMemoryBudget(download_memory_budget_);
   return std::unique_ptr<ObjectReadSource>(
       new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
 }
@@ -1397,16 +1535,20 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   if (!status.ok()) {
     return status;
   }
+  SetupBuilderDefaultFields(builder, options_, request);
 
-  // 2. Pick a separator that does not conflict with the request contents.
-  auto boundary = PickBoundary(request.contents());
+  // 2. Pick a separator, long enough that it cannot (realistically) appear
+  //    in the request contents.
+  auto boundary = PickBoundary();
   builder.AddHeader("content-type: multipart/related; boundary=" + boundary);
   builder.AddQueryParameter("uploadType", "multipart");
   builder.AddQueryParameter("name", request.object_name());
 
-  // 3. Perform a streaming upload because computing the size upfront is more
-  //    complicated than it is worth.
-  std::ostringstream writer;
+  // 3. Stage the multipart framing in a recycled buffer. The media itself is
+  //    *not* copied into the buffer, `MakeUploadRequest()` streams it from a
+  //    borrowed view, so only the (small) framing is staged here.
+  auto writer = scratch_pool_.Acquire();
+  writer->clear();
 
   nl::json metadata = nl::json::object();
   if (request.HasOption<WithObjectMetadata>()) {
@@ -1429,46 +1571,59 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   std::string marker = "--" + boundary;
 
   // 4. Format the first part, including the separators and the headers.
-  writer << marker << crlf << "content-type: application/json; charset=UTF-8"
-         << crlf << crlf << metadata.dump() << crlf << marker << crlf;
-
-  // 5. Format the second part, which includes all the contents and a final
-  //    separator.
+  auto metadata_text = metadata.dump();
+  writer->reserve(marker.size() * 3 + metadata_text.size() + 128);
+  writer->append(marker)
+      .append(crlf)
+      .append("content-type: application/json; charset=UTF-8")
+      .append(crlf)
+      .append(crlf)
+      .append(metadata_text)
+      .append(crlf)
+      .append(marker)
+      .append(crlf);
+
+  // 5. Format the headers for the second part. The contents are streamed
+  //    from `request.contents()` directly, without copying them into the
+  //    staged buffer.
   if (request.HasOption<ContentType>()) {
-    writer << "content-type: " << request.GetOption<ContentType>().value()
-           << crlf;
+    writer->append("content-type: ")
+        .append(request.GetOption<ContentType>().value())
+        .append(crlf);
   } else if (metadata.count("contentType") != 0) {
-    writer << "content-type: "
-           << metadata.value("contentType", "application/octet-stream") << crlf;
+    writer->append("content-type: ")
+        .append(metadata.value("contentType", "application/octet-stream"))
+        .append(crlf);
   } else {
-    writer << "content-type: application/octet-stream" << crlf;
-  }
-  writer << crlf << request.contents() << crlf << marker << "--" << crlf;
-
-  // 6. Return the results as usual.
-  auto contents = std::move(writer).str();
-  builder.AddHeader("Content-Length: " + std::to_string(contents.size()));
+    writer->append("content-type: application/octet-stream").append(crlf);
+  }
+  writer->append(crlf);
+  auto const preamble_size = writer->size();
+  writer->append(crlf).append(marker).append("--").append(crlf);
+
+  // 6. Return the results as usual. Note that the buffer views are taken
+  //    only after the staged buffer stops growing.
+  ConstBufferSequence payload{
+      ConstBuffer(writer->data(), preamble_size),
+      ConstBuffer(request.contents()),
+      ConstBuffer(writer->data() + preamble_size,
+                  writer->size() - preamble_size)};
+  builder.AddHeader("Content-Length: " + std::to_string(TotalBytes(payload)));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(contents));
+      builder.BuildRequest().MakeUploadRequest(std::move(payload)));
 }
 
-std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
-  // We need to find a string that is *not* found in `text_to_avoid`, we pick
-  // a string at random, and see if it is in `text_to_avoid`, if it is, we grow
-  // the string with random characters and start from where we last found a
-  // the candidate.  Eventually we will find something, though it might be
-  // larger than `text_to_avoid`.  And we only make (approximately) one pass
-  // over `text_to_avoid`.
+std::string CurlClient::PickBoundary() {
+  // The boundary is long enough that a collision with the payload is not a
+  // realistic concern (see `GenerateMessageBoundary()` for the math), so
+  // there is no need to scan the payload for it.
   auto generate_candidate = [this](int n) {
     static std::string const kChars =
         "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
     std::unique_lock<std::mutex> lk(mu_);
     return google::cloud::internal::Sample(generator_, n, kChars);
   };
-  constexpr int kCandidateInitialSize = 16;
-  constexpr int kCandidateGrowthSize = 4;
-  return GenerateMessageBoundary(text_to_avoid, std::move(generate_candidate),
-                                 kCandidateInitialSize, kCandidateGrowthSize);
+  return GenerateMessageBoundary(std::move(generate_candidate));
 }
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
@@ -1479,6 +1634,7 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
   if (!status.ok()) {
     return status;
   }
+  SetupBuilderDefaultFields(builder, options_, request);
   // Set the content type of a sensible value, the application can override this
   // in the options for the request.
   if (!request.HasOption<ContentType>()) {
@@ -1487,9 +1643,9 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
   builder.AddQueryParameter("uploadType", "media");
   builder.AddQueryParameter("name", request.object_name());
   builder.AddHeader("Content-Length: " +
-                    std::to_string(request.contents().size()));
+                    std::to_string(request.contents_size()));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(request.contents()));
+      builder.BuildRequest().MakeUploadRequest(request.contents_buffers()));
 }
 
 }  // namespace internal
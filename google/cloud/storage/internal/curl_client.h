@@ -16,8 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H
 
 #include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/batch_request.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/download_memory_budget.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/recycling_pool.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
@@ -65,10 +68,51 @@ class CurlClient : public RawClient,
       UploadChunkRequest const&);
   virtual StatusOr<ResumableUploadResponse> QueryResumableUpload(
       QueryResumableUploadRequest const&);
+
+  /**
+   * As above, but issue the request through @p factory.
+   *
+   * `CurlResumableUploadSession` pins each session to its own handle
+   * factory, so all the chunks of one upload ride the same warm
+   * connection, see `CreateUploadSessionFactory()`. A `nullptr` factory
+   * uses the shared upload pool.
+   */
+  virtual StatusOr<ResumableUploadResponse> UploadChunk(
+      UploadChunkRequest const&,
+      std::shared_ptr<CurlHandleFactory> const& factory);
+  virtual StatusOr<ResumableUploadResponse> QueryResumableUpload(
+      QueryResumableUploadRequest const&,
+      std::shared_ptr<CurlHandleFactory> const& factory);
+
+  /**
+   * Creates a handle factory to pin one upload session to one connection.
+   *
+   * The factory holds a single handle, reusing it for every chunk of the
+   * session keeps the connection (and its fully opened congestion
+   * window) warm for the lifetime of the upload. Requests through this
+   * factory must not join the client-wide `CURLSH*`, its shared
+   * connection cache would hand the session whichever connection is
+   * idle.
+   */
+  std::shared_ptr<CurlHandleFactory> CreateUploadSessionFactory() const;
   //@}
 
+  /**
+   * Executes a batch of metadata operations in a single HTTP request.
+   *
+   * The returned responses are in the same order as the operations were added
+   * to @p batch. Note that individual operations may fail even though the
+   * batch itself succeeded. This is virtual only to override it in the unit
+   * tests.
+   */
+  virtual StatusOr<std::vector<HttpResponse>> ExecuteBatch(
+      BatchRequestBuilder const& batch);
+
   ClientOptions const& client_options() const override { return options_; }
 
+  /// Aggregates the counters from all the connection pools in this client.
+  PoolStatistics pool_statistics() const override;
+
   StatusOr<ListBucketsResponse> ListBuckets(
       ListBucketsRequest const& request) override;
   StatusOr<BucketMetadata> CreateBucket(
@@ -99,6 +143,15 @@ class CurlClient : public RawClient,
       GetObjectMetadataRequest const& request) override;
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
+  /**
+   * Like `ReadObject()`, but issues the download through @p factory.
+   *
+   * Used by `ObjectReadSession` to reuse a dedicated connection when an
+   * application performs many range reads against the same object.
+   */
+  StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
+      ReadObjectRangeRequest const& request,
+      std::shared_ptr<CurlHandleFactory> factory);
   StatusOr<ListObjectsResponse> ListObjects(
       ListObjectsRequest const& request) override;
   StatusOr<EmptyResponse> DeleteObject(
@@ -197,12 +250,16 @@ class CurlClient : public RawClient,
   StatusOr<ObjectMetadata> InsertObjectMediaXml(
       InsertObjectMediaRequest const& request);
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectXml(
-      ReadObjectRangeRequest const& request);
+      ReadObjectRangeRequest const& request,
+      std::shared_ptr<CurlHandleFactory> factory);
+  StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectJson(
+      ReadObjectRangeRequest const& request,
+      std::shared_ptr<CurlHandleFactory> factory);
 
   /// Insert an object using uploadType=multipart.
   StatusOr<ObjectMetadata> InsertObjectMediaMultipart(
       InsertObjectMediaRequest const& request);
-  std::string PickBoundary(std::string const& text_to_avoid);
+  std::string PickBoundary();
 
   /// Insert an object using uploadType=media.
   StatusOr<ObjectMetadata> InsertObjectMediaSimple(
@@ -213,6 +270,7 @@ class CurlClient : public RawClient,
   CreateResumableSessionGeneric(RequestType const& request);
 
   ClientOptions options_;
+  std::string x_goog_api_client_header_;
   std::string storage_endpoint_;
   std::string upload_endpoint_;
   std::string xml_upload_endpoint_;
@@ -229,6 +287,17 @@ class CurlClient : public RawClient,
 
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;  // GUARDED_BY(mu_);
+  // Recycled staging buffers for multipart uploads, they grow to the size of
+  // the payload and reusing them avoids reallocation on the upload hot path.
+  RecyclingPool<std::string> scratch_pool_;
+
+  // Caps the aggregate buffer memory used by this client's active downloads,
+  // each `CurlDownloadRequest` charges its buffers against this budget.
+  std::shared_ptr<DownloadMemoryBudget> download_memory_budget_;
+
+  // The endpoints pre-resolved at construction (when enabled), every request
+  // seeds these entries into libcurl's DNS cache instead of resolving.
+  CurlResolveList resolve_list_;
 
   // The factories must be listed *after* the CurlShare. libcurl keeps a
   // usage count on each CURLSH* handle, which is only released once the CURL*
@@ -51,12 +51,12 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
                  << ", buffer_offset_=" << buffer_offset_                   \
                  << ", spill_.size()=" << spill_.size()                     \
                  << ", spill_offset_=" << spill_offset_                     \
+                 << ", spill_read_offset_=" << spill_read_offset_           \
                  << ", closing=" << closing_ << ", closed=" << curl_closed_ \
                  << ", paused=" << paused_ << ", in_multi=" << in_multi_
 
 CurlDownloadRequest::CurlDownloadRequest()
-    : headers_(nullptr, &curl_slist_free_all),
-      download_stall_timeout_(0),
+    : download_stall_timeout_(0),
       multi_(nullptr, &curl_multi_cleanup),
       spill_(CURL_MAX_WRITE_SIZE) {}
 
@@ -150,7 +150,12 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
   handle_.FlushDebug(__func__);
   TRACE_STATE();
 
-  if (!curl_closed_) {
+  // Resume a paused transfer only when the staged data has dropped below the
+  // low watermark (or the application buffer still has room). Serving reads
+  // from the spill buffer while it remains above the low watermark avoids
+  // pause/unpause churn on every `Read()` call.
+  if (!curl_closed_ && (spill_offset_ - spill_read_offset_ < low_watermark_ ||
+                        buffer_offset_ < buffer_size_)) {
     auto status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
     if (!status.ok()) {
       TRACE_STATE() << ", status=" << status;
@@ -168,6 +173,8 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
   }
   TRACE_STATE();
   auto bytes_read = buffer_offset_;
+  total_downloaded_bytes_ += bytes_read;
+  GrowTransferBuffer();
   buffer_ = nullptr;
   buffer_offset_ = 0;
   buffer_size_ = 0;
@@ -202,14 +209,47 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
 void CurlDownloadRequest::SetOptions() {
   // We get better performance using a slightly larger buffer (128KiB) than the
   // default buffer size set by libcurl (16KiB)
-  auto constexpr kDefaultBufferSize = 128 * 1024L;
+  auto constexpr kDefaultBufferSize = std::size_t(128 * 1024);
+
+  current_buffer_size_ =
+      transfer_buffer_size_ == 0 ? kDefaultBufferSize : transfer_buffer_size_;
+
+  // Resolve the spill buffer watermarks. The defaults let the transfer stage
+  // one receive buffer's worth of data while the application is not reading,
+  // the spill buffer never shrinks below one minimal libcurl block.
+  auto constexpr kMinimumBufferSize = std::size_t(CURL_MAX_WRITE_SIZE);
+  if (high_watermark_ == 0) {
+    high_watermark_ = current_buffer_size_;
+  }
+  high_watermark_ = (std::max)(high_watermark_, kMinimumBufferSize);
+  if (low_watermark_ == 0 || low_watermark_ > high_watermark_) {
+    low_watermark_ = high_watermark_ / 2;
+  }
+  if (memory_budget_) {
+    auto const preferred = current_buffer_size_ + high_watermark_;
+    budgeted_bytes_ =
+        memory_budget_->Acquire(preferred, 2 * kMinimumBufferSize);
+    if (budgeted_bytes_ < preferred) {
+      // The client-wide cap has been reached, run this download with the
+      // smallest configuration that still makes progress.
+      current_buffer_size_ = kMinimumBufferSize;
+      high_watermark_ = kMinimumBufferSize;
+      low_watermark_ = high_watermark_ / 2;
+    }
+  }
+  if (high_watermark_ > spill_.size()) {
+    spill_.resize(high_watermark_);
+  }
 
   handle_.SetOption(CURLOPT_URL, url_.c_str());
-  handle_.SetOption(CURLOPT_HTTPHEADER, headers_.get());
+  handle_.SetOption(CURLOPT_HTTPHEADER,
+                    header_arena_ ? header_arena_->list() : nullptr);
   handle_.SetOption(CURLOPT_USERAGENT, user_agent_.c_str());
-  handle_.SetOption(CURLOPT_NOSIGNAL, 1L);
+  // CURLOPT_NOSIGNAL is applied by the handle factories, every handle
+  // carries it already.
   handle_.SetOption(CURLOPT_NOPROGRESS, 1L);
-  handle_.SetOption(CURLOPT_BUFFERSIZE, kDefaultBufferSize);
+  // NOLINTNEXTLINE(google-runtime-int) - libcurl *requires* `long`
+  handle_.SetOption(CURLOPT_BUFFERSIZE, static_cast<long>(current_buffer_size_));
   if (!payload_.empty()) {
     handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload_.length());
     handle_.SetOption(CURLOPT_POSTFIELDS, payload_.c_str());
@@ -228,6 +268,17 @@ void CurlDownloadRequest::SetOptions() {
   if (in_multi_) {
     return;
   }
+#if LIBCURL_VERSION_NUM >= 0x072b00  // CURLMOPT_PIPELINING multiplex: 7.43.0
+  if (http2_multiplexing_enabled_) {
+    // Allow libcurl to multiplex this transfer with other transfers over a
+    // single HTTP/2 connection. The connection cache is shared across handles
+    // via the CURLSH* interface, so limiting the connections per host makes
+    // libcurl prefer multiplexing over opening new connections.
+    curl_multi_setopt(multi_.get(), CURLMOPT_PIPELINING,
+                      CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi_.get(), CURLMOPT_MAX_HOST_CONNECTIONS, 1L);
+  }
+#endif  // LIBCURL_VERSION_NUM
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
   if (error != CURLM_OK) {
     // This indicates that we are using the API incorrectly, the application
@@ -238,14 +289,59 @@ void CurlDownloadRequest::SetOptions() {
   in_multi_ = true;
 }
 
+void CurlDownloadRequest::GrowTransferBuffer() {
+#if LIBCURL_VERSION_NUM >= 0x073500  // resizing requires 7.53.0
+  // libcurl caps CURLOPT_BUFFERSIZE at CURL_MAX_READ_SIZE (512 KiB), going
+  // beyond that value has no effect.
+  auto constexpr kMaxAdaptiveBufferSize = std::size_t(512 * 1024);
+  if (!adaptive_buffer_size_enabled_ || curl_closed_ ||
+      current_buffer_size_ >= kMaxAdaptiveBufferSize) {
+    return;
+  }
+  // Only grow once the download proves to be long-running relative to the
+  // current buffer size, short downloads keep a small footprint.
+  if (total_downloaded_bytes_ < 16 * current_buffer_size_) {
+    return;
+  }
+  auto const new_buffer_size =
+      (std::min)(2 * current_buffer_size_, kMaxAdaptiveBufferSize);
+  // Growing the receive buffer also grows the spill buffer, it should keep
+  // holding one full libcurl block past the application buffer. Skip the
+  // growth when the client-wide budget cannot absorb the increase.
+  auto const new_high_watermark = (std::max)(high_watermark_, new_buffer_size);
+  auto const delta = (new_buffer_size - current_buffer_size_) +
+                     (new_high_watermark - high_watermark_);
+  if (memory_budget_) {
+    if (!memory_budget_->TryAcquire(delta)) {
+      return;
+    }
+    budgeted_bytes_ += delta;
+  }
+  current_buffer_size_ = new_buffer_size;
+  high_watermark_ = new_high_watermark;
+  if (high_watermark_ > spill_.size()) {
+    spill_.resize(high_watermark_);
+  }
+  // NOLINTNEXTLINE(google-runtime-int) - libcurl *requires* `long`
+  handle_.SetOption(CURLOPT_BUFFERSIZE, static_cast<long>(current_buffer_size_));
+#endif  // LIBCURL_VERSION_NUM
+}
+
 void CurlDownloadRequest::DrainSpillBuffer() {
   std::size_t free = buffer_size_ - buffer_offset_;
-  auto copy_count = (std::min)(free, spill_offset_);
-  std::memcpy(buffer_ + buffer_offset_, spill_.data(), copy_count);
+  auto copy_count = (std::min)(free, spill_offset_ - spill_read_offset_);
+  std::memcpy(buffer_ + buffer_offset_, spill_.data() + spill_read_offset_,
+              copy_count);
   buffer_offset_ += copy_count;
-  std::memmove(spill_.data(), spill_.data() + copy_count,
-               spill_.size() - copy_count);
-  spill_offset_ -= copy_count;
+  spill_read_offset_ += copy_count;
+  // Once fully drained reset the offsets, the next spill starts at zero. Note
+  // that there is no need to compact (memmove) the remaining data here: the
+  // write callback compacts the buffer itself, and only when a new block
+  // would not fit in the space past `spill_offset_`.
+  if (spill_read_offset_ == spill_offset_) {
+    spill_read_offset_ = 0;
+    spill_offset_ = 0;
+  }
 }
 
 std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
@@ -260,37 +356,46 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
     TRACE_STATE() << " closing";
     return 0;
   }
-  if (buffer_offset_ >= buffer_size_) {
-    TRACE_STATE() << " *** PAUSING HANDLE ***";
-    paused_ = true;
-    return CURL_READFUNC_PAUSE;
-  }
+  std::size_t const n = size * nmemb;
 
   // Use the spill buffer first, if there is any...
   DrainSpillBuffer();
   std::size_t free = buffer_size_ - buffer_offset_;
-  if (free == 0) {
+  std::size_t spill_fill = spill_offset_ - spill_read_offset_;
+  // Pause the transfer, without consuming the block, when the application
+  // buffer is full and the staged data has reached the high watermark, or
+  // when the block simply does not fit. libcurl redelivers the block after
+  // the transfer is unpaused in `Read()`.
+  if ((free == 0 && spill_fill >= high_watermark_) ||
+      n > free + (spill_.size() - spill_fill)) {
     TRACE_STATE() << " *** PAUSING HANDLE ***";
     paused_ = true;
     return CURL_READFUNC_PAUSE;
   }
-  TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
+  TRACE_STATE() << ", n=" << n << ", free=" << free;
 
-  // Copy the full contents of `ptr` into the application buffer.
-  if (size * nmemb < free) {
-    std::memcpy(buffer_ + buffer_offset_, ptr, size * nmemb);
-    buffer_offset_ += size * nmemb;
-    TRACE_STATE() << ", n=" << size * nmemb;
-    return size * nmemb;
-  }
   // Copy as much as possible from `ptr` into the application buffer.
-  std::memcpy(buffer_ + buffer_offset_, ptr, free);
-  buffer_offset_ += free;
-  spill_offset_ = size * nmemb - free;
-  // The rest goes into the spill buffer.
-  std::memcpy(spill_.data(), static_cast<char*>(ptr) + free, spill_offset_);
-  TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
-  return size * nmemb;
+  auto const copied = (std::min)(free, n);
+  std::memcpy(buffer_ + buffer_offset_, ptr, copied);
+  buffer_offset_ += copied;
+  if (copied == n) {
+    TRACE_STATE() << ", n=" << n;
+    return n;
+  }
+  // The rest is staged in the spill buffer. Compact the buffer first if the
+  // staged data has accumulated towards its end, the check above guarantees
+  // the block fits after compacting.
+  if (spill_.size() - spill_offset_ < n - copied) {
+    std::memmove(spill_.data(), spill_.data() + spill_read_offset_,
+                 spill_fill);
+    spill_read_offset_ = 0;
+    spill_offset_ = spill_fill;
+  }
+  std::memcpy(spill_.data() + spill_offset_,
+              static_cast<char const*>(ptr) + copied, n - copied);
+  spill_offset_ += n - copied;
+  TRACE_STATE() << ", n=" << n << ", free=" << free;
+  return n;
 }
 
 std::size_t CurlDownloadRequest::HeaderCallback(char* contents,
@@ -15,10 +15,13 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 
+#include "google/cloud/storage/internal/curl_header_arena.h"
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/internal/download_memory_budget.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
 #include "google/cloud/storage/version.h"
+#include <cstdint>
 
 namespace google {
 namespace cloud {
@@ -47,6 +50,9 @@ class CurlDownloadRequest : public ObjectReadSource {
   explicit CurlDownloadRequest();
 
   ~CurlDownloadRequest() override {
+    if (memory_budget_) {
+      memory_budget_->Release(budgeted_bytes_);
+    }
     if (!factory_) {
       return;
     }
@@ -86,6 +92,9 @@ class CurlDownloadRequest : public ObjectReadSource {
   /// Copy any available data from the spill buffer to `buffer_`
   void DrainSpillBuffer();
 
+  /// Grow the libcurl receive buffer for long-running downloads.
+  void GrowTransferBuffer();
+
   /// Called by libcurl to show that more data is available in the download.
   std::size_t WriteCallback(void* ptr, std::size_t size, std::size_t nmemb);
 
@@ -106,11 +115,31 @@ class CurlDownloadRequest : public ObjectReadSource {
   static Status AsStatus(CURLMcode result, char const* where);
 
   std::string url_;
-  CurlHeaders headers_;
+  std::shared_ptr<CurlHeaderArena> header_arena_;
   std::string payload_;
   std::string user_agent_;
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_ = false;
+  bool http2_multiplexing_enabled_ = false;
+  std::size_t transfer_buffer_size_ = 0;
+  bool adaptive_buffer_size_enabled_ = false;
+  // The current libcurl receive buffer size, and the total bytes returned to
+  // the application, used to grow the buffer on long-running downloads.
+  std::size_t current_buffer_size_ = 0;
+  std::uint64_t total_downloaded_bytes_ = 0;
+  // Watermarks on the data staged in the spill buffer. The transfer pauses
+  // when the staged data reaches `high_watermark_` and resumes once the
+  // application drains it below `low_watermark_`. The values are resolved
+  // from the client options in `SetOptions()`.
+  std::size_t low_watermark_ = 0;
+  std::size_t high_watermark_ = 0;
+  // The client-wide budget (if any) charged for this download's buffers, and
+  // the number of bytes charged, released in the destructor.
+  std::shared_ptr<DownloadMemoryBudget> memory_budget_;
+  std::size_t budgeted_bytes_ = 0;
+  // Pins the `CURLOPT_RESOLVE` list (if any) for the lifetime of the
+  // download, libcurl does not copy the list.
+  CurlResolveList resolve_list_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
   CurlHandle handle_;
@@ -145,13 +174,21 @@ class CurlDownloadRequest : public ObjectReadSource {
   std::size_t buffer_size_ = 0;
   std::size_t buffer_offset_ = 0;
 
-  // libcurl(1) will never pass a block larger than CURL_MAX_WRITE_SIZE to the
-  // WriteCallback. However, the callback *must* save all the bytes, returning
-  // less bytes read aborts the download (we do that on a Close(), but in
-  // general we do not). The application may have requested less bytes in the
-  // call to `Read()`, so we need a place to store the additional bytes.
+  // libcurl(1) passes blocks of up to CURLOPT_BUFFERSIZE bytes to the
+  // WriteCallback. The application may have requested less bytes in the call
+  // to `Read()`, so we need a place to store the additional bytes: the
+  // callback cannot return a short count without aborting the download, its
+  // only alternatives are to save all the bytes or to pause the transfer.
+  // The spill buffer stages such bytes up to `high_watermark_`, blocks that
+  // do not fit pause the transfer and are redelivered by libcurl after the
+  // application drains the staged data.
   std::vector<char> spill_;
+  // The range [spill_read_offset_, spill_offset_) contains data received from
+  // libcurl but not yet returned to the application. Draining the buffer
+  // advances `spill_read_offset_` instead of compacting the buffer, saving a
+  // `memmove()` of the staged bytes on each `Read()` call.
   std::size_t spill_offset_ = 0;
+  std::size_t spill_read_offset_ = 0;
 };
 
 }  // namespace internal
@@ -363,6 +363,50 @@ void CurlHandle::ThrowSetOptionError(CURLcode e, CURLoption opt, void* param) {
   google::cloud::internal::ThrowRuntimeError(os.str());
 }
 
+namespace {
+// True for the RFC 3986 unreserved characters, the exact set that
+// `curl_easy_escape()` leaves unchanged.
+bool IsUnreservedChar(unsigned char c) {
+  if (c >= 'A' && c <= 'Z') return true;
+  if (c >= 'a' && c <= 'z') return true;
+  if (c >= '0' && c <= '9') return true;
+  return c == '-' || c == '.' || c == '_' || c == '~';
+}
+}  // namespace
+
+void AppendUrlEscaped(std::string& output, std::string const& value) {
+  static constexpr char kHexDigits[] = "0123456789ABCDEF";
+  auto const* data = value.data();
+  auto const size = value.size();
+  std::size_t run_start = 0;
+  for (std::size_t i = 0; i != size; ++i) {
+    auto const c = static_cast<unsigned char>(data[i]);
+    if (IsUnreservedChar(c)) continue;
+    output.append(data + run_start, data + i);
+    output.push_back('%');
+    output.push_back(kHexDigits[c >> 4]);
+    output.push_back(kHexDigits[c & 0xf]);
+    run_start = i + 1;
+  }
+  output.append(data + run_start, data + size);
+}
+
+std::string UrlEscape(std::string const& value) {
+  auto needs_escaping = [&value] {
+    for (char c : value) {
+      if (!IsUnreservedChar(static_cast<unsigned char>(c))) return true;
+    }
+    return false;
+  };
+  if (!needs_escaping()) {
+    return value;
+  }
+  std::string result;
+  result.reserve(value.size() + 8);
+  AppendUrlEscaped(result, value);
+  return result;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
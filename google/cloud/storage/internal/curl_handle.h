@@ -126,6 +126,21 @@ class CurlHandle {
   SocketOptions socket_options_;
 };
 
+/**
+ * Appends @p value, URL-escaped, to @p output.
+ *
+ * Produces the same escaping as `curl_easy_escape()` (every byte outside
+ * the RFC 3986 unreserved set becomes `%XX`), but without creating a curl
+ * handle or allocating a buffer per call: unreserved runs are copied in
+ * bulk into @p output. Most requests escape three to five short strings
+ * (bucket, object, query values), the per-call overhead of the curl escaper
+ * dominated its cost.
+ */
+void AppendUrlEscaped(std::string& output, std::string const& value);
+
+/// URL-escapes @p value, returning it unchanged when nothing needs escaping.
+std::string UrlEscape(std::string const& value);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -22,6 +23,39 @@ namespace internal {
 std::once_flag default_curl_handle_factory_initialized;
 std::shared_ptr<CurlHandleFactory> default_curl_handle_factory;
 
+namespace {
+extern "C" void CurlHandleFactoryShareLock(CURL*, curl_lock_data,
+                                           curl_lock_access, void* userptr) {
+  reinterpret_cast<std::mutex*>(userptr)->lock();
+}
+
+extern "C" void CurlHandleFactoryShareUnlock(CURL*, curl_lock_data,
+                                             void* userptr) {
+  reinterpret_cast<std::mutex*>(userptr)->unlock();
+}
+}  // namespace
+
+CurlHandleFactory::CurlHandleFactory()
+    : share_(curl_share_init(), &curl_share_cleanup) {
+  curl_share_setopt(share_.get(), CURLSHOPT_LOCKFUNC,
+                    CurlHandleFactoryShareLock);
+  curl_share_setopt(share_.get(), CURLSHOPT_UNLOCKFUNC,
+                    CurlHandleFactoryShareUnlock);
+  curl_share_setopt(share_.get(), CURLSHOPT_USERDATA, &share_mu_);
+  curl_share_setopt(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  // Share TLS session tickets too, so new connections resume the sessions
+  // established by earlier ones instead of paying for a full handshake.
+  curl_share_setopt(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+void CurlHandleFactory::SetShare(CURL* handle) {
+  curl_easy_setopt(handle, CURLOPT_SHARE, share_.get());
+  // Cache resolver results for longer than the (60 second) libcurl default.
+  // GCS endpoints are served through stable anycast addresses, re-resolving
+  // them every minute just adds latency.
+  curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+}
+
 void CurlHandleFactory::SetCurlStringOption(CURL* handle, CURLoption option_tag,
                                             char const* value) {
   curl_easy_setopt(handle, option_tag, value);
@@ -35,6 +69,15 @@ void CurlHandleFactory::SetCurlOptions(CURL* handle,
   }
 }
 
+void CurlHandleFactory::SetInvariantOptions(CURL* handle) {
+  // The library is designed for multi-threaded applications, where signal
+  // handlers cannot be used safely by libcurl.
+  curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+#if LIBCURL_VERSION_NUM >= 0x071900  // CURLOPT_TCP_KEEPALIVE requires 7.25.0
+  curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+#endif  // LIBCURL_VERSION_NUM
+}
+
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory() {
   std::call_once(default_curl_handle_factory_initialized, [] {
     default_curl_handle_factory = std::make_shared<DefaultCurlHandleFactory>();
@@ -53,6 +96,8 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
 CurlPtr DefaultCurlHandleFactory::CreateHandle() {
   CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
   SetCurlOptions(curl.get(), options_);
+  SetInvariantOptions(curl.get());
+  SetShare(curl.get());
   return curl;
 }
 
@@ -80,8 +125,8 @@ PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size,
 }
 
 PooledCurlHandleFactory::~PooledCurlHandleFactory() {
-  for (auto* h : handles_) {
-    curl_easy_cleanup(h);
+  for (auto& h : handles_) {
+    curl_easy_cleanup(h.handle);
   }
   for (auto* m : multi_handles_) {
     curl_multi_cleanup(m);
@@ -89,36 +134,153 @@ PooledCurlHandleFactory::~PooledCurlHandleFactory() {
 }
 
 CurlPtr PooledCurlHandleFactory::CreateHandle() {
+  auto acquire_start = std::chrono::steady_clock::now();
   std::unique_lock<std::mutex> lk(mu_);
+  auto now = std::chrono::steady_clock::now();
+  statistics_.acquire_wait_time +=
+      std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                            acquire_start);
+  DiscardExpiredHandles(now);
   if (!handles_.empty()) {
-    CURL* handle = handles_.back();
+    CURL* handle = handles_.back().handle;
     // Clear all the options in the handle so we do not leak its previous state.
     (void)curl_easy_reset(handle);
     handles_.pop_back();
+    ++statistics_.handle_pool_hits;
     CurlPtr curl(handle, &curl_easy_cleanup);
     SetCurlOptions(curl.get(), options_);
+    SetInvariantOptions(curl.get());
+    SetKeepaliveOptions(curl.get());
+    SetShare(curl.get());
     return curl;
   }
+  ++statistics_.handle_pool_misses;
+  ++statistics_.handles_created;
   CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
   SetCurlOptions(curl.get(), options_);
+  SetInvariantOptions(curl.get());
+  SetKeepaliveOptions(curl.get());
+  SetShare(curl.get());
   return curl;
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlHandle&& h) {
-  std::unique_lock<std::mutex> lk(mu_);
-  char* ip;
-  auto res = curl_easy_getinfo(GetHandle(h), CURLINFO_LOCAL_IP, &ip);
-  if (res == CURLE_OK && ip != nullptr) {
-    last_client_ip_address_ = ip;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    char* ip;
+    auto res = curl_easy_getinfo(GetHandle(h), CURLINFO_LOCAL_IP, &ip);
+    if (res == CURLE_OK && ip != nullptr) {
+      last_client_ip_address_ = ip;
+    }
   }
+  ReturnToPool(GetHandle(h));
+  // The handles_ vector now has ownership, so release it.
+  ReleaseHandle(h);
+}
+
+void PooledCurlHandleFactory::ReturnToPool(CURL* handle) {
+  auto now = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lk(mu_);
+  DiscardExpiredHandles(now);
   if (handles_.size() >= maximum_size_) {
-    CURL* tmp = handles_.front();
+    CURL* tmp = handles_.front().handle;
     handles_.erase(handles_.begin());
     curl_easy_cleanup(tmp);
+    ++statistics_.handle_evictions;
+    ++statistics_.handles_closed;
   }
-  handles_.push_back(GetHandle(h));
-  // The handles_ vector now has ownership, so release it.
-  ReleaseHandle(h);
+  handles_.push_back(IdleHandle{handle, now});
+}
+
+void PooledCurlHandleFactory::DiscardExpiredHandles(
+    std::chrono::steady_clock::time_point now) {
+  // The pool is ordered by idle time, the oldest handles are at the front.
+  auto it = handles_.begin();
+  for (; it != handles_.end(); ++it) {
+    if (now - it->idle_since < idle_handle_ttl_) {
+      break;
+    }
+    curl_easy_cleanup(it->handle);
+    ++statistics_.handle_evictions;
+    ++statistics_.handles_closed;
+  }
+  handles_.erase(handles_.begin(), it);
+}
+
+void PooledCurlHandleFactory::SetKeepaliveOptions(CURL* handle) {
+  if (!enable_tcp_keepalive_) {
+    return;
+  }
+#if LIBCURL_VERSION_NUM >= 0x071900  // CURLOPT_TCP_KEEPALIVE requires 7.25.0
+  curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+  curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, 60L);
+  curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, 60L);
+#else
+  (void)handle;
+#endif  // LIBCURL_VERSION_NUM
+}
+
+StatusOr<std::size_t> PooledCurlHandleFactory::WarmUp(
+    std::string const& endpoint, std::size_t count, CURLSH* share) {
+  count = (std::min)(count, maximum_size_);
+  auto multi = CreateMultiHandle();
+  std::vector<CurlPtr> handles;
+  handles.reserve(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    auto handle = CreateHandle();
+    curl_easy_setopt(handle.get(), CURLOPT_URL, endpoint.c_str());
+    // A HEAD request: we only care about establishing the connection, any
+    // response (including 4xx for unauthenticated requests) is good enough.
+    curl_easy_setopt(handle.get(), CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(handle.get(), CURLOPT_NOSIGNAL, 1L);
+    // Force a new connection for each handle, otherwise libcurl would simply
+    // reuse (or multiplex over) the first connection it establishes.
+    curl_easy_setopt(handle.get(), CURLOPT_FRESH_CONNECT, 1L);
+    if (share != nullptr) {
+      curl_easy_setopt(handle.get(), CURLOPT_SHARE, share);
+    }
+    auto error = curl_multi_add_handle(multi.get(), handle.get());
+    if (error != CURLM_OK) {
+      return Status(StatusCode::kUnknown, curl_multi_strerror(error));
+    }
+    handles.push_back(std::move(handle));
+  }
+
+  int running_handles = 0;
+  do {
+    CURLMcode result;
+    do {
+      result = curl_multi_perform(multi.get(), &running_handles);
+    } while (result == CURLM_CALL_MULTI_PERFORM);
+    if (result != CURLM_OK) {
+      return Status(StatusCode::kUnknown, curl_multi_strerror(result));
+    }
+    if (running_handles != 0) {
+      int numfds = 0;
+      result = curl_multi_wait(multi.get(), nullptr, 0, 1000, &numfds);
+      if (result != CURLM_OK) {
+        return Status(StatusCode::kUnknown, curl_multi_strerror(result));
+      }
+    }
+  } while (running_handles != 0);
+
+  std::size_t established = 0;
+  int remaining = 0;
+  while (auto* msg = curl_multi_info_read(multi.get(), &remaining)) {
+    if (msg->msg == CURLMSG_DONE && msg->data.result == CURLE_OK) {
+      ++established;
+    }
+  }
+
+  for (auto& handle : handles) {
+    curl_multi_remove_handle(multi.get(), handle.get());
+    // Reset the warm-up options, the established connection (and the DNS and
+    // TLS session caches) survive the reset.
+    curl_easy_reset(handle.get());
+    ReturnToPool(handle.release());
+  }
+  CleanupMultiHandle(std::move(multi));
+  return established;
 }
 
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
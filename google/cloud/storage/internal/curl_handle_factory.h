@@ -17,7 +17,9 @@
 
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
+#include "google/cloud/storage/internal/pool_statistics.h"
 #include "google/cloud/storage/version.h"
+#include <chrono>
 #include <mutex>
 #include <vector>
 
@@ -31,6 +33,7 @@ namespace internal {
  */
 class CurlHandleFactory {
  public:
+  CurlHandleFactory();
   virtual ~CurlHandleFactory() = default;
 
   virtual CurlPtr CreateHandle() = 0;
@@ -41,15 +44,55 @@ class CurlHandleFactory {
 
   virtual std::string LastClientIpAddress() const = 0;
 
+  /// The `CURLSH*` sharing the DNS cache and TLS session tickets across
+  /// handles from this factory.
+  CURLSH* share() const { return share_.get(); }
+
+  /**
+   * Returns the connection-pool counters for this factory.
+   *
+   * Factories without a pool return all-zero counters, except for the
+   * created/closed counts when they choose to track them.
+   */
+  virtual PoolStatistics statistics() const { return PoolStatistics{}; }
+
  protected:
   // Only virtual for testing purposes.
   virtual void SetCurlStringOption(CURL* handle, CURLoption option_tag,
                                    char const* value);
   void SetCurlOptions(CURL* handle, ChannelOptions const& options);
 
+  /**
+   * Applies the options that are invariant for every request.
+   *
+   * Every handle returned by `CreateHandle()` carries these options, so the
+   * per-request code only needs to set the URL, headers, and payload. The
+   * options are re-applied when a pooled handle is recycled, because
+   * recycling resets the handle.
+   */
+  void SetInvariantOptions(CURL* handle);
+
+  /**
+   * Shares the DNS cache and TLS session cache of this factory with
+   * @p handle.
+   *
+   * Without sharing, each new handle re-resolves the endpoint (and slow
+   * resolvers land directly on request latency) and performs a full TLS
+   * handshake. Sharing the session cache lets new connections resume the
+   * sessions established by earlier ones, saving a round trip of handshake
+   * latency. Note that `CurlClient` later installs its own `CURLSH*` (which
+   * shares the same caches) on the handles it uses, overriding this one; the
+   * factory-level share covers all other uses of the handles.
+   */
+  void SetShare(CURL* handle);
+
   static CURL* GetHandle(CurlHandle& h) { return h.handle_.get(); }
   static void ResetHandle(CurlHandle& h) { h.handle_.reset(); }
   static void ReleaseHandle(CurlHandle& h) { (void)h.handle_.release(); }
+
+ private:
+  std::mutex share_mu_;
+  CurlShare share_;
 };
 
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
@@ -110,11 +153,77 @@ class PooledCurlHandleFactory : public CurlHandleFactory {
     return last_client_ip_address_;
   }
 
+  /**
+   * Pre-establishes up to @p count connections to @p endpoint.
+   *
+   * The connections are established concurrently, so the call takes roughly
+   * one DNS + TCP + TLS handshake, not @p count of them. The handles (and the
+   * multi handle driving them) are returned to the pool, so later requests
+   * reuse the established connections instead of paying the handshake
+   * latency on the application's critical path.
+   *
+   * If @p share is not `nullptr` the connections are owned by that `CURLSH*`,
+   * which must have been configured to share `CURL_LOCK_DATA_CONNECT`.
+   *
+   * @return the number of connections successfully established. Failures to
+   *   connect are not errors, the actual requests will retry and report them.
+   */
+  StatusOr<std::size_t> WarmUp(std::string const& endpoint, std::size_t count,
+                               CURLSH* share = nullptr);
+
+  //@{
+  /**
+   * @name Control stale-connection handling for pooled handles.
+   *
+   * Servers (and middleboxes) close connections that remain idle for too
+   * long. A handle that sat in the pool past that timeout makes its next
+   * request eat a TCP reset and a full reconnect. Handles idle for longer
+   * than the TTL are closed instead of reused. TCP keepalive probes keep the
+   * connection alive (and detect dead peers) during shorter lulls.
+   *
+   * The default TTL is a conservative value below the idle timeout used by
+   * Google services. TCP keepalive is enabled by default.
+   */
+  std::chrono::milliseconds idle_handle_ttl() const { return idle_handle_ttl_; }
+  PooledCurlHandleFactory& set_idle_handle_ttl(std::chrono::milliseconds ttl) {
+    idle_handle_ttl_ = ttl;
+    return *this;
+  }
+
+  bool enable_tcp_keepalive() const { return enable_tcp_keepalive_; }
+  PooledCurlHandleFactory& set_enable_tcp_keepalive(bool v) {
+    enable_tcp_keepalive_ = v;
+    return *this;
+  }
+  //@}
+
+  PoolStatistics statistics() const override {
+    std::lock_guard<std::mutex> lk(mu_);
+    return statistics_;
+  }
+
  private:
+  struct IdleHandle {
+    CURL* handle;
+    std::chrono::steady_clock::time_point idle_since;
+  };
+
+  /// Returns @p handle to the pool, evicting the oldest handle if full.
+  void ReturnToPool(CURL* handle);
+
+  /// Closes expired handles. Requires `mu_` to be held.
+  void DiscardExpiredHandles(std::chrono::steady_clock::time_point now);
+
+  /// Configures TCP keepalive probes on @p handle, if enabled.
+  void SetKeepaliveOptions(CURL* handle);
+
   std::size_t maximum_size_;
   mutable std::mutex mu_;
-  std::vector<CURL*> handles_;
+  std::vector<IdleHandle> handles_;
   std::vector<CURLM*> multi_handles_;
+  std::chrono::milliseconds idle_handle_ttl_ = std::chrono::minutes(2);
+  bool enable_tcp_keepalive_ = true;
+  PoolStatistics statistics_;  // GUARDED_BY(mu_)
   std::string last_client_ip_address_;
   ChannelOptions options_;
 };
@@ -111,6 +111,30 @@ TEST(CurlHandleFactoryTest, PooledFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, DefaultFactoryReturnsZeroStatistics) {
+  DefaultCurlHandleFactory object_under_test;
+
+  object_under_test.CreateHandle();
+  auto stats = object_under_test.statistics();
+  EXPECT_EQ(0, stats.handle_pool_hits);
+  EXPECT_EQ(0, stats.handle_pool_misses);
+  EXPECT_EQ(0, stats.handles_created);
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryCountsMisses) {
+  PooledCurlHandleFactory object_under_test(2);
+
+  // With an empty pool each handle is a miss and creates a new handle.
+  auto h1 = object_under_test.CreateHandle();
+  auto h2 = object_under_test.CreateHandle();
+  auto stats = object_under_test.statistics();
+  EXPECT_EQ(0, stats.handle_pool_hits);
+  EXPECT_EQ(2, stats.handle_pool_misses);
+  EXPECT_EQ(2, stats.handles_created);
+  EXPECT_EQ(0, stats.handle_evictions);
+  EXPECT_EQ(0, stats.handles_closed);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -60,6 +60,29 @@ TEST(CurlHandleTest, AsStatus) {
   }
 }
 
+TEST(CurlHandleTest, UrlEscape) {
+  EXPECT_EQ("", UrlEscape(""));
+  EXPECT_EQ("object-name_1.txt~", UrlEscape("object-name_1.txt~"));
+  EXPECT_EQ("foo%2Fbar%20baz", UrlEscape("foo/bar baz"));
+  EXPECT_EQ("%00%FF", UrlEscape(std::string{'\0'} + std::string{'\xff'}));
+
+  // The results must match `curl_easy_escape()`, signed URLs depend on the
+  // exact escaping.
+  std::string all_bytes;
+  for (int c = 0; c != 256; ++c) {
+    all_bytes.push_back(static_cast<char>(c));
+  }
+  CurlHandle handle;
+  EXPECT_EQ(std::string(handle.MakeEscapedString(all_bytes).get()),
+            UrlEscape(all_bytes));
+}
+
+TEST(CurlHandleTest, AppendUrlEscaped) {
+  std::string output = "prefix?name=";
+  AppendUrlEscaped(output, "a b");
+  EXPECT_EQ("prefix?name=a%20b", output);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,54 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_header_arena.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+void CurlHeaderArena::Append(std::string const& header) {
+  if (size_ == nodes_.size()) {
+    nodes_.emplace_back();
+    storage_.emplace_back();
+  }
+  auto& text = storage_[size_];
+  // `assign()` reuses the string's capacity, a recycled slot long enough for
+  // the new header performs no allocation.
+  text.assign(header);
+  auto& node = nodes_[size_];
+  node.data = const_cast<char*>(text.c_str());
+  node.next = nullptr;
+  if (tail_ == nullptr) {
+    head_ = &node;
+  } else {
+    tail_->next = &node;
+  }
+  tail_ = &node;
+  ++size_;
+}
+
+void CurlHeaderArena::Clear() {
+  size_ = 0;
+  head_ = nullptr;
+  tail_ = nullptr;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
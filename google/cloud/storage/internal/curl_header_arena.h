@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HEADER_ARENA_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HEADER_ARENA_H
+
+#include "google/cloud/storage/version.h"
+#include <curl/curl.h>
+#include <deque>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Owns the nodes and text of a `curl_slist` header list.
+ *
+ * `curl_slist_append()` performs one allocation for the list node and another
+ * to copy the header text, for every header of every request. This arena owns
+ * both, and `Clear()` recycles them (including the `std::string` capacity for
+ * the header text) for the next request, so a steady stream of requests
+ * reusing an arena performs no header allocations at all.
+ *
+ * The list returned by `list()` borrows the arena's storage: the arena must
+ * outlive any transfer using the list, and `Clear()` must not be called until
+ * such transfers complete.
+ */
+class CurlHeaderArena {
+ public:
+  CurlHeaderArena() = default;
+
+  CurlHeaderArena(CurlHeaderArena const&) = delete;
+  CurlHeaderArena& operator=(CurlHeaderArena const&) = delete;
+
+  /// Appends @p header to the list, reusing recycled storage if available.
+  void Append(std::string const& header);
+
+  /// The list in the form expected by `CURLOPT_HTTPHEADER`.
+  curl_slist* list() const { return head_; }
+
+  /// The number of headers in the list.
+  std::size_t size() const { return size_; }
+
+  /// Empties the list, recycling its storage. Invalidates `list()`.
+  void Clear();
+
+ private:
+  // Both containers must keep the addresses of their elements stable as the
+  // arena grows, the list nodes point at each other and at the text.
+  std::deque<curl_slist> nodes_;
+  std::deque<std::string> storage_;
+  std::size_t size_ = 0;
+  curl_slist* head_ = nullptr;
+  curl_slist* tail_ = nullptr;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HEADER_ARENA_H
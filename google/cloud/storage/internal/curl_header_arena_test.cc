@@ -0,0 +1,72 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_header_arena.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<std::string> AsVector(curl_slist* list) {
+  std::vector<std::string> result;
+  for (; list != nullptr; list = list->next) {
+    result.emplace_back(list->data);
+  }
+  return result;
+}
+
+TEST(CurlHeaderArenaTest, Empty) {
+  CurlHeaderArena arena;
+  EXPECT_EQ(nullptr, arena.list());
+  EXPECT_EQ(0U, arena.size());
+}
+
+TEST(CurlHeaderArenaTest, AppendBuildsList) {
+  CurlHeaderArena arena;
+  arena.Append("Content-Type: application/json");
+  arena.Append("Content-Length: 0");
+  EXPECT_EQ(2U, arena.size());
+  EXPECT_THAT(AsVector(arena.list()),
+              ElementsAre("Content-Type: application/json",
+                          "Content-Length: 0"));
+}
+
+TEST(CurlHeaderArenaTest, ClearRecyclesStorage) {
+  CurlHeaderArena arena;
+  arena.Append("Content-Type: application/json");
+  arena.Append("Content-Length: 0");
+  auto* first_node = arena.list();
+
+  arena.Clear();
+  EXPECT_EQ(nullptr, arena.list());
+  EXPECT_EQ(0U, arena.size());
+
+  arena.Append("Content-Type: text/plain");
+  // The node (and its text storage) should be recycled, not reallocated.
+  EXPECT_EQ(first_node, arena.list());
+  EXPECT_THAT(AsVector(arena.list()), ElementsAre("Content-Type: text/plain"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
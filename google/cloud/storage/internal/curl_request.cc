@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_request.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace google {
@@ -33,7 +35,47 @@ extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
   return request->OnHeaderData(contents, size, nitems);
 }
 
+extern "C" size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                        void* userdata) {
+  auto* request = reinterpret_cast<CurlRequest*>(userdata);
+  return request->OnReadData(ptr, size, nitems);
+}
+
 StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
+  handle_.SetOption(CURLOPT_UPLOAD, 0L);
+  if (!payload.empty()) {
+    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
+    handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
+  }
+  return MakeRequestImpl();
+}
+
+StatusOr<HttpResponse> CurlRequest::MakeUploadRequest(
+    ConstBufferSequence payload) {
+  handle_.SetOption(CURLOPT_UPLOAD, 0L);
+  auto const total = TotalBytes(payload);
+  if (total == 0) {
+    return MakeRequestImpl();
+  }
+  if (payload.size() == 1) {
+    // A single buffer does not need the read callback, posting the borrowed
+    // memory directly saves the callback round trips.
+    handle_.SetOption(CURLOPT_POSTFIELDSIZE_LARGE,
+                      static_cast<curl_off_t>(payload[0].size));
+    handle_.SetOption(CURLOPT_POSTFIELDS, payload[0].data);
+    return MakeRequestImpl();
+  }
+  upload_payload_ = std::move(payload);
+  upload_buffer_index_ = 0;
+  upload_buffer_offset_ = 0;
+  handle_.SetOption(CURLOPT_READFUNCTION, &CurlRequestOnReadData);
+  handle_.SetOption(CURLOPT_READDATA, this);
+  handle_.SetOption(CURLOPT_UPLOAD, 1L);
+  handle_.SetOption(CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(total));
+  return MakeRequestImpl();
+}
+
+StatusOr<HttpResponse> CurlRequest::MakeRequestImpl() {
   // We get better performance using a slightly larger buffer (128KiB) than the
   // default buffer size set by libcurl (16KiB)
   auto constexpr kDefaultBufferSize = 128 * 1024L;
@@ -41,21 +83,17 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
   response_payload_.clear();
   handle_.SetOption(CURLOPT_BUFFERSIZE, kDefaultBufferSize);
   handle_.SetOption(CURLOPT_URL, url_.c_str());
-  handle_.SetOption(CURLOPT_HTTPHEADER, headers_.get());
+  handle_.SetOption(CURLOPT_HTTPHEADER,
+                    header_arena_ ? header_arena_->list() : nullptr);
   handle_.SetOption(CURLOPT_USERAGENT, user_agent_.c_str());
-  handle_.SetOption(CURLOPT_NOSIGNAL, 1);
-  handle_.SetOption(CURLOPT_UPLOAD, 0L);
-  handle_.SetOption(CURLOPT_TCP_KEEPALIVE, 1L);
+  // CURLOPT_NOSIGNAL and CURLOPT_TCP_KEEPALIVE are applied by the handle
+  // factories, every handle carries them already.
   handle_.EnableLogging(logging_enabled_);
   handle_.SetSocketCallback(socket_options_);
   handle_.SetOption(CURLOPT_WRITEFUNCTION, &CurlRequestOnWriteData);
   handle_.SetOption(CURLOPT_WRITEDATA, this);
   handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlRequestOnHeaderData);
   handle_.SetOption(CURLOPT_HEADERDATA, this);
-  if (!payload.empty()) {
-    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
-    handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
-  }
   auto status = handle_.EasyPerform();
   if (!status.ok()) {
     return status;
@@ -82,6 +120,25 @@ std::size_t CurlRequest::OnHeaderData(char* contents, std::size_t size,
   return CurlAppendHeaderData(received_headers_, contents, size * nitems);
 }
 
+std::size_t CurlRequest::OnReadData(char* ptr, std::size_t size,
+                                    std::size_t nitems) {
+  std::size_t const capacity = size * nitems;
+  std::size_t copied = 0;
+  while (copied != capacity && upload_buffer_index_ != upload_payload_.size()) {
+    auto const& buffer = upload_payload_[upload_buffer_index_];
+    auto const n = (std::min)(capacity - copied,
+                              buffer.size - upload_buffer_offset_);
+    std::memcpy(ptr + copied, buffer.data + upload_buffer_offset_, n);
+    copied += n;
+    upload_buffer_offset_ += n;
+    if (upload_buffer_offset_ == buffer.size) {
+      ++upload_buffer_index_;
+      upload_buffer_offset_ = 0;
+    }
+  }
+  return copied;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_header_arena.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/version.h"
 
@@ -29,6 +31,8 @@ extern "C" size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                          void* userdata);
 extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
                                           size_t nitems, void* userdata);
+extern "C" size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                        void* userdata);
 
 class CurlRequest {
  public:
@@ -49,24 +53,46 @@ class CurlRequest {
    */
   StatusOr<HttpResponse> MakeRequest(std::string const& payload);
 
+  /**
+   * Makes the prepared request, uploading the payload from @p payload.
+   *
+   * The buffers are fed to libcurl through its read callback, without
+   * coalescing them first, so the upload performs no payload copies beyond
+   * the one into the socket buffer. The memory viewed by @p payload must
+   * remain valid until this function returns.
+   */
+  StatusOr<HttpResponse> MakeUploadRequest(ConstBufferSequence payload);
+
  private:
   friend class CurlRequestBuilder;
   friend size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                        void* userdata);
   friend size_t CurlRequestOnHeaderData(char* contents, size_t size,
                                         size_t nitems, void* userdata);
+  friend size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                      void* userdata);
+
+  /// Performs the request once the payload options are set.
+  StatusOr<HttpResponse> MakeRequestImpl();
 
   std::size_t OnWriteData(char* contents, std::size_t size, std::size_t nmemb);
   std::size_t OnHeaderData(char* contents, std::size_t size,
                            std::size_t nitems);
+  std::size_t OnReadData(char* ptr, std::size_t size, std::size_t nitems);
 
   std::string url_;
-  CurlHeaders headers_ = CurlHeaders(nullptr, &curl_slist_free_all);
+  std::shared_ptr<CurlHeaderArena> header_arena_;
   std::string user_agent_;
   std::string response_payload_;
+  ConstBufferSequence upload_payload_;
+  std::size_t upload_buffer_index_ = 0;
+  std::size_t upload_buffer_offset_ = 0;
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_ = false;
   CurlHandle::SocketOptions socket_options_;
+  // Pins the `CURLOPT_RESOLVE` list (if any) for the lifetime of the
+  // request, libcurl does not copy the list.
+  CurlResolveList resolve_list_;
   CurlHandle handle_;
   std::shared_ptr<CurlHandleFactory> factory_;
 };
@@ -28,24 +28,34 @@ namespace internal {
 
 CurlRequestBuilder::CurlRequestBuilder(
     std::string base_url, std::shared_ptr<CurlHandleFactory> factory)
+    : CurlRequestBuilder(std::move(base_url), std::move(factory),
+                         std::make_shared<CurlHeaderArena>()) {}
+
+CurlRequestBuilder::CurlRequestBuilder(
+    std::string base_url, std::shared_ptr<CurlHandleFactory> factory,
+    std::shared_ptr<CurlHeaderArena> header_arena)
     : factory_(std::move(factory)),
       handle_(factory_->CreateHandle()),
-      headers_(nullptr, &curl_slist_free_all),
+      header_arena_(std::move(header_arena)),
       url_(std::move(base_url)),
       query_parameter_separator_("?"),
       logging_enabled_(false),
-      download_stall_timeout_(0) {}
+      http2_multiplexing_enabled_(false),
+      download_stall_timeout_(0) {
+  header_arena_->Clear();
+}
 
 CurlRequest CurlRequestBuilder::BuildRequest() {
   ValidateBuilderState(__func__);
   CurlRequest request;
   request.url_ = std::move(url_);
-  request.headers_ = std::move(headers_);
+  request.header_arena_ = std::move(header_arena_);
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.handle_ = std::move(handle_);
   request.factory_ = std::move(factory_);
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
+  request.resolve_list_ = std::move(resolve_list_);
   return request;
 }
 
@@ -54,7 +64,7 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   ValidateBuilderState(__func__);
   CurlDownloadRequest request;
   request.url_ = std::move(url_);
-  request.headers_ = std::move(headers_);
+  request.header_arena_ = std::move(header_arena_);
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.payload_ = std::move(payload);
   request.handle_ = std::move(handle_);
@@ -63,6 +73,13 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
   request.download_stall_timeout_ = download_stall_timeout_;
+  request.http2_multiplexing_enabled_ = http2_multiplexing_enabled_;
+  request.transfer_buffer_size_ = transfer_buffer_size_;
+  request.adaptive_buffer_size_enabled_ = adaptive_buffer_size_enabled_;
+  request.low_watermark_ = download_low_watermark_;
+  request.high_watermark_ = download_high_watermark_;
+  request.memory_budget_ = std::move(download_memory_budget_);
+  request.resolve_list_ = std::move(resolve_list_);
   request.SetOptions();
   return request;
 }
@@ -75,26 +92,98 @@ CurlRequestBuilder& CurlRequestBuilder::ApplyClientOptions(
   socket_options_.send_buffer_size_ = options.maximum_socket_send_size();
   user_agent_prefix_ = options.user_agent_prefix() + user_agent_prefix_;
   download_stall_timeout_ = options.download_stall_timeout();
+  http2_multiplexing_enabled_ = options.enable_http2_multiplexing();
+  transfer_buffer_size_ = options.transfer_buffer_size();
+  adaptive_buffer_size_enabled_ = options.enable_adaptive_buffer_size();
+  download_low_watermark_ = options.download_buffer_low_watermark();
+  download_high_watermark_ = options.download_buffer_high_watermark();
+#if LIBCURL_VERSION_NUM >= 0x073b00  // HAPPY_EYEBALLS_TIMEOUT_MS: 7.59.0
+  if (options.happy_eyeballs_timeout().count() != 0) {
+    handle_.SetOption(
+        CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS,
+        // NOLINTNEXTLINE(google-runtime-int) - libcurl *requires* `long`
+        static_cast<long>(options.happy_eyeballs_timeout().count()));
+  }
+#endif  // LIBCURL_VERSION_NUM
+#if LIBCURL_VERSION_NUM >= 0x072b00  // CURLOPT_PIPEWAIT requires 7.43.0
+  if (http2_multiplexing_enabled_) {
+    // Prefer waiting for an existing HTTP/2 connection (shared via CURLSH*
+    // with CURL_LOCK_DATA_CONNECT) over establishing a new connection.
+    handle_.SetOption(CURLOPT_PIPEWAIT, 1L);
+  }
+#endif  // LIBCURL_VERSION_NUM
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::AddOption(ConnectTimeout const& p) {
+  ValidateBuilderState(__func__);
+  if (p.has_value()) {
+    handle_.SetOption(CURLOPT_CONNECTTIMEOUT_MS,
+                      // NOLINTNEXTLINE(google-runtime-int) - libcurl API
+                      static_cast<long>(p.value().count()));
+  }
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::AddOption(
+    TransferStallTimeout const& p) {
+  ValidateBuilderState(__func__);
+  if (p.has_value()) {
+    // Consider the transfer stalled when it moves less than one byte per
+    // second over the configured window, and abort it.
+    // NOLINTNEXTLINE(google-runtime-int) - libcurl requires `long`
+    handle_.SetOption(CURLOPT_LOW_SPEED_LIMIT, 1L);
+    // NOLINTNEXTLINE(google-runtime-int) - libcurl requires `long`
+    handle_.SetOption(CURLOPT_LOW_SPEED_TIME,
+                      static_cast<long>(p.value().count()));
+    // Downloads implement their own stall detection, the per-request
+    // option takes precedence over the client-wide configuration.
+    download_stall_timeout_ = p.value();
+  }
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::AddOption(TransferTimeout const& p) {
+  ValidateBuilderState(__func__);
+  if (p.has_value()) {
+    handle_.SetOption(CURLOPT_TIMEOUT_MS,
+                      // NOLINTNEXTLINE(google-runtime-int) - libcurl API
+                      static_cast<long>(p.value().count()));
+  }
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetDownloadMemoryBudget(
+    std::shared_ptr<DownloadMemoryBudget> budget) {
+  ValidateBuilderState(__func__);
+  download_memory_budget_ = std::move(budget);
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetResolveList(CurlResolveList list) {
+  ValidateBuilderState(__func__);
+  if (!list) {
+    return *this;
+  }
+  handle_.SetOption(CURLOPT_RESOLVE, list.get());
+  resolve_list_ = std::move(list);
   return *this;
 }
 
 CurlRequestBuilder& CurlRequestBuilder::AddHeader(std::string const& header) {
   ValidateBuilderState(__func__);
-  auto new_header = curl_slist_append(headers_.get(), header.c_str());
-  (void)headers_.release();
-  headers_.reset(new_header);
+  header_arena_->Append(header);
   return *this;
 }
 
 CurlRequestBuilder& CurlRequestBuilder::AddQueryParameter(
     std::string const& key, std::string const& value) {
   ValidateBuilderState(__func__);
-  std::string parameter = query_parameter_separator_;
-  parameter += handle_.MakeEscapedString(key).get();
-  parameter += "=";
-  parameter += handle_.MakeEscapedString(value).get();
+  url_.append(query_parameter_separator_);
+  AppendUrlEscaped(url_, key);
+  url_.append("=");
+  AppendUrlEscaped(url_, value);
   query_parameter_separator_ = "&";
-  url_.append(parameter);
   return *this;
 }
 
@@ -18,7 +18,9 @@
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/internal/curl_download_request.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_header_arena.h"
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/transfer_timeouts.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_headers.h"
 
@@ -37,6 +39,17 @@ class CurlRequestBuilder {
   explicit CurlRequestBuilder(std::string base_url,
                               std::shared_ptr<CurlHandleFactory> factory);
 
+  /**
+   * Creates a builder recycling the header storage in @p header_arena.
+   *
+   * The arena is `Clear()`ed, so it must not be in use by a pending request.
+   * Callers issuing many sequential requests can reuse one arena to avoid
+   * the per-header allocations of building a fresh `curl_slist` every time.
+   */
+  CurlRequestBuilder(std::string base_url,
+                     std::shared_ptr<CurlHandleFactory> factory,
+                     std::shared_ptr<CurlHeaderArena> header_arena);
+
   /**
    * Creates a http request with the given payload.
    *
@@ -93,6 +106,15 @@ class CurlRequestBuilder {
     return *this;
   }
 
+  /// Bounds the connection-establishment time for this request.
+  CurlRequestBuilder& AddOption(ConnectTimeout const& p);
+
+  /// Aborts the request when no data is transferred for the given time.
+  CurlRequestBuilder& AddOption(TransferStallTimeout const& p);
+
+  /// Bounds the total duration of this request.
+  CurlRequestBuilder& AddOption(TransferTimeout const& p);
+
   /// Adds a custom header to the request.
   CurlRequestBuilder& AddOption(CustomHeader const& p) {
     if (p.has_value()) {
@@ -144,6 +166,13 @@ class CurlRequestBuilder {
   /// Copy interesting configuration parameters from the client options.
   CurlRequestBuilder& ApplyClientOptions(ClientOptions const& options);
 
+  /// Sets the client-wide budget charged for a download's buffer memory.
+  CurlRequestBuilder& SetDownloadMemoryBudget(
+      std::shared_ptr<DownloadMemoryBudget> budget);
+
+  /// Sets the pre-resolved `CURLOPT_RESOLVE` entries for this request.
+  CurlRequestBuilder& SetResolveList(CurlResolveList list);
+
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
@@ -166,13 +195,20 @@ class CurlRequestBuilder {
   std::shared_ptr<CurlHandleFactory> factory_;
 
   CurlHandle handle_;
-  CurlHeaders headers_;
+  std::shared_ptr<CurlHeaderArena> header_arena_;
 
   std::string url_;
   char const* query_parameter_separator_;
 
   std::string user_agent_prefix_;
   bool logging_enabled_;
+  bool http2_multiplexing_enabled_;
+  std::size_t transfer_buffer_size_ = 0;
+  bool adaptive_buffer_size_enabled_ = false;
+  std::size_t download_low_watermark_ = 0;
+  std::size_t download_high_watermark_ = 0;
+  std::shared_ptr<DownloadMemoryBudget> download_memory_budget_;
+  CurlResolveList resolve_list_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
 };
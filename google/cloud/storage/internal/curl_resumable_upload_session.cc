@@ -21,24 +21,27 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
 StatusOr<ResumableUploadResponse> CurlResumableUploadSession::UploadChunk(
-    std::string const& buffer) {
-  UploadChunkRequest request(session_id_, next_expected_, buffer);
-  auto result = client_->UploadChunk(request);
-  Update(result, buffer.size());
+    ConstBufferSequence const& buffers) {
+  // Borrow the caller's buffers, they outlive the request and copying each
+  // chunk just costs CPU and memory bandwidth.
+  UploadChunkRequest request(session_id_, next_expected_, buffers);
+  auto result = client_->UploadChunk(request, pinned_factory_);
+  Update(result, TotalBytes(buffers));
   return result;
 }
 
 StatusOr<ResumableUploadResponse> CurlResumableUploadSession::UploadFinalChunk(
-    std::string const& buffer, std::uint64_t upload_size) {
-  UploadChunkRequest request(session_id_, next_expected_, buffer, upload_size);
-  auto result = client_->UploadChunk(request);
-  Update(result, buffer.size());
+    ConstBufferSequence const& buffers, std::uint64_t upload_size) {
+  UploadChunkRequest request(session_id_, next_expected_, buffers,
+                             upload_size);
+  auto result = client_->UploadChunk(request, pinned_factory_);
+  Update(result, TotalBytes(buffers));
   return result;
 }
 
 StatusOr<ResumableUploadResponse> CurlResumableUploadSession::ResetSession() {
   QueryResumableUploadRequest request(session_id_);
-  auto result = client_->QueryResumableUpload(request);
+  auto result = client_->QueryResumableUpload(request, pinned_factory_);
   Update(result, 0);
   return result;
 }
@@ -51,6 +54,10 @@ void CurlResumableUploadSession::Update(
     StatusOr<ResumableUploadResponse> const& result, std::size_t chunk_size) {
   last_response_ = result;
   if (!result.ok()) {
+    // The pinned connection failed, fall back to the shared pool for the
+    // rest of the session rather than reconnecting a dedicated handle on
+    // every retry.
+    pinned_factory_.reset();
     return;
   }
   done_ = result->upload_state == ResumableUploadResponse::kDone;
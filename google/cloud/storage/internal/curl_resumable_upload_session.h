@@ -26,18 +26,36 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 /**
  * Implement a ResumableUploadSession that delegates to a CurlClient.
+ *
+ * The session pins its requests to a dedicated connection: each chunk
+ * reuses the connection of the previous one, at its fully opened
+ * congestion window, instead of drawing a (possibly cold) connection
+ * from the shared pool per chunk. After a failed request the session
+ * falls back to the shared pool, see `Update()`.
  */
 class CurlResumableUploadSession : public ResumableUploadSession {
  public:
   explicit CurlResumableUploadSession(std::shared_ptr<CurlClient> client,
                                       std::string session_id)
-      : client_(std::move(client)), session_id_(std::move(session_id)) {}
+      : client_(std::move(client)),
+        session_id_(std::move(session_id)),
+        pinned_factory_(client_->CreateUploadSessionFactory()) {}
+
+  /// Restore a session at a known committed byte count, without querying the
+  /// service, typically from an upload checkpoint.
+  CurlResumableUploadSession(std::shared_ptr<CurlClient> client,
+                             std::string session_id,
+                             std::uint64_t next_expected)
+      : client_(std::move(client)),
+        session_id_(std::move(session_id)),
+        pinned_factory_(client_->CreateUploadSessionFactory()),
+        next_expected_(next_expected) {}
 
   StatusOr<ResumableUploadResponse> UploadChunk(
-      std::string const& buffer) override;
+      ConstBufferSequence const& buffers) override;
 
   StatusOr<ResumableUploadResponse> UploadFinalChunk(
-      std::string const& buffer, std::uint64_t upload_size) override;
+      ConstBufferSequence const& buffers, std::uint64_t upload_size) override;
 
   StatusOr<ResumableUploadResponse> ResetSession() override;
 
@@ -57,6 +75,9 @@ class CurlResumableUploadSession : public ResumableUploadSession {
 
   std::shared_ptr<CurlClient> client_;
   std::string session_id_;
+  /// The factory pinning this session to one connection, `nullptr` after
+  /// a failed request, the session then uses the shared upload pool.
+  std::shared_ptr<CurlHandleFactory> pinned_factory_;
   std::uint64_t next_expected_ = 0;
   bool done_ = false;
   StatusOr<ResumableUploadResponse> last_response_;
@@ -37,10 +37,15 @@ class MockCurlClient : public CurlClient {
   MockCurlClient()
       : CurlClient(ClientOptions(oauth2::CreateAnonymousCredentials())) {}
 
-  MOCK_METHOD1(UploadChunk,
-               StatusOr<ResumableUploadResponse>(UploadChunkRequest const&));
-  MOCK_METHOD1(QueryResumableUpload, StatusOr<ResumableUploadResponse>(
-                                         QueryResumableUploadRequest const&));
+  // The session always uses the overloads taking a handle factory, with
+  // its pinned factory (or `nullptr` after a failure).
+  MOCK_METHOD2(UploadChunk, StatusOr<ResumableUploadResponse>(
+                                UploadChunkRequest const&,
+                                std::shared_ptr<CurlHandleFactory> const&));
+  MOCK_METHOD2(QueryResumableUpload,
+               StatusOr<ResumableUploadResponse>(
+                   QueryResumableUploadRequest const&,
+                   std::shared_ptr<CurlHandleFactory> const&));
 };
 
 TEST(CurlResumableUploadSessionTest, Simple) {
@@ -53,16 +58,20 @@ TEST(CurlResumableUploadSessionTest, Simple) {
 
   EXPECT_FALSE(session.done());
   EXPECT_EQ(0, session.next_expected_byte());
-  EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](UploadChunkRequest const& request) {
+  EXPECT_CALL(*mock, UploadChunk(_, _))
+      .WillOnce(Invoke([&](UploadChunkRequest const& request,
+                           std::shared_ptr<CurlHandleFactory> const& factory) {
         EXPECT_EQ(test_url, request.upload_session_url());
         EXPECT_EQ(payload, request.payload());
         EXPECT_EQ(0, request.source_size());
         EXPECT_EQ(0, request.range_begin());
+        // The session is pinned to its own handle factory.
+        EXPECT_TRUE(factory);
         return make_status_or(ResumableUploadResponse{
             "", size - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](UploadChunkRequest const& request) {
+      .WillOnce(Invoke([&](UploadChunkRequest const& request,
+                           std::shared_ptr<CurlHandleFactory> const&) {
         EXPECT_EQ(test_url, request.upload_session_url());
         EXPECT_EQ(payload, request.payload());
         EXPECT_EQ(2 * size, request.source_size());
@@ -71,13 +80,13 @@ TEST(CurlResumableUploadSessionTest, Simple) {
             "", 2 * size - 1, {}, ResumableUploadResponse::kDone, {}});
       }));
 
-  auto upload = session.UploadChunk(payload);
+  auto upload = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(upload);
   EXPECT_EQ(size - 1, upload->last_committed_byte);
   EXPECT_EQ(size, session.next_expected_byte());
   EXPECT_FALSE(session.done());
 
-  upload = session.UploadFinalChunk(payload, 2 * size);
+  upload = session.UploadFinalChunk({ConstBuffer(payload)}, 2 * size);
   EXPECT_STATUS_OK(upload);
   EXPECT_EQ(2 * size - 1, upload->last_committed_byte);
   EXPECT_EQ(2 * size, session.next_expected_byte());
@@ -94,26 +103,33 @@ TEST(CurlResumableUploadSessionTest, Reset) {
   auto const size = payload.size();
 
   EXPECT_EQ(0, session.next_expected_byte());
-  EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](UploadChunkRequest const&) {
+  EXPECT_CALL(*mock, UploadChunk(_, _))
+      .WillOnce(Invoke([&](UploadChunkRequest const&,
+                           std::shared_ptr<CurlHandleFactory> const& factory) {
+        EXPECT_TRUE(factory);
         return make_status_or(ResumableUploadResponse{
             "", size - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](UploadChunkRequest const&) {
+      .WillOnce(Invoke([&](UploadChunkRequest const&,
+                           std::shared_ptr<CurlHandleFactory> const&) {
         return StatusOr<ResumableUploadResponse>(
             AsStatus(HttpResponse{308, "uh oh", {}}));
       }));
   const ResumableUploadResponse resume_response{
       url2, 2 * size - 1, {}, ResumableUploadResponse::kInProgress, {}};
-  EXPECT_CALL(*mock, QueryResumableUpload(_))
-      .WillOnce(Invoke([&](QueryResumableUploadRequest const& request) {
+  EXPECT_CALL(*mock, QueryResumableUpload(_, _))
+      .WillOnce(Invoke([&](QueryResumableUploadRequest const& request,
+                           std::shared_ptr<CurlHandleFactory> const& factory) {
         EXPECT_EQ(url1, request.upload_session_url());
+        // The failed chunk dropped the pinned factory, the session falls
+        // back to the shared upload pool.
+        EXPECT_FALSE(factory);
         return make_status_or(resume_response);
       }));
 
-  auto upload = session.UploadChunk(payload);
+  auto upload = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_EQ(size, session.next_expected_byte());
-  upload = session.UploadChunk(payload);
+  upload = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_FALSE(upload.ok());
   EXPECT_EQ(size, session.next_expected_byte());
   EXPECT_EQ(url1, session.session_id());
@@ -137,19 +153,21 @@ TEST(CurlResumableUploadSessionTest, SessionUpdatedInChunkUpload) {
   auto const size = payload.size();
 
   EXPECT_EQ(0, session.next_expected_byte());
-  EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](UploadChunkRequest const&) {
+  EXPECT_CALL(*mock, UploadChunk(_, _))
+      .WillOnce(Invoke([&](UploadChunkRequest const&,
+                           std::shared_ptr<CurlHandleFactory> const&) {
         return make_status_or(ResumableUploadResponse{
             "", size - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](UploadChunkRequest const&) {
+      .WillOnce(Invoke([&](UploadChunkRequest const&,
+                           std::shared_ptr<CurlHandleFactory> const&) {
         return make_status_or(ResumableUploadResponse{
             url2, 2 * size - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }));
 
-  auto upload = session.UploadChunk(payload);
+  auto upload = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_EQ(size, session.next_expected_byte());
-  upload = session.UploadChunk(payload);
+  upload = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(upload);
   EXPECT_EQ(2 * size, session.next_expected_byte());
   EXPECT_EQ(url2, session.session_id());
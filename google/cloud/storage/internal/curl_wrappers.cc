@@ -17,10 +17,19 @@
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
 #include <openssl/crypto.h>
 #include <openssl/opensslv.h>
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif  // _WIN32
 #include <algorithm>
 #include <cctype>
 #include <csignal>
 #include <iostream>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -223,18 +232,102 @@ std::size_t CurlAppendHeaderData(CurlReceivedHeaders& received_headers,
     return size;
   }
   auto separator = std::find(data, data + size, ':');
-  std::string header_name = std::string(data, separator);
-  std::string header_value;
   // If there is a value, capture it, but ignore the final \r\n.
+  char const* value_begin = data + size - 2;
+  char const* value_end = data + size - 2;
   if (static_cast<std::size_t>(separator - data) < size - 2) {
-    header_value = std::string(separator + 2, data + size - 2);
+    value_begin = separator + 2;
   }
-  std::transform(header_name.begin(), header_name.end(), header_name.begin(),
-                 [](char x) { return std::tolower(x); });
-  received_headers.emplace(std::move(header_name), std::move(header_value));
+  received_headers.Append(data, separator, value_begin, value_end);
   return size;
 }
 
+std::pair<std::string, std::string> EndpointHostPort(
+    std::string const& endpoint) {
+  auto host = endpoint;
+  std::string port = "443";
+  auto pos = host.find("://");
+  if (pos != std::string::npos) {
+    if (host.compare(0, pos, "http") == 0) {
+      port = "80";
+    }
+    host = host.substr(pos + 3);
+  }
+  pos = host.find('/');
+  if (pos != std::string::npos) {
+    host = host.substr(0, pos);
+  }
+  if (!host.empty() && host[0] == '[') {
+    // A bracketed IPv6 literal, e.g. `[::1]:9000`.
+    pos = host.find(']');
+    if (pos != std::string::npos && pos + 2 < host.size() &&
+        host[pos + 1] == ':') {
+      port = host.substr(pos + 2);
+    }
+    host = host.substr(1, pos == std::string::npos ? pos : pos - 1);
+    return {host, port};
+  }
+  pos = host.rfind(':');
+  if (pos != std::string::npos) {
+    port = host.substr(pos + 1);
+    host = host.substr(0, pos);
+  }
+  return {host, port};
+}
+
+CurlResolveList PreResolveEndpoints(std::vector<std::string> const& endpoints) {
+  curl_slist* list = nullptr;
+  std::set<std::string> seen;
+  for (auto const& endpoint : endpoints) {
+    auto host_port = EndpointHostPort(endpoint);
+    auto entry = host_port.first + ":" + host_port.second + ":";
+    if (!seen.insert(entry).second) {
+      continue;
+    }
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(host_port.first.c_str(), host_port.second.c_str(), &hints,
+                    &results) != 0) {
+      continue;
+    }
+    // Entries with multiple addresses (comma separated) require libcurl >=
+    // 7.59.0; older versions ignore the malformed entry and fall back to
+    // normal resolution, which is harmless.
+    char buffer[INET6_ADDRSTRLEN];
+    char const* sep = "";
+    for (auto* ai = results; ai != nullptr; ai = ai->ai_next) {
+      void const* addr = nullptr;
+      if (ai->ai_family == AF_INET) {
+        addr = &reinterpret_cast<sockaddr_in const*>(ai->ai_addr)->sin_addr;
+      } else if (ai->ai_family == AF_INET6) {
+        addr = &reinterpret_cast<sockaddr_in6 const*>(ai->ai_addr)->sin6_addr;
+      } else {
+        continue;
+      }
+      if (inet_ntop(ai->ai_family, addr, buffer, sizeof(buffer)) == nullptr) {
+        continue;
+      }
+      entry += sep;
+      entry += buffer;
+      sep = ",";
+    }
+    freeaddrinfo(results);
+    if (entry.back() == ':') {
+      continue;  // no usable addresses for this host
+    }
+    auto* appended = curl_slist_append(list, entry.c_str());
+    if (appended != nullptr) {
+      list = appended;
+    }
+  }
+  if (list == nullptr) {
+    return nullptr;
+  }
+  return CurlResolveList(list, &curl_slist_free_all);
+}
+
 void CurlInitializeOnce(ClientOptions const& options) {
   static CurlInitializer curl_initializer;
   std::call_once(ssl_locking_initialized, InitializeSslLocking,
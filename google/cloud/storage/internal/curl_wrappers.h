@@ -17,12 +17,16 @@
 
 #include "google/cloud/storage/client_options.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/received_headers.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
 #include <curl/curl.h>
 #include <functional>
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -40,12 +44,34 @@ using CurlString = std::unique_ptr<char, decltype(&curl_free)>;
 
 using CurlHeaders = std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)>;
 
-using CurlReceivedHeaders = std::multimap<std::string, std::string>;
+using CurlReceivedHeaders = ReceivedHeaders;
 std::size_t CurlAppendHeaderData(CurlReceivedHeaders& received_headers,
                                  char const* data, std::size_t size);
 
 using CurlShare = std::unique_ptr<CURLSH, decltype(&curl_share_cleanup)>;
 
+/**
+ * Holds a `CURLOPT_RESOLVE` list shared by many requests.
+ *
+ * libcurl does not copy the list, each request pins the list with one of
+ * these shared pointers until the transfer completes.
+ */
+using CurlResolveList = std::shared_ptr<curl_slist>;
+
+/// Extracts the hostname and port (as a string) from an endpoint URL.
+std::pair<std::string, std::string> EndpointHostPort(
+    std::string const& endpoint);
+
+/**
+ * Resolves the hosts in @p endpoints and formats `CURLOPT_RESOLVE` entries.
+ *
+ * The lookups block, callers are expected to invoke this once, at client
+ * construction, so individual requests never block on DNS. Hosts that fail
+ * to resolve are simply omitted, requests fall back to normal resolution
+ * for them. Returns `nullptr` when no host resolved.
+ */
+CurlResolveList PreResolveEndpoints(std::vector<std::string> const& endpoints);
+
 /// Returns true if the SSL locking callbacks are installed.
 bool SslLockingCallbacksInstalled();
 
@@ -0,0 +1,72 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(CurlWrappersTest, EndpointHostPortHttps) {
+  auto hp = EndpointHostPort("https://storage.googleapis.com");
+  EXPECT_EQ("storage.googleapis.com", hp.first);
+  EXPECT_EQ("443", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortWithPath) {
+  auto hp = EndpointHostPort("https://www.googleapis.com/storage/v1");
+  EXPECT_EQ("www.googleapis.com", hp.first);
+  EXPECT_EQ("443", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortHttpDefaultsTo80) {
+  auto hp = EndpointHostPort("http://localhost/xmlapi");
+  EXPECT_EQ("localhost", hp.first);
+  EXPECT_EQ("80", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortExplicitPort) {
+  auto hp = EndpointHostPort("http://localhost:9000/storage/v1");
+  EXPECT_EQ("localhost", hp.first);
+  EXPECT_EQ("9000", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortNoScheme) {
+  auto hp = EndpointHostPort("storage.googleapis.com");
+  EXPECT_EQ("storage.googleapis.com", hp.first);
+  EXPECT_EQ("443", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortIpv6Literal) {
+  auto hp = EndpointHostPort("http://[::1]:9000/storage/v1");
+  EXPECT_EQ("::1", hp.first);
+  EXPECT_EQ("9000", hp.second);
+}
+
+TEST(CurlWrappersTest, EndpointHostPortIpv6LiteralNoPort) {
+  auto hp = EndpointHostPort("https://[2001:db8::1]/storage/v1");
+  EXPECT_EQ("2001:db8::1", hp.first);
+  EXPECT_EQ("443", hp.second);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
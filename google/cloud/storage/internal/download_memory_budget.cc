@@ -0,0 +1,65 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_memory_budget.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::size_t DownloadMemoryBudget::Acquire(std::size_t preferred,
+                                          std::size_t minimum) {
+  if (limit_ == 0) {
+    in_use_.fetch_add(preferred, std::memory_order_relaxed);
+    return preferred;
+  }
+  auto current = in_use_.load(std::memory_order_relaxed);
+  while (current + preferred <= limit_) {
+    if (in_use_.compare_exchange_weak(current, current + preferred,
+                                      std::memory_order_relaxed)) {
+      return preferred;
+    }
+  }
+  // The budget is exhausted. Grant the minimum anyway, downloads must make
+  // progress, the limit is a soft cap on the aggregate, not a hard failure.
+  in_use_.fetch_add(minimum, std::memory_order_relaxed);
+  return minimum;
+}
+
+bool DownloadMemoryBudget::TryAcquire(std::size_t n) {
+  if (limit_ == 0) {
+    in_use_.fetch_add(n, std::memory_order_relaxed);
+    return true;
+  }
+  auto current = in_use_.load(std::memory_order_relaxed);
+  while (current + n <= limit_) {
+    if (in_use_.compare_exchange_weak(current, current + n,
+                                      std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DownloadMemoryBudget::Release(std::size_t n) {
+  in_use_.fetch_sub(n, std::memory_order_relaxed);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
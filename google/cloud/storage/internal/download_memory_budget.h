@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MEMORY_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MEMORY_BUDGET_H
+
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Tracks the buffer memory used by the active downloads of one client.
+ *
+ * Each download holds a libcurl receive buffer and a spill buffer while it
+ * is active. With hundreds of concurrent (and possibly paused) downloads
+ * this adds up; a client-wide budget keeps the aggregate bounded. Downloads
+ * charge their buffers on creation and release them on destruction. The
+ * budget degrades instead of failing: once the limit is reached new
+ * downloads are granted only minimally-sized buffers, so they still make
+ * progress.
+ *
+ * The budget is shared across threads, all operations are thread-safe.
+ */
+class DownloadMemoryBudget {
+ public:
+  /// Creates a budget with @p limit bytes, `0` means unlimited.
+  explicit DownloadMemoryBudget(std::size_t limit) : limit_(limit) {}
+
+  /**
+   * Charges the budget for a new download's buffers.
+   *
+   * Grants @p preferred bytes if they fit under the limit, otherwise grants
+   * @p minimum bytes, even if that overshoots the limit. The caller must
+   * `Release()` the returned value when the download completes.
+   */
+  std::size_t Acquire(std::size_t preferred, std::size_t minimum);
+
+  /// Charges @p n additional bytes only if they fit under the limit.
+  bool TryAcquire(std::size_t n);
+
+  /// Returns @p n bytes to the budget.
+  void Release(std::size_t n);
+
+  std::size_t limit() const { return limit_; }
+  std::size_t in_use() const {
+    return in_use_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::size_t const limit_;
+  std::atomic<std::size_t> in_use_{0};
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MEMORY_BUDGET_H
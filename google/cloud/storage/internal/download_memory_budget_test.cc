@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_memory_budget.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(DownloadMemoryBudgetTest, UnlimitedGrantsPreferred) {
+  DownloadMemoryBudget budget(0);
+  EXPECT_EQ(128, budget.Acquire(128, 16));
+  EXPECT_EQ(128, budget.Acquire(128, 16));
+  EXPECT_EQ(256, budget.in_use());
+}
+
+TEST(DownloadMemoryBudgetTest, GrantsPreferredUnderLimit) {
+  DownloadMemoryBudget budget(256);
+  EXPECT_EQ(128, budget.Acquire(128, 16));
+  EXPECT_EQ(128, budget.Acquire(128, 16));
+  EXPECT_EQ(256, budget.in_use());
+}
+
+TEST(DownloadMemoryBudgetTest, GrantsMinimumWhenExhausted) {
+  DownloadMemoryBudget budget(256);
+  EXPECT_EQ(200, budget.Acquire(200, 16));
+  // Another 200 bytes do not fit, the budget degrades to the minimum.
+  EXPECT_EQ(16, budget.Acquire(200, 16));
+  EXPECT_EQ(216, budget.in_use());
+}
+
+TEST(DownloadMemoryBudgetTest, TryAcquire) {
+  DownloadMemoryBudget budget(256);
+  EXPECT_TRUE(budget.TryAcquire(200));
+  EXPECT_FALSE(budget.TryAcquire(100));
+  EXPECT_TRUE(budget.TryAcquire(56));
+  EXPECT_EQ(256, budget.in_use());
+}
+
+TEST(DownloadMemoryBudgetTest, TryAcquireUnlimited) {
+  DownloadMemoryBudget budget(0);
+  EXPECT_TRUE(budget.TryAcquire(1024));
+  EXPECT_EQ(1024, budget.in_use());
+}
+
+TEST(DownloadMemoryBudgetTest, ReleaseReturnsBytes) {
+  DownloadMemoryBudget budget(256);
+  EXPECT_EQ(256, budget.Acquire(256, 16));
+  EXPECT_EQ(16, budget.Acquire(256, 16));
+  budget.Release(16);
+  budget.Release(256);
+  EXPECT_EQ(0, budget.in_use());
+  EXPECT_EQ(256, budget.Acquire(256, 16));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
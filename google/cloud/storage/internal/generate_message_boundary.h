@@ -26,44 +26,43 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
 /**
- * Generate a string that is not found in @p message.
+ * The length of the random MIME multipart boundaries.
  *
- * When sending messages over multipart MIME payloads we need a separator that
- * is not found in the body of the message *and* that is not too large (it is
- * trivial to generate a string not found in @p message, just append some
- * characters to the message itself).
+ * With 62 candidate characters, a 32-character random boundary is one of
+ * 62^32 (roughly 2^190) strings. A payload of N bytes contains fewer than
+ * N candidate substrings, so the probability that the boundary appears in
+ * the payload is below N * 2^-190, negligible even for multi-terabyte
+ * payloads. RFC 2046 limits boundaries to 70 characters, so there is room
+ * to grow this if the math ever changes.
+ */
+int constexpr kMessageBoundarySize = 32;
+
+/**
+ * Generate a random string to separate the parts of a MIME multipart
+ * message.
  *
- * The algorithm is to generate a short random string, and search for it in the
- * message, if the message has that string, append some more random characters
- * and keep searching.
+ * A previous version of this function searched the message body for the
+ * candidate boundary, growing the candidate until it was not found. That
+ * scan touched every byte of the payload before the upload even started.
+ * Making the boundary long enough renders a collision so improbable (see
+ * `kMessageBoundarySize`) that the scan is just wasted work, so the
+ * boundary is now used without examining the message at all.
  *
  * This function is a template because the string generator is typically a
- * lambda that captures state variables (such as the random number generator),
- * of the class that uses it.
+ * lambda that captures state variables (such as the random number generator
+ * and the locks protecting it) of the class that uses it.
  *
- * @param message a message body, typically the payload of a HTTP request that
- *     will need to be encoded as a MIME multipart message.
- * @param random_string_generator a callable to generate random strings.
- *     Typically a lambda that captures the generator and any locks necessary
- *     to generate the string. This is also used in testing to verify things
- *     work when the initial string is found.
- * @param initial_size the length for the initial string.
- * @param growth_size how fast to grow the random string.
- * @return a string not found in @p message.
+ * @param random_string_generator a callable to generate random strings of a
+ *     given length, from an alphabet valid in MIME boundaries.
+ * @return a string of `kMessageBoundarySize` random characters.
  */
 template <typename RandomStringGenerator,
           typename std::enable_if<google::cloud::internal::is_invocable<
                                       RandomStringGenerator, int>::value,
                                   int>::type = 0>
 std::string GenerateMessageBoundary(
-    std::string const& message, RandomStringGenerator&& random_string_generator,
-    int initial_size, int growth_size) {
-  std::string candidate = random_string_generator(initial_size);
-  for (std::string::size_type i = message.find(candidate, 0);
-       i != std::string::npos; i = message.find(candidate, i)) {
-    candidate += random_string_generator(growth_size);
-  }
-  return candidate;
+    RandomStringGenerator&& random_string_generator) {
+  return random_string_generator(kMessageBoundarySize);
 }
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
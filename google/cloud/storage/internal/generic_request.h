@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GENERIC_REQUEST_H
 
 #include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/transfer_timeouts.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_headers.h"
 #include "google/cloud/storage/well_known_parameters.h"
@@ -197,13 +198,16 @@ class GenericRequestBase : public GenericRequestBase<Derived, Options...> {
  */
 template <typename Derived, typename... Options>
 class GenericRequest
-    : public GenericRequestBase<Derived, CustomHeader, Fields, IfMatchEtag,
-                                IfNoneMatchEtag, QuotaUser, UserIp,
-                                Options...> {
+    : public GenericRequestBase<Derived, ConnectTimeout, CustomHeader, Fields,
+                                IfMatchEtag, IfNoneMatchEtag, OperationDeadline,
+                                QuotaUser, TransferStallTimeout,
+                                TransferTimeout, UserIp, Options...> {
  public:
   using Super =
-      GenericRequestBase<Derived, CustomHeader, Fields, IfMatchEtag,
-                         IfNoneMatchEtag, QuotaUser, UserIp, Options...>;
+      GenericRequestBase<Derived, ConnectTimeout, CustomHeader, Fields,
+                         IfMatchEtag, IfNoneMatchEtag, OperationDeadline,
+                         QuotaUser, TransferStallTimeout, TransferTimeout,
+                         UserIp, Options...>;
 
   template <typename H, typename... T>
   Derived& set_multiple_options(H&& h, T&&... tail) {
@@ -0,0 +1,92 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/gzip_compressor.h"
+#include <zlib.h>
+#include <array>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// Ask for a gzip wrapper (instead of the default zlib wrapper) by adding 16
+// to the maximum window size, as described in the `deflateInit2()`
+// documentation.
+int constexpr kGzipWindowBits = 15 + 16;
+int constexpr kDefaultMemLevel = 8;
+}  // namespace
+
+struct GzipCompressor::Impl {
+  z_stream stream;
+  bool initialized = false;
+};
+
+GzipCompressor::GzipCompressor() : impl_(new Impl) {
+  std::memset(&impl_->stream, 0, sizeof(impl_->stream));
+  auto result =
+      deflateInit2(&impl_->stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   kGzipWindowBits, kDefaultMemLevel, Z_DEFAULT_STRATEGY);
+  impl_->initialized = (result == Z_OK);
+}
+
+GzipCompressor::~GzipCompressor() {
+  if (impl_->initialized) {
+    deflateEnd(&impl_->stream);
+  }
+}
+
+Status GzipCompressor::Compress(char const* data, std::size_t size,
+                                std::string& out, bool finish) {
+  if (!impl_->initialized) {
+    return Status(StatusCode::kInternal,
+                  "cannot initialize zlib deflate stream");
+  }
+  auto& stream = impl_->stream;
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data));  // NOLINT
+  stream.avail_in = static_cast<uInt>(size);
+
+  std::array<char, 64 * 1024> buffer;
+  int const flush = finish ? Z_FINISH : Z_NO_FLUSH;
+  int result;
+  do {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+    stream.avail_out = static_cast<uInt>(buffer.size());
+    result = deflate(&stream, flush);
+    if (result == Z_STREAM_ERROR) {
+      std::string msg = "error compressing upload data: ";
+      msg += stream.msg != nullptr ? stream.msg : "Z_STREAM_ERROR";
+      return Status(StatusCode::kInternal, std::move(msg));
+    }
+    out.append(buffer.data(), buffer.size() - stream.avail_out);
+    // With Z_NO_FLUSH deflate() returns once it consumed all the input, with
+    // Z_FINISH it returns Z_STREAM_END once the trailer is written. In either
+    // case a full output buffer means there is more output pending.
+  } while (stream.avail_out == 0);
+
+  if (finish && result != Z_STREAM_END) {
+    return Status(StatusCode::kInternal,
+                  "error finalizing compressed upload data");
+  }
+  return Status();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,73 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_COMPRESSOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_COMPRESSOR_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * An incremental gzip compressor.
+ *
+ * This is a thin wrapper around zlib's streaming `deflate()` API. The
+ * compression context (dictionary, pending bits) is carried across calls to
+ * `Compress()`, so feeding the input in arbitrarily sized pieces produces a
+ * single, valid gzip stream. This is what makes streaming compressed uploads
+ * possible: each piece can be compressed (and sent) as soon as the
+ * application flushes it, without staging the full object first.
+ *
+ * The class intentionally does not expose zlib types, so including this
+ * header does not require `<zlib.h>`.
+ */
+class GzipCompressor {
+ public:
+  GzipCompressor();
+  ~GzipCompressor();
+
+  GzipCompressor(GzipCompressor const&) = delete;
+  GzipCompressor& operator=(GzipCompressor const&) = delete;
+
+  /**
+   * Compresses `[data, data + size)`, appending any output to @p out.
+   *
+   * Set @p finish on the last call (possibly with `size == 0`) to flush the
+   * remaining compressed bits and write the gzip trailer. The compressor
+   * cannot be used again after a call with @p finish set.
+   *
+   * Note that a call may produce no output: zlib buffers input until it has
+   * enough data to compress effectively.
+   */
+  Status Compress(char const* data, std::size_t size, std::string& out,
+                  bool finish);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_COMPRESSOR_H
@@ -0,0 +1,103 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/gzip_compressor.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <zlib.h>
+#include <cstring>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// Decompress a gzip stream, the inverse of `GzipCompressor`.
+std::string GzipInflate(std::string const& compressed) {
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // 15 + 16 selects the gzip wrapper, see the `inflateInit2()` documentation.
+  EXPECT_EQ(Z_OK, inflateInit2(&stream, 15 + 16));
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  std::string result;
+  std::vector<char> buffer(64 * 1024);
+  int status;
+  do {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+    stream.avail_out = static_cast<uInt>(buffer.size());
+    status = inflate(&stream, Z_NO_FLUSH);
+    EXPECT_TRUE(status == Z_OK || status == Z_STREAM_END);
+    result.append(buffer.data(), buffer.size() - stream.avail_out);
+  } while (status == Z_OK);
+  EXPECT_EQ(Z_STREAM_END, status);
+  inflateEnd(&stream);
+  return result;
+}
+
+/// @test Verify that data compressed in pieces forms a single gzip stream.
+TEST(GzipCompressorTest, RoundTrip) {
+  std::string const expected =
+      "The quick brown fox jumps over the lazy dog. " + std::string(4096, 'a');
+
+  GzipCompressor compressor;
+  std::string compressed;
+  // Feed the input in unevenly sized pieces, the compressor must carry its
+  // state across calls.
+  std::size_t const pieces[] = {1, 100, 1000};
+  std::size_t offset = 0;
+  for (auto size : pieces) {
+    ASSERT_STATUS_OK(
+        compressor.Compress(expected.data() + offset, size, compressed, false));
+    offset += size;
+  }
+  ASSERT_STATUS_OK(compressor.Compress(expected.data() + offset,
+                                       expected.size() - offset, compressed,
+                                       true));
+
+  EXPECT_EQ(expected, GzipInflate(compressed));
+}
+
+/// @test Verify that an empty input produces a valid (empty) gzip stream.
+TEST(GzipCompressorTest, EmptyInput) {
+  GzipCompressor compressor;
+  std::string compressed;
+  ASSERT_STATUS_OK(compressor.Compress(nullptr, 0, compressed, true));
+  EXPECT_FALSE(compressed.empty());
+  EXPECT_EQ("", GzipInflate(compressed));
+}
+
+/// @test Verify that compressible data actually shrinks.
+TEST(GzipCompressorTest, CompressibleDataShrinks) {
+  std::string const expected(1024 * 1024, 'x');
+
+  GzipCompressor compressor;
+  std::string compressed;
+  ASSERT_STATUS_OK(compressor.Compress(expected.data(), expected.size(),
+                                       compressed, true));
+
+  EXPECT_LT(compressed.size(), expected.size() / 10);
+  EXPECT_EQ(expected, GzipInflate(compressed));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/internal/async_hash_validator.h"
 #include "google/cloud/storage/internal/hash_validator_impl.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/object_metadata.h"
@@ -25,6 +26,18 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
 void CompositeValidator::Update(char const* buf, std::size_t n) {
+  // Process the buffer in cache-sized chunks. Large buffers do not fit in
+  // the L2 cache, walking the whole buffer once per validator would evict
+  // it between the two passes and pay for the memory reads twice. With
+  // chunks the second validator reads from cache, making the combined
+  // update close to a single pass over memory.
+  std::size_t constexpr kChunkSize = 64 * 1024;
+  while (n > kChunkSize) {
+    left_->Update(buf, kChunkSize);
+    right_->Update(buf, kChunkSize);
+    buf += kChunkSize;
+    n -= kChunkSize;
+  }
   left_->Update(buf, n);
   right_->Update(buf, n);
 }
@@ -40,6 +53,42 @@ void CompositeValidator::ProcessHeader(std::string const& key,
   right_->ProcessHeader(key, value);
 }
 
+std::string CompositeValidator::State() const {
+  auto left_state = left_->State();
+  // A 4-byte little-endian length prefix is enough to split the two states
+  // when restoring.
+  std::string state;
+  auto size = left_state.size();
+  for (int i = 0; i != 4; ++i) {
+    state.push_back(static_cast<char>(size & 0xFFU));
+    size >>= 8;
+  }
+  state += left_state;
+  state += right_->State();
+  return state;
+}
+
+Status CompositeValidator::Restore(std::string const& state) {
+  if (state.size() < 4) {
+    return Status(StatusCode::kInvalidArgument,
+                  "mismatched hash state for composite validator");
+  }
+  std::size_t left_size = 0;
+  for (int i = 3; i >= 0; --i) {
+    left_size = (left_size << 8) |
+                static_cast<unsigned char>(state[static_cast<std::size_t>(i)]);
+  }
+  if (state.size() < 4 + left_size) {
+    return Status(StatusCode::kInvalidArgument,
+                  "mismatched hash state for composite validator");
+  }
+  auto status = left_->Restore(state.substr(4, left_size));
+  if (!status.ok()) {
+    return status;
+  }
+  return right_->Restore(state.substr(4 + left_size));
+}
+
 HashValidator::Result CompositeValidator::Finish() && {
   auto left_result = std::move(*left_).Finish();
   auto right_result = std::move(*right_).Finish();
@@ -53,19 +102,26 @@ HashValidator::Result CompositeValidator::Finish() && {
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
-                                                   bool disable_crc32c) {
+                                                   bool disable_crc32c,
+                                                   bool async_hashing) {
   if (disable_md5 && disable_crc32c) {
     return google::cloud::internal::make_unique<NullHashValidator>();
   }
+  std::unique_ptr<HashValidator> validator;
   if (disable_md5) {
-    return google::cloud::internal::make_unique<Crc32cHashValidator>();
+    validator = google::cloud::internal::make_unique<Crc32cHashValidator>();
+  } else if (disable_crc32c) {
+    validator = google::cloud::internal::make_unique<MD5HashValidator>();
+  } else {
+    validator = google::cloud::internal::make_unique<CompositeValidator>(
+        google::cloud::internal::make_unique<Crc32cHashValidator>(),
+        google::cloud::internal::make_unique<MD5HashValidator>());
   }
-  if (disable_crc32c) {
-    return google::cloud::internal::make_unique<MD5HashValidator>();
+  if (async_hashing) {
+    return google::cloud::internal::make_unique<AsyncHashValidator>(
+        std::move(validator));
   }
-  return google::cloud::internal::make_unique<CompositeValidator>(
-      google::cloud::internal::make_unique<Crc32cHashValidator>(),
-      google::cloud::internal::make_unique<MD5HashValidator>());
+  return validator;
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(
@@ -77,7 +133,9 @@ std::unique_ptr<HashValidator> CreateHashValidator(
                      request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto async_hashing = request.HasOption<AsyncHashing>() &&
+                       request.GetOption<AsyncHashing>().value();
+  return CreateHashValidator(disable_md5, disable_crc32c, async_hashing);
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(
@@ -86,7 +144,9 @@ std::unique_ptr<HashValidator> CreateHashValidator(
                      request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto async_hashing = request.HasOption<AsyncHashing>() &&
+                       request.GetOption<AsyncHashing>().value();
+  return CreateHashValidator(disable_md5, disable_crc32c, async_hashing);
 }
 
 }  // namespace internal
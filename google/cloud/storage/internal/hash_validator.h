@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HASH_VALIDATOR_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HASH_VALIDATOR_H
 
+#include "google/cloud/status.h"
 #include "google/cloud/storage/version.h"
 #include <memory>
 #include <string>
@@ -45,6 +46,20 @@ class HashValidator {
   virtual void ProcessHeader(std::string const& key,
                              std::string const& value) = 0;
 
+  /**
+   * Serialize the running hash state.
+   *
+   * The returned value can be stored (e.g. in an upload checkpoint) and
+   * later passed to `Restore()` on a freshly created validator of the same
+   * type, continuing the hash computation from the same point. The format
+   * is opaque, and only guaranteed to be readable by the same library
+   * version on the same architecture.
+   */
+  virtual std::string State() const = 0;
+
+  /// Restore the running hash state from a previous `State()` call.
+  virtual Status Restore(std::string const& state) = 0;
+
   struct Result {
     /// The value reported by the server, based on the calls to ProcessHeader().
     std::string received;
@@ -76,6 +91,14 @@ class NullHashValidator : public HashValidator {
   void Update(char const*, std::size_t) override {}
   void ProcessMetadata(ObjectMetadata const&) override {}
   void ProcessHeader(std::string const&, std::string const&) override {}
+  std::string State() const override { return std::string{}; }
+  Status Restore(std::string const& state) override {
+    if (!state.empty()) {
+      return Status(StatusCode::kInvalidArgument,
+                    "mismatched hash state for null validator");
+    }
+    return Status();
+  }
   Result Finish() && override { return Result{}; }
 };
 
@@ -92,6 +115,8 @@ class CompositeValidator : public HashValidator {
   void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
+  std::string State() const override;
+  Status Restore(std::string const& state) override;
   Result Finish() && override;
 
  private:
@@ -14,9 +14,10 @@
 
 #include "google/cloud/storage/internal/hash_validator_impl.h"
 #include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/object_metadata.h"
-#include <crc32c/crc32c.h>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -58,6 +59,22 @@ void MD5HashValidator::ProcessHeader(std::string const& key,
   received_hash_ = value.substr(pos + kPrefixLen, end - pos - kPrefixLen);
 }
 
+std::string MD5HashValidator::State() const {
+  // The OpenSSL context is a plain struct of counters and partial blocks,
+  // its raw bytes are a valid (if architecture-specific) serialization.
+  return std::string(reinterpret_cast<char const*>(&context_),
+                     sizeof(context_));
+}
+
+Status MD5HashValidator::Restore(std::string const& state) {
+  if (state.size() != sizeof(context_)) {
+    return Status(StatusCode::kInvalidArgument,
+                  "mismatched hash state for md5 validator");
+  }
+  std::memcpy(&context_, state.data(), sizeof(context_));
+  return Status();
+}
+
 HashValidator::Result MD5HashValidator::Finish() && {
   std::string hash(MD5_DIGEST_LENGTH, ' ');
   MD5_Final(reinterpret_cast<unsigned char*>(&hash[0]), &context_);
@@ -70,7 +87,7 @@ Crc32cHashValidator::Crc32cHashValidator() : current_(0) {}
 
 void Crc32cHashValidator::Update(char const* buf, std::size_t n) {
   current_ =
-      crc32c::Extend(current_, reinterpret_cast<std::uint8_t const*>(buf), n);
+      Crc32cExtend(current_, reinterpret_cast<std::uint8_t const*>(buf), n);
 }
 
 void Crc32cHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -102,6 +119,23 @@ void Crc32cHashValidator::ProcessHeader(std::string const& key,
   received_hash_ = value.substr(pos + kPrefixLen, end - pos - kPrefixLen);
 }
 
+std::string Crc32cHashValidator::State() const {
+  return google::cloud::internal::EncodeBigEndian(current_);
+}
+
+Status Crc32cHashValidator::Restore(std::string const& state) {
+  if (state.size() != sizeof(std::uint32_t)) {
+    return Status(StatusCode::kInvalidArgument,
+                  "mismatched hash state for crc32c validator");
+  }
+  std::uint32_t value = 0;
+  for (auto c : state) {
+    value = (value << 8) | static_cast<unsigned char>(c);
+  }
+  current_ = value;
+  return Status();
+}
+
 HashValidator::Result Crc32cHashValidator::Finish() && {
   std::string const hash = google::cloud::internal::EncodeBigEndian(current_);
   auto computed = Base64Encode(hash);
@@ -39,6 +39,8 @@ class MD5HashValidator : public HashValidator {
   void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
+  std::string State() const override;
+  Status Restore(std::string const& state) override;
   Result Finish() && override;
 
  private:
@@ -60,6 +62,8 @@ class Crc32cHashValidator : public HashValidator {
   void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
+  std::string State() const override;
+  Status Restore(std::string const& state) override;
   Result Finish() && override;
 
  private:
@@ -18,6 +18,7 @@
 #include "google/cloud/storage/internal/hash_validator_impl.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -223,6 +224,90 @@ TEST(CompositeHashValidator, Missing) {
   EXPECT_FALSE(result.is_mismatch);
 }
 
+TEST(CompositeHashValidator, LargeBuffer) {
+  // Large buffers are processed in cache-sized chunks, verify the result is
+  // unchanged, including for sizes that are not a multiple of the chunk.
+  CompositeValidator chunked(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(),
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  Crc32cHashValidator crc32c;
+  MD5HashValidator md5;
+  std::string buffer(256 * 1024 + 12345, '\0');
+  for (std::size_t i = 0; i != buffer.size(); ++i) {
+    buffer[i] = static_cast<char>(i % 251);
+  }
+  chunked.Update(buffer.data(), buffer.size());
+  crc32c.Update(buffer.data(), buffer.size());
+  md5.Update(buffer.data(), buffer.size());
+  auto result = std::move(chunked).Finish();
+  auto expected_crc32c = std::move(crc32c).Finish();
+  auto expected_md5 = std::move(md5).Finish();
+  EXPECT_EQ(
+      "crc32c=" + expected_crc32c.computed + ",md5=" + expected_md5.computed,
+      result.computed);
+}
+
+TEST(MD5HashValidator, StateRoundTrip) {
+  MD5HashValidator original;
+  UpdateValidator(original, "The quick");
+  UpdateValidator(original, " brown");
+
+  MD5HashValidator restored;
+  ASSERT_STATUS_OK(restored.Restore(original.State()));
+  UpdateValidator(restored, " fox jumps over the lazy dog");
+  auto result = std::move(restored).Finish();
+  EXPECT_EQ(QUICK_FOX_MD5_HASH, result.computed);
+}
+
+TEST(MD5HashValidator, RestoreInvalidState) {
+  MD5HashValidator validator;
+  auto status = validator.Restore("too-short");
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+}
+
+TEST(Crc32cHashValidator, StateRoundTrip) {
+  Crc32cHashValidator original;
+  UpdateValidator(original, "The quick");
+  UpdateValidator(original, " brown");
+
+  Crc32cHashValidator restored;
+  ASSERT_STATUS_OK(restored.Restore(original.State()));
+  UpdateValidator(restored, " fox jumps over the lazy dog");
+  auto result = std::move(restored).Finish();
+  EXPECT_EQ(QUICK_FOX_CRC32C_CHECKSUM, result.computed);
+}
+
+TEST(Crc32cHashValidator, RestoreInvalidState) {
+  Crc32cHashValidator validator;
+  auto status = validator.Restore("too-long-to-be-a-crc32c");
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+}
+
+TEST(CompositeHashValidator, StateRoundTrip) {
+  CompositeValidator original(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(),
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  UpdateValidator(original, "The quick");
+  UpdateValidator(original, " brown");
+
+  CompositeValidator restored(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(),
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  ASSERT_STATUS_OK(restored.Restore(original.State()));
+  UpdateValidator(restored, " fox jumps over the lazy dog");
+  auto result = std::move(restored).Finish();
+  EXPECT_EQ(
+      "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM + ",md5=" + QUICK_FOX_MD5_HASH,
+      result.computed);
+}
+
+TEST(NullHashValidatorTest, RestoreState) {
+  NullHashValidator validator;
+  EXPECT_STATUS_OK(validator.Restore(""));
+  EXPECT_EQ(StatusCode::kInvalidArgument,
+            validator.Restore("unexpected").code());
+}
+
 TEST(CreateHashValidator, Read_Null) {
   auto validator =
       CreateHashValidator(ReadObjectRangeRequest("test-bucket", "test-object")
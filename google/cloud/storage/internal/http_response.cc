@@ -51,13 +51,19 @@ Status AsStatus(HttpResponse const& http_response) {
     // handle, i.e., the mapping depends on the operation.
     return Status(StatusCode::kFailedPrecondition, http_response.payload);
   }
+  if (http_response.status_code == HttpStatusCode::kNotModified) {
+    // 304 - Not Modified: reads (and metadata requests) with a failed
+    // `IfGenerationNotMatch` or `IfMetagenerationNotMatch` pre-condition
+    // return this code, treat it like the 412 responses for the other
+    // pre-conditions.
+    return Status(StatusCode::kFailedPrecondition, http_response.payload);
+  }
   if (HttpStatusCode::kMinRedirects <= http_response.status_code &&
       http_response.status_code < HttpStatusCode::kMinRequestErrors) {
     // The 300s should be handled by libcurl, we should not get them, according
     // to the Google Cloud Storage documentation these are:
     // 302 - Found
     // 303 - See Other
-    // 304 - Not Modified
     // 307 - Temporary Redirect
     return Status(StatusCode::kUnknown, http_response.payload);
   }
@@ -16,9 +16,9 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HTTP_RESPONSE_H
 
 #include "google/cloud/status.h"
+#include "google/cloud/storage/internal/received_headers.h"
 #include "google/cloud/storage/version.h"
 #include <iosfwd>
-#include <map>
 #include <string>
 
 namespace google {
@@ -40,6 +40,10 @@ enum HttpStatusCode {
   kOk = 200,
   kCreated = 201,
 
+  // 304 - Not Modified: returned by reads with a failed
+  // `IfGenerationNotMatch` or `IfMetagenerationNotMatch` pre-condition.
+  kNotModified = 304,
+
   // Google's resumable upload protocol abuses 308 (Permanent Redirect) as
   // "Resume Incomplete".
   kResumeIncomplete = 308,
@@ -72,7 +76,7 @@ enum HttpStatusCode {
 struct HttpResponse {
   long status_code;
   std::string payload;
-  std::multimap<std::string, std::string> headers;
+  ReceivedHeaders headers;
 };
 
 /**
@@ -49,6 +49,8 @@ TEST(HttpResponseTest, AsStatus) {
   EXPECT_EQ(
       StatusCode::kUnknown,
       AsStatus(HttpResponse{300, "libcurl should handle this", {}}).code());
+  EXPECT_EQ(StatusCode::kFailedPrecondition,
+            AsStatus(HttpResponse{304, "not modified", {}}).code());
   EXPECT_EQ(StatusCode::kFailedPrecondition,
             AsStatus(HttpResponse{308, "pending", {}}).code());
   EXPECT_EQ(StatusCode::kInvalidArgument,
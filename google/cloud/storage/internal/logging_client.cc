@@ -84,6 +84,10 @@ ClientOptions const& LoggingClient::client_options() const {
   return client_->client_options();
 }
 
+PoolStatistics LoggingClient::pool_statistics() const {
+  return client_->pool_statistics();
+}
+
 StatusOr<ListBucketsResponse> LoggingClient::ListBuckets(
     ListBucketsRequest const& request) {
   return MakeCall(*client_, &RawClient::ListBuckets, request, __func__);
@@ -33,6 +33,8 @@ class LoggingClient : public RawClient {
 
   ClientOptions const& client_options() const override;
 
+  PoolStatistics pool_statistics() const override;
+
   StatusOr<ListBucketsResponse> ListBuckets(
       ListBucketsRequest const& request) override;
   StatusOr<BucketMetadata> CreateBucket(
@@ -63,15 +63,16 @@ TEST_F(LoggingResumableUploadSessionTest, UploadChunk) {
       testing::MockResumableUploadSession>();
 
   std::string const payload = "test-payload-data";
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    EXPECT_EQ(payload, p);
-    return StatusOr<ResumableUploadResponse>(
-        AsStatus(HttpResponse{503, "uh oh", {}}));
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        EXPECT_EQ(payload, ToString(p));
+        return StatusOr<ResumableUploadResponse>(
+            AsStatus(HttpResponse{503, "uh oh", {}}));
+      }));
 
   LoggingResumableUploadSession session(std::move(mock));
 
-  auto result = session.UploadChunk(payload);
+  auto result = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_EQ(StatusCode::kUnavailable, result.status().code());
   EXPECT_EQ("uh oh", result.status().message());
 
@@ -84,8 +85,8 @@ TEST_F(LoggingResumableUploadSessionTest, UploadFinalChunk) {
 
   std::string const payload = "test-payload-data";
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
-        EXPECT_EQ(payload, p);
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(513 * 1024, s);
         return StatusOr<ResumableUploadResponse>(
             AsStatus(HttpResponse{503, "uh oh", {}}));
@@ -93,7 +94,7 @@ TEST_F(LoggingResumableUploadSessionTest, UploadFinalChunk) {
 
   LoggingResumableUploadSession session(std::move(mock));
 
-  auto result = session.UploadFinalChunk(payload, 513 * 1024);
+  auto result = session.UploadFinalChunk({ConstBuffer(payload)}, 513 * 1024);
   EXPECT_EQ(StatusCode::kUnavailable, result.status().code());
   EXPECT_EQ("uh oh", result.status().message());
 
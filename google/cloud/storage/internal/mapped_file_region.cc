@@ -0,0 +1,80 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file_region.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+#ifndef _WIN32
+StatusOr<MappedFileRegion> MappedFileRegion::Open(
+    std::string const& file_name) {
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Status(StatusCode::kNotFound,
+                  "cannot open upload file source " + file_name);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return Status(StatusCode::kInvalidArgument,
+                  "upload file source is not a regular file " + file_name);
+  }
+  auto const size = static_cast<std::size_t>(st.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return MappedFileRegion(nullptr, 0);
+  }
+  void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file, the descriptor is no
+  // longer needed.
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return Status(StatusCode::kUnknown,
+                  "cannot map upload file source " + file_name);
+  }
+  // The upload consumes the file front to back, this is only a hint and any
+  // failure is safe to ignore.
+  (void)::madvise(addr, size, MADV_SEQUENTIAL);
+  return MappedFileRegion(static_cast<char const*>(addr), size);
+}
+
+MappedFileRegion::~MappedFileRegion() {
+  if (data_ != nullptr) {
+    (void)::munmap(const_cast<char*>(data_), size_);
+  }
+}
+#else
+StatusOr<MappedFileRegion> MappedFileRegion::Open(std::string const&) {
+  return Status(StatusCode::kUnimplemented,
+                "memory-mapped files are not supported on this platform");
+}
+
+MappedFileRegion::~MappedFileRegion() = default;
+#endif  // _WIN32
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,78 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A read-only memory mapping of a regular file.
+ *
+ * Uploading from a mapping avoids copying the data through an `std::istream`
+ * buffer, the upload chunks are built directly from the mapped region. The
+ * mapping is advised as sequential, so the kernel reads ahead aggressively
+ * and can drop the pages once they are consumed.
+ *
+ * On platforms without `mmap()` the `Open()` function returns an error, and
+ * callers are expected to fall back to stream-based I/O.
+ */
+class MappedFileRegion {
+ public:
+  /// Map @p file_name, which must name an existing regular file.
+  static StatusOr<MappedFileRegion> Open(std::string const& file_name);
+
+  ~MappedFileRegion();
+
+  MappedFileRegion(MappedFileRegion&& rhs) noexcept
+      : data_(rhs.data_), size_(rhs.size_) {
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+  }
+  MappedFileRegion& operator=(MappedFileRegion&& rhs) noexcept {
+    MappedFileRegion tmp(std::move(rhs));
+    std::swap(data_, tmp.data_);
+    std::swap(size_, tmp.size_);
+    return *this;
+  }
+  MappedFileRegion(MappedFileRegion const&) = delete;
+  MappedFileRegion& operator=(MappedFileRegion const&) = delete;
+
+  /// The start of the mapped region, nullptr for empty files.
+  char const* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  MappedFileRegion(char const* data, std::size_t size)
+      : data_(data), size_(size) {}
+
+  char const* data_;
+  std::size_t size_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
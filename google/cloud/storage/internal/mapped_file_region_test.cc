@@ -0,0 +1,72 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file_region.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+#ifndef _WIN32
+/// @test Verify that a regular file can be mapped and read back.
+TEST(MappedFileRegionTest, MapRegularFile) {
+  std::string const expected = "The quick brown fox jumps over the lazy dog";
+  testing::TempFile temp_file(expected);
+
+  auto region = MappedFileRegion::Open(temp_file.name());
+  ASSERT_STATUS_OK(region);
+  ASSERT_EQ(expected.size(), region->size());
+  EXPECT_EQ(expected, std::string(region->data(), region->size()));
+}
+
+/// @test Verify that empty files produce an empty (but valid) region.
+TEST(MappedFileRegionTest, EmptyFile) {
+  testing::TempFile temp_file("");
+
+  auto region = MappedFileRegion::Open(temp_file.name());
+  ASSERT_STATUS_OK(region);
+  EXPECT_EQ(0U, region->size());
+}
+
+/// @test Verify that missing files are reported as errors.
+TEST(MappedFileRegionTest, MissingFile) {
+  auto region =
+      MappedFileRegion::Open("/no/such/directory/no-such-file.bin");
+  EXPECT_FALSE(region);
+  EXPECT_EQ(StatusCode::kNotFound, region.status().code());
+}
+#else
+/// @test Verify that platforms without mmap() report an error.
+TEST(MappedFileRegionTest, Unimplemented) {
+  testing::TempFile temp_file("unused");
+
+  auto region = MappedFileRegion::Open(temp_file.name());
+  EXPECT_FALSE(region);
+  EXPECT_EQ(StatusCode::kUnimplemented, region.status().code());
+}
+#endif  // _WIN32
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -20,6 +20,7 @@
 #include "google/cloud/storage/object_metadata.h"
 #include <cinttypes>
 #include <sstream>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -42,8 +43,8 @@ void SetIfNotEmpty(internal::nl::json& json, char const* key,
 }
 }  // namespace
 
-StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
-    internal::nl::json const& json) {
+StatusOr<ObjectMetadata> ObjectMetadataParser::FromJsonImpl(
+    internal::nl::json const& json, bool lazy_acl) {
   if (!json.is_object()) {
     return Status(StatusCode::kInvalidArgument, __func__);
   }
@@ -54,12 +55,17 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   }
 
   if (json.count("acl") != 0) {
-    for (auto const& kv : json["acl"].items()) {
-      auto parsed = ObjectAccessControlParser::FromJson(kv.value());
-      if (!parsed.ok()) {
-        return std::move(parsed).status();
+    if (lazy_acl) {
+      result.raw_acl_ =
+          std::make_shared<std::string const>(json["acl"].dump());
+    } else {
+      for (auto const& kv : json["acl"].items()) {
+        auto parsed = ObjectAccessControlParser::FromJson(kv.value());
+        if (!parsed.ok()) {
+          return std::move(parsed).status();
+        }
+        result.acl_.emplace_back(std::move(*parsed));
       }
-      result.acl_.emplace_back(std::move(*parsed));
     }
   }
 
@@ -72,7 +78,7 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   result.content_type_ = json.value("contentType", "");
   result.crc32c_ = json.value("crc32c", "");
   if (json.count("customerEncryption") != 0) {
-    auto field = json["customerEncryption"];
+    auto const& field = json["customerEncryption"];
     CustomerEncryption e;
     e.encryption_algorithm = field.value("encryptionAlgorithm", "");
     e.key_sha256 = field.value("keySha256", "");
@@ -98,6 +104,16 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   return result;
 }
 
+StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
+    internal::nl::json const& json) {
+  return FromJsonImpl(json, false);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataParser::FromJsonLazyAcl(
+    internal::nl::json const& json) {
+  return FromJsonImpl(json, true);
+}
+
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromString(
     std::string const& payload) {
   auto json = internal::nl::json::parse(payload, nullptr, false);
@@ -194,25 +210,180 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
   return os << "}";
 }
 
-StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
-    std::string const& payload) {
-  auto json = storage::internal::nl::json::parse(payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
+namespace {
+/**
+ * Parse an `Objects: list` response without a DOM for the full page.
+ *
+ * The payload for a page with 1,000 objects can be several MiB, and parsing
+ * it with `nl::json::parse()` creates a DOM of roughly the same size before
+ * a single `ObjectMetadata` is built. This SAX handler builds the DOM for
+ * one element of `items` at a time, converts it to its `ObjectMetadata`, and
+ * discards it before the next element starts, so the transient memory is
+ * bounded by the largest object in the page.
+ */
+class ListObjectsResponseParser : public nl::json::json_sax_t {
+ public:
+  StatusOr<ListObjectsResponse> Result() && {
+    if (!status_.ok()) {
+      return std::move(status_);
+    }
+    if (!found_top_object_) {
+      return Status(StatusCode::kInvalidArgument, "FromHttpResponse");
+    }
+    return std::move(result_);
   }
 
-  ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
+  bool null() override { return Value(nullptr); }
+  bool boolean(bool val) override { return Value(val); }
+  bool number_integer(number_integer_t val) override { return Value(val); }
+  bool number_unsigned(number_unsigned_t val) override { return Value(val); }
+  bool number_float(number_float_t val, string_t const&) override {
+    return Value(val);
+  }
+  bool string(string_t& val) override {
+    if (in_prefixes_) {
+      result_.prefixes.emplace_back(std::move(val));
+      return true;
+    }
+    if (!in_items_ && depth_ == 1 && key_ == "nextPageToken") {
+      result_.next_page_token = std::move(val);
+      return true;
+    }
+    return Value(std::move(val));
+  }
+
+  bool key(string_t& val) override {
+    key_ = std::move(val);
+    return true;
+  }
+
+  bool start_object(std::size_t) override {
+    ++depth_;
+    if (depth_ == 1) {
+      found_top_object_ = true;
+      return true;
+    }
+    if (!in_items_) {
+      return true;
+    }
+    if (stack_.empty()) {
+      item_ = nl::json::object();
+      stack_.push_back(&item_);
+      return true;
+    }
+    stack_.push_back(&NewChild(nl::json::object()));
+    return true;
+  }
 
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::ObjectMetadataParser::FromJson(kv.value());
+  bool end_object() override {
+    --depth_;
+    if (!in_items_ || stack_.empty()) {
+      return true;
+    }
+    stack_.pop_back();
+    if (!stack_.empty()) {
+      return true;
+    }
+    // A full element of `items` is available, convert it and discard the
+    // transient DOM before the next element starts. Use the lazy ACL mode,
+    // most applications never look at the ACLs of listed objects.
+    auto parsed = ObjectMetadataParser::FromJsonLazyAcl(item_);
     if (!parsed.ok()) {
-      return std::move(parsed).status();
+      status_ = std::move(parsed).status();
+      return false;
     }
-    result.items.emplace_back(std::move(*parsed));
+    result_.items.emplace_back(std::move(*parsed));
+    item_ = nl::json();
+    return true;
   }
 
-  return result;
+  bool start_array(std::size_t) override {
+    if (in_items_) {
+      if (stack_.empty()) {
+        return Invalid();
+      }
+      stack_.push_back(&NewChild(nl::json::array()));
+      return true;
+    }
+    if (depth_ == 1 && key_ == "items") {
+      in_items_ = true;
+    } else if (depth_ == 1 && key_ == "prefixes") {
+      in_prefixes_ = true;
+    }
+    return true;
+  }
+
+  bool end_array() override {
+    if (in_prefixes_) {
+      in_prefixes_ = false;
+      return true;
+    }
+    if (!in_items_) {
+      return true;
+    }
+    if (stack_.empty()) {
+      in_items_ = false;
+      return true;
+    }
+    stack_.pop_back();
+    return true;
+  }
+
+  bool parse_error(std::size_t, std::string const&,
+                   nl::detail::exception const& ex) override {
+    status_ = Status(StatusCode::kInvalidArgument, ex.what());
+    return false;
+  }
+
+ private:
+  /// Append @p value to the innermost open container of the current item.
+  nl::json& NewChild(nl::json value) {
+    auto& top = *stack_.back();
+    if (top.is_array()) {
+      top.push_back(std::move(value));
+      return top.back();
+    }
+    auto& child = top[key_];
+    child = std::move(value);
+    return child;
+  }
+
+  template <typename T>
+  bool Value(T&& val) {
+    if (!in_items_) {
+      // Scalars outside of `items` (e.g. `kind`) are ignored.
+      return true;
+    }
+    if (stack_.empty()) {
+      // A scalar directly inside `items` is not a valid object resource.
+      return Invalid();
+    }
+    NewChild(nl::json(std::forward<T>(val)));
+    return true;
+  }
+
+  bool Invalid() {
+    status_ = Status(StatusCode::kInvalidArgument, "FromHttpResponse");
+    return false;
+  }
+
+  ListObjectsResponse result_;
+  Status status_;
+  int depth_ = 0;
+  bool found_top_object_ = false;
+  bool in_items_ = false;
+  bool in_prefixes_ = false;
+  std::string key_;
+  nl::json item_;
+  std::vector<nl::json*> stack_;
+};
+}  // namespace
+
+StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
+    std::string const& payload) {
+  ListObjectsResponseParser parser;
+  nl::json::sax_parse(payload, &parser);
+  return std::move(parser).Result();
 }
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
@@ -230,6 +401,37 @@ std::ostream& operator<<(std::ostream& os, GetObjectMetadataRequest const& r) {
   return os << "}";
 }
 
+namespace {
+// Coalesces @p buffers into @p destination, once. Borrowed buffers remain the
+// source of truth until a code path needs the contents as a single string,
+// this conversion pays the copy that the buffer form exists to avoid, so it
+// only happens for paths (hashing, multipart encoding) that require it.
+void CoalesceInto(std::string& destination, ConstBufferSequence& buffers) {
+  if (buffers.empty()) return;
+  destination.reserve(TotalBytes(buffers));
+  for (auto const& b : buffers) {
+    destination.append(b.data, b.size);
+  }
+  buffers.clear();
+}
+}  // namespace
+
+std::string const& InsertObjectMediaRequest::contents() const {
+  CoalesceInto(contents_, contents_buffers_);
+  return contents_;
+}
+
+ConstBufferSequence InsertObjectMediaRequest::contents_buffers() const {
+  if (!contents_buffers_.empty()) return contents_buffers_;
+  if (contents_.empty()) return ConstBufferSequence{};
+  return ConstBufferSequence{ConstBuffer(contents_)};
+}
+
+std::size_t InsertObjectMediaRequest::contents_size() const {
+  if (!contents_buffers_.empty()) return TotalBytes(contents_buffers_);
+  return contents_.size();
+}
+
 std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r) {
   os << "InsertObjectMediaRequest={bucket_name=" << r.bucket_name()
      << ", object_name=" << r.object_name();
@@ -566,10 +768,26 @@ std::ostream& operator<<(std::ostream& os, ResumableUploadRequest const& r) {
   return os << "}";
 }
 
+std::string const& UploadChunkRequest::payload() const {
+  CoalesceInto(payload_, payload_buffers_);
+  return payload_;
+}
+
+ConstBufferSequence UploadChunkRequest::payload_buffers() const {
+  if (!payload_buffers_.empty()) return payload_buffers_;
+  if (payload_.empty()) return ConstBufferSequence{};
+  return ConstBufferSequence{ConstBuffer(payload_)};
+}
+
+std::size_t UploadChunkRequest::payload_size() const {
+  if (!payload_buffers_.empty()) return TotalBytes(payload_buffers_);
+  return payload_.size();
+}
+
 std::string UploadChunkRequest::RangeHeader() const {
   std::ostringstream os;
   os << "Content-Range: bytes ";
-  if (payload().empty()) {
+  if (payload_size() == 0) {
     // This typically happens when the sender realizes too late that the
     // previous chunk was really the last chunk (e.g. the file is exactly a
     // multiple of the quantum, reading the last chunk from a file, or sending
@@ -577,7 +795,7 @@ std::string UploadChunkRequest::RangeHeader() const {
     // the range is special in this case.
     os << "*";
   } else {
-    os << range_begin() << "-" << range_begin() + payload().size() - 1;
+    os << range_begin() << "-" << range_begin() + payload_size() - 1;
   }
   if (!last_chunk_) {
     os << "/*";
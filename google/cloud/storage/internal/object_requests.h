@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/download_options.h"
 #include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/object_metadata.h"
@@ -31,7 +32,23 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 struct ObjectMetadataParser {
   static StatusOr<ObjectMetadata> FromJson(internal::nl::json const& json);
+
+  /**
+   * Like `FromJson()`, but defers parsing the `acl` field.
+   *
+   * Parsing the access control list dominates the cost of parsing object
+   * resources, and most applications never look at the ACLs of listed
+   * objects. This function stores the raw JSON for the `acl` field in the
+   * `ObjectMetadata`, which parses it on first access.
+   */
+  static StatusOr<ObjectMetadata> FromJsonLazyAcl(
+      internal::nl::json const& json);
+
   static StatusOr<ObjectMetadata> FromString(std::string const& payload);
+
+ private:
+  static StatusOr<ObjectMetadata> FromJsonImpl(internal::nl::json const& json,
+                                               bool lazy_acl);
 };
 
 //@{
@@ -81,6 +98,8 @@ struct ListObjectsResponse {
 
   std::string next_page_token;
   std::vector<ObjectMetadata> items;
+  // The object name prefixes returned when listing with a `Delimiter`.
+  std::vector<std::string> prefixes;
 };
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
@@ -124,14 +143,34 @@ class InsertObjectMediaRequest
       : GenericObjectRequest(std::move(bucket_name), std::move(object_name)),
         contents_(std::move(contents)) {}
 
-  std::string const& contents() const { return contents_; }
+  /**
+   * Creates a request borrowing the contents from @p contents.
+   *
+   * The memory viewed by @p contents must remain valid until the request
+   * completes. Upload paths stream the buffers without coalescing them; code
+   * paths that need the contents as a single string (e.g. to compute hashes)
+   * coalesce them once, on first use.
+   */
+  explicit InsertObjectMediaRequest(std::string bucket_name,
+                                    std::string object_name,
+                                    ConstBufferSequence contents)
+      : GenericObjectRequest(std::move(bucket_name), std::move(object_name)),
+        contents_buffers_(std::move(contents)) {}
+
+  std::string const& contents() const;
   InsertObjectMediaRequest& set_contents(std::string&& v) {
     contents_ = std::move(v);
+    contents_buffers_.clear();
     return *this;
   }
 
+  /// The contents as a sequence of borrowed buffers, without copying.
+  ConstBufferSequence contents_buffers() const;
+  std::size_t contents_size() const;
+
  private:
-  std::string contents_;
+  mutable std::string contents_;
+  mutable ConstBufferSequence contents_buffers_;
 };
 
 std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r);
@@ -176,10 +215,11 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
  */
 class ReadObjectRangeRequest
     : public GenericObjectRequest<
-          ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadFromOffset,
-          ReadRange, ReadLast, UserProject> {
+          ReadObjectRangeRequest, AsyncHashing, DisableCrc32cChecksum,
+          DisableMD5Hash, EncryptionKey, Generation, IfGenerationMatch,
+          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
+          ReadAheadBufferSize, ReadFromOffset, ReadRange, ReadLast,
+          UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 
@@ -356,11 +396,13 @@ std::ostream& operator<<(std::ostream& os, RewriteObjectResponse const& r);
  */
 class ResumableUploadRequest
     : public GenericObjectRequest<
-          ResumableUploadRequest, ContentEncoding, ContentType,
-          Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
+          ResumableUploadRequest, AsyncHashing, BackgroundUploadFlush,
+          ContentEncoding, ContentType, Crc32cChecksumValue,
+          DisableCrc32cChecksum, DisableMD5Hash, EncryptionKey,
+          GzipUploadCompression,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, KmsKeyName, MD5HashValue, PredefinedAcl,
+          Projection, SingleShotUploadThreshold, UseResumableUploadSession,
           UserProject, WithObjectMetadata> {
  public:
   ResumableUploadRequest() = default;
@@ -394,11 +436,41 @@ class UploadChunkRequest : public GenericRequest<UploadChunkRequest> {
         source_size_(source_size),
         last_chunk_(true) {}
 
+  /**
+   * @name Creates a request borrowing the payload from @p payload.
+   *
+   * The memory viewed by @p payload must remain valid until the request
+   * completes. The payload is streamed to the service buffer by buffer,
+   * without coalescing.
+   */
+  //@{
+  UploadChunkRequest(std::string upload_session_url, std::uint64_t range_begin,
+                     ConstBufferSequence payload)
+      : GenericRequest(),
+        upload_session_url_(std::move(upload_session_url)),
+        range_begin_(range_begin),
+        payload_buffers_(std::move(payload)),
+        source_size_(0),
+        last_chunk_(false) {}
+  UploadChunkRequest(std::string upload_session_url, std::uint64_t range_begin,
+                     ConstBufferSequence payload, std::uint64_t source_size)
+      : GenericRequest(),
+        upload_session_url_(std::move(upload_session_url)),
+        range_begin_(range_begin),
+        payload_buffers_(std::move(payload)),
+        source_size_(source_size),
+        last_chunk_(true) {}
+  //@}
+
   std::string const& upload_session_url() const { return upload_session_url_; }
   std::uint64_t range_begin() const { return range_begin_; }
-  std::uint64_t range_end() const { return range_begin_ + payload_.size() - 1; }
+  std::uint64_t range_end() const { return range_begin_ + payload_size() - 1; }
   std::uint64_t source_size() const { return source_size_; }
-  std::string const& payload() const { return payload_; }
+  std::string const& payload() const;
+
+  /// The payload as a sequence of borrowed buffers, without copying.
+  ConstBufferSequence payload_buffers() const;
+  std::size_t payload_size() const;
 
   std::string RangeHeader() const;
 
@@ -420,7 +492,8 @@ class UploadChunkRequest : public GenericRequest<UploadChunkRequest> {
  private:
   std::string upload_session_url_;
   std::uint64_t range_begin_ = 0;
-  std::string payload_;
+  mutable std::string payload_;
+  mutable ConstBufferSequence payload_buffers_;
   std::uint64_t source_size_ = 0;
   bool last_chunk_ = false;
 };
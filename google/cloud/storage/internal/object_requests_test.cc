@@ -130,6 +130,31 @@ TEST(ObjectRequestsTest, ParseListResponseFailureInItems) {
   EXPECT_FALSE(actual.ok());
 }
 
+TEST(ObjectRequestsTest, ParseListResponsePrefixes) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "items": [{"bucket": "foo-bar", "name": "baz"}],
+      "prefixes": ["dir1/", "dir2/"]
+})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text).value();
+  EXPECT_THAT(actual.prefixes, ::testing::ElementsAre("dir1/", "dir2/"));
+  ASSERT_EQ(1U, actual.items.size());
+}
+
+TEST(ObjectRequestsTest, ParseListResponsePageTokenAfterItems) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "items": [{"bucket": "foo-bar", "name": "baz"}],
+      "nextPageToken": "some-token-42"
+})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text).value();
+  EXPECT_EQ("some-token-42", actual.next_page_token);
+  ASSERT_EQ(1U, actual.items.size());
+  EXPECT_EQ("baz", actual.items[0].name());
+}
+
 TEST(ObjectRequestsTest, Get) {
   GetObjectMetadataRequest request("my-bucket", "my-object");
   request.set_multiple_options(Generation(1), IfMetagenerationMatch(3));
@@ -167,6 +192,21 @@ TEST(ObjectRequestsTest, InsertObjectMediaUpdateContents) {
   EXPECT_EQ("new contents", request.contents());
 }
 
+TEST(ObjectRequestsTest, InsertObjectMediaBorrowedContents) {
+  std::string const b0 = "object ";
+  std::string const b1 = "contents";
+  InsertObjectMediaRequest request(
+      "my-bucket", "my-object",
+      ConstBufferSequence{ConstBuffer(b0), ConstBuffer(b1)});
+  EXPECT_EQ(b0.size() + b1.size(), request.contents_size());
+  auto buffers = request.contents_buffers();
+  ASSERT_EQ(2U, buffers.size());
+  EXPECT_EQ(b0.data(), buffers[0].data);
+  EXPECT_EQ(b1.data(), buffers[1].data);
+  // Requesting the contents as a string coalesces the buffers.
+  EXPECT_EQ("object contents", request.contents());
+}
+
 TEST(ObjectRequestsTest, Copy) {
   CopyObjectRequest request("source-bucket", "source-object", "my-bucket",
                             "my-object");
@@ -519,6 +559,21 @@ TEST(ObjectRequestsTest, UploadChunk) {
   EXPECT_THAT(actual, HasSubstr("<Content-Range: bytes 0-5/2048>"));
 }
 
+TEST(ObjectRequestsTest, UploadChunkBorrowedPayload) {
+  std::string const url = "https://unused.googleapis.com/test-only";
+  std::string const b0 = "abc";
+  std::string const b1 = "123";
+  UploadChunkRequest request(
+      url, 0, ConstBufferSequence{ConstBuffer(b0), ConstBuffer(b1)}, 2048);
+  EXPECT_EQ(6, request.payload_size());
+  EXPECT_EQ(5, request.range_end());
+  EXPECT_EQ("Content-Range: bytes 0-5/2048", request.RangeHeader());
+  auto buffers = request.payload_buffers();
+  ASSERT_EQ(2U, buffers.size());
+  EXPECT_EQ(b0.data(), buffers[0].data);
+  EXPECT_EQ("abc123", request.payload());
+}
+
 TEST(ObjectRequestsTest, UploadChunkContentRangeNotLast) {
   std::string const url = "https://unused.googleapis.com/test-only";
   UploadChunkRequest request(url, 1024, "1234");
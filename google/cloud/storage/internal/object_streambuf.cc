@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/object_streambuf.h"
 #include "google/cloud/log.h"
 #include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/upload_checkpoint.h"
 #include "google/cloud/storage/object_stream.h"
 #include <cstring>
 
@@ -25,9 +26,15 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 ObjectReadStreambuf::ObjectReadStreambuf(
     ReadObjectRangeRequest const& request,
-    std::unique_ptr<ObjectReadSource> source)
-    : source_(std::move(source)) {
+    std::unique_ptr<ObjectReadSource> source,
+    std::shared_ptr<BufferAllocator> buffer_allocator)
+    : source_(std::move(source)),
+      current_ios_buffer_(BufferStdAllocator<char>(buffer_allocator)),
+      prefetch_buffer_(BufferStdAllocator<char>(std::move(buffer_allocator))) {
   hash_validator_ = CreateHashValidator(request);
+  if (request.HasOption<ReadAheadBufferSize>()) {
+    prefetch_size_ = request.GetOption<ReadAheadBufferSize>().value();
+  }
 }
 
 ObjectReadStreambuf::ObjectReadStreambuf(ReadObjectRangeRequest const& request,
@@ -38,9 +45,21 @@ ObjectReadStreambuf::ObjectReadStreambuf(ReadObjectRangeRequest const& request,
   status_ = std::move(status);
 }
 
-bool ObjectReadStreambuf::IsOpen() const { return source_->IsOpen(); }
+bool ObjectReadStreambuf::IsOpen() const {
+  if (prefetch_.valid()) {
+    // A background fill is outstanding, so the source is necessarily open.
+    // Checking the source directly would race with the background read.
+    return true;
+  }
+  return source_->IsOpen();
+}
 
 void ObjectReadStreambuf::Close() {
+  if (prefetch_.valid()) {
+    // The source cannot be closed while the background task reads from it.
+    // The prefetched data is discarded, the stream is going away anyway.
+    (void)prefetch_.get();
+  }
   auto response = source_->Close();
   if (!response.ok()) {
     ReportError(std::move(response).status());
@@ -48,6 +67,13 @@ void ObjectReadStreambuf::Close() {
 }
 
 StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
+  if (prefetch_.valid()) {
+    auto next_char = ConsumePrefetch();
+    if (next_char) {
+      StartPrefetch();
+    }
+    return next_char;
+  }
   if (!IsOpen()) {
     // The stream is closed, reading from a closed stream can happen if there is
     // no object to read from, or the object is empty. In that case just setup
@@ -56,16 +82,35 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
     return traits_type::eof();
   }
 
-  auto constexpr kInitialPeekRead = 128 * 1024;
-  current_ios_buffer_.resize(kInitialPeekRead);
-  std::size_t n = current_ios_buffer_.size();
-  StatusOr<ReadSourceResult> read_result =
-      source_->Read(current_ios_buffer_.data(), n);
+  char* data;
+  std::size_t capacity;
+  if (user_buffer_ != nullptr) {
+    data = user_buffer_;
+    capacity = user_buffer_size_;
+  } else {
+    auto constexpr kInitialPeekRead = 128 * 1024;
+    current_ios_buffer_.resize(kInitialPeekRead);
+    data = current_ios_buffer_.data();
+    capacity = current_ios_buffer_.size();
+  }
+  StatusOr<ReadSourceResult> read_result = source_->Read(data, capacity);
+  auto next_char = InstallReadResult(data, std::move(read_result));
+  if (next_char) {
+    StartPrefetch();
+  }
+  return next_char;
+}
+
+StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::InstallReadResult(
+    char* data, StatusOr<ReadSourceResult> read_result) {
   if (!read_result.ok()) {
     return std::move(read_result).status();
   }
-  // assert(n <= current_ios_buffer_.size())
-  current_ios_buffer_.resize(read_result->bytes_received);
+  std::size_t const size = read_result->bytes_received;
+  if (data == current_ios_buffer_.data()) {
+    // assert(size <= current_ios_buffer_.size())
+    current_ios_buffer_.resize(size);
+  }
 
   for (auto const& kv : read_result->response.headers) {
     hash_validator_->ProcessHeader(kv.first, kv.second);
@@ -75,10 +120,9 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
     return AsStatus(read_result->response);
   }
 
-  if (!current_ios_buffer_.empty()) {
-    char* data = current_ios_buffer_.data();
-    hash_validator_->Update(data, current_ios_buffer_.size());
-    setg(data, data, data + current_ios_buffer_.size());
+  if (size != 0) {
+    hash_validator_->Update(data, size);
+    setg(data, data, data + size);
     return traits_type::to_int_type(*data);
   }
 
@@ -88,6 +132,65 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
   return traits_type::eof();
 }
 
+StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::ConsumePrefetch() {
+  // The `get()` call synchronizes with the background thread, after it
+  // returns `source_` and the fill target are safe to use again.
+  auto read_result = prefetch_.get();
+  char* data = prefetch_data_;
+  prefetch_data_ = nullptr;
+  if (data == prefetch_buffer_.data()) {
+    // Swapping the buffers does not move the data, `data` remains valid, it
+    // just points into `current_ios_buffer_` now.
+    current_ios_buffer_.swap(prefetch_buffer_);
+  }
+  return InstallReadResult(data, std::move(read_result));
+}
+
+void ObjectReadStreambuf::StartPrefetch() {
+  if (prefetch_size_ == 0 || !IsOpen()) {
+    return;
+  }
+  std::size_t capacity;
+  if (user_buffer_ != nullptr) {
+    // Fill whichever half of the application's buffer is not the get area.
+    prefetch_data_ = eback() == user_buffer_ ? user_buffer_ + user_buffer_size_
+                                             : user_buffer_;
+    capacity = user_buffer_size_;
+  } else {
+    prefetch_buffer_.resize(prefetch_size_);
+    prefetch_data_ = prefetch_buffer_.data();
+    capacity = prefetch_buffer_.size();
+  }
+  // The background task only touches `source_` and the fill target, and the
+  // consumer thread does not use either one until the future is consumed.
+  auto* source = source_.get();
+  auto* data = prefetch_data_;
+  prefetch_ = std::async(std::launch::async, [source, data, capacity] {
+    return source->Read(data, capacity);
+  });
+}
+
+std::basic_streambuf<char>* ObjectReadStreambuf::setbuf(char* s,
+                                                        std::streamsize n) {
+  // Only accept the buffer before any data is buffered, and never while a
+  // background fill is outstanding.
+  if (s == nullptr || n <= 0 || prefetch_.valid() || in_avail() > 0) {
+    return this;
+  }
+  auto size = static_cast<std::size_t>(n);
+  if (prefetch_size_ != 0) {
+    // With read-ahead the buffer is split in halves, one is consumed while
+    // the other one is filled in the background.
+    size /= 2;
+  }
+  if (size == 0) {
+    return this;
+  }
+  user_buffer_ = s;
+  user_buffer_size_ = size;
+  return this;
+}
+
 ObjectReadStreambuf::int_type ObjectReadStreambuf::underflow() {
   auto next_char = Peek();
   if (!next_char) {
@@ -179,31 +282,60 @@ std::streamsize ObjectReadStreambuf::xsgetn(char* s, std::streamsize count) {
     return run_validator_if_closed(Status());
   }
 
-  StatusOr<ReadSourceResult> read_result =
-      source_->Read(s + offset, static_cast<std::size_t>(count - offset));
-  // If there was an error set the internal state, but we still return the
-  // number of bytes.
-  if (!read_result) {
+  // A background fill may be outstanding, consume it before touching the
+  // source directly; the `get()` call synchronizes with the background
+  // thread.
+  if (prefetch_.valid()) {
+    auto next_char = ConsumePrefetch();
+    if (!next_char) {
+      return run_validator_if_closed(std::move(next_char).status());
+    }
+    auto from_prefetch = (std::min)(count - offset, in_avail());
+    std::memcpy(s + offset, gptr(), static_cast<std::size_t>(from_prefetch));
+    gbump(static_cast<int>(from_prefetch));
+    offset += from_prefetch;
+    if (offset >= count || !IsOpen()) {
+      StartPrefetch();
+      return run_validator_if_closed(Status());
+    }
+  }
+
+  // Keep reading directly into the application's buffer until it is full, or
+  // the download completes. A single `Read()` may return less data than
+  // requested, returning early in that case would make the caller's
+  // `stream.read()` fail with a spurious short count.
+  while (offset < count && IsOpen()) {
+    StatusOr<ReadSourceResult> read_result =
+        source_->Read(s + offset, static_cast<std::size_t>(count - offset));
+    // If there was an error set the internal state, but we still return the
+    // number of bytes.
+    if (!read_result) {
+      GCP_LOG(INFO) << __func__ << "(): count=" << count
+                    << ", in_avail=" << in_avail() << ", offset=" << offset
+                    << ", status=" << read_result.status();
+      return run_validator_if_closed(std::move(read_result).status());
+    }
     GCP_LOG(INFO) << __func__ << "(): count=" << count
                   << ", in_avail=" << in_avail() << ", offset=" << offset
-                  << ", status=" << read_result.status();
-    return run_validator_if_closed(std::move(read_result).status());
-  }
-  GCP_LOG(INFO) << __func__ << "(): count=" << count
-                << ", in_avail=" << in_avail() << ", offset=" << offset
-                << ", read_result->bytes_received="
-                << read_result->bytes_received;
+                  << ", read_result->bytes_received="
+                  << read_result->bytes_received;
 
-  hash_validator_->Update(s + offset, read_result->bytes_received);
-  offset += read_result->bytes_received;
+    hash_validator_->Update(s + offset, read_result->bytes_received);
+    offset += read_result->bytes_received;
 
-  for (auto const& kv : read_result->response.headers) {
-    hash_validator_->ProcessHeader(kv.first, kv.second);
-    headers_.emplace(kv.first, kv.second);
-  }
-  if (read_result->response.status_code >= HttpStatusCode::kMinNotSuccess) {
-    return run_validator_if_closed(AsStatus(read_result->response));
+    for (auto const& kv : read_result->response.headers) {
+      hash_validator_->ProcessHeader(kv.first, kv.second);
+      headers_.emplace(kv.first, kv.second);
+    }
+    if (read_result->response.status_code >= HttpStatusCode::kMinNotSuccess) {
+      return run_validator_if_closed(AsStatus(read_result->response));
+    }
+    if (read_result->bytes_received == 0) {
+      // This is an actual EOF, stop instead of spinning on empty reads.
+      break;
+    }
   }
+  StartPrefetch();
   return run_validator_if_closed(Status());
 }
 
@@ -236,9 +368,16 @@ void ObjectReadStreambuf::SetEmptyRegion() {
 
 ObjectWriteStreambuf::ObjectWriteStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
-    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator)
+    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator,
+    std::unique_ptr<GzipCompressor> gzip_compressor, bool background_flush,
+    std::shared_ptr<BufferAllocator> buffer_allocator)
     : upload_session_(std::move(upload_session)),
+      current_ios_buffer_(BufferStdAllocator<char>(buffer_allocator)),
       max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
+      gzip_compressor_(std::move(gzip_compressor)),
+      background_flush_(background_flush && !gzip_compressor_),
+      upload_staging_(BufferStdAllocator<char>(buffer_allocator)),
+      in_flight_chunk_(BufferStdAllocator<char>(std::move(buffer_allocator))),
       hash_validator_(std::move(hash_validator)),
       last_response_(ResumableUploadResponse{
           {}, 0, {}, ResumableUploadResponse::kInProgress, {}}) {
@@ -260,9 +399,40 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Close() {
 }
 
 bool ObjectWriteStreambuf::IsOpen() const {
+  if (in_flight_.valid()) {
+    // A background upload is outstanding, so the session is necessarily
+    // open. Checking it directly would race with the background task.
+    return true;
+  }
   return static_cast<bool>(upload_session_) && !upload_session_->done();
 }
 
+StatusOr<std::string> ObjectWriteStreambuf::Checkpoint() const {
+  if (!IsOpen()) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "cannot checkpoint a closed upload");
+  }
+  if (gzip_compressor_) {
+    return Status(StatusCode::kUnimplemented,
+                  "cannot checkpoint a compressed upload, the compression"
+                  " state is not serializable");
+  }
+  if (pptr() != pbase() || !upload_staging_.empty() || in_flight_.valid()) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "cannot checkpoint with unflushed data, call flush() and"
+                  " note that only full chunks can be committed");
+  }
+  UploadSessionCheckpoint chk;
+  chk.session_id = upload_session_->session_id();
+  if (chk.session_id.empty()) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "only resumable uploads can be checkpointed");
+  }
+  chk.next_expected_byte = upload_session_->next_expected_byte();
+  chk.hash_state = hash_validator_->State();
+  return SerializeUploadCheckpoint(chk);
+}
+
 bool ObjectWriteStreambuf::ValidateHash(ObjectMetadata const& meta) {
   hash_validator_->ProcessMetadata(meta);
   hash_validator_result_ = std::move(*hash_validator_).Finish();
@@ -331,17 +501,41 @@ ObjectWriteStreambuf::int_type ObjectWriteStreambuf::overflow(int_type ch) {
   return ch;
 }
 
+std::basic_streambuf<char>* ObjectWriteStreambuf::setbuf(char* s,
+                                                         std::streamsize n) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  // Only accept the buffer before any data is buffered or uploaded, and only
+  // if it can hold at least one full upload chunk.
+  if (s == nullptr || n < static_cast<std::streamsize>(quantum) ||
+      pptr() != pbase() || !upload_staging_.empty() || in_flight_.valid() ||
+      (upload_session_ && upload_session_->next_expected_byte() != 0)) {
+    return this;
+  }
+  // Round down to a multiple of the upload quantum, intermediate chunks must
+  // be uploaded in quantum multiples.
+  max_buffer_size_ = static_cast<std::size_t>(n) / quantum * quantum;
+  setp(s, s + max_buffer_size_);
+  return this;
+}
+
 StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::FlushFinal() {
   if (!IsOpen()) {
     return last_response_;
   }
+  if (gzip_compressor_) {
+    return FlushGzip(true);
+  }
+  if (background_flush_) {
+    return FlushAsync(true);
+  }
   // Shorten the buffer to the actual used size.
   auto actual_size = static_cast<std::size_t>(pptr() - pbase());
   std::size_t upload_size = upload_session_->next_expected_byte() + actual_size;
   hash_validator_->Update(pbase(), actual_size);
 
-  std::string to_upload(pbase(), actual_size);
-  last_response_ = upload_session_->UploadFinalChunk(to_upload, upload_size);
+  // The session only borrows views of the put area, the chunk is not copied.
+  last_response_ = upload_session_->UploadFinalChunk(
+      ConstBufferSequence{ConstBuffer(pbase(), actual_size)}, upload_size);
   if (!last_response_) {
     // This was an unrecoverable error, time to store status and signal an
     // error.
@@ -366,6 +560,12 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
   if (actual_size < max_buffer_size_) {
     return last_response_;
   }
+  if (gzip_compressor_) {
+    return FlushGzip(false);
+  }
+  if (background_flush_) {
+    return FlushAsync(false);
+  }
 
   auto chunk_count = actual_size / UploadChunkRequest::kChunkSizeQuantum;
   auto chunk_size = chunk_count * UploadChunkRequest::kChunkSizeQuantum;
@@ -375,9 +575,9 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
   auto expected_next_byte = upload_session_->next_expected_byte() + chunk_size;
 
   hash_validator_->Update(pbase(), chunk_size);
-  StatusOr<ResumableUploadResponse> result;
-  std::string to_send(pbase(), chunk_size);
-  last_response_ = upload_session_->UploadChunk(to_send);
+  // The session only borrows views of the put area, the chunk is not copied.
+  last_response_ = upload_session_->UploadChunk(
+      ConstBufferSequence{ConstBuffer(pbase(), chunk_size)});
   if (!last_response_) {
     return last_response_;
   }
@@ -405,6 +605,174 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
   return last_response_;
 }
 
+StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::FlushGzip(
+    bool final_chunk) {
+  // Compress the put area into `compressed_buffer_`. The compressor keeps its
+  // deflate context across calls, so this extends a single gzip stream.
+  auto actual_size = static_cast<std::size_t>(pptr() - pbase());
+  auto previous_size = compressed_buffer_.size();
+  auto status = gzip_compressor_->Compress(pbase(), actual_size,
+                                           compressed_buffer_, final_chunk);
+  if (!status.ok()) {
+    last_response_ = std::move(status);
+    return last_response_;
+  }
+  // The service stores (and reports hashes for) the compressed bytes, so the
+  // hashes must cover those. Each compressed byte is produced exactly once,
+  // hash it as it is produced rather than as it is uploaded.
+  hash_validator_->Update(compressed_buffer_.data() + previous_size,
+                          compressed_buffer_.size() - previous_size);
+  // All the staged bytes were consumed by the compressor, reset the put area.
+  setp(pbase(), epptr());
+
+  if (final_chunk) {
+    std::size_t upload_size =
+        upload_session_->next_expected_byte() + compressed_buffer_.size();
+    last_response_ = upload_session_->UploadFinalChunk(
+        ConstBufferSequence{ConstBuffer(compressed_buffer_)}, upload_size);
+    if (!last_response_) {
+      return last_response_;
+    }
+    compressed_buffer_.clear();
+    // Reset the iostream put area with valid pointers, but empty.
+    current_ios_buffer_.resize(1);
+    auto pbeg = current_ios_buffer_.data();
+    setp(pbeg, pbeg);
+    upload_session_.reset();
+    return last_response_;
+  }
+
+  // Intermediate chunks must be a multiple of the upload quantum, keep any
+  // excess compressed bytes for the next flush.
+  auto chunk_count =
+      compressed_buffer_.size() / UploadChunkRequest::kChunkSizeQuantum;
+  auto chunk_size = chunk_count * UploadChunkRequest::kChunkSizeQuantum;
+  if (chunk_size == 0) {
+    // Compressible data often shrinks below one quantum, just accumulate
+    // more compressed bytes before uploading.
+    return last_response_;
+  }
+  auto expected_next_byte = upload_session_->next_expected_byte() + chunk_size;
+  last_response_ = upload_session_->UploadChunk(
+      ConstBufferSequence{ConstBuffer(compressed_buffer_.data(), chunk_size)});
+  if (!last_response_) {
+    return last_response_;
+  }
+  auto actual_next_byte = upload_session_->next_expected_byte();
+  auto bytes_uploaded = static_cast<int64_t>(chunk_size);
+  if (actual_next_byte < expected_next_byte) {
+    bytes_uploaded -= expected_next_byte - actual_next_byte;
+    if (bytes_uploaded < 0) {
+      std::ostringstream error_message;
+      error_message << "Could not continue upload stream. GCS requested byte "
+                    << actual_next_byte << " which has already been uploaded.";
+      return Status(StatusCode::kAborted, error_message.str());
+    }
+  } else if (actual_next_byte > expected_next_byte) {
+    std::ostringstream error_message;
+    error_message << "Could not continue upload stream. "
+                  << "GCS requested unexpected byte. (expected: "
+                  << expected_next_byte << ", actual: " << actual_next_byte
+                  << ")";
+    return Status(StatusCode::kAborted, error_message.str());
+  }
+  compressed_buffer_.erase(0, static_cast<std::size_t>(bytes_uploaded));
+  return last_response_;
+}
+
+StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::WaitForInFlight() {
+  if (!in_flight_.valid()) {
+    return last_response_;
+  }
+  // The `get()` call synchronizes with the background task, after it returns
+  // `upload_session_` and `in_flight_chunk_` are safe to use again.
+  last_response_ = in_flight_.get();
+  if (!last_response_) {
+    return last_response_;
+  }
+  auto expected_next_byte = in_flight_expected_byte_;
+  auto actual_next_byte = upload_session_->next_expected_byte();
+  if (actual_next_byte < expected_next_byte) {
+    auto not_accepted = expected_next_byte - actual_next_byte;
+    if (not_accepted > in_flight_chunk_.size()) {
+      std::ostringstream error_message;
+      error_message << "Could not continue upload stream. GCS requested byte "
+                    << actual_next_byte << " which has already been uploaded.";
+      return Status(StatusCode::kAborted, error_message.str());
+    }
+    // Bytes the service did not accept must be retransmitted before any data
+    // staged later. They were already hashed, do not hash them again.
+    upload_staging_.insert(0, in_flight_chunk_,
+                           in_flight_chunk_.size() -
+                               static_cast<std::size_t>(not_accepted),
+                           BufferString::npos);
+  } else if (actual_next_byte > expected_next_byte) {
+    std::ostringstream error_message;
+    error_message << "Could not continue upload stream. "
+                  << "GCS requested unexpected byte. (expected: "
+                  << expected_next_byte << ", actual: " << actual_next_byte
+                  << ")";
+    return Status(StatusCode::kAborted, error_message.str());
+  }
+  in_flight_chunk_.clear();
+  return last_response_;
+}
+
+StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::FlushAsync(
+    bool final_chunk) {
+  auto result = WaitForInFlight();
+  if (!result) {
+    return result;
+  }
+  // Move the put area into the staging buffer, hashing each byte exactly
+  // once, and hand the (now empty) put area back to the writer.
+  auto actual_size = static_cast<std::size_t>(pptr() - pbase());
+  hash_validator_->Update(pbase(), actual_size);
+  upload_staging_.append(pbase(), actual_size);
+  setp(pbase(), epptr());
+
+  if (final_chunk) {
+    std::size_t upload_size =
+        upload_session_->next_expected_byte() + upload_staging_.size();
+    last_response_ = upload_session_->UploadFinalChunk(
+        ConstBufferSequence{
+            ConstBuffer(upload_staging_.data(), upload_staging_.size())},
+        upload_size);
+    if (!last_response_) {
+      return last_response_;
+    }
+    upload_staging_.clear();
+    // Reset the iostream put area with valid pointers, but empty.
+    current_ios_buffer_.resize(1);
+    auto pbeg = current_ios_buffer_.data();
+    setp(pbeg, pbeg);
+    upload_session_.reset();
+    return last_response_;
+  }
+
+  // Intermediate chunks must be a multiple of the upload quantum, keep any
+  // excess bytes staged for the next flush.
+  auto chunk_count =
+      upload_staging_.size() / UploadChunkRequest::kChunkSizeQuantum;
+  auto chunk_size = chunk_count * UploadChunkRequest::kChunkSizeQuantum;
+  if (chunk_size == 0) {
+    return last_response_;
+  }
+  in_flight_chunk_.assign(upload_staging_, 0, chunk_size);
+  upload_staging_.erase(0, chunk_size);
+  in_flight_expected_byte_ = upload_session_->next_expected_byte() + chunk_size;
+  // The background task only touches `upload_session_` and
+  // `in_flight_chunk_`, and the writer thread does not use either one until
+  // the future is consumed.
+  auto* session = upload_session_.get();
+  auto* chunk = &in_flight_chunk_;
+  in_flight_ = std::async(std::launch::async, [session, chunk] {
+    return session->UploadChunk(
+        ConstBufferSequence{ConstBuffer(chunk->data(), chunk->size())});
+  });
+  return last_response_;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
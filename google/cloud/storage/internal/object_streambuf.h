@@ -16,11 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 
 #include "google/cloud/status_or.h"
+#include "google/cloud/storage/buffer_allocator.h"
+#include "google/cloud/storage/internal/gzip_compressor.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/version.h"
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -41,8 +44,16 @@ namespace internal {
  */
 class ObjectReadStreambuf : public std::basic_streambuf<char> {
  public:
+  /**
+   * @param request the request that created the download.
+   * @param source the (possibly mocked) download connection.
+   * @param buffer_allocator if not null, the transfer buffers are obtained
+   *     from this allocator instead of the regular heap.
+   */
   ObjectReadStreambuf(ReadObjectRangeRequest const& request,
-                      std::unique_ptr<ObjectReadSource> source);
+                      std::unique_ptr<ObjectReadSource> source,
+                      std::shared_ptr<BufferAllocator> buffer_allocator =
+                          nullptr);
 
   /// Create a streambuf in a permanent error status.
   ObjectReadStreambuf(ReadObjectRangeRequest const& request, Status status);
@@ -72,15 +83,55 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
   void SetEmptyRegion();
   StatusOr<int_type> Peek();
 
+  /**
+   * Make the contents of @p read_result, stored at @p data, the new get area.
+   *
+   * Updates the hashes and the response headers. Returns the first character
+   * in the new get area, EOF when @p read_result is an empty (final) chunk,
+   * or the error status.
+   */
+  StatusOr<int_type> InstallReadResult(char* data,
+                                       StatusOr<ReadSourceResult> read_result);
+
+  /// Consume the outstanding background fill and install it as the get area.
+  StatusOr<int_type> ConsumePrefetch();
+
+  /// Start a background fill, if read-ahead is enabled and none is pending.
+  void StartPrefetch();
+
   int_type underflow() override;
   std::streamsize xsgetn(char* s, std::streamsize count) override;
 
+  /**
+   * Use an application-provided get area.
+   *
+   * The buffer is only accepted before any data is buffered, and never while
+   * a background fill is outstanding. With read-ahead enabled the buffer is
+   * split in halves, one is consumed while the other one is filled in the
+   * background. The buffer must outlive the stream.
+   */
+  std::basic_streambuf<char>* setbuf(char* s, std::streamsize n) override;
+
   std::unique_ptr<ObjectReadSource> source_;
-  std::vector<char> current_ios_buffer_;
+  BufferVector current_ios_buffer_;
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
   Status status_;
   std::multimap<std::string, std::string> headers_;
+
+  /// The read-ahead buffer size, 0 disables read-ahead.
+  std::size_t prefetch_size_ = 0;
+  /// Filled by the background task while the get area is consumed.
+  BufferVector prefetch_buffer_;
+  /// Where the pending background fill stores its data.
+  char* prefetch_data_ = nullptr;
+  /// The pending background fill, if `valid()` the background task owns
+  /// `source_` and the fill target until the future is consumed.
+  std::future<StatusOr<ReadSourceResult>> prefetch_;
+  /// The application-provided buffer, nullptr to use the internal buffers.
+  char* user_buffer_ = nullptr;
+  /// The usable size of `user_buffer_` (halved when read-ahead is enabled).
+  std::size_t user_buffer_size_ = 0;
 };
 
 /**
@@ -94,9 +145,31 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
  public:
   ObjectWriteStreambuf() = default;
 
+  /**
+   * @param upload_session the (possibly mocked) service connection.
+   * @param max_buffer_size the size of the put area.
+   * @param hash_validator validates the server-side hashes on Close().
+   * @param gzip_compressor if not null, the buffered data is compressed as
+   *     it is flushed, and the service stores the compressed bytes. The
+   *     compressor keeps its deflate context across chunks, so the stored
+   *     object is a single valid gzip stream.
+   * @param background_flush if true, intermediate chunks are uploaded by a
+   *     background task while the application fills the next buffer. At most
+   *     one chunk is in flight at a time, and upload errors are reported on
+   *     the next flush (or on `Close()`). Ignored when @p gzip_compressor is
+   *     set, the compression path uploads synchronously.
+   * @param buffer_allocator if not null, the put area and the staging
+   *     buffers are obtained from this allocator instead of the regular
+   *     heap.
+   */
   ObjectWriteStreambuf(std::unique_ptr<ResumableUploadSession> upload_session,
                        std::size_t max_buffer_size,
-                       std::unique_ptr<HashValidator> hash_validator);
+                       std::unique_ptr<HashValidator> hash_validator,
+                       std::unique_ptr<GzipCompressor> gzip_compressor =
+                           nullptr,
+                       bool background_flush = false,
+                       std::shared_ptr<BufferAllocator> buffer_allocator =
+                           nullptr);
 
   ~ObjectWriteStreambuf() override = default;
 
@@ -126,6 +199,17 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
     return upload_session_->next_expected_byte();
   }
 
+  /**
+   * Export a binary checkpoint of the upload state.
+   *
+   * The checkpoint captures the session id, the committed byte count, and
+   * the running hash state. Passing it to `RestoreResumableUploadSession()`
+   * resumes the upload without querying the service for the committed byte
+   * count. Only valid at a flush boundary, i.e., when all buffered data has
+   * been uploaded, call `flush()` on the stream first.
+   */
+  virtual StatusOr<std::string> Checkpoint() const;
+
   virtual Status last_status() const { return last_response_.status(); }
 
  protected:
@@ -133,6 +217,16 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   std::streamsize xsputn(char const* s, std::streamsize count) override;
   int_type overflow(int_type ch) override;
 
+  /**
+   * Use an application-provided put area.
+   *
+   * The buffer is only accepted before any data is buffered or uploaded, and
+   * only if it can hold at least one full upload chunk. The usable size is
+   * rounded down to a multiple of the upload quantum. The buffer must
+   * outlive the stream.
+   */
+  std::basic_streambuf<char>* setbuf(char* s, std::streamsize n) override;
+
  private:
   /// Flush any data if possible.
   StatusOr<ResumableUploadResponse> Flush();
@@ -140,11 +234,55 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   /// Flush any remaining data and commit the upload.
   StatusOr<ResumableUploadResponse> FlushFinal();
 
+  /**
+   * Compress the put area into `compressed_buffer_` and upload from there.
+   *
+   * Used instead of the plain upload path when a compressor is installed.
+   * When @p final_chunk is false only full chunk quanta are uploaded, the
+   * remaining compressed bytes stay in `compressed_buffer_` for the next
+   * flush.
+   */
+  StatusOr<ResumableUploadResponse> FlushGzip(bool final_chunk);
+
+  /**
+   * Move the put area into the staging buffer and upload in the background.
+   *
+   * Used instead of the plain upload path when background flushing is
+   * enabled. The writer thread keeps filling the put area while the
+   * background task uploads the previous chunk.
+   */
+  StatusOr<ResumableUploadResponse> FlushAsync(bool final_chunk);
+
+  /**
+   * Wait for the outstanding background upload, if any.
+   *
+   * Checks the server-committed byte count, re-staging any bytes the service
+   * did not accept so they are retransmitted with the next chunk.
+   */
+  StatusOr<ResumableUploadResponse> WaitForInFlight();
+
   std::unique_ptr<ResumableUploadSession> upload_session_;
 
-  std::vector<char> current_ios_buffer_;
+  BufferVector current_ios_buffer_;
   std::size_t max_buffer_size_;
 
+  /// Not null iff the upload is compressed as it is streamed.
+  std::unique_ptr<GzipCompressor> gzip_compressor_;
+  /// Compressed bytes not yet uploaded, empty for uncompressed uploads.
+  std::string compressed_buffer_;
+
+  /// True iff intermediate chunks are uploaded by a background task.
+  bool background_flush_ = false;
+  /// Bytes moved out of the put area but not yet sent (async mode only).
+  BufferString upload_staging_;
+  /// The chunk currently uploaded by the background task.
+  BufferString in_flight_chunk_;
+  /// The next expected byte once the in-flight chunk is fully accepted.
+  std::uint64_t in_flight_expected_byte_ = 0;
+  /// The pending background upload, if `valid()` the background task owns
+  /// `upload_session_` and `in_flight_chunk_` until the future is consumed.
+  std::future<StatusOr<ResumableUploadResponse>> in_flight_;
+
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
 
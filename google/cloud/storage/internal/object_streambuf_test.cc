@@ -14,11 +14,16 @@
 
 #include "google/cloud/storage/internal/object_streambuf.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/internal/upload_checkpoint.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <zlib.h>
+#include <cstring>
+#include <iterator>
+#include <random>
 
 namespace google {
 namespace cloud {
@@ -48,7 +53,7 @@ TEST(ObjectWriteStreambufTest, EmptyStream) {
 
   int count = 0;
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(1, count);
         EXPECT_TRUE(p.empty());
@@ -76,10 +81,10 @@ TEST(ObjectWriteStreambufTest, SmallStream) {
 
   int count = 0;
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(payload.size(), s);
         auto last_committed_byte = payload.size() - 1;
         return make_status_or(
@@ -112,17 +117,19 @@ TEST(ObjectWriteStreambufTest, EmptyTrailer) {
 
   int count = 0;
   size_t next_byte = 0;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    EXPECT_EQ(payload, p);
-    auto last_committed_byte = payload.size() - 1;
-    next_byte = last_committed_byte + 1;
-    return make_status_or(ResumableUploadResponse{
-        "", last_committed_byte, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        EXPECT_EQ(payload, ToString(p));
+        auto last_committed_byte = payload.size() - 1;
+        next_byte = last_committed_byte + 1;
+        return make_status_or(ResumableUploadResponse{
+            "", last_committed_byte, {}, ResumableUploadResponse::kInProgress,
+            {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(2, count);
         EXPECT_TRUE(p.empty());
@@ -204,21 +211,23 @@ TEST(ObjectWriteStreambufTest, FlushAfterFullQuantum) {
 
   int count = 0;
   size_t next_byte = 0;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    auto expected = payload_1 + payload_2.substr(0, quantum - payload_1.size());
-    EXPECT_EQ(expected, p);
-    next_byte += p.size();
-    return make_status_or(ResumableUploadResponse{
-        "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        auto expected =
+            payload_1 + payload_2.substr(0, quantum - payload_1.size());
+        EXPECT_EQ(expected, ToString(p));
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(2, count);
         auto expected = payload_2.substr(payload_2.size() - payload_1.size());
-        EXPECT_EQ(expected, p);
+        EXPECT_EQ(expected, ToString(p));
         EXPECT_EQ(payload_1.size() + payload_2.size(), s);
         auto last_committed_byte = payload_1.size() + payload_2.size() - 1;
         return make_status_or(
@@ -242,6 +251,62 @@ TEST(ObjectWriteStreambufTest, FlushAfterFullQuantum) {
   EXPECT_STATUS_OK(response);
 }
 
+/// @test Verify that a checkpoint can be exported at a flush boundary.
+TEST(ObjectWriteStreambufTest, CheckpointAtFlushBoundary) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(quantum, '*');
+  std::string const id = "test-session-id";
+
+  size_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
+    return next_byte;
+  }));
+  EXPECT_CALL(*mock, session_id).WillRepeatedly(ReturnRef(id));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>());
+
+  streambuf.sputn(payload.data(), payload.size());
+  streambuf.pubsync();
+
+  auto blob = streambuf.Checkpoint();
+  ASSERT_STATUS_OK(blob);
+  auto chk = ParseUploadCheckpoint(*blob);
+  ASSERT_STATUS_OK(chk);
+  EXPECT_EQ(id, chk->session_id);
+  EXPECT_EQ(quantum, chk->next_expected_byte);
+}
+
+/// @test Verify that checkpoints are rejected while data is buffered.
+TEST(ObjectWriteStreambufTest, CheckpointWithUnflushedData) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>());
+
+  std::string const payload = "unflushed";
+  streambuf.sputn(payload.data(), payload.size());
+
+  auto blob = streambuf.Checkpoint();
+  EXPECT_FALSE(blob);
+  EXPECT_EQ(StatusCode::kFailedPrecondition, blob.status().code());
+}
+
 /// @test Verify that a stream flushes when adding one character at a time.
 TEST(ObjectWriteStreambufTest, OverflowFlushAtFullQuantum) {
   auto mock = google::cloud::internal::make_unique<
@@ -252,17 +317,18 @@ TEST(ObjectWriteStreambufTest, OverflowFlushAtFullQuantum) {
 
   int count = 0;
   size_t next_byte = 0;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    auto expected = payload;
-    EXPECT_EQ(expected, p);
-    next_byte += p.size();
-    return make_status_or(ResumableUploadResponse{
-        "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        auto expected = payload;
+        EXPECT_EQ(expected, ToString(p));
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(2, count);
         EXPECT_TRUE(p.empty());
@@ -301,20 +367,21 @@ TEST(ObjectWriteStreambufTest, SomeBytesNotAccepted) {
 
   size_t next_byte = 0;
   uint64_t const bytes_uploaded_first_try = quantum - 1;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    auto expected = payload.substr(0, quantum);
-    EXPECT_EQ(expected, p);
-    next_byte += bytes_uploaded_first_try;
-    return make_status_or(
-        ResumableUploadResponse{"",
-                                bytes_uploaded_first_try - 1,
-                                {},
-                                ResumableUploadResponse::kInProgress,
-                                {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        auto expected = payload.substr(0, quantum);
+        EXPECT_EQ(expected, ToString(p));
+        next_byte += bytes_uploaded_first_try;
+        return make_status_or(
+            ResumableUploadResponse{"",
+                                    bytes_uploaded_first_try - 1,
+                                    {},
+                                    ResumableUploadResponse::kInProgress,
+                                    {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
-        EXPECT_EQ(p, payload.substr(bytes_uploaded_first_try));
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        EXPECT_EQ(payload.substr(bytes_uploaded_first_try), ToString(p));
         EXPECT_EQ(payload.size(), s);
         auto last_committed_byte = payload.size() - 1;
         return make_status_or(
@@ -349,13 +416,14 @@ TEST(ObjectWriteStreambufTest, NextExpectedByteJumpsAhead) {
   std::string const payload = std::string(quantum * 2, '*');
 
   size_t next_byte = 0;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    next_byte += quantum * 2;
-    auto expected = payload.substr(0, quantum);
-    EXPECT_EQ(expected, p);
-    return make_status_or(ResumableUploadResponse{
-        "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        next_byte += quantum * 2;
+        auto expected = payload.substr(0, quantum);
+        EXPECT_EQ(expected, ToString(p));
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
   EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
     return next_byte;
   }));
@@ -416,21 +484,23 @@ TEST(ObjectWriteStreambufTest, MixPutcPutn) {
 
   int count = 0;
   size_t next_byte = 0;
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    auto expected = payload_1 + payload_2.substr(0, quantum - payload_1.size());
-    EXPECT_EQ(expected, p);
-    next_byte += p.size();
-    return make_status_or(ResumableUploadResponse{
-        "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        auto expected =
+            payload_1 + payload_2.substr(0, quantum - payload_1.size());
+        EXPECT_EQ(expected, ToString(p));
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
         ++count;
         EXPECT_EQ(2, count);
         auto expected = payload_2.substr(payload_2.size() - payload_1.size());
-        EXPECT_EQ(expected, p);
+        EXPECT_EQ(expected, ToString(p));
         EXPECT_EQ(payload_1.size() + payload_2.size(), s);
         auto last_committed_byte = payload_1.size() + payload_2.size() - 1;
         return make_status_or(
@@ -486,10 +556,10 @@ TEST(ObjectWriteStreambufTest, ErroneousStream) {
 
   int count = 0;
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::uint64_t n) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t n) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(payload.size(), n);
         return Status(StatusCode::kInvalidArgument, "Invalid Argument");
       }));
@@ -540,6 +610,455 @@ TEST(ObjectWriteStreambufTest, ErrorInLargePayload) {
   EXPECT_EQ(StatusCode::kInvalidArgument, response.status().code())
       << ", status=" << response.status();
 }
+
+/// Decompress a gzip stream produced by the streaming compressed uploads.
+std::string GzipInflateForTest(std::string const& compressed) {
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // 15 + 16 selects the gzip wrapper, see `inflateInit2()`.
+  EXPECT_EQ(Z_OK, inflateInit2(&stream, 15 + 16));
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  std::string result;
+  std::vector<char> buffer(128 * 1024);
+  int status;
+  do {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+    stream.avail_out = static_cast<uInt>(buffer.size());
+    status = inflate(&stream, Z_NO_FLUSH);
+    EXPECT_TRUE(status == Z_OK || status == Z_STREAM_END);
+    result.append(buffer.data(), buffer.size() - stream.avail_out);
+  } while (status == Z_OK);
+  EXPECT_EQ(Z_STREAM_END, status);
+  inflateEnd(&stream);
+  return result;
+}
+
+/// @test Verify that compressed uploads produce a valid gzip object.
+TEST(ObjectWriteStreambufTest, GzipCompressedUpload) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(3 * quantum, '*');
+
+  // The payload is highly compressible, it shrinks below one quantum, so all
+  // the compressed bytes are sent in the final chunk.
+  EXPECT_CALL(*mock, UploadChunk(_)).Times(0);
+  std::string uploaded;
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        uploaded = ToString(p);
+        EXPECT_EQ(TotalBytes(p), s);
+        return make_status_or(ResumableUploadResponse{
+            "{}", TotalBytes(p) - 1, {}, ResumableUploadResponse::kInProgress,
+            {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>(),
+      google::cloud::internal::make_unique<GzipCompressor>());
+
+  streambuf.sputn(payload.data(), payload.size());
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+
+  EXPECT_LT(uploaded.size(), payload.size());
+  EXPECT_EQ(payload, GzipInflateForTest(uploaded));
+}
+
+/// @test Verify that large compressed uploads send quantum-aligned chunks.
+TEST(ObjectWriteStreambufTest, GzipCompressedUploadChunks) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  // Incompressible (pseudo-random) data does not shrink, so the compressed
+  // stream exceeds one quantum and intermediate chunks are uploaded.
+  std::string payload(4 * quantum, ' ');
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto& c : payload) {
+    c = static_cast<char>(dist(gen));
+  }
+
+  std::string uploaded;
+  std::size_t chunk_count = 0;
+  std::size_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillRepeatedly(Invoke([&](ConstBufferSequence const& p) {
+        ++chunk_count;
+        EXPECT_EQ(0, TotalBytes(p) % quantum);
+        uploaded += ToString(p);
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        uploaded += ToString(p);
+        EXPECT_EQ(uploaded.size(), s);
+        return make_status_or(
+            ResumableUploadResponse{"{}",
+                                    uploaded.size() - 1,
+                                    {},
+                                    ResumableUploadResponse::kInProgress,
+                                    {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
+    return next_byte;
+  }));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>(),
+      google::cloud::internal::make_unique<GzipCompressor>());
+
+  streambuf.sputn(payload.data(), payload.size());
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+
+  EXPECT_LE(1U, chunk_count);
+  EXPECT_EQ(payload, GzipInflateForTest(uploaded));
+}
+
+
+/// @test Verify that read-ahead delivers all the data, in order.
+TEST(ObjectReadStreambufTest, ReadAheadDeliversAllData) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockObjectReadSource>();
+
+  std::string const chunk_1(1000, 'a');
+  std::string const chunk_2(500, 'b');
+  bool all_data_returned = false;
+  auto make_read_action = [&](std::string const& chunk) {
+    return Invoke([&, chunk](char* buf, std::size_t n) {
+      EXPECT_LE(chunk.size(), n);
+      std::memcpy(buf, chunk.data(), chunk.size());
+      return make_status_or(ReadSourceResult{chunk.size(), HttpResponse{}});
+    });
+  };
+  {
+    InSequence seq;
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_1));
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_2));
+    EXPECT_CALL(*mock, Read(_, _))
+        .WillOnce(Invoke([&](char*, std::size_t) {
+          all_data_returned = true;
+          return make_status_or(ReadSourceResult{0, HttpResponse{}});
+        }));
+  }
+  EXPECT_CALL(*mock, IsOpen()).WillRepeatedly(Invoke([&]() {
+    return !all_data_returned;
+  }));
+  EXPECT_CALL(*mock, Close())
+      .WillOnce(Return(make_status_or(HttpResponse{200, "", {}})));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(ReadAheadBufferSize(128 * 1024),
+                               DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  ObjectReadStreambuf streambuf(request, std::move(mock));
+
+  std::istream stream(&streambuf);
+  std::string const actual{std::istreambuf_iterator<char>{stream},
+                           std::istreambuf_iterator<char>{}};
+  EXPECT_EQ(chunk_1 + chunk_2, actual);
+  streambuf.Close();
+  EXPECT_STATUS_OK(streambuf.status());
+}
+
+/// @test Verify that bulk reads consume any outstanding read-ahead first.
+TEST(ObjectReadStreambufTest, ReadAheadWithBulkRead) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockObjectReadSource>();
+
+  std::string const chunk_1(1000, 'a');
+  std::string const chunk_2(500, 'b');
+  std::string const chunk_3(250, 'c');
+  bool all_data_returned = false;
+  auto make_read_action = [&](std::string const& chunk) {
+    return Invoke([&, chunk](char* buf, std::size_t n) {
+      EXPECT_LE(chunk.size(), n);
+      std::memcpy(buf, chunk.data(), chunk.size());
+      return make_status_or(ReadSourceResult{chunk.size(), HttpResponse{}});
+    });
+  };
+  {
+    InSequence seq;
+    // The first read is synchronous, the second is the background fill, the
+    // third is the direct read issued by `sgetn()` for the remainder.
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_1));
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_2));
+    EXPECT_CALL(*mock, Read(_, _))
+        .WillOnce(Invoke([&](char* buf, std::size_t n) {
+          EXPECT_LE(chunk_3.size(), n);
+          std::memcpy(buf, chunk_3.data(), chunk_3.size());
+          all_data_returned = true;
+          return make_status_or(
+              ReadSourceResult{chunk_3.size(), HttpResponse{}});
+        }));
+  }
+  EXPECT_CALL(*mock, IsOpen()).WillRepeatedly(Invoke([&]() {
+    return !all_data_returned;
+  }));
+  EXPECT_CALL(*mock, Close())
+      .WillOnce(Return(make_status_or(HttpResponse{200, "", {}})));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(ReadAheadBufferSize(128 * 1024),
+                               DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  ObjectReadStreambuf streambuf(request, std::move(mock));
+
+  // Trigger the initial fill (and the first background fill).
+  EXPECT_EQ('a', streambuf.sgetc());
+  auto const total = chunk_1.size() + chunk_2.size() + chunk_3.size();
+  std::vector<char> buffer(total);
+  EXPECT_EQ(total, streambuf.sgetn(buffer.data(), total));
+  EXPECT_EQ(chunk_1 + chunk_2 + chunk_3,
+            std::string(buffer.begin(), buffer.end()));
+  streambuf.Close();
+  EXPECT_STATUS_OK(streambuf.status());
+}
+
+
+/// @test Verify that bulk reads tolerate short reads from the source.
+TEST(ObjectReadStreambufTest, BulkReadContinuesAfterShortRead) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockObjectReadSource>();
+
+  // A single `Read()` on the source may return less data than requested, the
+  // streambuf must keep reading until the caller's buffer is full.
+  std::string const chunk_1(600, 'a');
+  std::string const chunk_2(400, 'b');
+  auto make_read_action = [&](std::string const& chunk) {
+    return Invoke([&, chunk](char* buf, std::size_t n) {
+      EXPECT_LE(chunk.size(), n);
+      std::memcpy(buf, chunk.data(), chunk.size());
+      return make_status_or(ReadSourceResult{chunk.size(), HttpResponse{}});
+    });
+  };
+  {
+    InSequence seq;
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_1));
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(make_read_action(chunk_2));
+  }
+  EXPECT_CALL(*mock, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock, Close())
+      .WillOnce(Return(make_status_or(HttpResponse{200, "", {}})));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  ObjectReadStreambuf streambuf(request, std::move(mock));
+
+  auto const total = chunk_1.size() + chunk_2.size();
+  std::vector<char> buffer(total);
+  EXPECT_EQ(total, streambuf.sgetn(buffer.data(), total));
+  EXPECT_EQ(chunk_1 + chunk_2, std::string(buffer.begin(), buffer.end()));
+  streambuf.Close();
+  EXPECT_STATUS_OK(streambuf.status());
+}
+
+
+/// @test Verify that background flushing uploads all the data, in order.
+TEST(ObjectWriteStreambufTest, BackgroundFlushUploadsAllData) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload = std::string(3 * quantum, '*') + "trailer";
+
+  std::string uploaded;
+  std::size_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillRepeatedly(Invoke([&](ConstBufferSequence const& p) {
+        EXPECT_EQ(0, TotalBytes(p) % quantum);
+        uploaded += ToString(p);
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        uploaded += ToString(p);
+        EXPECT_EQ(payload.size(), s);
+        return make_status_or(
+            ResumableUploadResponse{"{}",
+                                    payload.size() - 1,
+                                    {},
+                                    ResumableUploadResponse::kInProgress,
+                                    {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
+    return next_byte;
+  }));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>(), nullptr,
+      true);
+
+  streambuf.sputn(payload.data(), payload.size());
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+  EXPECT_EQ(payload, uploaded);
+}
+
+/// @test Verify that background upload errors surface on a later flush.
+TEST(ObjectWriteStreambufTest, BackgroundFlushReportsErrorOnNextFlush) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(quantum, '*');
+  std::string const session_id = "upload_id";
+
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(
+          Return(Status(StatusCode::kInvalidArgument, "Invalid Argument")));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*mock, session_id).WillOnce(ReturnRef(session_id));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>(), nullptr,
+      true);
+
+  // The first full buffer starts a background upload, its error is only
+  // reported when the next flush waits for it.
+  streambuf.sputn(payload.data(), payload.size());
+  streambuf.sputn(payload.data(), payload.size());
+  EXPECT_EQ(StatusCode::kInvalidArgument, streambuf.last_status().code())
+      << ", status=" << streambuf.last_status();
+  EXPECT_EQ(streambuf.resumable_session_id(), session_id);
+
+  auto response = streambuf.Close();
+  EXPECT_EQ(StatusCode::kInvalidArgument, response.status().code());
+}
+
+/// @test Verify that an application-provided put area is used for uploads.
+TEST(ObjectWriteStreambufTest, PubsetbufChangesPutArea) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(2 * quantum, '*');
+
+  std::size_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        // A single chunk, the application's buffer holds two quanta.
+        EXPECT_EQ(payload, ToString(p));
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        EXPECT_TRUE(p.empty());
+        EXPECT_EQ(payload.size(), s);
+        return make_status_or(ResumableUploadResponse{
+            "{}", payload.size() - 1, {}, ResumableUploadResponse::kDone, {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
+    return next_byte;
+  }));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>());
+
+  // The usable size is rounded down to a multiple of the upload quantum.
+  std::vector<char> buffer(2 * quantum + 100);
+  streambuf.pubsetbuf(buffer.data(), buffer.size());
+
+  streambuf.sputn(payload.data(), payload.size());
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+}
+
+/// @test Verify that a put area change is rejected once data is buffered.
+TEST(ObjectWriteStreambufTest, PubsetbufRejectedAfterWrite) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload = "small test payload";
+
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::uint64_t s) {
+        EXPECT_EQ(payload, ToString(p));
+        EXPECT_EQ(payload.size(), s);
+        auto last_committed_byte = payload.size() - 1;
+        return make_status_or(
+            ResumableUploadResponse{"{}",
+                                    last_committed_byte,
+                                    {},
+                                    ResumableUploadResponse::kInProgress,
+                                    {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), quantum,
+      google::cloud::internal::make_unique<NullHashValidator>());
+
+  streambuf.sputn(payload.data(), payload.size());
+  // The buffer is rejected because data is already buffered, the payload
+  // must still be uploaded from the original put area.
+  std::vector<char> buffer(2 * quantum);
+  streambuf.pubsetbuf(buffer.data(), buffer.size());
+
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+}
+
+/// @test Verify that an application-provided get area is used for downloads.
+TEST(ObjectReadStreambufTest, PubsetbufChangesGetArea) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockObjectReadSource>();
+
+  std::string const contents = "some contents for the get area";
+  std::vector<char> buffer(333);
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke([&](char* buf, std::size_t n) {
+        // The read goes into the application's buffer, at its full size,
+        // instead of the (much larger) internal buffer.
+        EXPECT_EQ(buffer.data(), buf);
+        EXPECT_EQ(buffer.size(), n);
+        std::memcpy(buf, contents.data(), contents.size());
+        return make_status_or(
+            ReadSourceResult{contents.size(), HttpResponse{}});
+      }));
+  EXPECT_CALL(*mock, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock, Close())
+      .WillOnce(Return(make_status_or(HttpResponse{200, "", {}})));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  ObjectReadStreambuf streambuf(request, std::move(mock));
+  streambuf.pubsetbuf(buffer.data(), buffer.size());
+
+  EXPECT_EQ(contents[0], streambuf.sgetc());
+  std::vector<char> actual(contents.size());
+  EXPECT_EQ(contents.size(), streambuf.sgetn(actual.data(), actual.size()));
+  EXPECT_EQ(contents, std::string(actual.begin(), actual.end()));
+  streambuf.Close();
+  EXPECT_STATUS_OK(streambuf.status());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -15,13 +15,10 @@
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <openssl/bio.h>
-#include <openssl/buffer.h>
 #include <openssl/evp.h>
 #include <openssl/opensslv.h>
 #include <openssl/pem.h>
-#ifdef OPENSSL_IS_BORINGSSL
-#include <openssl/base64.h>
-#endif  // OPENSSL_IS_BORINGSSL
+#include <array>
 #include <memory>
 #include <sstream>
 
@@ -46,122 +43,109 @@ inline std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> GetDigestCtx() {
 };
 #endif
 
-#ifndef OPENSSL_IS_BORINGSSL
+constexpr char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
 /**
- * Build a BIO chain for Base 64 encoding and decoding.
- *
- * BIO chains are a OpenSSL abstraction to perform I/O (including from memory
- * buffers) with transformations. This function takes a BIO object and builds a
- * chain that:
- *
- * - For writes, it performs Base 64 encoding and then writes the encoded data
- *   into @p mem_io.
- * - For reads, it extracts data from @p mem_io and then decodes it using
- *   Base64.
- *
+ * Maps each character to its 6-bit value: 0-63 for the alphabet, 64 for the
+ * padding character, and 255 for anything else.
  */
-std::unique_ptr<BIO, decltype(&BIO_free_all)> PushBase64Transcoding(
-    std::unique_ptr<BIO, decltype(&BIO_free)> mem_io) {
-  auto base64_io = std::unique_ptr<BIO, decltype(&BIO_free)>(
-      BIO_new(BIO_f_base64()), &BIO_free);
-  if (!(base64_io && mem_io)) {
-    std::ostringstream err_builder;
-    err_builder << "Permanent error in " << __func__ << ": "
-                << "Could not allocate BIO* for Base64 encoding.";
-    google::cloud::internal::ThrowRuntimeError(err_builder.str());
-  }
-  auto bio_chain = std::unique_ptr<BIO, decltype(&BIO_free_all)>(
-      // Output from a b64 encoder should go to an in-memory sink.
-      BIO_push(base64_io.release(), mem_io.release()),
-      // Make sure we free all resources in this chain upon destruction.
-      &BIO_free_all);
-  // Don't use newlines as a signal for when to flush buffers.
-  BIO_set_flags(bio_chain.get(), BIO_FLAGS_BASE64_NO_NL);
-  return bio_chain;
+std::array<std::uint8_t, 256> const& Base64DecodeTable() {
+  static std::array<std::uint8_t, 256> const kTable = [] {
+    std::array<std::uint8_t, 256> table;
+    table.fill(255);
+    for (std::uint8_t i = 0; i != 64; ++i) {
+      table[static_cast<std::uint8_t>(kBase64Alphabet[i])] = i;
+    }
+    table[static_cast<std::uint8_t>('=')] = 64;
+    return table;
+  }();
+  return kTable;
 }
-#endif  // OPENSSL_IS_BORINGSSL
 
+// Base64 encoding and decoding used to go through OpenSSL BIO chains, which
+// allocate several objects per call and process the data byte-at-a-time.
+// These functions run on every hash validation and every signed URL, the
+// table-driven implementation below makes a single allocation (the result)
+// and processes a full 24-bit group per iteration.
 std::string Base64Encode(std::uint8_t const* bytes, std::size_t bytes_size) {
-#ifdef OPENSSL_IS_BORINGSSL
-  std::size_t encoded_size;
-  EVP_EncodedLength(&encoded_size, bytes_size);
-  std::vector<std::uint8_t> result(encoded_size);
-  std::size_t out_size = EVP_EncodeBlock(result.data(), bytes, bytes_size);
-  result.resize(out_size);
-  return {result.begin(), result.end()};
-#else
-  auto mem_io = std::unique_ptr<BIO, decltype(&BIO_free)>(BIO_new(BIO_s_mem()),
-                                                          &BIO_free);
-  auto bio_chain = PushBase64Transcoding(std::move(mem_io));
-
-  // These BIO_*() operations are guaranteed not to block, consult the NOTES in:
-  //   https://www.openssl.org/docs/man1.1.1/man3/BIO_s_mem.html
-  // for details.
-  int retval = BIO_write(bio_chain.get(), bytes, static_cast<int>(bytes_size));
-  if (retval <= 0) {
-    std::ostringstream err_builder;
-    err_builder << "Permanent error in " << __func__ << ": "
-                << "BIO_write returned non-retryable value of " << retval;
-    google::cloud::internal::ThrowRuntimeError(err_builder.str());
+  std::string result(((bytes_size + 2) / 3) * 4, '=');
+  auto* out = &result[0];
+  std::size_t i = 0;
+  for (; i + 3 <= bytes_size; i += 3) {
+    auto const v = (static_cast<std::uint32_t>(bytes[i]) << 16) |
+                   (static_cast<std::uint32_t>(bytes[i + 1]) << 8) |
+                   static_cast<std::uint32_t>(bytes[i + 2]);
+    *out++ = kBase64Alphabet[(v >> 18) & 0x3f];
+    *out++ = kBase64Alphabet[(v >> 12) & 0x3f];
+    *out++ = kBase64Alphabet[(v >> 6) & 0x3f];
+    *out++ = kBase64Alphabet[v & 0x3f];
   }
-
-  // Tell the b64 encoder that we're done writing data, thus prompting it to
-  // add trailing '=' characters for padding if needed.
-  retval = BIO_flush(bio_chain.get());
-  if (retval <= 0) {
-    std::ostringstream err_builder;
-    err_builder << "Permanent error in " << __func__ << ": "
-                << "BIO_flush returned non-retryable value of " << retval;
-    google::cloud::internal::ThrowRuntimeError(err_builder.str());
+  if (bytes_size - i == 1) {
+    auto const v = static_cast<std::uint32_t>(bytes[i]) << 16;
+    *out++ = kBase64Alphabet[(v >> 18) & 0x3f];
+    *out++ = kBase64Alphabet[(v >> 12) & 0x3f];
+  } else if (bytes_size - i == 2) {
+    auto const v = (static_cast<std::uint32_t>(bytes[i]) << 16) |
+                   (static_cast<std::uint32_t>(bytes[i + 1]) << 8);
+    *out++ = kBase64Alphabet[(v >> 18) & 0x3f];
+    *out++ = kBase64Alphabet[(v >> 12) & 0x3f];
+    *out++ = kBase64Alphabet[(v >> 6) & 0x3f];
   }
-
-  // This buffer belongs to the BIO chain and is freed upon its destruction.
-  BUF_MEM* buf_mem;
-  BIO_get_mem_ptr(bio_chain.get(), &buf_mem);
-  // Return a string copy of the buffer's bytes, as the buffer will be freed
-  // upon this method's exit.
-  return std::string(buf_mem->data, buf_mem->length);
-#endif  // OPENSSL_IS_BORINGSSL
+  return result;
 }
 }  // namespace
 
 std::vector<std::uint8_t> Base64Decode(std::string const& str) {
-#ifdef OPENSSL_IS_BORINGSSL
-  std::size_t decoded_size;
-  EVP_DecodedLength(&decoded_size, str.size());
-  std::vector<std::uint8_t> result(decoded_size);
-  EVP_DecodeBase64(result.data(), &decoded_size, result.size(),
-                   reinterpret_cast<unsigned char const*>(str.data()),
-                   str.size());
-  result.resize(decoded_size);
-  return result;
-#else
   if (str.empty()) {
     return {};
   }
-
-  std::unique_ptr<BIO, decltype(&BIO_free)> source(
-      BIO_new_mem_buf(str.data(), static_cast<int>(str.size())), &BIO_free);
-  auto bio = PushBase64Transcoding(std::move(source));
-
-  // We could compute the exact buffer size by looking at the number of padding
-  // characters (=) at the end of str, but we will get the exact length later,
-  // so simply compute a buffer that is big enough.
-  std::vector<std::uint8_t> result(str.size() * 3 / 4);
-
-  // We do not retry, just make one call because the full stream is blocking.
-  // Note that the number of bytes to read is the number of bytes we fetch from
-  // the *source*, not the number of bytes that we have available in `result`.
-  int len = BIO_read(bio.get(), result.data(), static_cast<int>(str.size()));
-  if (len < 0) {
+  auto report_error = [&str]() {
     std::ostringstream os;
-    os << "Error parsing Base64 string [" << len << "], string=<" << str << ">";
+    os << "Error parsing Base64 string, string=<" << str << ">";
     google::cloud::internal::ThrowRuntimeError(os.str());
+  };
+  if (str.size() % 4 != 0) {
+    report_error();
   }
-
-  result.resize(static_cast<std::size_t>(len));
+  auto const& table = Base64DecodeTable();
+  std::vector<std::uint8_t> result(str.size() / 4 * 3);
+  auto* out = result.data();
+  auto const* in = reinterpret_cast<std::uint8_t const*>(str.data());
+  auto const* last_quad = in + str.size() - 4;
+  for (; in <= last_quad; in += 4) {
+    auto const a = table[in[0]];
+    auto const b = table[in[1]];
+    auto const c = table[in[2]];
+    auto const d = table[in[3]];
+    if (a >= 64 || b >= 64 || c == 255 || d == 255) {
+      report_error();
+    }
+    if (c == 64 || d == 64) {
+      // The padding character is only valid in the last one or two positions
+      // of the input.
+      if (in != last_quad || (c == 64 && d != 64)) {
+        report_error();
+      }
+      auto const v = (static_cast<std::uint32_t>(a) << 18) |
+                     (static_cast<std::uint32_t>(b) << 12) |
+                     (c == 64 ? 0 : static_cast<std::uint32_t>(c) << 6);
+      *out++ = static_cast<std::uint8_t>(v >> 16);
+      if (c != 64) {
+        *out++ = static_cast<std::uint8_t>(v >> 8);
+      }
+      break;
+    }
+    auto const v = (static_cast<std::uint32_t>(a) << 18) |
+                   (static_cast<std::uint32_t>(b) << 12) |
+                   (static_cast<std::uint32_t>(c) << 6) |
+                   static_cast<std::uint32_t>(d);
+    *out++ = static_cast<std::uint8_t>(v >> 16);
+    *out++ = static_cast<std::uint8_t>(v >> 8);
+    *out++ = static_cast<std::uint8_t>(v);
+  }
+  result.resize(static_cast<std::size_t>(out - result.data()));
   return result;
-#endif  // OPENSSL_IS_BORINGSSL
 }
 
 std::string Base64Encode(std::string const& str) {
@@ -176,6 +160,45 @@ std::string Base64Encode(std::vector<std::uint8_t> const& bytes) {
 std::vector<std::uint8_t> SignStringWithPem(
     std::string const& str, std::string const& pem_contents,
     storage::oauth2::JwtSigningAlgorithms alg) {
+  return PemSigningKey::FromPem(pem_contents).Sign(str, alg);
+}
+
+PemSigningKey PemSigningKey::FromPem(std::string const& pem_contents) {
+  auto result = TryFromPem(pem_contents);
+  if (!result.valid()) {
+    std::ostringstream err_builder;
+    err_builder << "Permanent error in " << __func__
+                << " (failed to sign string with PEM key):\n"
+                << "Could not parse PEM to get private key.";
+    google::cloud::internal::ThrowRuntimeError(err_builder.str());
+  }
+  return result;
+}
+
+PemSigningKey PemSigningKey::TryFromPem(std::string const& pem_contents) {
+  auto pem_buffer = std::unique_ptr<BIO, decltype(&BIO_free)>(
+      BIO_new_mem_buf(pem_contents.data(),
+                      static_cast<int>(pem_contents.length())),
+      &BIO_free);
+  PemSigningKey result;
+  if (!pem_buffer) {
+    return result;
+  }
+  result.key_ = std::shared_ptr<EVP_PKEY>(
+      PEM_read_bio_PrivateKey(
+          pem_buffer.get(),
+          nullptr,  // EVP_PKEY **x
+          nullptr,  // pem_password_cb *cb -- a custom callback.
+          // void *u -- this represents the password for the PEM (only
+          // applicable for formats such as PKCS12 (.p12 files) that use
+          // a password, which we don't currently support.
+          nullptr),
+      &EVP_PKEY_free);
+  return result;
+}
+
+std::vector<std::uint8_t> PemSigningKey::Sign(
+    std::string const& str, storage::oauth2::JwtSigningAlgorithms alg) const {
   using ::google::cloud::storage::oauth2::JwtSigningAlgorithms;
 
   // We check for failures several times, so we shorten this into a lambda
@@ -204,35 +227,13 @@ std::vector<std::uint8_t> SignStringWithPem(
     handle_openssl_failure("Could not find specified digest in OpenSSL.");
   }
 
-  auto pem_buffer = std::unique_ptr<BIO, decltype(&BIO_free)>(
-      BIO_new_mem_buf(pem_contents.data(),
-                      static_cast<int>(pem_contents.length())),
-      &BIO_free);
-  if (!pem_buffer) {
-    handle_openssl_failure("Could not create PEM buffer.");
-  }
-
-  auto private_key = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(
-      PEM_read_bio_PrivateKey(
-          pem_buffer.get(),
-          nullptr,  // EVP_PKEY **x
-          nullptr,  // pem_password_cb *cb -- a custom callback.
-          // void *u -- this represents the password for the PEM (only
-          // applicable for formats such as PKCS12 (.p12 files) that use
-          // a password, which we don't currently support.
-          nullptr),
-      &EVP_PKEY_free);
-  if (!private_key) {
-    handle_openssl_failure("Could not parse PEM to get private key.");
-  }
-
   int const digest_sign_success_code = 1;
   if (digest_sign_success_code !=
       EVP_DigestSignInit(digest_ctx.get(),
                          nullptr,  // EVP_PKEY_CTX **pctx
                          digest_type,
                          nullptr,  // ENGINE *e
-                         private_key.get())) {
+                         key_.get())) {
     handle_openssl_failure("Could not initialize PEM digest.");
   }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/testing_util/expect_exception.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -68,6 +69,48 @@ TEST(OpensslUtilTest, Base64DecodePadding) {
   EXPECT_THAT(UrlsafeBase64Decode("QUJDRA=="), ElementsAre('A', 'B', 'C', 'D'));
 }
 
+TEST(OpensslUtilTest, Base64DecodeInvalid) {
+  for (std::string const& input :
+       {"A", "AB", "ABC", "A===", "=AAA", "AA=A", "****", "QUJD\n",
+        "QQ==QUJD"}) {
+    testing_util::ExpectException<std::runtime_error>(
+        [&input] { Base64Decode(input); },
+        [](std::runtime_error const& ex) {
+          EXPECT_THAT(ex.what(), HasSubstr("Error parsing Base64"));
+        },
+        "Exceptions are disabled, the program should terminate");
+  }
+}
+
+TEST(OpensslUtilTest, Base64RoundTrip) {
+  std::vector<std::uint8_t> data;
+  for (int n = 0; n != 128; ++n) {
+    auto encoded = Base64Encode(data);
+    EXPECT_EQ(((data.size() + 2) / 3) * 4, encoded.size());
+    EXPECT_THAT(Base64Decode(encoded), ElementsAreArray(data));
+    data.push_back(static_cast<std::uint8_t>(n * 7 + 1));
+  }
+}
+
+TEST(OpensslUtilTest, PemSigningKeyDefaultIsInvalid) {
+  PemSigningKey key;
+  EXPECT_FALSE(key.valid());
+}
+
+TEST(OpensslUtilTest, PemSigningKeyTryFromPemInvalid) {
+  auto key = PemSigningKey::TryFromPem("not-a-valid-pem-key");
+  EXPECT_FALSE(key.valid());
+}
+
+TEST(OpensslUtilTest, PemSigningKeyFromPemInvalid) {
+  testing_util::ExpectException<std::runtime_error>(
+      [] { PemSigningKey::FromPem("not-a-valid-pem-key"); },
+      [](std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("Could not parse PEM"));
+      },
+      "Exceptions are disabled, the program should terminate");
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,182 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/operation_metrics.h"
+#include "google/cloud/internal/make_unique.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+struct MergedShard {
+  std::uint64_t attempt_count = 0;
+  std::uint64_t error_count = 0;
+  std::uint64_t byte_count = 0;
+  std::array<std::uint64_t, OperationMetrics::kBucketCount> buckets{};
+};
+
+std::chrono::microseconds Percentile(MergedShard const& merged,
+                                     std::uint64_t permille) {
+  if (merged.attempt_count == 0) {
+    return std::chrono::microseconds(0);
+  }
+  // The smallest rank whose cumulative count reaches the percentile.
+  auto target = (merged.attempt_count * permille + 999) / 1000;
+  std::uint64_t cumulative = 0;
+  for (std::size_t i = 0; i != merged.buckets.size(); ++i) {
+    cumulative += merged.buckets[i];
+    if (cumulative >= target) {
+      return std::chrono::microseconds(OperationMetrics::BucketUpperBound(i));
+    }
+  }
+  return std::chrono::microseconds(
+      OperationMetrics::BucketUpperBound(merged.buckets.size() - 1));
+}
+
+}  // namespace
+
+OperationMetrics& OperationMetrics::Instance() {
+  static OperationMetrics instance;
+  return instance;
+}
+
+std::size_t OperationMetrics::BucketIndex(std::uint64_t usec) {
+  if (usec < kSubBucketCount) {
+    return static_cast<std::size_t>(usec);
+  }
+  int log = 0;
+  for (auto v = usec; v > 1; v >>= 1) {
+    ++log;
+  }
+  auto sub = static_cast<std::size_t>((usec >> (log - 4)) &
+                                      (kSubBucketCount - 1));
+  auto index = static_cast<std::size_t>(log - 3) * kSubBucketCount + sub;
+  return (std::min)(index, kBucketCount - 1);
+}
+
+std::uint64_t OperationMetrics::BucketUpperBound(std::size_t index) {
+  if (index < kSubBucketCount) {
+    return index + 1;
+  }
+  auto log = index / kSubBucketCount + 3;
+  auto sub = index % kSubBucketCount;
+  return static_cast<std::uint64_t>(kSubBucketCount + sub + 1) << (log - 4);
+}
+
+void OperationMetrics::Record(char const* operation,
+                              std::chrono::steady_clock::duration elapsed,
+                              StatusCode status, std::int64_t byte_count) {
+  auto* shard = FindShard(LocalShard(), operation);
+  if (shard == nullptr) {
+    return;
+  }
+  auto usec =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  if (usec < 0) {
+    usec = 0;
+  }
+  shard->attempt_count.fetch_add(1, std::memory_order_relaxed);
+  if (status != StatusCode::kOk) {
+    shard->error_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (byte_count > 0) {
+    shard->byte_count.fetch_add(static_cast<std::uint64_t>(byte_count),
+                                std::memory_order_relaxed);
+  }
+  shard->buckets[BucketIndex(static_cast<std::uint64_t>(usec))].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+std::vector<OperationMetricsSummary> OperationMetrics::Snapshot() const {
+  // Operation names are `__func__` literals; different threads (or
+  // translation units) may record the same operation through different
+  // pointers, merge them by value.
+  std::map<std::string, MergedShard> merged;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto const& thread_shard : shards_) {
+      for (auto const& slot : thread_shard->operations) {
+        auto const* op = slot.load(std::memory_order_acquire);
+        if (op == nullptr) {
+          break;
+        }
+        auto& m = merged[op->name];
+        m.attempt_count += op->attempt_count.load(std::memory_order_relaxed);
+        m.error_count += op->error_count.load(std::memory_order_relaxed);
+        m.byte_count += op->byte_count.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i != kBucketCount; ++i) {
+          m.buckets[i] += op->buckets[i].load(std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+  std::vector<OperationMetricsSummary> result;
+  result.reserve(merged.size());
+  for (auto const& kv : merged) {
+    OperationMetricsSummary summary;
+    summary.operation = kv.first;
+    summary.attempt_count = kv.second.attempt_count;
+    summary.error_count = kv.second.error_count;
+    summary.byte_count = kv.second.byte_count;
+    summary.latency_p50 = Percentile(kv.second, 500);
+    summary.latency_p99 = Percentile(kv.second, 990);
+    summary.latency_p999 = Percentile(kv.second, 999);
+    result.push_back(std::move(summary));
+  }
+  return result;
+}
+
+OperationMetrics::ThreadShard& OperationMetrics::LocalShard() {
+  thread_local ThreadShard* shard = nullptr;
+  if (shard == nullptr) {
+    auto new_shard = google::cloud::internal::make_unique<ThreadShard>();
+    std::unique_lock<std::mutex> lk(mu_);
+    shards_.push_back(std::move(new_shard));
+    shard = shards_.back().get();
+  }
+  return *shard;
+}
+
+OperationMetrics::OperationShard* OperationMetrics::FindShard(
+    ThreadShard& shard, char const* operation) {
+  // Only the owning thread writes the slots, and it fills them in order, so
+  // a simple linear scan needs no synchronization beyond the release store
+  // that publishes a new shard to `Snapshot()`.
+  for (auto& slot : shard.operations) {
+    auto* op = slot.load(std::memory_order_relaxed);
+    if (op == nullptr) {
+      op = new OperationShard(operation);
+      slot.store(op, std::memory_order_release);
+      return op;
+    }
+    if (op->name == operation || std::strcmp(op->name, operation) == 0) {
+      return op;
+    }
+  }
+  // The operation table is full; this cannot happen with the operations
+  // recorded by `TracingClient`, drop the sample rather than crash.
+  return nullptr;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,134 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OPERATION_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OPERATION_METRICS_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * The aggregated metrics for one `RawClient` operation.
+ *
+ * The metrics count *attempts*: the recorder runs below `RetryClient`, so
+ * each retry is a separate sample. The retry rate for an operation can be
+ * derived from the error count, as each error (except the last in a failed
+ * call) corresponds to a retry.
+ */
+struct OperationMetricsSummary {
+  std::string operation;
+  /// The number of attempts, including retries.
+  std::uint64_t attempt_count;
+  /// The number of attempts that completed with an error.
+  std::uint64_t error_count;
+  /// The sum of the request payload sizes, for uploads.
+  std::uint64_t byte_count;
+  /// Attempt latency percentiles, upper bounds of the histogram bucket
+  /// holding the percentile, accurate to about 6%.
+  std::chrono::microseconds latency_p50;
+  std::chrono::microseconds latency_p99;
+  std::chrono::microseconds latency_p999;
+};
+
+/**
+ * Process-wide, per-operation latency histograms and counters.
+ *
+ * `Record()` increments counters owned by the calling thread, without
+ * locks or contended cache lines, so it is cheap enough to leave enabled
+ * in production. The histograms use log-linear ("HDR" style) buckets:
+ * sixteen linear sub-buckets per power of two of the latency in
+ * microseconds, covering one microsecond to roughly nine minutes with a
+ * worst-case quantization error of about 6%.
+ *
+ * `Snapshot()` merges the per-thread counters into one summary per
+ * operation; the counts in the summary can be exported directly to
+ * monitoring systems that expect cumulative counters.
+ */
+class OperationMetrics {
+ public:
+  /// The process-wide instance.
+  static OperationMetrics& Instance();
+
+  /// Records one attempt of @p operation in the calling thread's shard.
+  void Record(char const* operation,
+              std::chrono::steady_clock::duration elapsed, StatusCode status,
+              std::int64_t byte_count);
+
+  /// Returns one summary per operation, ordered by operation name.
+  std::vector<OperationMetricsSummary> Snapshot() const;
+
+  //@{
+  /// @name Histogram geometry, exposed for the tests.
+  static std::size_t constexpr kSubBucketCount = 16;
+  static std::size_t constexpr kBucketCount = 416;
+
+  /// Returns the bucket index for a latency of @p usec microseconds.
+  static std::size_t BucketIndex(std::uint64_t usec);
+
+  /// Returns the upper bound, in microseconds, of the bucket at @p index.
+  static std::uint64_t BucketUpperBound(std::size_t index);
+  //@}
+
+ private:
+  OperationMetrics() = default;
+
+  struct OperationShard {
+    explicit OperationShard(char const* n) : name(n) {}
+    char const* name;
+    std::atomic<std::uint64_t> attempt_count{0};
+    std::atomic<std::uint64_t> error_count{0};
+    std::atomic<std::uint64_t> byte_count{0};
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets{};
+  };
+
+  struct ThreadShard {
+    static std::size_t constexpr kMaxOperations = 128;
+    // Only the owning thread stores into these slots, `Snapshot()` loads
+    // them with acquire semantics.
+    std::array<std::atomic<OperationShard*>, kMaxOperations> operations{};
+  };
+
+  ThreadShard& LocalShard();
+
+  /// Finds (or creates) the calling thread's shard for @p operation,
+  /// returns `nullptr` if the operation table is full.
+  static OperationShard* FindShard(ThreadShard& shard, char const* operation);
+
+  // Protects the registry of thread shards, not the counters themselves.
+  // Shards are kept alive until the process exits, even if their thread is
+  // gone, so `Snapshot()` includes samples from completed threads.
+  mutable std::mutex mu_;
+  std::vector<std::unique_ptr<ThreadShard>> shards_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OPERATION_METRICS_H
@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/operation_metrics.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using std::chrono::microseconds;
+
+// The metrics are process-wide, each test uses its own operation name to
+// stay independent of the other tests (and their execution order).
+OperationMetricsSummary FindSummary(std::string const& operation) {
+  for (auto& summary : OperationMetrics::Instance().Snapshot()) {
+    if (summary.operation == operation) {
+      return summary;
+    }
+  }
+  return OperationMetricsSummary{};
+}
+
+/// @test Verify the bucket mapping is contiguous and within tolerance.
+TEST(OperationMetricsTest, BucketGeometry) {
+  // The first buckets hold exactly one microsecond each.
+  EXPECT_EQ(0U, OperationMetrics::BucketIndex(0));
+  EXPECT_EQ(15U, OperationMetrics::BucketIndex(15));
+  EXPECT_EQ(16U, OperationMetrics::BucketIndex(16));
+  EXPECT_EQ(31U, OperationMetrics::BucketIndex(31));
+  // The first sub-bucketed power of two starts where the linear range ends.
+  EXPECT_EQ(32U, OperationMetrics::BucketIndex(32));
+
+  std::size_t previous = 0;
+  for (std::uint64_t v = 1; v < (1ULL << 28); v = v * 3 + 1) {
+    auto index = OperationMetrics::BucketIndex(v);
+    EXPECT_GE(index, previous) << "v=" << v;
+    previous = index;
+    auto upper = OperationMetrics::BucketUpperBound(index);
+    EXPECT_GT(upper, v);
+    // The log-linear buckets are at most 1/16th of the value wide.
+    EXPECT_LE(upper, v + v / 8 + 1) << "v=" << v;
+  }
+  // Values beyond the histogram range fall in the last bucket.
+  EXPECT_EQ(OperationMetrics::kBucketCount - 1,
+            OperationMetrics::BucketIndex(1ULL << 40));
+}
+
+/// @test Verify counters and error counts are aggregated.
+TEST(OperationMetricsTest, Counters) {
+  auto& metrics = OperationMetrics::Instance();
+  metrics.Record("OperationMetricsTestCounters", microseconds(100),
+                 StatusCode::kOk, 100);
+  metrics.Record("OperationMetricsTestCounters", microseconds(200),
+                 StatusCode::kOk, 200);
+  metrics.Record("OperationMetricsTestCounters", microseconds(300),
+                 StatusCode::kUnavailable, 0);
+
+  auto summary = FindSummary("OperationMetricsTestCounters");
+  EXPECT_EQ(3U, summary.attempt_count);
+  EXPECT_EQ(1U, summary.error_count);
+  EXPECT_EQ(300U, summary.byte_count);
+}
+
+/// @test Verify the latency percentiles reflect the recorded samples.
+TEST(OperationMetricsTest, Percentiles) {
+  auto& metrics = OperationMetrics::Instance();
+  for (int i = 0; i != 99; ++i) {
+    metrics.Record("OperationMetricsTestPercentiles", microseconds(1000),
+                   StatusCode::kOk, 0);
+  }
+  metrics.Record("OperationMetricsTestPercentiles", microseconds(1000000),
+                 StatusCode::kOk, 0);
+
+  auto summary = FindSummary("OperationMetricsTestPercentiles");
+  EXPECT_EQ(100U, summary.attempt_count);
+  EXPECT_GE(summary.latency_p50, microseconds(1000));
+  EXPECT_LE(summary.latency_p50, microseconds(1200));
+  EXPECT_LE(summary.latency_p99, microseconds(1200));
+  EXPECT_GE(summary.latency_p999, microseconds(1000000));
+}
+
+/// @test Verify samples from multiple threads are merged.
+TEST(OperationMetricsTest, MultipleThreads) {
+  auto constexpr kThreadCount = 4;
+  auto constexpr kSamplesPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreadCount; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i != kSamplesPerThread; ++i) {
+        OperationMetrics::Instance().Record("OperationMetricsTestThreads",
+                                            microseconds(10), StatusCode::kOk,
+                                            1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto summary = FindSummary("OperationMetricsTestThreads");
+  EXPECT_EQ(kThreadCount * kSamplesPerThread, summary.attempt_count);
+  EXPECT_EQ(kThreadCount * kSamplesPerThread, summary.byte_count);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
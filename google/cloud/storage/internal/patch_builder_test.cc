@@ -124,6 +124,34 @@ TEST(PatchBuilderTest, SubPatch) {
   EXPECT_EQ(expected, actual) << builder.ToString();
 }
 
+TEST(PatchBuilderTest, EmptySubPatch) {
+  PatchBuilder builder;
+  builder.AddStringField("some-field", "", "new-value");
+  builder.AddSubPatch("the-field", PatchBuilder());
+  nl::json expected{
+      {"some-field", "new-value"},
+      {"the-field", nullptr},
+  };
+  nl::json actual = nl::json::parse(builder.ToString());
+  EXPECT_EQ(expected, actual) << builder.ToString();
+}
+
+TEST(PatchBuilderTest, StringEscaping) {
+  PatchBuilder builder;
+  builder.SetStringField("quotes", R"(say "hello")");
+  builder.SetStringField("backslash", R"(a\b)");
+  builder.SetStringField("control", "line1\nline2\ttab\x01");
+  builder.SetStringField("utf8", "\xE6\x97\xA5\xE6\x9C\xAC");
+  nl::json expected{
+      {"quotes", R"(say "hello")"},
+      {"backslash", R"(a\b)"},
+      {"control", "line1\nline2\ttab\x01"},
+      {"utf8", "\xE6\x97\xA5\xE6\x9C\xAC"},
+  };
+  nl::json actual = nl::json::parse(builder.ToString());
+  EXPECT_EQ(expected, actual) << builder.ToString();
+}
+
 TEST(PatchBuilderTest, RemoveField) {
   PatchBuilder builder;
   builder.AddStringField("some-field", "", "new-value");
@@ -23,6 +23,32 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+/**
+ * Canonicalize one condition.
+ *
+ * If the elements is of size 2, we've encountered an exact match in
+ * object form.  So we create a json object using the first element as the
+ * key and the second element as the value. Returns false for conditions
+ * that do not appear in the signed text.
+ */
+bool ConditionToJson(PolicyDocumentCondition const& condition,
+                     nl::json& result) {
+  std::vector<std::string> elements = condition.elements();
+  if (elements.size() == 2) {
+    nl::json object;
+    object[elements.at(0)] = elements.at(1);
+    result = std::move(object);
+    return true;
+  }
+  if (elements.at(0) == "content-length-range") {
+    result = nl::json{elements.at(0), std::stol(elements.at(1)),
+                      std::stol(elements.at(2))};
+    return true;
+  }
+  return false;
+}
+}  // namespace
 
 std::string PolicyDocumentRequest::StringToSign() const {
   using internal::nl::json;
@@ -32,22 +58,9 @@ std::string PolicyDocumentRequest::StringToSign() const {
   j["expiration"] = google::cloud::internal::FormatRfc3339(document.expiration);
 
   for (auto const& kv : document.conditions) {
-    std::vector<std::string> elements = kv.elements();
-
-    /**
-     * If the elements is of size 2, we've encountered an exact match in
-     * object form.  So we create a json object using the first element as the
-     * key and the second element as the value.
-     */
-    if (elements.size() == 2) {
-      json object;
-      object[elements.at(0)] = elements.at(1);
-      j["conditions"].push_back(object);
-    } else {
-      if (elements.at(0) == "content-length-range") {
-        j["conditions"].push_back({elements.at(0), std::stol(elements.at(1)),
-                                   std::stol(elements.at(2))});
-      }
+    json object;
+    if (ConditionToJson(kv, object)) {
+      j["conditions"].push_back(std::move(object));
     }
   }
 
@@ -58,6 +71,46 @@ std::ostream& operator<<(std::ostream& os, PolicyDocumentRequest const& r) {
   return os << "PolicyDocumentRequest={" << r.StringToSign() << "}";
 }
 
+PolicyDocumentTemplate::PolicyDocumentTemplate(
+    std::vector<PolicyDocumentCondition> common_conditions) {
+  char const* sep = "";
+  for (auto const& condition : common_conditions) {
+    nl::json object;
+    if (!ConditionToJson(condition, object)) {
+      continue;
+    }
+    common_fragment_ += sep;
+    common_fragment_ += std::move(object).dump();
+    sep = ",";
+  }
+}
+
+std::string PolicyDocumentTemplate::Render(
+    std::chrono::system_clock::time_point expiration,
+    std::vector<PolicyDocumentCondition> const& call_conditions) const {
+  std::string conditions = common_fragment_;
+  for (auto const& condition : call_conditions) {
+    nl::json object;
+    if (!ConditionToJson(condition, object)) {
+      continue;
+    }
+    if (!conditions.empty()) {
+      conditions += ",";
+    }
+    conditions += std::move(object).dump();
+  }
+  // Splice the pre-rendered text by hand, the keys appear in the same
+  // (alphabetical) order the JSON library dumps them in, so the result
+  // is byte-for-byte what `StringToSign()` produces.
+  std::string result = "{";
+  if (!conditions.empty()) {
+    result += R"("conditions":[)" + conditions + "],";
+  }
+  result += R"("expiration":")" +
+            google::cloud::internal::FormatRfc3339(expiration) + R"("})";
+  return result;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -70,6 +70,31 @@ class PolicyDocumentRequest {
 
 std::ostream& operator<<(std::ostream& os, PolicyDocumentRequest const& r);
 
+/**
+ * Pre-renders the constant conditions of a policy document.
+ *
+ * Applications that mint many signed POST policies differing only in a
+ * few fields (typically the object key and the expiration) pay to
+ * re-canonicalize the same condition set on every call. This class
+ * compiles the shared conditions to their JSON text once; `Render()`
+ * splices the per-call fields around the cached fragment, producing
+ * exactly the text `PolicyDocumentRequest::StringToSign()` would for
+ * the equivalent document.
+ */
+class PolicyDocumentTemplate {
+ public:
+  explicit PolicyDocumentTemplate(
+      std::vector<PolicyDocumentCondition> common_conditions);
+
+  /// Render the policy text for one document, ready to sign.
+  std::string Render(
+      std::chrono::system_clock::time_point expiration,
+      std::vector<PolicyDocumentCondition> const& call_conditions) const;
+
+ private:
+  std::string common_fragment_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -38,6 +38,59 @@ TEST(PolicyDocumentRequest, SigningAccount) {
               ::testing::ElementsAre("test-delegate1", "test-delegate2"));
 }
 
+TEST(PolicyDocumentTemplate, RendersSameTextAsStringToSign) {
+  std::vector<PolicyDocumentCondition> common{
+      PolicyDocumentCondition::ExactMatchObject("bucket", "travel-maps"),
+      PolicyDocumentCondition::ExactMatchObject("acl", "public-read"),
+      PolicyDocumentCondition::ContentLengthRange(0, 1000000),
+  };
+  std::vector<PolicyDocumentCondition> per_call{
+      PolicyDocumentCondition::ExactMatchObject("key", "test-object"),
+  };
+  auto expiration =
+      std::chrono::system_clock::now() + std::chrono::minutes(15);
+
+  PolicyDocument document;
+  document.expiration = expiration;
+  document.conditions = common;
+  document.conditions.insert(document.conditions.end(), per_call.begin(),
+                             per_call.end());
+  PolicyDocumentRequest request(document);
+
+  PolicyDocumentTemplate compiled(common);
+  EXPECT_EQ(request.StringToSign(), compiled.Render(expiration, per_call));
+}
+
+TEST(PolicyDocumentTemplate, RendersDocumentsWithoutConditions) {
+  auto expiration =
+      std::chrono::system_clock::now() + std::chrono::minutes(15);
+  PolicyDocument document;
+  document.expiration = expiration;
+  PolicyDocumentRequest request(document);
+
+  PolicyDocumentTemplate compiled({});
+  EXPECT_EQ(request.StringToSign(), compiled.Render(expiration, {}));
+}
+
+TEST(PolicyDocumentTemplate, SkipsConditionsOmittedFromTheSignedText) {
+  std::vector<PolicyDocumentCondition> common{
+      PolicyDocumentCondition::ExactMatchObject("bucket", "travel-maps"),
+      // List-form conditions do not appear in the signed text today,
+      // the template must drop them just like `StringToSign()` does.
+      PolicyDocumentCondition::StartsWith("key", "photos/"),
+  };
+  auto expiration =
+      std::chrono::system_clock::now() + std::chrono::minutes(15);
+
+  PolicyDocument document;
+  document.expiration = expiration;
+  document.conditions = common;
+  PolicyDocumentRequest request(document);
+
+  PolicyDocumentTemplate compiled(common);
+  EXPECT_EQ(request.StringToSign(), compiled.Render(expiration, {}));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
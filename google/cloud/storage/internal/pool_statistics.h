@@ -0,0 +1,66 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POOL_STATISTICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POOL_STATISTICS_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Connection-pool counters for monitoring purposes.
+ *
+ * Applications can export these counters to their metrics pipeline to
+ * distinguish (for example) throughput dips caused by pool exhaustion from
+ * dips caused by connection churn. The counters are cumulative since the
+ * factory (or client) was created.
+ */
+struct PoolStatistics {
+  /// Requests that found an idle handle in the pool.
+  std::uint64_t handle_pool_hits = 0;
+  /// Requests that had to create a new handle.
+  std::uint64_t handle_pool_misses = 0;
+  /// Handles closed because they expired or the pool was full.
+  std::uint64_t handle_evictions = 0;
+  /// Handles (and therefore potential connections) created.
+  std::uint64_t handles_created = 0;
+  /// Handles (and their connections) closed.
+  std::uint64_t handles_closed = 0;
+  /// Total time spent waiting to acquire a handle from the pool.
+  std::chrono::microseconds acquire_wait_time = std::chrono::microseconds(0);
+
+  PoolStatistics& operator+=(PoolStatistics const& rhs) {
+    handle_pool_hits += rhs.handle_pool_hits;
+    handle_pool_misses += rhs.handle_pool_misses;
+    handle_evictions += rhs.handle_evictions;
+    handles_created += rhs.handles_created;
+    handles_closed += rhs.handles_closed;
+    acquire_wait_time += rhs.acquire_wait_time;
+    return *this;
+  }
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POOL_STATISTICS_H
@@ -18,6 +18,7 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/version.h"
 #include <functional>
+#include <future>
 #include <iterator>
 #include <string>
 #include <utility>
@@ -117,19 +118,32 @@ class PaginationRange {
   using iterator = PaginationIterator<T, PaginationRange>;
 
   /**
-   * Return an iterator over the list of hmacKeys.
+   * Return an iterator over the elements in the range.
    *
-   * The returned iterator is a single-pass input iterator that reads object
-   * metadata from the ListHmacKeysReader when incremented.
+   * The returned iterator is a single-pass input iterator that fetches new
+   * pages from the service as needed when incremented.
    *
    * Creating, and particularly incrementing, multiple iterators on the same
-   * ListHmacKeysReader is unsupported and can produce incorrect results.
+   * range is unsupported and can produce incorrect results.
    */
   iterator begin() { return GetNext(); }
 
   /// Return an iterator pointing to the end of the stream.
   iterator end() { return PaginationIterator<T, PaginationRange>{}; }
 
+  /**
+   * Fetch the next page in the background while the current one is consumed.
+   *
+   * Normally the next page is requested only when the current one is
+   * exhausted, which inserts a full round-trip stall into every page
+   * boundary. With prefetch enabled the range issues the request for page
+   * N+1 as soon as page N is installed, roughly doubling the throughput of
+   * long listings.
+   *
+   * Must be called before `begin()`.
+   */
+  void EnablePagePrefetch() { prefetch_enabled_ = true; }
+
  protected:
   friend class PaginationIterator<T, PaginationRange>;
 
@@ -143,13 +157,18 @@ class PaginationRange {
   iterator GetNext() {
     static Status const past_the_end_error(
         StatusCode::kFailedPrecondition,
-        "Cannot iterating past the end of ListObjectReader");
+        "Cannot iterating past the end of the pagination range");
     if (current_page_.end() == current_) {
       if (on_last_page_) {
         return iterator(nullptr, past_the_end_error);
       }
-      request_.set_page_token(std::move(next_page_token_));
-      auto response = next_page_loader_(request_);
+      StatusOr<Response> response = [this] {
+        if (prefetch_.valid()) {
+          return prefetch_.get();
+        }
+        request_.set_page_token(std::move(next_page_token_));
+        return next_page_loader_(request_);
+      }();
       if (!response.ok()) {
         next_page_token_.clear();
         current_page_.clear();
@@ -162,6 +181,8 @@ class PaginationRange {
       current_ = current_page_.begin();
       if (next_page_token_.empty()) {
         on_last_page_ = true;
+      } else if (prefetch_enabled_) {
+        StartPrefetch();
       }
       if (current_page_.end() == current_) {
         return iterator(nullptr, past_the_end_error);
@@ -171,12 +192,24 @@ class PaginationRange {
   }
 
  private:
+  /// Request the page for `next_page_token_` in the background.
+  void StartPrefetch() {
+    request_.set_page_token(std::move(next_page_token_));
+    next_page_token_.clear();
+    auto loader = next_page_loader_;
+    auto request = request_;
+    prefetch_ = std::async(std::launch::async,
+                           [loader, request] { return loader(request); });
+  }
+
   Request request_;
   std::function<StatusOr<Response>(Request const& r)> next_page_loader_;
   std::vector<T> current_page_;
   typename std::vector<T>::iterator current_;
   std::string next_page_token_;
   bool on_last_page_;
+  bool prefetch_enabled_ = false;
+  std::future<StatusOr<Response>> prefetch_;
 };
 
 }  // namespace internal
@@ -0,0 +1,69 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  auto p = std::make_shared<promise<StatusOr<ObjectMetadata>>>();
+  auto f = p->get_future();
+  auto r = request;
+  SubmitBackgroundTask(client_options(),
+                       [this, p, r] { p->set_value(InsertObjectMedia(r)); });
+  return f;
+}
+
+future<StatusOr<std::unique_ptr<ObjectReadSource>>> RawClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto p = std::make_shared<
+      promise<StatusOr<std::unique_ptr<ObjectReadSource>>>>();
+  auto f = p->get_future();
+  auto r = request;
+  SubmitBackgroundTask(client_options(),
+                       [this, p, r] { p->set_value(ReadObject(r)); });
+  return f;
+}
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  auto p = std::make_shared<promise<StatusOr<ObjectMetadata>>>();
+  auto f = p->get_future();
+  auto r = request;
+  SubmitBackgroundTask(client_options(),
+                       [this, p, r] { p->set_value(GetObjectMetadata(r)); });
+  return f;
+}
+
+future<StatusOr<EmptyResponse>> RawClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  auto p = std::make_shared<promise<StatusOr<EmptyResponse>>>();
+  auto f = p->get_future();
+  auto r = request;
+  SubmitBackgroundTask(client_options(),
+                       [this, p, r] { p->set_value(DeleteObject(r)); });
+  return f;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
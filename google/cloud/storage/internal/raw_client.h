@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H
 
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/bucket_metadata.h"
@@ -30,6 +31,7 @@
 #include "google/cloud/storage/internal/object_read_source.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/pool_statistics.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/internal/service_account_requests.h"
 #include "google/cloud/storage/internal/sign_blob_requests.h"
@@ -52,6 +54,14 @@ class RawClient {
 
   virtual ClientOptions const& client_options() const = 0;
 
+  /**
+   * Returns the connection-pool counters for this client.
+   *
+   * Transports that do not pool connections return all-zero counters.
+   * Decorators forward the call to the client they wrap.
+   */
+  virtual PoolStatistics pool_statistics() const { return PoolStatistics{}; }
+
   //@{
   /// @name Bucket resource operations
   virtual StatusOr<ListBucketsResponse> ListBuckets(
@@ -102,6 +112,26 @@ class RawClient {
   RestoreResumableSession(std::string const& session_id) = 0;
   //@}
 
+  //@{
+  /**
+   * @name Asynchronous object operations.
+   *
+   * These operations do not block the calling thread, they return a `future`
+   * satisfied when the operation completes. The default implementations run
+   * the synchronous operation in a shared thread pool, derived classes may
+   * override them with a natively asynchronous implementation. The client
+   * must not be destroyed while any of these futures are pending.
+   */
+  virtual future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request);
+  virtual future<StatusOr<std::unique_ptr<ObjectReadSource>>> AsyncReadObject(
+      ReadObjectRangeRequest const& request);
+  virtual future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request);
+  virtual future<StatusOr<EmptyResponse>> AsyncDeleteObject(
+      DeleteObjectRequest const& request);
+  //@}
+
   //@{
   /// @name BucketAccessControls resource operations
   virtual StatusOr<ListBucketAclResponse> ListBucketAcl(
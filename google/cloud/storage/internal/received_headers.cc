@@ -0,0 +1,90 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/received_headers.h"
+#include <algorithm>
+#include <cctype>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// Enough for a typical response, a single reservation avoids the vector
+// growth reallocations on the hot path.
+std::size_t constexpr kTypicalHeaderCount = 16;
+
+char ToLower(char c) {
+  return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+// The stored names are lowercase, @p name may be in any case.
+bool EqualsStoredName(std::string const& stored, char const* name) {
+  auto it = stored.begin();
+  for (; it != stored.end() && *name != '\0'; ++it, ++name) {
+    if (*it != ToLower(*name)) {
+      return false;
+    }
+  }
+  return it == stored.end() && *name == '\0';
+}
+}  // namespace
+
+ReceivedHeaders::ReceivedHeaders(std::initializer_list<value_type> list) {
+  headers_.reserve(list.size());
+  for (auto const& kv : list) {
+    emplace(kv.first, kv.second);
+  }
+}
+
+ReceivedHeaders::const_iterator ReceivedHeaders::find(char const* name) const {
+  return std::find_if(headers_.begin(), headers_.end(),
+                      [name](value_type const& kv) {
+                        return EqualsStoredName(kv.first, name);
+                      });
+}
+
+std::size_t ReceivedHeaders::count(char const* name) const {
+  return static_cast<std::size_t>(
+      std::count_if(headers_.begin(), headers_.end(),
+                    [name](value_type const& kv) {
+                      return EqualsStoredName(kv.first, name);
+                    }));
+}
+
+void ReceivedHeaders::emplace(std::string name, std::string value) {
+  std::transform(name.begin(), name.end(), name.begin(), ToLower);
+  if (headers_.empty()) {
+    headers_.reserve(kTypicalHeaderCount);
+  }
+  headers_.emplace_back(std::move(name), std::move(value));
+}
+
+void ReceivedHeaders::Append(char const* name_begin, char const* name_end,
+                             char const* value_begin, char const* value_end) {
+  if (headers_.empty()) {
+    headers_.reserve(kTypicalHeaderCount);
+  }
+  headers_.emplace_back(std::string(name_begin, name_end),
+                        std::string(value_begin, value_end));
+  auto& name = headers_.back().first;
+  std::transform(name.begin(), name.end(), name.begin(), ToLower);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,96 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECEIVED_HEADERS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECEIVED_HEADERS_H
+
+#include "google/cloud/storage/version.h"
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * The headers received in a HTTP response, as a flat container.
+ *
+ * This used to be a `std::multimap<std::string, std::string>`, which
+ * allocates a red-black-tree node (plus the two strings) for every header,
+ * while a typical response carries a dozen headers and the library only
+ * looks up two or three well-known keys. The headers are kept in a vector,
+ * in arrival order, and lookups are linear with case-insensitive
+ * comparison; for the header counts seen in practice a linear scan over
+ * contiguous memory beats the tree walk, and the short-string optimization
+ * covers most header names and values.
+ *
+ * The class implements the (small) subset of the `std::multimap` interface
+ * used by the library: iteration, `find()`, `count()`, and `emplace()`.
+ * Lookups accept a C string so callers do not allocate a temporary key.
+ */
+class ReceivedHeaders {
+ public:
+  using value_type = std::pair<std::string, std::string>;
+  using const_iterator = std::vector<value_type>::const_iterator;
+  using iterator = const_iterator;
+
+  ReceivedHeaders() = default;
+  ReceivedHeaders(std::initializer_list<value_type> list);
+
+  bool empty() const { return headers_.empty(); }
+  std::size_t size() const { return headers_.size(); }
+  const_iterator begin() const { return headers_.begin(); }
+  const_iterator end() const { return headers_.end(); }
+  void clear() { headers_.clear(); }
+
+  /// Return the first header named @p name, compared case-insensitively.
+  const_iterator find(char const* name) const;
+  const_iterator find(std::string const& name) const {
+    return find(name.c_str());
+  }
+
+  /// Count the headers named @p name, compared case-insensitively.
+  std::size_t count(char const* name) const;
+  std::size_t count(std::string const& name) const {
+    return count(name.c_str());
+  }
+
+  /// Add a header, the name is stored in lowercase.
+  void emplace(std::string name, std::string value);
+
+  /**
+   * Add a header copied from the ranges `[name_begin, name_end)` and
+   * `[value_begin, value_end)`, lowercasing the name while copying.
+   *
+   * This is the allocation-light path for the libcurl header callback, the
+   * header is copied straight from the buffer owned by libcurl.
+   */
+  void Append(char const* name_begin, char const* name_end,
+              char const* value_begin, char const* value_end);
+
+ private:
+  std::vector<value_type> headers_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECEIVED_HEADERS_H
@@ -0,0 +1,86 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/received_headers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+TEST(ReceivedHeadersTest, Empty) {
+  ReceivedHeaders headers;
+  EXPECT_TRUE(headers.empty());
+  EXPECT_EQ(0U, headers.size());
+  EXPECT_TRUE(headers.find("content-type") == headers.end());
+  EXPECT_EQ(0U, headers.count("content-type"));
+}
+
+TEST(ReceivedHeadersTest, NamesAreStoredLowercase) {
+  ReceivedHeaders headers;
+  headers.emplace("Content-Type", "application/json");
+  headers.emplace("X-Goog-Generation", "12345");
+  EXPECT_THAT(headers,
+              ElementsAre(Pair("content-type", "application/json"),
+                          Pair("x-goog-generation", "12345")));
+}
+
+TEST(ReceivedHeadersTest, FindIsCaseInsensitive) {
+  ReceivedHeaders headers{{"content-type", "application/json"},
+                          {"x-goog-generation", "12345"}};
+  auto loc = headers.find("Content-Type");
+  ASSERT_TRUE(loc != headers.end());
+  EXPECT_EQ("application/json", loc->second);
+  EXPECT_TRUE(headers.find("content-length") == headers.end());
+  // Prefix matches are not matches.
+  EXPECT_TRUE(headers.find("content") == headers.end());
+  EXPECT_TRUE(headers.find("content-type-extended") == headers.end());
+}
+
+TEST(ReceivedHeadersTest, CountDuplicates) {
+  ReceivedHeaders headers{{"x-test", "a"},
+                          {"x-other", "b"},
+                          {"X-Test", "c"}};
+  EXPECT_EQ(2U, headers.count("x-test"));
+  EXPECT_EQ(2U, headers.count("X-TEST"));
+  EXPECT_EQ(1U, headers.count("x-other"));
+  // `find()` returns the first header in arrival order.
+  EXPECT_EQ("a", headers.find("x-test")->second);
+}
+
+TEST(ReceivedHeadersTest, AppendFromRanges) {
+  std::string const name = "X-Goog-Hash";
+  std::string const value = "crc32c=AAAAAA==";
+  ReceivedHeaders headers;
+  headers.Append(name.data(), name.data() + name.size(), value.data(),
+                 value.data() + value.size());
+  std::string const empty_name = "x-test-empty";
+  headers.Append(empty_name.data(), empty_name.data() + empty_name.size(),
+                 value.data(), value.data());
+  EXPECT_THAT(headers, ElementsAre(Pair("x-goog-hash", "crc32c=AAAAAA=="),
+                                   Pair("x-test-empty", "")));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,104 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECYCLING_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECYCLING_POOL_H
+
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Recycles objects that are expensive to recreate.
+ *
+ * The canonical use is `std::string` staging buffers on the upload hot
+ * path: such buffers grow to the size of the payload, and recycling them
+ * keeps their capacity, so steady-state request issue performs no heap
+ * allocations for staging.
+ *
+ * Recycled objects are returned in an unspecified state, callers must reset
+ * them (for strings `clear()` does, and keeps the capacity). The pool must
+ * outlive all the handles it returns.
+ */
+template <typename T>
+class RecyclingPool {
+ public:
+  /// @param maximum_size objects released beyond this limit are destroyed
+  ///   instead of pooled, bounding the memory retained by an idle pool.
+  explicit RecyclingPool(std::size_t maximum_size = 16)
+      : maximum_size_(maximum_size) {}
+
+  RecyclingPool(RecyclingPool const&) = delete;
+  RecyclingPool& operator=(RecyclingPool const&) = delete;
+
+  /// Returns the object to the pool (or destroys it) when the handle goes
+  /// out of scope.
+  class Deleter {
+   public:
+    explicit Deleter(RecyclingPool* pool = nullptr) : pool_(pool) {}
+    void operator()(T* object) const {
+      if (pool_ == nullptr) {
+        delete object;
+        return;
+      }
+      pool_->Release(std::unique_ptr<T>(object));
+    }
+
+   private:
+    RecyclingPool* pool_;
+  };
+  using Handle = std::unique_ptr<T, Deleter>;
+
+  /// Returns a recycled object, or a default-constructed one if the pool is
+  /// empty.
+  Handle Acquire() {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!pool_.empty()) {
+      auto object = std::move(pool_.back());
+      pool_.pop_back();
+      lk.unlock();
+      return Handle(object.release(), Deleter(this));
+    }
+    lk.unlock();
+    return Handle(new T, Deleter(this));
+  }
+
+ private:
+  void Release(std::unique_ptr<T> object) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (pool_.size() >= maximum_size_) {
+      // Destroyed when `object` goes out of scope.
+      return;
+    }
+    pool_.push_back(std::move(object));
+  }
+
+  std::size_t const maximum_size_;
+  std::mutex mu_;
+  std::vector<std::unique_ptr<T>> pool_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RECYCLING_POOL_H
@@ -0,0 +1,68 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/recycling_pool.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(RecyclingPoolTest, RecyclesObjects) {
+  RecyclingPool<std::string> pool;
+  std::string* recycled;
+  {
+    auto buffer = pool.Acquire();
+    buffer->assign("some contents");
+    recycled = buffer.get();
+  }
+  auto buffer = pool.Acquire();
+  EXPECT_EQ(recycled, buffer.get());
+}
+
+TEST(RecyclingPoolTest, RetainsStringCapacity) {
+  RecyclingPool<std::string> pool;
+  std::size_t capacity;
+  {
+    auto buffer = pool.Acquire();
+    buffer->assign(std::string(1024, 'a'));
+    capacity = buffer->capacity();
+  }
+  auto buffer = pool.Acquire();
+  buffer->clear();
+  EXPECT_GE(buffer->capacity(), capacity);
+}
+
+TEST(RecyclingPoolTest, RespectsMaximumSize) {
+  RecyclingPool<std::string> pool(1);
+  auto a = pool.Acquire();
+  auto b = pool.Acquire();
+  auto* first = a.get();
+  a.reset();
+  // The pool is full, this one is destroyed instead of pooled.
+  b.reset();
+  auto c = pool.Acquire();
+  EXPECT_EQ(first, c.get());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
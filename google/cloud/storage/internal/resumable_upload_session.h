@@ -17,6 +17,7 @@
 
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/version.h"
@@ -41,22 +42,30 @@ class ResumableUploadSession {
   /**
    * Uploads a chunk and returns the resulting response.
    *
-   * @param buffer the chunk to upload.
+   * The chunk is borrowed: the memory viewed by @p buffers must remain valid
+   * until this function returns. Sharing views (instead of copying the chunk
+   * at each layer) lets retries resend the same bytes without any payload
+   * copies, and lets the caller reuse its buffer as soon as the chunk is
+   * committed.
+   *
+   * @param buffers the chunk to upload, as a sequence of borrowed views.
    * @return The result of uploading the chunk.
    */
   virtual StatusOr<ResumableUploadResponse> UploadChunk(
-      std::string const& buffer) = 0;
+      ConstBufferSequence const& buffers) = 0;
 
   /**
    * Uploads the final chunk in a stream, committing all previous data.
    *
-   * @param buffer the chunk to upload.
+   * The chunk is borrowed, see `UploadChunk()` for the lifetime requirements.
+   *
+   * @param buffers the chunk to upload, as a sequence of borrowed views.
    * @param upload_size the total size of the upload, use `0` if the size is not
    *   known.
    * @return The final result of the upload, including the object metadata.
    */
   virtual StatusOr<ResumableUploadResponse> UploadFinalChunk(
-      std::string const& buffer, std::uint64_t upload_size) = 0;
+      ConstBufferSequence const& buffers, std::uint64_t upload_size) = 0;
 
   /// Resets the session by querying its current state.
   virtual StatusOr<ResumableUploadResponse> ResetSession() = 0;
@@ -124,11 +133,12 @@ class ResumableUploadSessionError : public ResumableUploadSession {
 
   ~ResumableUploadSessionError() override = default;
 
-  StatusOr<ResumableUploadResponse> UploadChunk(std::string const&) override {
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      ConstBufferSequence const&) override {
     return last_response_;
   }
 
-  StatusOr<ResumableUploadResponse> UploadFinalChunk(std::string const&,
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(ConstBufferSequence const&,
                                                      std::uint64_t) override {
     return last_response_;
   }
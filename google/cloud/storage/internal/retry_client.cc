@@ -17,6 +17,11 @@
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
 #include "google/cloud/storage/internal/retry_object_read_source.h"
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 
@@ -48,25 +53,85 @@ namespace {
 
 using ::google::cloud::storage::internal::raw_client_wrapper_utils::Signature;
 
+/**
+ * Per-call retry state that defers cloning the policy prototype.
+ *
+ * Each operation needs its own mutable retry state, but that state is only
+ * consulted after an attempt fails. Cloning the prototype eagerly costs a
+ * virtual call and an allocation on every request, even when the first
+ * attempt succeeds (the common case). This wrapper clones the prototype on
+ * the first failure instead, so successful calls perform no allocations.
+ *
+ * A policy whose fresh clones are born exhausted (e.g.
+ * `LimitedTimeRetryPolicy(0ms)`) must report `IsExhausted()` before the
+ * first attempt; the caller detects that property once when the prototype
+ * is installed and passes it as @p starts_exhausted.
+ */
+class LazyRetryPolicy {
+ public:
+  LazyRetryPolicy(RetryPolicy const& prototype, bool starts_exhausted)
+      : prototype_(prototype), starts_exhausted_(starts_exhausted) {}
+
+  bool IsExhausted() const {
+    return clone_ ? clone_->IsExhausted() : starts_exhausted_;
+  }
+
+  bool OnFailure(Status const& status) {
+    if (!clone_) clone_ = prototype_.clone();
+    return clone_->OnFailure(status);
+  }
+
+ private:
+  RetryPolicy const& prototype_;
+  bool starts_exhausted_;
+  std::unique_ptr<RetryPolicy> clone_;
+};
+
+/**
+ * Per-call backoff state, cloned from the prototype on the first backoff.
+ */
+class LazyBackoffPolicy {
+ public:
+  explicit LazyBackoffPolicy(BackoffPolicy const& prototype)
+      : prototype_(prototype) {}
+
+  std::chrono::milliseconds OnCompletion() {
+    if (!clone_) clone_ = prototype_.clone();
+    return clone_->OnCompletion();
+  }
+
+ private:
+  BackoffPolicy const& prototype_;
+  std::unique_ptr<BackoffPolicy> clone_;
+};
+
 /**
  * Calls a client operation with retries borrowing the RPC policies.
  *
  * @tparam MemberFunction the signature of the member function.
+ * @tparam RetryPolicyType a type implementing `IsExhausted()` and
+ *     `OnFailure()`, either `RetryPolicy` or `LazyRetryPolicy`.
+ * @tparam BackoffPolicyType a type implementing `OnCompletion()`, either
+ *     `BackoffPolicy` or `LazyBackoffPolicy`.
  * @param client the storage::Client object to make the call through.
  * @param retry_policy the policy controlling what failures are retryable, and
  *     for how long we can retry
  * @param backoff_policy the policy controlling how long to wait before
  *     retrying.
+ * @param throttler the admission controller shared by all operations of the
+ *     client, attempts it rejects are not sent to the service.
  * @param function the pointer to the member function to call.
  * @param request an initialized request parameter for the call.
  * @param error_message include this message in any exception or error log.
  * @return the result from making the call;
  * @throw std::exception with a description of the last error.
  */
-template <typename MemberFunction>
+template <typename MemberFunction, typename RetryPolicyType,
+          typename BackoffPolicyType>
 typename Signature<MemberFunction>::ReturnType MakeCall(
-    RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
-    bool is_idempotent, RawClient& client, MemberFunction function,
+    RetryPolicyType& retry_policy, BackoffPolicyType& backoff_policy,
+    AdaptiveThrottler& throttler, bool is_idempotent, RawClient& client,
+    MemberFunction function,
     typename Signature<MemberFunction>::RequestType const& request,
     char const* error_message) {
   Status last_status(StatusCode::kDeadlineExceeded,
@@ -75,12 +140,60 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
     return Status(last_status.code(), msg);
   };
 
+  // The overall deadline, if any, is consumed across all the attempts:
+  // no new attempt starts after it expires, and backoff waits are
+  // clipped to the remaining budget.
+  bool const has_deadline = request.template HasOption<OperationDeadline>();
+  auto const deadline =
+      std::chrono::steady_clock::now() +
+      (has_deadline
+           ? request.template GetOption<OperationDeadline>().value()
+           : std::chrono::milliseconds(0));
+  auto deadline_expired = [has_deadline, deadline] {
+    return has_deadline && std::chrono::steady_clock::now() >= deadline;
+  };
+  auto backoff = [has_deadline, deadline,
+                  &backoff_policy](std::chrono::milliseconds delay) {
+    if (has_deadline) {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+      delay = (std::min)(delay, remaining);
+    }
+    if (delay.count() > 0) {
+      std::this_thread::sleep_for(delay);
+    }
+  };
+
   while (!retry_policy.IsExhausted()) {
+    if (deadline_expired()) {
+      std::ostringstream os;
+      os << "Operation deadline expired in " << error_message << ": "
+         << last_status;
+      return Status(StatusCode::kDeadlineExceeded, std::move(os).str());
+    }
+    if (!throttler.Allow()) {
+      // The request never reached the service, so it is safe to retry after
+      // a backoff, even for non-idempotent operations.
+      last_status = Status(StatusCode::kUnavailable,
+                           "rejected by the client-side adaptive throttler");
+      if (!retry_policy.OnFailure(last_status)) {
+        break;
+      }
+      backoff(backoff_policy.OnCompletion());
+      continue;
+    }
     auto result = (client.*function)(request);
     if (result.ok()) {
+      throttler.RecordAccept();
       return result;
     }
     last_status = std::move(result).status();
+    // Overload rejections (HTTP 429 and 503) do not count as accepted,
+    // anything else does, including application-level errors such as 404.
+    if (last_status.code() != StatusCode::kResourceExhausted &&
+        last_status.code() != StatusCode::kUnavailable) {
+      throttler.RecordAccept();
+    }
     if (!is_idempotent) {
       std::ostringstream os;
       os << "Error in non-idempotent operation " << error_message << ": "
@@ -99,13 +212,49 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
       // Exit the loop immediately instead of sleeping before trying again.
       break;
     }
-    auto delay = backoff_policy.OnCompletion();
-    std::this_thread::sleep_for(delay);
+    backoff(backoff_policy.OnCompletion());
   }
   std::ostringstream os;
   os << "Retry policy exhausted in " << error_message << ": " << last_status;
   return error(std::move(os).str());
 }
+
+/**
+ * Runs @p attempt, starting a backup attempt if it is slower than @p delay.
+ *
+ * Returns the result of whichever attempt completes first. The losing
+ * attempt is not interrupted, its result is discarded when it completes and
+ * any resources it acquired are released at that point.
+ */
+template <typename Result, typename Functor>
+Result HedgedCall(ClientOptions const& options, std::chrono::milliseconds delay,
+                  Functor attempt) {
+  struct State {
+    std::mutex mu;
+    bool settled = false;
+    promise<Result> result;
+  };
+  auto state = std::make_shared<State>();
+  auto launch = [&options, state, attempt] {
+    SubmitBackgroundTask(options, [state, attempt]() mutable {
+      auto result = attempt();
+      std::unique_lock<std::mutex> lk(state->mu);
+      if (state->settled) {
+        // The other attempt won, discard this result.
+        return;
+      }
+      state->settled = true;
+      lk.unlock();
+      state->result.set_value(std::move(result));
+    });
+  };
+  auto f = state->result.get_future();
+  launch();
+  if (f.wait_for(delay) == std::future_status::timeout) {
+    launch();
+  }
+  return f.get();
+}
 }  // namespace
 
 RetryClient::RetryClient(std::shared_ptr<RawClient> client, DefaultPolicies)
@@ -119,161 +268,212 @@ RetryClient::RetryClient(std::shared_ptr<RawClient> client, DefaultPolicies)
                                STORAGE_CLIENT_DEFAULT_BACKOFF_SCALING)
           .clone();
   idempotency_policy_ = AlwaysRetryIdempotencyPolicy().clone();
+  retry_policy_starts_exhausted_ =
+      retry_policy_prototype_->clone()->IsExhausted();
+  throttler_ = std::make_shared<AdaptiveThrottler>();
 }
 
 ClientOptions const& RetryClient::client_options() const {
   return client_->client_options();
 }
 
+PoolStatistics RetryClient::pool_statistics() const {
+  return client_->pool_statistics();
+}
+
 StatusOr<ListBucketsResponse> RetryClient::ListBuckets(
     ListBucketsRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListBuckets, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListBuckets, request, __func__);
 }
 
 StatusOr<BucketMetadata> RetryClient::CreateBucket(
     CreateBucketRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateBucket, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateBucket, request, __func__);
 }
 
 StatusOr<BucketMetadata> RetryClient::GetBucketMetadata(
     GetBucketMetadataRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetBucketMetadata, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetBucketMetadata, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteBucket(
     DeleteBucketRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteBucket, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteBucket, request, __func__);
 }
 
 StatusOr<BucketMetadata> RetryClient::UpdateBucket(
     UpdateBucketRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateBucket, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateBucket, request, __func__);
 }
 
 StatusOr<BucketMetadata> RetryClient::PatchBucket(
     PatchBucketRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::PatchBucket, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::PatchBucket, request, __func__);
 }
 
 StatusOr<IamPolicy> RetryClient::GetBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetBucketIamPolicy, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetBucketIamPolicy, request, __func__);
 }
 
 StatusOr<NativeIamPolicy> RetryClient::GetNativeBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetNativeBucketIamPolicy, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetNativeBucketIamPolicy, request,
+                  __func__);
 }
 
 StatusOr<IamPolicy> RetryClient::SetBucketIamPolicy(
     SetBucketIamPolicyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::SetBucketIamPolicy, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::SetBucketIamPolicy, request, __func__);
 }
 
 StatusOr<NativeIamPolicy> RetryClient::SetNativeBucketIamPolicy(
     SetNativeBucketIamPolicyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::SetNativeBucketIamPolicy, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::SetNativeBucketIamPolicy, request,
+                  __func__);
 }
 
 StatusOr<TestBucketIamPermissionsResponse>
 RetryClient::TestBucketIamPermissions(
     TestBucketIamPermissionsRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::TestBucketIamPermissions, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::TestBucketIamPermissions, request,
+                  __func__);
 }
 
 StatusOr<BucketMetadata> RetryClient::LockBucketRetentionPolicy(
     LockBucketRetentionPolicyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::LockBucketRetentionPolicy, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::LockBucketRetentionPolicy, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::InsertObjectMedia(
     InsertObjectMediaRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::InsertObjectMedia, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::InsertObjectMedia, request, __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::CopyObject(
     CopyObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CopyObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CopyObject, request, __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::GetObjectMetadata(
     GetObjectMetadataRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetObjectMetadata, request, __func__);
+  if (hedging_policy_.enabled() && is_idempotent) {
+    auto self = shared_from_this();
+    return HedgedCall<StatusOr<ObjectMetadata>>(
+        client_options(), hedging_policy_.delay(), [self, request] {
+          LazyRetryPolicy retry_policy(*self->retry_policy_prototype_,
+                                       self->retry_policy_starts_exhausted_);
+          LazyBackoffPolicy backoff_policy(*self->backoff_policy_prototype_);
+          return MakeCall(retry_policy, backoff_policy, *self->throttler_,
+                          true, *self->client_, &RawClient::GetObjectMetadata,
+                          request, "GetObjectMetadata");
+        });
+  }
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetObjectMetadata, request, __func__);
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObjectNotWrapped(
     ReadObjectRangeRequest const& request, RetryPolicy& retry_policy,
     BackoffPolicy& backoff_policy) {
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(retry_policy, backoff_policy, is_idempotent, *client_,
-                  &RawClient::ReadObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ReadObject, request, __func__);
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObject(
     ReadObjectRangeRequest const& request) {
   auto retry_policy = retry_policy_prototype_->clone();
   auto backoff_policy = backoff_policy_prototype_->clone();
-  auto child = ReadObjectNotWrapped(request, *retry_policy, *backoff_policy);
+  auto child = [&]() -> StatusOr<std::unique_ptr<ObjectReadSource>> {
+    if (hedging_policy_.enabled() &&
+        idempotency_policy_->IsIdempotent(request)) {
+      auto self = shared_from_this();
+      return HedgedCall<StatusOr<std::unique_ptr<ObjectReadSource>>>(
+          client_options(), hedging_policy_.delay(), [self, request] {
+            auto retry_policy = self->retry_policy_prototype_->clone();
+            auto backoff_policy = self->backoff_policy_prototype_->clone();
+            return self->ReadObjectNotWrapped(request, *retry_policy,
+                                              *backoff_policy);
+          });
+    }
+    return ReadObjectNotWrapped(request, *retry_policy, *backoff_policy);
+  }();
   if (!child) {
     return child;
   }
@@ -285,56 +485,62 @@ StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObject(
 
 StatusOr<ListObjectsResponse> RetryClient::ListObjects(
     ListObjectsRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListObjects, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListObjects, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteObject(
     DeleteObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteObject, request, __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::UpdateObject(
     UpdateObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateObject, request, __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::PatchObject(
     PatchObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::PatchObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::PatchObject, request, __func__);
 }
 
 StatusOr<ObjectMetadata> RetryClient::ComposeObject(
     ComposeObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ComposeObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ComposeObject, request, __func__);
 }
 
 StatusOr<RewriteObjectResponse> RetryClient::RewriteObject(
     RewriteObjectRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::RewriteObject, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::RewriteObject, request, __func__);
 }
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
@@ -343,8 +549,9 @@ RetryClient::CreateResumableSession(ResumableUploadRequest const& request) {
   auto backoff_policy = backoff_policy_prototype_->clone();
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
   auto result =
-      MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-               &RawClient::CreateResumableSession, request, __func__);
+      MakeCall(*retry_policy, *backoff_policy, *throttler_, is_idempotent,
+               *client_, &RawClient::CreateResumableSession, request,
+               __func__);
   if (!result.ok()) {
     return result;
   }
@@ -357,272 +564,308 @@ RetryClient::CreateResumableSession(ResumableUploadRequest const& request) {
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
 RetryClient::RestoreResumableSession(std::string const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = true;
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::RestoreResumableSession, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::RestoreResumableSession, request,
+                  __func__);
 }
 
 StatusOr<ListBucketAclResponse> RetryClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListBucketAcl, request, __func__);
 }
 
 StatusOr<BucketAccessControl> RetryClient::GetBucketAcl(
     GetBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetBucketAcl, request, __func__);
 }
 
 StatusOr<BucketAccessControl> RetryClient::CreateBucketAcl(
     CreateBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateBucketAcl, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteBucketAcl(
     DeleteBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteBucketAcl, request, __func__);
 }
 
 StatusOr<ListObjectAclResponse> RetryClient::ListObjectAcl(
     ListObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListObjectAcl, request, __func__);
 }
 
 StatusOr<BucketAccessControl> RetryClient::UpdateBucketAcl(
     UpdateBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateBucketAcl, request, __func__);
 }
 
 StatusOr<BucketAccessControl> RetryClient::PatchBucketAcl(
     PatchBucketAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::PatchBucketAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::PatchBucketAcl, request, __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::CreateObjectAcl(
     CreateObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateObjectAcl, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteObjectAcl(
     DeleteObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteObjectAcl, request, __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::GetObjectAcl(
     GetObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetObjectAcl, request, __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::UpdateObjectAcl(
     UpdateObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateObjectAcl, request, __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::PatchObjectAcl(
     PatchObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::PatchObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::PatchObjectAcl, request, __func__);
 }
 
 StatusOr<ListDefaultObjectAclResponse> RetryClient::ListDefaultObjectAcl(
     ListDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::CreateDefaultObjectAcl(
     CreateDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteDefaultObjectAcl(
     DeleteDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::GetDefaultObjectAcl(
     GetDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetDefaultObjectAcl, request, __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::UpdateDefaultObjectAcl(
     UpdateDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::PatchDefaultObjectAcl(
     PatchDefaultObjectAclRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::PatchDefaultObjectAcl, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::PatchDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ServiceAccount> RetryClient::GetServiceAccount(
     GetProjectServiceAccountRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetServiceAccount, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetServiceAccount, request, __func__);
 }
 
 StatusOr<ListHmacKeysResponse> RetryClient::ListHmacKeys(
     ListHmacKeysRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListHmacKeys, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListHmacKeys, request, __func__);
 }
 
 StatusOr<CreateHmacKeyResponse> RetryClient::CreateHmacKey(
     CreateHmacKeyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateHmacKey, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateHmacKey, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteHmacKey(
     DeleteHmacKeyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteHmacKey, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteHmacKey, request, __func__);
 }
 
 StatusOr<HmacKeyMetadata> RetryClient::GetHmacKey(
     GetHmacKeyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetHmacKey, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetHmacKey, request, __func__);
 }
 
 StatusOr<HmacKeyMetadata> RetryClient::UpdateHmacKey(
     UpdateHmacKeyRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::UpdateHmacKey, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::UpdateHmacKey, request, __func__);
 }
 
 StatusOr<SignBlobResponse> RetryClient::SignBlob(
     SignBlobRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::SignBlob, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::SignBlob, request, __func__);
 }
 
 StatusOr<ListNotificationsResponse> RetryClient::ListNotifications(
     ListNotificationsRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ListNotifications, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::ListNotifications, request, __func__);
 }
 
 StatusOr<NotificationMetadata> RetryClient::CreateNotification(
     CreateNotificationRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::CreateNotification, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::CreateNotification, request, __func__);
 }
 
 StatusOr<NotificationMetadata> RetryClient::GetNotification(
     GetNotificationRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::GetNotification, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::GetNotification, request, __func__);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteNotification(
     DeleteNotificationRequest const& request) {
-  auto retry_policy = retry_policy_prototype_->clone();
-  auto backoff_policy = backoff_policy_prototype_->clone();
+  LazyRetryPolicy retry_policy(*retry_policy_prototype_,
+                               retry_policy_starts_exhausted_);
+  LazyBackoffPolicy backoff_policy(*backoff_policy_prototype_);
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::DeleteNotification, request, __func__);
+  return MakeCall(retry_policy, backoff_policy, *throttler_, is_idempotent,
+                  *client_, &RawClient::DeleteNotification, request, __func__);
 }
 
 }  // namespace internal
@@ -15,7 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_CLIENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_CLIENT_H
 
+#include "google/cloud/storage/hedging_policy.h"
 #include "google/cloud/storage/idempotency_policy.h"
+#include "google/cloud/storage/internal/adaptive_throttler.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/retry_policy.h"
@@ -48,6 +50,8 @@ class RetryClient : public RawClient,
 
   ClientOptions const& client_options() const override;
 
+  PoolStatistics pool_statistics() const override;
+
   StatusOr<ListBucketsResponse> ListBuckets(
       ListBucketsRequest const& request) override;
   StatusOr<BucketMetadata> CreateBucket(
@@ -164,6 +168,8 @@ class RetryClient : public RawClient,
  private:
   void Apply(RetryPolicy const& policy) {
     retry_policy_prototype_ = policy.clone();
+    retry_policy_starts_exhausted_ =
+        retry_policy_prototype_->clone()->IsExhausted();
   }
 
   void Apply(BackoffPolicy const& policy) {
@@ -174,6 +180,8 @@ class RetryClient : public RawClient,
     idempotency_policy_ = policy.clone();
   }
 
+  void Apply(HedgingPolicy const& policy) { hedging_policy_ = policy; }
+
   void ApplyPolicies() {}
 
   template <typename P, typename... Policies>
@@ -184,8 +192,15 @@ class RetryClient : public RawClient,
 
   std::shared_ptr<RawClient> client_;
   std::shared_ptr<RetryPolicy const> retry_policy_prototype_;
+  // True if fresh clones of `retry_policy_prototype_` are born exhausted,
+  // e.g. `LimitedTimeRetryPolicy(0ms)`. Computed once so the per-call retry
+  // state can answer `IsExhausted()` before its first failure without
+  // cloning the prototype.
+  bool retry_policy_starts_exhausted_ = false;
   std::shared_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::shared_ptr<IdempotencyPolicy const> idempotency_policy_;
+  HedgingPolicy hedging_policy_;
+  std::shared_ptr<AdaptiveThrottler> throttler_;
 };
 
 }  // namespace internal
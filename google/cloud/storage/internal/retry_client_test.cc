@@ -30,6 +30,7 @@ using ::google::cloud::storage::testing::canonical_errors::PermanentError;
 using ::google::cloud::storage::testing::canonical_errors::TransientError;
 using ::testing::_;
 using ::testing::HasSubstr;
+using ::testing::Invoke;
 using ::testing::Return;
 
 class RetryClientTest : public ::testing::Test {
@@ -104,6 +105,77 @@ TEST_F(RetryClientTest, ExpiredRetryPolicy) {
               HasSubstr("Retry policy exhausted before first attempt"));
 }
 
+/// @test Verify that each operation receives fresh per-call retry state.
+TEST_F(RetryClientTest, EachCallGetsFreshRetryState) {
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock),
+                     LimitedErrorCountRetryPolicy(2),
+                     // Make the tests faster.
+                     ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  // Use a read-only operation because these are always idempotent. Each call
+  // should perform the initial attempt plus two retries before giving up,
+  // the failures in the first call must not consume the second call's
+  // budget.
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(6)
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(request);
+  EXPECT_EQ(TransientError().code(), result.status().code());
+  result = client.GetObjectMetadata(request);
+  EXPECT_EQ(TransientError().code(), result.status().code());
+}
+
+/// @test Verify that an `OperationDeadline` bounds the whole retry loop.
+TEST_F(RetryClientTest, OperationDeadlineStopsRetries) {
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock),
+                     LimitedErrorCountRetryPolicy(1000),
+                     ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  // Use a read-only operation because these are always idempotent.
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object")
+          .set_multiple_options(
+              OperationDeadline(std::chrono::milliseconds(5))));
+  ASSERT_FALSE(result);
+  EXPECT_EQ(StatusCode::kDeadlineExceeded, result.status().code());
+  EXPECT_THAT(result.status().message(),
+              HasSubstr("Operation deadline expired"));
+}
+
+/// @test Verify that hedged calls return the first response to complete.
+TEST_F(RetryClientTest, HedgedGetObjectMetadata) {
+  // Hedging uses shared_from_this(), the client must be owned by a
+  // shared_ptr.
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(mock),
+      LimitedErrorCountRetryPolicy(3), StrictIdempotencyPolicy(),
+      ExponentialBackoffPolicy(1_us, 2_us, 2),
+      HedgingPolicy(std::chrono::milliseconds(5)));
+
+  auto const slow_delay = std::chrono::milliseconds(100);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](GetObjectMetadataRequest const&) {
+        std::this_thread::sleep_for(slow_delay);
+        return make_status_or(ObjectMetadata());
+      }))
+      .WillOnce(Return(make_status_or(ObjectMetadata())));
+
+  auto start = std::chrono::steady_clock::now();
+  auto result = client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_STATUS_OK(result);
+  // The backup attempt completes immediately, well before the slow attempt.
+  EXPECT_LT(elapsed, slow_delay);
+  // Let the losing attempt complete before the mock is verified.
+  std::this_thread::sleep_for(slow_delay + slow_delay);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -309,6 +309,46 @@ TEST(RetryObjectReadSourceTest, TransientFailureWithReadLastOption) {
   auto res = (*source)->Read(nullptr, 1024);
   ASSERT_TRUE(res);
 }
+
+/// @test A restarted download resumes from the last offset and pins the
+/// generation reported by the first response.
+TEST(RetryObjectReadSourceTest, ResumePinsGenerationAndOffset) {
+  auto raw_client = std::make_shared<testing::MockClient>();
+  auto raw_source1 = new MockObjectReadSource;
+  auto raw_source2 = new MockObjectReadSource;
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(raw_client),
+      LimitedErrorCountRetryPolicy(3), StrictIdempotencyPolicy(),
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*raw_client, ReadObject(_))
+      .WillOnce(Invoke([raw_source1](ReadObjectRangeRequest req) {
+        EXPECT_FALSE(req.HasOption<Generation>());
+        return std::unique_ptr<ObjectReadSource>(raw_source1);
+      }))
+      .WillOnce(Invoke([raw_source2](ReadObjectRangeRequest req) {
+        EXPECT_TRUE(req.HasOption<ReadFromOffset>());
+        EXPECT_EQ(1024, req.GetOption<ReadFromOffset>().value());
+        EXPECT_TRUE(req.HasOption<Generation>());
+        EXPECT_EQ(23456, req.GetOption<Generation>().value());
+        return std::unique_ptr<ObjectReadSource>(raw_source2);
+      }));
+
+  EXPECT_CALL(*raw_source1, Read(_, _))
+      .WillOnce(Return(ReadSourceResult{
+          static_cast<std::size_t>(1024),
+          HttpResponse{200, "", {{"x-goog-generation", "23456"}}}}))
+      .WillOnce(Return(TransientError()));
+
+  EXPECT_CALL(*raw_source2, Read(_, _)).WillOnce(Return(ReadSourceResult{}));
+
+  ReadObjectRangeRequest req("test_bucket", "test_object");
+  auto source = client->ReadObject(req);
+  ASSERT_STATUS_OK(source);
+  ASSERT_STATUS_OK((*source)->Read(nullptr, 1024));
+  auto res = (*source)->Read(nullptr, 1024);
+  ASSERT_TRUE(res);
+}
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -84,36 +84,36 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransient) {
   // 18. next_expected_byte() -> returns 3 * quantum
   //
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(7, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return make_status_or(ResumableUploadResponse{
             "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(11, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(14, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return make_status_or(ResumableUploadResponse{
             "", 2 * quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(18, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return make_status_or(ResumableUploadResponse{
             "", 3 * quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }));
@@ -188,15 +188,15 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransient) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response;
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(quantum - 1, response->last_committed_byte);
 
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(2 * quantum - 1, response->last_committed_byte);
 
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(3 * quantum - 1, response->last_committed_byte);
 }
@@ -217,12 +217,13 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnUpload) {
   // Ignore next_expected_byte() in tests - it will always return 0.
   // 1. UploadChunk() -> returns permanent error, the request aborts.
   //
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    EXPECT_EQ(payload, p);
-    return StatusOr<ResumableUploadResponse>(PermanentError());
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        EXPECT_EQ(payload, ToString(p));
+        return StatusOr<ResumableUploadResponse>(PermanentError());
+      }));
 
   EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
 
@@ -232,7 +233,8 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnUpload) {
                                       LimitedErrorCountRetryPolicy(10).clone(),
                                       TestBackoffPolicy());
 
-  StatusOr<ResumableUploadResponse> response = session.UploadChunk(payload);
+  StatusOr<ResumableUploadResponse> response =
+      session.UploadChunk({ConstBuffer(payload)});
   EXPECT_FALSE(response.ok());
 }
 
@@ -253,12 +255,13 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnReset) {
   // 1. UploadChunk() -> returns transient error
   // 2. ResetSession() -> returns permanent, the request aborts.
   //
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(1, count);
-    EXPECT_EQ(payload, p);
-    return StatusOr<ResumableUploadResponse>(TransientError());
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(1, count);
+        EXPECT_EQ(payload, ToString(p));
+        return StatusOr<ResumableUploadResponse>(TransientError());
+      }));
 
   EXPECT_CALL(*mock, ResetSession()).WillOnce(Invoke([&]() {
     ++count;
@@ -274,7 +277,8 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnReset) {
                                       LimitedErrorCountRetryPolicy(10).clone(),
                                       TestBackoffPolicy());
 
-  StatusOr<ResumableUploadResponse> response = session.UploadChunk(payload);
+  StatusOr<ResumableUploadResponse> response =
+      session.UploadChunk({ConstBuffer(payload)});
   EXPECT_FALSE(response.ok());
 }
 
@@ -299,22 +303,22 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnUploadChunk) {
   // 5. UploadChunk() -> returns transient error, the policy is exhausted.
   //
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(5, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }));
 
@@ -340,7 +344,8 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnUploadChunk) {
                                       LimitedErrorCountRetryPolicy(2).clone(),
                                       TestBackoffPolicy());
 
-  StatusOr<ResumableUploadResponse> response = session.UploadChunk(payload);
+  StatusOr<ResumableUploadResponse> response =
+      session.UploadChunk({ConstBuffer(payload)});
   EXPECT_FALSE(response.ok());
   EXPECT_EQ(response.status().code(), TransientError().code());
   EXPECT_THAT(response.status().message(), HasSubstr("Retry policy exhausted"));
@@ -366,12 +371,13 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnReset) {
   // 4. ResetSession() -> returns transient error
   // 5. ResetSession() -> returns transient error, the policy is exhausted
   //
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const& p) {
-    ++count;
-    EXPECT_EQ(3, count);
-    EXPECT_EQ(payload, p);
-    return StatusOr<ResumableUploadResponse>(TransientError());
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
+        ++count;
+        EXPECT_EQ(3, count);
+        EXPECT_EQ(payload, ToString(p));
+        return StatusOr<ResumableUploadResponse>(TransientError());
+      }));
 
   EXPECT_CALL(*mock, ResetSession())
       .WillOnce(Invoke([&]() {
@@ -402,7 +408,8 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnReset) {
                                       LimitedErrorCountRetryPolicy(2).clone(),
                                       TestBackoffPolicy());
 
-  StatusOr<ResumableUploadResponse> response = session.UploadChunk(payload);
+  StatusOr<ResumableUploadResponse> response =
+      session.UploadChunk({ConstBuffer(payload)});
   EXPECT_FALSE(response.ok());
 }
 
@@ -442,16 +449,16 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransiensOnSeparateChunks) {
   // 9. UploadChunk() -> returns success
   //
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         next_expected_byte = quantum;
         return make_status_or(
             ResumableUploadResponse{"",
@@ -460,16 +467,16 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransiensOnSeparateChunks) {
                                     ResumableUploadResponse::kInProgress,
                                     {}});
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(4, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(6, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         next_expected_byte = 2 * quantum;
         return make_status_or(
             ResumableUploadResponse{"",
@@ -478,16 +485,16 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransiensOnSeparateChunks) {
                                     ResumableUploadResponse::kInProgress,
                                     {}});
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(7, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(9, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         next_expected_byte = 3 * quantum;
         return make_status_or(
             ResumableUploadResponse{"",
@@ -531,15 +538,16 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransiensOnSeparateChunks) {
                                       LimitedErrorCountRetryPolicy(2).clone(),
                                       TestBackoffPolicy());
 
-  StatusOr<ResumableUploadResponse> response = session.UploadChunk(payload);
+  StatusOr<ResumableUploadResponse> response =
+      session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(response->last_committed_byte, quantum - 1);
 
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(response->last_committed_byte, 2 * quantum - 1);
 
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(response->last_committed_byte, 3 * quantum - 1);
 }
@@ -562,10 +570,10 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnUploadFinalChunk) {
   // 1. UploadChunk() -> returns permanent error, the request aborts.
   //
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t s) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(quantum, s);
         return StatusOr<ResumableUploadResponse>(PermanentError());
       }));
@@ -579,7 +587,7 @@ TEST_F(RetryResumableUploadSessionTest, PermanentErrorOnUploadFinalChunk) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response =
-      session.UploadFinalChunk(payload, quantum);
+      session.UploadFinalChunk({ConstBuffer(payload)}, quantum);
   EXPECT_FALSE(response.ok());
   EXPECT_EQ(PermanentError().code(), response.status().code());
 }
@@ -606,24 +614,24 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnUploadFinalChunk) {
   // 5. UploadFinalChunk() -> returns transient error, the policy is exhausted.
   //
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t s) {
         ++count;
         EXPECT_EQ(1, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(quantum, s);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t s) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(quantum, s);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t s) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t s) {
         ++count;
         EXPECT_EQ(5, count);
-        EXPECT_EQ(payload, p);
+        EXPECT_EQ(payload, ToString(p));
         EXPECT_EQ(quantum, s);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }));
@@ -651,7 +659,7 @@ TEST_F(RetryResumableUploadSessionTest, TooManyTransientOnUploadFinalChunk) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response =
-      session.UploadFinalChunk(payload, quantum);
+      session.UploadFinalChunk({ConstBuffer(payload)}, quantum);
   EXPECT_FALSE(response.ok());
 }
 
@@ -689,8 +697,8 @@ TEST(RetryResumableUploadSession, UploadChunkPolicyExhaustedOnStart) {
       std::move(mock), LimitedTimeRetryPolicy(std::chrono::seconds(0)).clone(),
       TestBackoffPolicy());
 
-  auto res = session.UploadChunk(
-      std::string(UploadChunkRequest::kChunkSizeQuantum, 'X'));
+  std::string const payload(UploadChunkRequest::kChunkSizeQuantum, 'X');
+  auto res = session.UploadChunk({ConstBuffer(payload)});
   ASSERT_FALSE(res);
   EXPECT_EQ(StatusCode::kDeadlineExceeded, res.status().code());
   EXPECT_THAT(res.status().message(),
@@ -705,7 +713,8 @@ TEST(RetryResumableUploadSession, UploadFinalChunkPolicyExhaustedOnStart) {
       std::move(mock), LimitedTimeRetryPolicy(std::chrono::seconds(0)).clone(),
       TestBackoffPolicy());
 
-  auto res = session.UploadFinalChunk("blah", 4);
+  std::string const payload("blah");
+  auto res = session.UploadFinalChunk({ConstBuffer(payload)}, 4);
   ASSERT_FALSE(res);
   EXPECT_EQ(StatusCode::kDeadlineExceeded, res.status().code());
   EXPECT_THAT(res.status().message(),
@@ -766,48 +775,48 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransientPartialFailures) {
   // 19. UploadFinalChunk() -> returns success (6 * quantum bytes committed)
   // 20. next_expected_byte() -> returns 6 * quantum
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(3 * quantum, p.size());
-        EXPECT_EQ('X', p[0]);
+        EXPECT_EQ(3 * quantum, TotalBytes(p));
+        EXPECT_EQ('X', ToString(p)[0]);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(6, count);
-        EXPECT_EQ(2 * quantum, p.size());
-        EXPECT_EQ('Y', p[0]);
+        EXPECT_EQ(2 * quantum, TotalBytes(p));
+        EXPECT_EQ('Y', ToString(p)[0]);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(9, count);
-        EXPECT_EQ(quantum, p.size());
-        EXPECT_EQ('Z', p[0]);
+        EXPECT_EQ(quantum, TotalBytes(p));
+        EXPECT_EQ('Z', ToString(p)[0]);
         return make_status_or(ResumableUploadResponse{
             "", 3 * quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t) {
         ++count;
         EXPECT_EQ(13, count);
-        EXPECT_EQ(3 * quantum, p.size());
-        EXPECT_EQ('A', p[0]);
+        EXPECT_EQ(3 * quantum, TotalBytes(p));
+        EXPECT_EQ('A', ToString(p)[0]);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t) {
         ++count;
         EXPECT_EQ(16, count);
-        EXPECT_EQ(2 * quantum, p.size());
-        EXPECT_EQ('B', p[0]);
+        EXPECT_EQ(2 * quantum, TotalBytes(p));
+        EXPECT_EQ('B', ToString(p)[0]);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p, std::size_t) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p, std::size_t) {
         ++count;
         EXPECT_EQ(19, count);
-        EXPECT_EQ(quantum, p.size());
-        EXPECT_EQ('C', p[0]);
+        EXPECT_EQ(quantum, TotalBytes(p));
+        EXPECT_EQ('C', ToString(p)[0]);
         return make_status_or(ResumableUploadResponse{
             "", 6 * quantum - 1, {}, ResumableUploadResponse::kDone, {}});
       }));
@@ -881,11 +890,12 @@ TEST_F(RetryResumableUploadSessionTest, HandleTransientPartialFailures) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response;
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(3 * quantum - 1, response->last_committed_byte);
 
-  response = session.UploadFinalChunk(payload_final, 6 * quantum);
+  response =
+      session.UploadFinalChunk({ConstBuffer(payload_final)}, 6 * quantum);
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(6 * quantum - 1, response->last_committed_byte);
 }
@@ -913,14 +923,15 @@ TEST_F(RetryResumableUploadSessionTest, UploadFinalChunkUncommitted) {
   // 7. UploadFinalChunk() -> returns transient error
   // 8. ResetSession() -> returns success (0 bytes committed)
   // 9. next_expected_byte() -> returns 0
-  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce(Invoke([&](std::string const&) {
-    ++count;
-    EXPECT_EQ(3, count);
-    return make_status_or(ResumableUploadResponse{
-        "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
-  }));
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](ConstBufferSequence const&) {
+        ++count;
+        EXPECT_EQ(3, count);
+        return make_status_or(ResumableUploadResponse{
+            "", quantum - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
   EXPECT_CALL(*mock, UploadFinalChunk(_, _))
-      .WillOnce(Invoke([&](std::string const&, std::size_t) {
+      .WillOnce(Invoke([&](ConstBufferSequence const&, std::size_t) {
         ++count;
         EXPECT_EQ(7, count);
         return StatusOr<ResumableUploadResponse>(TransientError());
@@ -970,11 +981,11 @@ TEST_F(RetryResumableUploadSessionTest, UploadFinalChunkUncommitted) {
                                       LimitedErrorCountRetryPolicy(10).clone(),
                                       TestBackoffPolicy());
 
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   EXPECT_STATUS_OK(response);
   EXPECT_EQ(quantum - 1, response->last_committed_byte);
 
-  response = session.UploadFinalChunk(payload, 2 * quantum);
+  response = session.UploadFinalChunk({ConstBuffer(payload)}, 2 * quantum);
   ASSERT_FALSE(response);
   EXPECT_EQ(StatusCode::kInternal, response.status().code());
   EXPECT_THAT(response.status().message(), HasSubstr("github"));
@@ -1003,28 +1014,28 @@ TEST_F(RetryResumableUploadSessionTest, ShortWriteRetryExhausted) {
   // 3. Retry policy is exhausted.
   //
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const&) {
+      .WillOnce(Invoke([&](ConstBufferSequence const&) {
         ++count;
         EXPECT_EQ(1, count);
         return make_status_or(ResumableUploadResponse{
             "", neb - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(2, count);
-        EXPECT_EQ(p.size(), payload.size() - neb);
+        EXPECT_EQ(TotalBytes(p), payload.size() - neb);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(3, count);
-        EXPECT_EQ(p.size(), payload.size() - neb);
+        EXPECT_EQ(TotalBytes(p), payload.size() - neb);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }))
-      .WillOnce(Invoke([&](std::string const& p) {
+      .WillOnce(Invoke([&](ConstBufferSequence const& p) {
         ++count;
         EXPECT_EQ(4, count);
-        EXPECT_EQ(p.size(), payload.size() - neb);
+        EXPECT_EQ(TotalBytes(p), payload.size() - neb);
         return StatusOr<ResumableUploadResponse>(TransientError());
       }));
 
@@ -1038,7 +1049,7 @@ TEST_F(RetryResumableUploadSessionTest, ShortWriteRetryExhausted) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response;
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   ASSERT_FALSE(response);
   EXPECT_EQ(StatusCode::kUnavailable, response.status().code());
 }
@@ -1065,14 +1076,14 @@ TEST_F(RetryResumableUploadSessionTest, ShortWriteRetrySucceeds) {
   // 2. UploadChunk() -> success (2* quantum committed)
   //
   EXPECT_CALL(*mock, UploadChunk(_))
-      .WillOnce(Invoke([&](std::string const&) {
+      .WillOnce(Invoke([&](ConstBufferSequence const&) {
         ++count;
         EXPECT_EQ(1, count);
         neb = quantum;
         return make_status_or(ResumableUploadResponse{
             "", neb - 1, {}, ResumableUploadResponse::kInProgress, {}});
       }))
-      .WillOnce(Invoke([&](std::string const&) {
+      .WillOnce(Invoke([&](ConstBufferSequence const&) {
         ++count;
         EXPECT_EQ(2, count);
         neb = 2 * quantum;
@@ -1090,7 +1101,7 @@ TEST_F(RetryResumableUploadSessionTest, ShortWriteRetrySucceeds) {
                                       TestBackoffPolicy());
 
   StatusOr<ResumableUploadResponse> response;
-  response = session.UploadChunk(payload);
+  response = session.UploadChunk({ConstBuffer(payload)});
   ASSERT_STATUS_OK(response);
   EXPECT_EQ(2 * quantum - 1, response->last_committed_byte);
 }
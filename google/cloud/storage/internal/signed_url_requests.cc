@@ -83,19 +83,17 @@ std::string V2SignUrlRequest::StringToSign() const {
     os << kv.first << ":" << kv.second << "\n";
   }
 
-  CurlHandle curl;
   os << '/' << bucket_name();
   if (!object_name().empty()) {
-    os << '/' << curl.MakeEscapedString(object_name()).get();
+    os << '/' << UrlEscape(object_name());
   }
   char const* sep = "?";
   if (!sub_resource().empty()) {
-    os << sep << curl.MakeEscapedString(sub_resource()).get();
+    os << sep << UrlEscape(sub_resource());
     sep = "&";
   }
   for (auto const& kv : common_request_.query_parameters()) {
-    os << sep << curl.MakeEscapedString(kv.first).get() << "="
-       << curl.MakeEscapedString(kv.second).get();
+    os << sep << UrlEscape(kv.first) << "=" << UrlEscape(kv.second);
     sep = "&";
   }
 
@@ -108,15 +106,14 @@ std::ostream& operator<<(std::ostream& os, V2SignUrlRequest const& r) {
 
 namespace {
 std::string QueryStringFromParameters(
-    CurlHandle& curl,
     std::multimap<std::string, std::string> const& parameters) {
   std::string result;
   char const* sep = "";
   for (auto const& qp : parameters) {
     result += sep;
-    result += curl.MakeEscapedString(qp.first).get();
+    AppendUrlEscaped(result, qp.first);
     result += '=';
-    result += curl.MakeEscapedString(qp.second).get();
+    AppendUrlEscaped(result, qp.second);
     sep = "&";
   }
   return result;
@@ -164,10 +161,9 @@ void V4SignUrlRequest::SetOption(Scheme const& o) {
 
 std::string V4SignUrlRequest::CanonicalQueryString(
     std::string const& client_id) const {
-  CurlHandle curl;
   // Query parameters.
   auto parameters = AllQueryParameters(client_id);
-  return QueryStringFromParameters(curl, parameters);
+  return QueryStringFromParameters(parameters);
 }
 
 std::string V4SignUrlRequest::CanonicalRequest(
@@ -175,21 +171,20 @@ std::string V4SignUrlRequest::CanonicalRequest(
   std::ostringstream os;
 
   os << verb() << "\n";
-  CurlHandle curl;
   if (!SkipBucketInPath()) {
     os << '/' << bucket_name();
   }
   for (auto& part : ObjectNameParts()) {
-    os << '/' << curl.MakeEscapedString(part).get();
+    os << '/' << UrlEscape(part);
   }
   if (!sub_resource().empty()) {
-    os << '?' << curl.MakeEscapedString(sub_resource()).get();
+    os << '?' << UrlEscape(sub_resource());
   }
   os << "\n";
 
   // Query parameters.
   auto parameters = AllQueryParameters(client_id);
-  os << QueryStringFromParameters(curl, parameters) << "\n";
+  os << QueryStringFromParameters(parameters) << "\n";
 
   // Headers
   for (auto&& kv : common_request_.extension_headers()) {
@@ -281,7 +276,6 @@ V4SignUrlRequest::CanonicalQueryParameters(std::string const& client_id) const {
 
 std::multimap<std::string, std::string> V4SignUrlRequest::AllQueryParameters(
     std::string const& client_id) const {
-  CurlHandle curl;
   // Query parameters.
   auto parameters = common_request_.query_parameters();
   auto canonical_parameters = CanonicalQueryParameters(client_id);
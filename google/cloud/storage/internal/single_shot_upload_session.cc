@@ -0,0 +1,154 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/single_shot_upload_session.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+template <typename Option>
+void CopyOption(ResumableUploadRequest const& src,
+                InsertObjectMediaRequest& dst) {
+  if (src.template HasOption<Option>()) {
+    dst.set_option(src.template GetOption<Option>());
+  }
+}
+
+/// Build the equivalent `Objects: insert` request for @p src.
+///
+/// The contents are borrowed, the memory viewed by @p contents must remain
+/// valid until the request completes.
+InsertObjectMediaRequest MakeInsertRequest(ResumableUploadRequest const& src,
+                                           ConstBufferSequence contents) {
+  InsertObjectMediaRequest dst(src.bucket_name(), src.object_name(),
+                               std::move(contents));
+  CopyOption<ContentEncoding>(src, dst);
+  CopyOption<ContentType>(src, dst);
+  CopyOption<Crc32cChecksumValue>(src, dst);
+  CopyOption<DisableCrc32cChecksum>(src, dst);
+  CopyOption<DisableMD5Hash>(src, dst);
+  CopyOption<EncryptionKey>(src, dst);
+  CopyOption<IfGenerationMatch>(src, dst);
+  CopyOption<IfGenerationNotMatch>(src, dst);
+  CopyOption<IfMetagenerationMatch>(src, dst);
+  CopyOption<IfMetagenerationNotMatch>(src, dst);
+  CopyOption<KmsKeyName>(src, dst);
+  CopyOption<MD5HashValue>(src, dst);
+  CopyOption<PredefinedAcl>(src, dst);
+  CopyOption<Projection>(src, dst);
+  CopyOption<UserProject>(src, dst);
+  CopyOption<WithObjectMetadata>(src, dst);
+  return dst;
+}
+}  // namespace
+
+StatusOr<ResumableUploadResponse> SingleShotUploadSession::UploadChunk(
+    ConstBufferSequence const& buffers) {
+  auto status = EnsureSession();
+  if (!status.ok()) {
+    last_response_ = StatusOr<ResumableUploadResponse>(std::move(status));
+    return last_response_;
+  }
+  return session_->UploadChunk(buffers);
+}
+
+StatusOr<ResumableUploadResponse> SingleShotUploadSession::UploadFinalChunk(
+    ConstBufferSequence const& buffers, std::uint64_t upload_size) {
+  if (session_ == nullptr && upload_size == TotalBytes(buffers) &&
+      upload_size <= threshold_) {
+    auto metadata = client_->InsertObjectMedia(
+        MakeInsertRequest(request_, buffers));
+    if (!metadata) {
+      last_response_ =
+          StatusOr<ResumableUploadResponse>(std::move(metadata).status());
+      return last_response_;
+    }
+    committed_size_ = upload_size;
+    done_ = true;
+    last_response_ = ResumableUploadResponse{
+        {},
+        upload_size == 0 ? 0 : upload_size - 1,
+        *std::move(metadata),
+        ResumableUploadResponse::kDone,
+        {}};
+    return last_response_;
+  }
+  auto status = EnsureSession();
+  if (!status.ok()) {
+    last_response_ = StatusOr<ResumableUploadResponse>(std::move(status));
+    return last_response_;
+  }
+  return session_->UploadFinalChunk(buffers, upload_size);
+}
+
+StatusOr<ResumableUploadResponse> SingleShotUploadSession::ResetSession() {
+  if (session_ == nullptr) {
+    return StatusOr<ResumableUploadResponse>(
+        Status(StatusCode::kFailedPrecondition,
+               "ResetSession() called before the upload session was created"));
+  }
+  return session_->ResetSession();
+}
+
+std::uint64_t SingleShotUploadSession::next_expected_byte() const {
+  if (session_ == nullptr) {
+    return committed_size_;
+  }
+  return session_->next_expected_byte();
+}
+
+std::string const& SingleShotUploadSession::session_id() const {
+  if (session_ == nullptr) {
+    return session_id_;
+  }
+  return session_->session_id();
+}
+
+bool SingleShotUploadSession::done() const {
+  if (session_ == nullptr) {
+    return done_;
+  }
+  return session_->done();
+}
+
+StatusOr<ResumableUploadResponse> const&
+SingleShotUploadSession::last_response() const {
+  if (session_ == nullptr) {
+    return last_response_;
+  }
+  return session_->last_response();
+}
+
+Status SingleShotUploadSession::EnsureSession() {
+  if (session_ != nullptr) {
+    return Status();
+  }
+  // The upload turned out to be larger than the single-shot threshold,
+  // fall back to a regular resumable upload session.
+  auto session = client_->CreateResumableSession(request_);
+  if (!session) {
+    return std::move(session).status();
+  }
+  session_ = *std::move(session);
+  return Status();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
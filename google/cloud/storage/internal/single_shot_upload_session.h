@@ -0,0 +1,81 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SINGLE_SHOT_UPLOAD_SESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SINGLE_SHOT_UPLOAD_SESSION_H
+
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * An upload session that sends small objects in a single request.
+ *
+ * Creating a resumable upload session costs one round trip before any data
+ * is sent, doubling the latency of small writes. This session defers that
+ * call: if the upload completes with a single `UploadFinalChunk()` whose
+ * size is at or below the configured threshold, the data is sent in one
+ * `InsertObjectMedia` request instead. In any other case (an intermediate
+ * chunk is uploaded, or the final chunk is too large) a regular resumable
+ * session is created on demand and all the calls are forwarded to it.
+ */
+class SingleShotUploadSession : public ResumableUploadSession {
+ public:
+  SingleShotUploadSession(std::shared_ptr<RawClient> client,
+                          ResumableUploadRequest request,
+                          std::size_t threshold)
+      : client_(std::move(client)),
+        request_(std::move(request)),
+        threshold_(threshold) {}
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      ConstBufferSequence const& buffers) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      ConstBufferSequence const& buffers, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> ResetSession() override;
+  std::uint64_t next_expected_byte() const override;
+  std::string const& session_id() const override;
+  bool done() const override;
+  StatusOr<ResumableUploadResponse> const& last_response() const override;
+
+ private:
+  /// Create the underlying resumable session, if not created already.
+  Status EnsureSession();
+
+  std::shared_ptr<RawClient> client_;
+  ResumableUploadRequest request_;
+  std::size_t threshold_;
+  std::unique_ptr<ResumableUploadSession> session_;
+  bool done_ = false;
+  std::uint64_t committed_size_ = 0;
+  std::string session_id_;
+  StatusOr<ResumableUploadResponse> last_response_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SINGLE_SHOT_UPLOAD_SESSION_H
@@ -0,0 +1,173 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/single_shot_upload_session.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+MATCHER_P(PayloadIs, expected, "payload bytes match") {
+  return ToString(arg) == expected;
+}
+
+ResumableUploadRequest MakeRequest() {
+  ResumableUploadRequest request("test-bucket", "test-object");
+  request.set_multiple_options(IfGenerationMatch(0), ContentType("text/plain"));
+  return request;
+}
+
+/// @test Small final chunks are sent in a single `InsertObjectMedia` request.
+TEST(SingleShotUploadSessionTest, SmallUploadUsesSingleRequest) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, CreateResumableSession(_)).Times(0);
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([](InsertObjectMediaRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        EXPECT_EQ("small contents", request.contents());
+        EXPECT_TRUE(request.HasOption<IfGenerationMatch>());
+        EXPECT_EQ(0, request.GetOption<IfGenerationMatch>().value());
+        EXPECT_TRUE(request.HasOption<ContentType>());
+        return make_status_or(internal::ObjectMetadataParser::FromJson(
+                                  internal::nl::json{{"name", "test-object"}})
+                                  .value());
+      }));
+
+  SingleShotUploadSession session(mock, MakeRequest(), 1024);
+  EXPECT_FALSE(session.done());
+  EXPECT_EQ(0U, session.next_expected_byte());
+
+  std::string const payload("small contents");
+  auto response = session.UploadFinalChunk({ConstBuffer(payload)}, 14);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(ResumableUploadResponse::kDone, response->upload_state);
+  EXPECT_EQ(13U, response->last_committed_byte);
+  ASSERT_TRUE(response->payload.has_value());
+  EXPECT_EQ("test-object", response->payload->name());
+
+  EXPECT_TRUE(session.done());
+  EXPECT_EQ(14U, session.next_expected_byte());
+  EXPECT_STATUS_OK(session.last_response());
+}
+
+/// @test Empty uploads also avoid the resumable session.
+TEST(SingleShotUploadSessionTest, EmptyUpload) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, CreateResumableSession(_)).Times(0);
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([](InsertObjectMediaRequest const& request) {
+        EXPECT_TRUE(request.contents().empty());
+        return make_status_or(ObjectMetadata{});
+      }));
+
+  SingleShotUploadSession session(mock, MakeRequest(), 1024);
+  auto response = session.UploadFinalChunk(ConstBufferSequence{}, 0);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(0U, response->last_committed_byte);
+  EXPECT_TRUE(session.done());
+}
+
+/// @test Final chunks over the threshold fall back to a resumable session.
+TEST(SingleShotUploadSessionTest, LargeFinalChunkFallsBack) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, InsertObjectMedia(_)).Times(0);
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([](ResumableUploadRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        auto session = google::cloud::internal::make_unique<
+            testing::MockResumableUploadSession>();
+        EXPECT_CALL(*session,
+                    UploadFinalChunk(PayloadIs("payload too large"), 17))
+            .WillOnce(Return(make_status_or(ResumableUploadResponse{
+                {}, 16, ObjectMetadata{}, ResumableUploadResponse::kDone,
+                {}})));
+        return make_status_or(
+            std::unique_ptr<ResumableUploadSession>(std::move(session)));
+      }));
+
+  SingleShotUploadSession session(mock, MakeRequest(), 4);
+  std::string const payload("payload too large");
+  auto response = session.UploadFinalChunk({ConstBuffer(payload)}, 17);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(16U, response->last_committed_byte);
+}
+
+/// @test Intermediate chunks create the resumable session and forward to it.
+TEST(SingleShotUploadSessionTest, UploadChunkCreatesSession) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, InsertObjectMedia(_)).Times(0);
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([](ResumableUploadRequest const&) {
+        auto session = google::cloud::internal::make_unique<
+            testing::MockResumableUploadSession>();
+        EXPECT_CALL(*session, UploadChunk(PayloadIs("chunk")))
+            .WillOnce(Return(make_status_or(ResumableUploadResponse{
+                {}, 4, {}, ResumableUploadResponse::kInProgress, {}})));
+        EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Return(5));
+        return make_status_or(
+            std::unique_ptr<ResumableUploadSession>(std::move(session)));
+      }));
+
+  SingleShotUploadSession session(mock, MakeRequest(), 1024);
+  std::string const payload("chunk");
+  auto response = session.UploadChunk({ConstBuffer(payload)});
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(5U, session.next_expected_byte());
+}
+
+/// @test Errors creating the fallback session are reported to the caller.
+TEST(SingleShotUploadSessionTest, CreateSessionError) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Return(StatusOr<std::unique_ptr<ResumableUploadSession>>(
+          PermanentError())));
+
+  SingleShotUploadSession session(mock, MakeRequest(), 1024);
+  std::string const payload("chunk");
+  auto response = session.UploadChunk({ConstBuffer(payload)});
+  EXPECT_FALSE(response);
+  EXPECT_EQ(PermanentError().code(), response.status().code());
+  EXPECT_EQ(PermanentError().code(), session.last_response().status().code());
+}
+
+/// @test `ResetSession()` is an error before any session exists.
+TEST(SingleShotUploadSessionTest, ResetBeforeSession) {
+  auto mock = std::make_shared<testing::MockClient>();
+
+  SingleShotUploadSession session(mock, MakeRequest(), 1024);
+  auto response = session.ResetSession();
+  EXPECT_FALSE(response);
+  EXPECT_EQ(StatusCode::kFailedPrecondition, response.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
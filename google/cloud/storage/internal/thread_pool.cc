@@ -0,0 +1,78 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/thread_pool.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::size_t constexpr ThreadPool::kQueueCapacity;
+
+ThreadPool::ThreadPool(std::size_t thread_count) : queue_(kQueueCapacity) {
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+  pool_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    pool_.emplace_back([this] { Worker(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  queue_.Shutdown();
+  for (auto& t : pool_) {
+    t.join();
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  // Blocks when the queue is full, tasks submitted before shutdown are
+  // never dropped.
+  queue_.Push(std::move(task));
+}
+
+void ThreadPool::Worker() {
+  // `Pop()` drains the queue after a shutdown, the destructor promises
+  // that previously submitted tasks complete.
+  for (auto task = queue_.Pop(); task.has_value(); task = queue_.Pop()) {
+    (*task)();
+  }
+}
+
+ThreadPool& AsyncOperationsPool() {
+  static auto* const kPool = new ThreadPool([] {
+    auto count = std::thread::hardware_concurrency();
+    return count == 0 ? std::size_t(4) : std::size_t(count);
+  }());
+  return *kPool;
+}
+
+void SubmitBackgroundTask(ClientOptions const& options,
+                          std::function<void()> task) {
+  auto const& executor = options.background_executor();
+  if (executor) {
+    executor(std::move(task));
+    return;
+  }
+  AsyncOperationsPool().Submit(std::move(task));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
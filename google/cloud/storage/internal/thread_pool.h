@@ -0,0 +1,85 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_THREAD_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_THREAD_POOL_H
+
+#include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/internal/bounded_mpmc_queue.h"
+#include "google/cloud/storage/version.h"
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A simple fixed-size thread pool to run asynchronous operations.
+ *
+ * The pool executes the submitted tasks in FIFO order. The destructor blocks
+ * until all previously submitted tasks have completed.
+ *
+ * The tasks are distributed through a lock-free bounded queue, `Submit()`
+ * applies backpressure (blocks) when the queue is full. Do not `Submit()`
+ * from a pool thread, with a full queue that can deadlock the pool.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t thread_count);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  /// Schedule @p task to run on one of the pool threads.
+  void Submit(std::function<void()> task);
+
+  std::size_t thread_count() const { return pool_.size(); }
+
+ private:
+  void Worker();
+
+  static std::size_t constexpr kQueueCapacity = 1024;
+
+  BoundedMpmcQueue<std::function<void()>> queue_;
+  std::vector<std::thread> pool_;
+};
+
+/**
+ * The process-wide pool used for background client operations.
+ *
+ * The pool is created on first use and never destroyed, tasks submitted to
+ * it must not depend on running before process exit.
+ */
+ThreadPool& AsyncOperationsPool();
+
+/**
+ * Run @p task in the background, honoring the configured executor.
+ *
+ * When @p options carries a `background_executor()` the task is handed
+ * to it, otherwise the task runs on `AsyncOperationsPool()`.
+ */
+void SubmitBackgroundTask(ClientOptions const& options,
+                          std::function<void()> task);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_THREAD_POOL_H
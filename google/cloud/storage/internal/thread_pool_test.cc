@@ -0,0 +1,82 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(ThreadPoolTest, RunsSubmittedTask) {
+  ThreadPool pool(2);
+  std::promise<int> done;
+  pool.Submit([&done] { done.set_value(42); });
+  EXPECT_EQ(42, done.get_future().get());
+}
+
+TEST(ThreadPoolTest, DrainsQueueOnShutdown) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i != 100; ++i) {
+      pool.Submit([&count] { ++count; });
+    }
+  }
+  EXPECT_EQ(100, count.load());
+}
+
+TEST(ThreadPoolTest, AtLeastOneThread) {
+  ThreadPool pool(0);
+  EXPECT_EQ(1, pool.thread_count());
+}
+
+
+TEST(ThreadPoolTest, SubmitBackgroundTaskUsesConfiguredExecutor) {
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  std::vector<std::function<void()>> submitted;
+  options.set_background_executor(
+      [&submitted](std::function<void()> task) {
+        submitted.push_back(std::move(task));
+      });
+  bool ran = false;
+  SubmitBackgroundTask(options, [&ran] { ran = true; });
+  // The task goes to the executor, it does not run until the executor
+  // decides to run it.
+  EXPECT_FALSE(ran);
+  ASSERT_EQ(1U, submitted.size());
+  submitted[0]();
+  EXPECT_TRUE(ran);
+}
+
+TEST(ThreadPoolTest, SubmitBackgroundTaskDefaultsToInternalPool) {
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  std::promise<void> done;
+  SubmitBackgroundTask(options, [&done] { done.set_value(); });
+  done.get_future().get();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
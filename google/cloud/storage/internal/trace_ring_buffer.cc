@@ -0,0 +1,89 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/trace_ring_buffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::size_t constexpr TraceEvent::kMaxOperationNameSize;
+std::size_t constexpr TraceRingBuffer::kThreadCapacity;
+
+TraceEvent MakeTraceEvent(char const* operation,
+                          std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point stop,
+                          StatusCode status, std::int64_t byte_count) {
+  TraceEvent event;
+  std::strncpy(event.operation, operation,
+               TraceEvent::kMaxOperationNameSize - 1);
+  event.operation[TraceEvent::kMaxOperationNameSize - 1] = '\0';
+  event.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       start.time_since_epoch())
+                       .count();
+  event.stop_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      stop.time_since_epoch())
+                      .count();
+  event.status = status;
+  event.byte_count = byte_count;
+  return event;
+}
+
+TraceRingBuffer& TraceRingBuffer::Instance() {
+  // The instance is never destroyed, threads may record events during the
+  // destruction of other static objects.
+  static auto* instance = new TraceRingBuffer;
+  return *instance;
+}
+
+void TraceRingBuffer::Record(TraceEvent const& event) {
+  auto& buffer = LocalBuffer();
+  auto head = buffer.head.load(std::memory_order_relaxed);
+  buffer.events[head % kThreadCapacity] = event;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> TraceRingBuffer::Dump() const {
+  std::vector<TraceEvent> result;
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& buffer : buffers_) {
+    auto head = buffer->head.load(std::memory_order_acquire);
+    auto count = (std::min<std::uint64_t>)(head, kThreadCapacity);
+    for (std::uint64_t i = head - count; i != head; ++i) {
+      result.push_back(buffer->events[i % kThreadCapacity]);
+    }
+  }
+  return result;
+}
+
+TraceRingBuffer::ThreadBuffer& TraceRingBuffer::LocalBuffer() {
+  thread_local ThreadBuffer* local = [this] {
+    auto buffer = std::unique_ptr<ThreadBuffer>(new ThreadBuffer);
+    auto* pointer = buffer.get();
+    std::unique_lock<std::mutex> lk(mu_);
+    buffers_.push_back(std::move(buffer));
+    return pointer;
+  }();
+  return *local;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
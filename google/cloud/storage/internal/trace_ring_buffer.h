@@ -0,0 +1,115 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_RING_BUFFER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_RING_BUFFER_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A fixed-size binary record describing one `RawClient` operation.
+ *
+ * Records are copied into the ring buffer by value, so they must be
+ * trivially copyable and must not own memory. The operation name is
+ * truncated to fit the record.
+ */
+struct TraceEvent {
+  static std::size_t constexpr kMaxOperationNameSize = 32;
+
+  /// The operation name, NUL-terminated and truncated if needed.
+  char operation[kMaxOperationNameSize];
+  /// Timestamps from `std::chrono::steady_clock`, in nanoseconds since the
+  /// (unspecified) epoch of that clock.
+  std::int64_t start_ns;
+  std::int64_t stop_ns;
+  StatusCode status;
+  /// The request payload size for uploads, zero when not applicable.
+  std::int64_t byte_count;
+};
+
+/// Creates a `TraceEvent`, truncating @p operation if needed.
+TraceEvent MakeTraceEvent(char const* operation,
+                          std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point stop,
+                          StatusCode status, std::int64_t byte_count);
+
+/**
+ * A process-wide, per-thread ring buffer of `TraceEvent` records.
+ *
+ * `LoggingClient` formats every request and response into iostreams, which
+ * is far too expensive to leave enabled in production. This buffer is the
+ * cheap alternative: `Record()` copies a fixed-size record into a buffer
+ * owned by the calling thread, without locks, atomic read-modify-write
+ * operations, or allocations (after the first call in each thread). Old
+ * records are overwritten when a buffer fills up.
+ *
+ * `Dump()` takes a snapshot of all thread buffers for offline analysis. It
+ * does not synchronize with concurrent `Record()` calls, so a dump taken
+ * while threads are active may contain a few records that are partially
+ * overwritten. This is an acceptable trade-off for a diagnostics tool, it
+ * keeps the hot path free of synchronization.
+ */
+class TraceRingBuffer {
+ public:
+  /// The number of records kept per thread.
+  static std::size_t constexpr kThreadCapacity = 1024;
+
+  /// The process-wide instance.
+  static TraceRingBuffer& Instance();
+
+  /// Copies @p event into the calling thread's buffer.
+  void Record(TraceEvent const& event);
+
+  /// Returns a snapshot of all recorded events, oldest first within each
+  /// thread.
+  std::vector<TraceEvent> Dump() const;
+
+ private:
+  TraceRingBuffer() = default;
+
+  struct ThreadBuffer {
+    std::array<TraceEvent, kThreadCapacity> events;
+    // Only the owning thread writes `head`, `Dump()` only reads it.
+    std::atomic<std::uint64_t> head{0};
+  };
+
+  ThreadBuffer& LocalBuffer();
+
+  // Protects the registry of thread buffers, not the buffers themselves.
+  // Buffers are kept alive until the process exits, even if their thread
+  // is gone, so `Dump()` can report events from completed threads.
+  mutable std::mutex mu_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_RING_BUFFER_H
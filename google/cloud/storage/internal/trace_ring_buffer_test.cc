@@ -0,0 +1,79 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/trace_ring_buffer.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// The ring buffer is process-wide and shared with other tests, count only
+// the events with a given operation name.
+std::size_t CountEvents(std::string const& operation) {
+  auto events = TraceRingBuffer::Instance().Dump();
+  return std::count_if(events.begin(), events.end(),
+                       [&operation](TraceEvent const& e) {
+                         return operation == e.operation;
+                       });
+}
+
+TEST(TraceRingBufferTest, RecordAndDump) {
+  auto start = std::chrono::steady_clock::now();
+  auto stop = start + std::chrono::microseconds(5);
+  TraceRingBuffer::Instance().Record(MakeTraceEvent(
+      "RecordAndDump-Op", start, stop, StatusCode::kNotFound, 1234));
+
+  auto events = TraceRingBuffer::Instance().Dump();
+  auto i = std::find_if(events.begin(), events.end(), [](TraceEvent const& e) {
+    return std::string("RecordAndDump-Op") == e.operation;
+  });
+  ASSERT_NE(i, events.end());
+  EXPECT_EQ(StatusCode::kNotFound, i->status);
+  EXPECT_EQ(1234, i->byte_count);
+  EXPECT_EQ(5000, i->stop_ns - i->start_ns);
+}
+
+TEST(TraceRingBufferTest, TruncatesLongOperationNames) {
+  std::string const long_name(2 * TraceEvent::kMaxOperationNameSize, 'a');
+  auto now = std::chrono::steady_clock::now();
+  auto event =
+      MakeTraceEvent(long_name.c_str(), now, now, StatusCode::kOk, 0);
+  EXPECT_EQ(std::string(TraceEvent::kMaxOperationNameSize - 1, 'a'),
+            std::string(event.operation));
+}
+
+TEST(TraceRingBufferTest, OverwritesOldestRecords) {
+  auto now = std::chrono::steady_clock::now();
+  auto const extra = 10;
+  for (std::size_t i = 0; i != TraceRingBuffer::kThreadCapacity + extra; ++i) {
+    TraceRingBuffer::Instance().Record(
+        MakeTraceEvent("Overwrites-Op", now, now, StatusCode::kOk, 0));
+  }
+  EXPECT_LE(CountEvents("Overwrites-Op"), TraceRingBuffer::kThreadCapacity);
+  EXPECT_GE(CountEvents("Overwrites-Op"),
+            TraceRingBuffer::kThreadCapacity - extra);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,417 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/tracing_client.h"
+#include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+namespace {
+
+using ::google::cloud::storage::internal::raw_client_wrapper_utils::Signature;
+
+/**
+ * Calls a `RawClient` operation recording the configured instrumentation.
+ *
+ * @tparam MemberFunction the signature of the member function.
+ * @param record_event whether this call records a `TraceEvent`.
+ * @param record_metrics whether this call updates `OperationMetrics`.
+ * @param client the storage::RawClient object to make the call through.
+ * @param function the pointer to the member function to call.
+ * @param request an initialized request parameter for the call.
+ * @param context the operation name stored in the trace record.
+ * @param byte_count the request payload size, zero when not applicable.
+ * @return the result from making the call;
+ */
+template <typename MemberFunction>
+static typename Signature<MemberFunction>::ReturnType MakeCall(
+    bool record_event, bool record_metrics, RawClient& client,
+    MemberFunction function,
+    typename Signature<MemberFunction>::RequestType const& request,
+    char const* context, std::int64_t byte_count = 0) {
+  if (!record_event && !record_metrics) {
+    return (client.*function)(request);
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto response = (client.*function)(request);
+  auto stop = std::chrono::steady_clock::now();
+  auto code = response ? StatusCode::kOk : response.status().code();
+  if (record_event) {
+    TraceRingBuffer::Instance().Record(
+        MakeTraceEvent(context, start, stop, code, byte_count));
+  }
+  if (record_metrics) {
+    OperationMetrics::Instance().Record(context, stop - start, code,
+                                        byte_count);
+  }
+  return response;
+}
+}  // namespace
+
+TracingClient::TracingClient(std::shared_ptr<RawClient> client,
+                             int sample_period, bool record_trace_events,
+                             bool record_metrics)
+    : client_(std::move(client)),
+      sample_period_(sample_period < 1 ? 1 : sample_period),
+      record_trace_events_(record_trace_events),
+      record_metrics_(record_metrics) {}
+
+bool TracingClient::Sampled() const {
+  if (!record_trace_events_) {
+    return false;
+  }
+  if (sample_period_ == 1) {
+    return true;
+  }
+  thread_local int counter = 0;
+  return ++counter % sample_period_ == 1;
+}
+
+ClientOptions const& TracingClient::client_options() const {
+  return client_->client_options();
+}
+
+PoolStatistics TracingClient::pool_statistics() const {
+  return client_->pool_statistics();
+}
+
+StatusOr<ListBucketsResponse> TracingClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::ListBuckets,
+                  request, __func__);
+}
+
+StatusOr<BucketMetadata> TracingClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> TracingClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetBucketMetadata, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> TracingClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> TracingClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::PatchBucket,
+                  request, __func__);
+}
+
+StatusOr<IamPolicy> TracingClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetBucketIamPolicy, request, __func__);
+}
+
+StatusOr<NativeIamPolicy> TracingClient::GetNativeBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetNativeBucketIamPolicy, request, __func__);
+}
+
+StatusOr<IamPolicy> TracingClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::SetBucketIamPolicy, request, __func__);
+}
+
+StatusOr<NativeIamPolicy> TracingClient::SetNativeBucketIamPolicy(
+    SetNativeBucketIamPolicyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::SetNativeBucketIamPolicy, request, __func__);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+TracingClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::TestBucketIamPermissions, request, __func__);
+}
+
+StatusOr<BucketMetadata> TracingClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::LockBucketRetentionPolicy, request, __func__);
+}
+
+StatusOr<ObjectMetadata> TracingClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::InsertObjectMedia, request, __func__,
+                  static_cast<std::int64_t>(request.contents_size()));
+}
+
+StatusOr<ObjectMetadata> TracingClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::CopyObject,
+                  request, __func__);
+}
+
+StatusOr<ObjectMetadata> TracingClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetObjectMetadata, request, __func__);
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> TracingClient::ReadObject(
+    ReadObjectRangeRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::ReadObject,
+                  request, __func__);
+}
+
+StatusOr<ListObjectsResponse> TracingClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::ListObjects,
+                  request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> TracingClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> TracingClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::PatchObject,
+                  request, __func__);
+}
+
+StatusOr<ObjectMetadata> TracingClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ComposeObject, request, __func__);
+}
+
+StatusOr<RewriteObjectResponse> TracingClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::RewriteObject, request, __func__);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+TracingClient::CreateResumableSession(ResumableUploadRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateResumableSession, request, __func__);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+TracingClient::RestoreResumableSession(std::string const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::RestoreResumableSession, request, __func__);
+}
+
+StatusOr<ListBucketAclResponse> TracingClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ListBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> TracingClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> TracingClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateBucketAcl, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> TracingClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> TracingClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::PatchBucketAcl, request, __func__);
+}
+
+StatusOr<ListObjectAclResponse> TracingClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ListObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateObjectAcl, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::PatchObjectAcl, request, __func__);
+}
+
+StatusOr<ListDefaultObjectAclResponse> TracingClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ListDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> TracingClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::PatchDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ServiceAccount> TracingClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetServiceAccount, request, __func__);
+}
+
+StatusOr<ListHmacKeysResponse> TracingClient::ListHmacKeys(
+    ListHmacKeysRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ListHmacKeys, request, __func__);
+}
+
+StatusOr<CreateHmacKeyResponse> TracingClient::CreateHmacKey(
+    CreateHmacKeyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateHmacKey, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteHmacKey(
+    DeleteHmacKeyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteHmacKey, request, __func__);
+}
+
+StatusOr<HmacKeyMetadata> TracingClient::GetHmacKey(
+    GetHmacKeyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::GetHmacKey,
+                  request, __func__);
+}
+
+StatusOr<HmacKeyMetadata> TracingClient::UpdateHmacKey(
+    UpdateHmacKeyRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::UpdateHmacKey, request, __func__);
+}
+
+StatusOr<SignBlobResponse> TracingClient::SignBlob(
+    SignBlobRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_, &RawClient::SignBlob,
+                  request, __func__);
+}
+
+StatusOr<ListNotificationsResponse> TracingClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::ListNotifications, request, __func__);
+}
+
+StatusOr<NotificationMetadata> TracingClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::CreateNotification, request, __func__);
+}
+
+StatusOr<NotificationMetadata> TracingClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::GetNotification, request, __func__);
+}
+
+StatusOr<EmptyResponse> TracingClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return MakeCall(Sampled(), record_metrics_, *client_,
+                  &RawClient::DeleteNotification, request, __func__);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,119 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/tracing_client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::TransientError;
+using ::testing::_;
+using ::testing::Return;
+
+// The trace ring buffer is process-wide and shared with other tests, count
+// only the events for a given operation.
+std::size_t CountEvents(std::string const& operation) {
+  auto events = TraceRingBuffer::Instance().Dump();
+  return std::count_if(events.begin(), events.end(),
+                       [&operation](TraceEvent const& e) {
+                         return operation == e.operation;
+                       });
+}
+
+TEST(TracingClientTest, GetBucketMetadata) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(BucketMetadata())));
+
+  auto before = CountEvents("GetBucketMetadata");
+  TracingClient client(mock);
+  client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  EXPECT_EQ(before + 1, CountEvents("GetBucketMetadata"));
+
+  auto events = TraceRingBuffer::Instance().Dump();
+  auto i = std::find_if(
+      events.rbegin(), events.rend(), [](TraceEvent const& e) {
+        return std::string("GetBucketMetadata") == e.operation;
+      });
+  ASSERT_NE(i, events.rend());
+  EXPECT_EQ(StatusCode::kOk, i->status);
+  EXPECT_LE(i->start_ns, i->stop_ns);
+}
+
+TEST(TracingClientTest, GetBucketMetadataWithError) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(StatusOr<BucketMetadata>(TransientError())));
+
+  TracingClient client(mock);
+  client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+
+  auto events = TraceRingBuffer::Instance().Dump();
+  auto i = std::find_if(
+      events.rbegin(), events.rend(), [](TraceEvent const& e) {
+        return std::string("GetBucketMetadata") == e.operation;
+      });
+  ASSERT_NE(i, events.rend());
+  EXPECT_EQ(TransientError().code(), i->status);
+}
+
+TEST(TracingClientTest, InsertObjectMediaRecordsByteCount) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(make_status_or(ObjectMetadata())));
+
+  TracingClient client(mock);
+  client.InsertObjectMedia(
+      InsertObjectMediaRequest("bkt", "obj", "0123456789"));
+
+  auto events = TraceRingBuffer::Instance().Dump();
+  auto i = std::find_if(
+      events.rbegin(), events.rend(), [](TraceEvent const& e) {
+        return std::string("InsertObjectMedia") == e.operation;
+      });
+  ASSERT_NE(i, events.rend());
+  EXPECT_EQ(10, i->byte_count);
+}
+
+TEST(TracingClientTest, SamplingRecordsSubsetOfCalls) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillRepeatedly(Return(make_status_or(EmptyResponse{})));
+
+  auto before = CountEvents("DeleteObject");
+  TracingClient client(mock, 4);
+  for (int i = 0; i != 8; ++i) {
+    client.DeleteObject(DeleteObjectRequest("bkt", "obj"));
+  }
+  // With a sample period of 4 only 1 out of every 4 calls is recorded. The
+  // sampling counter is thread-wide, so other calls in this thread may shift
+  // which calls are selected, but never how many.
+  EXPECT_EQ(before + 2, CountEvents("DeleteObject"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,99 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/upload_checkpoint.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// The leading '\0' guarantees the magic cannot collide with a session id,
+// those are URLs. The trailing '1' is the format version.
+char const kMagic[] = "\0gcs-upload-ckpt-1";
+std::size_t const kMagicSize = sizeof(kMagic) - 1;
+
+void AppendLittleEndian(std::string& blob, std::uint64_t value, int bytes) {
+  for (int i = 0; i != bytes; ++i) {
+    blob.push_back(static_cast<char>(value & 0xFFU));
+    value >>= 8;
+  }
+}
+
+std::uint64_t ReadLittleEndian(std::string const& blob, std::size_t pos,
+                               int bytes) {
+  std::uint64_t value = 0;
+  for (int i = bytes - 1; i >= 0; --i) {
+    value = (value << 8) |
+            static_cast<unsigned char>(blob[pos + static_cast<std::size_t>(i)]);
+  }
+  return value;
+}
+}  // namespace
+
+std::string SerializeUploadCheckpoint(UploadSessionCheckpoint const& chk) {
+  std::string blob(kMagic, kMagicSize);
+  AppendLittleEndian(blob, chk.next_expected_byte, 8);
+  AppendLittleEndian(blob, chk.session_id.size(), 4);
+  blob.append(chk.session_id);
+  AppendLittleEndian(blob, chk.hash_state.size(), 4);
+  blob.append(chk.hash_state);
+  return blob;
+}
+
+StatusOr<UploadSessionCheckpoint> ParseUploadCheckpoint(
+    std::string const& blob) {
+  auto invalid = [](char const* what) {
+    return Status(StatusCode::kInvalidArgument,
+                  std::string("invalid upload checkpoint: ") + what);
+  };
+  if (!IsUploadCheckpoint(blob)) {
+    return invalid("missing magic");
+  }
+  UploadSessionCheckpoint chk;
+  std::size_t pos = kMagicSize;
+  if (blob.size() < pos + 8 + 4) {
+    return invalid("truncated header");
+  }
+  chk.next_expected_byte = ReadLittleEndian(blob, pos, 8);
+  pos += 8;
+  auto session_id_size =
+      static_cast<std::size_t>(ReadLittleEndian(blob, pos, 4));
+  pos += 4;
+  if (blob.size() < pos + session_id_size + 4) {
+    return invalid("truncated session id");
+  }
+  chk.session_id = blob.substr(pos, session_id_size);
+  pos += session_id_size;
+  auto hash_state_size =
+      static_cast<std::size_t>(ReadLittleEndian(blob, pos, 4));
+  pos += 4;
+  if (blob.size() != pos + hash_state_size) {
+    return invalid("truncated hash state");
+  }
+  chk.hash_state = blob.substr(pos, hash_state_size);
+  return chk;
+}
+
+bool IsUploadCheckpoint(std::string const& value) {
+  return value.size() >= kMagicSize &&
+         value.compare(0, kMagicSize, kMagic, kMagicSize) == 0;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,71 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHECKPOINT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHECKPOINT_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * The state needed to resume an upload without querying the service.
+ *
+ * Restoring a session from just its id requires one round trip to discover
+ * the committed byte count. A checkpoint captures that count (and the
+ * running hash state) when it is known, so a crashed or suspended upload can
+ * resume without the extra request.
+ *
+ * Checkpoints use a compact binary format, they are only intended to be
+ * read back by the same library version on the same architecture, typically
+ * from a local file written by a crash-resume path.
+ */
+struct UploadSessionCheckpoint {
+  /// The resumable upload session id.
+  std::string session_id;
+  /// The next byte expected by the service when the checkpoint was taken.
+  std::uint64_t next_expected_byte;
+  /// The serialized `HashValidator` state, see `HashValidator::State()`.
+  std::string hash_state;
+};
+
+/// Serialize @p checkpoint into its binary representation.
+std::string SerializeUploadCheckpoint(UploadSessionCheckpoint const& chk);
+
+/// Parse a binary checkpoint, previously created by
+/// `SerializeUploadCheckpoint()`.
+StatusOr<UploadSessionCheckpoint> ParseUploadCheckpoint(
+    std::string const& blob);
+
+/**
+ * Returns true if @p value looks like a serialized checkpoint.
+ *
+ * Used to distinguish checkpoints from plain session ids, the binary magic
+ * cannot appear in a session URL.
+ */
+bool IsUploadCheckpoint(std::string const& value);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHECKPOINT_H
@@ -0,0 +1,72 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/upload_checkpoint.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// @test Verify that checkpoints survive a serialize/parse round trip.
+TEST(UploadCheckpointTest, RoundTrip) {
+  UploadSessionCheckpoint chk;
+  chk.session_id = "https://test.googleapis.com/upload/session-id-1234";
+  chk.next_expected_byte = 5 * 256 * 1024UL;
+  chk.hash_state = std::string("\x01\x02\x00\x03binary state", 16);
+
+  auto blob = SerializeUploadCheckpoint(chk);
+  EXPECT_TRUE(IsUploadCheckpoint(blob));
+
+  auto parsed = ParseUploadCheckpoint(blob);
+  ASSERT_STATUS_OK(parsed);
+  EXPECT_EQ(chk.session_id, parsed->session_id);
+  EXPECT_EQ(chk.next_expected_byte, parsed->next_expected_byte);
+  EXPECT_EQ(chk.hash_state, parsed->hash_state);
+}
+
+/// @test Verify that session ids are not mistaken for checkpoints.
+TEST(UploadCheckpointTest, SessionIdIsNotCheckpoint) {
+  EXPECT_FALSE(IsUploadCheckpoint(
+      "https://test.googleapis.com/upload/session-id-1234"));
+  EXPECT_FALSE(IsUploadCheckpoint(""));
+}
+
+/// @test Verify that corrupt checkpoints are rejected.
+TEST(UploadCheckpointTest, Corrupt) {
+  UploadSessionCheckpoint chk;
+  chk.session_id = "session-id";
+  chk.next_expected_byte = 1024;
+  chk.hash_state = "state";
+  auto blob = SerializeUploadCheckpoint(chk);
+
+  auto truncated = ParseUploadCheckpoint(blob.substr(0, blob.size() - 1));
+  EXPECT_FALSE(truncated);
+  EXPECT_EQ(StatusCode::kInvalidArgument, truncated.status().code());
+
+  auto missing_magic = ParseUploadCheckpoint("not-a-checkpoint");
+  EXPECT_FALSE(missing_magic);
+  EXPECT_EQ(StatusCode::kInvalidArgument, missing_magic.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -204,6 +204,46 @@ TEST(ListBucketsReaderTest, IteratorCompare) {
   // same elements are different.
   EXPECT_NE(a1, a2);
 }
+
+TEST(ListBucketsReaderTest, Prefetch) {
+  std::vector<BucketMetadata> expected;
+
+  int page_count = 3;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto create_mock = [&expected, page_count](int i) {
+    ListBucketsResponse response;
+    if (i != page_count - 1) {
+      response.next_page_token = "page-" + std::to_string(i);
+    }
+    response.items.push_back(expected[2 * i]);
+    response.items.push_back(expected[2 * i + 1]);
+    std::string expected_token = i == 0 ? "" : "page-" + std::to_string(i - 1);
+    return [response, expected_token](ListBucketsRequest const& r) {
+      EXPECT_EQ(expected_token, r.page_token());
+      return make_status_or(response);
+    };
+  };
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListBuckets(_))
+      .WillOnce(Invoke(create_mock(0)))
+      .WillOnce(Invoke(create_mock(1)))
+      .WillOnce(Invoke(create_mock(2)));
+
+  ListBucketsReader reader(
+      ListBucketsRequest("foo-bar-baz").set_multiple_options(Prefix("dir/")),
+      [mock](ListBucketsRequest const& r) { return mock->ListBuckets(r); });
+  reader.EnablePagePrefetch();
+  std::vector<BucketMetadata> actual;
+  for (auto&& bucket : reader) {
+    ASSERT_STATUS_OK(bucket);
+    actual.push_back(*bucket);
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -204,6 +204,46 @@ TEST(ListHmacKeysReaderTest, IteratorCompare) {
   // same elements are different.
   EXPECT_NE(a1, a2);
 }
+
+TEST(ListHmacKeysReaderTest, Prefetch) {
+  std::vector<HmacKeyMetadata> expected;
+
+  int page_count = 3;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto create_mock = [&expected, page_count](int i) {
+    ListHmacKeysResponse response;
+    if (i != page_count - 1) {
+      response.next_page_token = "page-" + std::to_string(i);
+    }
+    response.items.push_back(expected[2 * i]);
+    response.items.push_back(expected[2 * i + 1]);
+    std::string expected_token = i == 0 ? "" : "page-" + std::to_string(i - 1);
+    return [response, expected_token](ListHmacKeysRequest const& r) {
+      EXPECT_EQ(expected_token, r.page_token());
+      return make_status_or(response);
+    };
+  };
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListHmacKeys(_))
+      .WillOnce(Invoke(create_mock(0)))
+      .WillOnce(Invoke(create_mock(1)))
+      .WillOnce(Invoke(create_mock(2)));
+
+  ListHmacKeysReader reader(
+      ListHmacKeysRequest("test-project-id"),
+      [mock](ListHmacKeysRequest const& r) { return mock->ListHmacKeys(r); });
+  reader.EnablePagePrefetch();
+  std::vector<HmacKeyMetadata> actual;
+  for (auto&& key : reader) {
+    ASSERT_STATUS_OK(key);
+    actual.push_back(*key);
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
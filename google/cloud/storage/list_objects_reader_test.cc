@@ -91,6 +91,80 @@ TEST(ListObjectsReaderTest, Basic) {
   EXPECT_THAT(actual, ContainerEq(expected));
 }
 
+TEST(ListObjectsReaderTest, PrefetchPages) {
+  // Create a synthetic list of ObjectMetadata elements, each request will
+  // return 2 of them.
+  std::vector<ObjectMetadata> expected;
+
+  int page_count = 3;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto create_mock = [page_count](int i) {
+    ListObjectsResponse response;
+    if (i != page_count - 1) {
+      response.next_page_token = "page-" + std::to_string(i);
+    }
+    response.items.emplace_back(CreateElement(2 * i));
+    response.items.emplace_back(CreateElement(2 * i + 1));
+    std::string expected_token = i == 0 ? "" : "page-" + std::to_string(i - 1);
+    return [response, expected_token](ListObjectsRequest const& r) {
+      EXPECT_EQ(expected_token, r.page_token());
+      return StatusOr<ListObjectsResponse>(response);
+    };
+  };
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Invoke(create_mock(0)))
+      .WillOnce(Invoke(create_mock(1)))
+      .WillOnce(Invoke(create_mock(2)));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("foo-bar-baz").set_multiple_options(Prefix("dir/")),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); });
+  reader.EnablePagePrefetch();
+  std::vector<ObjectMetadata> actual;
+  for (auto&& object : reader) {
+    ASSERT_STATUS_OK(object);
+    actual.emplace_back(std::move(object).value());
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
+TEST(ListObjectsReaderTest, PrefetchFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.next_page_token = "page-0";
+        response.items.emplace_back(CreateElement(0));
+        return StatusOr<ListObjectsResponse>(response);
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("test-bucket"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); });
+  reader.EnablePagePrefetch();
+  std::vector<ObjectMetadata> actual;
+  bool has_status_or_error = false;
+  for (auto&& object : reader) {
+    if (object.ok()) {
+      actual.emplace_back(*std::move(object));
+      continue;
+    }
+    EXPECT_FALSE(has_status_or_error);
+    has_status_or_error = true;
+    EXPECT_EQ(PermanentError().code(), std::move(object).status().code());
+  }
+  EXPECT_TRUE(has_status_or_error);
+  EXPECT_EQ(1U, actual.size());
+}
+
 TEST(ListObjectsReaderTest, Empty) {
   auto mock = std::make_shared<MockClient>();
   EXPECT_CALL(*mock, ListObjects(_))
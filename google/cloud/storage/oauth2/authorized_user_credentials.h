@@ -23,7 +23,6 @@
 #include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
 #include "google/cloud/storage/version.h"
 #include <iostream>
-#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -95,11 +94,21 @@ class AuthorizedUserCredentials : public Credentials {
   }
 
   StatusOr<std::string> AuthorizationHeader() override {
-    std::unique_lock<std::mutex> lock(mu_);
     return refreshing_creds_.AuthorizationHeader(clock_.now(),
                                                  [this] { return Refresh(); });
   }
 
+  /**
+   * Renew the access token in a background thread before it expires.
+   *
+   * In steady state `AuthorizationHeader()` then never blocks on a token
+   * refresh. See `RefreshingCredentialsWrapper::EnableProactiveRefresh()`
+   * for details.
+   */
+  void EnableProactiveRefresh() {
+    refreshing_creds_.EnableProactiveRefresh([this] { return Refresh(); });
+  }
+
  private:
   StatusOr<RefreshingCredentialsWrapper::TemporaryToken> Refresh() {
     auto response = request_.MakeRequest(payload_);
@@ -115,7 +124,8 @@ class AuthorizedUserCredentials : public Credentials {
   ClockType clock_;
   typename HttpRequestBuilderType::RequestType request_;
   std::string payload_;
-  mutable std::mutex mu_;
+  // Declared last so its destructor joins the proactive refresh thread
+  // before the members used by `Refresh()` are destroyed.
   RefreshingCredentialsWrapper refreshing_creds_;
 };
 
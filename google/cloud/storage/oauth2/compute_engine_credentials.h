@@ -84,15 +84,25 @@ class ComputeEngineCredentials : public Credentials {
       : clock_(), service_account_email_(service_account_email) {}
 
   StatusOr<std::string> AuthorizationHeader() override {
-    std::unique_lock<std::mutex> lock(mu_);
     return refreshing_creds_.AuthorizationHeader(clock_.now(),
                                                  [this] { return Refresh(); });
   }
 
+  /**
+   * Renew the access token in a background thread before it expires.
+   *
+   * In steady state `AuthorizationHeader()` then never blocks on the
+   * metadata server. See
+   * `RefreshingCredentialsWrapper::EnableProactiveRefresh()` for details.
+   */
+  void EnableProactiveRefresh() {
+    refreshing_creds_.EnableProactiveRefresh([this] { return Refresh(); });
+  }
+
   std::string AccountEmail() const override {
-    std::unique_lock<std::mutex> lock(mu_);
     // Force a refresh on the account info.
     RetrieveServiceAccountInfo();
+    std::unique_lock<std::mutex> lock(mu_);
     return service_account_email_;
   }
 
@@ -145,6 +155,13 @@ class ComputeEngineCredentials : public Credentials {
     return request_builder.BuildRequest().MakeRequest(std::string{});
   }
 
+  /// Returns the current service account email (or alias) under a lock. The
+  /// metadata server requests must run without the lock held.
+  std::string CurrentAccountEmail() const {
+    std::unique_lock<std::mutex> lock(mu_);
+    return service_account_email_;
+  }
+
   /**
    * Fetches metadata for an instance's service account.
    *
@@ -155,7 +172,7 @@ class ComputeEngineCredentials : public Credentials {
   Status RetrieveServiceAccountInfo() const {
     auto response = DoMetadataServerGetRequest(
         "/computeMetadata/v1/instance/service-accounts/" +
-            service_account_email_ + "/",
+            CurrentAccountEmail() + "/",
         true);
     if (!response) {
       return std::move(response).status();
@@ -168,6 +185,7 @@ class ComputeEngineCredentials : public Credentials {
     if (!metadata) {
       return metadata.status();
     }
+    std::unique_lock<std::mutex> lock(mu_);
     service_account_email_ = std::move(metadata->email);
     scopes_ = std::move(metadata->scopes);
     return Status();
@@ -181,7 +199,7 @@ class ComputeEngineCredentials : public Credentials {
 
     auto response = DoMetadataServerGetRequest(
         "/computeMetadata/v1/instance/service-accounts/" +
-            service_account_email_ + "/token",
+            CurrentAccountEmail() + "/token",
         false);
     if (!response) {
       return std::move(response).status();
@@ -195,9 +213,11 @@ class ComputeEngineCredentials : public Credentials {
 
   ClockType clock_;
   mutable std::mutex mu_;
-  RefreshingCredentialsWrapper refreshing_creds_;
   mutable std::set<std::string> scopes_;
   mutable std::string service_account_email_;
+  // Declared last so its destructor joins the proactive refresh thread
+  // before the members used by `Refresh()` are destroyed.
+  RefreshingCredentialsWrapper refreshing_creds_;
 };
 
 }  // namespace oauth2
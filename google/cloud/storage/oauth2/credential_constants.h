@@ -62,6 +62,12 @@ inline char const* GoogleOAuthScopeCloudPlatform() {
       "https://www.googleapis.com/auth/cloud-platform";
   return kScope;
 }
+
+/// The audience claim for self-signed JWTs used against Cloud Storage.
+inline char const* GoogleOAuthSelfSignedJwtAudience() {
+  static constexpr char kAudience[] = "https://storage.googleapis.com/";
+  return kAudience;
+}
 }  // namespace oauth2
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -23,8 +23,11 @@
 #include "google/cloud/storage/oauth2/google_application_default_credentials_file.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
 #include <fstream>
+#include <functional>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -36,6 +39,63 @@ char constexpr kAdcLink[] =  // NOLINT(modernize-avoid-c-arrays)
     "https://developers.google.com/identity/protocols/"
     "application-default-credentials";
 
+namespace {
+
+// A process-wide cache of `Credentials` objects, so all the clients created
+// for the same account share one access token and one refresh schedule.
+class CredentialsRegistry {
+ public:
+  static CredentialsRegistry& Instance() {
+    static CredentialsRegistry instance;
+    return instance;
+  }
+
+  StatusOr<std::shared_ptr<Credentials>> GetOrCreate(
+      std::string const& key,
+      std::function<StatusOr<std::shared_ptr<Credentials>>()> const& factory) {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      return it->second;
+    }
+    // Run the factory without the lock, it performs file (and sometimes
+    // network) I/O. Errors are not cached, the next call retries.
+    lk.unlock();
+    auto credentials = factory();
+    if (!credentials) {
+      return credentials;
+    }
+    lk.lock();
+    // Another thread may have created the same credentials while the factory
+    // was running, keep the first copy so all the clients share one object.
+    auto p = cache_.emplace(key, *std::move(credentials));
+    return p.first->second;
+  }
+
+ private:
+  CredentialsRegistry() = default;
+
+  std::mutex mu_;
+  std::map<std::string, std::shared_ptr<Credentials>> cache_;
+};
+
+// Computes the cache key for the Application Default Credentials. The account
+// is identified by the credentials file that would be loaded (or by the GCE
+// metadata server when no file is configured), the channel options affect the
+// transport used to refresh the tokens.
+std::string AdcCacheKey(ChannelOptions const& options) {
+  auto path = GoogleAdcFilePathFromEnvVarOrEmpty();
+  if (path.empty()) {
+    path = GoogleAdcFilePathFromWellKnownPathOrEmpty();
+  }
+  if (path.empty()) {
+    path = "compute-engine-vm";
+  }
+  return "adc/" + path + "/ssl-root/" + options.ssl_root_path();
+}
+
+}  // namespace
+
 // Parses the JSON or P12 file at `path` and creates the appropriate
 // Credentials type.
 //
@@ -182,6 +242,13 @@ StatusOr<std::shared_ptr<Credentials>> GoogleDefaultCredentials(
                  std::string(kAdcLink)));
 }
 
+StatusOr<std::shared_ptr<Credentials>> GoogleSharedDefaultCredentials(
+    ChannelOptions const& options) {
+  return CredentialsRegistry::Instance().GetOrCreate(
+      AdcCacheKey(options),
+      [&options] { return GoogleDefaultCredentials(options); });
+}
+
 std::shared_ptr<Credentials> CreateAnonymousCredentials() {
   return std::make_shared<AnonymousCredentials>();
 }
@@ -43,6 +43,24 @@ namespace oauth2 {
 StatusOr<std::shared_ptr<Credentials>> GoogleDefaultCredentials(
     ChannelOptions const& options = {});
 
+/**
+ * Produces the Application Default %Credentials, shared process-wide.
+ *
+ * Each call to `GoogleDefaultCredentials()` re-reads the credentials file
+ * and creates a new `Credentials` object, each with its own access token and
+ * refresh schedule. Applications that create many `Client` objects should
+ * prefer this function: the credentials for each account are created once,
+ * cached for the lifetime of the process, and shared by all callers, so the
+ * clients share one token and one token refresh schedule.
+ *
+ * Failures to load the credentials are not cached, the next call retries.
+ *
+ * @see https://cloud.google.com/docs/authentication/production for details
+ * about Application Default %Credentials.
+ */
+StatusOr<std::shared_ptr<Credentials>> GoogleSharedDefaultCredentials(
+    ChannelOptions const& options = {});
+
 //@{
 /**
  * @name Functions to manually create specific credential types.
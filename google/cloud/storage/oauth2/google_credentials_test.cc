@@ -176,6 +176,24 @@ TEST_F(GoogleCredentialsTest, LoadValidAuthorizedUserCredentialsViaEnvVar) {
   EXPECT_EQ(typeid(*ptr), typeid(AuthorizedUserCredentials<>));
 }
 
+/**
+ * @test Verify `GoogleSharedDefaultCredentials()` returns one shared object.
+ *
+ * The credentials for a given account are created once and cached, so all
+ * the clients in the process share one token and one refresh schedule.
+ */
+TEST_F(GoogleCredentialsTest, SharedDefaultCredentials) {
+  std::string filename = ::testing::TempDir() + AUTHORIZED_USER_CRED_FILENAME;
+  SetupAuthorizedUserCredentialsFileForTest(filename);
+  ScopedEnvironment adc_env_var(GoogleAdcEnvVar(), filename.c_str());
+
+  auto c1 = GoogleSharedDefaultCredentials();
+  ASSERT_STATUS_OK(c1);
+  auto c2 = GoogleSharedDefaultCredentials();
+  ASSERT_STATUS_OK(c2);
+  EXPECT_EQ(c1->get(), c2->get());
+}
+
 TEST_F(GoogleCredentialsTest, LoadValidAuthorizedUserCredentialsViaGcloudFile) {
   std::string filename = ::testing::TempDir() + AUTHORIZED_USER_CRED_FILENAME;
   SetupAuthorizedUserCredentialsFileForTest(filename);
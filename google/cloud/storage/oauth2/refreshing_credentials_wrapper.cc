@@ -14,12 +14,88 @@
 
 #include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
 #include "google/cloud/storage/oauth2/credential_constants.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace oauth2 {
+namespace {
+/// How long to wait before retrying a failed proactive refresh.
+std::chrono::seconds constexpr kProactiveRefreshRetryDelay(60);
+}  // namespace
+
+RefreshingCredentialsWrapper::~RefreshingCredentialsWrapper() {
+  StopProactiveRefresh();
+}
+
+void RefreshingCredentialsWrapper::EnableProactiveRefresh(
+    std::function<StatusOr<TemporaryToken>()> refresh_fn,
+    std::chrono::seconds margin) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (refresher_.joinable()) {
+    return;
+  }
+  refresh_fn_ = std::move(refresh_fn);
+  // A margin not exceeding the expiration slack renews the token after
+  // `IsValid()` already returns false, defeating the purpose.
+  margin_ = (std::max)(margin, GoogleOAuthAccessTokenExpirationSlack() +
+                                   kProactiveRefreshRetryDelay);
+  shutdown_ = false;
+  // The new thread blocks on `mu_` until this function returns.
+  refresher_ = std::thread([this] { ProactiveRefreshLoop(); });
+}
+
+void RefreshingCredentialsWrapper::StopProactiveRefresh() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  if (refresher_.joinable()) {
+    refresher_.join();
+  }
+}
+
+void RefreshingCredentialsWrapper::ProactiveRefreshLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!shutdown_) {
+    if (temporary_token.token.empty()) {
+      // There is no token to renew, the first `AuthorizationHeader()` call
+      // fetches it. Wake up when that happens.
+      cv_.wait(lk);
+      continue;
+    }
+    auto deadline = temporary_token.expiration_time - margin_;
+    auto now = std::chrono::system_clock::now();
+    if (now < deadline) {
+      cv_.wait_until(lk, deadline);
+      continue;
+    }
+    if (refresh_in_progress_) {
+      cv_.wait(lk);
+      continue;
+    }
+    refresh_in_progress_ = true;
+    auto refresh_fn = refresh_fn_;
+    lk.unlock();
+    StatusOr<TemporaryToken> new_token = refresh_fn();
+    lk.lock();
+    refresh_in_progress_ = false;
+    cv_.notify_all();
+    if (new_token) {
+      temporary_token = *std::move(new_token);
+      continue;
+    }
+    // The refresh failed, and there may be nobody to report the error to;
+    // retry after a delay. If the token expires in the meantime the next
+    // `AuthorizationHeader()` call performs a synchronous refresh and
+    // reports any errors to the caller.
+    cv_.wait_until(
+        lk, std::chrono::system_clock::now() + kProactiveRefreshRetryDelay);
+  }
+}
 
 bool RefreshingCredentialsWrapper::IsExpired(
     std::chrono::system_clock::time_point now) const {
@@ -32,6 +108,12 @@ bool RefreshingCredentialsWrapper::IsValid(
   return !temporary_token.token.empty() && !IsExpired(now);
 }
 
+bool RefreshingCredentialsWrapper::IsUsable(
+    std::chrono::system_clock::time_point now) const {
+  return !temporary_token.token.empty() &&
+         now < temporary_token.expiration_time;
+}
+
 }  // namespace oauth2
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -19,7 +19,11 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/version.h"
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
 namespace google {
@@ -29,6 +33,18 @@ inline namespace STORAGE_CLIENT_NS {
 namespace oauth2 {
 /**
  * Wrapper for refreshable parts of a Credentials object.
+ *
+ * The wrapper owns the synchronization for the cached token. The refresh
+ * functor runs without any lock held, so threads that find a valid cached
+ * token make progress while another thread performs a refresh. At most one
+ * refresh is in flight at a time, additional threads that need the new token
+ * wait for the in-flight refresh instead of issuing their own.
+ *
+ * The wrapper implements stale-while-revalidate semantics: a token inside
+ * its expiration slack (but before its actual expiration time) is still
+ * served while a refresh is in flight, and is still served if a refresh
+ * fails. Requests only block on (or fail with) the token endpoint when the
+ * cached token is truly expired.
  */
 class RefreshingCredentialsWrapper {
  public:
@@ -37,22 +53,81 @@ class RefreshingCredentialsWrapper {
     std::chrono::system_clock::time_point expiration_time;
   };
 
+  RefreshingCredentialsWrapper() = default;
+
+  /// Stops the proactive refresh thread, if one was started.
+  ~RefreshingCredentialsWrapper();
+
+  RefreshingCredentialsWrapper(RefreshingCredentialsWrapper const&) = delete;
+  RefreshingCredentialsWrapper& operator=(RefreshingCredentialsWrapper const&) =
+      delete;
+
   template <typename RefreshFunctor>
   StatusOr<std::string> AuthorizationHeader(
       std::chrono::system_clock::time_point now,
       RefreshFunctor refresh_fn) const {
-    if (IsValid(now)) {
-      return temporary_token.token;
+    std::unique_lock<std::mutex> lk(mu_);
+    while (true) {
+      if (IsValid(now)) {
+        return temporary_token.token;
+      }
+      if (!refresh_in_progress_) {
+        break;
+      }
+      // Another thread (or the proactive refresh thread) is fetching a new
+      // token. A token inside the expiration slack is stale but still
+      // usable, serve it instead of blocking on the in-flight refresh.
+      if (IsUsable(now)) {
+        return temporary_token.token;
+      }
+      cv_.wait(lk);
     }
-
+    refresh_in_progress_ = true;
+    lk.unlock();
     StatusOr<TemporaryToken> new_token = refresh_fn();
+    lk.lock();
+    refresh_in_progress_ = false;
+    cv_.notify_all();
     if (new_token) {
       temporary_token = *std::move(new_token);
       return temporary_token.token;
     }
+    // The refresh failed, but the cached token has not actually expired
+    // yet, keep serving it. Only a truly expired token propagates the
+    // error to the caller.
+    if (IsUsable(now)) {
+      return temporary_token.token;
+    }
     return new_token.status();
   }
 
+  /**
+   * Start a background thread that renews the token before it expires.
+   *
+   * Once a token is cached, the thread invokes @p refresh_fn when the token
+   * is within @p margin of its expiration time. In steady state
+   * `AuthorizationHeader()` then always finds a valid token and never blocks
+   * on the token endpoint. Failed proactive refresh attempts are retried
+   * after a short delay; if the token expires in the meantime the next
+   * `AuthorizationHeader()` call refreshes it synchronously, as usual.
+   *
+   * @param refresh_fn the functor used to fetch a new token. It must remain
+   *     valid until `StopProactiveRefresh()` (or the destructor) returns,
+   *     and it must not require external synchronization. The wrapper never
+   *     runs it concurrently with a synchronous refresh.
+   * @param margin how long before the expiration time the token is renewed.
+   *     Values not exceeding the expiration slack used by `IsExpired()`
+   *     would renew the token only after it is already considered invalid,
+   *     so the margin is raised above that slack if needed.
+   */
+  void EnableProactiveRefresh(
+      std::function<StatusOr<TemporaryToken>()> refresh_fn,
+      std::chrono::seconds margin = std::chrono::seconds(1000));
+
+  /// Stop and join the proactive refresh thread. This is a no-op if the
+  /// proactive refresh was never enabled.
+  void StopProactiveRefresh();
+
   /**
    * Returns whether the current access token should be considered expired.
    *
@@ -75,7 +150,27 @@ class RefreshingCredentialsWrapper {
   bool IsValid(std::chrono::system_clock::time_point now) const;
 
  private:
-  mutable TemporaryToken temporary_token;
+  /**
+   * Returns whether the current access token can still be served.
+   *
+   * A token inside the expiration slack is not `IsValid()`, a refresh
+   * should be underway, but it has not actually expired so it can still be
+   * used while that refresh completes (or after it fails).
+   */
+  bool IsUsable(std::chrono::system_clock::time_point now) const;
+
+  /// The body of the proactive refresh thread.
+  void ProactiveRefreshLoop();
+
+  mutable std::mutex mu_;
+  mutable std::condition_variable cv_;
+  mutable TemporaryToken temporary_token;     // GUARDED_BY(mu_)
+  mutable bool refresh_in_progress_ = false;  // GUARDED_BY(mu_)
+
+  std::function<StatusOr<TemporaryToken>()> refresh_fn_;  // GUARDED_BY(mu_)
+  std::chrono::seconds margin_{0};                        // GUARDED_BY(mu_)
+  bool shutdown_ = false;                                 // GUARDED_BY(mu_)
+  std::thread refresher_;
 };
 
 }  // namespace oauth2
@@ -0,0 +1,194 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+namespace {
+
+using Token = RefreshingCredentialsWrapper::TemporaryToken;
+
+/// @test Verify tokens are fetched once and then served from the cache.
+TEST(RefreshingCredentialsWrapperTest, SynchronousRefresh) {
+  RefreshingCredentialsWrapper wrapper;
+  int count = 0;
+  auto now = std::chrono::system_clock::now();
+  auto refresh = [&count, now]() -> StatusOr<Token> {
+    ++count;
+    return Token{"Authorization: Bearer test-token",
+                 now + std::chrono::hours(1)};
+  };
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer test-token", *header);
+  EXPECT_EQ(1, count);
+
+  header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ(1, count);
+}
+
+/// @test Verify refresh errors are returned to the caller.
+TEST(RefreshingCredentialsWrapperTest, RefreshError) {
+  RefreshingCredentialsWrapper wrapper;
+  auto now = std::chrono::system_clock::now();
+  auto refresh = []() -> StatusOr<Token> {
+    return Status(StatusCode::kUnavailable, "cannot reach token endpoint");
+  };
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  EXPECT_FALSE(header.ok());
+  EXPECT_EQ(StatusCode::kUnavailable, header.status().code());
+}
+
+/// @test Verify a stale (but not expired) token survives a failed refresh.
+TEST(RefreshingCredentialsWrapperTest, StaleTokenServedOnRefreshError) {
+  RefreshingCredentialsWrapper wrapper;
+  auto now = std::chrono::system_clock::now();
+  auto refresh = [now]() -> StatusOr<Token> {
+    return Token{"Authorization: Bearer stale-token",
+                 now + std::chrono::seconds(100)};
+  };
+  // The token expires in 100 seconds, inside the expiration slack, so the
+  // next call attempts a refresh.
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+
+  auto failing = []() -> StatusOr<Token> {
+    return Status(StatusCode::kUnavailable, "cannot reach metadata server");
+  };
+  header = wrapper.AuthorizationHeader(now, failing);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer stale-token", *header);
+
+  // Once the token actually expires the error is propagated.
+  header =
+      wrapper.AuthorizationHeader(now + std::chrono::seconds(101), failing);
+  EXPECT_FALSE(header.ok());
+  EXPECT_EQ(StatusCode::kUnavailable, header.status().code());
+}
+
+/// @test Verify a stale token is served while a refresh is in flight.
+TEST(RefreshingCredentialsWrapperTest, StaleTokenServedDuringRefresh) {
+  RefreshingCredentialsWrapper wrapper;
+  std::mutex mu;
+  std::condition_variable cv;
+  bool refresh_started = false;
+  bool release_refresh = false;
+
+  auto now = std::chrono::system_clock::now();
+  auto header = wrapper.AuthorizationHeader(now, [now]() -> StatusOr<Token> {
+    return Token{"Authorization: Bearer stale-token",
+                 now + std::chrono::seconds(100)};
+  });
+  ASSERT_STATUS_OK(header);
+
+  // Start a refresh that blocks until this test releases it.
+  std::thread refresher([&] {
+    auto blocked = [&]() -> StatusOr<Token> {
+      std::unique_lock<std::mutex> lk(mu);
+      refresh_started = true;
+      cv.notify_all();
+      cv.wait(lk, [&] { return release_refresh; });
+      return Token{"Authorization: Bearer renewed-token",
+                   std::chrono::system_clock::now() + std::chrono::hours(1)};
+    };
+    auto h = wrapper.AuthorizationHeader(now, blocked);
+    ASSERT_STATUS_OK(h);
+  });
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return refresh_started; });
+  }
+
+  // While the refresh is in flight the stale token is served immediately.
+  auto never_called = []() -> StatusOr<Token> {
+    return Status(StatusCode::kUnknown, "unexpected synchronous refresh");
+  };
+  header = wrapper.AuthorizationHeader(now, never_called);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer stale-token", *header);
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    release_refresh = true;
+    cv.notify_all();
+  }
+  refresher.join();
+  header = wrapper.AuthorizationHeader(now, never_called);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer renewed-token", *header);
+}
+
+/// @test Verify the background thread renews a token nearing expiration.
+TEST(RefreshingCredentialsWrapperTest, ProactiveRefresh) {
+  RefreshingCredentialsWrapper wrapper;
+  std::mutex mu;
+  std::condition_variable cv;
+  int count = 0;
+  wrapper.EnableProactiveRefresh([&mu, &cv, &count]() -> StatusOr<Token> {
+    std::unique_lock<std::mutex> lk(mu);
+    ++count;
+    cv.notify_all();
+    return Token{"Authorization: Bearer renewed-token",
+                 std::chrono::system_clock::now() + std::chrono::hours(1)};
+  });
+
+  // Install a token that is valid, but close enough to its expiration that
+  // the background thread renews it immediately.
+  auto now = std::chrono::system_clock::now();
+  auto header = wrapper.AuthorizationHeader(now, [now]() -> StatusOr<Token> {
+    return Token{"Authorization: Bearer short-lived-token",
+                 now + std::chrono::seconds(600)};
+  });
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer short-lived-token", *header);
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(30),
+                            [&count] { return count >= 1; }));
+  }
+
+  // The renewed token becomes visible shortly after the refresh functor
+  // returns; no synchronous refresh is needed to observe it.
+  auto never_called = []() -> StatusOr<Token> {
+    return Status(StatusCode::kUnknown, "unexpected synchronous refresh");
+  };
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (std::chrono::steady_clock::now() < deadline) {
+    header = wrapper.AuthorizationHeader(std::chrono::system_clock::now(),
+                                         never_called);
+    ASSERT_STATUS_OK(header);
+    if (*header == "Authorization: Bearer renewed-token") break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ("Authorization: Bearer renewed-token", *header);
+  wrapper.StopProactiveRefresh();
+}
+
+}  // namespace
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
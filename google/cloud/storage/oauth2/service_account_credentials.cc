@@ -248,6 +248,48 @@ std::string CreateServiceAccountRefreshPayload(
   return payload;
 }
 
+StatusOr<RefreshingCredentialsWrapper::TemporaryToken> MakeSelfSignedJWT(
+    ServiceAccountCredentialsInfo const& info,
+    std::chrono::system_clock::time_point now) {
+  if (info.subject) {
+    return Status(StatusCode::kInvalidArgument,
+                  "Self-signed JWTs do not support domain-wide delegation,"
+                  " use the OAuth token endpoint instead");
+  }
+  storage::internal::nl::json header = {
+      {"alg", "RS256"}, {"kid", info.private_key_id}, {"typ", "JWT"}};
+
+  auto expiration = now + GoogleOAuthAccessTokenLifetime();
+  // As in `AssertionComponentsFromInfo()`, do the time arithmetic with the
+  // std::chrono types and convert to integers only for the claims.
+  auto const now_from_epoch =
+      static_cast<std::intmax_t>(std::chrono::system_clock::to_time_t(now));
+  auto const expiration_from_epoch = static_cast<std::intmax_t>(
+      std::chrono::system_clock::to_time_t(expiration));
+  storage::internal::nl::json payload = {{"iss", info.client_email},
+                                         {"sub", info.client_email},
+                                         {"iat", now_from_epoch},
+                                         {"exp", expiration_from_epoch}};
+  if (info.scopes) {
+    // Self-signed JWTs carry a space-delimited `scope` claim in place of the
+    // audience.
+    std::string scope_str;
+    char const* sep = "";
+    for (auto const& scope : *(info.scopes)) {
+      scope_str += sep + scope;
+      sep = " ";
+    }
+    payload["scope"] = scope_str;
+  } else {
+    payload["aud"] = GoogleOAuthSelfSignedJwtAudience();
+  }
+
+  auto token =
+      MakeJWTAssertion(header.dump(), payload.dump(), info.private_key);
+  return RefreshingCredentialsWrapper::TemporaryToken{
+      "Authorization: Bearer " + token, expiration};
+}
+
 StatusOr<RefreshingCredentialsWrapper::TemporaryToken>
 ParseServiceAccountRefreshResponse(
     storage::internal::HttpResponse const& response,
@@ -438,6 +438,115 @@ TEST_F(ServiceAccountCredentialsTest, RefreshingUpdatesTimestamps) {
             *authorization_header);
 }
 
+/// @test Verify that MakeSelfSignedJWT() creates a valid bearer token.
+TEST_F(ServiceAccountCredentialsTest, MakeSelfSignedJWT) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+
+  auto const now = std::chrono::system_clock::from_time_t(kFixedJwtTimestamp);
+  auto token = MakeSelfSignedJWT(*info, now);
+  ASSERT_STATUS_OK(token);
+  EXPECT_EQ(now + GoogleOAuthAccessTokenLifetime(), token->expiration_time);
+
+  std::string const prefix = "Authorization: Bearer ";
+  ASSERT_THAT(token->token, StartsWith(prefix));
+  std::istringstream is(token->token.substr(prefix.size()));
+  std::string encoded_header;
+  std::getline(is, encoded_header, '.');
+  std::string encoded_payload;
+  std::getline(is, encoded_payload, '.');
+
+  auto header_bytes = internal::UrlsafeBase64Decode(encoded_header);
+  auto header = internal::nl::json::parse(
+      std::string{header_bytes.begin(), header_bytes.end()});
+  EXPECT_EQ("RS256", header.value("alg", ""));
+  EXPECT_EQ("JWT", header.value("typ", ""));
+  EXPECT_EQ(info->private_key_id, header.value("kid", ""));
+
+  auto payload_bytes = internal::UrlsafeBase64Decode(encoded_payload);
+  auto payload = internal::nl::json::parse(
+      std::string{payload_bytes.begin(), payload_bytes.end()});
+  EXPECT_EQ(info->client_email, payload.value("iss", ""));
+  EXPECT_EQ(info->client_email, payload.value("sub", ""));
+  EXPECT_EQ(GoogleOAuthSelfSignedJwtAudience(), payload.value("aud", ""));
+  EXPECT_EQ(kFixedJwtTimestamp, payload.value("iat", 0));
+  EXPECT_EQ(kFixedJwtTimestamp + 3600, payload.value("exp", 0));
+}
+
+/// @test Verify that self-signed JWTs use a `scope` claim when scopes are set.
+TEST_F(ServiceAccountCredentialsTest, MakeSelfSignedJWTWithScopes) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+  info->scopes = {kAltScopeForTest};
+
+  auto const now = std::chrono::system_clock::from_time_t(kFixedJwtTimestamp);
+  auto token = MakeSelfSignedJWT(*info, now);
+  ASSERT_STATUS_OK(token);
+
+  std::string const prefix = "Authorization: Bearer ";
+  ASSERT_THAT(token->token, StartsWith(prefix));
+  std::istringstream is(token->token.substr(prefix.size()));
+  std::string encoded_header;
+  std::getline(is, encoded_header, '.');
+  std::string encoded_payload;
+  std::getline(is, encoded_payload, '.');
+
+  auto payload_bytes = internal::UrlsafeBase64Decode(encoded_payload);
+  auto payload = internal::nl::json::parse(
+      std::string{payload_bytes.begin(), payload_bytes.end()});
+  EXPECT_EQ(kAltScopeForTest, payload.value("scope", ""));
+  EXPECT_EQ(0U, payload.count("aud"));
+}
+
+/// @test Verify that self-signed JWTs reject domain-wide delegation.
+TEST_F(ServiceAccountCredentialsTest, MakeSelfSignedJWTWithSubject) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+  info->subject = std::string(kSubjectForGrant);
+
+  auto token = MakeSelfSignedJWT(*info, std::chrono::system_clock::now());
+  EXPECT_FALSE(token.ok());
+  EXPECT_EQ(StatusCode::kInvalidArgument, token.status().code());
+}
+
+/// @test Verify that UseSelfSignedJwt() never contacts the token endpoint.
+TEST_F(ServiceAccountCredentialsTest, SelfSignedJwtSkipsTokenEndpoint) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+
+  auto mock_request = std::make_shared<MockHttpRequest::Impl>();
+  EXPECT_CALL(*mock_request, MakeRequest(_)).Times(0);
+
+  auto mock_builder = MockHttpRequestBuilder::mock;
+  EXPECT_CALL(*mock_builder, BuildRequest()).WillOnce(Invoke([mock_request] {
+    MockHttpRequest result;
+    result.mock = mock_request;
+    return result;
+  }));
+  std::string expected_header =
+      "Content-Type: application/x-www-form-urlencoded";
+  EXPECT_CALL(*mock_builder, AddHeader(StrEq(expected_header)));
+  EXPECT_CALL(*mock_builder, Constructor(GoogleOAuthRefreshEndpoint()))
+      .Times(1);
+  EXPECT_CALL(*mock_builder, MakeEscapedString(An<std::string const&>()))
+      .WillRepeatedly(
+          Invoke([](std::string const& s) -> std::unique_ptr<char[]> {
+            EXPECT_EQ(kGrantParamUnescaped, s);
+            auto t =
+                std::unique_ptr<char[]>(new char[sizeof(kGrantParamEscaped)]);
+            std::copy(kGrantParamEscaped,
+                      kGrantParamEscaped + sizeof(kGrantParamEscaped), t.get());
+            return t;
+          }));
+
+  ServiceAccountCredentials<MockHttpRequestBuilder, FakeClock> credentials(
+      *info);
+  credentials.UseSelfSignedJwt();
+  auto header = credentials.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  EXPECT_THAT(*header, StartsWith("Authorization: Bearer "));
+}
+
 /// @test Verify that we can create sign blobs using a service account.
 TEST_F(ServiceAccountCredentialsTest, SignBlob) {
   auto mock_builder = MockHttpRequestBuilder::mock;
@@ -0,0 +1,89 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_content_cache.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+StatusOr<std::shared_ptr<std::string const>> ObjectContentCache::Get(
+    std::string const& bucket_name, std::string const& object_name) {
+  std::int64_t generation = 0;
+  std::shared_ptr<std::string const> cached;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto loc = cache_.find(std::make_pair(bucket_name, object_name));
+    if (loc != cache_.end()) {
+      generation = loc->second.generation;
+      cached = loc->second.contents;
+    }
+  }
+  if (!cached) {
+    auto stream = client_.ReadObject(bucket_name, object_name);
+    return Store(bucket_name, object_name, stream);
+  }
+  auto stream = client_.ReadObject(bucket_name, object_name,
+                                   IfGenerationNotMatch(generation));
+  auto result = Store(bucket_name, object_name, stream);
+  if (!result && result.status().code() == StatusCode::kFailedPrecondition) {
+    // The generation has not changed, the service responded with `304 Not
+    // Modified` and no payload, serve the cached contents.
+    return cached;
+  }
+  return result;
+}
+
+void ObjectContentCache::Invalidate(std::string const& bucket_name,
+                                    std::string const& object_name) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cache_.erase(std::make_pair(bucket_name, object_name));
+}
+
+void ObjectContentCache::Clear() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cache_.clear();
+}
+
+std::size_t ObjectContentCache::size() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return cache_.size();
+}
+
+StatusOr<std::shared_ptr<std::string const>> ObjectContentCache::Store(
+    std::string const& bucket_name, std::string const& object_name,
+    ObjectReadStream& stream) {
+  std::string contents{std::istreambuf_iterator<char>{stream}, {}};
+  stream.Close();
+  if (!stream.status().ok()) {
+    return stream.status();
+  }
+  auto result = std::make_shared<std::string const>(std::move(contents));
+  auto loc = stream.headers().find("x-goog-generation");
+  if (loc == stream.headers().end()) {
+    // Without a generation the entry cannot be revalidated, do not cache it.
+    return StatusOr<std::shared_ptr<std::string const>>(std::move(result));
+  }
+  auto generation = std::stoll(loc->second);
+  std::unique_lock<std::mutex> lk(mu_);
+  cache_[std::make_pair(bucket_name, object_name)] = Entry{generation, result};
+  return StatusOr<std::shared_ptr<std::string const>>(std::move(result));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,91 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_CONTENT_CACHE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_CONTENT_CACHE_H_
+
+#include "google/cloud/storage/client.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * An in-process cache for the contents of GCS objects.
+ *
+ * Applications that repeatedly read the same objects, configuration files
+ * being the typical example, pay a full download on every read. This class
+ * caches the contents, keyed by `(bucket, object)`, together with the object
+ * generation. Subsequent calls to `Get()` revalidate the cached entry with a
+ * conditional read (`IfGenerationNotMatch`): if the object has not changed
+ * the service responds with `304 Not Modified` and no payload, and the
+ * cached contents are returned without downloading the object again.
+ *
+ * The contents are returned as a `std::shared_ptr<std::string const>` so
+ * concurrent callers share a single copy of the data.
+ *
+ * This class is thread-safe, but note that each call to `Get()` performs at
+ * least one network round-trip to revalidate the entry. Applications that
+ * can tolerate stale data should add their own time-based throttling.
+ */
+class ObjectContentCache {
+ public:
+  explicit ObjectContentCache(Client client) : client_(std::move(client)) {}
+
+  /**
+   * Return the contents of `(bucket_name, object_name)`.
+   *
+   * If the object is cached this issues a conditional read, downloading the
+   * contents only when the object generation has changed.
+   */
+  StatusOr<std::shared_ptr<std::string const>> Get(
+      std::string const& bucket_name, std::string const& object_name);
+
+  /// Remove the entry for `(bucket_name, object_name)`, if any.
+  void Invalidate(std::string const& bucket_name,
+                  std::string const& object_name);
+
+  /// Remove all the cached entries.
+  void Clear();
+
+  /// Return the number of cached entries, mostly useful in tests.
+  std::size_t size() const;
+
+ private:
+  struct Entry {
+    std::int64_t generation;
+    std::shared_ptr<std::string const> contents;
+  };
+
+  /// Consume @p stream and insert (or replace) the cache entry.
+  StatusOr<std::shared_ptr<std::string const>> Store(
+      std::string const& bucket_name, std::string const& object_name,
+      ObjectReadStream& stream);
+
+  Client client_;
+  mutable std::mutex mu_;
+  std::map<std::pair<std::string, std::string>, Entry> cache_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_CONTENT_CACHE_H_
@@ -0,0 +1,183 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_content_cache.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+
+/// Serve @p payload as the full object contents for generation @p generation.
+StatusOr<std::unique_ptr<internal::ObjectReadSource>> MakeReadSource(
+    std::string const& payload, std::int64_t generation) {
+  internal::HttpResponse response{
+      200, "", {{"x-goog-generation", std::to_string(generation)}}};
+  auto source =
+      google::cloud::internal::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*source, Read(_, _))
+      .WillOnce(Invoke([payload, response](char* buf, std::size_t n) {
+        EXPECT_GE(n, payload.size());
+        std::memcpy(buf, payload.data(), payload.size());
+        return internal::ReadSourceResult{payload.size(), response};
+      }))
+      .WillOnce(Return(internal::ReadSourceResult{0, response}));
+  EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*source, Close())
+      .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+  return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+      std::move(source));
+}
+
+/// Serve a `304 Not Modified` response without a payload.
+StatusOr<std::unique_ptr<internal::ObjectReadSource>> MakeNotModifiedSource() {
+  auto source =
+      google::cloud::internal::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*source, Read(_, _))
+      .WillOnce(Return(
+          internal::ReadSourceResult{0, internal::HttpResponse{304, "", {}}}));
+  EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*source, Close())
+      .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+  return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+      std::move(source));
+}
+
+class ObjectContentCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(ObjectContentCacheTest, UnchangedObjectServedFromCache) {
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(kBucketName, request.bucket_name());
+        EXPECT_EQ(kObjectName, request.object_name());
+        EXPECT_FALSE(request.HasOption<IfGenerationNotMatch>());
+        return MakeReadSource("cached-contents", 42);
+      }))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_TRUE(request.HasOption<IfGenerationNotMatch>());
+        EXPECT_EQ(42, request.GetOption<IfGenerationNotMatch>().value());
+        return MakeNotModifiedSource();
+      }));
+
+  ObjectContentCache cache(*client);
+  auto first = cache.Get(kBucketName, kObjectName);
+  ASSERT_STATUS_OK(first);
+  EXPECT_EQ("cached-contents", **first);
+  EXPECT_EQ(1U, cache.size());
+
+  auto second = cache.Get(kBucketName, kObjectName);
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ(first->get(), second->get());
+}
+
+TEST_F(ObjectContentCacheTest, ChangedObjectIsRefreshed) {
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const&) {
+        return MakeReadSource("old-contents", 42);
+      }))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(42, request.GetOption<IfGenerationNotMatch>().value());
+        return MakeReadSource("new-contents", 43);
+      }))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(43, request.GetOption<IfGenerationNotMatch>().value());
+        return MakeNotModifiedSource();
+      }));
+
+  ObjectContentCache cache(*client);
+  auto first = cache.Get(kBucketName, kObjectName);
+  ASSERT_STATUS_OK(first);
+  EXPECT_EQ("old-contents", **first);
+
+  auto second = cache.Get(kBucketName, kObjectName);
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ("new-contents", **second);
+
+  auto third = cache.Get(kBucketName, kObjectName);
+  ASSERT_STATUS_OK(third);
+  EXPECT_EQ(second->get(), third->get());
+}
+
+TEST_F(ObjectContentCacheTest, InvalidateForcesDownload) {
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const&) {
+        return MakeReadSource("contents", 42);
+      }))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_FALSE(request.HasOption<IfGenerationNotMatch>());
+        return MakeReadSource("contents", 42);
+      }));
+
+  ObjectContentCache cache(*client);
+  ASSERT_STATUS_OK(cache.Get(kBucketName, kObjectName));
+  cache.Invalidate(kBucketName, kObjectName);
+  EXPECT_EQ(0U, cache.size());
+  ASSERT_STATUS_OK(cache.Get(kBucketName, kObjectName));
+  EXPECT_EQ(1U, cache.size());
+}
+
+TEST_F(ObjectContentCacheTest, DownloadErrorIsPropagated) {
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Return(StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+          PermanentError())));
+
+  ObjectContentCache cache(*client);
+  auto result = cache.Get(kBucketName, kObjectName);
+  EXPECT_FALSE(result);
+  EXPECT_EQ(PermanentError().code(), result.status().code());
+  EXPECT_EQ(0U, cache.size());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -22,10 +22,38 @@ namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
+std::vector<ObjectAccessControl> const& ObjectMetadata::acl() const {
+  MaterializeAcl();
+  return acl_;
+}
+
+std::vector<ObjectAccessControl>& ObjectMetadata::mutable_acl() {
+  MaterializeAcl();
+  return acl_;
+}
+
+void ObjectMetadata::MaterializeAcl() const {
+  if (!raw_acl_) {
+    return;
+  }
+  auto raw = std::move(raw_acl_);
+  auto json = internal::nl::json::parse(*raw, nullptr, false);
+  for (auto const& kv : json.items()) {
+    auto parsed = internal::ObjectAccessControlParser::FromJson(kv.value());
+    if (!parsed.ok()) {
+      // The raw JSON was produced by the service, entries that do not parse
+      // as access controls should not happen, skip them.
+      continue;
+    }
+    acl_.emplace_back(*std::move(parsed));
+  }
+}
+
 bool operator==(ObjectMetadata const& lhs, ObjectMetadata const& rhs) {
+  // Compare via `acl()` so deferred ACLs are parsed before the comparison.
   return static_cast<internal::CommonMetadata<ObjectMetadata> const&>(lhs) ==
              rhs &&
-         lhs.acl_ == rhs.acl_ && lhs.bucket_ == rhs.bucket_ &&
+         lhs.acl() == rhs.acl() && lhs.bucket_ == rhs.bucket_ &&
          lhs.cache_control_ == rhs.cache_control_ &&
          lhs.component_count_ == rhs.component_count_ &&
          lhs.content_disposition_ == rhs.content_disposition_ &&
@@ -22,6 +22,7 @@
 #include "google/cloud/storage/object_access_control.h"
 #include "google/cloud/storage/version.h"
 #include <map>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -89,16 +90,32 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
 
   // Please keep these in alphabetical order, that make it easier to verify we
   // have actually implemented all of them.
-  std::vector<ObjectAccessControl> const& acl() const { return acl_; }
-  std::vector<ObjectAccessControl>& mutable_acl() { return acl_; }
+  /**
+   * Returns the access control list for the object.
+   *
+   * Objects created by `internal::ObjectMetadataParser::FromJsonLazyAcl()`,
+   * notably the results of `Client::ListObjects()`, keep the raw JSON for
+   * this field and parse it on the first call to `acl()`, `mutable_acl()`,
+   * or `operator==()`. Applications that never touch the ACLs, the common
+   * case when listing objects, do not pay for parsing them. Note that the
+   * deferred parsing modifies the object, so the first of these calls is not
+   * thread-safe with respect to other accessors.
+   */
+  std::vector<ObjectAccessControl> const& acl() const;
+  std::vector<ObjectAccessControl>& mutable_acl();
   ObjectMetadata& set_acl(std::vector<ObjectAccessControl> acl) {
     acl_ = std::move(acl);
+    raw_acl_.reset();
     return *this;
   }
 
-  std::string const& bucket() const { return bucket_; }
+  // The string accessors return references, with `&&`-qualified overloads
+  // so callers can steal the strings from expiring values.
+  std::string const& bucket() const& { return bucket_; }
+  std::string&& bucket() && { return std::move(bucket_); }
 
-  std::string const& cache_control() const { return cache_control_; }
+  std::string const& cache_control() const& { return cache_control_; }
+  std::string&& cache_control() && { return std::move(cache_control_); }
   ObjectMetadata& set_cache_control(std::string cache_control) {
     cache_control_ = std::move(cache_control);
     return *this;
@@ -106,31 +123,40 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
 
   std::int32_t component_count() const { return component_count_; }
 
-  std::string content_disposition() const { return content_disposition_; }
+  std::string const& content_disposition() const& {
+    return content_disposition_;
+  }
+  std::string&& content_disposition() && {
+    return std::move(content_disposition_);
+  }
   ObjectMetadata& set_content_disposition(std::string value) {
     content_disposition_ = std::move(value);
     return *this;
   }
 
-  std::string content_encoding() const { return content_encoding_; }
+  std::string const& content_encoding() const& { return content_encoding_; }
+  std::string&& content_encoding() && { return std::move(content_encoding_); }
   ObjectMetadata& set_content_encoding(std::string value) {
     content_encoding_ = std::move(value);
     return *this;
   }
 
-  std::string content_language() const { return content_language_; }
+  std::string const& content_language() const& { return content_language_; }
+  std::string&& content_language() && { return std::move(content_language_); }
   ObjectMetadata& set_content_language(std::string value) {
     content_language_ = std::move(value);
     return *this;
   }
 
-  std::string content_type() const { return content_type_; }
+  std::string const& content_type() const& { return content_type_; }
+  std::string&& content_type() && { return std::move(content_type_); }
   ObjectMetadata& set_content_type(std::string value) {
     content_type_ = std::move(value);
     return *this;
   }
 
-  std::string const& crc32c() const { return crc32c_; }
+  std::string const& crc32c() const& { return crc32c_; }
+  std::string&& crc32c() && { return std::move(crc32c_); }
 
   bool has_customer_encryption() const {
     return customer_encryption_.has_value();
@@ -152,9 +178,12 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
   using CommonMetadata::id;
   using CommonMetadata::kind;
 
-  std::string const& kms_key_name() const { return kms_key_name_; }
-  std::string const& md5_hash() const { return md5_hash_; }
-  std::string const& media_link() const { return media_link_; }
+  std::string const& kms_key_name() const& { return kms_key_name_; }
+  std::string&& kms_key_name() && { return std::move(kms_key_name_); }
+  std::string const& md5_hash() const& { return md5_hash_; }
+  std::string&& md5_hash() && { return std::move(md5_hash_); }
+  std::string const& media_link() const& { return media_link_; }
+  std::string&& media_link() && { return std::move(media_link_); }
 
   //@{
   /// @name Accessors and modifiers to the `metadata` labels.
@@ -237,8 +266,12 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
   friend struct internal::ObjectMetadataParser;
 
   friend std::ostream& operator<<(std::ostream& os, ObjectMetadata const& rhs);
+
+  /// Parse `raw_acl_` into `acl_`, if needed.
+  void MaterializeAcl() const;
+
   // Keep the fields in alphabetical order.
-  std::vector<ObjectAccessControl> acl_;
+  mutable std::vector<ObjectAccessControl> acl_;
   std::string bucket_;
   std::string cache_control_;
   std::int32_t component_count_;
@@ -254,6 +287,9 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
   std::string md5_hash_;
   std::string media_link_;
   std::map<std::string, std::string> metadata_;
+  // The raw JSON for the `acl` field, if it has not been parsed yet. Shared
+  // so copies of the metadata share the unparsed representation.
+  mutable std::shared_ptr<std::string const> raw_acl_;
   std::chrono::system_clock::time_point retention_expiration_time_;
   std::uint64_t size_;
   bool temporary_hold_ = false;
@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_metadata_batcher.h"
+#include "google/cloud/storage/internal/curl_client.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+ObjectMetadataBatcher::ObjectMetadataBatcher(Client client,
+                                             std::size_t max_concurrency,
+                                             std::size_t batch_size)
+    : client_(std::move(client)),
+      curl_client_(std::dynamic_pointer_cast<internal::CurlClient>(
+          client_.raw_client())),
+      batch_size_((std::max<std::size_t>)(
+          1, (std::min)(batch_size, internal::kMaxBatchParts))),
+      pool_((std::max<std::size_t>)(1, max_concurrency)) {}
+
+ObjectMetadataBatcher::~ObjectMetadataBatcher() { Flush(); }
+
+std::future<StatusOr<ObjectMetadata>> ObjectMetadataBatcher::Schedule(
+    std::string bucket_name, std::string object_name) {
+  return Schedule(internal::GetObjectMetadataRequest(std::move(bucket_name),
+                                                     std::move(object_name)));
+}
+
+std::future<StatusOr<ObjectMetadata>> ObjectMetadataBatcher::Schedule(
+    internal::GetObjectMetadataRequest request) {
+  Item item{std::move(request), std::promise<StatusOr<ObjectMetadata>>{}};
+  auto f = item.promise.get_future();
+  std::vector<Item> batch;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    pending_.push_back(std::move(item));
+    if (pending_.size() < batch_size_) {
+      return f;
+    }
+    batch.swap(pending_);
+  }
+  auto items = std::make_shared<std::vector<Item>>(std::move(batch));
+  pool_.Submit([this, items] { SendBatch(items); });
+  return f;
+}
+
+void ObjectMetadataBatcher::Flush() {
+  std::vector<Item> batch;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    batch.swap(pending_);
+  }
+  if (batch.empty()) {
+    return;
+  }
+  auto items = std::make_shared<std::vector<Item>>(std::move(batch));
+  pool_.Submit([this, items] { SendBatch(items); });
+}
+
+void ObjectMetadataBatcher::SendBatch(
+    std::shared_ptr<std::vector<Item>> const& items) {
+  if (!curl_client_) {
+    // The transport does not expose the batch endpoint, issue the operations
+    // one at a time. The thread pool still bounds the concurrency.
+    for (auto& item : *items) {
+      item.promise.set_value(client_.raw_client()->GetObjectMetadata(
+          item.request));
+    }
+    return;
+  }
+  internal::BatchRequestBuilder builder;
+  for (auto const& item : *items) {
+    auto status = builder.AddGetObjectMetadata(item.request);
+    if (!status.ok()) {
+      // Cannot happen, `batch_size_` is capped at `kMaxBatchParts`, but do
+      // not leave broken promises behind if it ever does.
+      for (auto& broken : *items) {
+        broken.promise.set_value(status);
+      }
+      return;
+    }
+  }
+  auto responses = curl_client_->ExecuteBatch(builder);
+  if (!responses) {
+    for (auto& item : *items) {
+      item.promise.set_value(responses.status());
+    }
+    return;
+  }
+  if (responses->size() != items->size()) {
+    Status status(StatusCode::kInternal,
+                  "mismatched operation count in batch response");
+    for (auto& item : *items) {
+      item.promise.set_value(status);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i != items->size(); ++i) {
+    auto& part = (*responses)[i];
+    auto& promise = (*items)[i].promise;
+    if (part.status_code >= internal::HttpStatusCode::kMinNotSuccess) {
+      promise.set_value(internal::AsStatus(part));
+      continue;
+    }
+    promise.set_value(
+        internal::ObjectMetadataParser::FromString(part.payload));
+  }
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
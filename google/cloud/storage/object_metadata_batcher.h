@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_METADATA_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_METADATA_BATCHER_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/batch_request.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/version.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+class CurlClient;
+}  // namespace internal
+
+/**
+ * Fetch the metadata of many objects without paying one round trip each.
+ *
+ * `Client::GetObjectMetadata()` performs one HTTPS request per call, so
+ * applications that stat millions of objects (e.g. indexing jobs) are
+ * bound by the request latency. This class accumulates the requests and
+ * sends them to the GCS batch endpoint, up to `internal::kMaxBatchParts`
+ * operations per HTTP request, using a bounded number of threads (and
+ * therefore connections). Each scheduled request gets a `std::future`
+ * satisfied with the object metadata, or with the error for that
+ * operation.
+ *
+ * Batching requires direct access to the CURL-based transport. When the
+ * client is wrapped (e.g. by `ClientOptions::enable_tracing()`), the
+ * batcher falls back to issuing the operations individually, still with
+ * bounded concurrency.
+ *
+ * @par Example
+ * @code
+ * storage::ObjectMetadataBatcher batcher(client, 8);
+ * std::vector<std::future<StatusOr<ObjectMetadata>>> results;
+ * for (auto const& name : object_names) {
+ *   results.push_back(batcher.Schedule("my-bucket", name));
+ * }
+ * batcher.Flush();
+ * for (auto& r : results) { auto metadata = r.get(); }
+ * @endcode
+ */
+class ObjectMetadataBatcher {
+ public:
+  /**
+   * @param client the client used to contact the service.
+   * @param max_concurrency the number of worker threads, and therefore the
+   *     maximum number of batch requests in flight.
+   * @param batch_size the number of operations per batch request, capped at
+   *     `internal::kMaxBatchParts`.
+   */
+  explicit ObjectMetadataBatcher(
+      Client client, std::size_t max_concurrency = 4,
+      std::size_t batch_size = internal::kMaxBatchParts);
+
+  /// Sends any buffered requests and blocks until all batches complete.
+  ~ObjectMetadataBatcher();
+
+  ObjectMetadataBatcher(ObjectMetadataBatcher const&) = delete;
+  ObjectMetadataBatcher& operator=(ObjectMetadataBatcher const&) = delete;
+
+  /**
+   * Schedule a metadata fetch for `<bucket_name>/<object_name>`.
+   *
+   * The request is buffered until a full batch accumulates, the batcher is
+   * flushed, or the batcher is destroyed.
+   */
+  std::future<StatusOr<ObjectMetadata>> Schedule(std::string bucket_name,
+                                                 std::string object_name);
+
+  /// Schedule a metadata fetch with explicit request options.
+  std::future<StatusOr<ObjectMetadata>> Schedule(
+      internal::GetObjectMetadataRequest request);
+
+  /// Send any buffered requests, even if they do not fill a batch.
+  void Flush();
+
+ private:
+  struct Item {
+    internal::GetObjectMetadataRequest request;
+    std::promise<StatusOr<ObjectMetadata>> promise;
+  };
+
+  /// Execute one batch, satisfying the promise for each item.
+  void SendBatch(std::shared_ptr<std::vector<Item>> const& items);
+
+  Client client_;
+  // Set when the transport supports the batch endpoint, otherwise the
+  // batcher issues the operations one at a time.
+  std::shared_ptr<internal::CurlClient> curl_client_;
+  std::size_t batch_size_;
+
+  std::mutex mu_;
+  std::vector<Item> pending_;  // GUARDED_BY(mu_)
+
+  // Declared last so it is destroyed (and drained) first, the queued tasks
+  // reference the other members.
+  internal::ThreadPool pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_METADATA_BATCHER_H
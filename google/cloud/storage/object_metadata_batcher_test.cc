@@ -0,0 +1,150 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_metadata_batcher.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::GetObjectMetadataRequest;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+
+ObjectMetadata CreateObject(std::string const& name) {
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{{"bucket", "test-bucket"},
+                                {"name", name},
+                                {"kind", "storage#object"}})
+      .value();
+}
+
+class ObjectMetadataBatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+/// @test Verify scheduled requests are satisfied after a Flush().
+TEST_F(ObjectMetadataBatcherTest, ScheduleAndFlush) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        return StatusOr<ObjectMetadata>(CreateObject(request.object_name()));
+      }));
+
+  ObjectMetadataBatcher batcher(*client, 2);
+  auto f1 = batcher.Schedule("test-bucket", "object-1");
+  auto f2 = batcher.Schedule("test-bucket", "object-2");
+  batcher.Flush();
+
+  auto m1 = f1.get();
+  ASSERT_STATUS_OK(m1);
+  EXPECT_EQ("object-1", m1->name());
+  auto m2 = f2.get();
+  ASSERT_STATUS_OK(m2);
+  EXPECT_EQ("object-2", m2->name());
+}
+
+/// @test Verify a full batch is sent without an explicit Flush().
+TEST_F(ObjectMetadataBatcherTest, AutoFlushAtBatchSize) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const& request) {
+        return StatusOr<ObjectMetadata>(CreateObject(request.object_name()));
+      }));
+
+  ObjectMetadataBatcher batcher(*client, 2, 2);
+  auto f1 = batcher.Schedule("test-bucket", "object-1");
+  auto f2 = batcher.Schedule("test-bucket", "object-2");
+
+  // The second Schedule() completes the batch, the futures are satisfied
+  // without calling Flush().
+  auto m1 = f1.get();
+  ASSERT_STATUS_OK(m1);
+  EXPECT_EQ("object-1", m1->name());
+  auto m2 = f2.get();
+  ASSERT_STATUS_OK(m2);
+  EXPECT_EQ("object-2", m2->name());
+}
+
+/// @test Verify the destructor sends any buffered requests.
+TEST_F(ObjectMetadataBatcherTest, DestructorFlushes) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const& request) {
+        return StatusOr<ObjectMetadata>(CreateObject(request.object_name()));
+      }));
+
+  std::future<StatusOr<ObjectMetadata>> f;
+  {
+    ObjectMetadataBatcher batcher(*client, 1);
+    f = batcher.Schedule("test-bucket", "object-1");
+  }
+  auto metadata = f.get();
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ("object-1", metadata->name());
+}
+
+/// @test Verify per-operation errors are delivered to the right future.
+TEST_F(ObjectMetadataBatcherTest, ErrorsPropagate) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const& request) {
+        if (request.object_name() == "missing") {
+          return StatusOr<ObjectMetadata>(PermanentError());
+        }
+        return StatusOr<ObjectMetadata>(CreateObject(request.object_name()));
+      }));
+
+  ObjectMetadataBatcher batcher(*client, 2);
+  auto good = batcher.Schedule("test-bucket", "object-1");
+  auto bad = batcher.Schedule("test-bucket", "missing");
+  batcher.Flush();
+
+  ASSERT_STATUS_OK(good.get());
+  auto failure = bad.get();
+  EXPECT_FALSE(failure.ok());
+  EXPECT_EQ(PermanentError().code(), failure.status().code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
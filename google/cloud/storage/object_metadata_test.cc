@@ -165,6 +165,60 @@ TEST(ObjectMetadataTest, Parse) {
                                       .count());
 }
 
+/// @test Verify the rvalue-qualified accessors transfer the strings.
+TEST(ObjectMetadataTest, MoveAccessors) {
+  // A temporary picks the `&&` overload without an explicit `std::move()`.
+  EXPECT_EQ(
+      "https://storage.googleapis.com/storage/v1/b/foo-bar/o/"
+      "baz?generation=12345&alt=media",
+      CreateObjectMetadataForTest().media_link());
+
+  auto actual = CreateObjectMetadataForTest();
+  std::string bucket = std::move(actual).bucket();
+  EXPECT_EQ("foo-bar", bucket);
+  actual = CreateObjectMetadataForTest();
+  std::string name = std::move(actual).name();
+  EXPECT_EQ("baz", name);
+  actual = CreateObjectMetadataForTest();
+  std::string content_type = std::move(actual).content_type();
+  EXPECT_EQ("application/octet-stream", content_type);
+}
+
+/// @test Verify that lazily parsed ACLs match the eagerly parsed ones.
+TEST(ObjectMetadataTest, ParseLazyAcl) {
+  std::string text = R"""({
+      "bucket": "foo-bar",
+      "name": "baz",
+      "acl": [
+        {"kind": "storage#objectAccessControl", "id": "acl-id-0",
+         "entity": "user-qux", "role": "OWNER"},
+        {"kind": "storage#objectAccessControl", "id": "acl-id-1",
+         "entity": "user-quux", "role": "READER"}
+      ]
+})""";
+  auto json = internal::nl::json::parse(text);
+  auto eager = internal::ObjectMetadataParser::FromJson(json).value();
+  auto lazy = internal::ObjectMetadataParser::FromJsonLazyAcl(json).value();
+  ASSERT_EQ(2, lazy.acl().size());
+  EXPECT_EQ("acl-id-0", lazy.acl().at(0).id());
+  EXPECT_EQ("user-quux", lazy.acl().at(1).entity());
+  EXPECT_EQ(eager, lazy);
+}
+
+/// @test Verify that setting the ACL discards the unparsed representation.
+TEST(ObjectMetadataTest, LazyAclSetAcl) {
+  std::string text = R"""({
+      "bucket": "foo-bar",
+      "name": "baz",
+      "acl": [{"kind": "storage#objectAccessControl", "id": "acl-id-0",
+               "entity": "user-qux", "role": "OWNER"}]
+})""";
+  auto json = internal::nl::json::parse(text);
+  auto lazy = internal::ObjectMetadataParser::FromJsonLazyAcl(json).value();
+  lazy.set_acl({});
+  EXPECT_TRUE(lazy.acl().empty());
+}
+
 /// @test Verify that the IOStream operator works as expected.
 TEST(ObjectMetadataTest, IOStream) {
   auto meta = CreateObjectMetadataForTest();
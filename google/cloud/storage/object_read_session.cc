@@ -0,0 +1,76 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_read_session.h"
+#include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/curl_handle_factory.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+ObjectReadSession::ObjectReadSession(Client client, ObjectMetadata metadata,
+                                     internal::ReadObjectRangeRequest request)
+    : client_(std::move(client)),
+      metadata_(std::move(metadata)),
+      request_(std::move(request)),
+      curl_client_(std::dynamic_pointer_cast<internal::CurlClient>(
+          client_.raw_client())) {
+  if (curl_client_) {
+    // A pool of one handle gives the session a dedicated connection, the
+    // reads reuse it and skip the TCP and TLS handshakes.
+    factory_ = std::make_shared<internal::PooledCurlHandleFactory>(1);
+  }
+}
+
+StatusOr<std::size_t> ObjectReadSession::ReadAt(std::uint64_t offset,
+                                                std::size_t count,
+                                                char* buffer) {
+  if (count == 0) {
+    return std::size_t{0};
+  }
+  auto request = request_;
+  request.set_option(ReadRange(static_cast<std::int64_t>(offset),
+                               static_cast<std::int64_t>(offset + count)));
+  auto source = curl_client_ ? curl_client_->ReadObject(request, factory_)
+                             : client_.raw_client()->ReadObject(request);
+  if (!source) {
+    return std::move(source).status();
+  }
+  std::size_t total = 0;
+  while (total != count) {
+    auto result = (*source)->Read(buffer + total, count - total);
+    if (!result) {
+      return std::move(result).status();
+    }
+    if (result->response.status_code >=
+        internal::HttpStatusCode::kMinNotSuccess) {
+      return internal::AsStatus(result->response);
+    }
+    if (result->bytes_received == 0) {
+      // The range extends beyond the end of the object, this is a short
+      // read, not an error.
+      break;
+    }
+    total += result->bytes_received;
+  }
+  (*source)->Close();
+  return total;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
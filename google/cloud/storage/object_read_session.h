@@ -0,0 +1,128 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_READ_SESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_READ_SESSION_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+class CurlClient;
+class CurlHandleFactory;
+}  // namespace internal
+
+/**
+ * Perform many small range reads against the same object.
+ *
+ * Applications serving data out of a few hot objects issue thousands of
+ * small `ReadObject()` calls, paying the full request setup each time, and
+ * racing against concurrent overwrites. A session fetches the object
+ * metadata once, pins the generation so all the reads observe the same
+ * version, and (when the underlying transport allows it) reuses a dedicated
+ * connection, so repeated reads skip the TCP and TLS handshakes.
+ *
+ * `ReadAt()` performs a single read attempt without buffering or hash
+ * validation, applications that need retries should wrap the call with
+ * their own retry loop.
+ */
+class ObjectReadSession {
+ public:
+  /**
+   * Create a session to read from an object.
+   *
+   * @param client the client on which to perform the operation.
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request
+   *     headers. Valid types for this operation include
+   *     `DisableCrc32cChecksum`, `DisableMD5Hash`, `EncryptionKey`,
+   *     `Generation`, `IfGenerationMatch`, `IfMetagenerationMatch`,
+   *     `UserProject`.
+   */
+  template <typename... Options>
+  static StatusOr<ObjectReadSession> Create(Client client,
+                                            std::string bucket_name,
+                                            std::string object_name,
+                                            Options&&... options) {
+    using internal::Among;
+    using internal::StaticTupleFilter;
+    auto metadata_options = StaticTupleFilter<
+        Among<Generation, IfGenerationMatch, IfMetagenerationMatch,
+              UserProject>::TPred>(std::tie(options...));
+    auto metadata = google::cloud::internal::apply(
+        internal::GetObjectMetadataApplyHelper{client, bucket_name,
+                                               object_name},
+        std::move(metadata_options));
+    if (!metadata) {
+      return metadata.status();
+    }
+    internal::ReadObjectRangeRequest request(std::move(bucket_name),
+                                             std::move(object_name));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    // Pin the generation so all the reads in the session observe the same
+    // version of the object, even if it is overwritten.
+    request.set_option(Generation(metadata->generation()));
+    return ObjectReadSession(std::move(client), *std::move(metadata),
+                             std::move(request));
+  }
+
+  /**
+   * Read up to @p count bytes starting at @p offset into @p buffer.
+   *
+   * @return the number of bytes read. This is less than @p count only when
+   *     the range extends beyond the end of the object.
+   */
+  StatusOr<std::size_t> ReadAt(std::uint64_t offset, std::size_t count,
+                               char* buffer);
+
+  /// The metadata of the object, fetched when the session was created.
+  ObjectMetadata const& metadata() const { return metadata_; }
+
+  /// The generation all the reads in this session are pinned to.
+  std::int64_t generation() const { return metadata_.generation(); }
+
+  /// The size of the object, in bytes.
+  std::uint64_t size() const { return metadata_.size(); }
+
+ private:
+  ObjectReadSession(Client client, ObjectMetadata metadata,
+                    internal::ReadObjectRangeRequest request);
+
+  Client client_;
+  ObjectMetadata metadata_;
+  internal::ReadObjectRangeRequest request_;
+  /// Not null iff the raw client supports dedicated connections.
+  std::shared_ptr<internal::CurlClient> curl_client_;
+  /// The dedicated connection for this session.
+  std::shared_ptr<internal::CurlHandleFactory> factory_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_READ_SESSION_H
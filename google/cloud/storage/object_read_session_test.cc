@@ -0,0 +1,178 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_read_session.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <cstring>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+std::int64_t const kGeneration = 42;
+
+ObjectMetadata MockObject(std::uintmax_t size) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(internal::nl::json{
+      {"kind", "storage#object"},
+      {"bucket", kBucketName},
+      {"name", kObjectName},
+      {"generation", kGeneration},
+      {"size", size}});
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+class ObjectReadSessionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(ObjectReadSessionTest, ReadAtServesRange) {
+  std::string const payload = "0123456789";
+
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject(1000))));
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Invoke([&](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(kBucketName, request.bucket_name());
+        EXPECT_EQ(kObjectName, request.object_name());
+        EXPECT_TRUE(request.HasOption<Generation>());
+        EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+        EXPECT_TRUE(request.HasOption<ReadRange>());
+        auto range = request.GetOption<ReadRange>().value();
+        EXPECT_EQ(100, range.begin);
+        EXPECT_EQ(110, range.end);
+        auto source = google::cloud::internal::make_unique<
+            testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, Read(_, _))
+            .WillOnce(Invoke([&](char* buf, std::size_t n) {
+              EXPECT_GE(n, payload.size());
+              std::memcpy(buf, payload.data(), payload.size());
+              return internal::ReadSourceResult{
+                  payload.size(), internal::HttpResponse{200, "", {}}};
+            }));
+        EXPECT_CALL(*source, Close())
+            .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(source));
+      }));
+
+  auto session = ObjectReadSession::Create(*client, kBucketName, kObjectName);
+  ASSERT_STATUS_OK(session);
+  EXPECT_EQ(kGeneration, session->generation());
+  EXPECT_EQ(1000U, session->size());
+
+  std::vector<char> buffer(10);
+  auto count = session->ReadAt(100, buffer.size(), buffer.data());
+  ASSERT_STATUS_OK(count);
+  EXPECT_EQ(payload.size(), *count);
+  EXPECT_EQ(payload, std::string(buffer.data(), *count));
+}
+
+TEST_F(ObjectReadSessionTest, ShortReadAtEndOfObject) {
+  std::string const payload = "tail!";
+
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject(1000))));
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Invoke([&](internal::ReadObjectRangeRequest const&) {
+        auto source = google::cloud::internal::make_unique<
+            testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, Read(_, _))
+            .WillOnce(Invoke([&](char* buf, std::size_t) {
+              std::memcpy(buf, payload.data(), payload.size());
+              return internal::ReadSourceResult{
+                  payload.size(), internal::HttpResponse{200, "", {}}};
+            }))
+            .WillOnce(Return(internal::ReadSourceResult{
+                0, internal::HttpResponse{200, "", {}}}));
+        EXPECT_CALL(*source, Close())
+            .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(source));
+      }));
+
+  auto session = ObjectReadSession::Create(*client, kBucketName, kObjectName);
+  ASSERT_STATUS_OK(session);
+
+  std::vector<char> buffer(100);
+  auto count = session->ReadAt(995, buffer.size(), buffer.data());
+  ASSERT_STATUS_OK(count);
+  EXPECT_EQ(payload.size(), *count);
+  EXPECT_EQ(payload, std::string(buffer.data(), *count));
+}
+
+TEST_F(ObjectReadSessionTest, MetadataFailure) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  auto session = ObjectReadSession::Create(*client, kBucketName, kObjectName);
+  EXPECT_FALSE(session);
+  EXPECT_EQ(PermanentError().code(), session.status().code());
+}
+
+TEST_F(ObjectReadSessionTest, ReadFailure) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject(1000))));
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Return(StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+          PermanentError())));
+
+  auto session = ObjectReadSession::Create(*client, kBucketName, kObjectName);
+  ASSERT_STATUS_OK(session);
+
+  std::vector<char> buffer(10);
+  auto count = session->ReadAt(0, buffer.size(), buffer.data());
+  EXPECT_FALSE(count);
+  EXPECT_EQ(PermanentError().code(), count.status().code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -333,6 +333,22 @@ class ObjectWriteStream : public std::basic_ostream<char> {
     return buf_->next_expected_byte();
   }
 
+  /**
+   * Exports a binary checkpoint of the upload state.
+   *
+   * The checkpoint captures the session id, the committed byte count, and
+   * the running hash state in a compact binary blob. Passing the blob to
+   * `RestoreResumableUploadSession()` resumes the upload without the round
+   * trip to query the committed byte count that a plain session id
+   * requires.
+   *
+   * Checkpoints are only valid at a flush boundary: call `flush()` first,
+   * and note that the service only commits full 256 KiB chunks. The blob
+   * is only readable by the same library version on the same architecture,
+   * it is intended for crash-resume from local state, not for archival.
+   */
+  StatusOr<std::string> Checkpoint() const { return buf_->Checkpoint(); }
+
   /**
    * Suspends an upload.
    *
@@ -20,6 +20,7 @@
 #include "google/cloud/storage/testing/retry_tests.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -88,6 +89,36 @@ TEST_F(ObjectTest, InsertObjectMedia) {
   EXPECT_EQ(expected, *actual);
 }
 
+TEST_F(ObjectTest, InsertObjectMediaBorrowedContents) {
+  std::string text = R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""";
+  auto expected =
+      storage::internal::ObjectMetadataParser::FromString(text).value();
+
+  std::string const b0 = "test object ";
+  std::string const b1 = "contents";
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke(
+          [&](internal::InsertObjectMediaRequest const& request) {
+            EXPECT_EQ("test-bucket-name", request.bucket_name());
+            EXPECT_EQ("test-object-name", request.object_name());
+            auto buffers = request.contents_buffers();
+            EXPECT_EQ(2U, buffers.size());
+            EXPECT_EQ(b0.size() + b1.size(), request.contents_size());
+            EXPECT_EQ("test object contents", request.contents());
+            return make_status_or(expected);
+          }));
+
+  auto actual = client->InsertObject(
+      "test-bucket-name", "test-object-name",
+      internal::ConstBufferSequence{internal::ConstBuffer(b0),
+                                    internal::ConstBuffer(b1)},
+      DisableMD5Hash(true), DisableCrc32cChecksum(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+}
+
 TEST_F(ObjectTest, InsertObjectMediaTooManyFailures) {
   testing::TooManyFailuresStatusTest<ObjectMetadata>(
       mock, EXPECT_CALL(*mock, InsertObjectMedia(_)),
@@ -424,6 +455,86 @@ TEST_F(ObjectTest, ReadObjectPermanentFailure) {
   EXPECT_THAT(status.message(), HasSubstr("ReadObject"));
 }
 
+TEST_F(ObjectTest, DownloadObjectToBuffer) {
+  std::string const payload = "How vexingly quick daft zebras jump!";
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(
+          Invoke([&payload](internal::ReadObjectRangeRequest const& request) {
+            EXPECT_EQ("test-bucket-name", request.bucket_name());
+            EXPECT_EQ("test-object-name", request.object_name());
+            auto source = google::cloud::internal::make_unique<
+                testing::MockObjectReadSource>();
+            internal::HttpResponse response{
+                200, "", {{"x-goog-generation", "2345"}}};
+            EXPECT_CALL(*source, Read(_, _))
+                .WillOnce(
+                    Invoke([payload, response](char* buf, std::size_t n) {
+                      EXPECT_GE(n, payload.size());
+                      std::memcpy(buf, payload.data(), payload.size());
+                      return internal::ReadSourceResult{payload.size(),
+                                                        response};
+                    }))
+                .WillOnce(Return(internal::ReadSourceResult{0, response}));
+            EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+            EXPECT_CALL(*source, Close())
+                .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+            return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+                std::move(source));
+          }));
+
+  std::vector<char> buffer(1024);
+  auto actual = client->DownloadObjectToBuffer(
+      "test-bucket-name", "test-object-name", buffer.data(), buffer.size());
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(payload.size(), actual->bytes_written);
+  EXPECT_EQ(2345, actual->generation);
+  EXPECT_EQ(payload,
+            std::string(buffer.data(), buffer.data() + actual->bytes_written));
+}
+
+TEST_F(ObjectTest, DownloadObjectToBufferTooSmall) {
+  std::string const payload = "How vexingly quick daft zebras jump!";
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([&payload](internal::ReadObjectRangeRequest const&) {
+        auto source = google::cloud::internal::make_unique<
+            testing::MockObjectReadSource>();
+        std::size_t offset = 0;
+        EXPECT_CALL(*source, Read(_, _))
+            .WillRepeatedly(
+                Invoke([payload, offset](char* buf, std::size_t n) mutable {
+                  auto count = (std::min)(n, payload.size() - offset);
+                  std::memcpy(buf, payload.data() + offset, count);
+                  offset += count;
+                  return internal::ReadSourceResult{
+                      count, internal::HttpResponse{200, "", {}}};
+                }));
+        EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*source, Close())
+            .WillRepeatedly(Return(internal::HttpResponse{200, "", {}}));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(source));
+      }));
+
+  std::vector<char> buffer(payload.size() / 2);
+  auto actual = client->DownloadObjectToBuffer(
+      "test-bucket-name", "test-object-name", buffer.data(), buffer.size());
+  EXPECT_EQ(StatusCode::kOutOfRange, actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("does not fit"));
+}
+
+TEST_F(ObjectTest, DownloadObjectToBufferPermanentFailure) {
+  using ReturnType = std::unique_ptr<internal::ObjectReadSource>;
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](internal::ReadObjectRangeRequest const&) {
+        return StatusOr<ReturnType>(PermanentError());
+      }));
+
+  std::vector<char> buffer(1024);
+  auto actual = client->DownloadObjectToBuffer(
+      "test-bucket-name", "test-object-name", buffer.data(), buffer.size());
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
 ObjectMetadata CreateObject(int index) {
   std::string id = "object-" + std::to_string(index);
   std::string name = id;
@@ -706,51 +817,34 @@ TEST_F(ObjectTest, ComposeManyThreeLayers) {
 
   // Test 63 sources.
 
+  // The compositions within a layer run in parallel and may arrive in any
+  // order, so dispatch on the destination object name.
   EXPECT_CALL(*mock, ComposeObject(_))
-      .WillOnce(Invoke([](internal::ComposeObjectRequest const& req)
-                           -> StatusOr<ObjectMetadata> {
+      .Times(3)
+      .WillRepeatedly(Invoke([](internal::ComposeObjectRequest const& req)
+                                 -> StatusOr<ObjectMetadata> {
         EXPECT_EQ("test-bucket", req.bucket_name());
-        EXPECT_EQ("prefix.compose-tmp-0", req.object_name());
         internal::nl::json parsed =
             internal::nl::json::parse(req.JsonPayload());
         auto source_objects = parsed["sourceObjects"];
 
-        EXPECT_EQ(32, source_objects.size());
-
-        for (int i = 0; i != 32; ++i) {
-          EXPECT_EQ(std::to_string(i), source_objects[i]["name"]);
+        if (req.object_name() == "prefix.compose-tmp-0") {
+          EXPECT_EQ(32, source_objects.size());
+          for (int i = 0; i != 32; ++i) {
+            EXPECT_EQ(std::to_string(i), source_objects[i]["name"]);
+          }
+        } else if (req.object_name() == "prefix.compose-tmp-1") {
+          EXPECT_EQ(31, source_objects.size());
+          for (int i = 0; i != 31; ++i) {
+            EXPECT_EQ(std::to_string(i + 32), source_objects[i]["name"]);
+          }
+        } else {
+          EXPECT_EQ("dest", req.object_name());
+          EXPECT_EQ(2, source_objects.size());
+          EXPECT_EQ("prefix.compose-tmp-0", source_objects[0]["name"]);
+          EXPECT_EQ("prefix.compose-tmp-1", source_objects[1]["name"]);
         }
 
-        return MockObject(req.bucket_name(), req.object_name(), 42);
-      }))
-      .WillOnce(Invoke([](internal::ComposeObjectRequest const& req)
-                           -> StatusOr<ObjectMetadata> {
-        EXPECT_EQ("test-bucket", req.bucket_name());
-        EXPECT_EQ("prefix.compose-tmp-1", req.object_name());
-        internal::nl::json parsed =
-            internal::nl::json::parse(req.JsonPayload());
-        auto source_objects = parsed["sourceObjects"];
-
-        EXPECT_EQ(31, source_objects.size());
-
-        for (int i = 0; i != 31; ++i) {
-          EXPECT_EQ(std::to_string(i + 32), source_objects[i]["name"]);
-        }
-
-        return MockObject(req.bucket_name(), req.object_name(), 42);
-      }))
-      .WillOnce(Invoke([](internal::ComposeObjectRequest const& req)
-                           -> StatusOr<ObjectMetadata> {
-        EXPECT_EQ("test-bucket", req.bucket_name());
-        EXPECT_EQ("dest", req.object_name());
-        internal::nl::json parsed =
-            internal::nl::json::parse(req.JsonPayload());
-        auto source_objects = parsed["sourceObjects"];
-
-        EXPECT_EQ(2, source_objects.size());
-        EXPECT_EQ("prefix.compose-tmp-0", source_objects[0]["name"]);
-        EXPECT_EQ("prefix.compose-tmp-1", source_objects[1]["name"]);
-
         return MockObject(req.bucket_name(), req.object_name(), 42);
       }));
   EXPECT_CALL(*mock, InsertObjectMedia(_))
@@ -0,0 +1,175 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include <fstream>
+#include <sstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+#ifndef _WIN32
+Status PreallocateFile(std::string const& file_name, std::uintmax_t size) {
+  int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0) {
+    return Status(
+        StatusCode::kInvalidArgument,
+        "cannot create download destination file " + file_name);
+  }
+  if (size != 0) {
+#if defined(__linux__)
+    // Reserve the blocks up front, if the filesystem does not support the
+    // call just extend the file, that only reserves the metadata.
+    if (::posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0) {
+      (void)::ftruncate(fd, static_cast<off_t>(size));
+    }
+#else
+    (void)::ftruncate(fd, static_cast<off_t>(size));
+#endif  // __linux__
+  }
+  if (::close(fd) != 0) {
+    return Status(StatusCode::kUnknown,
+                  "cannot close download destination file " + file_name);
+  }
+  return Status();
+}
+
+Status WriteShardToFile(ObjectReadStream stream, std::string const& file_name,
+                        std::uintmax_t offset, std::size_t buffer_size) {
+  auto report_error = [&file_name, offset](char const* what,
+                                           Status const& status) {
+    std::ostringstream msg;
+    msg << "WriteShardToFile(" << file_name << ", offset=" << offset
+        << "): " << what << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  if (!stream.status().ok()) {
+    return report_error("cannot open download source object", stream.status());
+  }
+
+  // Each shard has its own descriptor and writes at explicit offsets, so
+  // the shards never interfere with each other's file position.
+  int fd = ::open(file_name.c_str(), O_WRONLY);
+  if (fd < 0) {
+    return report_error("cannot open download destination file",
+                        Status(StatusCode::kInvalidArgument, "open()"));
+  }
+
+  std::string buffer;
+  buffer.resize(buffer_size, '\0');
+  auto file_offset = offset;
+  do {
+    stream.read(&buffer[0], buffer.size());
+    auto count = static_cast<std::size_t>(stream.gcount());
+    std::size_t written = 0;
+    while (written != count) {
+      auto n = ::pwrite(fd, buffer.data() + written, count - written,
+                        static_cast<off_t>(file_offset + written));
+      if (n < 0) {
+        (void)::close(fd);
+        return report_error("cannot write to download destination file",
+                            Status(StatusCode::kUnknown, "pwrite()"));
+      }
+      written += static_cast<std::size_t>(n);
+    }
+    file_offset += count;
+  } while (stream.good());
+  if (::close(fd) != 0) {
+    return report_error("cannot close download destination file",
+                        Status(StatusCode::kUnknown, "close()"));
+  }
+  if (!stream.status().ok()) {
+    return report_error("error reading download source object",
+                        stream.status());
+  }
+  return Status();
+}
+#else
+Status PreallocateFile(std::string const& file_name, std::uintmax_t size) {
+  std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+  if (!os.is_open()) {
+    return Status(
+        StatusCode::kInvalidArgument,
+        "cannot create download destination file " + file_name);
+  }
+  if (size != 0) {
+    // There is no portable preallocation call, just extend the file.
+    os.seekp(static_cast<std::streamoff>(size - 1));
+    os.write("", 1);
+  }
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown,
+                  "cannot close download destination file " + file_name);
+  }
+  return Status();
+}
+
+Status WriteShardToFile(ObjectReadStream stream, std::string const& file_name,
+                        std::uintmax_t offset, std::size_t buffer_size) {
+  auto report_error = [&file_name, offset](char const* what,
+                                           Status const& status) {
+    std::ostringstream msg;
+    msg << "WriteShardToFile(" << file_name << ", offset=" << offset
+        << "): " << what << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  if (!stream.status().ok()) {
+    return report_error("cannot open download source object", stream.status());
+  }
+
+  // Reopen the destination file without truncating it, each shard has its
+  // own handle and writes only within its own range.
+  std::fstream os(file_name, std::ios::binary | std::ios::in | std::ios::out);
+  if (!os.is_open()) {
+    return report_error(
+        "cannot open download destination file",
+        Status(StatusCode::kInvalidArgument, "fstream::open()"));
+  }
+  os.seekp(static_cast<std::streamoff>(offset));
+
+  std::string buffer;
+  buffer.resize(buffer_size, '\0');
+  do {
+    stream.read(&buffer[0], buffer.size());
+    os.write(buffer.data(), stream.gcount());
+  } while (os.good() && stream.good());
+  os.close();
+  if (!os.good()) {
+    return report_error("cannot close download destination file",
+                        Status(StatusCode::kUnknown, "fstream::close()"));
+  }
+  if (!stream.status().ok()) {
+    return report_error("error reading download source object",
+                        stream.status());
+  }
+  return Status();
+}
+#endif  // _WIN32
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
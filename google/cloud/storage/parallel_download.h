@@ -0,0 +1,167 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Create (or truncate) @p file_name and preallocate @p size bytes.
+ *
+ * Reserving the blocks up front avoids filesystem fragmentation when the
+ * shards write their ranges concurrently. On platforms without
+ * `fallocate()`-style calls the file is simply extended to @p size.
+ */
+Status PreallocateFile(std::string const& file_name, std::uintmax_t size);
+
+/**
+ * Write the contents of @p stream to @p file_name starting at @p offset.
+ *
+ * The file must already exist, typically created via `PreallocateFile()`.
+ * Each shard of a parallel download opens its own handle to the destination
+ * file and writes at explicit offsets (via `pwrite()` where available), so
+ * the shards can write their ranges concurrently.
+ */
+Status WriteShardToFile(ObjectReadStream stream, std::string const& file_name,
+                        std::uintmax_t offset, std::size_t buffer_size);
+
+}  // namespace internal
+
+/**
+ * Download a GCS object to a file using multiple parallel streams.
+ *
+ * The object is split into consecutive ranges, each range is downloaded on a
+ * separate stream (and thus a separate connection), and written directly at
+ * its offset in the destination file. A single stream is often limited by
+ * per-connection throughput, downloading large objects through multiple
+ * streams can be significantly faster.
+ *
+ * You can affect how many streams will be created by using the `MaxStreams`
+ * and `MinStreamSize` options. All the streams read the same generation of
+ * the object, so a concurrent overwrite cannot produce a torn file.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the object.
+ * @param object_name the name of the object to be downloaded.
+ * @param file_name the name of the destination file, it is created (or
+ *     truncated) by this function.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `DisableCrc32cChecksum`,
+ *     `DisableMD5Hash`, `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+ *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `MinStreamSize`,
+ *     `UserProject`.
+ *
+ * @return the metadata of the downloaded object.
+ *
+ * @par Idempotency
+ * This operation is read-only and therefore it is always idempotent.
+ */
+template <typename... Options>
+StatusOr<ObjectMetadata> ParallelDownloadFile(
+    Client client, std::string bucket_name, std::string object_name,
+    std::string file_name, Options&&... options) {
+  using internal::Among;
+  using internal::StaticTupleFilter;
+
+  auto metadata_options = StaticTupleFilter<
+      Among<Generation, IfGenerationMatch, IfGenerationNotMatch,
+            IfMetagenerationMatch, IfMetagenerationNotMatch,
+            UserProject>::TPred>(std::tie(options...));
+  auto metadata = google::cloud::internal::apply(
+      internal::GetObjectMetadataApplyHelper{client, bucket_name, object_name},
+      std::move(metadata_options));
+  if (!metadata) {
+    return metadata.status();
+  }
+
+  auto const object_size = static_cast<std::uintmax_t>(metadata->size());
+  auto status = internal::PreallocateFile(file_name, object_size);
+  if (!status.ok()) {
+    return status;
+  }
+  if (object_size == 0) {
+    return *std::move(metadata);
+  }
+
+  // The split point computation depends only on the total size, it applies
+  // to downloads just as well as to uploads.
+  auto file_split_points = internal::ComputeParallelFileUploadSplitPoints(
+      object_size, std::tie(options...));
+  file_split_points.emplace_back(object_size);
+
+  auto read_options = StaticTupleFilter<
+      Among<DisableCrc32cChecksum, DisableMD5Hash, EncryptionKey,
+            UserProject>::TPred>(std::tie(options...));
+  auto const buffer_size =
+      client.raw_client()->client_options().download_buffer_size();
+
+  std::vector<Status> results(file_split_points.size());
+  std::vector<std::thread> threads;
+  threads.reserve(file_split_points.size());
+  std::uintmax_t offset = 0;
+  std::size_t shard_idx = 0;
+  for (auto shard_end : file_split_points) {
+    // Pin the generation so all the shards read the same version of the
+    // object, even if it is overwritten mid-download.
+    auto stream = google::cloud::internal::apply(
+        internal::ReadObjectApplyHelper{client, bucket_name, object_name},
+        std::tuple_cat(
+            read_options,
+            std::make_tuple(Generation(metadata->generation()),
+                            ReadRange(static_cast<std::int64_t>(offset),
+                                      static_cast<std::int64_t>(shard_end)))));
+    auto* result = &results[shard_idx++];
+    threads.emplace_back(
+        [result, file_name, offset, buffer_size](ObjectReadStream stream) {
+          *result = internal::WriteShardToFile(std::move(stream), file_name,
+                                               offset, buffer_size);
+        },
+        std::move(stream));
+    offset = shard_end;
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& result : results) {
+    if (!result.ok()) {
+      return result;
+    }
+  }
+  return *std::move(metadata);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
@@ -0,0 +1,191 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+std::int64_t const kGeneration = 42;
+
+ObjectMetadata MockObject(std::uintmax_t size) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(internal::nl::json{
+      {"kind", "storage#object"},
+      {"bucket", kBucketName},
+      {"name", kObjectName},
+      {"generation", kGeneration},
+      {"size", size}});
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+class ParallelDownloadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+// Serve the range requested via `ReadRange` from `payload`.
+auto create_shard_read_expectation = [](std::string const& payload) {
+  return [payload](ReadObjectRangeRequest const& request) {
+    EXPECT_EQ(kBucketName, request.bucket_name());
+    EXPECT_EQ(kObjectName, request.object_name());
+    EXPECT_TRUE(request.HasOption<Generation>());
+    EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+    EXPECT_TRUE(request.HasOption<ReadRange>());
+    auto range = request.GetOption<ReadRange>().value();
+    EXPECT_LT(range.begin, range.end);
+    EXPECT_LE(static_cast<std::uintmax_t>(range.end), payload.size());
+    auto contents = payload.substr(range.begin, range.end - range.begin);
+    auto source =
+        google::cloud::internal::make_unique<testing::MockObjectReadSource>();
+    EXPECT_CALL(*source, Read(_, _))
+        .WillOnce(Invoke([contents](char* buf, std::size_t n) {
+          EXPECT_GE(n, contents.size());
+          std::memcpy(buf, contents.data(), contents.size());
+          return ReadSourceResult{contents.size(), HttpResponse{200, "", {}}};
+        }))
+        .WillOnce(Return(ReadSourceResult{0, HttpResponse{200, "", {}}}));
+    EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*source, Close())
+        .WillRepeatedly(Return(HttpResponse{200, "", {}}));
+    return StatusOr<std::unique_ptr<ObjectReadSource>>(std::move(source));
+  };
+};
+
+TEST_F(ParallelDownloadTest, ShardedDownload) {
+  std::string payload;
+  for (int i = 0; i != 100; ++i) {
+    payload += "block-" + std::to_string(i) + " ";
+  }
+
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](GetObjectMetadataRequest const& request) {
+        EXPECT_EQ(kBucketName, request.bucket_name());
+        EXPECT_EQ(kObjectName, request.object_name());
+        return make_status_or(MockObject(payload.size()));
+      }));
+  // Expect one `ReadObject()` call per shard, each serving its own range.
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .Times(4)
+      .WillRepeatedly(Invoke(create_shard_read_expectation(payload)));
+
+  testing::TempFile temp_file("");
+  auto actual =
+      ParallelDownloadFile(*client, kBucketName, kObjectName, temp_file.name(),
+                           MaxStreams(4), MinStreamSize(1));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(kGeneration, actual->generation());
+
+  std::ifstream is(temp_file.name(), std::ios::binary);
+  std::string contents{std::istreambuf_iterator<char>{is},
+                       std::istreambuf_iterator<char>{}};
+  EXPECT_EQ(payload, contents);
+}
+
+TEST_F(ParallelDownloadTest, ShardReadFailure) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject(1000))));
+  EXPECT_CALL(*raw_client_mock, ReadObject(_))
+      .WillOnce(Return(
+          StatusOr<std::unique_ptr<ObjectReadSource>>(PermanentError())));
+
+  testing::TempFile temp_file("");
+  auto actual = ParallelDownloadFile(*client, kBucketName, kObjectName,
+                                     temp_file.name());
+  EXPECT_FALSE(actual);
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(ParallelDownloadTest, MetadataFailure) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(
+          StatusOr<ObjectMetadata>(PermanentError())));
+
+  testing::TempFile temp_file("");
+  auto actual = ParallelDownloadFile(*client, kBucketName, kObjectName,
+                                     temp_file.name());
+  EXPECT_FALSE(actual);
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(ParallelDownloadTest, EmptyObject) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject(0))));
+  // No `ReadObject()` calls are expected for an empty object.
+
+  testing::TempFile temp_file("previous contents");
+  auto actual = ParallelDownloadFile(*client, kBucketName, kObjectName,
+                                     temp_file.name());
+  ASSERT_STATUS_OK(actual);
+
+  std::ifstream is(temp_file.name(), std::ios::binary);
+  std::string contents{std::istreambuf_iterator<char>{is},
+                       std::istreambuf_iterator<char>{}};
+  EXPECT_TRUE(contents.empty());
+}
+
+TEST(PreallocateFileTest, ExtendsToRequestedSize) {
+  testing::TempFile temp_file("previous contents");
+
+  ASSERT_STATUS_OK(PreallocateFile(temp_file.name(), 1000));
+
+  std::ifstream is(temp_file.name(), std::ios::binary | std::ios::ate);
+  EXPECT_EQ(1000, is.tellg());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,260 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_listing.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+Status CancelledStatus() {
+  return Status(StatusCode::kCancelled, "parallel listing shut down");
+}
+}  // namespace
+
+ParallelListObjectsReader::ParallelListObjectsReader(
+    Client client, std::string bucket_name, ParallelListingMode mode,
+    std::size_t thread_count, std::string delimiter)
+    : client_(std::move(client)),
+      bucket_name_(std::move(bucket_name)),
+      mode_(mode),
+      delimiter_(std::move(delimiter)),
+      // Keep roughly one page worth of items buffered per shard.
+      max_queue_size_((std::max<std::size_t>)(thread_count, 1) * 1000),
+      pool_((std::max<std::size_t>)(thread_count, 1)) {}
+
+ParallelListObjectsReader::~ParallelListObjectsReader() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  // The thread pool destructor waits for the shards, which observe
+  // `shutdown_` and terminate early.
+}
+
+google::cloud::optional<StatusOr<ObjectMetadata>>
+ParallelListObjectsReader::Next() {
+  if (finished_) {
+    return google::cloud::optional<StatusOr<ObjectMetadata>>{};
+  }
+  if (!started_) {
+    started_ = true;
+    auto status = Start();
+    if (!status.ok()) {
+      finished_ = true;
+      return google::cloud::optional<StatusOr<ObjectMetadata>>(
+          StatusOr<ObjectMetadata>(std::move(status)));
+    }
+  }
+  if (mode_ == ParallelListingMode::kOrdered) {
+    return NextOrdered();
+  }
+  return NextUnordered();
+}
+
+Status ParallelListObjectsReader::Start() {
+  // Probe the bucket with a delimiter to discover the prefixes. The probe
+  // also returns the objects whose names do not contain the delimiter.
+  internal::ListObjectsRequest request(bucket_name_);
+  request.set_multiple_options(Delimiter(delimiter_));
+  std::string page_token;
+  do {
+    request.set_page_token(std::move(page_token));
+    auto response = client_.raw_client()->ListObjects(request);
+    if (!response.ok()) {
+      return std::move(response).status();
+    }
+    // Both `items` and `prefixes` are sorted, and every name in a prefix
+    // starts with that prefix. Merging them by name produces the units in
+    // the order a sequential listing would deliver their contents.
+    auto item = std::make_move_iterator(response->items.begin());
+    auto const item_end = std::make_move_iterator(response->items.end());
+    auto prefix = std::make_move_iterator(response->prefixes.begin());
+    auto const prefix_end = std::make_move_iterator(response->prefixes.end());
+    while (item != item_end || prefix != prefix_end) {
+      Unit unit;
+      if (prefix == prefix_end ||
+          (item != item_end && item->name() < *prefix.base())) {
+        unit.item = *item++;
+      } else {
+        unit.prefix = *prefix++;
+      }
+      units_.push_back(std::move(unit));
+    }
+    page_token = std::move(response->next_page_token);
+  } while (!page_token.empty());
+
+  if (mode_ == ParallelListingMode::kOrdered) {
+    // Start one shard per prefix, the consumer collects their futures in
+    // unit order.
+    for (auto& unit : units_) {
+      if (unit.prefix.empty()) {
+        continue;
+      }
+      auto const& prefix = unit.prefix;
+      auto promise = std::make_shared<
+          std::promise<StatusOr<std::vector<ObjectMetadata>>>>();
+      unit.results = promise->get_future();
+      pool_.Submit(
+          [this, prefix, promise] { promise->set_value(ListPrefix(prefix)); });
+    }
+    return Status();
+  }
+  // In unordered mode the probe results go directly into the queue, and the
+  // shards are started only after the loop, so the queue needs no locking
+  // here.
+  std::vector<std::string> prefixes;
+  for (auto& unit : units_) {
+    if (unit.prefix.empty()) {
+      queue_.push_back(std::move(unit.item));
+    } else {
+      prefixes.push_back(std::move(unit.prefix));
+    }
+  }
+  units_.clear();
+  active_producers_ = prefixes.size();
+  for (auto& prefix : prefixes) {
+    pool_.Submit([this, prefix] { ProducePrefix(prefix); });
+  }
+  return Status();
+}
+
+StatusOr<std::vector<ObjectMetadata>> ParallelListObjectsReader::ListPrefix(
+    std::string const& prefix) {
+  internal::ListObjectsRequest request(bucket_name_);
+  request.set_multiple_options(Prefix(prefix));
+  std::vector<ObjectMetadata> result;
+  std::string page_token;
+  do {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (shutdown_) {
+        return CancelledStatus();
+      }
+    }
+    request.set_page_token(std::move(page_token));
+    auto response = client_.raw_client()->ListObjects(request);
+    if (!response.ok()) {
+      return std::move(response).status();
+    }
+    result.insert(result.end(),
+                  std::make_move_iterator(response->items.begin()),
+                  std::make_move_iterator(response->items.end()));
+    page_token = std::move(response->next_page_token);
+  } while (!page_token.empty());
+  return result;
+}
+
+void ParallelListObjectsReader::ProducePrefix(std::string const& prefix) {
+  internal::ListObjectsRequest request(bucket_name_);
+  request.set_multiple_options(Prefix(prefix));
+  std::string page_token;
+  bool done = false;
+  do {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      done = shutdown_;
+    }
+    if (done) {
+      break;
+    }
+    request.set_page_token(std::move(page_token));
+    auto response = client_.raw_client()->ListObjects(request);
+    if (!response.ok()) {
+      Push(std::move(response).status());
+      break;
+    }
+    for (auto& item : response->items) {
+      if (!Push(std::move(item))) {
+        done = true;
+        break;
+      }
+    }
+    page_token = std::move(response->next_page_token);
+  } while (!done && !page_token.empty());
+  std::unique_lock<std::mutex> lk(mu_);
+  --active_producers_;
+  cv_.notify_all();
+}
+
+bool ParallelListObjectsReader::Push(StatusOr<ObjectMetadata> value) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return shutdown_ || queue_.size() < max_queue_size_;
+  });
+  if (shutdown_) {
+    return false;
+  }
+  queue_.push_back(std::move(value));
+  cv_.notify_all();
+  return true;
+}
+
+google::cloud::optional<StatusOr<ObjectMetadata>>
+ParallelListObjectsReader::NextOrdered() {
+  for (;;) {
+    if (buffer_pos_ != buffer_.size()) {
+      return google::cloud::optional<StatusOr<ObjectMetadata>>(
+          StatusOr<ObjectMetadata>(std::move(buffer_[buffer_pos_++])));
+    }
+    if (current_unit_ == units_.size()) {
+      finished_ = true;
+      return google::cloud::optional<StatusOr<ObjectMetadata>>{};
+    }
+    auto& unit = units_[current_unit_++];
+    if (unit.prefix.empty()) {
+      return google::cloud::optional<StatusOr<ObjectMetadata>>(
+          StatusOr<ObjectMetadata>(std::move(unit.item)));
+    }
+    auto results = unit.results.get();
+    if (!results.ok()) {
+      finished_ = true;
+      // Stop the remaining shards, their results will not be consumed.
+      std::unique_lock<std::mutex> lk(mu_);
+      shutdown_ = true;
+      return google::cloud::optional<StatusOr<ObjectMetadata>>(
+          StatusOr<ObjectMetadata>(std::move(results).status()));
+    }
+    buffer_ = *std::move(results);
+    buffer_pos_ = 0;
+  }
+}
+
+google::cloud::optional<StatusOr<ObjectMetadata>>
+ParallelListObjectsReader::NextUnordered() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk,
+           [this] { return !queue_.empty() || active_producers_ == 0; });
+  if (queue_.empty()) {
+    finished_ = true;
+    return google::cloud::optional<StatusOr<ObjectMetadata>>{};
+  }
+  auto value = std::move(queue_.front());
+  queue_.pop_front();
+  if (!value.ok()) {
+    // Terminate the listing, the shards observe `shutdown_` and exit.
+    finished_ = true;
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  return google::cloud::optional<StatusOr<ObjectMetadata>>(std::move(value));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,153 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LISTING_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LISTING_H_
+
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/// The delivery order for `ParallelListObjectsReader`.
+enum class ParallelListingMode {
+  /// Deliver objects as soon as any shard produces them.
+  kUnordered,
+  /// Deliver objects in lexicographic name order, like `ListObjects()`.
+  kOrdered,
+};
+
+/**
+ * List the objects in a bucket using many concurrent requests.
+ *
+ * A single `ListObjectsReader` fetches pages sequentially, for buckets with
+ * hundreds of millions of objects a full scan takes hours. This class first
+ * probes the bucket with a delimiter-based listing to discover the object
+ * name prefixes, then lists each prefix with its own paginator, running up
+ * to @p thread_count paginators concurrently and merging their results.
+ *
+ * The sharding is a single level deep: objects whose names do not contain
+ * the delimiter are returned from the probe itself, and each prefix is
+ * listed completely (without a delimiter) by one shard. Buckets where most
+ * objects share a single prefix see little benefit.
+ *
+ * In `kUnordered` mode objects are delivered as the shards produce them,
+ * with bounded buffering. In `kOrdered` mode the shards still run
+ * concurrently, but each shard buffers its results until all the preceding
+ * names have been delivered; the additional memory is proportional to the
+ * size of the largest prefixes.
+ *
+ * Example:
+ * @code
+ * ParallelListObjectsReader reader(client, "my-bucket",
+ *                                  ParallelListingMode::kUnordered, 16);
+ * for (auto object = reader.Next(); object.has_value();
+ *      object = reader.Next()) {
+ *   if (!*object) {  // the listing failed.
+ *     std::cerr << "error: " << object->status() << "\n";
+ *     break;
+ *   }
+ *   std::cout << (*object)->name() << "\n";
+ * }
+ * @endcode
+ */
+class ParallelListObjectsReader {
+ public:
+  ParallelListObjectsReader(Client client, std::string bucket_name,
+                            ParallelListingMode mode, std::size_t thread_count,
+                            std::string delimiter = "/");
+
+  /// Stops the shards, discarding any results not consumed yet.
+  ~ParallelListObjectsReader();
+
+  ParallelListObjectsReader(ParallelListObjectsReader const&) = delete;
+  ParallelListObjectsReader& operator=(ParallelListObjectsReader const&) =
+      delete;
+
+  /**
+   * Return the next object in the listing.
+   *
+   * Returns an empty optional when the listing is complete. A failure in
+   * any shard is delivered as an element with an error status, after which
+   * the listing terminates; the results already delivered remain valid.
+   */
+  google::cloud::optional<StatusOr<ObjectMetadata>> Next();
+
+ private:
+  /**
+   * One unit of the merged output, either a single object from the probe or
+   * a prefix listed by a shard.
+   */
+  struct Unit {
+    std::string prefix;
+    ObjectMetadata item;
+    std::future<StatusOr<std::vector<ObjectMetadata>>> results;
+  };
+
+  /// Run the delimiter probe and start the shards, on the first `Next()`.
+  Status Start();
+  /// List the contents of @p prefix, checking for shutdown between pages.
+  StatusOr<std::vector<ObjectMetadata>> ListPrefix(std::string const& prefix);
+  /// Shard body for `kUnordered` mode, pushes into the queue.
+  void ProducePrefix(std::string const& prefix);
+  /// Blocks until there is room in the queue, returns false on shutdown.
+  bool Push(StatusOr<ObjectMetadata> value);
+
+  google::cloud::optional<StatusOr<ObjectMetadata>> NextOrdered();
+  google::cloud::optional<StatusOr<ObjectMetadata>> NextUnordered();
+
+  Client client_;
+  std::string bucket_name_;
+  ParallelListingMode mode_;
+  std::string delimiter_;
+
+  bool started_ = false;
+  bool finished_ = false;
+
+  // State for `kOrdered` mode, only accessed from the consumer.
+  std::vector<Unit> units_;
+  std::size_t current_unit_ = 0;
+  std::vector<ObjectMetadata> buffer_;
+  std::size_t buffer_pos_ = 0;
+
+  // State shared with the shards.
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<StatusOr<ObjectMetadata>> queue_;
+  std::size_t active_producers_ = 0;
+  bool shutdown_ = false;
+  std::size_t max_queue_size_;
+
+  // Destroyed (and therefore drained) first, while the other members are
+  // still valid.
+  internal::ThreadPool pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LISTING_H_
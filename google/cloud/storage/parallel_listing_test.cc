@@ -0,0 +1,183 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_listing.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+using ::testing::UnorderedElementsAreArray;
+
+std::string const kBucketName = "test-bucket";
+
+ObjectMetadata CreateElement(std::string const& name) {
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{{"bucket", kBucketName},
+                                {"name", name},
+                                {"kind", "storage#object"}})
+      .value();
+}
+
+ListObjectsResponse MakeResponse(std::vector<std::string> const& names,
+                                 std::vector<std::string> prefixes) {
+  ListObjectsResponse response;
+  for (auto const& name : names) {
+    response.items.push_back(CreateElement(name));
+  }
+  response.prefixes = std::move(prefixes);
+  return response;
+}
+
+class ParallelListingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(ParallelListingTest, UnorderedDeliversAllObjects) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& request) {
+        if (request.HasOption<Delimiter>()) {
+          EXPECT_EQ("/", request.GetOption<Delimiter>().value());
+          return StatusOr<ListObjectsResponse>(
+              MakeResponse({"root-1"}, {"a/", "b/"}));
+        }
+        auto prefix = request.GetOption<Prefix>().value();
+        return StatusOr<ListObjectsResponse>(MakeResponse(
+            {prefix + "object-1", prefix + "object-2", prefix + "object-3"},
+            {}));
+      }));
+
+  ParallelListObjectsReader reader(*client, kBucketName,
+                                   ParallelListingMode::kUnordered, 2);
+  std::vector<std::string> actual;
+  for (auto object = reader.Next(); object.has_value();
+       object = reader.Next()) {
+    ASSERT_STATUS_OK(*object);
+    actual.push_back((*object)->name());
+  }
+  std::vector<std::string> expected{
+      "root-1",      "a/object-1", "a/object-2", "a/object-3",
+      "b/object-1",  "b/object-2", "b/object-3",
+  };
+  EXPECT_THAT(actual, UnorderedElementsAreArray(expected));
+}
+
+TEST_F(ParallelListingTest, OrderedDeliversInNameOrder) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& request) {
+        if (request.HasOption<Delimiter>()) {
+          return StatusOr<ListObjectsResponse>(
+              MakeResponse({"a.txt", "m.txt"}, {"b/", "z/"}));
+        }
+        auto prefix = request.GetOption<Prefix>().value();
+        if (prefix == "b/") {
+          return StatusOr<ListObjectsResponse>(
+              MakeResponse({"b/1", "b/2"}, {}));
+        }
+        return StatusOr<ListObjectsResponse>(MakeResponse({"z/1"}, {}));
+      }));
+
+  ParallelListObjectsReader reader(*client, kBucketName,
+                                   ParallelListingMode::kOrdered, 2);
+  std::vector<std::string> actual;
+  for (auto object = reader.Next(); object.has_value();
+       object = reader.Next()) {
+    ASSERT_STATUS_OK(*object);
+    actual.push_back((*object)->name());
+  }
+  EXPECT_THAT(actual, ::testing::ElementsAre("a.txt", "b/1", "b/2", "m.txt",
+                                             "z/1"));
+}
+
+TEST_F(ParallelListingTest, ShardFailurePropagates) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& request) {
+        if (request.HasOption<Delimiter>()) {
+          return StatusOr<ListObjectsResponse>(
+              MakeResponse({}, {"good/", "broken/"}));
+        }
+        auto prefix = request.GetOption<Prefix>().value();
+        if (prefix == "broken/") {
+          return StatusOr<ListObjectsResponse>(PermanentError());
+        }
+        return StatusOr<ListObjectsResponse>(
+            MakeResponse({prefix + "object-1"}, {}));
+      }));
+
+  ParallelListObjectsReader reader(*client, kBucketName,
+                                   ParallelListingMode::kOrdered, 2);
+  bool saw_error = false;
+  for (auto object = reader.Next(); object.has_value();
+       object = reader.Next()) {
+    if (!*object) {
+      EXPECT_EQ(PermanentError().code(), object->status().code());
+      saw_error = true;
+    }
+  }
+  EXPECT_TRUE(saw_error);
+}
+
+TEST_F(ParallelListingTest, ProbeFailure) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      }));
+
+  ParallelListObjectsReader reader(*client, kBucketName,
+                                   ParallelListingMode::kUnordered, 2);
+  auto object = reader.Next();
+  ASSERT_TRUE(object.has_value());
+  EXPECT_FALSE(*object);
+  EXPECT_EQ(PermanentError().code(), object->status().code());
+  EXPECT_FALSE(reader.Next().has_value());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
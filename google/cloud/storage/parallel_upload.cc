@@ -13,12 +13,40 @@
 // limitations under the License.
 
 #include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
+#include "google/cloud/storage/internal/openssl_util.h"
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+
+/// Decodes the base64 CRC32C from object metadata, if it is well-formed.
+optional<std::uint32_t> ParseCrc32c(std::string const& base64) {
+  // Four bytes of checksum always encode to exactly 8 base64 characters.
+  if (base64.size() != 8) {
+    return optional<std::uint32_t>();
+  }
+  char const kValidChars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/=";
+  if (base64.find_first_not_of(kValidChars) != std::string::npos) {
+    return optional<std::uint32_t>();
+  }
+  auto bytes = Base64Decode(base64);
+  if (bytes.size() != sizeof(std::uint32_t)) {
+    return optional<std::uint32_t>();
+  }
+  std::uint32_t value = 0;
+  for (auto b : bytes) {
+    value = (value << 8) | b;
+  }
+  return value;
+}
+
+}  // namespace
 
 class ParallelObjectWriteStreambuf : public ObjectWriteStreambuf {
  public:
@@ -26,9 +54,11 @@ class ParallelObjectWriteStreambuf : public ObjectWriteStreambuf {
       std::shared_ptr<ParallelUploadStateImpl> state, std::size_t stream_idx,
       std::unique_ptr<ResumableUploadSession> upload_session,
       std::size_t max_buffer_size,
-      std::unique_ptr<HashValidator> hash_validator)
+      std::unique_ptr<HashValidator> hash_validator,
+      std::shared_ptr<BufferAllocator> buffer_allocator)
       : ObjectWriteStreambuf(std::move(upload_session), max_buffer_size,
-                             std::move(hash_validator)),
+                             std::move(hash_validator), nullptr, false,
+                             std::move(buffer_allocator)),
         state_(std::move(state)),
         stream_idx_(stream_idx) {}
 
@@ -78,15 +108,16 @@ StatusOr<ObjectWriteStream> ParallelUploadStateImpl::CreateStream(
 
   auto idx = streams_.size();
   ++num_unfinished_streams_;
-  streams_.emplace_back(
-      StreamInfo{request.object_name(), (*session)->session_id(), {}, false});
+  streams_.emplace_back(StreamInfo{
+      request.object_name(), (*session)->session_id(), {}, false, {}, 0});
   assert(idx < streams_.size());
   lk.unlock();
   return ObjectWriteStream(
       google::cloud::internal::make_unique<ParallelObjectWriteStreambuf>(
           shared_from_this(), idx, *std::move(session),
           raw_client.client_options().upload_buffer_size(),
-          CreateHashValidator(request)));
+          CreateHashValidator(request),
+          raw_client.client_options().buffer_allocator()));
 }
 
 std::string ParallelUploadPersistentState::ToString() const {
@@ -250,6 +281,17 @@ void ParallelUploadStateImpl::AllStreamsFinished(
     lk.unlock();
     auto res = composer_(to_compose);
     lk.lock();
+    if (res && !res->crc32c().empty()) {
+      // Predict the composed object's checksum from the shard checksums
+      // and verify the service composed exactly the bytes we uploaded.
+      auto expected = ComposedCrc32cExpectation();
+      if (expected && *expected != res->crc32c()) {
+        res = Status(StatusCode::kDataLoss,
+                     "Composed object has mismatched CRC32C checksum,"
+                     " expected=" +
+                         *expected + ", received=" + res->crc32c());
+      }
+    }
     if (res) {
       deleter_->Enable(true);
     }
@@ -264,6 +306,24 @@ void ParallelUploadStateImpl::AllStreamsFinished(
   }
 }
 
+optional<std::string> ParallelUploadStateImpl::ComposedCrc32cExpectation()
+    const {
+  optional<std::uint32_t> crc;
+  for (auto const& stream : streams_) {
+    if (!stream.crc32c) {
+      // Without every shard checksum the composed value cannot be
+      // predicted, e.g. when checksums are disabled for the upload.
+      return optional<std::string>();
+    }
+    crc = crc ? Crc32cCombine(*crc, *stream.crc32c, stream.object_size)
+              : *stream.crc32c;
+  }
+  if (!crc) {
+    return optional<std::string>();
+  }
+  return Base64Encode(google::cloud::internal::EncodeBigEndian(*crc));
+}
+
 void ParallelUploadStateImpl::StreamFinished(
     std::size_t stream_idx, StatusOr<ResumableUploadResponse> const& response) {
   std::unique_lock<std::mutex> lk(mu_);
@@ -285,6 +345,11 @@ void ParallelUploadStateImpl::StreamFinished(
     deleter_->Add(metadata);
     streams_[stream_idx].composition_arg =
         ComposeSourceObject{metadata.name(), metadata.generation(), {}};
+    // The stream's hash validator has already checked this value against
+    // the bytes uploaded by the application, record it to predict the
+    // composed object's checksum.
+    streams_[stream_idx].crc32c = ParseCrc32c(metadata.crc32c());
+    streams_[stream_idx].object_size = metadata.size();
   }
   if (num_unfinished_streams_ > 0) {
     return;
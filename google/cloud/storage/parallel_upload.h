@@ -26,6 +26,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <mutex>
@@ -213,8 +214,21 @@ class ParallelUploadStateImpl
     std::string resumable_session_id;
     optional<ComposeSourceObject> composition_arg;
     bool finished;
+    // The CRC32C checksum and size of the temporary object; used to
+    // predict the composed object's checksum.
+    optional<std::uint32_t> crc32c;
+    std::uint64_t object_size;
   };
 
+  /**
+   * Returns the expected CRC32C of the composed object, base64-encoded.
+   *
+   * Combines the per-shard checksums with crc32c-extend math, without
+   * re-reading any data. Returns an empty optional if the checksum of any
+   * shard is unknown. Requires `mu_` to be held.
+   */
+  optional<std::string> ComposedCrc32cExpectation() const;
+
   mutable std::mutex mu_;
   // Promises made via `WaitForCompletion()`
   mutable std::vector<promise<StatusOr<ObjectMetadata>>> res_promises_;
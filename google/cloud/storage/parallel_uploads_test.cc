@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/crc32c_accelerated.h"
+#include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/parallel_upload.h"
 #include "google/cloud/storage/retry_policy.h"
@@ -92,6 +95,33 @@ ObjectMetadata MockObject(std::string const& object_name, int generation) {
   return *metadata;
 }
 
+/// Like `MockObject()`, but with a well-formed CRC32C checksum and size.
+ObjectMetadata MockObjectWithChecksum(std::string const& object_name,
+                                      int generation,
+                                      std::string const& crc32c,
+                                      std::uintmax_t size) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(internal::nl::json{
+      {"contentType", "application/octet-stream"},
+      {"crc32c", crc32c},
+      {"kind", "storage#object"},
+      {"size", size},
+      {"bucket", kBucketName},
+      {"generation", generation},
+      {"id", ObjectId(kBucketName, object_name, generation)},
+      {"name", object_name}});
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+std::uint32_t Crc32cOf(std::string const& data) {
+  return Crc32cExtend(0, reinterpret_cast<std::uint8_t const*>(data.data()),
+                      data.size());
+}
+
+std::string EncodeCrc32c(std::uint32_t crc) {
+  return Base64Encode(google::cloud::internal::EncodeBigEndian(crc));
+}
+
 class ExpectedDeletions {
  public:
   ExpectedDeletions(std::map<std::pair<std::string, int>, Status> expectations)
@@ -208,9 +238,11 @@ class ParallelUploadTest : public ::testing::Test {
       EXPECT_CALL(res, UploadFinalChunk(_, _))
           .WillOnce(
               Invoke([expected_content, object_name, generation](
-                         std::string const& content, std::uint64_t /*size*/) {
-                EXPECT_EQ(*expected_content, content);
-                EXPECT_EQ(expected_content->size(), content.size());
+                         internal::ConstBufferSequence const& content,
+                         std::uint64_t /*size*/) {
+                EXPECT_EQ(*expected_content, internal::ToString(content));
+                EXPECT_EQ(expected_content->size(),
+                          internal::TotalBytes(content));
                 return make_status_or(
                     ResumableUploadResponse{"fake-url",
                                             0,
@@ -232,6 +264,30 @@ class ParallelUploadTest : public ::testing::Test {
     return res;
   }
 
+  testing::MockResumableUploadSession& ExpectCreateSessionWithMetadata(
+      std::string const& object_name, ObjectMetadata metadata) {
+    auto session = google::cloud::internal::make_unique<
+        testing::MockResumableUploadSession>();
+    auto& res = *session;
+    session_mocks.emplace(std::move(session));
+    using internal::ResumableUploadResponse;
+
+    EXPECT_CALL(res, done()).WillRepeatedly(Return(false));
+    static std::string session_id(kIndividualSessionId);
+    EXPECT_CALL(res, session_id()).WillRepeatedly(ReturnRef(session_id));
+    EXPECT_CALL(res, next_expected_byte()).WillRepeatedly(Return(0));
+    EXPECT_CALL(res, UploadFinalChunk(_, _))
+        .WillOnce(Return(make_status_or(
+            ResumableUploadResponse{"fake-url",
+                                    0,
+                                    std::move(metadata),
+                                    ResumableUploadResponse::kDone,
+                                    {}})));
+    AddNewExpectation(object_name);
+
+    return res;
+  }
+
   testing::MockResumableUploadSession& ExpectCreateSessionToSuspend(
       std::string const& object_name,
       optional<std::string> const& resumable_session_id =
@@ -432,6 +488,130 @@ TEST_F(ParallelUploadTest, Success) {
   EXPECT_STATUS_OK(state->EagerCleanup());
 }
 
+TEST_F(ParallelUploadTest, ComposedCrc32cMatches) {
+  int const num_shards = 3;
+  std::string const contents[] = {"first shard contents", "second shard",
+                                  "third"};
+  auto const full = contents[0] + contents[1] + contents[2];
+  auto const expected_crc32c = EncodeCrc32c(Crc32cOf(full));
+  // The expectations need to be reversed.
+  ExpectCreateSessionWithMetadata(
+      kPrefix + ".upload_shard_2",
+      MockObjectWithChecksum(kPrefix + ".upload_shard_2", 333,
+                             EncodeCrc32c(Crc32cOf(contents[2])),
+                             contents[2].size()));
+  ExpectCreateSessionWithMetadata(
+      kPrefix + ".upload_shard_1",
+      MockObjectWithChecksum(kPrefix + ".upload_shard_1", 222,
+                             EncodeCrc32c(Crc32cOf(contents[1])),
+                             contents[1].size()));
+  ExpectCreateSessionWithMetadata(
+      kPrefix + ".upload_shard_0",
+      MockObjectWithChecksum(kPrefix + ".upload_shard_0", 111,
+                             EncodeCrc32c(Crc32cOf(contents[0])),
+                             contents[0].size()));
+
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke(expect_new_object(kPrefix, kUploadMarkerGeneration)))
+      .WillOnce(Invoke(expect_new_object(kPrefix + ".compose_many",
+                                         kComposeMarkerGeneration)));
+  EXPECT_CALL(*raw_client_mock, ComposeObject(_))
+      .WillOnce(Invoke(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111},
+           {kPrefix + ".upload_shard_1", 222},
+           {kPrefix + ".upload_shard_2", 333}},
+          kDestObjectName,
+          MockObjectWithChecksum(kDestObjectName, kDestGeneration,
+                                 expected_crc32c, full.size()))));
+
+  ExpectedDeletions deletions({{{kPrefix + ".upload_shard_0", 111}, Status()},
+                               {{kPrefix + ".upload_shard_1", 222}, Status()},
+                               {{kPrefix + ".upload_shard_2", 333}, Status()}});
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillOnce(Invoke(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration)))
+      .WillOnce(Invoke([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      }))
+      .WillOnce(Invoke([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      }))
+      .WillOnce(Invoke([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      }))
+      .WillOnce(Invoke(expect_deletion(kPrefix, kUploadMarkerGeneration)));
+
+  auto state = PrepareParallelUpload(*client, kBucketName, kDestObjectName,
+                                     num_shards, kPrefix);
+  EXPECT_STATUS_OK(state);
+  auto res_future = state->WaitForCompletion();
+
+  state->shards().clear();
+  auto res = res_future.get();
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ(expected_crc32c, res->crc32c());
+
+  EXPECT_STATUS_OK(state->EagerCleanup());
+}
+
+TEST_F(ParallelUploadTest, ComposedCrc32cMismatchIsDataLoss) {
+  int const num_shards = 2;
+  std::string const contents[] = {"first shard contents", "second shard"};
+  auto const full = contents[0] + contents[1];
+  // The composed object reports a checksum that cannot result from
+  // composing these shards.
+  auto const wrong_crc32c = EncodeCrc32c(Crc32cOf(full) ^ 1);
+  // The expectations need to be reversed.
+  ExpectCreateSessionWithMetadata(
+      kPrefix + ".upload_shard_1",
+      MockObjectWithChecksum(kPrefix + ".upload_shard_1", 222,
+                             EncodeCrc32c(Crc32cOf(contents[1])),
+                             contents[1].size()));
+  ExpectCreateSessionWithMetadata(
+      kPrefix + ".upload_shard_0",
+      MockObjectWithChecksum(kPrefix + ".upload_shard_0", 111,
+                             EncodeCrc32c(Crc32cOf(contents[0])),
+                             contents[0].size()));
+
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillOnce(Invoke(expect_new_object(kPrefix, kUploadMarkerGeneration)))
+      .WillOnce(Invoke(expect_new_object(kPrefix + ".compose_many",
+                                         kComposeMarkerGeneration)));
+  EXPECT_CALL(*raw_client_mock, ComposeObject(_))
+      .WillOnce(Invoke(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111},
+           {kPrefix + ".upload_shard_1", 222}},
+          kDestObjectName,
+          MockObjectWithChecksum(kDestObjectName, kDestGeneration,
+                                 wrong_crc32c, full.size()))));
+
+  ExpectedDeletions deletions({{{kPrefix + ".upload_shard_0", 111}, Status()},
+                               {{kPrefix + ".upload_shard_1", 222}, Status()}});
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillOnce(Invoke(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration)))
+      .WillOnce(Invoke([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      }))
+      .WillOnce(Invoke([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      }))
+      .WillOnce(Invoke(expect_deletion(kPrefix, kUploadMarkerGeneration)));
+
+  auto state = PrepareParallelUpload(*client, kBucketName, kDestObjectName,
+                                     num_shards, kPrefix);
+  EXPECT_STATUS_OK(state);
+  auto res_future = state->WaitForCompletion();
+
+  state->shards().clear();
+  auto res = res_future.get();
+  ASSERT_FALSE(res);
+  EXPECT_EQ(StatusCode::kDataLoss, res.status().code());
+  EXPECT_THAT(res.status().message(), HasSubstr("mismatched CRC32C"));
+
+  EXPECT_STATUS_OK(state->EagerCleanup());
+}
+
 TEST_F(ParallelUploadTest, OneStreamFailsUponCration) {
   int const num_shards = 3;
   // The expectations need to be reversed.
@@ -0,0 +1,187 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/prefix_deleter.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+// Workers take several targets per queue access to reduce lock contention,
+// the JSON API has no batch-delete endpoint so each target is still one
+// `DeleteObject` request.
+std::size_t constexpr kDeleteBatchSize = 32;
+}  // namespace
+
+std::size_t constexpr PrefixDeleter::kMaxRecordedFailures;
+
+PrefixDeleter::PrefixDeleter(Client client, std::size_t delete_thread_count,
+                             std::size_t listing_thread_count)
+    : client_(std::move(client)),
+      // Keep roughly one page worth of targets buffered per worker.
+      max_queue_size_((std::max<std::size_t>)(delete_thread_count, 1) * 1000),
+      lister_pool_((std::max<std::size_t>)(listing_thread_count, 1)),
+      delete_pool_((std::max<std::size_t>)(delete_thread_count, 1)) {}
+
+DeleteByPrefixReport PrefixDeleter::Run(std::string const& bucket_name,
+                                        std::string const& prefix) {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    queue_.clear();
+    listing_done_ = false;
+    listed_ = 0;
+    report_ = DeleteByPrefixReport{};
+    active_workers_ = delete_pool_.thread_count();
+  }
+  for (std::size_t i = 0; i != delete_pool_.thread_count(); ++i) {
+    delete_pool_.Submit([this, bucket_name] { DeleteWorker(bucket_name); });
+  }
+
+  // Probe the prefix with a delimiter: the probe items are enqueued
+  // directly, and each sub-prefix becomes a listing shard. Deletes start
+  // with the first probe page, the listing and the deletes overlap.
+  internal::ListObjectsRequest request(bucket_name);
+  request.set_multiple_options(Prefix(prefix), Delimiter("/"),
+                               Projection::NoAcl());
+  std::string page_token;
+  do {
+    request.set_page_token(std::move(page_token));
+    auto response = client_.raw_client()->ListObjects(request);
+    if (!response.ok()) {
+      RecordListingError(std::move(response).status());
+      break;
+    }
+    std::vector<Target> targets;
+    targets.reserve(response->items.size());
+    for (auto& item : response->items) {
+      targets.push_back(Target{item.name(), item.generation()});
+    }
+    Enqueue(std::move(targets));
+    for (auto& sub_prefix : response->prefixes) {
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        ++active_listers_;
+      }
+      std::string p = std::move(sub_prefix);
+      lister_pool_.Submit(
+          [this, bucket_name, p] { ListShard(bucket_name, p); });
+    }
+    page_token = std::move(response->next_page_token);
+  } while (!page_token.empty());
+
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return active_listers_ == 0; });
+  listing_done_ = true;
+  cv_.notify_all();
+  cv_.wait(lk, [this] { return active_workers_ == 0; });
+  DeleteByPrefixReport report = std::move(report_);
+  report_ = DeleteByPrefixReport{};
+  return report;
+}
+
+DeleteByPrefixProgress PrefixDeleter::Progress() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return DeleteByPrefixProgress{listed_, report_.deleted, report_.failed,
+                                listing_done_};
+}
+
+void PrefixDeleter::ListShard(std::string const& bucket_name,
+                              std::string const& prefix) {
+  internal::ListObjectsRequest request(bucket_name);
+  request.set_multiple_options(Prefix(prefix), Projection::NoAcl());
+  std::string page_token;
+  do {
+    request.set_page_token(std::move(page_token));
+    auto response = client_.raw_client()->ListObjects(request);
+    if (!response.ok()) {
+      RecordListingError(std::move(response).status());
+      break;
+    }
+    std::vector<Target> targets;
+    targets.reserve(response->items.size());
+    for (auto& item : response->items) {
+      targets.push_back(Target{item.name(), item.generation()});
+    }
+    Enqueue(std::move(targets));
+    page_token = std::move(response->next_page_token);
+  } while (!page_token.empty());
+  std::unique_lock<std::mutex> lk(mu_);
+  --active_listers_;
+  cv_.notify_all();
+}
+
+void PrefixDeleter::DeleteWorker(std::string const& bucket_name) {
+  std::vector<Target> batch;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk, [this] { return !queue_.empty() || listing_done_; });
+      if (queue_.empty()) {
+        break;
+      }
+      while (!queue_.empty() && batch.size() < kDeleteBatchSize) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      // Wake the listers blocked on a full queue.
+      cv_.notify_all();
+    }
+    for (auto& target : batch) {
+      auto status = client_.DeleteObject(bucket_name, target.name,
+                                         IfGenerationMatch(target.generation));
+      std::unique_lock<std::mutex> lk(mu_);
+      if (status.ok()) {
+        ++report_.deleted;
+      } else {
+        RecordFailure(std::move(target.name), std::move(status));
+      }
+    }
+    batch.clear();
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  --active_workers_;
+  cv_.notify_all();
+}
+
+void PrefixDeleter::Enqueue(std::vector<Target> targets) {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& target : targets) {
+    cv_.wait(lk, [this] { return queue_.size() < max_queue_size_; });
+    queue_.push_back(std::move(target));
+    ++listed_;
+    cv_.notify_all();
+  }
+}
+
+// Requires that the caller holds `mu_`.
+void PrefixDeleter::RecordFailure(std::string name, Status status) {
+  ++report_.failed;
+  if (report_.failures.size() < kMaxRecordedFailures) {
+    report_.failures.emplace_back(std::move(name), std::move(status));
+  }
+}
+
+void PrefixDeleter::RecordListingError(Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (report_.listing_status.ok()) {
+    report_.listing_status = std::move(status);
+  }
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,164 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PREFIX_DELETER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PREFIX_DELETER_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/// A point-in-time snapshot of a `PrefixDeleter::Run()` in progress.
+struct DeleteByPrefixProgress {
+  /// The number of objects discovered by the listing so far.
+  std::uint64_t listed;
+  /// The number of objects deleted successfully so far.
+  std::uint64_t deleted;
+  /// The number of delete requests that failed so far.
+  std::uint64_t failed;
+  /// True once all the listing shards have completed.
+  bool listing_done;
+};
+
+/// The outcome of a `PrefixDeleter::Run()` call.
+struct DeleteByPrefixReport {
+  /// The number of objects deleted successfully.
+  std::uint64_t deleted = 0;
+  /// The number of delete requests that failed.
+  std::uint64_t failed = 0;
+  /**
+   * The name and final status of the failed deletes.
+   *
+   * At most `PrefixDeleter::kMaxRecordedFailures` entries are kept, the
+   * remaining failures are only counted in `failed`.
+   */
+  std::vector<std::pair<std::string, Status>> failures;
+  /// The first error reported by the listing, if any. Objects listed before
+  /// the error are still deleted.
+  Status listing_status;
+};
+
+/**
+ * Delete all the objects under a prefix using many concurrent requests.
+ *
+ * `DeleteByPrefix()` iterates a single `ListObjectsReader` and issues one
+ * synchronous delete per object, for prefixes with millions of objects the
+ * cleanup takes hours. This class pipelines the two phases: a delimiter
+ * probe under the prefix discovers the sub-prefixes, each sub-prefix is
+ * listed by its own shard, and the discovered objects flow through a
+ * bounded queue to a pool of delete workers. Deletes start as soon as the
+ * first listing page arrives, and the queue applies backpressure so memory
+ * stays bounded no matter how far the listing runs ahead.
+ *
+ * Each delete is conditioned with `IfGenerationMatch()` on the listed
+ * generation, objects overwritten after they were listed are left alone
+ * (and reported as failures with `kFailedPrecondition`).
+ *
+ * Only one `Run()` may be active at a time. `Progress()` may be called
+ * concurrently with `Run()`, e.g. from a reporting thread.
+ *
+ * @par Example
+ * @code
+ * storage::PrefixDeleter deleter(client, 64);
+ * auto report = deleter.Run("my-bucket", "scratch/");
+ * std::cout << "deleted " << report.deleted << " objects\n";
+ * for (auto const& f : report.failures) {
+ *   std::cerr << f.first << ": " << f.second << "\n";
+ * }
+ * @endcode
+ */
+class PrefixDeleter {
+ public:
+  /// Failures recorded with their name and status in the report, see
+  /// `DeleteByPrefixReport::failures`.
+  static std::size_t constexpr kMaxRecordedFailures = 1000;
+
+  /**
+   * @param client the client used for both listing and deleting.
+   * @param delete_thread_count the number of delete workers, and therefore
+   *     the maximum number of concurrent `DeleteObject` calls.
+   * @param listing_thread_count the maximum number of concurrent listing
+   *     shards.
+   */
+  explicit PrefixDeleter(Client client, std::size_t delete_thread_count,
+                         std::size_t listing_thread_count = 4);
+
+  PrefixDeleter(PrefixDeleter const&) = delete;
+  PrefixDeleter& operator=(PrefixDeleter const&) = delete;
+
+  /**
+   * Delete the objects in @p bucket_name whose names start with @p prefix.
+   *
+   * Blocks until the listing completes and all the discovered objects have
+   * been deleted (or their delete has failed).
+   */
+  DeleteByPrefixReport Run(std::string const& bucket_name,
+                           std::string const& prefix);
+
+  /// The progress of the currently running (or last completed) `Run()`.
+  DeleteByPrefixProgress Progress() const;
+
+ private:
+  /// An object discovered by the listing, waiting to be deleted.
+  struct Target {
+    std::string name;
+    std::int64_t generation;
+  };
+
+  /// List the contents of @p prefix and enqueue them for deletion.
+  void ListShard(std::string const& bucket_name, std::string const& prefix);
+  /// Drain the queue, deleting objects, until the listing completes.
+  void DeleteWorker(std::string const& bucket_name);
+  /// Blocks until there is room in the queue, then adds @p targets.
+  void Enqueue(std::vector<Target> targets);
+  void RecordFailure(std::string name, Status status);
+  void RecordListingError(Status status);
+
+  Client client_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Target> queue_;             // GUARDED_BY(mu_)
+  std::size_t max_queue_size_;
+  std::size_t active_listers_ = 0;       // GUARDED_BY(mu_)
+  std::size_t active_workers_ = 0;       // GUARDED_BY(mu_)
+  bool listing_done_ = false;            // GUARDED_BY(mu_)
+  std::uint64_t listed_ = 0;             // GUARDED_BY(mu_)
+  DeleteByPrefixReport report_;          // GUARDED_BY(mu_)
+
+  // Declared last so they are destroyed (and drained) first, their tasks
+  // reference the other members.
+  internal::ThreadPool lister_pool_;
+  internal::ThreadPool delete_pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PREFIX_DELETER_H
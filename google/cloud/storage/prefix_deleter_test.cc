@@ -0,0 +1,172 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/prefix_deleter.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::DeleteObjectRequest;
+using ::google::cloud::storage::internal::EmptyResponse;
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+using ::testing::UnorderedElementsAreArray;
+
+std::string const kBucketName = "test-bucket";
+
+ObjectMetadata CreateElement(std::string const& name) {
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{{"bucket", kBucketName},
+                                {"name", name},
+                                {"generation", 7},
+                                {"kind", "storage#object"}})
+      .value();
+}
+
+ListObjectsResponse MakeResponse(std::vector<std::string> const& names,
+                                 std::vector<std::string> prefixes) {
+  ListObjectsResponse response;
+  for (auto const& name : names) {
+    response.items.push_back(CreateElement(name));
+  }
+  response.prefixes = std::move(prefixes);
+  return response;
+}
+
+class PrefixDeleterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(PrefixDeleterTest, DeletesAllObjectsUnderPrefix) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& request) {
+        EXPECT_TRUE(request.HasOption<Prefix>());
+        if (request.HasOption<Delimiter>()) {
+          EXPECT_EQ("scratch/", request.GetOption<Prefix>().value());
+          return StatusOr<ListObjectsResponse>(MakeResponse(
+              {"scratch/root"}, {"scratch/a/", "scratch/b/"}));
+        }
+        auto prefix = request.GetOption<Prefix>().value();
+        return StatusOr<ListObjectsResponse>(
+            MakeResponse({prefix + "object-1", prefix + "object-2"}, {}));
+      }));
+  std::mutex mu;
+  std::vector<std::string> deleted;
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillRepeatedly(Invoke([&](DeleteObjectRequest const& request) {
+        EXPECT_TRUE(request.HasOption<IfGenerationMatch>());
+        EXPECT_EQ(7, request.GetOption<IfGenerationMatch>().value());
+        std::unique_lock<std::mutex> lk(mu);
+        deleted.push_back(request.object_name());
+        return StatusOr<EmptyResponse>(EmptyResponse{});
+      }));
+
+  PrefixDeleter deleter(*client, 4, 2);
+  auto report = deleter.Run(kBucketName, "scratch/");
+  EXPECT_EQ(5, report.deleted);
+  EXPECT_EQ(0, report.failed);
+  EXPECT_TRUE(report.failures.empty());
+  ASSERT_STATUS_OK(report.listing_status);
+  std::vector<std::string> expected{
+      "scratch/root",       "scratch/a/object-1", "scratch/a/object-2",
+      "scratch/b/object-1", "scratch/b/object-2",
+  };
+  EXPECT_THAT(deleted, UnorderedElementsAreArray(expected));
+
+  auto progress = deleter.Progress();
+  EXPECT_TRUE(progress.listing_done);
+  EXPECT_EQ(5, progress.listed);
+}
+
+TEST_F(PrefixDeleterTest, FailedDeletesAreReported) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(
+            MakeResponse({"p/keep", "p/gone"}, {}));
+      }));
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillRepeatedly(Invoke([](DeleteObjectRequest const& request) {
+        if (request.object_name() == "p/keep") {
+          return StatusOr<EmptyResponse>(PermanentError());
+        }
+        return StatusOr<EmptyResponse>(EmptyResponse{});
+      }));
+
+  PrefixDeleter deleter(*client, 2);
+  auto report = deleter.Run(kBucketName, "p/");
+  EXPECT_EQ(1, report.deleted);
+  EXPECT_EQ(1, report.failed);
+  ASSERT_EQ(1U, report.failures.size());
+  EXPECT_EQ("p/keep", report.failures[0].first);
+  EXPECT_EQ(PermanentError().code(), report.failures[0].second.code());
+}
+
+TEST_F(PrefixDeleterTest, ListingErrorsAreReported) {
+  EXPECT_CALL(*raw_client_mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& request) {
+        if (request.HasOption<Delimiter>()) {
+          return StatusOr<ListObjectsResponse>(
+              MakeResponse({"p/root"}, {"p/broken/"}));
+        }
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      }));
+  EXPECT_CALL(*raw_client_mock, DeleteObject(_))
+      .WillRepeatedly(Invoke([](DeleteObjectRequest const&) {
+        return StatusOr<EmptyResponse>(EmptyResponse{});
+      }));
+
+  PrefixDeleter deleter(*client, 2);
+  auto report = deleter.Run(kBucketName, "p/");
+  // The objects listed before the error are still deleted.
+  EXPECT_EQ(1, report.deleted);
+  EXPECT_EQ(PermanentError().code(), report.listing_status.code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
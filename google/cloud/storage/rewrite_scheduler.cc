@@ -0,0 +1,79 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/rewrite_scheduler.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+std::future<StatusOr<ObjectMetadata>> RewriteScheduler::Schedule(
+    ObjectRewriter rewriter) {
+  auto entry = std::make_shared<Entry>(std::move(rewriter));
+  auto future = entry->promise.get_future();
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    entries_.push_back(entry);
+  }
+  pool_.Submit([this, entry] { Step(entry); });
+  return future;
+}
+
+AggregateRewriteProgress RewriteScheduler::Progress() const {
+  AggregateRewriteProgress aggregate{0, 0, 0, 0, 0};
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& entry : entries_) {
+    aggregate.total_bytes_rewritten += entry->progress.total_bytes_rewritten;
+    aggregate.total_object_size += entry->progress.object_size;
+    if (entry->failed) {
+      ++aggregate.failed;
+    } else if (entry->progress.done) {
+      ++aggregate.completed;
+    } else {
+      ++aggregate.pending;
+    }
+  }
+  return aggregate;
+}
+
+void RewriteScheduler::Step(std::shared_ptr<Entry> const& entry) {
+  // Only one task at a time references `entry->rewriter`, no locking needed
+  // for the iteration itself.
+  auto progress = entry->rewriter.Iterate();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!progress) {
+    entry->progress.done = true;
+    entry->failed = true;
+    lk.unlock();
+    entry->promise.set_value(std::move(progress).status());
+    return;
+  }
+  entry->progress = *progress;
+  if (progress->done) {
+    lk.unlock();
+    // The rewrite already completed, `Result()` returns without blocking.
+    entry->promise.set_value(entry->rewriter.Result());
+    return;
+  }
+  lk.unlock();
+  // Requeue at the back so all the rewrites advance at a similar pace.
+  auto shared = entry;
+  pool_.Submit([this, shared] { Step(shared); });
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_SCHEDULER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_SCHEDULER_H
+
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/object_rewriter.h"
+#include "google/cloud/storage/version.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * The combined progress of all the rewrites in a `RewriteScheduler`.
+ */
+struct AggregateRewriteProgress {
+  /// The sum of the bytes rewritten across all the scheduled rewrites.
+  std::uint64_t total_bytes_rewritten;
+  /// The sum of the source object sizes, as reported by the service. This is
+  /// zero for rewrites that have not performed their first iteration.
+  std::uint64_t total_object_size;
+  /// The number of rewrites that have not completed.
+  std::size_t pending;
+  /// The number of rewrites that completed successfully.
+  std::size_t completed;
+  /// The number of rewrites that completed with an error.
+  std::size_t failed;
+};
+
+/**
+ * Drive many object rewrites concurrently over a bounded set of connections.
+ *
+ * `ObjectRewriter::Result()` drives a single rewrite to completion,
+ * synchronously. Large migrations (e.g. copying a bucket across regions)
+ * have millions of rewrites in flight, and dedicating a thread to each is
+ * not feasible. This class multiplexes any number of in-progress rewrites
+ * over a fixed number of threads (and thus connections): each scheduled
+ * rewrite joins a FIFO queue, the worker threads repeatedly take the
+ * rewrite at the head of the queue, perform one `Iterate()` call, and
+ * requeue it unless it completed. This round-robin keeps all the rewrites
+ * advancing at a similar pace.
+ *
+ * @par Example
+ * @code
+ * storage::RewriteScheduler scheduler(16);
+ * std::vector<std::future<StatusOr<ObjectMetadata>>> results;
+ * for (auto const& name : object_names) {
+ *   results.push_back(scheduler.Schedule(
+ *       client.RewriteObject("src", name, "dst", name)));
+ * }
+ * // ... poll scheduler.Progress() to report progress ...
+ * for (auto& r : results) { auto metadata = r.get(); }
+ * @endcode
+ */
+class RewriteScheduler {
+ public:
+  /// @param max_connections the number of worker threads, and therefore the
+  ///     maximum number of concurrent `RewriteObject` calls.
+  explicit RewriteScheduler(std::size_t max_connections)
+      : pool_(max_connections) {}
+
+  /// Blocks until all the scheduled rewrites have completed.
+  ~RewriteScheduler() = default;
+
+  RewriteScheduler(RewriteScheduler const&) = delete;
+  RewriteScheduler& operator=(RewriteScheduler const&) = delete;
+
+  /**
+   * Add a rewrite to the scheduler.
+   *
+   * @param rewriter a rewrite operation, typically the result of
+   *     `Client::RewriteObject()` or `Client::ResumeRewriteObject()`.
+   *
+   * @return a future satisfied when the rewrite completes, with the metadata
+   *     of the newly created object, or with the error that terminated the
+   *     rewrite.
+   */
+  std::future<StatusOr<ObjectMetadata>> Schedule(ObjectRewriter rewriter);
+
+  /// The combined progress of all the rewrites scheduled so far.
+  AggregateRewriteProgress Progress() const;
+
+ private:
+  struct Entry {
+    explicit Entry(ObjectRewriter r) : rewriter(std::move(r)) {}
+
+    ObjectRewriter rewriter;
+    RewriteProgress progress{0, 0, false};  // GUARDED_BY(mu_)
+    bool failed = false;                    // GUARDED_BY(mu_)
+    std::promise<StatusOr<ObjectMetadata>> promise;
+  };
+
+  /// Perform one iteration of @p entry, requeue it if it did not complete.
+  void Step(std::shared_ptr<Entry> const& entry);
+
+  mutable std::mutex mu_;
+  std::vector<std::shared_ptr<Entry>> entries_;  // GUARDED_BY(mu_)
+
+  // Declared last so it is destroyed (and drained) first, the queued tasks
+  // reference the other members.
+  internal::ThreadPool pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_SCHEDULER_H
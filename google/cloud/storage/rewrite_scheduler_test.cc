@@ -0,0 +1,162 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/rewrite_scheduler.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <map>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+ObjectMetadata MockObject(std::string const& object_name) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(
+      internal::nl::json{{"name", object_name}});
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+internal::RewriteObjectRequest MakeRequest(std::string const& object_name) {
+  return internal::RewriteObjectRequest("source-bucket", object_name,
+                                        "destination-bucket", object_name,
+                                        "");
+}
+
+/// @test Verify that many rewrites complete over a few worker threads.
+TEST(RewriteSchedulerTest, ManyRewritesFewConnections) {
+  int const object_count = 32;
+  std::uint64_t const object_size = 3000;
+
+  auto mock = std::make_shared<testing::MockClient>();
+  // Each rewrite takes 3 iterations, rewriting 1000 bytes per call. The
+  // rewrite token encodes the progress, as it would in the service.
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .Times(3 * object_count)
+      .WillRepeatedly(
+          Invoke([&](internal::RewriteObjectRequest const& request) {
+            std::uint64_t rewritten = 1000;
+            if (request.rewrite_token() == "token-1000") {
+              rewritten = 2000;
+            } else if (request.rewrite_token() == "token-2000") {
+              rewritten = 3000;
+            } else {
+              EXPECT_EQ("", request.rewrite_token());
+            }
+            internal::RewriteObjectResponse response;
+            response.total_bytes_rewritten = rewritten;
+            response.object_size = object_size;
+            response.done = rewritten == object_size;
+            response.rewrite_token =
+                response.done ? "" : "token-" + std::to_string(rewritten);
+            if (response.done) {
+              response.resource = MockObject(request.destination_object());
+            }
+            return make_status_or(response);
+          }));
+
+  RewriteScheduler scheduler(4);
+  std::map<std::string, std::future<StatusOr<ObjectMetadata>>> results;
+  for (int i = 0; i != object_count; ++i) {
+    auto name = "object-" + std::to_string(i);
+    results.emplace(
+        name, scheduler.Schedule(ObjectRewriter(mock, MakeRequest(name))));
+  }
+  for (auto& kv : results) {
+    auto metadata = kv.second.get();
+    ASSERT_STATUS_OK(metadata);
+    EXPECT_EQ(kv.first, metadata->name());
+  }
+
+  auto progress = scheduler.Progress();
+  EXPECT_EQ(object_count * object_size, progress.total_bytes_rewritten);
+  EXPECT_EQ(object_count * object_size, progress.total_object_size);
+  EXPECT_EQ(0U, progress.pending);
+  EXPECT_EQ(static_cast<std::size_t>(object_count), progress.completed);
+  EXPECT_EQ(0U, progress.failed);
+}
+
+/// @test Verify that a failed rewrite does not affect the others.
+TEST(RewriteSchedulerTest, PartialFailure) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .WillRepeatedly(
+          Invoke([](internal::RewriteObjectRequest const& request)
+                     -> StatusOr<internal::RewriteObjectResponse> {
+            if (request.source_object() == "broken-object") {
+              return PermanentError();
+            }
+            internal::RewriteObjectResponse response;
+            response.total_bytes_rewritten = 100;
+            response.object_size = 100;
+            response.done = true;
+            response.resource = MockObject(request.destination_object());
+            return make_status_or(response);
+          }));
+
+  RewriteScheduler scheduler(2);
+  auto good =
+      scheduler.Schedule(ObjectRewriter(mock, MakeRequest("good-object")));
+  auto bad =
+      scheduler.Schedule(ObjectRewriter(mock, MakeRequest("broken-object")));
+
+  auto good_result = good.get();
+  ASSERT_STATUS_OK(good_result);
+  EXPECT_EQ("good-object", good_result->name());
+
+  auto bad_result = bad.get();
+  EXPECT_FALSE(bad_result);
+  EXPECT_EQ(PermanentError().code(), bad_result.status().code());
+
+  auto progress = scheduler.Progress();
+  EXPECT_EQ(1U, progress.completed);
+  EXPECT_EQ(1U, progress.failed);
+  EXPECT_EQ(0U, progress.pending);
+}
+
+/// @test Verify that the destructor waits for the scheduled rewrites.
+TEST(RewriteSchedulerTest, DestructorDrains) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .WillRepeatedly(Invoke([](internal::RewriteObjectRequest const&) {
+        internal::RewriteObjectResponse response;
+        response.total_bytes_rewritten = 10;
+        response.object_size = 10;
+        response.done = true;
+        return make_status_or(response);
+      }));
+
+  std::future<StatusOr<ObjectMetadata>> result;
+  {
+    RewriteScheduler scheduler(1);
+    result = scheduler.Schedule(ObjectRewriter(mock, MakeRequest("object")));
+  }
+  // The scheduler is gone, the future must be satisfied already.
+  ASSERT_STATUS_OK(result.get());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -17,41 +17,55 @@
 """Automatically generated source lists for storage_client - DO NOT EDIT."""
 
 storage_client_hdrs = [
+    "appendable_object_writer.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
+    "buffer_allocator.h",
     "client.h",
     "client_options.h",
     "download_options.h",
     "hashing_options.h",
+    "hedging_policy.h",
     "hmac_key_metadata.h",
     "iam_policy.h",
     "idempotency_policy.h",
     "internal/access_control_common.h",
+    "internal/adaptive_throttler.h",
+    "internal/async_hash_validator.h",
+    "internal/batch_request.h",
     "internal/binary_data_as_debug_string.h",
+    "internal/bounded_mpmc_queue.h",
     "internal/bucket_acl_requests.h",
+    "internal/bucket_metadata_cache_client.h",
     "internal/bucket_requests.h",
     "internal/common_metadata.h",
     "internal/complex_option.h",
     "internal/compute_engine_util.h",
+    "internal/const_buffer.h",
+    "internal/crc32c_accelerated.h",
     "internal/curl_client.h",
     "internal/curl_download_request.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
+    "internal/curl_header_arena.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
     "internal/curl_resumable_upload_session.h",
     "internal/curl_wrappers.h",
     "internal/default_object_acl_requests.h",
+    "internal/download_memory_budget.h",
     "internal/empty_response.h",
     "internal/generate_message_boundary.h",
     "internal/generic_object_request.h",
     "internal/generic_request.h",
+    "internal/gzip_compressor.h",
     "internal/hash_validator.h",
     "internal/hash_validator_impl.h",
     "internal/hmac_key_requests.h",
     "internal/http_response.h",
     "internal/logging_client.h",
     "internal/logging_resumable_upload_session.h",
+    "internal/mapped_file_region.h",
     "internal/metadata_parser.h",
     "internal/nljson.h",
     "internal/notification_requests.h",
@@ -60,12 +74,16 @@ storage_client_hdrs = [
     "internal/object_requests.h",
     "internal/object_streambuf.h",
     "internal/openssl_util.h",
+    "internal/operation_metrics.h",
     "internal/parameter_pack_validation.h",
     "internal/patch_builder.h",
     "internal/policy_document_request.h",
+    "internal/pool_statistics.h",
     "internal/range_from_pagination.h",
     "internal/raw_client.h",
     "internal/raw_client_wrapper_utils.h",
+    "internal/received_headers.h",
+    "internal/recycling_pool.h",
     "internal/resumable_upload_session.h",
     "internal/retry_client.h",
     "internal/retry_object_read_source.h",
@@ -74,7 +92,12 @@ storage_client_hdrs = [
     "internal/sha256_hash.h",
     "internal/sign_blob_requests.h",
     "internal/signed_url_requests.h",
+    "internal/single_shot_upload_session.h",
+    "internal/thread_pool.h",
+    "internal/trace_ring_buffer.h",
+    "internal/tracing_client.h",
     "internal/tuple_filter.h",
+    "internal/upload_checkpoint.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
     "list_hmac_keys_reader.h",
@@ -92,16 +115,25 @@ storage_client_hdrs = [
     "oauth2/refreshing_credentials_wrapper.h",
     "oauth2/service_account_credentials.h",
     "object_access_control.h",
+    "object_content_cache.h",
     "object_metadata.h",
+    "object_metadata_batcher.h",
+    "object_read_session.h",
     "object_rewriter.h",
     "object_stream.h",
     "override_default_project.h",
+    "parallel_download.h",
+    "parallel_listing.h",
     "parallel_upload.h",
     "policy_document.h",
+    "prefix_deleter.h",
     "retry_policy.h",
+    "rewrite_scheduler.h",
     "service_account.h",
     "signed_url_options.h",
     "storage_class.h",
+    "transfer_manager.h",
+    "transfer_timeouts.h",
     "upload_options.h",
     "version.h",
     "version_info.h",
@@ -110,8 +142,10 @@ storage_client_hdrs = [
 ]
 
 storage_client_srcs = [
+    "appendable_object_writer.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
+    "buffer_allocator.cc",
     "client.cc",
     "client_options.cc",
     "hashing_options.cc",
@@ -119,33 +153,45 @@ storage_client_srcs = [
     "iam_policy.cc",
     "idempotency_policy.cc",
     "internal/access_control_common.cc",
+    "internal/adaptive_throttler.cc",
+    "internal/async_hash_validator.cc",
+    "internal/batch_request.cc",
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_acl_requests.cc",
+    "internal/bucket_metadata_cache_client.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
+    "internal/crc32c_accelerated.cc",
     "internal/curl_client.cc",
     "internal/curl_download_request.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
+    "internal/curl_header_arena.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
     "internal/curl_resumable_upload_session.cc",
     "internal/curl_wrappers.cc",
     "internal/default_object_acl_requests.cc",
+    "internal/download_memory_budget.cc",
     "internal/empty_response.cc",
+    "internal/gzip_compressor.cc",
     "internal/hash_validator.cc",
     "internal/hash_validator_impl.cc",
     "internal/hmac_key_requests.cc",
     "internal/http_response.cc",
     "internal/logging_client.cc",
     "internal/logging_resumable_upload_session.cc",
+    "internal/mapped_file_region.cc",
     "internal/metadata_parser.cc",
     "internal/notification_requests.cc",
     "internal/object_acl_requests.cc",
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
     "internal/openssl_util.cc",
+    "internal/operation_metrics.cc",
     "internal/policy_document_request.cc",
+    "internal/raw_client.cc",
+    "internal/received_headers.cc",
     "internal/resumable_upload_session.cc",
     "internal/retry_client.cc",
     "internal/retry_object_read_source.cc",
@@ -154,6 +200,11 @@ storage_client_srcs = [
     "internal/sha256_hash.cc",
     "internal/sign_blob_requests.cc",
     "internal/signed_url_requests.cc",
+    "internal/single_shot_upload_session.cc",
+    "internal/thread_pool.cc",
+    "internal/trace_ring_buffer.cc",
+    "internal/tracing_client.cc",
+    "internal/upload_checkpoint.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
     "list_hmac_keys_reader.cc",
@@ -168,12 +219,21 @@ storage_client_srcs = [
     "oauth2/refreshing_credentials_wrapper.cc",
     "oauth2/service_account_credentials.cc",
     "object_access_control.cc",
+    "object_content_cache.cc",
     "object_metadata.cc",
+    "object_metadata_batcher.cc",
+    "object_read_session.cc",
     "object_rewriter.cc",
     "object_stream.cc",
+    "parallel_download.cc",
+    "parallel_listing.cc",
     "parallel_upload.cc",
     "policy_document.cc",
+    "prefix_deleter.cc",
+    "rewrite_scheduler.cc",
     "service_account.cc",
+    "transfer_manager.cc",
+    "transfer_timeouts.cc",
     "version.cc",
     "well_known_headers.cc",
 ]
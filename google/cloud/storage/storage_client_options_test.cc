@@ -180,6 +180,84 @@ TEST_F(ClientOptionsTest, SetMaximumSocketSendSize) {
   EXPECT_EQ(16 * 1024, client_options.maximum_socket_send_size());
 }
 
+TEST_F(ClientOptionsTest, SetEnableHttp2Multiplexing) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  auto default_value = client_options.enable_http2_multiplexing();
+  EXPECT_FALSE(default_value);
+  client_options.set_enable_http2_multiplexing(true);
+  EXPECT_TRUE(client_options.enable_http2_multiplexing());
+  client_options.set_enable_http2_multiplexing(false);
+  EXPECT_FALSE(client_options.enable_http2_multiplexing());
+}
+
+TEST_F(ClientOptionsTest, SetTransferBufferSize) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.transfer_buffer_size());
+  client_options.set_transfer_buffer_size(256 * 1024);
+  EXPECT_EQ(256 * 1024, client_options.transfer_buffer_size());
+  EXPECT_FALSE(client_options.enable_adaptive_buffer_size());
+  client_options.set_enable_adaptive_buffer_size(true);
+  EXPECT_TRUE(client_options.enable_adaptive_buffer_size());
+}
+
+TEST_F(ClientOptionsTest, SetDownloadBufferWatermarks) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.download_buffer_low_watermark());
+  EXPECT_EQ(0, client_options.download_buffer_high_watermark());
+  client_options.set_download_buffer_watermarks(64 * 1024, 256 * 1024);
+  EXPECT_EQ(64 * 1024, client_options.download_buffer_low_watermark());
+  EXPECT_EQ(256 * 1024, client_options.download_buffer_high_watermark());
+}
+
+TEST_F(ClientOptionsTest, SetMaximumDownloadBufferMemory) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.maximum_download_buffer_memory());
+  client_options.set_maximum_download_buffer_memory(64 * 1024 * 1024);
+  EXPECT_EQ(64 * 1024 * 1024, client_options.maximum_download_buffer_memory());
+}
+
+TEST_F(ClientOptionsTest, SetHappyEyeballsTimeout) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.happy_eyeballs_timeout().count());
+  client_options.set_happy_eyeballs_timeout(std::chrono::milliseconds(50));
+  EXPECT_EQ(50, client_options.happy_eyeballs_timeout().count());
+}
+
+TEST_F(ClientOptionsTest, SetEnableEndpointPreResolution) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.enable_endpoint_pre_resolution());
+  client_options.set_enable_endpoint_pre_resolution(true);
+  EXPECT_TRUE(client_options.enable_endpoint_pre_resolution());
+}
+
+TEST_F(ClientOptionsTest, SetTransport) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ("curl", client_options.transport());
+  client_options.set_transport("grpc");
+  EXPECT_EQ("grpc", client_options.transport());
+}
+
+TEST_F(ClientOptionsTest, SetBucketMetadataCacheTtl) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.bucket_metadata_cache_ttl().count());
+  client_options.set_bucket_metadata_cache_ttl(std::chrono::seconds(300));
+  EXPECT_EQ(300, client_options.bucket_metadata_cache_ttl().count());
+}
+
+TEST_F(ClientOptionsTest, SetPreferXmlDataOperations) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.prefer_xml_data_operations());
+  client_options.set_prefer_xml_data_operations(true);
+  EXPECT_TRUE(client_options.prefer_xml_data_operations());
+}
+
+TEST_F(ClientOptionsTest, SetDefaultFields) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_TRUE(client_options.default_fields().empty());
+  client_options.set_default_fields("bucket,name,generation,size");
+  EXPECT_EQ("bucket,name,generation,size", client_options.default_fields());
+}
+
 TEST_F(ClientOptionsTest, SetMaximumDownloadStall) {
   ClientOptions client_options(oauth2::CreateAnonymousCredentials());
   auto default_value = client_options.download_stall_timeout();
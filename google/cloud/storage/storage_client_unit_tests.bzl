@@ -17,9 +17,11 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_client_unit_tests = [
+    "appendable_object_writer_test.cc",
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "buffer_allocator_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
     "client_notifications_test.cc",
@@ -34,27 +36,39 @@ storage_client_unit_tests = [
     "hmac_key_metadata_test.cc",
     "idempotency_policy_test.cc",
     "internal/access_control_common_test.cc",
+    "internal/adaptive_throttler_test.cc",
+    "internal/async_hash_validator_test.cc",
+    "internal/batch_request_test.cc",
     "internal/binary_data_as_debug_string_test.cc",
+    "internal/bounded_mpmc_queue_test.cc",
     "internal/bucket_acl_requests_test.cc",
+    "internal/bucket_metadata_cache_client_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/compute_engine_util_test.cc",
+    "internal/const_buffer_test.cc",
+    "internal/crc32c_accelerated_test.cc",
     "internal/curl_client_test.cc",
     "internal/curl_handle_factory_test.cc",
     "internal/curl_handle_test.cc",
+    "internal/curl_header_arena_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
     "internal/curl_wrappers_disable_sigpipe_handler_test.cc",
     "internal/curl_wrappers_enable_sigpipe_handler_test.cc",
     "internal/curl_wrappers_locking_already_present_test.cc",
     "internal/curl_wrappers_locking_disabled_test.cc",
     "internal/curl_wrappers_locking_enabled_test.cc",
+    "internal/curl_wrappers_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/download_memory_budget_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
+    "internal/gzip_compressor_test.cc",
     "internal/hash_validator_test.cc",
     "internal/hmac_key_requests_test.cc",
     "internal/http_response_test.cc",
     "internal/logging_client_test.cc",
     "internal/logging_resumable_upload_session_test.cc",
+    "internal/mapped_file_region_test.cc",
     "internal/metadata_parser_test.cc",
     "internal/nljson_use_after_third_party_test.cc",
     "internal/nljson_use_third_party_test.cc",
@@ -63,9 +77,12 @@ storage_client_unit_tests = [
     "internal/object_requests_test.cc",
     "internal/object_streambuf_test.cc",
     "internal/openssl_util_test.cc",
+    "internal/operation_metrics_test.cc",
     "internal/parameter_pack_validation_test.cc",
     "internal/patch_builder_test.cc",
     "internal/policy_document_request_test.cc",
+    "internal/received_headers_test.cc",
+    "internal/recycling_pool_test.cc",
     "internal/resumable_upload_session_test.cc",
     "internal/retry_client_test.cc",
     "internal/retry_object_read_source_test.cc",
@@ -74,7 +91,12 @@ storage_client_unit_tests = [
     "internal/sha256_hash_test.cc",
     "internal/sign_blob_requests_test.cc",
     "internal/signed_url_requests_test.cc",
+    "internal/single_shot_upload_session_test.cc",
+    "internal/thread_pool_test.cc",
+    "internal/trace_ring_buffer_test.cc",
+    "internal/tracing_client_test.cc",
     "internal/tuple_filter_test.cc",
+    "internal/upload_checkpoint_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
     "list_hmac_keys_reader_test.cc",
@@ -85,19 +107,28 @@ storage_client_unit_tests = [
     "oauth2/compute_engine_credentials_test.cc",
     "oauth2/google_application_default_credentials_file_test.cc",
     "oauth2/google_credentials_test.cc",
+    "oauth2/refreshing_credentials_wrapper_test.cc",
     "oauth2/service_account_credentials_test.cc",
     "object_access_control_test.cc",
+    "object_content_cache_test.cc",
+    "object_metadata_batcher_test.cc",
     "object_metadata_test.cc",
+    "object_read_session_test.cc",
     "object_stream_test.cc",
     "object_test.cc",
+    "parallel_downloads_test.cc",
+    "parallel_listing_test.cc",
     "parallel_uploads_test.cc",
     "policy_document_test.cc",
+    "prefix_deleter_test.cc",
     "retry_policy_test.cc",
+    "rewrite_scheduler_test.cc",
     "service_account_test.cc",
     "signed_url_options_test.cc",
     "storage_class_test.cc",
     "storage_client_options_test.cc",
     "storage_iam_policy_test.cc",
     "storage_version_test.cc",
+    "transfer_manager_test.cc",
     "well_known_headers_test.cc",
 ]
@@ -0,0 +1,368 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/transfer_manager.h"
+#include "google/cloud/internal/filesystem.h"
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+// Files at least this large are transferred in shards by default.
+auto constexpr kDefaultShardedTransferThreshold =
+    std::uintmax_t(128) * 1024 * 1024;
+// The default target size of each shard.
+auto constexpr kDefaultShardSize = std::uintmax_t(32) * 1024 * 1024;
+
+std::size_t DefaultThreadCount() {
+  auto const count = std::thread::hardware_concurrency();
+  return count == 0 ? 4 : static_cast<std::size_t>(count);
+}
+}  // namespace
+
+std::size_t constexpr TransferManager::kMaxRecordedFailures;
+
+TransferManagerOptions::TransferManagerOptions()
+    : thread_count_(DefaultThreadCount()),
+      sharded_transfer_threshold_(kDefaultShardedTransferThreshold),
+      shard_size_(kDefaultShardSize),
+      bandwidth_budget_(0),
+      temporary_prefix_(".gcs-cpp-transfer"),
+      ignore_cleanup_failures_(false) {}
+
+TransferManager::TransferManager(Client client, TransferManagerOptions options)
+    : client_(std::move(client)),
+      options_(std::move(options)),
+      last_refill_(std::chrono::steady_clock::now()),
+      worker_pool_((std::max<std::size_t>)(options_.thread_count(), 1)) {
+  options_.set_shard_size((std::max<std::uintmax_t>)(options_.shard_size(), 1));
+}
+
+TransferReport TransferManager::UploadMany(
+    std::vector<TransferRequest> const& requests) {
+  ResetJobState(requests.size());
+  for (auto const& request : requests) {
+    auto const file_status = google::cloud::internal::status(request.file_name);
+    if (!google::cloud::internal::is_regular(file_status)) {
+      std::ostringstream os;
+      os << "UploadMany(" << request.file_name
+         << "): not a regular file, cannot upload";
+      CompleteFile(request.file_name, 0,
+                   Status(StatusCode::kNotFound, std::move(os).str()));
+      continue;
+    }
+    auto const size = google::cloud::internal::file_size(request.file_name);
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      bytes_total_ += size;
+    }
+    if (size < options_.sharded_transfer_threshold()) {
+      auto req = request;
+      EnqueueSmall([this, req, size] {
+        AcquireBandwidth(size);
+        // `UploadFile()` picks between a single-shot and a resumable
+        // upload based on the configured simple upload limit.
+        auto metadata = client_.UploadFile(req.file_name, req.bucket_name,
+                                           req.object_name);
+        CompleteFile(req.file_name, metadata ? size : 0,
+                     std::move(metadata).status());
+      });
+      continue;
+    }
+    auto req = request;
+    EnqueueLarge([this, req, size] { ShardedUpload(req, size); });
+  }
+  return RunJob();
+}
+
+TransferReport TransferManager::DownloadMany(
+    std::vector<TransferRequest> const& requests) {
+  ResetJobState(requests.size());
+  for (auto const& request : requests) {
+    // An object's size is only known once its metadata arrives, so the
+    // small-vs-sharded choice is made by the task itself.
+    auto req = request;
+    EnqueueSmall([this, req] { Download(req); });
+  }
+  return RunJob();
+}
+
+TransferProgress TransferManager::Progress() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return TransferProgress{files_total_, report_.completed, report_.failed,
+                          bytes_total_, bytes_transferred_};
+}
+
+void TransferManager::ResetJobState(std::uint64_t files_total) {
+  std::unique_lock<std::mutex> lk(mu_);
+  small_queue_.clear();
+  large_queue_.clear();
+  tasks_in_flight_ = 0;
+  files_total_ = files_total;
+  bytes_total_ = 0;
+  bytes_transferred_ = 0;
+  report_ = TransferReport{};
+}
+
+TransferReport TransferManager::RunJob() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    active_workers_ = worker_pool_.thread_count();
+  }
+  for (std::size_t i = 0; i != worker_pool_.thread_count(); ++i) {
+    // Alternate the queue preference so both queues make progress even
+    // when the workers never need to steal.
+    bool const prefer_small = i % 2 == 0;
+    worker_pool_.Submit([this, prefer_small] { Worker(prefer_small); });
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return active_workers_ == 0; });
+  TransferReport report = std::move(report_);
+  report_ = TransferReport{};
+  return report;
+}
+
+void TransferManager::Worker(bool prefer_small) {
+  for (;;) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      // Running tasks may still schedule more work (e.g. the shards of a
+      // large file), so an empty pair of queues only ends the job when
+      // nothing is in flight either.
+      cv_.wait(lk, [this] {
+        return !small_queue_.empty() || !large_queue_.empty() ||
+               tasks_in_flight_ == 0;
+      });
+      auto& primary = prefer_small ? small_queue_ : large_queue_;
+      auto& secondary = prefer_small ? large_queue_ : small_queue_;
+      if (!primary.empty()) {
+        task = std::move(primary.front());
+        primary.pop_front();
+      } else if (!secondary.empty()) {
+        // Steal from the back, the front is the other workers' hot end.
+        task = std::move(secondary.back());
+        secondary.pop_back();
+      } else {
+        break;
+      }
+      ++tasks_in_flight_;
+    }
+    task();
+    std::unique_lock<std::mutex> lk(mu_);
+    --tasks_in_flight_;
+    cv_.notify_all();
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  --active_workers_;
+  cv_.notify_all();
+}
+
+void TransferManager::EnqueueSmall(Task task) {
+  std::unique_lock<std::mutex> lk(mu_);
+  small_queue_.push_back(std::move(task));
+  cv_.notify_all();
+}
+
+void TransferManager::EnqueueLarge(Task task) {
+  std::unique_lock<std::mutex> lk(mu_);
+  large_queue_.push_back(std::move(task));
+  cv_.notify_all();
+}
+
+void TransferManager::Download(TransferRequest const& request) {
+  auto metadata = client_.GetObjectMetadata(request.bucket_name,
+                                            request.object_name);
+  if (!metadata) {
+    CompleteFile(request.object_name, 0, std::move(metadata).status());
+    return;
+  }
+  auto const size = static_cast<std::uint64_t>(metadata->size());
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    bytes_total_ += size;
+  }
+  if (size < options_.sharded_transfer_threshold()) {
+    AcquireBandwidth(size);
+    auto status = client_.DownloadToFile(request.bucket_name,
+                                         request.object_name,
+                                         request.file_name,
+                                         Generation(metadata->generation()));
+    CompleteFile(request.object_name, status.ok() ? size : 0,
+                 std::move(status));
+    return;
+  }
+  ShardedDownload(request, *metadata);
+}
+
+void TransferManager::ShardedUpload(TransferRequest const& request,
+                                    std::uintmax_t file_size) {
+  auto const shard_size = options_.shard_size();
+  auto const max_streams =
+      static_cast<std::size_t>(file_size / shard_size) + 1;
+  auto shards = internal::CreateUploadShards(
+      client_, request.file_name, request.bucket_name, request.object_name,
+      options_.temporary_prefix(), MaxStreams(max_streams),
+      MinStreamSize(shard_size));
+  if (!shards) {
+    CompleteFile(request.file_name, 0, std::move(shards).status());
+    return;
+  }
+  struct ShardedUploadState {
+    std::vector<ParallelUploadFileShard> shards;
+    std::atomic<std::size_t> remaining;
+  };
+  auto state = std::make_shared<ShardedUploadState>();
+  state->shards = *std::move(shards);
+  state->remaining.store(state->shards.size());
+  auto const per_shard =
+      static_cast<std::uint64_t>(file_size) / state->shards.size();
+  auto const file_name = request.file_name;
+  bool const ignore_cleanup = options_.ignore_cleanup_failures();
+  auto const bytes = static_cast<std::uint64_t>(file_size);
+  for (std::size_t i = 0; i != state->shards.size(); ++i) {
+    EnqueueLarge([this, state, i, per_shard, file_name, bytes,
+                  ignore_cleanup] {
+      AcquireBandwidth(per_shard);
+      // Individual shard failures surface through `WaitForCompletion()`.
+      state->shards[i].Upload();
+      if (state->remaining.fetch_sub(1) != 1) {
+        return;
+      }
+      // This was the last shard, the completion future is already
+      // satisfied; compose the shards and clean up the temporaries.
+      auto metadata = state->shards[0].WaitForCompletion().get();
+      auto cleanup = state->shards[0].EagerCleanup();
+      if (metadata && !cleanup.ok() && !ignore_cleanup) {
+        CompleteFile(file_name, 0, std::move(cleanup));
+        return;
+      }
+      CompleteFile(file_name, metadata ? bytes : 0,
+                   std::move(metadata).status());
+    });
+  }
+}
+
+void TransferManager::ShardedDownload(TransferRequest const& request,
+                                      ObjectMetadata const& metadata) {
+  auto const object_size = static_cast<std::uintmax_t>(metadata.size());
+  auto status = internal::PreallocateFile(request.file_name, object_size);
+  if (!status.ok()) {
+    CompleteFile(request.object_name, 0, std::move(status));
+    return;
+  }
+  struct ShardedDownloadState {
+    std::atomic<std::size_t> remaining;
+    std::mutex mu;
+    Status status;
+  };
+  auto const shard_size = options_.shard_size();
+  auto const shard_count =
+      static_cast<std::size_t>((object_size + shard_size - 1) / shard_size);
+  auto state = std::make_shared<ShardedDownloadState>();
+  state->remaining.store(shard_count);
+  auto const buffer_size =
+      client_.raw_client()->client_options().download_buffer_size();
+  auto const generation = metadata.generation();
+  auto const bytes = static_cast<std::uint64_t>(object_size);
+  auto const req = request;
+  for (std::uintmax_t begin = 0; begin < object_size; begin += shard_size) {
+    auto const end = (std::min)(begin + shard_size, object_size);
+    EnqueueLarge([this, state, req, generation, begin, end, buffer_size,
+                  bytes] {
+      AcquireBandwidth(end - begin);
+      // Pin the generation so all the shards read the same version of the
+      // object, even if it is overwritten mid-download.
+      auto stream = client_.ReadObject(
+          req.bucket_name, req.object_name, Generation(generation),
+          ReadRange(static_cast<std::int64_t>(begin),
+                    static_cast<std::int64_t>(end)));
+      auto shard_status = internal::WriteShardToFile(
+          std::move(stream), req.file_name, begin, buffer_size);
+      {
+        std::unique_lock<std::mutex> lk(state->mu);
+        if (!shard_status.ok() && state->status.ok()) {
+          state->status = std::move(shard_status);
+        }
+      }
+      if (state->remaining.fetch_sub(1) != 1) {
+        return;
+      }
+      Status final_status;
+      {
+        std::unique_lock<std::mutex> lk(state->mu);
+        final_status = std::move(state->status);
+      }
+      CompleteFile(req.object_name, final_status.ok() ? bytes : 0,
+                   std::move(final_status));
+    });
+  }
+}
+
+void TransferManager::CompleteFile(std::string const& name,
+                                   std::uint64_t bytes, Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (status.ok()) {
+    ++report_.completed;
+    bytes_transferred_ += bytes;
+    return;
+  }
+  ++report_.failed;
+  if (report_.failures.size() < kMaxRecordedFailures) {
+    report_.failures.emplace_back(name, std::move(status));
+  }
+}
+
+void TransferManager::AcquireBandwidth(std::uint64_t bytes) {
+  auto const budget = options_.bandwidth_budget();
+  if (budget == 0 || bytes == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lk(throttle_mu_);
+  for (;;) {
+    auto const now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> const elapsed = now - last_refill_;
+    last_refill_ = now;
+    // A classic token bucket with a one second burst capacity.
+    tokens_ = (std::min)(
+        tokens_ + elapsed.count() * static_cast<double>(budget),
+        static_cast<double>(budget));
+    if (tokens_ > 0) {
+      // Let the balance go negative so transfers larger than one second's
+      // budget still proceed, they just delay the next acquisition.
+      tokens_ -= static_cast<double>(bytes);
+      return;
+    }
+    auto const wait = std::chrono::duration<double>(
+        -tokens_ / static_cast<double>(budget));
+    // Nothing signals this condition variable, the timeout drives the
+    // refill on the next loop iteration.
+    throttle_cv_.wait_for(
+        lk,
+        std::chrono::duration_cast<std::chrono::milliseconds>(wait) +
+            std::chrono::milliseconds(1));
+  }
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,287 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_MANAGER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_MANAGER_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/thread_pool.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/// One file of a `TransferManager` job.
+struct TransferRequest {
+  /// The local file, the source for uploads and the destination for
+  /// downloads.
+  std::string file_name;
+  std::string bucket_name;
+  std::string object_name;
+};
+
+/// A point-in-time snapshot of a `TransferManager` job in progress.
+struct TransferProgress {
+  /// The number of files in the job.
+  std::uint64_t files_total;
+  /// The number of files transferred successfully so far.
+  std::uint64_t files_completed;
+  /// The number of files that failed so far.
+  std::uint64_t files_failed;
+  /**
+   * The total number of bytes in the job.
+   *
+   * For uploads this is known when the job starts; for downloads each
+   * object's size is added as its metadata is fetched, so the value grows
+   * while the job runs.
+   */
+  std::uint64_t bytes_total;
+  /// The number of bytes belonging to successfully transferred files.
+  std::uint64_t bytes_transferred;
+};
+
+/// The outcome of a `TransferManager` job.
+struct TransferReport {
+  /// The number of files transferred successfully.
+  std::uint64_t completed = 0;
+  /// The number of files that failed.
+  std::uint64_t failed = 0;
+  /**
+   * The name and final status of the failed transfers.
+   *
+   * The name is the local file name for uploads and the object name for
+   * downloads. At most `TransferManager::kMaxRecordedFailures` entries are
+   * kept, the remaining failures are only counted in `failed`.
+   */
+  std::vector<std::pair<std::string, Status>> failures;
+};
+
+/// Configuration for `TransferManager`.
+class TransferManagerOptions {
+ public:
+  TransferManagerOptions();
+
+  /// The number of worker threads, and therefore the maximum number of
+  /// concurrent transfers (counting each shard of a large file separately).
+  std::size_t thread_count() const { return thread_count_; }
+  TransferManagerOptions& set_thread_count(std::size_t v) {
+    thread_count_ = v;
+    return *this;
+  }
+
+  /**
+   * Files at least this large are transferred in shards.
+   *
+   * Smaller files use one request per file: uploads pick between a
+   * single-shot and a resumable upload based on
+   * `ClientOptions::maximum_simple_upload_size()`, downloads use a single
+   * stream. Larger files are split into shards of roughly `shard_size()`
+   * bytes, each shard is scheduled as its own unit of work.
+   */
+  std::uintmax_t sharded_transfer_threshold() const {
+    return sharded_transfer_threshold_;
+  }
+  TransferManagerOptions& set_sharded_transfer_threshold(std::uintmax_t v) {
+    sharded_transfer_threshold_ = v;
+    return *this;
+  }
+
+  /// The target size of each shard of a sharded transfer.
+  std::uintmax_t shard_size() const { return shard_size_; }
+  TransferManagerOptions& set_shard_size(std::uintmax_t v) {
+    shard_size_ = v;
+    return *this;
+  }
+
+  /**
+   * Limit the job to roughly this many bytes per second, 0 is unlimited.
+   *
+   * The budget is enforced with a token bucket at the granularity of whole
+   * files (or shards): a transfer starts only when the job's recent usage
+   * is below the budget. It bounds sustained throughput, it does not shape
+   * traffic within a single request.
+   */
+  std::uint64_t bandwidth_budget() const { return bandwidth_budget_; }
+  TransferManagerOptions& set_bandwidth_budget(std::uint64_t v) {
+    bandwidth_budget_ = v;
+    return *this;
+  }
+
+  /// The prefix for the temporary objects created by sharded uploads, see
+  /// `ParallelUploadFile()`.
+  std::string const& temporary_prefix() const { return temporary_prefix_; }
+  TransferManagerOptions& set_temporary_prefix(std::string v) {
+    temporary_prefix_ = std::move(v);
+    return *this;
+  }
+
+  /// Treat failures to clean up the temporary objects of a sharded upload
+  /// as not fatal.
+  bool ignore_cleanup_failures() const { return ignore_cleanup_failures_; }
+  TransferManagerOptions& set_ignore_cleanup_failures(bool v) {
+    ignore_cleanup_failures_ = v;
+    return *this;
+  }
+
+ private:
+  std::size_t thread_count_;
+  std::uintmax_t sharded_transfer_threshold_;
+  std::uintmax_t shard_size_;
+  std::uint64_t bandwidth_budget_;
+  std::string temporary_prefix_;
+  bool ignore_cleanup_failures_;
+};
+
+/**
+ * Transfer whole sets of files with global scheduling.
+ *
+ * Moving a directory tree of thousands of files through per-file calls to
+ * `Client::UploadFile()` or `Client::DownloadToFile()` forces the
+ * application to hand-roll a thread pool, and a fixed files-per-thread
+ * split balances badly when the set mixes many small files with a few huge
+ * ones. This class schedules a whole file set over one pool of workers:
+ *
+ * - Each file picks its transfer method by size: small files use a single
+ *   request, large files are split into shards (reusing the machinery
+ *   behind `ParallelUploadFile()` and `ParallelDownloadFile()`), and each
+ *   shard is an independent unit of work.
+ * - Small files and shards of large files wait in separate queues; half
+ *   the workers prefer each queue and steal from the other when their own
+ *   is empty, so neither many-small-files nor few-huge-files can starve
+ *   the other.
+ * - An optional bandwidth budget bounds the job's sustained throughput,
+ *   see `TransferManagerOptions::set_bandwidth_budget()`.
+ *
+ * Only one job (`UploadMany()` or `DownloadMany()`) may be active at a
+ * time. `Progress()` may be called concurrently with a job, e.g. from a
+ * reporting thread.
+ *
+ * @par Example
+ * @code
+ * storage::TransferManager manager(client);
+ * std::vector<storage::TransferRequest> files = ...;
+ * auto report = manager.UploadMany(files);
+ * std::cout << "uploaded " << report.completed << " files\n";
+ * for (auto const& f : report.failures) {
+ *   std::cerr << f.first << ": " << f.second << "\n";
+ * }
+ * @endcode
+ */
+class TransferManager {
+ public:
+  /// Failures recorded with their name and status in the report, see
+  /// `TransferReport::failures`.
+  static std::size_t constexpr kMaxRecordedFailures = 1000;
+
+  explicit TransferManager(
+      Client client, TransferManagerOptions options = TransferManagerOptions());
+
+  TransferManager(TransferManager const&) = delete;
+  TransferManager& operator=(TransferManager const&) = delete;
+
+  /**
+   * Upload all the files in @p requests.
+   *
+   * Blocks until every file has been uploaded (or its upload has failed).
+   * Files that cannot be read are reported as failures without stopping
+   * the rest of the job.
+   */
+  TransferReport UploadMany(std::vector<TransferRequest> const& requests);
+
+  /**
+   * Download all the objects in @p requests.
+   *
+   * Blocks until every object has been downloaded (or its download has
+   * failed). Each download is pinned to the generation observed when its
+   * metadata was fetched, so concurrent overwrites cannot produce a torn
+   * file.
+   */
+  TransferReport DownloadMany(std::vector<TransferRequest> const& requests);
+
+  /// The progress of the currently running (or last completed) job.
+  TransferProgress Progress() const;
+
+ private:
+  using Task = std::function<void()>;
+
+  /// Reset the per-job state, @p files_total files are about to start.
+  void ResetJobState(std::uint64_t files_total);
+  /// Start the workers, wait for the job to drain, and collect the report.
+  TransferReport RunJob();
+  /// The worker loop, preferring one queue and stealing from the other.
+  void Worker(bool prefer_small);
+
+  void EnqueueSmall(Task task);
+  void EnqueueLarge(Task task);
+
+  /// Fetch the object's metadata and download it, sharding large objects.
+  void Download(TransferRequest const& request);
+  /// Create the upload shards for one large file and schedule them.
+  void ShardedUpload(TransferRequest const& request,
+                     std::uintmax_t file_size);
+  /// Schedule the ranged downloads for one large object.
+  void ShardedDownload(TransferRequest const& request,
+                       ObjectMetadata const& metadata);
+
+  /// Record the outcome of one file, @p bytes is 0 for failed transfers.
+  void CompleteFile(std::string const& name, std::uint64_t bytes,
+                    Status status);
+
+  /// Block until the bandwidth budget admits @p bytes more bytes.
+  void AcquireBandwidth(std::uint64_t bytes);
+
+  Client client_;
+  TransferManagerOptions options_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Task> small_queue_;         // GUARDED_BY(mu_)
+  std::deque<Task> large_queue_;         // GUARDED_BY(mu_)
+  std::size_t tasks_in_flight_ = 0;      // GUARDED_BY(mu_)
+  std::size_t active_workers_ = 0;       // GUARDED_BY(mu_)
+  std::uint64_t files_total_ = 0;        // GUARDED_BY(mu_)
+  std::uint64_t bytes_total_ = 0;        // GUARDED_BY(mu_)
+  std::uint64_t bytes_transferred_ = 0;  // GUARDED_BY(mu_)
+  TransferReport report_;                // GUARDED_BY(mu_)
+
+  /// The token bucket behind `AcquireBandwidth()`, under its own lock so
+  /// throttled workers do not block `Progress()` or the queues.
+  std::mutex throttle_mu_;
+  std::condition_variable throttle_cv_;
+  double tokens_ = 0;                               // GUARDED_BY(throttle_mu_)
+  std::chrono::steady_clock::time_point last_refill_;  // GUARDED_BY(...)
+
+  // Declared last so it is destroyed (and drained) first, its tasks
+  // reference the other members.
+  internal::ThreadPool worker_pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_MANAGER_H
@@ -0,0 +1,139 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/transfer_manager.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::GetObjectMetadataRequest;
+using ::google::cloud::storage::internal::InsertObjectMediaRequest;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+
+ObjectMetadata MakeObject(std::string const& name) {
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{{"bucket", kBucketName},
+                                {"name", name},
+                                {"generation", 7},
+                                {"kind", "storage#object"}})
+      .value();
+}
+
+class TransferManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client.reset();
+    raw_client_mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(TransferManagerTest, UploadsSmallFiles) {
+  testing::TempFile file_1("contents-1");
+  testing::TempFile file_2("longer contents-2");
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillRepeatedly(Invoke([](InsertObjectMediaRequest const& request) {
+        EXPECT_EQ(kBucketName, request.bucket_name());
+        return StatusOr<ObjectMetadata>(MakeObject(request.object_name()));
+      }));
+
+  TransferManager manager(*client,
+                          TransferManagerOptions().set_thread_count(4));
+  auto report = manager.UploadMany(
+      {TransferRequest{file_1.name(), kBucketName, "object-1"},
+       TransferRequest{file_2.name(), kBucketName, "object-2"}});
+  EXPECT_EQ(2, report.completed);
+  EXPECT_EQ(0, report.failed);
+  EXPECT_TRUE(report.failures.empty());
+
+  auto progress = manager.Progress();
+  EXPECT_EQ(2, progress.files_total);
+  EXPECT_EQ(2, progress.files_completed);
+  auto const expected_bytes =
+      std::uint64_t(std::string("contents-1").size() +
+                    std::string("longer contents-2").size());
+  EXPECT_EQ(expected_bytes, progress.bytes_total);
+  EXPECT_EQ(expected_bytes, progress.bytes_transferred);
+}
+
+TEST_F(TransferManagerTest, MissingFilesDontStopTheJob) {
+  testing::TempFile file_1("contents-1");
+  EXPECT_CALL(*raw_client_mock, InsertObjectMedia(_))
+      .WillRepeatedly(Invoke([](InsertObjectMediaRequest const& request) {
+        return StatusOr<ObjectMetadata>(MakeObject(request.object_name()));
+      }));
+
+  TransferManager manager(*client,
+                          TransferManagerOptions().set_thread_count(2));
+  auto report = manager.UploadMany(
+      {TransferRequest{"/no/such/file", kBucketName, "object-1"},
+       TransferRequest{file_1.name(), kBucketName, "object-2"}});
+  EXPECT_EQ(1, report.completed);
+  EXPECT_EQ(1, report.failed);
+  ASSERT_EQ(1U, report.failures.size());
+  EXPECT_EQ("/no/such/file", report.failures[0].first);
+  EXPECT_EQ(StatusCode::kNotFound, report.failures[0].second.code());
+}
+
+TEST_F(TransferManagerTest, DownloadMetadataErrorsAreReported) {
+  EXPECT_CALL(*raw_client_mock, GetObjectMetadata(_))
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const&) {
+        return StatusOr<ObjectMetadata>(PermanentError());
+      }));
+
+  TransferManager manager(*client,
+                          TransferManagerOptions().set_thread_count(2));
+  auto report = manager.DownloadMany(
+      {TransferRequest{"/tmp/ignored", kBucketName, "broken-object"}});
+  EXPECT_EQ(0, report.completed);
+  EXPECT_EQ(1, report.failed);
+  ASSERT_EQ(1U, report.failures.size());
+  EXPECT_EQ("broken-object", report.failures[0].first);
+  EXPECT_EQ(PermanentError().code(), report.failures[0].second.code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
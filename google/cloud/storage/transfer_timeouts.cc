@@ -0,0 +1,54 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/transfer_timeouts.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+template <typename Option, typename Rep, typename Period>
+std::ostream& StreamDuration(
+    std::ostream& os,
+    internal::ComplexOption<Option, std::chrono::duration<Rep, Period>> const&
+        rhs,
+    char const* suffix) {
+  if (rhs.has_value()) {
+    return os << rhs.option_name() << "=" << rhs.value().count() << suffix;
+  }
+  return os << rhs.option_name() << "=<not set>";
+}
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, ConnectTimeout const& rhs) {
+  return StreamDuration(os, rhs, "ms");
+}
+
+std::ostream& operator<<(std::ostream& os, TransferStallTimeout const& rhs) {
+  return StreamDuration(os, rhs, "s");
+}
+
+std::ostream& operator<<(std::ostream& os, TransferTimeout const& rhs) {
+  return StreamDuration(os, rhs, "ms");
+}
+
+std::ostream& operator<<(std::ostream& os, OperationDeadline const& rhs) {
+  return StreamDuration(os, rhs, "ms");
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
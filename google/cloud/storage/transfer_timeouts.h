@@ -0,0 +1,108 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_TIMEOUTS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_TIMEOUTS_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Bound the time to establish the connection for a single attempt.
+ *
+ * Without this option a request against an unreachable endpoint blocks
+ * the calling thread until the operating system gives up on the TCP
+ * handshake, which can take minutes. The timeout applies to each
+ * attempt separately, a timed-out attempt is retried like any other
+ * transient failure.
+ */
+struct ConnectTimeout
+    : public internal::ComplexOption<ConnectTimeout,
+                                     std::chrono::milliseconds> {
+  using ComplexOption<ConnectTimeout, std::chrono::milliseconds>::ComplexOption;
+  static char const* name() { return "connect-timeout"; }
+};
+
+std::ostream& operator<<(std::ostream& os, ConnectTimeout const& rhs);
+
+/**
+ * Abort an attempt that transfers no data for the given period.
+ *
+ * This detects both a server that accepted the connection but never
+ * answers (no time-to-first-byte) and a transfer that hangs midway.
+ * It bounds how long a hung connection can hold the calling thread
+ * without limiting the total duration of large, healthy transfers.
+ * The per-request option takes precedence over the client-wide
+ * `ClientOptions::download_stall_timeout()`, and unlike that option it
+ * also protects uploads and metadata requests.
+ */
+struct TransferStallTimeout
+    : public internal::ComplexOption<TransferStallTimeout,
+                                     std::chrono::seconds> {
+  using ComplexOption<TransferStallTimeout,
+                      std::chrono::seconds>::ComplexOption;
+  static char const* name() { return "transfer-stall-timeout"; }
+};
+
+std::ostream& operator<<(std::ostream& os, TransferStallTimeout const& rhs);
+
+/**
+ * Bound the total duration of a single attempt.
+ *
+ * A hard cap including connection setup and the full transfer. Use
+ * with care on downloads and uploads of unpredictable size, a healthy
+ * but large transfer is aborted just like a hung one.
+ */
+struct TransferTimeout
+    : public internal::ComplexOption<TransferTimeout,
+                                     std::chrono::milliseconds> {
+  using ComplexOption<TransferTimeout,
+                      std::chrono::milliseconds>::ComplexOption;
+  static char const* name() { return "transfer-timeout"; }
+};
+
+std::ostream& operator<<(std::ostream& os, TransferTimeout const& rhs);
+
+/**
+ * Bound the total duration of an operation, across all its attempts.
+ *
+ * The retry loop stops starting new attempts once the deadline (taken
+ * from the start of the operation) expires, and backoff waits are
+ * clipped to the remaining budget; the operation then fails with
+ * `kDeadlineExceeded`. An attempt already in flight is not interrupted,
+ * combine this option with the per-attempt timeouts above to bound the
+ * overall latency.
+ */
+struct OperationDeadline
+    : public internal::ComplexOption<OperationDeadline,
+                                     std::chrono::milliseconds> {
+  using ComplexOption<OperationDeadline,
+                      std::chrono::milliseconds>::ComplexOption;
+  static char const* name() { return "operation-deadline"; }
+};
+
+std::ostream& operator<<(std::ostream& os, OperationDeadline const& rhs);
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_TIMEOUTS_H
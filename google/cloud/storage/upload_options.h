@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -43,7 +44,14 @@ struct UseResumableUploadSession
   static char const* name() { return "resumable-upload"; }
 };
 
-/// Create a UseResumableUploadSession option that restores previous sessions.
+/**
+ * Create a UseResumableUploadSession option that restores previous sessions.
+ *
+ * The argument is either a session id, or a binary checkpoint obtained from
+ * `ObjectWriteStream::Checkpoint()`. Restoring from a session id queries the
+ * service for the committed byte count, restoring from a checkpoint resumes
+ * the upload without that extra round trip.
+ */
 inline UseResumableUploadSession RestoreResumableUploadSession(
     std::string session_id) {
   return UseResumableUploadSession(std::move(session_id));
@@ -54,6 +62,79 @@ inline UseResumableUploadSession NewResumableUploadSession() {
   return UseResumableUploadSession("");
 }
 
+/**
+ * Compress the data with gzip as it is uploaded.
+ *
+ * When this option is enabled `Client::WriteObject()` compresses the data
+ * incrementally as the application writes it, the full object is never
+ * staged in memory. The object is stored compressed, with its
+ * `contentEncoding` set to `gzip`, so downloads are decompressed by the
+ * service (or by any HTTP client that understands `Content-Encoding`).
+ *
+ * Note that the MD5 and CRC32C hashes of such objects cover the compressed
+ * bytes, as that is what the service stores.
+ *
+ * This option only applies to `Client::WriteObject()`.
+ */
+struct GzipUploadCompression
+    : public internal::ComplexOption<GzipUploadCompression, bool> {
+  using ComplexOption<GzipUploadCompression, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  GzipUploadCompression() = default;
+
+  static char const* name() { return "gzip-upload-compression"; }
+};
+
+/**
+ * Upload intermediate chunks in the background.
+ *
+ * When this option is enabled `Client::WriteObject()` uploads full chunks on
+ * a background task while the application fills the next buffer, overlapping
+ * data production and network transmission. At most one chunk is in flight
+ * at a time. Errors from a background upload are reported on a later write
+ * (or on `Close()`), the stream otherwise behaves as usual.
+ *
+ * This option only applies to `Client::WriteObject()`, and is ignored when
+ * combined with `GzipUploadCompression`.
+ */
+struct BackgroundUploadFlush
+    : public internal::ComplexOption<BackgroundUploadFlush, bool> {
+  using ComplexOption<BackgroundUploadFlush, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  BackgroundUploadFlush() = default;
+
+  static char const* name() { return "background-upload-flush"; }
+};
+
+/**
+ * Send small uploads in a single request.
+ *
+ * `Client::WriteObject()` normally creates a resumable upload session, which
+ * costs one round trip before any data is sent. With this option the session
+ * creation is deferred: if the stream is closed before any intermediate
+ * chunk was flushed, and the total size is at or below the threshold, the
+ * object is inserted with a single `InsertObjectMedia` request instead.
+ * Larger uploads transparently fall back to a resumable session.
+ *
+ * To be effective the threshold should not exceed the upload buffer size,
+ * uploads larger than the buffer flush intermediate chunks and therefore
+ * always create a resumable session.
+ *
+ * This option only applies to `Client::WriteObject()`, and is ignored when
+ * combined with `UseResumableUploadSession`.
+ */
+struct SingleShotUploadThreshold
+    : public internal::ComplexOption<SingleShotUploadThreshold, std::size_t> {
+  using ComplexOption<SingleShotUploadThreshold, std::size_t>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  SingleShotUploadThreshold() = default;
+
+  static char const* name() { return "single-shot-upload-threshold"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <random>
 #include <string>
 
@@ -57,6 +58,36 @@ std::ostream& operator<<(std::ostream& os, WellKnownHeader<H, T> const& rhs) {
   }
   return os << rhs.header_name() << ": <not set>";
 }
+
+/**
+ * A well-known request header with a precomputed, shared value.
+ *
+ * Some headers, notably the encryption keys, carry values derived from the
+ * application-provided data via relatively expensive computations (e.g. a
+ * SHA256 hash and several base64 encodings). Applications often attach the
+ * same value to many requests, and each request copies its options. This
+ * variant of `WellKnownHeader` stores the value on a `std::shared_ptr`, the
+ * derived values are computed once and copying the option is just a
+ * reference count update.
+ *
+ * @tparam H the type we will use to represent the header.
+ * @tparam T the C++ type of the header value.
+ */
+template <typename H, typename T>
+class SharedWellKnownHeader {
+ public:
+  SharedWellKnownHeader() = default;
+  explicit SharedWellKnownHeader(T value)
+      : value_(std::make_shared<T const>(std::move(value))) {}
+
+  bool has_value() const { return static_cast<bool>(value_); }
+
+  /// Returns the value, behavior is undefined if `has_value()` is false.
+  T const& value() const { return *value_; }
+
+ private:
+  std::shared_ptr<T const> value_;
+};
 }  // namespace internal
 
 /**
@@ -170,13 +201,18 @@ EncryptionKeyData EncryptionDataFromBase64Key(std::string const& key);
  * operations. Note that copy and compose operations use the same key for the
  * source and destination objects.
  *
+ * The derived values (the base64-encoded key and its SHA256 hash) are
+ * computed when the option is created and shared by all its copies, reusing
+ * the same `EncryptionKey` object across many requests is cheap.
+ *
  * @see https://cloud.google.com/storage/docs/encryption/customer-supplied-keys
  *     for a detailed description of how Customer Supplied Encryption keys are
  *     used in GCS.
  */
 struct EncryptionKey
-    : public internal::WellKnownHeader<EncryptionKey, EncryptionKeyData> {
-  using WellKnownHeader<EncryptionKey, EncryptionKeyData>::WellKnownHeader;
+    : public internal::SharedWellKnownHeader<EncryptionKey, EncryptionKeyData> {
+  using SharedWellKnownHeader<EncryptionKey,
+                              EncryptionKeyData>::SharedWellKnownHeader;
 
   /**
    * Create an encryption key parameter from a binary key.
@@ -220,9 +256,10 @@ std::ostream& operator<<(std::ostream& os, EncryptionKey const& rhs);
  *     used in GCS.
  */
 struct SourceEncryptionKey
-    : public internal::WellKnownHeader<SourceEncryptionKey, EncryptionKeyData> {
-  using WellKnownHeader<SourceEncryptionKey,
-                        EncryptionKeyData>::WellKnownHeader;
+    : public internal::SharedWellKnownHeader<SourceEncryptionKey,
+                                             EncryptionKeyData> {
+  using SharedWellKnownHeader<SourceEncryptionKey,
+                              EncryptionKeyData>::SharedWellKnownHeader;
 
   /**
    * Creates a source encryption key parameter from a binary key.
@@ -79,6 +79,15 @@ TEST(WellKnownHeader, EncryptionKeyFromBase64) {
   EXPECT_EQ(expected.value().sha256, actual.value().sha256);
 }
 
+/// @test Verify that copies of EncryptionKey share the precomputed value.
+TEST(WellKnownHeader, EncryptionKeyCopiesShareValue) {
+  auto header = EncryptionKey::FromBinaryKey("01234567");
+  ASSERT_TRUE(header.has_value());
+  EncryptionKey copy = header;
+  ASSERT_TRUE(copy.has_value());
+  EXPECT_EQ(&header.value(), &copy.value());
+}
+
 /// @test Verify that SourceEncryptionKey streaming works as expected.
 TEST(WellKnownHeader, SourceEncryptionKey) {
   SourceEncryptionKey header(
@@ -20,12 +20,12 @@ find_package(Threads REQUIRED)
 include(external/grpc)
 
 if (NOT TARGET googleapis-project)
-    # Give application developers a hook to configure the version and hash
-    # downloaded from GitHub.
-    set(GOOGLE_CLOUD_CPP_GOOGLEAPIS_URL
-        "https://github.com/googleapis/cpp-cmakefiles/archive/v0.6.0.tar.gz")
-    set(GOOGLE_CLOUD_CPP_GOOGLEAPIS_SHA256
-        "eb34f3369046e211754b570a9bd37123f44383cc38b7293e09174b4a86f224c7")
+    # Give application developers a hook to configure the version
+    # downloaded from GitHub. v0.6.0 did not ship the firestore proto
+    # libraries, google/cloud/firestore needs at least v0.10.0.
+    set(GOOGLE_CLOUD_CPP_GOOGLEAPIS_REPOSITORY
+        "https://github.com/googleapis/cpp-cmakefiles.git")
+    set(GOOGLE_CLOUD_CPP_GOOGLEAPIS_TAG "v0.10.0")
 
     set_external_project_build_parallel_level(PARALLEL)
     set_external_project_vars()
@@ -37,8 +37,8 @@ if (NOT TARGET googleapis-project)
         EXCLUDE_FROM_ALL ON
         PREFIX "${CMAKE_BINARY_DIR}/external/googleapis"
         INSTALL_DIR "${GOOGLE_CLOUD_CPP_EXTERNAL_PREFIX}"
-        URL ${GOOGLE_CLOUD_CPP_GOOGLEAPIS_URL}
-        URL_HASH SHA256=${GOOGLE_CLOUD_CPP_GOOGLEAPIS_SHA256}
+        GIT_REPOSITORY ${GOOGLE_CLOUD_CPP_GOOGLEAPIS_REPOSITORY}
+        GIT_TAG ${GOOGLE_CLOUD_CPP_GOOGLEAPIS_TAG}
         LIST_SEPARATOR |
         CONFIGURE_COMMAND
             ${CMAKE_COMMAND}